@@ -3,20 +3,59 @@ library;
 
 export 'src/library.dart'
     show
+        AudioBackend,
         AudioContext,
+        AudioContextConfig,
+        AudioContextTimings,
         AudioDeviceType,
         AudioFormat,
+        AudioOverview,
+        DataSource,
+        Decoder,
+        DecoderConfig,
         DeviceId,
         DeviceInfo,
         DeviceState,
         FileLogLevel,
         FileLogger,
+        MappedWav,
         PcmFormat,
         PlaybackConfig,
         PlaybackDevice,
+        PlaybackDspStage,
+        PlaybackDspType,
+        PlaybackEvent,
+        PlaybackEventType,
+        PlaybackGroup,
+        PlaybackGroupConfig,
+        PlaybackGroupOutputStats,
+        PlaybackInterruptionMode,
+        PlaybackInterruptionPolicy,
+        PlaybackInterruptionStats,
+        PlaybackMeter,
+        PlaybackMigration,
+        PlaybackPoolStats,
+        PlaybackReferenceBlock,
+        PlaybackSilenceConfig,
+        PlaybackSilenceStats,
+        SpectrumConfig,
+        SpectrumWindow,
         WavEncoder,
+        WavEncoderChunkCallback,
         WavEncoderConfig,
+        WavEncoderFsyncPolicy,
+        WavEncoderSegmentCallback,
+        WavEncoderSegmentConfig,
+        WavEncoderStorage,
+        WavEncoderWriterConfig,
+        WavEncoderWriterStats,
+        WavGap,
+        WavSegment,
         Waveform,
+        WaveformBank,
+        WaveformBankConfig,
+        WaveformBankMix,
+        WaveformBankOscillator,
         WaveformSawtoothConfig,
         WaveformSineConfig,
         WaveformSquareConfig,
@@ -32,6 +32,25 @@ final class AudioContext extends NativeResource<Void> {
   /// exception if the initialization fails.
   factory AudioContext() => AudioContext._(_bindings.audio_context_create());
 
+  /// Creates a new [AudioContext] that tries the backends of [config] and,
+  /// unless it is lazy, enumerates the devices before returning.
+  ///
+  /// Throws:
+  /// - [RangeError] if [config] lists too many backends.
+  /// - [StateError] if no backend could be initialized.
+  factory AudioContext.withConfig(AudioContextConfig config) {
+    final nativeConfig = config.toNative();
+    final ptr = _bindings.audio_context_create_ex(
+      nativeConfig.ensureIsNotFinalized(),
+    );
+
+    if (ptr == nullptr) {
+      throw StateError('Failed to create the audio context.');
+    }
+
+    return AudioContext._(ptr);
+  }
+
   /// Internal constructor.
   ///
   /// This constructor is used by the factory and should not be called
@@ -66,6 +85,35 @@ final class AudioContext extends NativeResource<Void> {
         ensureIsNotFinalized(),
       );
 
+  /// The time spent by each phase of starting the context.
+  ///
+  /// [AudioContextTimings.backend] can be persisted and listed first in
+  /// [AudioContextConfig.backends] on the next launch.
+  ///
+  /// Throws:
+  /// - [StateError] if the context is finalized.
+  AudioContextTimings get timings {
+    final pTimings = malloc<audio_context_timings_t>();
+
+    try {
+      _bindings.audio_context_get_timings(ensureIsNotFinalized(), pTimings);
+
+      final timings = pTimings.ref;
+
+      return AudioContextTimings(
+        backend: AudioBackend.fromValue(timings.backendAsInt),
+        logDuration: Duration(microseconds: timings.logNs ~/ 1000),
+        initDuration: Duration(microseconds: timings.initNs ~/ 1000),
+        enumerateDuration: timings.isEnumerated
+            ? Duration(microseconds: timings.enumerateNs ~/ 1000)
+            : null,
+        enumerations: timings.enumerations,
+      );
+    } finally {
+      malloc.free(pTimings);
+    }
+  }
+
   List<DeviceInfo> getDeviceInfos({required AudioDeviceType type}) {
     final devicesInfos = _bindings.audio_context_get_device_infos(
       ensureIsNotFinalized(),
@@ -78,6 +126,195 @@ final class AudioContext extends NativeResource<Void> {
     return deviceList;
   }
 
+  /// Opens and starts playback devices until [count] of them wait in the
+  /// playback pool for [id] and [config], and returns how many wait.
+  ///
+  /// Warm devices run, outputting silence, until taken with
+  /// [PlaybackDevice.acquire], which makes the first sound start within
+  /// one period instead of after opening and starting a device.
+  ///
+  /// Throws:
+  /// - [StateError] if the context is finalized.
+  int warmPlaybackDevices({
+    required DeviceId? id,
+    required PlaybackConfig config,
+    required int count,
+  }) {
+    final nativeConfig = config.toNative();
+
+    return _bindings.playback_pool_warm(
+      ensureIsNotFinalized(),
+      id == null ? nullptr : id.ensureIsNotFinalized(),
+      nativeConfig.ensureIsNotFinalized(),
+      count,
+    );
+  }
+
+  /// Destroys the devices waiting in the playback pool.
+  ///
+  /// Throws:
+  /// - [StateError] if the context is finalized.
+  void drainPlaybackPool() =>
+      _bindings.playback_pool_drain(ensureIsNotFinalized());
+
+  /// The state of the playback pool.
+  ///
+  /// Throws:
+  /// - [StateError] if the context is finalized.
+  PlaybackPoolStats get playbackPoolStats {
+    final pStats = malloc<playback_pool_stats_t>();
+
+    try {
+      _bindings.playback_pool_get_stats(ensureIsNotFinalized(), pStats);
+
+      final stats = pStats.ref;
+
+      return PlaybackPoolStats(
+        idleDevices: stats.idleDevices,
+        lentDevices: stats.lentDevices,
+        hits: stats.hits,
+        misses: stats.misses,
+      );
+    } finally {
+      malloc.free(pStats);
+    }
+  }
+
+  /// Refreshes the list of available audio devices without blocking.
+  ///
+  /// The backend is queried on a worker thread owned by the context.
+  /// Refreshes requested while the worker is busy share one query.
+  ///
+  /// Throws:
+  /// - [StateError] if the context is finalized or the request could not be
+  ///   queued.
+  ///
+  /// The returned future completes with a [StateError] if the backend
+  /// failed to enumerate the devices.
+  Future<void> refreshDevicesAsync() {
+    final self = ensureIsNotFinalized();
+    final completer = Completer<void>();
+    late final NativeCallable<audio_context_refresh_callback_tFunction>
+        callable;
+
+    callable = NativeCallable<audio_context_refresh_callback_tFunction>.listener(
+      (Pointer<Void> _, bool isSuccess) {
+        callable.close();
+
+        if (isSuccess) {
+          completer.complete();
+        } else {
+          completer.completeError(StateError('Failed to refresh devices.'));
+        }
+      },
+    );
+
+    if (!_bindings.audio_context_refresh_devices_async(
+      self,
+      callable.nativeFunction,
+      nullptr,
+    )) {
+      callable.close();
+      throw StateError('Failed to queue the device refresh.');
+    }
+
+    return completer.future;
+  }
+
+  /// Retrieves the audio devices of [type] without blocking, enumerating
+  /// them first if the context has not yet.
+  ///
+  /// Throws:
+  /// - [StateError] if the context is finalized or the request could not be
+  ///   queued.
+  Future<List<DeviceInfo>> getDeviceInfosAsync({
+    required AudioDeviceType type,
+  }) {
+    final self = ensureIsNotFinalized();
+    final completer = Completer<List<DeviceInfo>>();
+    late final NativeCallable<audio_context_device_infos_callback_tFunction>
+        callable;
+
+    callable =
+        NativeCallable<audio_context_device_infos_callback_tFunction>.listener(
+      (Pointer<Void> _, Pointer<device_infos_t> pDeviceInfos) {
+        callable.close();
+
+        completer.complete(
+          pDeviceInfos == nullptr
+              ? const []
+              : DeviceInfos._(pDeviceInfos).getList(),
+        );
+      },
+    );
+
+    if (!_bindings.audio_context_get_device_infos_async(
+      self,
+      type.toNative(),
+      callable.nativeFunction,
+      nullptr,
+    )) {
+      callable.close();
+      throw StateError('Failed to queue the device infos request.');
+    }
+
+    return completer.future;
+  }
+
+  /// Retrieves the native formats of the playback device [id] without
+  /// blocking.
+  ///
+  /// Throws:
+  /// - [StateError] if the context is finalized or the request could not be
+  ///   queued.
+  ///
+  /// The returned future completes with a [StateError] if the backend
+  /// failed to query the device.
+  Future<List<AudioFormat>> getDeviceFormatsAsync(DeviceId id) {
+    final self = ensureIsNotFinalized();
+    final completer = Completer<List<AudioFormat>>();
+    late final NativeCallable<audio_context_device_info_ext_callback_tFunction>
+        callable;
+
+    callable = NativeCallable<
+        audio_context_device_info_ext_callback_tFunction>.listener(
+      (Pointer<Void> _, Pointer<device_info_ext_t> pDeviceInfoExt) {
+        callable.close();
+
+        if (pDeviceInfoExt == nullptr) {
+          completer.completeError(StateError('Failed to query the device.'));
+          return;
+        }
+
+        final info = pDeviceInfoExt.ref;
+        final formats = List.generate(info.count, (i) {
+          final format = info.list[i];
+
+          return AudioFormat(
+            pcmFormat: PcmFormat.fromValue(format.pcmFormatAsInt),
+            channels: format.channels,
+            sampleRate: format.sampleRate,
+          );
+        });
+
+        _bindings.audio_context_device_info_ext_destroy(pDeviceInfoExt);
+        completer.complete(formats);
+      },
+    );
+
+    if (!_bindings.audio_context_get_device_info_ext_async(
+      self,
+      id.ensureIsNotFinalized().cast(),
+      callable.nativeFunction,
+      nullptr,
+    )) {
+      callable.close();
+      throw StateError('Failed to queue the device info request.');
+    }
+
+    return completer.future;
+  }
+
   // List<DeviceInfo> _extractDeviceInfoList(
   //   Pointer<device_info_t> devicesPointer,
   //   int count,
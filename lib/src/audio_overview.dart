@@ -0,0 +1,223 @@
+part of 'library.dart';
+
+/// A min/max waveform overview of a recording, for drawing waveforms at any
+/// zoom level without reading the audio.
+///
+/// The overview keeps the minimum and maximum sample of every channel per
+/// block of [blockFrames] frames, plus a pyramid of coarser levels that is
+/// grown incrementally while frames flow in. A [query] costs time
+/// proportional to the number of pixels, whatever the length of the range.
+///
+/// Frames reach the overview through a [WavEncoder] with
+/// [WavEncoder.attachOverview], through a [PlaybackDevice] with
+/// [PlaybackDevice.attachOverview], or with [writePcmFrames]. The overview
+/// can be saved as a sidecar file next to the recording and opened again
+/// with [AudioOverview.load].
+///
+/// ### Example Usage:
+/// ```dart
+/// final overview = AudioOverview(format: format);
+/// final encoder = WavEncoder(filePath: 'take.wav', config: config)
+///   ..attachOverview(overview, sidecarPath: 'take.wav.overview');
+///
+/// // ... record, then draw 800 pixels of the first minute:
+/// final (:min, :max) = overview.query(
+///   startFrame: 0,
+///   frameCount: 60 * format.sampleRate,
+///   pixelCount: 800,
+/// );
+/// ```
+final class AudioOverview extends NativeResource<Void> {
+  /// Creates an empty overview for frames in [format].
+  ///
+  /// - [blockFrames]: The number of frames per block of the finest level,
+  ///   which bounds the horizontal resolution of a [query].
+  ///
+  /// Throws:
+  /// - [Exception] if the overview creation fails.
+  factory AudioOverview({
+    required AudioFormat format,
+    int blockFrames = 256,
+  }) {
+    final nativeConfig = malloc<overview_config_t>();
+
+    try {
+      nativeConfig.ref
+        ..pcmFormatAsInt = format.pcmFormat.index
+        ..channels = format.channels
+        ..sampleRate = format.sampleRate
+        ..blockFrames = blockFrames;
+
+      final rOverview = _bindings.overview_create(nativeConfig);
+
+      if (rOverview == nullptr) {
+        throw Exception('Failed to create the overview');
+      }
+
+      return AudioOverview._(rOverview);
+    } finally {
+      malloc.free(nativeConfig);
+    }
+  }
+
+  /// Opens an overview saved with [save].
+  ///
+  /// Frames written to a loaded overview are ignored.
+  ///
+  /// Throws:
+  /// - [Exception] if the file is not a valid overview.
+  factory AudioOverview.load(String filePath) {
+    final filePathPtr = stringToCharPointer(filePath);
+    final rOverview = _bindings.overview_load(
+      filePathPtr.ensureIsNotFinalized(),
+    );
+
+    if (rOverview == nullptr) {
+      throw Exception('Failed to load the overview $filePath');
+    }
+
+    return AudioOverview._(rOverview);
+  }
+
+  /// Internal constructor.
+  ///
+  /// This is used internally by the factory constructors and should not
+  /// be called directly.
+  AudioOverview._(super.ptr) : super._() {
+    final nativeConfig = malloc<overview_config_t>();
+
+    try {
+      _bindings.overview_get_config(ensureIsNotFinalized(), nativeConfig);
+
+      format = AudioFormat(
+        pcmFormat: PcmFormat.fromValue(nativeConfig.ref.pcmFormatAsInt),
+        channels: nativeConfig.ref.channels,
+        sampleRate: nativeConfig.ref.sampleRate,
+      );
+      blockFrames = nativeConfig.ref.blockFrames;
+    } finally {
+      malloc.free(nativeConfig);
+    }
+  }
+
+  /// The format of the frames the overview is built from.
+  late final AudioFormat format;
+
+  /// The number of frames per block of the finest level.
+  late final int blockFrames;
+
+  @protected
+  @override
+  NativeFinalizer get finalizer => Library._audioOverviewFinalizer;
+
+  @protected
+  @override
+  void releaseResource() => _bindings.overview_destroy(
+        ensureIsNotFinalized(),
+      );
+
+  /// The number of frames that can be queried.
+  ///
+  /// Frames of the block being filled are counted once the block is complete
+  /// or the overview is finished.
+  int get frameCount =>
+      _bindings.overview_get_frame_count(ensureIsNotFinalized());
+
+  /// Adds [framesCount] frames of [buffer], interleaved in [format].
+  ///
+  /// Must not be used while the overview is attached to an encoder or a
+  /// device.
+  void writePcmFrames({
+    required TypedData buffer,
+    required int framesCount,
+  }) {
+    final resource = ensureIsNotFinalized();
+    final length = framesCount * format.channels;
+    final pFrames = malloc.allocate(framesCount * format.bytesPerFrame);
+
+    try {
+      switch (buffer) {
+        case Uint8List():
+          pFrames.cast<Uint8>().asTypedList(length).setAll(0, buffer);
+        case Int16List():
+          pFrames.cast<Int16>().asTypedList(length).setAll(0, buffer);
+        case Float32List():
+          pFrames.cast<Float>().asTypedList(length).setAll(0, buffer);
+        case Int32List():
+          pFrames.cast<Int32>().asTypedList(length).setAll(0, buffer);
+        case _:
+          throw UnsupportedError('Unsupported buffer type');
+      }
+
+      _bindings.overview_write_pcm_frames(
+        resource,
+        pFrames.cast(),
+        framesCount,
+      );
+    } finally {
+      malloc.free(pFrames);
+    }
+  }
+
+  /// Completes the last, partial block. Frames written afterwards are
+  /// ignored.
+  ///
+  /// [WavEncoder.finalize] finishes an attached overview.
+  void finish() => _bindings.overview_finish(ensureIsNotFinalized());
+
+  /// Saves the overview as a sidecar file, see [AudioOverview.load].
+  ///
+  /// Throws:
+  /// - [FileSystemException] if the file cannot be written.
+  void save(String filePath) {
+    final filePathPtr = stringToCharPointer(filePath);
+
+    if (!_bindings.overview_save(
+      ensureIsNotFinalized(),
+      filePathPtr.ensureIsNotFinalized(),
+    )) {
+      throw FileSystemException('Failed to save the overview', filePath);
+    }
+  }
+
+  /// Computes the minimum and maximum of [channel] for each of [pixelCount]
+  /// equal spans of `[startFrame, startFrame + frameCount)`.
+  ///
+  /// The lists are shorter than [pixelCount] when the range extends past
+  /// [frameCount]. Values are in the -1 to 1 range of normalized samples.
+  ///
+  /// Throws:
+  /// - [RangeError] if [channel] is not a channel of [format].
+  ({Float32List min, Float32List max}) query({
+    int channel = 0,
+    required int startFrame,
+    required int frameCount,
+    required int pixelCount,
+  }) {
+    RangeError.checkValueInInterval(channel, 0, format.channels - 1, 'channel');
+
+    final resource = ensureIsNotFinalized();
+    final pMin = malloc<Float>(pixelCount);
+    final pMax = malloc<Float>(pixelCount);
+
+    try {
+      final count = _bindings.overview_query(
+        resource,
+        channel,
+        startFrame,
+        frameCount,
+        pixelCount,
+        pMin,
+        pMax,
+      );
+
+      return (
+        min: Float32List.fromList(pMin.asTypedList(count)),
+        max: Float32List.fromList(pMax.asTypedList(count)),
+      );
+    } finally {
+      malloc.free(pMin);
+      malloc.free(pMax);
+    }
+  }
+}
@@ -0,0 +1,15 @@
+part of 'library.dart';
+
+/// A native audio source that a [PlaybackDevice] can pull frames from.
+///
+/// Data sources live entirely in native memory. Attaching one to a device with
+/// [PlaybackDevice.attachSource] lets the audio callback read frames straight
+/// from it, without copying audio into Dart and pushing it back.
+///
+/// Implemented by [Waveform] and [WaveformBank].
+abstract interface class DataSource implements Finalizable {
+  /// Returns the pointer to the native `ma_data_source`.
+  ///
+  /// Throws a [StateError] if the source has been disposed.
+  Pointer<Void> ensureIsNotFinalized();
+}
@@ -0,0 +1,173 @@
+part of 'library.dart';
+
+/// Streams an audio file (WAV, FLAC or MP3) from disk.
+///
+/// A background thread decodes the file into a fixed-size lookahead ring, so
+/// memory use does not grow with the file length and reads never block on
+/// the file system. A `Decoder` is a [DataSource] and is usually attached to
+/// a [PlaybackDevice] with a matching format, which plays the file without
+/// any data crossing into Dart.
+///
+/// ### Example Usage:
+/// ```dart
+/// final decoder = Decoder(
+///   filePath: '/path/to/music.flac',
+///   config: const DecoderConfig(
+///     pcmFormat: PcmFormat.f32,
+///     channels: 2,
+///     sampleRate: 48000,
+///   ),
+/// );
+///
+/// playbackDevice
+///   ..attachSource(decoder)
+///   ..start();
+///
+/// decoder.seek(48000 * 30);
+/// ```
+final class Decoder extends NativeResource<Void> implements DataSource {
+  /// Opens [filePath] for streaming with the provided configuration.
+  ///
+  /// Throws:
+  /// - [Exception] if the file cannot be opened or decoded.
+  factory Decoder({
+    required String filePath,
+    required DecoderConfig config,
+  }) {
+    final filePathPtr = stringToCharPointer(filePath);
+    final nativeConfig = malloc<decoder_config_t>();
+
+    try {
+      nativeConfig.ref
+        ..pcmFormatAsInt = config.pcmFormat.index
+        ..channels = config.channels
+        ..sampleRate = config.sampleRate
+        ..lookaheadFrames = config.lookaheadFrames;
+
+      final rDecoder = _bindings.decoder_create(
+        filePathPtr.ensureIsNotFinalized(),
+        nativeConfig,
+      );
+
+      if (rDecoder == nullptr) {
+        throw Exception('Failed to open decoder for $filePath');
+      }
+
+      return Decoder._(rDecoder, config);
+    } finally {
+      malloc.free(nativeConfig);
+    }
+  }
+
+  /// Internal constructor.
+  ///
+  /// This is used internally by the factory constructor and should not
+  /// be called directly.
+  Decoder._(super.ptr, this.config) : super._();
+
+  /// The configuration used to open the file.
+  final DecoderConfig config;
+
+  @protected
+  @override
+  NativeFinalizer get finalizer => Library._decoderFinalizer;
+
+  @protected
+  @override
+  void releaseResource() => _bindings.decoder_destroy(
+        ensureIsNotFinalized(),
+      );
+
+  /// The length of the file in output frames, or `0` if it is unknown.
+  int get length => _bindings.decoder_get_length(ensureIsNotFinalized());
+
+  /// The index of the next frame that will be read.
+  int get cursor => _bindings.decoder_get_cursor(ensureIsNotFinalized());
+
+  /// The number of frames currently decoded ahead of the reader.
+  int get bufferedFrames =>
+      _bindings.decoder_get_buffered_frames(ensureIsNotFinalized());
+
+  /// Whether every frame of the file has been read.
+  ///
+  /// Always `false` while [isLooping] is enabled.
+  bool get isAtEnd => _bindings.decoder_is_at_end(ensureIsNotFinalized());
+
+  bool _isLooping = false;
+
+  /// Whether playback restarts from the beginning at the end of the file.
+  bool get isLooping => _isLooping;
+
+  set isLooping(bool value) {
+    _bindings.decoder_set_looping(ensureIsNotFinalized(), value);
+    _isLooping = value;
+  }
+
+  /// Moves playback to [frameIndex].
+  ///
+  /// Returns immediately. Buffered frames are discarded and the read-ahead
+  /// thread refills the lookahead from the new position; silence is produced
+  /// until the first new frames are decoded.
+  void seek(int frameIndex) {
+    if (frameIndex < 0) {
+      throw RangeError.value(frameIndex, 'frameIndex', 'must not be negative');
+    }
+
+    _bindings.decoder_seek(ensureIsNotFinalized(), frameIndex);
+  }
+
+  /// Reads up to [frameCount] decoded frames.
+  ///
+  /// Only frames that are already decoded are returned, so `framesRead` may
+  /// be lower than [frameCount]. Must not be used while the decoder is
+  /// attached to a [PlaybackDevice].
+  ///
+  /// Returns:
+  /// - A record containing:
+  ///   - `frames`: The PCM audio data as a [TypedData].
+  ///   - `framesRead`: The number of frames successfully read.
+  ///
+  /// Throws:
+  /// - [StateError] if the decoder is finalized.
+  /// - [Exception] if the sample format is unsupported.
+  ({TypedData frames, int framesRead}) readPcmFrames({
+    required int frameCount,
+  }) {
+    final resource = ensureIsNotFinalized();
+
+    final pFramesOut = malloc.allocate(frameCount * config.bpf);
+    final pFramesRead = malloc<Uint64>();
+
+    try {
+      _bindings.decoder_read_pcm_frames_with_buffer(
+        resource,
+        pFramesOut.cast(),
+        frameCount,
+        pFramesRead,
+      );
+
+      final framesRead = pFramesRead.value;
+      final size = framesRead * config.channels;
+
+      final frames = switch (config.pcmFormat) {
+        PcmFormat.f32 => pFramesOut
+            .cast<Float>()
+            .asTypedList(size, finalizer: malloc.nativeFree),
+        PcmFormat.s16 => pFramesOut
+            .cast<Int16>()
+            .asTypedList(size, finalizer: malloc.nativeFree),
+        PcmFormat.s32 || PcmFormat.s24 => pFramesOut
+            .cast<Int32>()
+            .asTypedList(size, finalizer: malloc.nativeFree),
+        PcmFormat.u8 => pFramesOut
+            .cast<Uint8>()
+            .asTypedList(size, finalizer: malloc.nativeFree),
+        _ => throw Exception('Unsupported sample format: ${config.pcmFormat}'),
+      };
+
+      return (frames: frames, framesRead: framesRead);
+    } finally {
+      malloc.free(pFramesRead);
+    }
+  }
+}
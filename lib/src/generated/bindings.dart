@@ -327,7 +327,7 @@ class ProMiniaudioBindings {
       .asFunction<void Function(ffi.Pointer<ffi.Void>)>();
 
   /// Pushes audio data into the playback device's buffer.
-  void playback_device_push_buffer(
+  int playback_device_push_buffer(
     ffi.Pointer<ffi.Void> self,
     ffi.Pointer<playback_data_t> pData,
   ) {
@@ -339,11 +339,11 @@ class ProMiniaudioBindings {
 
   late final _playback_device_push_bufferPtr = _lookup<
       ffi.NativeFunction<
-          ffi.Void Function(ffi.Pointer<ffi.Void>,
+          ffi.Uint32 Function(ffi.Pointer<ffi.Void>,
               ffi.Pointer<playback_data_t>)>>('playback_device_push_buffer');
   late final _playback_device_push_buffer =
       _playback_device_push_bufferPtr.asFunction<
-          void Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_data_t>)>();
+          int Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_data_t>)>();
 
   /// Resets the playback device's internal buffer.
   void playback_device_reset_buffer(
@@ -460,338 +460,2850 @@ class ProMiniaudioBindings {
   late final _encoder_destroy =
       _encoder_destroyPtr.asFunction<void Function(ffi.Pointer<ffi.Void>)>();
 
+  /// Creates a bank of oscillators rendered together.
+  ffi.Pointer<ffi.Void> waveform_bank_create(
+    ffi.Pointer<waveform_bank_config_t> pConfig,
+    ffi.Pointer<waveform_bank_oscillator_t> pOscillators,
+    int oscillatorCount,
+  ) {
+    return _waveform_bank_create(
+      pConfig,
+      pOscillators,
+      oscillatorCount,
+    );
+  }
+
+  late final _waveform_bank_createPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(
+              ffi.Pointer<waveform_bank_config_t>,
+              ffi.Pointer<waveform_bank_oscillator_t>,
+              ffi.Uint32)>>('waveform_bank_create');
+  late final _waveform_bank_create = _waveform_bank_createPtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(ffi.Pointer<waveform_bank_config_t>,
+          ffi.Pointer<waveform_bank_oscillator_t>, int)>();
+
+  /// Destroys a waveform bank and releases its resources.
+  void waveform_bank_destroy(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _waveform_bank_destroy(
+      self,
+    );
+  }
+
+  late final _waveform_bank_destroyPtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>(
+          'waveform_bank_destroy');
+  late final _waveform_bank_destroy = _waveform_bank_destroyPtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Replaces the parameters of one oscillator.
+  void waveform_bank_set_oscillator(
+    ffi.Pointer<ffi.Void> self,
+    int index,
+    ffi.Pointer<waveform_bank_oscillator_t> pOscillator,
+  ) {
+    return _waveform_bank_set_oscillator(
+      self,
+      index,
+      pOscillator,
+    );
+  }
+
+  late final _waveform_bank_set_oscillatorPtr = _lookup<
+          ffi.NativeFunction<
+              ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Uint32,
+                  ffi.Pointer<waveform_bank_oscillator_t>)>>(
+      'waveform_bank_set_oscillator');
+  late final _waveform_bank_set_oscillator =
+      _waveform_bank_set_oscillatorPtr.asFunction<
+          void Function(ffi.Pointer<ffi.Void>, int,
+              ffi.Pointer<waveform_bank_oscillator_t>)>();
+
+  /// Returns the number of channels written per output frame.
+  int waveform_bank_get_channels(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _waveform_bank_get_channels(
+      self,
+    );
+  }
+
+  late final _waveform_bank_get_channelsPtr =
+      _lookup<ffi.NativeFunction<ffi.Uint32 Function(ffi.Pointer<ffi.Void>)>>(
+          'waveform_bank_get_channels');
+  late final _waveform_bank_get_channels = _waveform_bank_get_channelsPtr
+      .asFunction<int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Reads PCM frames from the waveform bank.
+  void waveform_bank_read_pcm_frames_with_buffer(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<ffi.Void> pFramesOut,
+    int framesCount,
+    ffi.Pointer<ffi.Uint64> pFramesRead,
+  ) {
+    return _waveform_bank_read_pcm_frames_with_buffer(
+      self,
+      pFramesOut,
+      framesCount,
+      pFramesRead,
+    );
+  }
+
+  late final _waveform_bank_read_pcm_frames_with_bufferPtr = _lookup<
+          ffi.NativeFunction<
+              ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>,
+                  ffi.Uint64, ffi.Pointer<ffi.Uint64>)>>(
+      'waveform_bank_read_pcm_frames_with_buffer');
+  late final _waveform_bank_read_pcm_frames_with_buffer =
+      _waveform_bank_read_pcm_frames_with_bufferPtr.asFunction<
+          void Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>, int,
+              ffi.Pointer<ffi.Uint64>)>();
+
+  /// Attaches a native data source that the device pulls audio from.
+  bool playback_device_attach_source(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<ffi.Void> pDataSource,
+  ) {
+    return _playback_device_attach_source(
+      self,
+      pDataSource,
+    );
+  }
+
+  late final _playback_device_attach_sourcePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>,
+              ffi.Pointer<ffi.Void>)>>('playback_device_attach_source');
+  late final _playback_device_attach_source =
+      _playback_device_attach_sourcePtr.asFunction<
+          bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>)>();
+
+  /// Detaches the current data source and returns to ring buffer playback.
+  void playback_device_detach_source(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _playback_device_detach_source(
+      self,
+    );
+  }
+
+  late final _playback_device_detach_sourcePtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>(
+          'playback_device_detach_source');
+  late final _playback_device_detach_source = _playback_device_detach_sourcePtr
+      .asFunction<void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Opens an audio file for streaming playback.
+  ffi.Pointer<ffi.Void> decoder_create(
+    ffi.Pointer<ffi.Char> path,
+    ffi.Pointer<decoder_config_t> pConfig,
+  ) {
+    return _decoder_create(
+      path,
+      pConfig,
+    );
+  }
+
+  late final _decoder_createPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Char>, ffi.Pointer<decoder_config_t>)>>('decoder_create');
+  late final _decoder_create = _decoder_createPtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Char>, ffi.Pointer<decoder_config_t>)>();
+
+  /// Stops the read-ahead thread, closes the file and releases the decoder.
+  void decoder_destroy(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _decoder_destroy(
+      self,
+    );
+  }
+
+  late final _decoder_destroyPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>)>>('decoder_destroy');
+  late final _decoder_destroy = _decoder_destroyPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Requests a seek to the given output frame.
+  void decoder_seek(
+    ffi.Pointer<ffi.Void> self,
+    int frameIndex,
+  ) {
+    return _decoder_seek(
+      self,
+      frameIndex,
+    );
+  }
+
+  late final _decoder_seekPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Uint64)>>('decoder_seek');
+  late final _decoder_seek = _decoder_seekPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>, int)>();
+
+  /// Enables or disables looping at the end of the file.
+  void decoder_set_looping(
+    ffi.Pointer<ffi.Void> self,
+    bool isLooping,
+  ) {
+    return _decoder_set_looping(
+      self,
+      isLooping,
+    );
+  }
+
+  late final _decoder_set_loopingPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Bool)>>('decoder_set_looping');
+  late final _decoder_set_looping = _decoder_set_loopingPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>, bool)>();
+
+  /// Returns the position of the reader, in output frames.
+  int decoder_get_cursor(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _decoder_get_cursor(
+      self,
+    );
+  }
+
+  late final _decoder_get_cursorPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint64 Function(ffi.Pointer<ffi.Void>)>>('decoder_get_cursor');
+  late final _decoder_get_cursor = _decoder_get_cursorPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Returns the length of the file, in output frames.
+  int decoder_get_length(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _decoder_get_length(
+      self,
+    );
+  }
+
+  late final _decoder_get_lengthPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint64 Function(ffi.Pointer<ffi.Void>)>>('decoder_get_length');
+  late final _decoder_get_length = _decoder_get_lengthPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Returns the number of frames currently decoded ahead of the reader.
+  int decoder_get_buffered_frames(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _decoder_get_buffered_frames(
+      self,
+    );
+  }
+
+  late final _decoder_get_buffered_framesPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint32 Function(ffi.Pointer<ffi.Void>)>>('decoder_get_buffered_frames');
+  late final _decoder_get_buffered_frames = _decoder_get_buffered_framesPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Returns whether every frame of the file has been read.
+  bool decoder_is_at_end(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _decoder_is_at_end(
+      self,
+    );
+  }
+
+  late final _decoder_is_at_endPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>)>>('decoder_is_at_end');
+  late final _decoder_is_at_end = _decoder_is_at_endPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Reads decoded PCM frames.
+  void decoder_read_pcm_frames_with_buffer(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<ffi.Void> pFramesOut,
+    int framesCount,
+    ffi.Pointer<ffi.Uint64> pFramesRead,
+  ) {
+    return _decoder_read_pcm_frames_with_buffer(
+      self,
+      pFramesOut,
+      framesCount,
+      pFramesRead,
+    );
+  }
+
+  late final _decoder_read_pcm_frames_with_bufferPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>, ffi.Uint64, ffi.Pointer<ffi.Uint64>)>>('decoder_read_pcm_frames_with_buffer');
+  late final _decoder_read_pcm_frames_with_buffer = _decoder_read_pcm_frames_with_bufferPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>, int, ffi.Pointer<ffi.Uint64>)>();
+
+  /// Opens an uncompressed PCM WAV file through a read-only memory mapping.
+  ffi.Pointer<ffi.Void> mapped_wav_create(
+    ffi.Pointer<ffi.Char> path,
+    ffi.Pointer<audio_format_t> pOutputFormat,
+  ) {
+    return _mapped_wav_create(
+      path,
+      pOutputFormat,
+    );
+  }
+
+  late final _mapped_wav_createPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Char>, ffi.Pointer<audio_format_t>)>>('mapped_wav_create');
+  late final _mapped_wav_create = _mapped_wav_createPtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Char>, ffi.Pointer<audio_format_t>)>();
+
+  /// Unmaps the file and releases the source.
+  void mapped_wav_destroy(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _mapped_wav_destroy(
+      self,
+    );
+  }
+
+  late final _mapped_wav_destroyPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>)>>('mapped_wav_destroy');
+  late final _mapped_wav_destroy = _mapped_wav_destroyPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Retrieves the format stored in the file.
+  void mapped_wav_get_file_format(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<audio_format_t> pFormat,
+  ) {
+    return _mapped_wav_get_file_format(
+      self,
+      pFormat,
+    );
+  }
+
+  late final _mapped_wav_get_file_formatPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Pointer<audio_format_t>)>>('mapped_wav_get_file_format');
+  late final _mapped_wav_get_file_format = _mapped_wav_get_file_formatPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>, ffi.Pointer<audio_format_t>)>();
+
+  /// Returns whether frames are copied straight from the mapping.
+  bool mapped_wav_is_direct(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _mapped_wav_is_direct(
+      self,
+    );
+  }
+
+  late final _mapped_wav_is_directPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>)>>('mapped_wav_is_direct');
+  late final _mapped_wav_is_direct = _mapped_wav_is_directPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Moves the read position to the given output frame.
+  bool mapped_wav_seek(
+    ffi.Pointer<ffi.Void> self,
+    int frameIndex,
+  ) {
+    return _mapped_wav_seek(
+      self,
+      frameIndex,
+    );
+  }
+
+  late final _mapped_wav_seekPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Uint64)>>('mapped_wav_seek');
+  late final _mapped_wav_seek = _mapped_wav_seekPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, int)>();
+
+  /// Enables or disables looping at the end of the file.
+  void mapped_wav_set_looping(
+    ffi.Pointer<ffi.Void> self,
+    bool isLooping,
+  ) {
+    return _mapped_wav_set_looping(
+      self,
+      isLooping,
+    );
+  }
+
+  late final _mapped_wav_set_loopingPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Bool)>>('mapped_wav_set_looping');
+  late final _mapped_wav_set_looping = _mapped_wav_set_loopingPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>, bool)>();
+
+  /// Returns the read position, in output frames.
+  int mapped_wav_get_cursor(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _mapped_wav_get_cursor(
+      self,
+    );
+  }
+
+  late final _mapped_wav_get_cursorPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint64 Function(ffi.Pointer<ffi.Void>)>>('mapped_wav_get_cursor');
+  late final _mapped_wav_get_cursor = _mapped_wav_get_cursorPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Returns the length of the file, in output frames.
+  int mapped_wav_get_length(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _mapped_wav_get_length(
+      self,
+    );
+  }
+
+  late final _mapped_wav_get_lengthPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint64 Function(ffi.Pointer<ffi.Void>)>>('mapped_wav_get_length');
+  late final _mapped_wav_get_length = _mapped_wav_get_lengthPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Reads PCM frames in the output format.
+  void mapped_wav_read_pcm_frames_with_buffer(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<ffi.Void> pFramesOut,
+    int framesCount,
+    ffi.Pointer<ffi.Uint64> pFramesRead,
+  ) {
+    return _mapped_wav_read_pcm_frames_with_buffer(
+      self,
+      pFramesOut,
+      framesCount,
+      pFramesRead,
+    );
+  }
+
+  late final _mapped_wav_read_pcm_frames_with_bufferPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>, ffi.Uint64, ffi.Pointer<ffi.Uint64>)>>('mapped_wav_read_pcm_frames_with_buffer');
+  late final _mapped_wav_read_pcm_frames_with_buffer = _mapped_wav_read_pcm_frames_with_bufferPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>, int, ffi.Pointer<ffi.Uint64>)>();
+
+  /// Creates an encoder that writes into a growable in-memory buffer.
+  ffi.Pointer<ffi.Void> encoder_create_memory(
+    ffi.Pointer<encoder_config_t> pConfig,
+    int chunkSizeInBytes,
+  ) {
+    return _encoder_create_memory(
+      pConfig,
+      chunkSizeInBytes,
+    );
+  }
+
+  late final _encoder_create_memoryPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(ffi.Pointer<encoder_config_t>, ffi.Size)>>('encoder_create_memory');
+  late final _encoder_create_memory = _encoder_create_memoryPtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(ffi.Pointer<encoder_config_t>, int)>();
+
+  /// Creates an encoder that streams encoded chunks to a callback.
+  ffi.Pointer<ffi.Void> encoder_create_callback(
+    ffi.Pointer<encoder_config_t> pConfig,
+    int chunkSizeInBytes,
+    encoder_chunk_callback_t onChunk,
+    ffi.Pointer<ffi.Void> pUserData,
+  ) {
+    return _encoder_create_callback(
+      pConfig,
+      chunkSizeInBytes,
+      onChunk,
+      pUserData,
+    );
+  }
+
+  late final _encoder_create_callbackPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(ffi.Pointer<encoder_config_t>, ffi.Size, encoder_chunk_callback_t, ffi.Pointer<ffi.Void>)>>('encoder_create_callback');
+  late final _encoder_create_callback = _encoder_create_callbackPtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(ffi.Pointer<encoder_config_t>, int, encoder_chunk_callback_t, ffi.Pointer<ffi.Void>)>();
+
+  /// Encodes PCM frames.
+  int encoder_write_pcm_frames(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<ffi.Void> pFrames,
+    int frameCount,
+  ) {
+    return _encoder_write_pcm_frames(
+      self,
+      pFrames,
+      frameCount,
+    );
+  }
+
+  late final _encoder_write_pcm_framesPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint64 Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>, ffi.Uint64)>>('encoder_write_pcm_frames');
+  late final _encoder_write_pcm_frames = _encoder_write_pcm_framesPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>, int)>();
+
+  /// Finishes the encoded stream.
+  void encoder_finalize(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _encoder_finalize(
+      self,
+    );
+  }
+
+  late final _encoder_finalizePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>)>>('encoder_finalize');
+  late final _encoder_finalize = _encoder_finalizePtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Returns the number of encoded bytes produced so far.
+  int encoder_get_size_in_bytes(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _encoder_get_size_in_bytes(
+      self,
+    );
+  }
+
+  late final _encoder_get_size_in_bytesPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint64 Function(ffi.Pointer<ffi.Void>)>>('encoder_get_size_in_bytes');
+  late final _encoder_get_size_in_bytes = _encoder_get_size_in_bytesPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Removes the first chunk from a finalized memory encoder.
+  ffi.Pointer<ffi.Void> encoder_take_chunk(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<ffi.Size> pSizeInBytes,
+  ) {
+    return _encoder_take_chunk(
+      self,
+      pSizeInBytes,
+    );
+  }
+
+  late final _encoder_take_chunkPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Size>)>>('encoder_take_chunk');
+  late final _encoder_take_chunk = _encoder_take_chunkPtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Size>)>();
+
+  /// Releases a chunk returned by `encoder_take_chunk` or passed to an `encoder_chunk_callback_t`.
+  void encoder_free_chunk(
+    ffi.Pointer<ffi.Void> pData,
+  ) {
+    return _encoder_free_chunk(
+      pData,
+    );
+  }
+
+  late final _encoder_free_chunkPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>)>>('encoder_free_chunk');
+  late final _encoder_free_chunk = _encoder_free_chunkPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Creates an encoder that writes a file through a block writer.
+  ffi.Pointer<ffi.Void> encoder_create_writer(
+    ffi.Pointer<ffi.Char> path,
+    ffi.Pointer<encoder_config_t> pConfig,
+    ffi.Pointer<encoder_writer_config_t> pWriterConfig,
+  ) {
+    return _encoder_create_writer(
+      path,
+      pConfig,
+      pWriterConfig,
+    );
+  }
+
+  late final _encoder_create_writerPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Char>, ffi.Pointer<encoder_config_t>, ffi.Pointer<encoder_writer_config_t>)>>('encoder_create_writer');
+  late final _encoder_create_writer = _encoder_create_writerPtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Char>, ffi.Pointer<encoder_config_t>, ffi.Pointer<encoder_writer_config_t>)>();
+
+  /// Retrieves the I/O statistics of a writer encoder.
+  bool encoder_get_writer_stats(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<encoder_writer_stats_t> pStats,
+  ) {
+    return _encoder_get_writer_stats(
+      self,
+      pStats,
+    );
+  }
+
+  late final _encoder_get_writer_statsPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<encoder_writer_stats_t>)>>('encoder_get_writer_stats');
+  late final _encoder_get_writer_stats = _encoder_get_writer_statsPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<encoder_writer_stats_t>)>();
+
+  /// Creates an encoder that splits the recording into segment files.
+  ffi.Pointer<ffi.Void> encoder_create_segmented(
+    ffi.Pointer<ffi.Char> pathPrefix,
+    ffi.Pointer<encoder_config_t> pConfig,
+    ffi.Pointer<encoder_segment_config_t> pSegmentConfig,
+    encoder_segment_callback_t onSegment,
+    ffi.Pointer<ffi.Void> pUserData,
+  ) {
+    return _encoder_create_segmented(
+      pathPrefix,
+      pConfig,
+      pSegmentConfig,
+      onSegment,
+      pUserData,
+    );
+  }
+
+  late final _encoder_create_segmentedPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Char>, ffi.Pointer<encoder_config_t>, ffi.Pointer<encoder_segment_config_t>, encoder_segment_callback_t, ffi.Pointer<ffi.Void>)>>('encoder_create_segmented');
+  late final _encoder_create_segmented = _encoder_create_segmentedPtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Char>, ffi.Pointer<encoder_config_t>, ffi.Pointer<encoder_segment_config_t>, encoder_segment_callback_t, ffi.Pointer<ffi.Void>)>();
+
+  /// Delivers device events to a callback instead of polling.
+  bool playback_device_set_event_callback(
+    ffi.Pointer<ffi.Void> self,
+    int lowWatermarkBytes,
+    playback_event_callback_t onEvent,
+    ffi.Pointer<ffi.Void> pUserData,
+  ) {
+    return _playback_device_set_event_callback(
+      self,
+      lowWatermarkBytes,
+      onEvent,
+      pUserData,
+    );
+  }
+
+  late final _playback_device_set_event_callbackPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Size, playback_event_callback_t, ffi.Pointer<ffi.Void>)>>('playback_device_set_event_callback');
+  late final _playback_device_set_event_callback = _playback_device_set_event_callbackPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, int, playback_event_callback_t, ffi.Pointer<ffi.Void>)>();
+
+  /// Enables or disables metering of the output.
+  bool playback_device_set_metering_enabled(
+    ffi.Pointer<ffi.Void> self,
+    bool enabled,
+  ) {
+    return _playback_device_set_metering_enabled(
+      self,
+      enabled,
+    );
+  }
+
+  late final _playback_device_set_metering_enabledPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Bool)>>('playback_device_set_metering_enabled');
+  late final _playback_device_set_metering_enabled = _playback_device_set_metering_enabledPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, bool)>();
+
+  /// Reads the latest levels without locking.
+  bool playback_device_get_meter(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<playback_meter_t> pMeter,
+  ) {
+    return _playback_device_get_meter(
+      self,
+      pMeter,
+    );
+  }
+
+  late final _playback_device_get_meterPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_meter_t>)>>('playback_device_get_meter');
+  late final _playback_device_get_meter = _playback_device_get_meterPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_meter_t>)>();
+
+  /// Starts or stops the spectrum analyzer of the output.
+  bool playback_device_set_spectrum(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<spectrum_config_t> pConfig,
+  ) {
+    return _playback_device_set_spectrum(
+      self,
+      pConfig,
+    );
+  }
+
+  late final _playback_device_set_spectrumPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<spectrum_config_t>)>>('playback_device_set_spectrum');
+  late final _playback_device_set_spectrum = _playback_device_set_spectrumPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<spectrum_config_t>)>();
+
+  /// Copies the latest magnitude bins without locking.
+  int playback_device_get_spectrum(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<ffi.Float> pBins,
+    int binCount,
+    ffi.Pointer<ffi.Uint64> pSequence,
+  ) {
+    return _playback_device_get_spectrum(
+      self,
+      pBins,
+      binCount,
+      pSequence,
+    );
+  }
+
+  late final _playback_device_get_spectrumPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint32 Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Float>, ffi.Uint32, ffi.Pointer<ffi.Uint64>)>>('playback_device_get_spectrum');
+  late final _playback_device_get_spectrum = _playback_device_get_spectrumPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Float>, int, ffi.Pointer<ffi.Uint64>)>();
+
+  /// Creates a min/max waveform overview.
+  ffi.Pointer<ffi.Void> overview_create(
+    ffi.Pointer<overview_config_t> pConfig,
+  ) {
+    return _overview_create(
+      pConfig,
+    );
+  }
+
+  late final _overview_createPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(ffi.Pointer<overview_config_t>)>>('overview_create');
+  late final _overview_create = _overview_createPtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(ffi.Pointer<overview_config_t>)>();
+
+  /// Loads an overview saved with `overview_save`.
+  ffi.Pointer<ffi.Void> overview_load(
+    ffi.Pointer<ffi.Char> path,
+  ) {
+    return _overview_load(
+      path,
+    );
+  }
+
+  late final _overview_loadPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Char>)>>('overview_load');
+  late final _overview_load = _overview_loadPtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Char>)>();
+
+  /// Retrieves the configuration of an overview.
+  bool overview_get_config(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<overview_config_t> pConfig,
+  ) {
+    return _overview_get_config(
+      self,
+      pConfig,
+    );
+  }
+
+  late final _overview_get_configPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<overview_config_t>)>>('overview_get_config');
+  late final _overview_get_config = _overview_get_configPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<overview_config_t>)>();
+
+  /// Adds frames to the overview.
+  int overview_write_pcm_frames(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<ffi.Void> pFrames,
+    int frameCount,
+  ) {
+    return _overview_write_pcm_frames(
+      self,
+      pFrames,
+      frameCount,
+    );
+  }
+
+  late final _overview_write_pcm_framesPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint64 Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>, ffi.Uint64)>>('overview_write_pcm_frames');
+  late final _overview_write_pcm_frames = _overview_write_pcm_framesPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>, int)>();
+
+  /// Completes the last, partial block. Frames written afterwards are ignored.
+  void overview_finish(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _overview_finish(
+      self,
+    );
+  }
+
+  late final _overview_finishPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>)>>('overview_finish');
+  late final _overview_finish = _overview_finishPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Returns the number of frames covered by the overview.
+  int overview_get_frame_count(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _overview_get_frame_count(
+      self,
+    );
+  }
+
+  late final _overview_get_frame_countPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint64 Function(ffi.Pointer<ffi.Void>)>>('overview_get_frame_count');
+  late final _overview_get_frame_count = _overview_get_frame_countPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Computes the minimum and maximum of a channel for each pixel of a range.
+  int overview_query(
+    ffi.Pointer<ffi.Void> self,
+    int channel,
+    int startFrame,
+    int frameCount,
+    int pixelCount,
+    ffi.Pointer<ffi.Float> pMin,
+    ffi.Pointer<ffi.Float> pMax,
+  ) {
+    return _overview_query(
+      self,
+      channel,
+      startFrame,
+      frameCount,
+      pixelCount,
+      pMin,
+      pMax,
+    );
+  }
+
+  late final _overview_queryPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint32 Function(ffi.Pointer<ffi.Void>, ffi.Uint32, ffi.Uint64, ffi.Uint64, ffi.Uint32, ffi.Pointer<ffi.Float>, ffi.Pointer<ffi.Float>)>>('overview_query');
+  late final _overview_query = _overview_queryPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>, int, int, int, int, ffi.Pointer<ffi.Float>, ffi.Pointer<ffi.Float>)>();
+
+  /// Writes the overview to a sidecar file.
+  bool overview_save(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<ffi.Char> path,
+  ) {
+    return _overview_save(
+      self,
+      path,
+    );
+  }
+
+  late final _overview_savePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Char>)>>('overview_save');
+  late final _overview_save = _overview_savePtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Char>)>();
+
+  /// Stops the background thread and releases the overview.
+  void overview_destroy(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _overview_destroy(
+      self,
+    );
+  }
+
+  late final _overview_destroyPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>)>>('overview_destroy');
+  late final _overview_destroy = _overview_destroyPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Feeds the encoded frames into a waveform overview, see `overview_create`.
+  bool encoder_set_overview(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<ffi.Void> pOverview,
+    ffi.Pointer<ffi.Char> sidecarPath,
+  ) {
+    return _encoder_set_overview(
+      self,
+      pOverview,
+      sidecarPath,
+    );
+  }
+
+  late final _encoder_set_overviewPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Char>)>>('encoder_set_overview');
+  late final _encoder_set_overview = _encoder_set_overviewPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Char>)>();
+
+  /// Feeds the output into a waveform overview, see `overview_create`.
+  bool playback_device_set_overview(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<ffi.Void> pOverview,
+  ) {
+    return _playback_device_set_overview(
+      self,
+      pOverview,
+    );
+  }
+
+  late final _playback_device_set_overviewPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>)>>('playback_device_set_overview');
+  late final _playback_device_set_overview = _playback_device_set_overviewPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>)>();
+
+  /// Sets the DSP chain applied to the output.
+  bool playback_device_set_dsp_chain(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<playback_dsp_stage_t> pStages,
+    int stageCount,
+  ) {
+    return _playback_device_set_dsp_chain(
+      self,
+      pStages,
+      stageCount,
+    );
+  }
+
+  late final _playback_device_set_dsp_chainPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_dsp_stage_t>, ffi.Uint32)>>('playback_device_set_dsp_chain');
+  late final _playback_device_set_dsp_chain = _playback_device_set_dsp_chainPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_dsp_stage_t>, int)>();
+
+  /// Changes the parameters of a stage of the DSP chain at runtime.
+  bool playback_device_update_dsp_stage(
+    ffi.Pointer<ffi.Void> self,
+    int stageIndex,
+    ffi.Pointer<playback_dsp_stage_t> pStage,
+  ) {
+    return _playback_device_update_dsp_stage(
+      self,
+      stageIndex,
+      pStage,
+    );
+  }
+
+  late final _playback_device_update_dsp_stagePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Uint32, ffi.Pointer<playback_dsp_stage_t>)>>('playback_device_update_dsp_stage');
+  late final _playback_device_update_dsp_stage = _playback_device_update_dsp_stagePtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, int, ffi.Pointer<playback_dsp_stage_t>)>();
+
+  /// Sets the linear gain applied to the output.
+  bool playback_device_set_volume(
+    ffi.Pointer<ffi.Void> self,
+    double volume,
+  ) {
+    return _playback_device_set_volume(
+      self,
+      volume,
+    );
+  }
+
+  late final _playback_device_set_volumePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Float)>>('playback_device_set_volume');
+  late final _playback_device_set_volume = _playback_device_set_volumePtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, double)>();
+
+  /// Retrieves the gain set with `playback_device_set_volume`.
+  double playback_device_get_volume(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _playback_device_get_volume(
+      self,
+    );
+  }
+
+  late final _playback_device_get_volumePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Float Function(ffi.Pointer<ffi.Void>)>>('playback_device_get_volume');
+  late final _playback_device_get_volume = _playback_device_get_volumePtr.asFunction<
+      double Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Mutes or unmutes the output without stopping the device.
+  void playback_device_set_muted(
+    ffi.Pointer<ffi.Void> self,
+    bool muted,
+  ) {
+    return _playback_device_set_muted(
+      self,
+      muted,
+    );
+  }
+
+  late final _playback_device_set_mutedPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>, ffi.Bool)>>('playback_device_set_muted');
+  late final _playback_device_set_muted = _playback_device_set_mutedPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>, bool)>();
+
+  /// Tells whether the output is muted.
+  bool playback_device_is_muted(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _playback_device_is_muted(
+      self,
+    );
+  }
+
+  late final _playback_device_is_mutedPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>)>>('playback_device_is_muted');
+  late final _playback_device_is_muted = _playback_device_is_mutedPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Exports the output as the reference signal of an echo canceller.
+  bool playback_device_set_reference_tap(
+    ffi.Pointer<ffi.Void> self,
+    int capacityFrames,
+  ) {
+    return _playback_device_set_reference_tap(
+      self,
+      capacityFrames,
+    );
+  }
+
+  late final _playback_device_set_reference_tapPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Uint32)>>('playback_device_set_reference_tap');
+  late final _playback_device_set_reference_tap = _playback_device_set_reference_tapPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, int)>();
+
+  /// Returns the oldest block of the reference tap, without copying.
+  ffi.Pointer<ffi.Void> playback_device_acquire_reference(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<playback_reference_block_t> pBlock,
+  ) {
+    return _playback_device_acquire_reference(
+      self,
+      pBlock,
+    );
+  }
+
+  late final _playback_device_acquire_referencePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_reference_block_t>)>>('playback_device_acquire_reference');
+  late final _playback_device_acquire_reference = _playback_device_acquire_referencePtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_reference_block_t>)>();
+
+  /// Releases the block returned by `playback_device_acquire_reference`.
+  void playback_device_release_reference(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _playback_device_release_reference(
+      self,
+    );
+  }
+
+  late final _playback_device_release_referencePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>)>>('playback_device_release_reference');
+  late final _playback_device_release_reference = _playback_device_release_referencePtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Detects silence in the frames the device consumes.
+  bool playback_device_set_silence_detection(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<playback_silence_config_t> pConfig,
+  ) {
+    return _playback_device_set_silence_detection(
+      self,
+      pConfig,
+    );
+  }
+
+  late final _playback_device_set_silence_detectionPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_silence_config_t>)>>('playback_device_set_silence_detection');
+  late final _playback_device_set_silence_detection = _playback_device_set_silence_detectionPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_silence_config_t>)>();
+
+  /// Reads what the silence detector measured, without locking.
+  bool playback_device_get_silence_stats(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<playback_silence_stats_t> pStats,
+  ) {
+    return _playback_device_get_silence_stats(
+      self,
+      pStats,
+    );
+  }
+
+  late final _playback_device_get_silence_statsPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_silence_stats_t>)>>('playback_device_get_silence_stats');
+  late final _playback_device_get_silence_stats = _playback_device_get_silence_statsPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_silence_stats_t>)>();
+
+  /// Records a stretch of silence instead of encoding it.
+  int encoder_write_gap(
+    ffi.Pointer<ffi.Void> self,
+    int frameCount,
+  ) {
+    return _encoder_write_gap(
+      self,
+      frameCount,
+    );
+  }
+
+  late final _encoder_write_gapPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint64 Function(ffi.Pointer<ffi.Void>, ffi.Uint64)>>('encoder_write_gap');
+  late final _encoder_write_gap = _encoder_write_gapPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>, int)>();
+
+  /// Lists the gaps recorded with `encoder_write_gap`, in stream order.
+  int encoder_get_gaps(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<encoder_gap_t> pGaps,
+    int capacity,
+  ) {
+    return _encoder_get_gaps(
+      self,
+      pGaps,
+      capacity,
+    );
+  }
+
+  late final _encoder_get_gapsPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint32 Function(ffi.Pointer<ffi.Void>, ffi.Pointer<encoder_gap_t>, ffi.Uint32)>>('encoder_get_gaps');
+  late final _encoder_get_gaps = _encoder_get_gapsPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>, ffi.Pointer<encoder_gap_t>, int)>();
+
+  /// Creates a group that plays one stream on several devices in sync.
+  ffi.Pointer<ffi.Void> playback_group_create(
+    ffi.Pointer<ffi.Void> pContext,
+    ffi.Pointer<playback_group_config_t> pConfig,
+  ) {
+    return _playback_group_create(
+      pContext,
+      pConfig,
+    );
+  }
+
+  late final _playback_group_createPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_group_config_t>)>>('playback_group_create');
+  late final _playback_group_create = _playback_group_createPtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_group_config_t>)>();
+
+  /// Destroys a group and its devices.
+  void playback_group_destroy(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _playback_group_destroy(
+      self,
+    );
+  }
+
+  late final _playback_group_destroyPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>)>>('playback_group_destroy');
+  late final _playback_group_destroy = _playback_group_destroyPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Opens a device and adds it as an output of a stopped group.
+  int playback_group_add_output(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<device_id> pDeviceId,
+  ) {
+    return _playback_group_add_output(
+      self,
+      pDeviceId,
+    );
+  }
+
+  late final _playback_group_add_outputPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(ffi.Pointer<ffi.Void>, ffi.Pointer<device_id>)>>('playback_group_add_output');
+  late final _playback_group_add_output = _playback_group_add_outputPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>, ffi.Pointer<device_id>)>();
+
+  /// Retrieves the number of outputs of a group.
+  int playback_group_get_output_count(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _playback_group_get_output_count(
+      self,
+    );
+  }
+
+  late final _playback_group_get_output_countPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint32 Function(ffi.Pointer<ffi.Void>)>>('playback_group_get_output_count');
+  late final _playback_group_get_output_count = _playback_group_get_output_countPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Starts every output of a group.
+  void playback_group_start(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _playback_group_start(
+      self,
+    );
+  }
+
+  late final _playback_group_startPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>)>>('playback_group_start');
+  late final _playback_group_start = _playback_group_startPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Stops every output of a group. Queued frames are kept.
+  void playback_group_stop(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _playback_group_stop(
+      self,
+    );
+  }
+
+  late final _playback_group_stopPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>)>>('playback_group_stop');
+  late final _playback_group_stop = _playback_group_stopPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Retrieves the state of a group.
+  device_state_t playback_group_get_state(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return device_state_t.fromValue(_playback_group_get_state(
+      self,
+    ));
+  }
+
+  late final _playback_group_get_statePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.UnsignedInt Function(ffi.Pointer<ffi.Void>)>>('playback_group_get_state');
+  late final _playback_group_get_state = _playback_group_get_statePtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Pushes frames to every output of a group. Never blocks.
+  int playback_group_push(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<ffi.Void> pData,
+    int sizeInBytes,
+  ) {
+    return _playback_group_push(
+      self,
+      pData,
+      sizeInBytes,
+    );
+  }
+
+  late final _playback_group_pushPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint32 Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>, ffi.Uint32)>>('playback_group_push');
+  late final _playback_group_push = _playback_group_pushPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>, int)>();
+
+  /// Retrieves the state of one output of a group.
+  bool playback_group_get_output_stats(
+    ffi.Pointer<ffi.Void> self,
+    int index,
+    ffi.Pointer<playback_group_output_stats_t> pStats,
+  ) {
+    return _playback_group_get_output_stats(
+      self,
+      index,
+      pStats,
+    );
+  }
+
+  late final _playback_group_get_output_statsPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Uint32, ffi.Pointer<playback_group_output_stats_t>)>>('playback_group_get_output_stats');
+  late final _playback_group_get_output_stats = _playback_group_get_output_statsPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, int, ffi.Pointer<playback_group_output_stats_t>)>();
+
+  /// Moves playback to another output without losing buffered audio.
+  bool playback_device_migrate(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<device_id> pDeviceId,
+    ffi.Pointer<playback_migration_t> pResult,
+  ) {
+    return _playback_device_migrate(
+      self,
+      pDeviceId,
+      pResult,
+    );
+  }
+
+  late final _playback_device_migratePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<device_id>, ffi.Pointer<playback_migration_t>)>>('playback_device_migrate');
+  late final _playback_device_migrate = _playback_device_migratePtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<device_id>, ffi.Pointer<playback_migration_t>)>();
+
+  /// Sets how a playback device handles interruptions.
+  bool playback_device_set_interruption_policy(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<playback_interruption_policy_t> pPolicy,
+  ) {
+    return _playback_device_set_interruption_policy(
+      self,
+      pPolicy,
+    );
+  }
+
+  late final _playback_device_set_interruption_policyPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_interruption_policy_t>)>>('playback_device_set_interruption_policy');
+  late final _playback_device_set_interruption_policy = _playback_device_set_interruption_policyPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_interruption_policy_t>)>();
+
+  /// Retrieves the interruptions seen by a playback device.
+  bool playback_device_get_interruption_stats(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<playback_interruption_stats_t> pStats,
+  ) {
+    return _playback_device_get_interruption_stats(
+      self,
+      pStats,
+    );
+  }
+
+  late final _playback_device_get_interruption_statsPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_interruption_stats_t>)>>('playback_device_get_interruption_stats');
+  late final _playback_device_get_interruption_stats = _playback_device_get_interruption_statsPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_interruption_stats_t>)>();
+
+  /// Begins an interruption reported by the platform rather than the backend.
+  void playback_device_begin_interruption(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _playback_device_begin_interruption(
+      self,
+    );
+  }
+
+  late final _playback_device_begin_interruptionPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>)>>('playback_device_begin_interruption');
+  late final _playback_device_begin_interruption = _playback_device_begin_interruptionPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Ends an interruption begun with `playback_device_begin_interruption`.
+  void playback_device_end_interruption(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _playback_device_end_interruption(
+      self,
+    );
+  }
+
+  late final _playback_device_end_interruptionPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>)>>('playback_device_end_interruption');
+  late final _playback_device_end_interruption = _playback_device_end_interruptionPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Creates a new audio context with a backend priority list.
+  ffi.Pointer<ffi.Void> audio_context_create_ex(
+    ffi.Pointer<audio_context_config_t> pConfig,
+  ) {
+    return _audio_context_create_ex(
+      pConfig,
+    );
+  }
+
+  late final _audio_context_create_exPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(ffi.Pointer<audio_context_config_t>)>>('audio_context_create_ex');
+  late final _audio_context_create_ex = _audio_context_create_exPtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(ffi.Pointer<audio_context_config_t>)>();
+
+  /// Retrieves the time spent by each phase of starting an audio context.
+  bool audio_context_get_timings(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<audio_context_timings_t> pTimings,
+  ) {
+    return _audio_context_get_timings(
+      self,
+      pTimings,
+    );
+  }
+
+  late final _audio_context_get_timingsPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<audio_context_timings_t>)>>('audio_context_get_timings');
+  late final _audio_context_get_timings = _audio_context_get_timingsPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<audio_context_timings_t>)>();
+
+  /// Refreshes the list of available audio devices on the worker thread of the context.
+  bool audio_context_refresh_devices_async(
+    ffi.Pointer<ffi.Void> self,
+    audio_context_refresh_callback_t onComplete,
+    ffi.Pointer<ffi.Void> pUserData,
+  ) {
+    return _audio_context_refresh_devices_async(
+      self,
+      onComplete,
+      pUserData,
+    );
+  }
+
+  late final _audio_context_refresh_devices_asyncPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, audio_context_refresh_callback_t, ffi.Pointer<ffi.Void>)>>('audio_context_refresh_devices_async');
+  late final _audio_context_refresh_devices_async = _audio_context_refresh_devices_asyncPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, audio_context_refresh_callback_t, ffi.Pointer<ffi.Void>)>();
+
+  /// Retrieves the list of audio devices of a type on the worker thread of the context.
+  bool audio_context_get_device_infos_async(
+    ffi.Pointer<ffi.Void> self,
+    audio_device_type_t type,
+    audio_context_device_infos_callback_t onComplete,
+    ffi.Pointer<ffi.Void> pUserData,
+  ) {
+    return _audio_context_get_device_infos_async(
+      self,
+      type.value,
+      onComplete,
+      pUserData,
+    );
+  }
+
+  late final _audio_context_get_device_infos_asyncPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.UnsignedInt, audio_context_device_infos_callback_t, ffi.Pointer<ffi.Void>)>>('audio_context_get_device_infos_async');
+  late final _audio_context_get_device_infos_async = _audio_context_get_device_infos_asyncPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, int, audio_context_device_infos_callback_t, ffi.Pointer<ffi.Void>)>();
+
+  /// Retrieves extended information about an audio device on the worker thread of the context.
+  bool audio_context_get_device_info_ext_async(
+    ffi.Pointer<ffi.Void> self,
+    ffi.Pointer<ffi.Void> deviceId,
+    audio_context_device_info_ext_callback_t onComplete,
+    ffi.Pointer<ffi.Void> pUserData,
+  ) {
+    return _audio_context_get_device_info_ext_async(
+      self,
+      deviceId,
+      onComplete,
+      pUserData,
+    );
+  }
+
+  late final _audio_context_get_device_info_ext_asyncPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>, audio_context_device_info_ext_callback_t, ffi.Pointer<ffi.Void>)>>('audio_context_get_device_info_ext_async');
+  late final _audio_context_get_device_info_ext_async = _audio_context_get_device_info_ext_asyncPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Void>, audio_context_device_info_ext_callback_t, ffi.Pointer<ffi.Void>)>();
+
+  /// Opens and starts playback devices until `count` of them wait in the pool.
+  int playback_pool_warm(
+    ffi.Pointer<ffi.Void> pContext,
+    ffi.Pointer<device_id> pDeviceId,
+    ffi.Pointer<playback_config_t> pConfig,
+    int count,
+  ) {
+    return _playback_pool_warm(
+      pContext,
+      pDeviceId,
+      pConfig,
+      count,
+    );
+  }
+
+  late final _playback_pool_warmPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint32 Function(ffi.Pointer<ffi.Void>, ffi.Pointer<device_id>, ffi.Pointer<playback_config_t>, ffi.Uint32)>>('playback_pool_warm');
+  late final _playback_pool_warm = _playback_pool_warmPtr.asFunction<
+      int Function(ffi.Pointer<ffi.Void>, ffi.Pointer<device_id>, ffi.Pointer<playback_config_t>, int)>();
+
+  /// Takes a started playback device from the pool.
+  ffi.Pointer<ffi.Void> playback_pool_acquire(
+    ffi.Pointer<ffi.Void> pContext,
+    ffi.Pointer<device_id> pDeviceId,
+    ffi.Pointer<playback_config_t> pConfig,
+  ) {
+    return _playback_pool_acquire(
+      pContext,
+      pDeviceId,
+      pConfig,
+    );
+  }
+
+  late final _playback_pool_acquirePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Void>, ffi.Pointer<device_id>, ffi.Pointer<playback_config_t>)>>('playback_pool_acquire');
+  late final _playback_pool_acquire = _playback_pool_acquirePtr.asFunction<
+      ffi.Pointer<ffi.Void> Function(ffi.Pointer<ffi.Void>, ffi.Pointer<device_id>, ffi.Pointer<playback_config_t>)>();
+
+  /// Returns an acquired playback device to the pool without closing its stream.
+  bool playback_pool_release(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _playback_pool_release(
+      self,
+    );
+  }
+
+  late final _playback_pool_releasePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>)>>('playback_pool_release');
+  late final _playback_pool_release = _playback_pool_releasePtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Destroys the idle devices of the pool.
+  void playback_pool_drain(
+    ffi.Pointer<ffi.Void> pContext,
+  ) {
+    return _playback_pool_drain(
+      pContext,
+    );
+  }
+
+  late final _playback_pool_drainPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>)>>('playback_pool_drain');
+  late final _playback_pool_drain = _playback_pool_drainPtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Retrieves the state of the playback pool of a context.
+  bool playback_pool_get_stats(
+    ffi.Pointer<ffi.Void> pContext,
+    ffi.Pointer<playback_pool_stats_t> pStats,
+  ) {
+    return _playback_pool_get_stats(
+      pContext,
+      pStats,
+    );
+  }
+
+  late final _playback_pool_get_statsPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_pool_stats_t>)>>('playback_pool_get_stats');
+  late final _playback_pool_get_stats = _playback_pool_get_statsPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, ffi.Pointer<playback_pool_stats_t>)>();
+
+  /// Starts a playback device on the worker thread of its context.
+  bool playback_device_start_async(
+    ffi.Pointer<ffi.Void> self,
+    playback_transition_callback_t onComplete,
+    ffi.Pointer<ffi.Void> pUserData,
+  ) {
+    return _playback_device_start_async(
+      self,
+      onComplete,
+      pUserData,
+    );
+  }
+
+  late final _playback_device_start_asyncPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, playback_transition_callback_t, ffi.Pointer<ffi.Void>)>>('playback_device_start_async');
+  late final _playback_device_start_async = _playback_device_start_asyncPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, playback_transition_callback_t, ffi.Pointer<ffi.Void>)>();
+
+  /// Stops a playback device on the worker thread of its context.
+  bool playback_device_stop_async(
+    ffi.Pointer<ffi.Void> self,
+    playback_transition_callback_t onComplete,
+    ffi.Pointer<ffi.Void> pUserData,
+  ) {
+    return _playback_device_stop_async(
+      self,
+      onComplete,
+      pUserData,
+    );
+  }
+
+  late final _playback_device_stop_asyncPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, playback_transition_callback_t, ffi.Pointer<ffi.Void>)>>('playback_device_stop_async');
+  late final _playback_device_stop_async = _playback_device_stop_asyncPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, playback_transition_callback_t, ffi.Pointer<ffi.Void>)>();
+
+  /// Pauses playback without stopping the backend stream.
+  void playback_device_pause(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _playback_device_pause(
+      self,
+    );
+  }
+
+  late final _playback_device_pausePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>)>>('playback_device_pause');
+  late final _playback_device_pause = _playback_device_pausePtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Resumes a paused device at the next callback.
+  void playback_device_resume(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _playback_device_resume(
+      self,
+    );
+  }
+
+  late final _playback_device_resumePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<ffi.Void>)>>('playback_device_resume');
+  late final _playback_device_resume = _playback_device_resumePtr.asFunction<
+      void Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Checks whether a device is paused.
+  bool playback_device_is_paused(
+    ffi.Pointer<ffi.Void> self,
+  ) {
+    return _playback_device_is_paused(
+      self,
+    );
+  }
+
+  late final _playback_device_is_pausedPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>)>>('playback_device_is_paused');
+  late final _playback_device_is_paused = _playback_device_is_pausedPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>)>();
+
+  /// Resizes the ring buffer without stopping playback.
+  bool playback_device_resize_buffer(
+    ffi.Pointer<ffi.Void> self,
+    int sizeInBytes,
+  ) {
+    return _playback_device_resize_buffer(
+      self,
+      sizeInBytes,
+    );
+  }
+
+  late final _playback_device_resize_bufferPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<ffi.Void>, ffi.Size)>>('playback_device_resize_buffer');
+  late final _playback_device_resize_buffer = _playback_device_resize_bufferPtr.asFunction<
+      bool Function(ffi.Pointer<ffi.Void>, int)>();
+
   late final addresses = _SymbolAddresses(this);
 }
 
-class _SymbolAddresses {
-  final ProMiniaudioBindings _library;
-  _SymbolAddresses(this._library);
-  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>
-      get audio_context_destroy => _library._audio_context_destroyPtr;
-  ffi.Pointer<
-          ffi.NativeFunction<ffi.Void Function(ffi.Pointer<device_infos_t>)>>
-      get audio_context_device_infos_destroy =>
-          _library._audio_context_device_infos_destroyPtr;
-  ffi.Pointer<
-          ffi.NativeFunction<ffi.Void Function(ffi.Pointer<device_info_ext_t>)>>
-      get audio_context_device_info_ext_destroy =>
-          _library._audio_context_device_info_ext_destroyPtr;
-  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>
-      get waveform_destroy => _library._waveform_destroyPtr;
-  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>
-      get encoder_destroy => _library._encoder_destroyPtr;
+class _SymbolAddresses {
+  final ProMiniaudioBindings _library;
+  _SymbolAddresses(this._library);
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>
+      get audio_context_destroy => _library._audio_context_destroyPtr;
+  ffi.Pointer<
+          ffi.NativeFunction<ffi.Void Function(ffi.Pointer<device_infos_t>)>>
+      get audio_context_device_infos_destroy =>
+          _library._audio_context_device_infos_destroyPtr;
+  ffi.Pointer<
+          ffi.NativeFunction<ffi.Void Function(ffi.Pointer<device_info_ext_t>)>>
+      get audio_context_device_info_ext_destroy =>
+          _library._audio_context_device_info_ext_destroyPtr;
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>
+      get waveform_destroy => _library._waveform_destroyPtr;
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>
+      get encoder_destroy => _library._encoder_destroyPtr;
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>
+      get waveform_bank_destroy => _library._waveform_bank_destroyPtr;
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>
+      get decoder_destroy => _library._decoder_destroyPtr;
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>
+      get mapped_wav_destroy => _library._mapped_wav_destroyPtr;
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>
+      get encoder_free_chunk => _library._encoder_free_chunkPtr;
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Void>)>>
+      get overview_destroy => _library._overview_destroyPtr;
+}
+
+/// Enumeration to represent common audio sample formats.
+enum pcm_format_t {
+  /// Unknown or unsupported PCM format.
+  pcm_format_unknown(0),
+
+  /// Unsigned 8-bit integer.
+  pcm_format_u8(1),
+
+  /// Signed 16-bit integer.
+  pcm_format_s16(2),
+
+  /// Signed 24-bit integer.
+  pcm_format_s24(3),
+
+  /// Signed 32-bit integer.
+  pcm_format_s32(4),
+
+  /// 32-bit floating point.
+  pcm_format_f32(5),
+
+  /// Total number of supported PCM formats.
+  pcm_format_count(6);
+
+  final int value;
+  const pcm_format_t(this.value);
+
+  static pcm_format_t fromValue(int value) => switch (value) {
+        0 => pcm_format_unknown,
+        1 => pcm_format_u8,
+        2 => pcm_format_s16,
+        3 => pcm_format_s24,
+        4 => pcm_format_s32,
+        5 => pcm_format_f32,
+        6 => pcm_format_count,
+        _ => throw ArgumentError("Unknown value for pcm_format_t: $value"),
+      };
+}
+
+/// Describes an audio data format.
+final class audio_format_t extends ffi.Struct {
+  /// The PCM sample format (e.g., 16-bit integer).
+  @ffi.UnsignedInt()
+  external int pcmFormatAsInt;
+
+  pcm_format_t get pcmFormat => pcm_format_t.fromValue(pcmFormatAsInt);
+
+  /// The number of audio channels (e.g., 1 for mono, 2 for stereo).
+  @ffi.Uint32()
+  external int channels;
+
+  /// The sample rate in Hertz (e.g., 44100 Hz).
+  @ffi.Uint32()
+  external int sampleRate;
+}
+
+final class UnnamedUnion1 extends ffi.Union {
+  @ffi.Int()
+  external int i;
+
+  @ffi.Array.multi([256])
+  external ffi.Array<ffi.Char> s;
+
+  external ffi.Pointer<ffi.Void> p;
+}
+
+final class device_id extends ffi.Union {
+  @ffi.Array.multi([64])
+  external ffi.Array<ffi.UnsignedShort> wasapi;
+
+  @ffi.Array.multi([16])
+  external ffi.Array<ffi.UnsignedChar> dsound;
+
+  @ffi.UnsignedInt()
+  external int winmm;
+
+  @ffi.Array.multi([256])
+  external ffi.Array<ffi.Char> alsa;
+
+  @ffi.Array.multi([256])
+  external ffi.Array<ffi.Char> pulse;
+
+  @ffi.Int()
+  external int jack;
+
+  @ffi.Array.multi([256])
+  external ffi.Array<ffi.Char> coreaudio;
+
+  @ffi.Array.multi([256])
+  external ffi.Array<ffi.Char> sndio;
+
+  @ffi.Array.multi([256])
+  external ffi.Array<ffi.Char> audio4;
+
+  @ffi.Array.multi([64])
+  external ffi.Array<ffi.Char> oss;
+
+  @ffi.Int()
+  external int aaudio;
+
+  @ffi.UnsignedInt()
+  external int opensl;
+
+  @ffi.Array.multi([32])
+  external ffi.Array<ffi.Char> webaudio;
+
+  external UnnamedUnion1 custom;
+
+  @ffi.Int()
+  external int nullbackend;
+}
+
+/// Provides detailed information about an audio device.
+final class device_info_t extends ffi.Struct {
+  /// Unique identifier for the device.
+  external device_id id;
+
+  /// Null-terminated string representing the device name.
+  @ffi.Array.multi([256])
+  external ffi.Array<ffi.Char> name;
+
+  /// Indicates whether this is the default device.
+  @ffi.Bool()
+  external bool isDefault;
+}
+
+/// Defines the type of the audio device.
+enum audio_device_type_t {
+  /// Playback device.
+  device_type_playback(1),
+
+  /// Capture device.
+  device_type_capture(2),
+
+  /// Duplex device.
+  device_type_duplex(3),
+
+  /// Loopback device.
+  device_type_loopback(4);
+
+  final int value;
+  const audio_device_type_t(this.value);
+
+  static audio_device_type_t fromValue(int value) => switch (value) {
+        1 => device_type_playback,
+        2 => device_type_capture,
+        3 => device_type_duplex,
+        4 => device_type_loopback,
+        _ =>
+          throw ArgumentError("Unknown value for audio_device_type_t: $value"),
+      };
+}
+
+final class device_infos_t extends ffi.Struct {
+  @ffi.UnsignedInt()
+  external int typeAsInt;
+
+  audio_device_type_t get type => audio_device_type_t.fromValue(typeAsInt);
+
+  external ffi.Pointer<device_info_t> list;
+
+  @ffi.Uint32()
+  external int count;
+}
+
+/// Provides extended information about an audio device.
+final class device_info_ext_t extends ffi.Struct {
+  /// Array of supported audio formats.
+  external ffi.Pointer<audio_format_t> list;
+
+  /// Number of supported audio formats.
+  @ffi.Uint32()
+  external int count;
+}
+
+/// Defines the severity levels for log messages.
+enum log_level_t {
+  /// Debug level: Detailed information for debugging purposes.
+  log_level_debug(0),
+
+  /// Info level: General informational messages.
+  log_level_info(1),
+
+  /// Warning level: Potential issues that are non-critical.
+  log_level_warning(2),
+
+  /// Error level: Critical issues requiring immediate attention.
+  log_level_error(3);
+
+  final int value;
+  const log_level_t(this.value);
+
+  static log_level_t fromValue(int value) => switch (value) {
+        0 => log_level_debug,
+        1 => log_level_info,
+        2 => log_level_warning,
+        3 => log_level_error,
+        _ => throw ArgumentError("Unknown value for log_level_t: $value"),
+      };
+}
+
+/// Configuration structure for a playback device.
+final class playback_config_t extends ffi.Struct {
+  /// Number of audio channels (e.g., 2 for stereo).
+  @ffi.Uint32()
+  external int channels;
+
+  /// Sample rate in Hertz (e.g., 44100 Hz).
+  @ffi.Uint32()
+  external int sampleRate;
+
+  /// PCM format of the audio data (e.g., `pcm_format_s16`).
+  @ffi.UnsignedInt()
+  external int pcmFormatAsInt;
+
+  pcm_format_t get pcmFormat => pcm_format_t.fromValue(pcmFormatAsInt);
+
+  /// Maximum threshold for the ring buffer.
+  @ffi.Size()
+  external int rbMaxThreshold;
+
+  /// Minimum threshold for the ring buffer.
+  @ffi.Size()
+  external int rbMinThreshold;
+
+  /// Total size of the ring buffer in bytes.
+  @ffi.Size()
+  external int rbSizeInBytes;
+}
+
+/// Represents audio data to be pushed to a playback device.
+final class playback_data_t extends ffi.Struct {
+  /// Pointer to the audio data to be played.
+  external ffi.Pointer<ffi.Void> pUserData;
+
+  /// Size of the audio data in bytes.
+  @ffi.Uint32()
+  external int sizeInBytes;
 }
 
-/// Enumeration to represent common audio sample formats.
-enum pcm_format_t {
-  /// Unknown or unsupported PCM format.
-  pcm_format_unknown(0),
+/// Represents the states of an audio device.
+enum device_state_t {
+  /// The device is not initialized.
+  device_state_uninitialized(0),
 
-  /// Unsigned 8-bit integer.
-  pcm_format_u8(1),
+  /// The device is initialized but not started.
+  device_state_stopped(1),
 
-  /// Signed 16-bit integer.
-  pcm_format_s16(2),
+  /// The device is active and processing audio data.
+  device_state_started(2),
 
-  /// Signed 24-bit integer.
-  pcm_format_s24(3),
+  /// The device is transitioning from stopped to started.
+  device_state_starting(3),
 
-  /// Signed 32-bit integer.
-  pcm_format_s32(4),
+  /// The device is transitioning from started to stopped.
+  device_state_stopping(4);
 
-  /// 32-bit floating point.
-  pcm_format_f32(5),
+  final int value;
+  const device_state_t(this.value);
 
-  /// Total number of supported PCM formats.
-  pcm_format_count(6);
+  static device_state_t fromValue(int value) => switch (value) {
+        0 => device_state_uninitialized,
+        1 => device_state_stopped,
+        2 => device_state_started,
+        3 => device_state_starting,
+        4 => device_state_stopping,
+        _ => throw ArgumentError("Unknown value for device_state_t: $value"),
+      };
+}
+
+/// Represents the types of waveforms that can be generated.
+enum waveform_type_t {
+  /// Sine waveform.
+  waveform_type_sine(0),
+
+  /// Square waveform.
+  waveform_type_square(1),
+
+  /// Triangle waveform.
+  waveform_type_triangle(2),
+
+  /// Sawtooth waveform.
+  waveform_type_sawtooth(3);
 
   final int value;
-  const pcm_format_t(this.value);
+  const waveform_type_t(this.value);
 
-  static pcm_format_t fromValue(int value) => switch (value) {
-        0 => pcm_format_unknown,
-        1 => pcm_format_u8,
-        2 => pcm_format_s16,
-        3 => pcm_format_s24,
-        4 => pcm_format_s32,
-        5 => pcm_format_f32,
-        6 => pcm_format_count,
-        _ => throw ArgumentError("Unknown value for pcm_format_t: $value"),
+  static waveform_type_t fromValue(int value) => switch (value) {
+        0 => waveform_type_sine,
+        1 => waveform_type_square,
+        2 => waveform_type_triangle,
+        3 => waveform_type_sawtooth,
+        _ => throw ArgumentError("Unknown value for waveform_type_t: $value"),
       };
 }
 
-/// Describes an audio data format.
-final class audio_format_t extends ffi.Struct {
-  /// The PCM sample format (e.g., 16-bit integer).
+typedef u_int32_t = ffi.UnsignedInt;
+typedef Dartu_int32_t = int;
+
+final class encoder_config_t extends ffi.Struct {
+  /// Number of audio channels (e.g., 2 for stereo).
+  @ffi.Uint32()
+  external int channels;
+
+  /// Sample rate in Hertz (e.g., 44100 Hz).
+  @ffi.Uint32()
+  external int sampleRate;
+
+  /// PCM format of the audio data (e.g., `pcm_format_s16`).
   @ffi.UnsignedInt()
   external int pcmFormatAsInt;
 
   pcm_format_t get pcmFormat => pcm_format_t.fromValue(pcmFormatAsInt);
 
-  /// The number of audio channels (e.g., 1 for mono, 2 for stereo).
+  /// Format of the samples in the file.
+  @ffi.UnsignedInt()
+  external int storageAsInt;
+
+  encoder_storage_t get storage => encoder_storage_t.fromValue(storageAsInt);
+}
+
+/// Describes how the oscillators of a bank are written to the output.
+enum waveform_bank_mix_t {
+  /// Each oscillator is written to its own channel.
+  waveform_bank_mix_interleaved(0),
+
+  /// All oscillators are summed and the sum is written to every channel.
+  waveform_bank_mix_summed(1);
+
+  final int value;
+  const waveform_bank_mix_t(this.value);
+
+  static waveform_bank_mix_t fromValue(int value) => switch (value) {
+        0 => waveform_bank_mix_interleaved,
+        1 => waveform_bank_mix_summed,
+        _ =>
+          throw ArgumentError("Unknown value for waveform_bank_mix_t: $value"),
+      };
+}
+
+/// Output configuration of a waveform bank.
+final class waveform_bank_config_t extends ffi.Struct {
+  /// PCM format of the output (e.g., `pcm_format_f32`).
+  @ffi.UnsignedInt()
+  external int pcmFormatAsInt;
+
+  pcm_format_t get pcmFormat => pcm_format_t.fromValue(pcmFormatAsInt);
+
+  /// Output channels for `waveform_bank_mix_summed`. Ignored when interleaved, where every oscillator is a channel.
+  @ffi.Uint32()
+  external int channels;
+
+  /// Sample rate in Hertz (e.g., 44100 Hz).
+  @ffi.Uint32()
+  external int sampleRate;
+
+  /// How oscillators are written to the output.
+  @ffi.UnsignedInt()
+  external int mixAsInt;
+
+  waveform_bank_mix_t get mix => waveform_bank_mix_t.fromValue(mixAsInt);
+}
+
+/// Parameters of a single oscillator in a waveform bank.
+final class waveform_bank_oscillator_t extends ffi.Struct {
+  /// Waveform shape of the oscillator.
+  @ffi.UnsignedInt()
+  external int typeAsInt;
+
+  waveform_type_t get type => waveform_type_t.fromValue(typeAsInt);
+
+  /// Amplitude, typically in the range [0.0, 1.0].
+  @ffi.Double()
+  external double amplitude;
+
+  /// Frequency in Hertz.
+  @ffi.Double()
+  external double frequency;
+}
+
+/// Output configuration of a streaming decoder.
+final class decoder_config_t extends ffi.Struct {
+  /// PCM format of the output (e.g., `pcm_format_f32`).
+  @ffi.UnsignedInt()
+  external int pcmFormatAsInt;
+
+  pcm_format_t get pcmFormat => pcm_format_t.fromValue(pcmFormatAsInt);
+
+  /// Number of output channels (e.g., 2 for stereo).
+  @ffi.Uint32()
+  external int channels;
+
+  /// Output sample rate in Hertz (e.g., 44100 Hz).
+  @ffi.Uint32()
+  external int sampleRate;
+
+  /// Frames decoded ahead of the reader. 0 selects half a second.
+  @ffi.Uint32()
+  external int lookaheadFrames;
+}
+
+/// Receives an encoded chunk from a callback encoder.
+typedef encoder_chunk_callback_t
+    = ffi.Pointer<ffi.NativeFunction<encoder_chunk_callback_tFunction>>;
+typedef encoder_chunk_callback_tFunction = ffi.Void Function(
+    ffi.Pointer<ffi.Void> pUserData,
+    ffi.Pointer<ffi.Void> pData,
+    ffi.Size sizeInBytes,
+    ffi.Uint64 offset);
+typedef Dartencoder_chunk_callback_tFunction = void Function(
+    ffi.Pointer<ffi.Void> pUserData,
+    ffi.Pointer<ffi.Void> pData,
+    int sizeInBytes,
+    int offset);
+
+/// Receives a completed segment from a segmented encoder.
+typedef encoder_segment_callback_t
+    = ffi.Pointer<ffi.NativeFunction<encoder_segment_callback_tFunction>>;
+typedef encoder_segment_callback_tFunction = ffi.Void Function(
+    ffi.Pointer<ffi.Void> pUserData,
+    ffi.Uint32 index,
+    ffi.Uint64 firstFrame,
+    ffi.Uint64 frameCount,
+    ffi.Uint64 sizeInBytes,
+    ffi.Bool isLast);
+typedef Dartencoder_segment_callback_tFunction = void Function(
+    ffi.Pointer<ffi.Void> pUserData,
+    int index,
+    int firstFrame,
+    int frameCount,
+    int sizeInBytes,
+    bool isLast);
+
+/// When a writer encoder forces written blocks to stable storage.
+enum encoder_fsync_policy_t {
+  /// Leave flushing to the operating system.
+  encoder_fsync_never(0),
+
+  /// Sync once when the encoder is finalized.
+  encoder_fsync_on_close(1),
+
+  /// Sync every `fsyncIntervalBytes` and on close.
+  encoder_fsync_interval(2);
+
+  final int value;
+  const encoder_fsync_policy_t(this.value);
+
+  static encoder_fsync_policy_t fromValue(int value) => switch (value) {
+        0 => encoder_fsync_never,
+        1 => encoder_fsync_on_close,
+        2 => encoder_fsync_interval,
+        _ =>
+          throw ArgumentError("Unknown value for encoder_fsync_policy_t: $value"),
+      };
+}
+
+/// Configuration of the block writer used by `encoder_create_writer`.
+final class encoder_writer_config_t extends ffi.Struct {
+  /// Bytes collected per write, rounded up to 4 KiB. 0 selects 1 MiB.
+  @ffi.Size()
+  external int blockSize;
+
+  /// Extent reserved ahead of the written data. 0 disables preallocation.
+  @ffi.Uint64()
+  external int preallocateSize;
+
+  /// Bypass the page cache where the platform and file system allow it.
+  @ffi.Bool()
+  external bool useDirectIo;
+
+  /// When written data is synced to storage.
+  @ffi.UnsignedInt()
+  external int fsyncPolicyAsInt;
+
+  encoder_fsync_policy_t get fsyncPolicy =>
+      encoder_fsync_policy_t.fromValue(fsyncPolicyAsInt);
+
+  /// Bytes between syncs for `encoder_fsync_interval`.
+  @ffi.Uint64()
+  external int fsyncIntervalBytes;
+}
+
+/// When a segmented encoder rolls over to a new file.
+final class encoder_segment_config_t extends ffi.Struct {
+  /// Length of a segment in seconds. 0 for no time limit.
+  @ffi.Uint32()
+  external int segmentSeconds;
+
+  /// Maximum size of a segment file. 0 for no size limit.
+  @ffi.Uint64()
+  external int segmentBytes;
+
+  /// Write segments with the block writer instead of stdio.
+  @ffi.Bool()
+  external bool useWriter;
+
+  /// Block writer configuration, used when `useWriter` is set.
+  external encoder_writer_config_t writerConfig;
+}
+
+/// I/O statistics of a writer encoder.
+final class encoder_writer_stats_t extends ffi.Struct {
+  /// Bytes passed to write calls, including alignment padding.
+  @ffi.Uint64()
+  external int bytesWritten;
+
+  /// Number of write system calls.
+  @ffi.Uint64()
+  external int writeCalls;
+
+  /// Number of reads of already written blocks, e.g. for the header patch.
+  @ffi.Uint64()
+  external int readCalls;
+
+  /// Number of preallocation system calls.
+  @ffi.Uint64()
+  external int preallocateCalls;
+
+  /// Number of sync system calls.
+  @ffi.Uint64()
+  external int syncCalls;
+
+  /// Time spent in the system calls above.
+  @ffi.Double()
+  external double ioSeconds;
+
+  /// `bytesWritten` in MB (10^6 bytes) divided by `ioSeconds`.
+  @ffi.Double()
+  external double megabytesPerSecond;
+
+  /// Whether the page cache is actually bypassed.
+  @ffi.Bool()
+  external bool isDirectIo;
+}
+
+/// How samples are stored in the encoded file.
+enum encoder_storage_t {
+  /// PCM in `pcmFormat`, as the frames are written.
+  encoder_storage_pcm(0),
+
+  /// 16-bit PCM, converted from `pcmFormat` while encoding.
+  encoder_storage_pcm_s16(1),
+
+  /// 4-bit IMA ADPCM, about a quarter of 16-bit PCM. Mono or stereo only.
+  encoder_storage_ima_adpcm(2);
+
+  final int value;
+  const encoder_storage_t(this.value);
+
+  static encoder_storage_t fromValue(int value) => switch (value) {
+        0 => encoder_storage_pcm,
+        1 => encoder_storage_pcm_s16,
+        2 => encoder_storage_ima_adpcm,
+        _ =>
+          throw ArgumentError("Unknown value for encoder_storage_t: $value"),
+      };
+}
+
+/// Kinds of events posted by a playback device.
+enum playback_event_type_t {
+  /// The ring buffer fell below the low watermark.
+  playback_event_need_data(0),
+
+  /// The ring buffer ran dry and silence was output.
+  playback_event_underrun(1),
+
+  /// The device started or stopped.
+  playback_event_state_changed(2),
+
+  /// The device was moved to another output.
+  playback_event_rerouted(3),
+
+  /// Last event before the callback is released.
+  playback_event_closed(4),
+
+  /// The system took the output away, e.g. for a call.
+  playback_event_interruption_began(5),
+
+  /// The output is back, see `playback_interruption_policy_t`.
+  playback_event_interruption_ended(6);
+
+  final int value;
+  const playback_event_type_t(this.value);
+
+  static playback_event_type_t fromValue(int value) => switch (value) {
+        0 => playback_event_need_data,
+        1 => playback_event_underrun,
+        2 => playback_event_state_changed,
+        3 => playback_event_rerouted,
+        4 => playback_event_closed,
+        5 => playback_event_interruption_began,
+        6 => playback_event_interruption_ended,
+        _ =>
+          throw ArgumentError("Unknown value for playback_event_type_t: $value"),
+      };
+}
+
+/// Receives an event from a playback device.
+typedef playback_event_callback_t
+    = ffi.Pointer<ffi.NativeFunction<playback_event_callback_tFunction>>;
+typedef playback_event_callback_tFunction = ffi.Void Function(
+    ffi.Pointer<ffi.Void> pUserData,
+    ffi.UnsignedInt type,
+    ffi.UnsignedInt state,
+    ffi.Uint32 availableBytes);
+typedef Dartplayback_event_callback_tFunction = void Function(
+    ffi.Pointer<ffi.Void> pUserData,
+    int type,
+    int state,
+    int availableBytes);
+
+/// Receives the outcome of a start or stop queued on the context worker.
+typedef playback_transition_callback_t
+    = ffi.Pointer<ffi.NativeFunction<playback_transition_callback_tFunction>>;
+typedef playback_transition_callback_tFunction = ffi.Void Function(
+    ffi.Pointer<ffi.Void> pUserData, ffi.Bool isSuccess, ffi.UnsignedInt state);
+typedef Dartplayback_transition_callback_tFunction = void Function(
+    ffi.Pointer<ffi.Void> pUserData, bool isSuccess, int state);
+
+/// Levels of the audio a playback device actually output.
+final class playback_meter_t extends ffi.Struct {
+  /// Number of measured channels.
+  @ffi.Uint32()
+  external int channels;
+
+  /// Sample peak per channel.
+  @ffi.Array.multi([8])
+  external ffi.Array<ffi.Float> peak;
+
+  /// RMS per channel, 300 ms time constant.
+  @ffi.Array.multi([8])
+  external ffi.Array<ffi.Float> rms;
+
+  /// 4x oversampled peak per channel (ITU-R BS.1770).
+  @ffi.Array.multi([8])
+  external ffi.Array<ffi.Float> truePeak;
+
+  /// EBU R128 momentary loudness, 400 ms window.
+  @ffi.Float()
+  external double momentaryLoudness;
+
+  /// EBU R128 short-term loudness, 3 s window.
+  @ffi.Float()
+  external double shortTermLoudness;
+
+  /// Frames measured since metering was enabled.
+  @ffi.Uint64()
+  external int framesMetered;
+}
+
+/// Window applied to each block before the FFT.
+enum spectrum_window_t {
+  /// No window: best resolution, most leakage.
+  spectrum_window_rectangular(0),
+
+  /// Good general-purpose window.
+  spectrum_window_hann(1),
+
+  /// Lower first side lobe than Hann.
+  spectrum_window_hamming(2),
+
+  /// 4-term window with very low leakage.
+  spectrum_window_blackman_harris(3);
+
+  final int value;
+  const spectrum_window_t(this.value);
+
+  static spectrum_window_t fromValue(int value) => switch (value) {
+        0 => spectrum_window_rectangular,
+        1 => spectrum_window_hann,
+        2 => spectrum_window_hamming,
+        3 => spectrum_window_blackman_harris,
+        _ =>
+          throw ArgumentError("Unknown value for spectrum_window_t: $value"),
+      };
+}
+
+/// Configuration of the spectrum analyzer of a playback device.
+final class spectrum_config_t extends ffi.Struct {
+  /// Power of two from 64 to 16384. 0 selects 2048.
+  @ffi.Uint32()
+  external int fftSize;
+
+  /// Frames between analyses. 0 selects `fftSize / 2`.
+  @ffi.Uint32()
+  external int hopSize;
+
+  /// Window applied before the FFT.
+  @ffi.UnsignedInt()
+  external int windowAsInt;
+
+  spectrum_window_t get window => spectrum_window_t.fromValue(windowAsInt);
+
+  /// 0 to 1, weight of the previous magnitudes, as in Web Audio.
+  @ffi.Float()
+  external double smoothing;
+}
+
+/// Configuration of a waveform overview.
+final class overview_config_t extends ffi.Struct {
+  /// PCM format of the written frames.
+  @ffi.UnsignedInt()
+  external int pcmFormatAsInt;
+
+  pcm_format_t get pcmFormat => pcm_format_t.fromValue(pcmFormatAsInt);
+
+  /// Number of channels.
   @ffi.Uint32()
   external int channels;
 
-  /// The sample rate in Hertz (e.g., 44100 Hz).
+  /// Sample rate in Hertz, kept for the sidecar file.
   @ffi.Uint32()
   external int sampleRate;
+
+  /// Frames per block of the finest level. 0 selects 256.
+  @ffi.Uint32()
+  external int blockFrames;
 }
 
-final class UnnamedUnion1 extends ffi.Union {
-  @ffi.Int()
-  external int i;
+/// Kinds of stages of a playback DSP chain.
+enum playback_dsp_type_t {
+  /// Biquad with explicit `coefficients`.
+  playback_dsp_biquad(0),
 
-  @ffi.Array.multi([256])
-  external ffi.Array<ffi.Char> s;
+  /// Butterworth low-pass of `order` at `frequency`.
+  playback_dsp_lowpass(1),
 
-  external ffi.Pointer<ffi.Void> p;
-}
+  /// Butterworth high-pass of `order` at `frequency`.
+  playback_dsp_highpass(2),
 
-final class device_id extends ffi.Union {
-  @ffi.Array.multi([64])
-  external ffi.Array<ffi.UnsignedShort> wasapi;
+  /// Band-pass of `order` centered on `frequency`.
+  playback_dsp_bandpass(3),
 
-  @ffi.Array.multi([16])
-  external ffi.Array<ffi.UnsignedChar> dsound;
+  /// Notch of quality `q` at `frequency`.
+  playback_dsp_notch(4),
+
+  /// Peaking EQ of `gainDb` and quality `q` at `frequency`.
+  playback_dsp_peaking(5),
 
+  /// Low shelf of `gainDb` and slope `q` below `frequency`.
+  playback_dsp_lowshelf(6),
+
+  /// High shelf of `gainDb` and slope `q` above `frequency`.
+  playback_dsp_highshelf(7),
+
+  /// Feedback delay of `delayFrames` with `decay`, `wet` and `dry`.
+  playback_dsp_delay(8),
+
+  /// Gain of `gainDb`, ramped over `smoothFrames`.
+  playback_dsp_gain(9);
+
+  final int value;
+  const playback_dsp_type_t(this.value);
+
+  static playback_dsp_type_t fromValue(int value) => switch (value) {
+        0 => playback_dsp_biquad,
+        1 => playback_dsp_lowpass,
+        2 => playback_dsp_highpass,
+        3 => playback_dsp_bandpass,
+        4 => playback_dsp_notch,
+        5 => playback_dsp_peaking,
+        6 => playback_dsp_lowshelf,
+        7 => playback_dsp_highshelf,
+        8 => playback_dsp_delay,
+        9 => playback_dsp_gain,
+        _ =>
+          throw ArgumentError("Unknown value for playback_dsp_type_t: $value"),
+      };
+}
+
+/// One stage of a playback DSP chain.
+final class playback_dsp_stage_t extends ffi.Struct {
+  /// Kind of stage.
   @ffi.UnsignedInt()
-  external int winmm;
+  external int typeAsInt;
 
-  @ffi.Array.multi([256])
-  external ffi.Array<ffi.Char> alsa;
+  playback_dsp_type_t get type => playback_dsp_type_t.fromValue(typeAsInt);
 
-  @ffi.Array.multi([256])
-  external ffi.Array<ffi.Char> pulse;
+  /// Filter order, 1 to 8 (even for band-pass). 0 selects 2.
+  @ffi.Uint32()
+  external int order;
 
-  @ffi.Int()
-  external int jack;
+  /// Cutoff or center frequency in Hertz.
+  @ffi.Double()
+  external double frequency;
 
-  @ffi.Array.multi([256])
-  external ffi.Array<ffi.Char> coreaudio;
+  /// Quality of notch and peaking filters, slope of shelves.
+  @ffi.Double()
+  external double q;
 
-  @ffi.Array.multi([256])
-  external ffi.Array<ffi.Char> sndio;
+  /// Gain of peaking, shelf and gain stages in dB.
+  @ffi.Double()
+  external double gainDb;
 
-  @ffi.Array.multi([256])
-  external ffi.Array<ffi.Char> audio4;
+  /// Length of a delay in frames.
+  @ffi.Uint32()
+  external int delayFrames;
 
-  @ffi.Array.multi([64])
-  external ffi.Array<ffi.Char> oss;
+  /// Feedback of a delay, 0 to below 1.
+  @ffi.Float()
+  external double decay;
 
-  @ffi.Int()
-  external int aaudio;
+  /// Level of the delayed signal.
+  @ffi.Float()
+  external double wet;
 
-  @ffi.UnsignedInt()
-  external int opensl;
+  /// Level of the direct signal.
+  @ffi.Float()
+  external double dry;
 
-  @ffi.Array.multi([32])
-  external ffi.Array<ffi.Char> webaudio;
+  /// Length of the gain ramp in frames.
+  @ffi.Uint32()
+  external int smoothFrames;
 
-  external UnnamedUnion1 custom;
+  /// Biquad `b0`, `b1`, `b2`, `a0`, `a1`, `a2`.
+  @ffi.Array.multi([6])
+  external ffi.Array<ffi.Double> coefficients;
+}
 
-  @ffi.Int()
-  external int nullbackend;
+/// Timing of a block of output frames exported by the reference tap.
+final class playback_reference_block_t extends ffi.Struct {
+  /// Index of the first frame among all frames output since the tap was set.
+  @ffi.Uint64()
+  external int framePosition;
+
+  /// Time the data callback started, in nanoseconds.
+  @ffi.Uint64()
+  external int timestampNs;
+
+  /// Estimated time the first frame reaches the speaker: `timestampNs` plus the latency.
+  @ffi.Uint64()
+  external int presentationNs;
+
+  /// Estimated frames between the data callback and the speaker.
+  @ffi.Uint32()
+  external int latencyFrames;
+
+  /// Number of frames in the block.
+  @ffi.Uint32()
+  external int frameCount;
+
+  /// Frames lost right before this block because the consumer fell behind.
+  @ffi.Uint32()
+  external int droppedFrames;
 }
 
-/// Provides detailed information about an audio device.
-final class device_info_t extends ffi.Struct {
-  /// Unique identifier for the device.
-  external device_id id;
+/// Configuration of the silence detector of a playback device.
+final class playback_silence_config_t extends ffi.Struct {
+  /// Peak level in dBFS below which a block is quiet. 0 selects -60.
+  @ffi.Float()
+  external double thresholdDb;
 
-  /// Null-terminated string representing the device name.
-  @ffi.Array.multi([256])
-  external ffi.Array<ffi.Char> name;
+  /// When above 0, a block is also quiet if its peak is within this margin above the noise floor.
+  @ffi.Float()
+  external double noiseFloorMarginDb;
 
-  /// Indicates whether this is the default device.
+  /// Quiet time before the output counts as silent, so that word endings are kept.
+  @ffi.Uint32()
+  external int holdMs;
+
+  /// Bypass the DSP chain while silent.
   @ffi.Bool()
-  external bool isDefault;
+  external bool skipProcessing;
+
+  /// Record silent blocks as gaps with `encoder_write_gap` instead of encoding them.
+  @ffi.Bool()
+  external bool compactRecording;
 }
 
-/// Defines the type of the audio device.
-enum audio_device_type_t {
-  /// Playback device.
-  device_type_playback(1),
+/// What the silence detector of a playback device measured.
+final class playback_silence_stats_t extends ffi.Struct {
+  /// Whether the last block was silent.
+  @ffi.Bool()
+  external bool isSilent;
 
-  /// Capture device.
-  device_type_capture(2),
+  /// Peak of the last block in dBFS.
+  @ffi.Float()
+  external double levelDb;
 
-  /// Duplex device.
-  device_type_duplex(3),
+  /// Estimated RMS noise floor in dBFS.
+  @ffi.Float()
+  external double noiseFloorDb;
 
-  /// Loopback device.
-  device_type_loopback(4);
+  /// Frames analyzed since the detector was set.
+  @ffi.Uint64()
+  external int totalFrames;
 
-  final int value;
-  const audio_device_type_t(this.value);
+  /// Frames classified as silent; divided by `totalFrames` gives the silent fraction.
+  @ffi.Uint64()
+  external int silentFrames;
+}
 
-  static audio_device_type_t fromValue(int value) => switch (value) {
-        1 => device_type_playback,
-        2 => device_type_capture,
-        3 => device_type_duplex,
-        4 => device_type_loopback,
-        _ =>
-          throw ArgumentError("Unknown value for audio_device_type_t: $value"),
-      };
+/// A stretch of silence left out of an encoded stream.
+final class encoder_gap_t extends ffi.Struct {
+  /// Frames of the stream that precede the gap.
+  @ffi.Uint64()
+  external int position;
+
+  /// Frames of silence the gap stands for.
+  @ffi.Uint64()
+  external int frameCount;
 }
 
-final class device_infos_t extends ffi.Struct {
+/// Configuration of a playback group.
+final class playback_group_config_t extends ffi.Struct {
+  /// PCM format of the pushed frames, `pcm_format_s16` or `pcm_format_f32`.
   @ffi.UnsignedInt()
-  external int typeAsInt;
+  external int pcmFormatAsInt;
 
-  audio_device_type_t get type => audio_device_type_t.fromValue(typeAsInt);
+  pcm_format_t get pcmFormat => pcm_format_t.fromValue(pcmFormatAsInt);
 
-  external ffi.Pointer<device_info_t> list;
+  /// Number of channels.
+  @ffi.Uint32()
+  external int channels;
 
+  /// Sample rate in Hertz.
   @ffi.Uint32()
-  external int count;
+  external int sampleRate;
+
+  /// Frames the shared ring holds. 0 selects one second.
+  @ffi.Uint32()
+  external int capacityFrames;
+
+  /// Frames each output keeps queued. 0 selects 50 ms.
+  @ffi.Uint32()
+  external int targetLatencyFrames;
 }
 
-/// Provides extended information about an audio device.
-final class device_info_ext_t extends ffi.Struct {
-  /// Array of supported audio formats.
-  external ffi.Pointer<audio_format_t> list;
+/// State of one output of a playback group.
+final class playback_group_output_stats_t extends ffi.Struct {
+  /// Frames output by the device, silence excluded.
+  @ffi.Uint64()
+  external int framesPlayed;
 
-  /// Number of supported audio formats.
+  /// Frames pushed but not yet read by the output.
   @ffi.Uint32()
-  external int count;
+  external int queuedFrames;
+
+  /// Estimated frames between the callback and the speaker.
+  @ffi.Uint32()
+  external int latencyFrames;
+
+  /// Times the output ran out of frames.
+  @ffi.Uint32()
+  external int underruns;
+
+  /// Input frames consumed per output frame, 1 when in sync.
+  @ffi.Float()
+  external double ratio;
+
+  /// Frames the output plays ahead of output 0, smoothed.
+  @ffi.Float()
+  external double offsetFrames;
 }
 
-/// Defines the severity levels for log messages.
-enum log_level_t {
-  /// Debug level: Detailed information for debugging purposes.
-  log_level_debug(0),
+/// How a playback device moved to another output, see `playback_device_migrate`.
+final class playback_migration_t extends ffi.Struct {
+  /// Time spent opening the new device while the old one kept playing.
+  @ffi.Uint64()
+  external int openNs;
 
-  /// Info level: General informational messages.
-  log_level_info(1),
+  /// Time from stopping the old device to starting the new one.
+  @ffi.Uint64()
+  external int switchNs;
 
-  /// Warning level: Potential issues that are non-critical.
-  log_level_warning(2),
+  /// Bytes queued in the ring buffer when the new device took over.
+  @ffi.Uint32()
+  external int bufferedBytes;
+}
 
-  /// Error level: Critical issues requiring immediate attention.
-  log_level_error(3);
+/// What a playback device does with the ring buffer during an interruption.
+enum playback_interruption_mode_t {
+  /// Keep consuming as if nothing happened, the default.
+  playback_interruption_ignore(0),
+
+  /// Freeze; resume with the first frame not played.
+  playback_interruption_resume_paused(1),
+
+  /// Freeze; resume with the latest frames, dropping older ones.
+  playback_interruption_resume_latest(2);
 
   final int value;
-  const log_level_t(this.value);
+  const playback_interruption_mode_t(this.value);
 
-  static log_level_t fromValue(int value) => switch (value) {
-        0 => log_level_debug,
-        1 => log_level_info,
-        2 => log_level_warning,
-        3 => log_level_error,
-        _ => throw ArgumentError("Unknown value for log_level_t: $value"),
+  static playback_interruption_mode_t fromValue(int value) => switch (value) {
+        0 => playback_interruption_ignore,
+        1 => playback_interruption_resume_paused,
+        2 => playback_interruption_resume_latest,
+        _ =>
+          throw ArgumentError("Unknown value for playback_interruption_mode_t: $value"),
       };
 }
 
-/// Configuration structure for a playback device.
-final class playback_config_t extends ffi.Struct {
-  /// Number of audio channels (e.g., 2 for stereo).
+/// How a playback device handles interruptions.
+final class playback_interruption_policy_t extends ffi.Struct {
+  /// What happens to consumption and to the ring buffer.
+  @ffi.UnsignedInt()
+  external int modeAsInt;
+
+  playback_interruption_mode_t get mode => playback_interruption_mode_t.fromValue(modeAsInt);
+
+  /// While frozen, pushes that do not fit are cut short instead of dropping queued frames.
+  @ffi.Bool()
+  external bool backpressure;
+}
+
+/// Interruptions seen by a playback device.
+final class playback_interruption_stats_t extends ffi.Struct {
+  /// An interruption began and has not ended.
+  @ffi.Bool()
+  external bool isInterrupted;
+
+  /// Interruptions since the device was created.
   @ffi.Uint32()
-  external int channels;
+  external int interruptionCount;
 
-  /// Sample rate in Hertz (e.g., 44100 Hz).
+  /// Bytes dropped when the last interruption ended, with `playback_interruption_resume_latest`.
   @ffi.Uint32()
-  external int sampleRate;
+  external int droppedBytes;
 
-  /// PCM format of the audio data (e.g., `pcm_format_s16`).
-  @ffi.UnsignedInt()
-  external int pcmFormatAsInt;
+  /// From the end of the last interruption to its first audible frame, 0 until it played.
+  @ffi.Uint64()
+  external int resumeLatencyNs;
+}
 
-  pcm_format_t get pcmFormat => pcm_format_t.fromValue(pcmFormatAsInt);
+/// Audio backends, with the values of `ma_backend`.
+enum audio_backend_t {
+  /// Windows Audio Session API.
+  audio_backend_wasapi(0),
 
-  /// Maximum threshold for the ring buffer.
-  @ffi.Size()
-  external int rbMaxThreshold;
+  /// DirectSound.
+  audio_backend_dsound(1),
 
-  /// Minimum threshold for the ring buffer.
-  @ffi.Size()
-  external int rbMinThreshold;
+  /// Windows Multimedia.
+  audio_backend_winmm(2),
 
-  /// Total size of the ring buffer in bytes.
-  @ffi.Size()
-  external int rbSizeInBytes;
-}
+  /// Core Audio, macOS and iOS.
+  audio_backend_coreaudio(3),
 
-/// Represents audio data to be pushed to a playback device.
-final class playback_data_t extends ffi.Struct {
-  /// Pointer to the audio data to be played.
-  external ffi.Pointer<ffi.Void> pUserData;
+  /// sndio, OpenBSD.
+  audio_backend_sndio(4),
 
-  /// Size of the audio data in bytes.
-  @ffi.Uint32()
-  external int sizeInBytes;
-}
+  /// audio(4), NetBSD.
+  audio_backend_audio4(5),
 
-/// Represents the states of an audio device.
-enum device_state_t {
-  /// The device is not initialized.
-  device_state_uninitialized(0),
+  /// Open Sound System.
+  audio_backend_oss(6),
 
-  /// The device is initialized but not started.
-  device_state_stopped(1),
+  /// PulseAudio.
+  audio_backend_pulseaudio(7),
 
-  /// The device is active and processing audio data.
-  device_state_started(2),
+  /// Advanced Linux Sound Architecture.
+  audio_backend_alsa(8),
 
-  /// The device is transitioning from stopped to started.
-  device_state_starting(3),
+  /// JACK Audio Connection Kit.
+  audio_backend_jack(9),
 
-  /// The device is transitioning from started to stopped.
-  device_state_stopping(4);
+  /// AAudio, Android.
+  audio_backend_aaudio(10),
 
-  final int value;
-  const device_state_t(this.value);
+  /// OpenSL ES, Android.
+  audio_backend_opensl(11),
 
-  static device_state_t fromValue(int value) => switch (value) {
-        0 => device_state_uninitialized,
-        1 => device_state_stopped,
-        2 => device_state_started,
-        3 => device_state_starting,
-        4 => device_state_stopping,
-        _ => throw ArgumentError("Unknown value for device_state_t: $value"),
+  /// Web Audio.
+  audio_backend_webaudio(12),
+
+  /// Custom backend.
+  audio_backend_custom(13),
+
+  /// Silent backend that plays in real time.
+  audio_backend_null(14),
+
+  /// No backend.
+  audio_backend_unknown(255);
+
+  final int value;
+  const audio_backend_t(this.value);
+
+  static audio_backend_t fromValue(int value) => switch (value) {
+        0 => audio_backend_wasapi,
+        1 => audio_backend_dsound,
+        2 => audio_backend_winmm,
+        3 => audio_backend_coreaudio,
+        4 => audio_backend_sndio,
+        5 => audio_backend_audio4,
+        6 => audio_backend_oss,
+        7 => audio_backend_pulseaudio,
+        8 => audio_backend_alsa,
+        9 => audio_backend_jack,
+        10 => audio_backend_aaudio,
+        11 => audio_backend_opensl,
+        12 => audio_backend_webaudio,
+        13 => audio_backend_custom,
+        14 => audio_backend_null,
+        255 => audio_backend_unknown,
+        _ =>
+          throw ArgumentError("Unknown value for audio_backend_t: $value"),
       };
 }
 
-/// Represents the types of waveforms that can be generated.
-enum waveform_type_t {
-  /// Sine waveform.
-  waveform_type_sine(0),
+/// Controls how an audio context starts.
+final class audio_context_config_t extends ffi.Struct {
+  /// Backends to try, in order.
+  @ffi.Array.multi([16])
+  external ffi.Array<ffi.UnsignedInt> backendsAsInt;
 
-  /// Square waveform.
-  waveform_type_square(1),
+  /// Number of `backends`. 0 tries every enabled backend.
+  @ffi.Uint32()
+  external int backendCount;
 
-  /// Triangle waveform.
-  waveform_type_triangle(2),
+  /// Try the backend the last context of the process used first.
+  @ffi.Bool()
+  external bool preferLastBackend;
 
-  /// Sawtooth waveform.
-  waveform_type_sawtooth(3);
+  /// Enumerate devices on first use instead of at creation.
+  @ffi.Bool()
+  external bool isLazy;
+}
 
-  final int value;
-  const waveform_type_t(this.value);
+/// Time spent by each phase of starting an audio context.
+final class audio_context_timings_t extends ffi.Struct {
+  /// Backend the context uses.
+  @ffi.UnsignedInt()
+  external int backendAsInt;
 
-  static waveform_type_t fromValue(int value) => switch (value) {
-        0 => waveform_type_sine,
-        1 => waveform_type_square,
-        2 => waveform_type_triangle,
-        3 => waveform_type_sawtooth,
-        _ => throw ArgumentError("Unknown value for waveform_type_t: $value"),
-      };
-}
+  audio_backend_t get backend => audio_backend_t.fromValue(backendAsInt);
 
-typedef u_int32_t = ffi.UnsignedInt;
-typedef Dartu_int32_t = int;
+  /// Setting up the log.
+  @ffi.Uint64()
+  external int logNs;
 
-final class encoder_config_t extends ffi.Struct {
-  /// Number of audio channels (e.g., 2 for stereo).
+  /// Probing the backends and initializing the one used.
+  @ffi.Uint64()
+  external int initNs;
+
+  /// Last device enumeration, 0 until the devices are enumerated.
+  @ffi.Uint64()
+  external int enumerateNs;
+
+  /// The devices were enumerated.
+  @ffi.Bool()
+  external bool isEnumerated;
+
+  /// Backend enumerations run, coalesced requests counting once.
   @ffi.Uint32()
-  external int channels;
+  external int enumerations;
+}
 
-  /// Sample rate in Hertz (e.g., 44100 Hz).
+/// Receives the outcome of `audio_context_refresh_devices_async`.
+typedef audio_context_refresh_callback_t
+    = ffi.Pointer<ffi.NativeFunction<audio_context_refresh_callback_tFunction>>;
+typedef audio_context_refresh_callback_tFunction = ffi.Void Function(
+    ffi.Pointer<ffi.Void> pUserData, ffi.Bool isSuccess);
+typedef Dartaudio_context_refresh_callback_tFunction = void Function(
+    ffi.Pointer<ffi.Void> pUserData, bool isSuccess);
+
+/// Receives the outcome of `audio_context_get_device_infos_async`.
+typedef audio_context_device_infos_callback_t = ffi
+    .Pointer<ffi.NativeFunction<audio_context_device_infos_callback_tFunction>>;
+typedef audio_context_device_infos_callback_tFunction = ffi.Void Function(
+    ffi.Pointer<ffi.Void> pUserData, ffi.Pointer<device_infos_t> pDeviceInfos);
+typedef Dartaudio_context_device_infos_callback_tFunction = void Function(
+    ffi.Pointer<ffi.Void> pUserData, ffi.Pointer<device_infos_t> pDeviceInfos);
+
+/// Receives the outcome of `audio_context_get_device_info_ext_async`.
+typedef audio_context_device_info_ext_callback_t = ffi.Pointer<
+    ffi.NativeFunction<audio_context_device_info_ext_callback_tFunction>>;
+typedef audio_context_device_info_ext_callback_tFunction = ffi.Void Function(
+    ffi.Pointer<ffi.Void> pUserData,
+    ffi.Pointer<device_info_ext_t> pDeviceInfoExt);
+typedef Dartaudio_context_device_info_ext_callback_tFunction = void Function(
+    ffi.Pointer<ffi.Void> pUserData,
+    ffi.Pointer<device_info_ext_t> pDeviceInfoExt);
+
+/// State of the playback pool of a context.
+final class playback_pool_stats_t extends ffi.Struct {
+  /// Started devices waiting in the pool.
   @ffi.Uint32()
-  external int sampleRate;
+  external int idleDevices;
 
-  /// PCM format of the audio data (e.g., `pcm_format_s16`).
-  @ffi.UnsignedInt()
-  external int pcmFormatAsInt;
+  /// Devices acquired and not yet released.
+  @ffi.Uint32()
+  external int lentDevices;
 
-  pcm_format_t get pcmFormat => pcm_format_t.fromValue(pcmFormatAsInt);
+  /// Acquisitions served by a warm device.
+  @ffi.Uint32()
+  external int hits;
+
+  /// Acquisitions that had to open a device.
+  @ffi.Uint32()
+  external int misses;
 }
@@ -46,6 +46,33 @@ AutoFreePointer<Char> stringToCharPointer(String string) {
   return AutoFreePointer._(pointer);
 }
 
+extension AudioContextConfigExt on AudioContextConfig {
+  AutoFreePointer<audio_context_config_t> toNative() {
+    if (backends.length > AudioContextConfig.maxBackends) {
+      throw RangeError.range(
+        backends.length,
+        0,
+        AudioContextConfig.maxBackends,
+        'backends',
+      );
+    }
+
+    final nativeConfig = malloc.allocate<audio_context_config_t>(
+      sizeOf<audio_context_config_t>(),
+    );
+
+    for (var i = 0; i < backends.length; i++) {
+      nativeConfig.ref.backendsAsInt[i] = backends[i].value;
+    }
+
+    nativeConfig.ref.backendCount = backends.length;
+    nativeConfig.ref.preferLastBackend = preferLastBackend;
+    nativeConfig.ref.isLazy = isLazy;
+
+    return AutoFreePointer._(nativeConfig);
+  }
+}
+
 extension PlaybackConfigExt on PlaybackConfig {
   AutoFreePointer<playback_config_t> toNative() {
     final nativePlaybackConfig = malloc.allocate<playback_config_t>(
@@ -72,11 +99,151 @@ extension WavEncoderConfigExt on WavEncoderConfig {
     nativeWavEncoderConfig.ref.channels = channels;
     nativeWavEncoderConfig.ref.sampleRate = sampleRate;
     nativeWavEncoderConfig.ref.pcmFormatAsInt = pcmFormat.index;
+    nativeWavEncoderConfig.ref.storageAsInt = storage.value;
 
     return AutoFreePointer._(nativeWavEncoderConfig);
   }
 }
 
+extension WavEncoderWriterConfigExt on WavEncoderWriterConfig {
+  AutoFreePointer<encoder_writer_config_t> toNative() {
+    final nativeWriterConfig = malloc.allocate<encoder_writer_config_t>(
+      sizeOf<encoder_writer_config_t>(),
+    );
+
+    nativeWriterConfig.ref.blockSize = blockSize;
+    nativeWriterConfig.ref.preallocateSize = preallocateSize;
+    nativeWriterConfig.ref.useDirectIo = useDirectIo;
+    nativeWriterConfig.ref.fsyncPolicyAsInt = fsyncPolicy.value;
+    nativeWriterConfig.ref.fsyncIntervalBytes = fsyncIntervalBytes;
+
+    return AutoFreePointer._(nativeWriterConfig);
+  }
+}
+
+extension WavEncoderSegmentConfigExt on WavEncoderSegmentConfig {
+  AutoFreePointer<encoder_segment_config_t> toNative() {
+    final nativeSegmentConfig = malloc.allocate<encoder_segment_config_t>(
+      sizeOf<encoder_segment_config_t>(),
+    );
+    final writerConfig = this.writerConfig;
+
+    nativeSegmentConfig.ref.segmentSeconds = segmentSeconds;
+    nativeSegmentConfig.ref.segmentBytes = segmentBytes;
+    nativeSegmentConfig.ref.useWriter = writerConfig != null;
+
+    final nativeWriterConfig = nativeSegmentConfig.ref.writerConfig;
+    final resolvedWriterConfig = writerConfig ?? const WavEncoderWriterConfig();
+
+    nativeWriterConfig.blockSize = resolvedWriterConfig.blockSize;
+    nativeWriterConfig.preallocateSize = resolvedWriterConfig.preallocateSize;
+    nativeWriterConfig.useDirectIo = resolvedWriterConfig.useDirectIo;
+    nativeWriterConfig.fsyncPolicyAsInt = resolvedWriterConfig.fsyncPolicy.value;
+    nativeWriterConfig.fsyncIntervalBytes =
+        resolvedWriterConfig.fsyncIntervalBytes;
+
+    return AutoFreePointer._(nativeSegmentConfig);
+  }
+}
+
+extension SpectrumConfigExt on SpectrumConfig {
+  AutoFreePointer<spectrum_config_t> toNative() {
+    final nativeSpectrumConfig = malloc.allocate<spectrum_config_t>(
+      sizeOf<spectrum_config_t>(),
+    );
+
+    nativeSpectrumConfig.ref.fftSize = fftSize;
+    nativeSpectrumConfig.ref.hopSize = hopSize;
+    nativeSpectrumConfig.ref.windowAsInt = window.value;
+    nativeSpectrumConfig.ref.smoothing = smoothing;
+
+    return AutoFreePointer._(nativeSpectrumConfig);
+  }
+}
+
+extension PlaybackDspStageExt on PlaybackDspStage {
+  AutoFreePointer<playback_dsp_stage_t> toNative() =>
+      [this].toNative();
+
+  void _fill(playback_dsp_stage_t nativeStage) {
+    nativeStage.typeAsInt = type.value;
+    nativeStage.order = order;
+    nativeStage.frequency = frequency;
+    nativeStage.q = q;
+    nativeStage.gainDb = gainDb;
+    nativeStage.delayFrames = delayFrames;
+    nativeStage.decay = decay;
+    nativeStage.wet = wet;
+    nativeStage.dry = dry;
+    nativeStage.smoothFrames = smoothFrames;
+
+    for (var i = 0; i < 6; i++) {
+      nativeStage.coefficients[i] =
+          i < coefficients.length ? coefficients[i] : 0;
+    }
+  }
+}
+
+extension PlaybackDspStageListExt on List<PlaybackDspStage> {
+  AutoFreePointer<playback_dsp_stage_t> toNative() {
+    // Never allocate 0 bytes: an empty chain still needs a valid pointer.
+    final nativeStages = malloc.allocate<playback_dsp_stage_t>(
+      sizeOf<playback_dsp_stage_t>() * (isEmpty ? 1 : length),
+    );
+
+    for (var i = 0; i < length; i++) {
+      this[i]._fill(nativeStages[i]);
+    }
+
+    return AutoFreePointer._(nativeStages);
+  }
+}
+
+extension PlaybackSilenceConfigExt on PlaybackSilenceConfig {
+  AutoFreePointer<playback_silence_config_t> toNative() {
+    final nativeConfig = malloc.allocate<playback_silence_config_t>(
+      sizeOf<playback_silence_config_t>(),
+    );
+
+    nativeConfig.ref.thresholdDb = thresholdDb;
+    nativeConfig.ref.noiseFloorMarginDb = noiseFloorMarginDb;
+    nativeConfig.ref.holdMs = holdMs;
+    nativeConfig.ref.skipProcessing = skipProcessing;
+    nativeConfig.ref.compactRecording = compactRecording;
+
+    return AutoFreePointer._(nativeConfig);
+  }
+}
+
+extension PlaybackGroupConfigExt on PlaybackGroupConfig {
+  AutoFreePointer<playback_group_config_t> toNative() {
+    final nativeConfig = malloc.allocate<playback_group_config_t>(
+      sizeOf<playback_group_config_t>(),
+    );
+
+    nativeConfig.ref.pcmFormatAsInt = format.pcmFormat.index;
+    nativeConfig.ref.channels = format.channels;
+    nativeConfig.ref.sampleRate = format.sampleRate;
+    nativeConfig.ref.capacityFrames = capacityFrames;
+    nativeConfig.ref.targetLatencyFrames = targetLatencyFrames;
+
+    return AutoFreePointer._(nativeConfig);
+  }
+}
+
+extension PlaybackInterruptionPolicyExt on PlaybackInterruptionPolicy {
+  AutoFreePointer<playback_interruption_policy_t> toNative() {
+    final nativePolicy = malloc.allocate<playback_interruption_policy_t>(
+      sizeOf<playback_interruption_policy_t>(),
+    );
+
+    nativePolicy.ref.modeAsInt = mode.value;
+    nativePolicy.ref.backpressure = backpressure;
+
+    return AutoFreePointer._(nativePolicy);
+  }
+}
+
 extension PcmFormatExt on PcmFormat {
   pcm_format_t toNative() => pcm_format_t.values[index];
 }
@@ -1,5 +1,7 @@
+import 'dart:async';
 import 'dart:ffi';
 import 'dart:io';
+import 'dart:math' show ln10, log;
 import 'dart:typed_data';
 
 import 'package:equatable/equatable.dart';
@@ -10,24 +12,53 @@ import 'package:meta/meta.dart';
 import 'generated/bindings.dart';
 
 part 'audio_context.dart';
+part 'audio_overview.dart';
+part 'data_source.dart';
+part 'decoder.dart';
 part 'device_infos.dart';
 part 'file_logger.dart';
 part 'internal.dart';
+part 'mapped_wav.dart';
+part 'models/audio_backend.dart';
+part 'models/audio_context_config.dart';
+part 'models/audio_context_timings.dart';
 part 'models/audio_device_type.dart';
 part 'models/audio_format.dart';
+part 'models/decoder_config.dart';
 part 'models/device_id.dart';
 part 'models/device_info.dart';
 part 'models/device_state.dart';
 part 'models/log_level.dart';
 part 'models/pcm_format.dart';
 part 'models/playback_config.dart';
+part 'models/playback_dsp_stage.dart';
+part 'models/playback_event.dart';
+part 'models/playback_group_config.dart';
+part 'models/playback_group_output_stats.dart';
+part 'models/playback_interruption_policy.dart';
+part 'models/playback_interruption_stats.dart';
+part 'models/playback_meter.dart';
+part 'models/playback_migration.dart';
+part 'models/playback_pool_stats.dart';
+part 'models/playback_reference_block.dart';
+part 'models/playback_silence_config.dart';
+part 'models/playback_silence_stats.dart';
+part 'models/spectrum_config.dart';
 part 'models/wav_encoder_config.dart';
+part 'models/wav_encoder_segment_config.dart';
+part 'models/wav_encoder_writer_config.dart';
+part 'models/wav_encoder_writer_stats.dart';
+part 'models/wav_gap.dart';
+part 'models/wav_segment.dart';
+part 'models/waveform_bank_config.dart';
 part 'models/waveform_config.dart';
 part 'models/waveform_type.dart';
 part 'native_resource.dart';
 part 'playback_device.dart';
+part 'playback_group.dart';
 part 'wav_encoder.dart';
 part 'waveform.dart';
+part 'waveform_bank.dart';
 
 ProMiniaudioBindings get _bindings => Library.instance.bindings;
 
@@ -39,11 +70,21 @@ final class Library {
 
   static Library instance = Library._(_loadBindings());
 
+  /// The finalizer for the `AudioOverview` class.
+  static final _audioOverviewFinalizer = NativeFinalizer(
+    _bindings.addresses.overview_destroy.cast(),
+  );
+
   /// The finalizer for the `Waveform` class.
   static final _waveformFinalizer = NativeFinalizer(
     _bindings.addresses.waveform_destroy.cast(),
   );
 
+  /// The finalizer for the `WaveformBank` class.
+  static final _waveformBankFinalizer = NativeFinalizer(
+    _bindings.addresses.waveform_bank_destroy.cast(),
+  );
+
   /// The finalizer for the `Context` class.
   static final _contextFinalizer = NativeFinalizer(
     _bindings.addresses.audio_context_destroy.cast(),
@@ -54,6 +95,16 @@ final class Library {
     _bindings.addresses.audio_context_device_infos_destroy.cast(),
   );
 
+  /// The finalizer for the `Decoder` class.
+  static final _decoderFinalizer = NativeFinalizer(
+    _bindings.addresses.decoder_destroy.cast(),
+  );
+
+  /// The finalizer for the `MappedWav` class.
+  static final _mappedWavFinalizer = NativeFinalizer(
+    _bindings.addresses.mapped_wav_destroy.cast(),
+  );
+
   /// The finalizer for the `WavEncoder` class.
   static final _wavEncoderFinalizer = NativeFinalizer(
     _bindings.addresses.encoder_destroy.cast(),
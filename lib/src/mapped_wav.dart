@@ -0,0 +1,188 @@
+part of 'library.dart';
+
+/// Plays an uncompressed PCM WAV file straight from a memory mapping.
+///
+/// The header is parsed once when the file is opened and the samples are
+/// never copied into intermediate buffers, so opening is instant even for
+/// very large files. When the file already has [outputFormat], reads copy
+/// frames directly from the mapping; otherwise they are converted on the
+/// fly. A `MappedWav` is a [DataSource] and is usually attached to a
+/// [PlaybackDevice].
+///
+/// Not available on Windows.
+///
+/// ### Example Usage:
+/// ```dart
+/// final wav = MappedWav(
+///   filePath: '/path/to/ambience.wav',
+///   outputFormat: const AudioFormat(
+///     pcmFormat: PcmFormat.s16,
+///     channels: 2,
+///     sampleRate: 48000,
+///   ),
+/// );
+///
+/// print('Direct: ${wav.isDirect}, frames: ${wav.length}');
+///
+/// playbackDevice
+///   ..attachSource(wav)
+///   ..start();
+/// ```
+final class MappedWav extends NativeResource<Void> implements DataSource {
+  /// Maps [filePath] and prepares it to be read in [outputFormat].
+  ///
+  /// Throws:
+  /// - [Exception] if the file cannot be mapped or is not a supported PCM
+  ///   WAV file.
+  factory MappedWav({
+    required String filePath,
+    required AudioFormat outputFormat,
+  }) {
+    final filePathPtr = stringToCharPointer(filePath);
+    final nativeFormat = malloc<audio_format_t>();
+
+    try {
+      nativeFormat.ref
+        ..pcmFormatAsInt = outputFormat.pcmFormat.index
+        ..channels = outputFormat.channels
+        ..sampleRate = outputFormat.sampleRate;
+
+      final rWav = _bindings.mapped_wav_create(
+        filePathPtr.ensureIsNotFinalized(),
+        nativeFormat,
+      );
+
+      if (rWav == nullptr) {
+        throw Exception('Failed to map WAV file $filePath');
+      }
+
+      return MappedWav._(rWav, outputFormat);
+    } finally {
+      malloc.free(nativeFormat);
+    }
+  }
+
+  /// Internal constructor.
+  ///
+  /// This is used internally by the factory constructor and should not
+  /// be called directly.
+  MappedWav._(super.ptr, this.outputFormat) : super._();
+
+  /// The format frames are read in.
+  final AudioFormat outputFormat;
+
+  @protected
+  @override
+  NativeFinalizer get finalizer => Library._mappedWavFinalizer;
+
+  @protected
+  @override
+  void releaseResource() => _bindings.mapped_wav_destroy(
+        ensureIsNotFinalized(),
+      );
+
+  /// The format of the samples stored in the file.
+  AudioFormat get fileFormat {
+    final nativeFormat = malloc<audio_format_t>();
+
+    try {
+      _bindings.mapped_wav_get_file_format(
+        ensureIsNotFinalized(),
+        nativeFormat,
+      );
+
+      return AudioFormat(
+        pcmFormat: PcmFormat.fromValue(nativeFormat.ref.pcmFormatAsInt),
+        channels: nativeFormat.ref.channels,
+        sampleRate: nativeFormat.ref.sampleRate,
+      );
+    } finally {
+      malloc.free(nativeFormat);
+    }
+  }
+
+  /// Whether frames are copied straight from the mapping without conversion.
+  bool get isDirect => _bindings.mapped_wav_is_direct(ensureIsNotFinalized());
+
+  /// The length of the file in output frames.
+  int get length => _bindings.mapped_wav_get_length(ensureIsNotFinalized());
+
+  /// The index of the next frame that will be read.
+  int get cursor => _bindings.mapped_wav_get_cursor(ensureIsNotFinalized());
+
+  bool _isLooping = false;
+
+  /// Whether reading restarts from the beginning at the end of the file.
+  bool get isLooping => _isLooping;
+
+  set isLooping(bool value) {
+    _bindings.mapped_wav_set_looping(ensureIsNotFinalized(), value);
+    _isLooping = value;
+  }
+
+  /// Moves the read position to [frameIndex].
+  ///
+  /// Must not be called while the source is attached to a running
+  /// [PlaybackDevice].
+  ///
+  /// Throws:
+  /// - [RangeError] if [frameIndex] is past the end of the file.
+  void seek(int frameIndex) {
+    if (!_bindings.mapped_wav_seek(ensureIsNotFinalized(), frameIndex)) {
+      throw RangeError.range(frameIndex, 0, length, 'frameIndex');
+    }
+  }
+
+  /// Reads up to [frameCount] frames in [outputFormat].
+  ///
+  /// Returns:
+  /// - A record containing:
+  ///   - `frames`: The PCM audio data as a [TypedData].
+  ///   - `framesRead`: The number of frames successfully read.
+  ///
+  /// Throws:
+  /// - [StateError] if the source is finalized.
+  /// - [Exception] if the sample format is unsupported.
+  ({TypedData frames, int framesRead}) readPcmFrames({
+    required int frameCount,
+  }) {
+    final resource = ensureIsNotFinalized();
+
+    final pFramesOut = malloc.allocate(frameCount * outputFormat.bytesPerFrame);
+    final pFramesRead = malloc<Uint64>();
+
+    try {
+      _bindings.mapped_wav_read_pcm_frames_with_buffer(
+        resource,
+        pFramesOut.cast(),
+        frameCount,
+        pFramesRead,
+      );
+
+      final framesRead = pFramesRead.value;
+      final size = framesRead * outputFormat.channels;
+
+      final frames = switch (outputFormat.pcmFormat) {
+        PcmFormat.f32 => pFramesOut
+            .cast<Float>()
+            .asTypedList(size, finalizer: malloc.nativeFree),
+        PcmFormat.s16 => pFramesOut
+            .cast<Int16>()
+            .asTypedList(size, finalizer: malloc.nativeFree),
+        PcmFormat.s32 || PcmFormat.s24 => pFramesOut
+            .cast<Int32>()
+            .asTypedList(size, finalizer: malloc.nativeFree),
+        PcmFormat.u8 => pFramesOut
+            .cast<Uint8>()
+            .asTypedList(size, finalizer: malloc.nativeFree),
+        _ => throw Exception(
+            'Unsupported sample format: ${outputFormat.pcmFormat}',
+          ),
+      };
+
+      return (frames: frames, framesRead: framesRead);
+    } finally {
+      malloc.free(pFramesRead);
+    }
+  }
+}
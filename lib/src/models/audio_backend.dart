@@ -0,0 +1,63 @@
+part of '../library.dart';
+
+/// An audio backend an [AudioContext] can run on.
+enum AudioBackend {
+  /// Windows Audio Session API.
+  wasapi(0),
+
+  /// DirectSound.
+  dsound(1),
+
+  /// Windows Multimedia.
+  winmm(2),
+
+  /// Core Audio, macOS and iOS.
+  coreaudio(3),
+
+  /// sndio, OpenBSD.
+  sndio(4),
+
+  /// audio(4), NetBSD.
+  audio4(5),
+
+  /// Open Sound System.
+  oss(6),
+
+  /// PulseAudio.
+  pulseaudio(7),
+
+  /// Advanced Linux Sound Architecture.
+  alsa(8),
+
+  /// JACK Audio Connection Kit.
+  jack(9),
+
+  /// AAudio, Android.
+  aaudio(10),
+
+  /// OpenSL ES, Android.
+  opensl(11),
+
+  /// Web Audio.
+  webaudio(12),
+
+  /// A custom backend.
+  custom(13),
+
+  /// A silent backend that plays in real time.
+  nullBackend(14);
+
+  /// Creates an [AudioBackend] with the associated integer value.
+  const AudioBackend(this.value);
+
+  /// The integer value used by the native library.
+  final int value;
+
+  /// Returns the [AudioBackend] with the native [value].
+  ///
+  /// Throws a [RangeError] if the value is not valid.
+  static AudioBackend fromValue(int value) => values.firstWhere(
+        (backend) => backend.value == value,
+        orElse: () => throw RangeError('Invalid AudioBackend value: $value'),
+      );
+}
@@ -0,0 +1,44 @@
+part of '../library.dart';
+
+/// Controls how an [AudioContext] starts.
+///
+/// ### Example Usage:
+/// ```dart
+/// final context = AudioContext.withConfig(
+///   const AudioContextConfig(
+///     backends: [AudioBackend.pulseaudio, AudioBackend.alsa],
+///     preferLastBackend: true,
+///     isLazy: true,
+///   ),
+/// );
+/// ```
+final class AudioContextConfig extends Equatable {
+  /// Creates a new [AudioContextConfig] instance.
+  ///
+  /// - [backends]: The backends to try, in order, at most
+  ///   [maxBackends]. Empty tries every enabled backend.
+  /// - [preferLastBackend]: Whether to try first the backend the last
+  ///   context of the process used.
+  /// - [isLazy]: Whether to enumerate the devices on first use instead of
+  ///   at creation.
+  const AudioContextConfig({
+    this.backends = const [],
+    this.preferLastBackend = false,
+    this.isLazy = false,
+  });
+
+  /// The maximum number of [backends].
+  static const maxBackends = 16;
+
+  /// The backends to try, in order.
+  final List<AudioBackend> backends;
+
+  /// Whether to try first the backend the last context of the process used.
+  final bool preferLastBackend;
+
+  /// Whether to enumerate the devices on first use.
+  final bool isLazy;
+
+  @override
+  List<Object?> get props => [backends, preferLastBackend, isLazy];
+}
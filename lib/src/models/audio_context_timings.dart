@@ -0,0 +1,38 @@
+part of '../library.dart';
+
+/// The time spent by each phase of starting an [AudioContext].
+final class AudioContextTimings extends Equatable {
+  /// Creates a new [AudioContextTimings] instance.
+  const AudioContextTimings({
+    required this.backend,
+    required this.logDuration,
+    required this.initDuration,
+    required this.enumerateDuration,
+    required this.enumerations,
+  });
+
+  /// The backend the context runs on.
+  final AudioBackend backend;
+
+  /// The time spent setting up the log.
+  final Duration logDuration;
+
+  /// The time spent probing the backends and initializing [backend].
+  final Duration initDuration;
+
+  /// The time spent by the last device enumeration, or `null` until the
+  /// devices are enumerated.
+  final Duration? enumerateDuration;
+
+  /// The backend enumerations run, requests served together counting once.
+  final int enumerations;
+
+  @override
+  List<Object?> get props => [
+        backend,
+        logDuration,
+        initDuration,
+        enumerateDuration,
+        enumerations,
+      ];
+}
@@ -0,0 +1,64 @@
+part of '../library.dart';
+
+/// Configuration for a [Decoder].
+///
+/// The file is converted to this format while it is decoded, so a decoder
+/// configured like a [PlaybackDevice] can be attached to it directly.
+///
+/// ### Example Usage:
+/// ```dart
+/// const config = DecoderConfig(
+///   pcmFormat: PcmFormat.f32,
+///   channels: 2,
+///   sampleRate: 48000,
+///   lookaheadFrames: 24000,
+/// );
+/// ```
+class DecoderConfig extends Equatable {
+  /// Creates a decoder configuration.
+  ///
+  /// - [pcmFormat]: The audio sample format of the output.
+  /// - [channels]: The number of output channels.
+  /// - [sampleRate]: The output sample rate in Hertz.
+  /// - [lookaheadFrames]: The number of frames decoded ahead of the reader.
+  ///   `0` selects half a second.
+  const DecoderConfig({
+    required this.pcmFormat,
+    required this.channels,
+    required this.sampleRate,
+    this.lookaheadFrames = 0,
+  });
+
+  /// Creates a [DecoderConfig] matching the specified [AudioFormat].
+  factory DecoderConfig.fromAudioFormat(
+    AudioFormat audioFormat, {
+    int lookaheadFrames = 0,
+  }) =>
+      DecoderConfig(
+        pcmFormat: audioFormat.pcmFormat,
+        channels: audioFormat.channels,
+        sampleRate: audioFormat.sampleRate,
+        lookaheadFrames: lookaheadFrames,
+      );
+
+  /// The audio sample format of the output.
+  final PcmFormat pcmFormat;
+
+  /// The number of output channels.
+  final int channels;
+
+  /// The output sample rate in Hertz.
+  final int sampleRate;
+
+  /// The number of frames decoded ahead of the reader.
+  ///
+  /// Larger values survive longer stalls of the read-ahead thread at the cost
+  /// of memory. `0` selects half a second.
+  final int lookaheadFrames;
+
+  /// The number of bytes per output frame.
+  int get bpf => pcmFormat.bps * channels;
+
+  @override
+  List<Object?> get props => [pcmFormat, channels, sampleRate, lookaheadFrames];
+}
@@ -0,0 +1,197 @@
+part of '../library.dart';
+
+/// Kinds of stages of the DSP chain of a [PlaybackDevice].
+enum PlaybackDspType {
+  /// Biquad with explicit coefficients.
+  biquad(0),
+
+  /// Butterworth low-pass.
+  lowpass(1),
+
+  /// Butterworth high-pass.
+  highpass(2),
+
+  /// Band-pass.
+  bandpass(3),
+
+  /// Notch.
+  notch(4),
+
+  /// Peaking EQ.
+  peaking(5),
+
+  /// Low shelf.
+  lowshelf(6),
+
+  /// High shelf.
+  highshelf(7),
+
+  /// Feedback delay.
+  delay(8),
+
+  /// Smoothed gain.
+  gain(9);
+
+  /// Creates a [PlaybackDspType] with the associated integer value.
+  const PlaybackDspType(this.value);
+
+  /// The integer value used by the native library.
+  final int value;
+}
+
+/// One stage of the DSP chain of a [PlaybackDevice].
+///
+/// Only the fields used by [type] matter; use the named constructors to
+/// build a stage of a given type.
+///
+/// ### Example Usage:
+/// ```dart
+/// playbackDevice.setDspChain(const [
+///   PlaybackDspStage.highpass(frequency: 80),
+///   PlaybackDspStage.peaking(frequency: 3000, gainDb: 4, q: 1.2),
+///   PlaybackDspStage.gain(gainDb: -3, smoothFrames: 480),
+/// ]);
+/// ```
+class PlaybackDspStage extends Equatable {
+  /// Creates a stage with every field explicit.
+  const PlaybackDspStage({
+    required this.type,
+    this.order = 0,
+    this.frequency = 0,
+    this.q = 0,
+    this.gainDb = 0,
+    this.delayFrames = 0,
+    this.decay = 0,
+    this.wet = 0,
+    this.dry = 0,
+    this.smoothFrames = 0,
+    this.coefficients = const [],
+  });
+
+  /// Creates a biquad from `b0`, `b1`, `b2`, `a0`, `a1`, `a2`.
+  const PlaybackDspStage.biquad(List<double> coefficients)
+      : this(type: PlaybackDspType.biquad, coefficients: coefficients);
+
+  /// Creates a Butterworth low-pass of [order] at [frequency].
+  const PlaybackDspStage.lowpass({required double frequency, int order = 2})
+      : this(type: PlaybackDspType.lowpass, frequency: frequency, order: order);
+
+  /// Creates a Butterworth high-pass of [order] at [frequency].
+  const PlaybackDspStage.highpass({required double frequency, int order = 2})
+      : this(type: PlaybackDspType.highpass, frequency: frequency, order: order);
+
+  /// Creates a band-pass of an even [order] centered on [frequency].
+  const PlaybackDspStage.bandpass({required double frequency, int order = 2})
+      : this(type: PlaybackDspType.bandpass, frequency: frequency, order: order);
+
+  /// Creates a notch of quality [q] at [frequency].
+  const PlaybackDspStage.notch({required double frequency, double q = 0})
+      : this(type: PlaybackDspType.notch, frequency: frequency, q: q);
+
+  /// Creates a peaking EQ of [gainDb] and quality [q] at [frequency].
+  const PlaybackDspStage.peaking({
+    required double frequency,
+    required double gainDb,
+    double q = 0,
+  }) : this(
+          type: PlaybackDspType.peaking,
+          frequency: frequency,
+          gainDb: gainDb,
+          q: q,
+        );
+
+  /// Creates a low shelf of [gainDb] and slope [q] below [frequency].
+  const PlaybackDspStage.lowshelf({
+    required double frequency,
+    required double gainDb,
+    double q = 0,
+  }) : this(
+          type: PlaybackDspType.lowshelf,
+          frequency: frequency,
+          gainDb: gainDb,
+          q: q,
+        );
+
+  /// Creates a high shelf of [gainDb] and slope [q] above [frequency].
+  const PlaybackDspStage.highshelf({
+    required double frequency,
+    required double gainDb,
+    double q = 0,
+  }) : this(
+          type: PlaybackDspType.highshelf,
+          frequency: frequency,
+          gainDb: gainDb,
+          q: q,
+        );
+
+  /// Creates a feedback delay of [delayFrames].
+  const PlaybackDspStage.delay({
+    required int delayFrames,
+    double decay = 0,
+    double wet = 1,
+    double dry = 1,
+  }) : this(
+          type: PlaybackDspType.delay,
+          delayFrames: delayFrames,
+          decay: decay,
+          wet: wet,
+          dry: dry,
+        );
+
+  /// Creates a gain of [gainDb], ramped over [smoothFrames] when it changes.
+  const PlaybackDspStage.gain({required double gainDb, int smoothFrames = 0})
+      : this(
+          type: PlaybackDspType.gain,
+          gainDb: gainDb,
+          smoothFrames: smoothFrames,
+        );
+
+  /// The kind of stage.
+  final PlaybackDspType type;
+
+  /// The filter order, 1 to 8 (even for band-pass). `0` selects 2.
+  final int order;
+
+  /// The cutoff or center frequency in Hertz.
+  final double frequency;
+
+  /// The quality of notch and peaking filters, the slope of shelves. `0`
+  /// selects a default.
+  final double q;
+
+  /// The gain of peaking, shelf and gain stages in dB.
+  final double gainDb;
+
+  /// The length of a delay in frames.
+  final int delayFrames;
+
+  /// The feedback of a delay, from 0 to below 1.
+  final double decay;
+
+  /// The level of the delayed signal.
+  final double wet;
+
+  /// The level of the direct signal.
+  final double dry;
+
+  /// The length of the gain ramp in frames.
+  final int smoothFrames;
+
+  /// The biquad coefficients `b0`, `b1`, `b2`, `a0`, `a1`, `a2`.
+  final List<double> coefficients;
+
+  @override
+  List<Object?> get props => [
+        type,
+        order,
+        frequency,
+        q,
+        gainDb,
+        delayFrames,
+        decay,
+        wet,
+        dry,
+        smoothFrames,
+        coefficients,
+      ];
+}
@@ -0,0 +1,65 @@
+part of '../library.dart';
+
+/// Kinds of events posted by a [PlaybackDevice].
+enum PlaybackEventType {
+  /// The buffer fell below the low watermark; push more data.
+  ///
+  /// Posted once per [PlaybackDevice.pushBuffer] while the buffer stays low.
+  needData(0),
+
+  /// The buffer ran dry and silence was played.
+  underrun(1),
+
+  /// The device started or stopped, see [PlaybackEvent.state].
+  stateChanged(2),
+
+  /// The device was moved to another output, e.g. headphones were plugged
+  /// in.
+  rerouted(3),
+
+  /// The system took the output away, e.g. for a phone call. Producers may
+  /// slow down until [interruptionEnded], see
+  /// [PlaybackDevice.setInterruptionPolicy].
+  interruptionBegan(5),
+
+  /// The output is back after [interruptionBegan].
+  interruptionEnded(6);
+
+  /// Creates a [PlaybackEventType] with the associated integer value.
+  const PlaybackEventType(this.value);
+
+  /// The integer value used by the native library.
+  final int value;
+
+  /// Returns the [PlaybackEventType] with the native [value].
+  static PlaybackEventType fromValue(int value) => values.firstWhere(
+        (type) => type.value == value,
+        orElse: () => throw RangeError('Invalid PlaybackEventType value: $value'),
+      );
+}
+
+/// An event posted by a [PlaybackDevice], see [PlaybackDevice.events].
+final class PlaybackEvent extends Equatable {
+  /// Creates a new [PlaybackEvent] instance.
+  const PlaybackEvent({
+    required this.type,
+    required this.state,
+    required this.availableBytes,
+  });
+
+  /// The event type.
+  final PlaybackEventType type;
+
+  /// The device state when the event was posted.
+  final DeviceState state;
+
+  /// The bytes queued in the buffer when the event was posted.
+  final int availableBytes;
+
+  @override
+  List<Object?> get props => [
+        type,
+        state,
+        availableBytes,
+      ];
+}
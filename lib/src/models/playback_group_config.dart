@@ -0,0 +1,30 @@
+part of '../library.dart';
+
+/// Configuration of a [PlaybackGroup].
+class PlaybackGroupConfig extends Equatable {
+  /// Creates a new [PlaybackGroupConfig] instance.
+  ///
+  /// - [format]: The format of the pushed frames. Only [PcmFormat.s16] and
+  ///   [PcmFormat.f32] are supported.
+  /// - [capacityFrames]: The frames the shared ring holds. `0` selects one
+  ///   second.
+  /// - [targetLatencyFrames]: The frames each output keeps between the
+  ///   producer and its speaker. `0` selects 50 ms.
+  const PlaybackGroupConfig({
+    required this.format,
+    this.capacityFrames = 0,
+    this.targetLatencyFrames = 0,
+  });
+
+  /// The format of the pushed frames.
+  final AudioFormat format;
+
+  /// The frames the shared ring holds, `0` for one second.
+  final int capacityFrames;
+
+  /// The frames each output keeps queued, `0` for 50 ms.
+  final int targetLatencyFrames;
+
+  @override
+  List<Object?> get props => [format, capacityFrames, targetLatencyFrames];
+}
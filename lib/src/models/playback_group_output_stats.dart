@@ -0,0 +1,44 @@
+part of '../library.dart';
+
+/// The state of one output of a [PlaybackGroup].
+final class PlaybackGroupOutputStats extends Equatable {
+  /// Creates a new [PlaybackGroupOutputStats] instance.
+  const PlaybackGroupOutputStats({
+    required this.framesPlayed,
+    required this.queuedFrames,
+    required this.latencyFrames,
+    required this.underruns,
+    required this.ratio,
+    required this.offsetFrames,
+  });
+
+  /// The frames output by the device, silence excluded.
+  final int framesPlayed;
+
+  /// The frames pushed but not yet read by the output.
+  final int queuedFrames;
+
+  /// The estimated frames between the output and the speaker.
+  final int latencyFrames;
+
+  /// The number of times the output ran out of frames.
+  final int underruns;
+
+  /// The frames consumed per frame played, `1` when the device clock
+  /// matches the producer.
+  final double ratio;
+
+  /// The frames this output plays ahead of the first output, negative when
+  /// it lags behind.
+  final double offsetFrames;
+
+  @override
+  List<Object?> get props => [
+        framesPlayed,
+        queuedFrames,
+        latencyFrames,
+        underruns,
+        ratio,
+        offsetFrames,
+      ];
+}
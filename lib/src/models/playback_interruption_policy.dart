@@ -0,0 +1,49 @@
+part of '../library.dart';
+
+/// What a [PlaybackDevice] does with its buffer during an interruption.
+enum PlaybackInterruptionMode {
+  /// Keep consuming as if nothing happened.
+  ignore(0),
+
+  /// Stop consuming; resume with the first frame not played.
+  resumePaused(1),
+
+  /// Stop consuming; resume with the latest frames, dropping older ones so
+  /// nothing stale is heard.
+  resumeLatest(2);
+
+  /// Creates a [PlaybackInterruptionMode] with the associated integer value.
+  const PlaybackInterruptionMode(this.value);
+
+  /// The integer value used by the native library.
+  final int value;
+}
+
+/// How a [PlaybackDevice] handles interruptions, such as a phone call.
+///
+/// ### Example Usage:
+/// ```dart
+/// playbackDevice.setInterruptionPolicy(
+///   const PlaybackInterruptionPolicy(
+///     mode: PlaybackInterruptionMode.resumePaused,
+///     backpressure: true,
+///   ),
+/// );
+/// ```
+final class PlaybackInterruptionPolicy extends Equatable {
+  /// Creates a new [PlaybackInterruptionPolicy] instance.
+  const PlaybackInterruptionPolicy({
+    required this.mode,
+    this.backpressure = false,
+  });
+
+  /// What happens to consumption and to the buffer.
+  final PlaybackInterruptionMode mode;
+
+  /// Whether pushes that do not fit while interrupted are cut short,
+  /// instead of dropping the oldest queued frames.
+  final bool backpressure;
+
+  @override
+  List<Object?> get props => [mode, backpressure];
+}
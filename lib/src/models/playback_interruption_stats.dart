@@ -0,0 +1,34 @@
+part of '../library.dart';
+
+/// The interruptions a [PlaybackDevice] went through.
+final class PlaybackInterruptionStats extends Equatable {
+  /// Creates a new [PlaybackInterruptionStats] instance.
+  const PlaybackInterruptionStats({
+    required this.isInterrupted,
+    required this.interruptionCount,
+    required this.droppedBytes,
+    required this.resumeLatency,
+  });
+
+  /// Whether an interruption began and has not ended.
+  final bool isInterrupted;
+
+  /// The number of interruptions since the device was created.
+  final int interruptionCount;
+
+  /// The bytes dropped when the last interruption ended, with
+  /// [PlaybackInterruptionMode.resumeLatest].
+  final int droppedBytes;
+
+  /// The time from the end of the last interruption to its first audible
+  /// frame, [Duration.zero] until it played.
+  final Duration resumeLatency;
+
+  @override
+  List<Object?> get props => [
+        isInterrupted,
+        interruptionCount,
+        droppedBytes,
+        resumeLatency,
+      ];
+}
@@ -0,0 +1,55 @@
+part of '../library.dart';
+
+/// Levels of the audio a [PlaybackDevice] actually output.
+///
+/// Levels are linear amplitudes relative to full scale, where `1.0` is
+/// 0 dBFS; use [toDecibels] for display. Loudness values are in LUFS and
+/// [double.negativeInfinity] below the -70 LUFS gate of EBU R128. Peaks fall
+/// back by 20 dB in 1.7 s, so reading once per UI frame does not miss short
+/// peaks.
+final class PlaybackMeter extends Equatable {
+  /// Creates a new [PlaybackMeter] instance.
+  const PlaybackMeter({
+    required this.peak,
+    required this.rms,
+    required this.truePeak,
+    required this.momentaryLoudness,
+    required this.shortTermLoudness,
+    required this.framesMetered,
+  });
+
+  /// The sample peak of each channel.
+  final List<double> peak;
+
+  /// The RMS level of each channel, averaged over 300 ms.
+  final List<double> rms;
+
+  /// The 4x oversampled peak of each channel, per ITU-R BS.1770.
+  ///
+  /// Unlike [peak], it catches the overshoot between samples that clips
+  /// after conversion to analog.
+  final List<double> truePeak;
+
+  /// The EBU R128 momentary loudness over the last 400 ms.
+  final double momentaryLoudness;
+
+  /// The EBU R128 short-term loudness over the last 3 s.
+  final double shortTermLoudness;
+
+  /// The number of frames measured since metering was enabled.
+  final int framesMetered;
+
+  /// Converts a linear [level] to dBFS.
+  static double toDecibels(double level) =>
+      level > 0 ? 20 * log(level) / ln10 : double.negativeInfinity;
+
+  @override
+  List<Object?> get props => [
+        peak,
+        rms,
+        truePeak,
+        momentaryLoudness,
+        shortTermLoudness,
+        framesMetered,
+      ];
+}
@@ -0,0 +1,25 @@
+part of '../library.dart';
+
+/// How a [PlaybackDevice] moved to another output, see
+/// [PlaybackDevice.migrate].
+final class PlaybackMigration extends Equatable {
+  /// Creates a new [PlaybackMigration] instance.
+  const PlaybackMigration({
+    required this.openDuration,
+    required this.switchDuration,
+    required this.bufferedBytes,
+  });
+
+  /// The time spent opening the new device while the old one kept playing.
+  final Duration openDuration;
+
+  /// The time from stopping the old device to starting the new one, during
+  /// which nothing played.
+  final Duration switchDuration;
+
+  /// The bytes queued in the buffer when the new device took over.
+  final int bufferedBytes;
+
+  @override
+  List<Object?> get props => [openDuration, switchDuration, bufferedBytes];
+}
@@ -0,0 +1,27 @@
+part of '../library.dart';
+
+/// The state of the playback pool of an [AudioContext].
+final class PlaybackPoolStats extends Equatable {
+  /// Creates a new [PlaybackPoolStats] instance.
+  const PlaybackPoolStats({
+    required this.idleDevices,
+    required this.lentDevices,
+    required this.hits,
+    required this.misses,
+  });
+
+  /// The started devices waiting in the pool.
+  final int idleDevices;
+
+  /// The devices acquired and not yet disposed.
+  final int lentDevices;
+
+  /// The acquisitions served by a warm device.
+  final int hits;
+
+  /// The acquisitions that had to open a device.
+  final int misses;
+
+  @override
+  List<Object?> get props => [idleDevices, lentDevices, hits, misses];
+}
@@ -0,0 +1,52 @@
+part of '../library.dart';
+
+/// A block of the output of a [PlaybackDevice], with its timing, for the
+/// reference input of an acoustic echo canceller.
+///
+/// Times are on the monotonic clock, in nanoseconds.
+final class PlaybackReferenceBlock extends Equatable {
+  /// Creates a new [PlaybackReferenceBlock] instance.
+  const PlaybackReferenceBlock({
+    required this.framePosition,
+    required this.timestampNs,
+    required this.presentationNs,
+    required this.latencyFrames,
+    required this.frameCount,
+    required this.droppedFrames,
+    required this.data,
+  });
+
+  /// The index of the first frame among all frames output since the tap
+  /// was enabled.
+  final int framePosition;
+
+  /// The time the audio callback that produced the block started.
+  final int timestampNs;
+
+  /// The estimated time the first frame reaches the speaker.
+  final int presentationNs;
+
+  /// The estimated frames between the audio callback and the speaker.
+  final int latencyFrames;
+
+  /// The number of frames in [data].
+  final int frameCount;
+
+  /// The frames lost right before this block because they were not read in
+  /// time.
+  final int droppedFrames;
+
+  /// The interleaved frames, in the format of the device.
+  final Uint8List data;
+
+  @override
+  List<Object?> get props => [
+        framePosition,
+        timestampNs,
+        presentationNs,
+        latencyFrames,
+        frameCount,
+        droppedFrames,
+        data,
+      ];
+}
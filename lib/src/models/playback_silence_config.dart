@@ -0,0 +1,58 @@
+part of '../library.dart';
+
+/// Configuration of the silence detector of a [PlaybackDevice].
+///
+/// ### Example Usage:
+/// ```dart
+/// playbackDevice.enableSilenceDetection(
+///   const PlaybackSilenceConfig(
+///     thresholdDb: -55,
+///     holdMs: 300,
+///     compactRecording: true,
+///   ),
+/// );
+/// ```
+class PlaybackSilenceConfig extends Equatable {
+  /// Creates a silence detector configuration.
+  ///
+  /// - [thresholdDb]: The peak level in dBFS below which audio is quiet.
+  ///   `0` selects -60.
+  /// - [noiseFloorMarginDb]: When above 0, audio is also quiet while its
+  ///   peak stays within this margin above the estimated noise floor.
+  /// - [holdMs]: How long audio must stay quiet before it counts as silent.
+  /// - [skipProcessing]: Whether silent audio bypasses the DSP chain.
+  /// - [compactRecording]: Whether silent audio is left out of the
+  ///   recording and listed in [WavEncoder.gaps] instead.
+  const PlaybackSilenceConfig({
+    this.thresholdDb = -60,
+    this.noiseFloorMarginDb = 0,
+    this.holdMs = 200,
+    this.skipProcessing = false,
+    this.compactRecording = false,
+  });
+
+  /// The peak level in dBFS below which audio is quiet.
+  final double thresholdDb;
+
+  /// The margin above the noise floor, in dB, within which audio is quiet.
+  final double noiseFloorMarginDb;
+
+  /// How long audio must stay quiet before it counts as silent, so that
+  /// word endings are kept.
+  final int holdMs;
+
+  /// Whether silent audio bypasses the DSP chain.
+  final bool skipProcessing;
+
+  /// Whether silent audio is recorded as gaps instead of frames.
+  final bool compactRecording;
+
+  @override
+  List<Object?> get props => [
+        thresholdDb,
+        noiseFloorMarginDb,
+        holdMs,
+        skipProcessing,
+        compactRecording,
+      ];
+}
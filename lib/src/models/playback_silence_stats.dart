@@ -0,0 +1,40 @@
+part of '../library.dart';
+
+/// What the silence detector of a [PlaybackDevice] measured.
+final class PlaybackSilenceStats extends Equatable {
+  /// Creates a new [PlaybackSilenceStats] instance.
+  const PlaybackSilenceStats({
+    required this.isSilent,
+    required this.levelDb,
+    required this.noiseFloorDb,
+    required this.totalFrames,
+    required this.silentFrames,
+  });
+
+  /// Whether the audio consumed most recently was silent.
+  final bool isSilent;
+
+  /// The peak of the audio consumed most recently, in dBFS.
+  final double levelDb;
+
+  /// The estimated RMS noise floor, in dBFS.
+  final double noiseFloorDb;
+
+  /// The number of frames analyzed since detection was enabled.
+  final int totalFrames;
+
+  /// The number of frames classified as silent.
+  final int silentFrames;
+
+  /// The fraction of the time that was silent, from 0 to 1.
+  double get silentFraction => totalFrames > 0 ? silentFrames / totalFrames : 0;
+
+  @override
+  List<Object?> get props => [
+        isSilent,
+        levelDb,
+        noiseFloorDb,
+        totalFrames,
+        silentFrames,
+      ];
+}
@@ -0,0 +1,75 @@
+part of '../library.dart';
+
+/// Window applied to each block before the FFT of a spectrum analyzer.
+enum SpectrumWindow {
+  /// No window: best frequency resolution, most leakage.
+  rectangular(0),
+
+  /// Good general-purpose window.
+  hann(1),
+
+  /// Lower first side lobe than [hann].
+  hamming(2),
+
+  /// 4-term window with very low leakage, for a wide dynamic range.
+  blackmanHarris(3);
+
+  /// Creates a [SpectrumWindow] with the associated integer value.
+  const SpectrumWindow(this.value);
+
+  /// The integer value used by the native library.
+  final int value;
+}
+
+/// Configuration of the spectrum analyzer of a [PlaybackDevice].
+///
+/// ### Example Usage:
+/// ```dart
+/// playbackDevice.startSpectrum(
+///   const SpectrumConfig(fftSize: 4096, smoothing: 0.8),
+/// );
+/// ```
+class SpectrumConfig extends Equatable {
+  /// Creates a spectrum analyzer configuration.
+  ///
+  /// - [fftSize]: The number of points of the FFT, a power of two from 64
+  ///   to 16384.
+  /// - [hopSize]: The number of frames between analyses. `0` selects half
+  ///   of [fftSize].
+  /// - [window]: The window applied before the FFT.
+  /// - [smoothing]: The weight of the previous magnitudes, from 0 to
+  ///   below 1.
+  const SpectrumConfig({
+    this.fftSize = 2048,
+    this.hopSize = 0,
+    this.window = SpectrumWindow.hann,
+    this.smoothing = 0,
+  });
+
+  /// The number of points of the FFT.
+  ///
+  /// The spectrum has `fftSize / 2 + 1` bins spaced `sampleRate / fftSize`
+  /// Hertz apart.
+  final int fftSize;
+
+  /// The number of frames between analyses.
+  final int hopSize;
+
+  /// The window applied before the FFT.
+  final SpectrumWindow window;
+
+  /// The weight of the previous magnitudes, as in Web Audio's
+  /// `smoothingTimeConstant`.
+  final double smoothing;
+
+  /// The number of magnitude bins.
+  int get binCount => fftSize ~/ 2 + 1;
+
+  @override
+  List<Object?> get props => [
+        fftSize,
+        hopSize,
+        window,
+        smoothing,
+      ];
+}
@@ -1,24 +1,54 @@
 part of '../library.dart';
 
+/// How a [WavEncoder] stores samples in the file.
+///
+/// Frames are always written in [WavEncoderConfig.pcmFormat]; a compact
+/// storage converts them while encoding, so an `f32` device can record a
+/// much smaller file.
+enum WavEncoderStorage {
+  /// PCM in [WavEncoderConfig.pcmFormat], as the frames are written.
+  pcm(0),
+
+  /// 16-bit PCM, half the size of `f32`.
+  pcmS16(1),
+
+  /// 4-bit IMA ADPCM, about a quarter of 16-bit PCM.
+  ///
+  /// Lossy. Only mono and stereo are supported.
+  imaAdpcm(2);
+
+  /// Creates a [WavEncoderStorage] with the associated integer value.
+  const WavEncoderStorage(this.value);
+
+  /// The integer value used by the native library.
+  final int value;
+}
+
 class WavEncoderConfig extends Equatable {
   /// Creates a new [WavEncoderConfig] instance with the specified properties.
   ///
   /// - [channels]: The number of audio channels.
   /// - [sampleRate]: The sample rate in Hertz.
   /// - [pcmFormat]: The audio sample format.
+  /// - [storage]: How samples are stored in the file.
   const WavEncoderConfig({
     required this.channels,
     required this.sampleRate,
     required this.pcmFormat,
+    this.storage = WavEncoderStorage.pcm,
   });
 
   /// Creates a new [WavEncoderConfig] instance from the specified
   /// [AudioFormat].
-  factory WavEncoderConfig.fromAudioFormat(AudioFormat audioFormat) =>
+  factory WavEncoderConfig.fromAudioFormat(
+    AudioFormat audioFormat, {
+    WavEncoderStorage storage = WavEncoderStorage.pcm,
+  }) =>
       WavEncoderConfig(
         channels: audioFormat.channels,
         sampleRate: audioFormat.sampleRate,
         pcmFormat: audioFormat.pcmFormat,
+        storage: storage,
       );
 
   /// The number of audio channels.
@@ -42,6 +72,9 @@ class WavEncoderConfig extends Equatable {
   /// - `PcmFormat.f32`: 32-bit floating point.
   final PcmFormat pcmFormat;
 
+  /// How samples are stored in the file.
+  final WavEncoderStorage storage;
+
   @override
-  List<Object?> get props => [channels, sampleRate, pcmFormat];
+  List<Object?> get props => [channels, sampleRate, pcmFormat, storage];
 }
@@ -0,0 +1,45 @@
+part of '../library.dart';
+
+/// When a [WavEncoder.segmented] encoder rolls over to a new file.
+///
+/// A segment ends as soon as either limit is reached. At least one limit must
+/// be set.
+///
+/// ### Example Usage:
+/// ```dart
+/// const segmentConfig = WavEncoderSegmentConfig(
+///   segmentSeconds: 600,
+///   segmentBytes: 2 * 1024 * 1024 * 1024,
+/// );
+/// ```
+class WavEncoderSegmentConfig extends Equatable {
+  /// Creates a segmentation configuration.
+  ///
+  /// - [segmentSeconds]: The length of a segment. `0` for no time limit.
+  /// - [segmentBytes]: The maximum size of a segment file. `0` for no size
+  ///   limit.
+  /// - [writerConfig]: Writes segments with the block writer of
+  ///   [WavEncoder.writer] when set.
+  const WavEncoderSegmentConfig({
+    this.segmentSeconds = 0,
+    this.segmentBytes = 0,
+    this.writerConfig,
+  });
+
+  /// The length of a segment in seconds.
+  final int segmentSeconds;
+
+  /// The maximum size of a segment file in bytes.
+  final int segmentBytes;
+
+  /// The block writer configuration of the segment files, or `null` to write
+  /// them with buffered stdio.
+  final WavEncoderWriterConfig? writerConfig;
+
+  @override
+  List<Object?> get props => [
+        segmentSeconds,
+        segmentBytes,
+        writerConfig,
+      ];
+}
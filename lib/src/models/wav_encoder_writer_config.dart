@@ -0,0 +1,81 @@
+part of '../library.dart';
+
+/// When a [WavEncoder.writer] encoder forces written data to storage.
+enum WavEncoderFsyncPolicy {
+  /// Leave flushing to the operating system.
+  never(0),
+
+  /// Sync once when the encoder is finalized.
+  onClose(1),
+
+  /// Sync every [WavEncoderWriterConfig.fsyncIntervalBytes] and on close.
+  interval(2);
+
+  /// Creates a [WavEncoderFsyncPolicy] with the associated integer value.
+  const WavEncoderFsyncPolicy(this.value);
+
+  /// The integer value used by the native library.
+  final int value;
+}
+
+/// Configuration of the block writer behind [WavEncoder.writer].
+///
+/// ### Example Usage:
+/// ```dart
+/// const writerConfig = WavEncoderWriterConfig(
+///   blockSize: 4 * 1024 * 1024,
+///   preallocateSize: 64 * 1024 * 1024,
+///   fsyncPolicy: WavEncoderFsyncPolicy.interval,
+///   fsyncIntervalBytes: 32 * 1024 * 1024,
+/// );
+/// ```
+class WavEncoderWriterConfig extends Equatable {
+  /// Creates a writer configuration.
+  ///
+  /// - [blockSize]: The number of bytes collected per write. `0` selects
+  ///   1 MiB.
+  /// - [preallocateSize]: The file extent reserved ahead of the written data.
+  ///   `0` disables preallocation.
+  /// - [useDirectIo]: Whether to bypass the page cache.
+  /// - [fsyncPolicy]: When written data is synced to storage.
+  /// - [fsyncIntervalBytes]: The number of bytes between syncs for
+  ///   [WavEncoderFsyncPolicy.interval].
+  const WavEncoderWriterConfig({
+    this.blockSize = 0,
+    this.preallocateSize = 0,
+    this.useDirectIo = false,
+    this.fsyncPolicy = WavEncoderFsyncPolicy.onClose,
+    this.fsyncIntervalBytes = 0,
+  });
+
+  /// The number of bytes collected per write, rounded up to 4 KiB.
+  ///
+  /// Larger blocks mean fewer but longer writes on the recording thread.
+  final int blockSize;
+
+  /// The file extent reserved ahead of the written data.
+  ///
+  /// Space that ends up unused is released when the encoder is finalized.
+  final int preallocateSize;
+
+  /// Whether to bypass the page cache.
+  ///
+  /// Falls back to buffered writes when the file system does not support it;
+  /// [WavEncoderWriterStats.isDirectIo] tells which mode is used.
+  final bool useDirectIo;
+
+  /// When written data is synced to storage.
+  final WavEncoderFsyncPolicy fsyncPolicy;
+
+  /// The number of bytes between syncs for [WavEncoderFsyncPolicy.interval].
+  final int fsyncIntervalBytes;
+
+  @override
+  List<Object?> get props => [
+        blockSize,
+        preallocateSize,
+        useDirectIo,
+        fsyncPolicy,
+        fsyncIntervalBytes,
+      ];
+}
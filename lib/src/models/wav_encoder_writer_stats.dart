@@ -0,0 +1,53 @@
+part of '../library.dart';
+
+/// I/O statistics of a [WavEncoder.writer] encoder.
+final class WavEncoderWriterStats extends Equatable {
+  /// Creates a new [WavEncoderWriterStats] instance.
+  const WavEncoderWriterStats({
+    required this.bytesWritten,
+    required this.writeCalls,
+    required this.readCalls,
+    required this.preallocateCalls,
+    required this.syncCalls,
+    required this.ioSeconds,
+    required this.megabytesPerSecond,
+    required this.isDirectIo,
+  });
+
+  /// The number of bytes passed to write calls, including alignment padding.
+  final int bytesWritten;
+
+  /// The number of write system calls.
+  final int writeCalls;
+
+  /// The number of reads of already written blocks, e.g. for the header
+  /// patch.
+  final int readCalls;
+
+  /// The number of preallocation system calls.
+  final int preallocateCalls;
+
+  /// The number of sync system calls.
+  final int syncCalls;
+
+  /// The time spent in the system calls above, in seconds.
+  final double ioSeconds;
+
+  /// The achieved write throughput in MB (10^6 bytes) per second of I/O time.
+  final double megabytesPerSecond;
+
+  /// Whether the page cache is actually bypassed.
+  final bool isDirectIo;
+
+  @override
+  List<Object?> get props => [
+        bytesWritten,
+        writeCalls,
+        readCalls,
+        preallocateCalls,
+        syncCalls,
+        ioSeconds,
+        megabytesPerSecond,
+        isDirectIo,
+      ];
+}
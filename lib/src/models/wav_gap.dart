@@ -0,0 +1,25 @@
+part of '../library.dart';
+
+/// A stretch of silence left out of a [WavEncoder] recording.
+///
+/// To restore the original timeline, insert [frameCount] silent frames
+/// after the first [position] frames of the file.
+final class WavGap extends Equatable {
+  /// Creates a new [WavGap] instance.
+  const WavGap({
+    required this.position,
+    required this.frameCount,
+  });
+
+  /// The number of frames of the file that precede the gap.
+  final int position;
+
+  /// The number of silent frames the gap stands for.
+  final int frameCount;
+
+  @override
+  List<Object?> get props => [
+        position,
+        frameCount,
+      ];
+}
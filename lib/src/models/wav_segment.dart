@@ -0,0 +1,42 @@
+part of '../library.dart';
+
+/// A completed file of a [WavEncoder.segmented] recording.
+final class WavSegment extends Equatable {
+  /// Creates a new [WavSegment] instance.
+  const WavSegment({
+    required this.index,
+    required this.filePath,
+    required this.firstFrame,
+    required this.frameCount,
+    required this.sizeInBytes,
+    required this.isLast,
+  });
+
+  /// The segment index, starting at 0.
+  final int index;
+
+  /// The path of the finalized segment file.
+  final String filePath;
+
+  /// The position of the first frame of the segment in the recording.
+  final int firstFrame;
+
+  /// The number of frames in the segment.
+  final int frameCount;
+
+  /// The size of the segment file in bytes.
+  final int sizeInBytes;
+
+  /// Whether this is the last segment of the recording.
+  final bool isLast;
+
+  @override
+  List<Object?> get props => [
+        index,
+        filePath,
+        firstFrame,
+        frameCount,
+        sizeInBytes,
+        isLast,
+      ];
+}
@@ -0,0 +1,121 @@
+part of '../library.dart';
+
+/// Describes how the oscillators of a [WaveformBank] are written to the
+/// output.
+enum WaveformBankMix {
+  /// Each oscillator is written to its own channel.
+  ///
+  /// The number of output channels equals the number of oscillators.
+  interleaved(0),
+
+  /// All oscillators are summed and the sum is written to every channel.
+  summed(1);
+
+  /// Creates a [WaveformBankMix] with the associated integer value.
+  const WaveformBankMix(this.value);
+
+  /// The integer value used by the native library.
+  final int value;
+}
+
+/// Parameters of a single oscillator in a [WaveformBank].
+///
+/// ### Example Usage:
+/// ```dart
+/// const oscillator = WaveformBankOscillator(
+///   type: WaveformType.sine,
+///   amplitude: 0.5,
+///   frequency: 440.0,
+/// );
+/// ```
+class WaveformBankOscillator extends Equatable {
+  /// Creates an oscillator description.
+  ///
+  /// - [type]: The waveform shape.
+  /// - [amplitude]: The amplitude, typically between `0.0` and `1.0`.
+  /// - [frequency]: The frequency in Hertz.
+  const WaveformBankOscillator({
+    required this.type,
+    required this.amplitude,
+    required this.frequency,
+  });
+
+  /// The waveform shape of the oscillator.
+  final WaveformType type;
+
+  /// The amplitude of the oscillator.
+  final double amplitude;
+
+  /// The frequency of the oscillator in Hertz.
+  final double frequency;
+
+  @override
+  List<Object?> get props => [type, amplitude, frequency];
+}
+
+/// Configuration for a [WaveformBank].
+///
+/// ### Example Usage:
+/// ```dart
+/// final config = WaveformBankConfig(
+///   sampleFormat: PcmFormat.f32,
+///   sampleRate: 48000,
+///   mix: WaveformBankMix.interleaved,
+///   oscillators: [
+///     for (var i = 0; i < 32; i++)
+///       WaveformBankOscillator(
+///         type: WaveformType.sine,
+///         amplitude: 0.5,
+///         frequency: 100.0 * (i + 1),
+///       ),
+///   ],
+/// );
+/// ```
+class WaveformBankConfig extends Equatable {
+  /// Creates a waveform bank configuration.
+  ///
+  /// - [sampleFormat]: The audio sample format of the output.
+  /// - [sampleRate]: The sample rate in Hertz.
+  /// - [mix]: How oscillators are written to the output.
+  /// - [oscillators]: The oscillators of the bank.
+  /// - [channels]: The number of output channels for [WaveformBankMix.summed].
+  ///   Ignored for [WaveformBankMix.interleaved].
+  const WaveformBankConfig({
+    required this.sampleFormat,
+    required this.sampleRate,
+    required this.mix,
+    required this.oscillators,
+    this.channels = 1,
+  });
+
+  /// The audio sample format of the output.
+  final PcmFormat sampleFormat;
+
+  /// The sample rate in Hertz.
+  final int sampleRate;
+
+  /// How oscillators are written to the output.
+  final WaveformBankMix mix;
+
+  /// The oscillators of the bank.
+  final List<WaveformBankOscillator> oscillators;
+
+  /// The requested output channels for [WaveformBankMix.summed].
+  final int channels;
+
+  /// The number of channels in each output frame.
+  int get outputChannels =>
+      mix == WaveformBankMix.interleaved ? oscillators.length : channels;
+
+  /// The number of bytes per output frame.
+  int get bpf => sampleFormat.bps * outputChannels;
+
+  @override
+  List<Object?> get props => [
+        sampleFormat,
+        sampleRate,
+        mix,
+        oscillators,
+        channels,
+      ];
+}
@@ -75,28 +75,131 @@ final class PlaybackDevice extends ManagedResource<Void> {
     );
   }
 
+  /// Takes a started device from the playback pool of [context], see
+  /// [AudioContext.warmPlaybackDevices].
+  ///
+  /// A warm device plays pushed audio within one period. If none is warm
+  /// for [id] and [config], a device is opened and started. Disposing the
+  /// device returns it to the pool instead of closing it.
+  ///
+  /// Throws:
+  /// - [StateError] if the [AudioContext] is finalized.
+  /// - [Exception] if the device creation fails.
+  factory PlaybackDevice.acquire({
+    required DeviceId? id,
+    required AudioContext context,
+    required PlaybackConfig config,
+  }) {
+    final nativeConfig = config.toNative();
+    final pContext = context.ensureIsNotFinalized();
+
+    final device = _bindings.playback_pool_acquire(
+      pContext,
+      id == null ? nullptr : id.ensureIsNotFinalized(),
+      nativeConfig.ensureIsNotFinalized(),
+    );
+
+    if (device == nullptr) {
+      throw Exception('Failed to acquire playback device');
+    }
+
+    return PlaybackDevice._(
+      device,
+      context: context,
+      config: config,
+      id: id,
+      isPooled: true,
+    );
+  }
+
   /// Internal constructor.
   PlaybackDevice._(
     super.ptr, {
     required this.context,
-    required this.config,
-    required this.id,
-  }) : super._();
+    required PlaybackConfig config,
+    required DeviceId? id,
+    this.isPooled = false,
+  })  : _config = config,
+        _id = id,
+        super._();
+
+  /// Whether the device came from the playback pool and goes back to it
+  /// when disposed.
+  final bool isPooled;
 
-  /// The playback configuration for this device.
-  final PlaybackConfig config;
+  /// The playback configuration for this device, updated by [resizeBuffer].
+  PlaybackConfig get config => _config;
+  PlaybackConfig _config;
 
-  /// Information about the playback device.
-  final DeviceId? id;
+  /// Information about the playback device, updated by [migrate].
+  DeviceId? get id => _id;
+  DeviceId? _id;
 
   /// The [AudioContext] that manages this device.
   final AudioContext context;
 
   @protected
   @override
-  void releaseResource() => _bindings.playback_device_destroy(
-        ensureIsNotFinalized(),
-      );
+  void releaseResource() {
+    if (isPooled) {
+      _bindings.playback_pool_release(ensureIsNotFinalized());
+    } else {
+      _bindings.playback_device_destroy(ensureIsNotFinalized());
+    }
+
+    _releaseSpectrumBins();
+  }
+
+  _PlaybackEvents? _events;
+
+  /// Returns a stream of device events, replacing polling [state] and
+  /// pushing on a timer.
+  ///
+  /// Events are posted natively without blocking the audio thread and
+  /// delivered asynchronously on this isolate. Listening starts delivery;
+  /// cancelling the subscription stops it. Calling [events] again replaces
+  /// the previous stream, which is closed. Disposing the device closes the
+  /// stream after the last event.
+  ///
+  /// - [lowWatermarkBytes]: The buffer fill below which
+  ///   [PlaybackEventType.needData] is posted. `0` selects
+  ///   [PlaybackConfig.rbMaxThreshold].
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  Stream<PlaybackEvent> events({int lowWatermarkBytes = 0}) {
+    late final _PlaybackEvents events;
+
+    final controller = StreamController<PlaybackEvent>(
+      onListen: () {
+        _events = events;
+
+        if (!_bindings.playback_device_set_event_callback(
+          ensureIsNotFinalized(),
+          lowWatermarkBytes,
+          events.callable.nativeFunction,
+          nullptr,
+        )) {
+          events.close();
+          throw StateError('Failed to start the event dispatcher');
+        }
+      },
+      onCancel: () {
+        if (identical(_events, events) && !isFinalized) {
+          _bindings.playback_device_set_event_callback(
+            ensureIsNotFinalized(),
+            0,
+            nullptr,
+            nullptr,
+          );
+        }
+      },
+    );
+
+    events = _PlaybackEvents(controller);
+
+    return controller.stream;
+  }
 
   /// Resets the internal buffer of the playback device.
   ///
@@ -109,6 +212,40 @@ final class PlaybackDevice extends ManagedResource<Void> {
         ensureIsNotFinalized(),
       );
 
+  /// Resizes the ring buffer to [sizeInBytes], rounded down to whole
+  /// frames, without stopping playback.
+  ///
+  /// The queued data moves to the new buffer, the newest first when it is
+  /// smaller, and a started device continues with the next frame. Use it
+  /// when the latency budget changes, for example from music to a call.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  /// - [ArgumentError] if [sizeInBytes] is below one frame or
+  ///   [PlaybackConfig.ringBufferMaxThreshold], or could not be allocated.
+  void resizeBuffer(int sizeInBytes) {
+    if (sizeInBytes < 0 ||
+        !_bindings.playback_device_resize_buffer(
+          ensureIsNotFinalized(),
+          sizeInBytes,
+        )) {
+      throw ArgumentError.value(
+        sizeInBytes,
+        'sizeInBytes',
+        'Invalid ring buffer size',
+      );
+    }
+
+    _config = PlaybackConfig(
+      channels: _config.channels,
+      sampleRate: _config.sampleRate,
+      pcmFormat: _config.pcmFormat,
+      ringBufferMaxThreshold: _config.ringBufferMaxThreshold,
+      ringBufferMinThreshold: _config.ringBufferMinThreshold,
+      ringBufferSizeInBytes: sizeInBytes - sizeInBytes % _config.bpf,
+    );
+  }
+
   /// Starts audio playback.
   ///
   /// Throws:
@@ -119,8 +256,9 @@ final class PlaybackDevice extends ManagedResource<Void> {
 
   /// Stops audio playback.
   ///
-  /// This halts ongoing playback and prepares the device for further
-  /// operations.
+  /// This halts the backend stream and prepares the device for further
+  /// operations. Buffered data is kept; see [pause] to keep the stream
+  /// open as well.
   ///
   /// Throws:
   /// - [StateError] if the device is finalized or not initialized.
@@ -128,6 +266,103 @@ final class PlaybackDevice extends ManagedResource<Void> {
         ensureIsNotFinalized(),
       );
 
+  /// Starts audio playback on the worker thread of the context, so a slow
+  /// backend never blocks the caller.
+  ///
+  /// Transitions queued on the same context run in order.
+  ///
+  /// Returns:
+  /// - The [DeviceState] the device reached.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized, the request could not be
+  ///   queued, or the device failed to start.
+  Future<DeviceState> startAsync() => _transitionAsync(
+        isStart: true,
+      );
+
+  /// Stops audio playback on the worker thread of the context, so a slow
+  /// backend never blocks the caller.
+  ///
+  /// Returns:
+  /// - The [DeviceState] the device reached.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized, the request could not be
+  ///   queued, or the device failed to stop.
+  Future<DeviceState> stopAsync() => _transitionAsync(
+        isStart: false,
+      );
+
+  /// Pauses playback without stopping the backend stream.
+  ///
+  /// The device outputs silence and keeps its buffer, or the position of
+  /// its data source, so [resume] picks up at the next frame without a
+  /// restart. Pushed data keeps filling the buffer meanwhile. The pause
+  /// outlives [stop] and [start].
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  void pause() => _bindings.playback_device_pause(
+        ensureIsNotFinalized(),
+      );
+
+  /// Resumes a paused device at the next frame.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  void resume() => _bindings.playback_device_resume(
+        ensureIsNotFinalized(),
+      );
+
+  /// Whether the device is paused, see [pause].
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  bool get isPaused => _bindings.playback_device_is_paused(
+        ensureIsNotFinalized(),
+      );
+
+  Future<DeviceState> _transitionAsync({required bool isStart}) {
+    final self = ensureIsNotFinalized();
+    final completer = Completer<DeviceState>();
+    final action = isStart ? 'start' : 'stop';
+    late final NativeCallable<playback_transition_callback_tFunction> callable;
+
+    callable = NativeCallable<playback_transition_callback_tFunction>.listener(
+      (Pointer<Void> _, bool isSuccess, int state) {
+        callable.close();
+
+        if (isSuccess) {
+          completer.complete(DeviceState.fromValue(state));
+        } else {
+          completer.completeError(
+            StateError('Failed to $action the playback device.'),
+          );
+        }
+      },
+    );
+
+    final isQueued = isStart
+        ? _bindings.playback_device_start_async(
+            self,
+            callable.nativeFunction,
+            nullptr,
+          )
+        : _bindings.playback_device_stop_async(
+            self,
+            callable.nativeFunction,
+            nullptr,
+          );
+
+    if (!isQueued) {
+      callable.close();
+      throw StateError('Failed to queue the playback device $action.');
+    }
+
+    return completer.future;
+  }
+
   /// Gets the current state of the playback device.
   ///
   /// Returns:
@@ -143,6 +378,523 @@ final class PlaybackDevice extends ManagedResource<Void> {
     return DeviceState.values[state.index];
   }
 
+  /// The linear gain applied to the output, `1.0` by default.
+  ///
+  /// Changes ramp smoothly over about 10 ms in the audio callback, so they
+  /// never click and never stop the stream. The encoder records the frames
+  /// before the gain, so muting does not silence the recording.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  double get volume => _bindings.playback_device_get_volume(
+        ensureIsNotFinalized(),
+      );
+
+  /// Sets the linear gain applied to the output.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  /// - [RangeError] if [volume] is not between `0.0` and `4.0`.
+  set volume(double volume) {
+    if (!_bindings.playback_device_set_volume(ensureIsNotFinalized(), volume)) {
+      throw RangeError.range(volume, 0, 4, 'volume');
+    }
+  }
+
+  /// Whether the output is muted.
+  ///
+  /// Muting ramps the output down without stopping the device, which keeps
+  /// consuming its buffer, so unmuting is instant.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  bool get isMuted => _bindings.playback_device_is_muted(
+        ensureIsNotFinalized(),
+      );
+
+  /// Mutes or unmutes the output.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  set isMuted(bool muted) {
+    _bindings.playback_device_set_muted(ensureIsNotFinalized(), muted);
+  }
+
+  /// Whether the output is metered, see [meter].
+  bool get isMeteringEnabled => _isMeteringEnabled;
+  bool _isMeteringEnabled = false;
+
+  /// Enables or disables metering of the output.
+  ///
+  /// Enabling resets the levels.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  /// - [UnsupportedError] if the device has more than 8 channels.
+  set isMeteringEnabled(bool enabled) {
+    if (!_bindings.playback_device_set_metering_enabled(
+      ensureIsNotFinalized(),
+      enabled,
+    )) {
+      throw UnsupportedError('Metering supports up to 8 channels');
+    }
+
+    _isMeteringEnabled = enabled;
+  }
+
+  /// The levels of the audio played most recently, or `null` if metering
+  /// is disabled.
+  ///
+  /// Levels are measured natively on the frames actually output, including
+  /// silence on underruns and audio from an attached [source]. Reading never
+  /// blocks the audio thread and is cheap enough for every UI frame.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  PlaybackMeter? get meter {
+    final pMeter = malloc<playback_meter_t>();
+
+    try {
+      if (!_bindings.playback_device_get_meter(ensureIsNotFinalized(), pMeter)) {
+        return null;
+      }
+
+      final meter = pMeter.ref;
+      final channels = meter.channels;
+
+      return PlaybackMeter(
+        peak: List.generate(channels, (c) => meter.peak[c]),
+        rms: List.generate(channels, (c) => meter.rms[c]),
+        truePeak: List.generate(channels, (c) => meter.truePeak[c]),
+        momentaryLoudness: meter.momentaryLoudness,
+        shortTermLoudness: meter.shortTermLoudness,
+        framesMetered: meter.framesMetered,
+      );
+    } finally {
+      malloc.free(pMeter);
+    }
+  }
+
+  /// Exports the output for the reference input of an echo canceller.
+  ///
+  /// Every frame output after the DSP chain and [volume] is queued, with the
+  /// time of its audio callback and the estimated output latency, in a
+  /// lock-free ring of [capacityFrames] frames. Read it with
+  /// [readReference]. Native cancellers can read the ring in place through
+  /// `playback_device_acquire_reference`.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  /// - [OutOfMemoryError] if the ring cannot be allocated.
+  void enableReferenceTap({int capacityFrames = 48000}) {
+    if (!_bindings.playback_device_set_reference_tap(
+      ensureIsNotFinalized(),
+      capacityFrames,
+    )) {
+      throw OutOfMemoryError();
+    }
+  }
+
+  /// Stops exporting the output, see [enableReferenceTap].
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  void disableReferenceTap() {
+    _bindings.playback_device_set_reference_tap(ensureIsNotFinalized(), 0);
+  }
+
+  /// Reads the oldest block of the reference tap, or `null` if none is
+  /// ready or the tap is disabled.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  PlaybackReferenceBlock? readReference() {
+    final resource = ensureIsNotFinalized();
+    final pBlock = malloc<playback_reference_block_t>();
+
+    try {
+      final pFrames = _bindings.playback_device_acquire_reference(
+        resource,
+        pBlock,
+      );
+
+      if (pFrames == nullptr) {
+        return null;
+      }
+
+      final block = pBlock.ref;
+      final data = Uint8List.fromList(
+        pFrames.cast<Uint8>().asTypedList(block.frameCount * config.bpf),
+      );
+
+      _bindings.playback_device_release_reference(resource);
+
+      return PlaybackReferenceBlock(
+        framePosition: block.framePosition,
+        timestampNs: block.timestampNs,
+        presentationNs: block.presentationNs,
+        latencyFrames: block.latencyFrames,
+        frameCount: block.frameCount,
+        droppedFrames: block.droppedFrames,
+        data: data,
+      );
+    } finally {
+      malloc.free(pBlock);
+    }
+  }
+
+  /// Enables detection of silence in the audio the device consumes.
+  ///
+  /// Detection runs natively in the audio callback and tracks the noise
+  /// floor. Silent audio can bypass the DSP chain and be left out of the
+  /// recording, see [PlaybackSilenceConfig]. Enabling again restarts the
+  /// statistics.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  /// - [OutOfMemoryError] if the detector cannot be allocated.
+  void enableSilenceDetection(PlaybackSilenceConfig config) {
+    final configPtr = config.toNative().ensureIsNotFinalized();
+
+    if (!_bindings.playback_device_set_silence_detection(
+      ensureIsNotFinalized(),
+      configPtr,
+    )) {
+      throw OutOfMemoryError();
+    }
+  }
+
+  /// Disables silence detection, see [enableSilenceDetection].
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  void disableSilenceDetection() {
+    _bindings.playback_device_set_silence_detection(
+      ensureIsNotFinalized(),
+      nullptr,
+    );
+  }
+
+  /// What the silence detector measured, or `null` if detection is
+  /// disabled.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  PlaybackSilenceStats? get silenceStats {
+    final pStats = malloc<playback_silence_stats_t>();
+
+    try {
+      if (!_bindings.playback_device_get_silence_stats(
+        ensureIsNotFinalized(),
+        pStats,
+      )) {
+        return null;
+      }
+
+      final stats = pStats.ref;
+
+      return PlaybackSilenceStats(
+        isSilent: stats.isSilent,
+        levelDb: stats.levelDb,
+        noiseFloorDb: stats.noiseFloorDb,
+        totalFrames: stats.totalFrames,
+        silentFrames: stats.silentFrames,
+      );
+    } finally {
+      malloc.free(pStats);
+    }
+  }
+
+  /// The overview attached with [attachOverview], if any.
+  AudioOverview? get overview => _overview;
+  AudioOverview? _overview;
+
+  /// Feeds the output into [overview], e.g. to draw the waveform of what is
+  /// being played.
+  ///
+  /// The overview must have the sample format and channel count of [config].
+  /// The device keeps a reference to the overview, so it is not finalized
+  /// while playing. Once this method returns, the previous overview is no
+  /// longer written to.
+  ///
+  /// Throws:
+  /// - [StateError] if the device or the overview is finalized.
+  /// - [ArgumentError] if the overview format does not match the device.
+  void attachOverview(AudioOverview overview) {
+    final attached = _bindings.playback_device_set_overview(
+      ensureIsNotFinalized(),
+      overview.ensureIsNotFinalized(),
+    );
+
+    if (!attached) {
+      throw ArgumentError.value(
+        overview,
+        'overview',
+        'Format does not match the playback device',
+      );
+    }
+
+    _overview = overview;
+  }
+
+  /// Stops feeding the overview attached with [attachOverview].
+  void detachOverview() {
+    _bindings.playback_device_set_overview(ensureIsNotFinalized(), nullptr);
+    _overview = null;
+  }
+
+  /// Replaces the DSP chain applied to the output.
+  ///
+  /// The stages run in order on the audio thread, after the data is read
+  /// and before metering and analysis taps; the encoder records the frames
+  /// before the chain. The chain is built here, so the audio thread never
+  /// allocates. An empty list removes the chain. Use [updateDspStage] to
+  /// change parameters without rebuilding the filters and losing their
+  /// state.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  /// - [ArgumentError] if a stage is invalid or there are too many stages.
+  void setDspChain(List<PlaybackDspStage> stages) {
+    final resource = ensureIsNotFinalized();
+    final stagesPtr = stages.toNative().ensureIsNotFinalized();
+
+    if (!_bindings.playback_device_set_dsp_chain(
+      resource,
+      stages.isEmpty ? nullptr : stagesPtr,
+      stages.length,
+    )) {
+      throw ArgumentError.value(stages, 'stages', 'Invalid DSP chain');
+    }
+  }
+
+  /// Changes the parameters of the stage at [index] of the DSP chain.
+  ///
+  /// The update reaches the audio thread through a lock-free queue. The
+  /// type, the filter order and the delay length of a stage cannot change.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  /// - [ArgumentError] if the update is invalid or the queue is full.
+  void updateDspStage(int index, PlaybackDspStage stage) {
+    final resource = ensureIsNotFinalized();
+    final stagePtr = stage.toNative().ensureIsNotFinalized();
+
+    if (!_bindings.playback_device_update_dsp_stage(resource, index, stagePtr)) {
+      throw ArgumentError.value(stage, 'stage', 'Invalid DSP stage update');
+    }
+  }
+
+  /// The configuration of the running spectrum analyzer, if any.
+  SpectrumConfig? get spectrumConfig => _spectrumConfig;
+  SpectrumConfig? _spectrumConfig;
+  Pointer<Float> _pSpectrum = nullptr;
+
+  /// Starts analyzing the spectrum of the output, see [spectrum].
+  ///
+  /// The audio thread only copies the output into a tap; windowing and the
+  /// FFT run on a native worker thread. Starting again restarts the
+  /// analyzer with the new [config].
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  /// - [ArgumentError] if the configuration is invalid.
+  void startSpectrum(SpectrumConfig config) {
+    final resource = ensureIsNotFinalized();
+    final configPtr = config.toNative().ensureIsNotFinalized();
+
+    if (!_bindings.playback_device_set_spectrum(resource, configPtr)) {
+      throw ArgumentError.value(config, 'config', 'Invalid spectrum config');
+    }
+
+    _releaseSpectrumBins();
+    _pSpectrum = malloc<Float>(config.binCount);
+    _spectrumConfig = config;
+  }
+
+  /// Stops the spectrum analyzer.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  void stopSpectrum() {
+    _bindings.playback_device_set_spectrum(ensureIsNotFinalized(), nullptr);
+    _releaseSpectrumBins();
+    _spectrumConfig = null;
+  }
+
+  void _releaseSpectrumBins() {
+    if (_pSpectrum != nullptr) {
+      malloc.free(_pSpectrum);
+      _pSpectrum = nullptr;
+    }
+  }
+
+  /// The latest magnitude spectrum of the output, or `null` if the analyzer
+  /// is stopped or has not completed its first analysis.
+  ///
+  /// Bin `k` is the linear magnitude at `k * sampleRate / fftSize` Hertz,
+  /// scaled so that a full-scale sine reads `1.0`. Reading never blocks the
+  /// audio thread.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  Float32List? get spectrum {
+    final config = _spectrumConfig;
+
+    if (config == null) {
+      return null;
+    }
+
+    final count = _bindings.playback_device_get_spectrum(
+      ensureIsNotFinalized(),
+      _pSpectrum,
+      config.binCount,
+      nullptr,
+    );
+
+    return count == 0
+        ? null
+        : Float32List.fromList(_pSpectrum.asTypedList(count));
+  }
+
+  /// The data source currently attached with [attachSource], if any.
+  DataSource? get source => _source;
+  DataSource? _source;
+
+  /// Attaches a native [source] the device pulls audio from.
+  ///
+  /// While a source is attached, the audio callback reads frames directly
+  /// from it and [pushBuffer] data is kept in the ring buffer until the
+  /// source is detached. The source must produce the same sample format,
+  /// channel count and sample rate as [config], and must not be read from
+  /// Dart while attached. The device keeps a reference to the source, so it
+  /// is not finalized while playing.
+  ///
+  /// Replacing a source while the device is running is seamless; once this
+  /// method returns, the previous source can be disposed.
+  ///
+  /// Throws:
+  /// - [StateError] if the device or the source is finalized.
+  /// - [ArgumentError] if the source format does not match the device.
+  void attachSource(DataSource source) {
+    final attached = _bindings.playback_device_attach_source(
+      ensureIsNotFinalized(),
+      source.ensureIsNotFinalized(),
+    );
+
+    if (!attached) {
+      throw ArgumentError.value(
+        source,
+        'source',
+        'Format does not match the playback device',
+      );
+    }
+
+    _source = source;
+  }
+
+  /// Detaches the current data source and returns to ring buffer playback.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized or not initialized.
+  void detachSource() {
+    _bindings.playback_device_detach_source(ensureIsNotFinalized());
+    _source = null;
+  }
+
+  /// Sets how the device handles interruptions, such as a phone call,
+  /// or ignores them if [policy] is `null`.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized.
+  void setInterruptionPolicy(PlaybackInterruptionPolicy? policy) {
+    final nativePolicy = policy?.toNative();
+
+    _bindings.playback_device_set_interruption_policy(
+      ensureIsNotFinalized(),
+      nativePolicy == null ? nullptr : nativePolicy.ensureIsNotFinalized(),
+    );
+  }
+
+  /// The interruptions the device went through.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized.
+  PlaybackInterruptionStats get interruptionStats {
+    final pStats = malloc<playback_interruption_stats_t>();
+
+    try {
+      _bindings.playback_device_get_interruption_stats(
+        ensureIsNotFinalized(),
+        pStats,
+      );
+
+      final stats = pStats.ref;
+
+      return PlaybackInterruptionStats(
+        isInterrupted: stats.isInterrupted,
+        interruptionCount: stats.interruptionCount,
+        droppedBytes: stats.droppedBytes,
+        resumeLatency: Duration(microseconds: stats.resumeLatencyNs ~/ 1000),
+      );
+    } finally {
+      malloc.free(pStats);
+    }
+  }
+
+  /// Begins an interruption the platform reported outside of the audio
+  /// backend, e.g. through an audio session observer.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized.
+  void beginInterruption() =>
+      _bindings.playback_device_begin_interruption(ensureIsNotFinalized());
+
+  /// Ends an interruption begun with [beginInterruption].
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized.
+  void endInterruption() =>
+      _bindings.playback_device_end_interruption(ensureIsNotFinalized());
+
+  /// Moves playback to the device [id], or to the default device if
+  /// `null`, keeping everything queued in the buffer.
+  ///
+  /// The new device is opened while the old one keeps playing; playback
+  /// then resumes on it with the frame after the last one played, and
+  /// starts only if the device was started. Call it on
+  /// [PlaybackEventType.rerouted] instead of recreating the device.
+  ///
+  /// Throws:
+  /// - [StateError] if the device is finalized, or if the new device fails
+  ///   to open, does not play the format of this one or fails to start. The
+  ///   current device keeps playing and the call can be retried.
+  PlaybackMigration migrate(DeviceId? id) {
+    final pResult = malloc<playback_migration_t>();
+
+    try {
+      if (!_bindings.playback_device_migrate(
+        ensureIsNotFinalized(),
+        id == null ? nullptr : id.ensureIsNotFinalized(),
+        pResult,
+      )) {
+        throw StateError('Failed to migrate the playback device');
+      }
+
+      _id = id;
+
+      final result = pResult.ref;
+
+      return PlaybackMigration(
+        openDuration: Duration(microseconds: result.openNs ~/ 1000),
+        switchDuration: Duration(microseconds: result.switchNs ~/ 1000),
+        bufferedBytes: result.bufferedBytes,
+      );
+    } finally {
+      malloc.free(pResult);
+    }
+  }
+
   /// Pushes an audio buffer to the playback device.
   ///
   /// - [buffer]: A [TypedData] containing the audio samples. Supported types
@@ -150,6 +902,11 @@ final class PlaybackDevice extends ManagedResource<Void> {
   /// - [framesCount]: The number of frames in the buffer. Each frame contains
   ///   samples for all channels.
   ///
+  /// Returns:
+  /// - The number of bytes accepted. It is less than `framesCount` times
+  ///   the bytes per frame only when the device is frozen with backpressure
+  ///   (see [setInterruptionPolicy]); push the remaining frames later.
+  ///
   /// Throws:
   /// - [StateError] if the device is finalized or not initialized.
   /// - [AssertionError] if the buffer type or frame count is invalid.
@@ -161,7 +918,7 @@ final class PlaybackDevice extends ManagedResource<Void> {
   ///   framesCount: 2,
   /// );
   /// ```
-  void pushBuffer<T extends TypedData>({
+  int pushBuffer<T extends TypedData>({
     required TypedData buffer,
     required int framesCount,
   }) {
@@ -198,11 +955,47 @@ final class PlaybackDevice extends ManagedResource<Void> {
     data.ref.pUserData = pUserData.cast();
     data.ref.sizeInBytes = sizeInBytes;
 
-    _bindings.playback_device_push_buffer(resource, data);
+    final pushedBytes = _bindings.playback_device_push_buffer(resource, data);
 
     // Free allocated memory.
     malloc
       ..free(data)
       ..free(pUserData);
+
+    return pushedBytes;
+  }
+}
+
+/// Delivers the events of a [PlaybackDevice] to a stream.
+///
+/// The native closing event closes the callable, so events posted before
+/// the callback is replaced or the device destroyed are never dropped.
+final class _PlaybackEvents {
+  _PlaybackEvents(this.controller) {
+    callable = NativeCallable<playback_event_callback_tFunction>.listener(
+      (Pointer<Void> _, int type, int state, int availableBytes) {
+        if (type == playback_event_type_t.playback_event_closed.value) {
+          close();
+          return;
+        }
+
+        controller.add(
+          PlaybackEvent(
+            type: PlaybackEventType.fromValue(type),
+            state: DeviceState.fromValue(state),
+            availableBytes: availableBytes,
+          ),
+        );
+      },
+    );
+  }
+
+  final StreamController<PlaybackEvent> controller;
+
+  late final NativeCallable<playback_event_callback_tFunction> callable;
+
+  void close() {
+    callable.close();
+    controller.close();
   }
 }
@@ -0,0 +1,188 @@
+part of 'library.dart';
+
+/// Plays one stream on several playback devices in sync.
+///
+/// Frames pushed with [push] are stored once and read by every output at
+/// its own pace. Each device runs on its own clock, so each output stretches
+/// the stream by a fraction of a percent to keep the same distance behind
+/// the producer; [outputStats] reports how far the outputs drift apart.
+///
+/// Like a [PlaybackDevice], a group belongs to its [AudioContext], which
+/// destroys it if it is still alive when the context is disposed.
+///
+/// ### Example Usage:
+/// ```dart
+/// final group = PlaybackGroup(
+///   context: context,
+///   config: const PlaybackGroupConfig(
+///     format: AudioFormat(
+///       pcmFormat: PcmFormat.f32,
+///       channels: 2,
+///       sampleRate: 48000,
+///     ),
+///   ),
+/// );
+///
+/// group
+///   ..addOutput(speakers.id)
+///   ..addOutput(headphones.id)
+///   ..start();
+///
+/// group.push(frames);
+/// print(group.outputStats(1).offsetFrames);
+/// ```
+final class PlaybackGroup extends ManagedResource<Void> {
+  /// Creates a group without outputs.
+  ///
+  /// Throws:
+  /// - [StateError] if the [AudioContext] is not initialized.
+  /// - [ArgumentError] if the format is not supported.
+  factory PlaybackGroup({
+    required AudioContext context,
+    required PlaybackGroupConfig config,
+  }) {
+    final nativeConfig = config.toNative();
+    final pContext = context.ensureIsNotFinalized();
+
+    final group = _bindings.playback_group_create(
+      pContext,
+      nativeConfig.ensureIsNotFinalized(),
+    );
+
+    if (group == nullptr) {
+      throw ArgumentError.value(config, 'config', 'Unsupported configuration');
+    }
+
+    return PlaybackGroup._(group, context: context, config: config);
+  }
+
+  /// Internal constructor.
+  PlaybackGroup._(
+    super.ptr, {
+    required this.context,
+    required this.config,
+  }) : super._();
+
+  /// The configuration of the group.
+  final PlaybackGroupConfig config;
+
+  /// The [AudioContext] that manages this group.
+  final AudioContext context;
+
+  @protected
+  @override
+  void releaseResource() {
+    _bindings.playback_group_destroy(ensureIsNotFinalized());
+  }
+
+  /// The current state of the group.
+  ///
+  /// Throws:
+  /// - [StateError] if the group is finalized.
+  DeviceState get state {
+    final state = _bindings.playback_group_get_state(ensureIsNotFinalized());
+
+    return DeviceState.values[state.index];
+  }
+
+  /// The number of outputs.
+  ///
+  /// Throws:
+  /// - [StateError] if the group is finalized.
+  int get outputCount =>
+      _bindings.playback_group_get_output_count(ensureIsNotFinalized());
+
+  /// Opens the device [id], or the default device if `null`, and adds it as
+  /// an output. Returns the index of the output.
+  ///
+  /// Throws:
+  /// - [StateError] if the group is started, full, or the device fails to
+  ///   open.
+  int addOutput(DeviceId? id) {
+    final index = _bindings.playback_group_add_output(
+      ensureIsNotFinalized(),
+      id == null ? nullptr : id.ensureIsNotFinalized(),
+    );
+
+    if (index < 0) {
+      throw StateError('Failed to add an output to the group');
+    }
+
+    return index;
+  }
+
+  /// Starts every output. Each one stays silent until it has
+  /// [PlaybackGroupConfig.targetLatencyFrames] queued.
+  ///
+  /// Throws:
+  /// - [StateError] if the group is finalized.
+  void start() => _bindings.playback_group_start(ensureIsNotFinalized());
+
+  /// Stops every output, keeping the queued frames.
+  ///
+  /// Throws:
+  /// - [StateError] if the group is finalized.
+  void stop() => _bindings.playback_group_stop(ensureIsNotFinalized());
+
+  /// Pushes interleaved frames in the format of the group to every output.
+  ///
+  /// Never blocks. Returns the number of frames written, fewer than [buffer]
+  /// holds when the slowest output is that far behind.
+  ///
+  /// Throws:
+  /// - [StateError] if the group is finalized.
+  int push(TypedData buffer) {
+    final resource = ensureIsNotFinalized();
+    final sizeInBytes = buffer.lengthInBytes;
+    final pData = malloc.allocate<Uint8>(sizeInBytes);
+
+    try {
+      pData.asTypedList(sizeInBytes).setAll(
+            0,
+            buffer.buffer.asUint8List(buffer.offsetInBytes, sizeInBytes),
+          );
+
+      final written = _bindings.playback_group_push(
+        resource,
+        pData.cast(),
+        sizeInBytes,
+      );
+
+      return written ~/ config.format.bytesPerFrame;
+    } finally {
+      malloc.free(pData);
+    }
+  }
+
+  /// The state of the output at [index].
+  ///
+  /// Throws:
+  /// - [StateError] if the group is finalized.
+  /// - [RangeError] if there is no output at [index].
+  PlaybackGroupOutputStats outputStats(int index) {
+    final pStats = malloc<playback_group_output_stats_t>();
+
+    try {
+      if (!_bindings.playback_group_get_output_stats(
+        ensureIsNotFinalized(),
+        index,
+        pStats,
+      )) {
+        throw RangeError.index(index, this, 'index', null, outputCount);
+      }
+
+      final stats = pStats.ref;
+
+      return PlaybackGroupOutputStats(
+        framesPlayed: stats.framesPlayed,
+        queuedFrames: stats.queuedFrames,
+        latencyFrames: stats.latencyFrames,
+        underruns: stats.underruns,
+        ratio: stats.ratio,
+        offsetFrames: stats.offsetFrames,
+      );
+    } finally {
+      malloc.free(pStats);
+    }
+  }
+}
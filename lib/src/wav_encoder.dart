@@ -1,5 +1,17 @@
 part of 'library.dart';
 
+/// Receives an encoded chunk from a [WavEncoder.stream] encoder.
+///
+/// - [chunk]: The encoded bytes. The list is backed by native memory that is
+///   released when the list is garbage collected.
+/// - [offset]: The byte offset of the chunk in the encoded file. Chunks arrive
+///   in order, except for the patched header which is delivered by
+///   [WavEncoder.finalize] with an offset pointing back into the file.
+typedef WavEncoderChunkCallback = void Function(Uint8List chunk, int offset);
+
+/// Receives a finalized file from a [WavEncoder.segmented] encoder.
+typedef WavEncoderSegmentCallback = void Function(WavSegment segment);
+
 final class WavEncoder extends NativeResource<Void> {
   factory WavEncoder({
     required String filePath,
@@ -18,15 +30,132 @@ final class WavEncoder extends NativeResource<Void> {
     return wavEncoder;
   }
 
+  /// Creates an encoder that writes the WAV file in large aligned blocks.
+  ///
+  /// Recommended for long recordings: the file is written with a few large
+  /// writes and its extent is preallocated as it grows, see
+  /// [WavEncoderWriterConfig]. Use [writerStats] to inspect the achieved
+  /// throughput.
+  factory WavEncoder.writer({
+    required String filePath,
+    required WavEncoderConfig config,
+    WavEncoderWriterConfig writerConfig = const WavEncoderWriterConfig(),
+  }) {
+    final filePathPtr = stringToCharPointer(filePath);
+    final configPtr = config.toNative().ensureIsNotFinalized();
+    final writerConfigPtr = writerConfig.toNative().ensureIsNotFinalized();
+
+    return WavEncoder._(
+      _bindings.encoder_create_writer(
+        filePathPtr.ensureIsNotFinalized(),
+        configPtr,
+        writerConfigPtr,
+      ),
+      config,
+    );
+  }
+
+  /// Creates an encoder that writes the WAV file into memory.
+  ///
+  /// The file is kept as a list of [chunkSizeInBytes] chunks. Call [finalize]
+  /// once recording is done, then [takeChunks] to get the file without
+  /// copying it.
+  ///
+  /// - [chunkSizeInBytes]: The size of each chunk. `0` selects 64 KiB.
+  factory WavEncoder.memory({
+    required WavEncoderConfig config,
+    int chunkSizeInBytes = 0,
+  }) {
+    final configPtr = config.toNative().ensureIsNotFinalized();
+
+    return WavEncoder._(
+      _bindings.encoder_create_memory(configPtr, chunkSizeInBytes),
+      config,
+    );
+  }
+
+  /// Creates an encoder that streams the WAV file to [onChunk].
+  ///
+  /// Every [chunkSizeInBytes] encoded bytes are delivered to [onChunk]
+  /// asynchronously on the isolate that created the encoder, without copying.
+  /// The last partial chunk and the patched header are delivered by
+  /// [finalize] or [dispose]; [done] completes after the last chunk.
+  ///
+  /// - [chunkSizeInBytes]: The size of each chunk. `0` selects 64 KiB.
+  factory WavEncoder.stream({
+    required WavEncoderConfig config,
+    required WavEncoderChunkCallback onChunk,
+    int chunkSizeInBytes = 0,
+  }) {
+    final stream = _WavEncoderStream(onChunk);
+    final configPtr = config.toNative().ensureIsNotFinalized();
+    final rEncoder = _bindings.encoder_create_callback(
+      configPtr,
+      chunkSizeInBytes,
+      stream.callable.nativeFunction,
+      nullptr,
+    );
+
+    if (rEncoder == nullptr) {
+      stream.callable.close();
+    }
+
+    return WavEncoder._(rEncoder, config, stream);
+  }
+
+  /// Creates an encoder that splits the recording into segment files.
+  ///
+  /// Segment files are named [pathPrefix] followed by the segment index as
+  /// five digits and `.wav`, e.g. `take_00000.wav`. Rotation is
+  /// frame-accurate, so concatenating the segments yields the recording
+  /// without gaps. The next file is opened and the previous one finalized on
+  /// a background thread, so the recording thread never waits for a file
+  /// system operation when the recording rolls over.
+  ///
+  /// Each finalized segment is delivered to [onSegment] on the isolate that
+  /// created the encoder; the last one is delivered by [finalize] or
+  /// [dispose] and completes [done].
+  factory WavEncoder.segmented({
+    required String pathPrefix,
+    required WavEncoderConfig config,
+    required WavEncoderSegmentConfig segmentConfig,
+    WavEncoderSegmentCallback? onSegment,
+  }) {
+    final segments = _WavEncoderSegments(pathPrefix, onSegment);
+    final pathPrefixPtr = stringToCharPointer(pathPrefix);
+    final configPtr = config.toNative().ensureIsNotFinalized();
+    final segmentConfigPtr = segmentConfig.toNative().ensureIsNotFinalized();
+    final rEncoder = _bindings.encoder_create_segmented(
+      pathPrefixPtr.ensureIsNotFinalized(),
+      configPtr,
+      segmentConfigPtr,
+      segments.callable.nativeFunction,
+      nullptr,
+    );
+
+    if (rEncoder == nullptr) {
+      segments.callable.close();
+    }
+
+    return WavEncoder._(rEncoder, config, null, segments);
+  }
+
   /// Internal constructor.
   ///
   /// This is used internally by the factory constructor and should not
   /// be called directly.
-  WavEncoder._(super.ptr, this.config) : super._();
+  WavEncoder._(super.ptr, this.config, [this._stream, this._segments])
+      : super._();
 
   /// Creates a new [WavEncoder] instance with the specified configuration.
   final WavEncoderConfig config;
 
+  /// Receives chunks of a [WavEncoder.stream] encoder.
+  final _WavEncoderStream? _stream;
+
+  /// Receives segments of a [WavEncoder.segmented] encoder.
+  final _WavEncoderSegments? _segments;
+
   @protected
   @override
   NativeFinalizer get finalizer => Library._wavEncoderFinalizer;
@@ -36,4 +165,232 @@ final class WavEncoder extends NativeResource<Void> {
   void releaseResource() => _bindings.encoder_destroy(
         ensureIsNotFinalized(),
       );
+
+  /// Completes once a [WavEncoder.stream] encoder delivered its last chunk or
+  /// a [WavEncoder.segmented] encoder its last segment.
+  ///
+  /// Completes immediately for other encoders.
+  Future<void> get done =>
+      _stream?.done.future ?? _segments?.done.future ?? Future.value();
+
+  /// The number of encoded bytes produced so far.
+  int get sizeInBytes =>
+      _bindings.encoder_get_size_in_bytes(ensureIsNotFinalized());
+
+  /// The I/O statistics of a [WavEncoder.writer] encoder.
+  ///
+  /// Throws:
+  /// - [StateError] if the encoder was not created with [WavEncoder.writer].
+  WavEncoderWriterStats get writerStats {
+    final pStats = malloc<encoder_writer_stats_t>();
+
+    try {
+      if (!_bindings.encoder_get_writer_stats(ensureIsNotFinalized(), pStats)) {
+        throw StateError('The encoder has no block writer');
+      }
+
+      final stats = pStats.ref;
+
+      return WavEncoderWriterStats(
+        bytesWritten: stats.bytesWritten,
+        writeCalls: stats.writeCalls,
+        readCalls: stats.readCalls,
+        preallocateCalls: stats.preallocateCalls,
+        syncCalls: stats.syncCalls,
+        ioSeconds: stats.ioSeconds,
+        megabytesPerSecond: stats.megabytesPerSecond,
+        isDirectIo: stats.isDirectIo,
+      );
+    } finally {
+      malloc.free(pStats);
+    }
+  }
+
+  /// The silent stretches left out of the recording, in file order.
+  ///
+  /// A [PlaybackDevice] records silence as gaps when its silence detector
+  /// is enabled with [PlaybackSilenceConfig.compactRecording]. They can be
+  /// read while recording, and [finalize] saves them in the WAV file as
+  /// `cue ` points with `ltxt` regions of the gap length.
+  List<WavGap> get gaps {
+    final resource = ensureIsNotFinalized();
+    final count = _bindings.encoder_get_gaps(resource, nullptr, 0);
+
+    if (count == 0) {
+      return const [];
+    }
+
+    final pGaps = malloc<encoder_gap_t>(count);
+
+    try {
+      // More gaps may have been recorded since they were counted.
+      final total = _bindings.encoder_get_gaps(resource, pGaps, count);
+
+      return List.generate(
+        total < count ? total : count,
+        (i) => WavGap(
+          position: pGaps[i].position,
+          frameCount: pGaps[i].frameCount,
+        ),
+      );
+    } finally {
+      malloc.free(pGaps);
+    }
+  }
+
+  /// Feeds every written frame into [overview].
+  ///
+  /// [finalize] finishes the overview and, when [sidecarPath] is set, saves
+  /// it there, so the waveform of the recording can be drawn later with
+  /// [AudioOverview.load] without reading the WAV file. Must be called
+  /// before frames are written. The encoder keeps a reference to the
+  /// overview, so it is not finalized while recording.
+  ///
+  /// Throws:
+  /// - [StateError] if the encoder or the overview is finalized.
+  /// - [ArgumentError] if the overview format does not match the encoder.
+  void attachOverview(AudioOverview overview, {String? sidecarPath}) {
+    final sidecarPathPtr =
+        sidecarPath != null ? stringToCharPointer(sidecarPath) : null;
+
+    final attached = _bindings.encoder_set_overview(
+      ensureIsNotFinalized(),
+      overview.ensureIsNotFinalized(),
+      sidecarPathPtr?.ensureIsNotFinalized() ?? nullptr,
+    );
+
+    if (!attached) {
+      throw ArgumentError.value(
+        overview,
+        'overview',
+        'Format does not match the encoder',
+      );
+    }
+
+    _overview = overview;
+  }
+
+  /// The overview attached with [attachOverview], if any.
+  AudioOverview? get overview => _overview;
+  AudioOverview? _overview;
+
+  /// Completes the WAV file.
+  ///
+  /// Patches the header with the final sizes and flushes pending data. The
+  /// encoder must no longer be in use by a [PlaybackDevice].
+  void finalize() {
+    _bindings.encoder_finalize(ensureIsNotFinalized());
+    _isComplete = true;
+  }
+
+  bool _isComplete = false;
+
+  /// Hands over the chunks of a finalized [WavEncoder.memory] encoder.
+  ///
+  /// Concatenating the returned lists yields the WAV file. The lists are
+  /// backed by native memory without copies and stay valid after the encoder
+  /// is disposed. The encoder is empty afterwards.
+  ///
+  /// Throws:
+  /// - [StateError] if the encoder is not a finalized memory encoder.
+  List<Uint8List> takeChunks() {
+    final resource = ensureIsNotFinalized();
+
+    if (!_isComplete || _stream != null) {
+      throw StateError('Chunks are only available from a finalized memory '
+          'encoder');
+    }
+
+    final pSize = malloc<Size>();
+    final chunks = <Uint8List>[];
+
+    try {
+      while (true) {
+        final pChunk = _bindings.encoder_take_chunk(resource, pSize);
+
+        if (pChunk == nullptr) {
+          break;
+        }
+
+        chunks.add(
+          pChunk.cast<Uint8>().asTypedList(
+                pSize.value,
+                finalizer: _bindings.addresses.encoder_free_chunk.cast(),
+              ),
+        );
+      }
+    } finally {
+      malloc.free(pSize);
+    }
+
+    return chunks;
+  }
+}
+
+/// Delivers the chunks of a [WavEncoder.stream] encoder to Dart.
+///
+/// The native end-of-stream marker closes the callable, so chunks posted
+/// before the encoder is destroyed are never dropped.
+final class _WavEncoderStream {
+  _WavEncoderStream(WavEncoderChunkCallback onChunk) {
+    callable = NativeCallable<encoder_chunk_callback_tFunction>.listener(
+      (Pointer<Void> _, Pointer<Void> pData, int sizeInBytes, int offset) {
+        if (pData == nullptr) {
+          callable.close();
+          done.complete();
+          return;
+        }
+
+        final chunk = pData.cast<Uint8>().asTypedList(
+              sizeInBytes,
+              finalizer: _bindings.addresses.encoder_free_chunk.cast(),
+            );
+
+        onChunk(chunk, offset);
+      },
+    );
+  }
+
+  late final NativeCallable<encoder_chunk_callback_tFunction> callable;
+
+  final done = Completer<void>();
+}
+
+/// Delivers the segments of a [WavEncoder.segmented] encoder to Dart.
+///
+/// The last segment closes the callable, so segments completed before the
+/// encoder is destroyed are never dropped.
+final class _WavEncoderSegments {
+  _WavEncoderSegments(String pathPrefix, WavEncoderSegmentCallback? onSegment) {
+    callable = NativeCallable<encoder_segment_callback_tFunction>.listener(
+      (
+        Pointer<Void> _,
+        int index,
+        int firstFrame,
+        int frameCount,
+        int sizeInBytes,
+        bool isLast,
+      ) {
+        onSegment?.call(
+          WavSegment(
+            index: index,
+            filePath: '$pathPrefix${index.toString().padLeft(5, '0')}.wav',
+            firstFrame: firstFrame,
+            frameCount: frameCount,
+            sizeInBytes: sizeInBytes,
+            isLast: isLast,
+          ),
+        );
+
+        if (isLast) {
+          callable.close();
+          done.complete();
+        }
+      },
+    );
+  }
+
+  late final NativeCallable<encoder_segment_callback_tFunction> callable;
+
+  final done = Completer<void>();
 }
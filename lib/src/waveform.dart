@@ -24,7 +24,8 @@ part of 'library.dart';
 ///
 /// waveform.dispose();
 /// ```
-final class Waveform extends NativeResource<Void> {
+final class Waveform extends NativeResource<Void>
+    implements DataSource {
   /// Creates a new waveform instance based on the provided configuration.
   ///
   /// - [config]: A configuration object (e.g., [WaveformSineConfig]) that
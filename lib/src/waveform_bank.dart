@@ -0,0 +1,187 @@
+part of 'library.dart';
+
+/// A bank of oscillators rendered together in native code.
+///
+/// `WaveformBank` is the multi-oscillator variant of [Waveform]. All
+/// oscillators are rendered in one call with vectorized kernels, either into
+/// their own channels or summed into one signal, which is much cheaper than
+/// running one [Waveform] per channel.
+///
+/// ### Example Usage:
+/// ```dart
+/// final bank = WaveformBank(
+///   config: WaveformBankConfig(
+///     sampleFormat: PcmFormat.f32,
+///     sampleRate: 48000,
+///     mix: WaveformBankMix.interleaved,
+///     oscillators: const [
+///       WaveformBankOscillator(
+///         type: WaveformType.sine,
+///         amplitude: 0.5,
+///         frequency: 440.0,
+///       ),
+///       WaveformBankOscillator(
+///         type: WaveformType.square,
+///         amplitude: 0.25,
+///         frequency: 220.0,
+///       ),
+///     ],
+///   ),
+/// );
+///
+/// final pcmFrames = bank.readWaveformPcmFrames(frameCount: 1024);
+/// print('Read ${pcmFrames.framesRead} frames');
+///
+/// bank.dispose();
+/// ```
+final class WaveformBank extends NativeResource<Void>
+    implements DataSource {
+  /// Creates a new waveform bank based on the provided configuration.
+  ///
+  /// Throws:
+  /// - [ArgumentError] if the configuration has no oscillators.
+  /// - [Exception] if the waveform bank creation fails.
+  factory WaveformBank({required WaveformBankConfig config}) {
+    if (config.oscillators.isEmpty) {
+      throw ArgumentError.value(
+        config.oscillators,
+        'config.oscillators',
+        'must not be empty',
+      );
+    }
+
+    final nativeConfig = malloc<waveform_bank_config_t>();
+    final nativeOscillators =
+        malloc<waveform_bank_oscillator_t>(config.oscillators.length);
+
+    try {
+      nativeConfig.ref
+        ..pcmFormatAsInt = config.sampleFormat.index
+        ..channels = config.channels
+        ..sampleRate = config.sampleRate
+        ..mixAsInt = config.mix.value;
+
+      for (var i = 0; i < config.oscillators.length; i++) {
+        _fillOscillator(nativeOscillators + i, config.oscillators[i]);
+      }
+
+      final rBank = _bindings.waveform_bank_create(
+        nativeConfig,
+        nativeOscillators,
+        config.oscillators.length,
+      );
+
+      if (rBank == nullptr) {
+        throw Exception('Failed to create waveform bank');
+      }
+
+      return WaveformBank._(rBank, config);
+    } finally {
+      malloc
+        ..free(nativeConfig)
+        ..free(nativeOscillators);
+    }
+  }
+
+  /// Internal constructor.
+  ///
+  /// This is used internally by the factory constructor and should not
+  /// be called directly.
+  WaveformBank._(super.ptr, this.config) : super._();
+
+  /// The configuration used to create the bank.
+  final WaveformBankConfig config;
+
+  @protected
+  @override
+  NativeFinalizer get finalizer => Library._waveformBankFinalizer;
+
+  @protected
+  @override
+  void releaseResource() => _bindings.waveform_bank_destroy(
+        ensureIsNotFinalized(),
+      );
+
+  static void _fillOscillator(
+    Pointer<waveform_bank_oscillator_t> pOscillator,
+    WaveformBankOscillator oscillator,
+  ) {
+    pOscillator.ref
+      ..typeAsInt = oscillator.type.value
+      ..amplitude = oscillator.amplitude
+      ..frequency = oscillator.frequency;
+  }
+
+  /// Replaces the parameters of the oscillator at [index].
+  ///
+  /// The phase of the oscillator is preserved, so frequency changes are
+  /// continuous.
+  ///
+  /// Throws:
+  /// - [StateError] if the bank is finalized.
+  void setOscillator(int index, WaveformBankOscillator oscillator) {
+    final resource = ensureIsNotFinalized();
+    final pOscillator = malloc<waveform_bank_oscillator_t>();
+
+    try {
+      _fillOscillator(pOscillator, oscillator);
+      _bindings.waveform_bank_set_oscillator(resource, index, pOscillator);
+    } finally {
+      malloc.free(pOscillator);
+    }
+  }
+
+  /// Reads PCM frames from the waveform bank.
+  ///
+  /// - [frameCount]: The number of frames to render.
+  ///
+  /// Returns:
+  /// - A record containing:
+  ///   - `frames`: The PCM audio data as a [TypedData].
+  ///   - `framesRead`: The number of frames successfully read.
+  ///
+  /// Throws:
+  /// - [StateError] if the bank is finalized or uninitialized.
+  /// - [Exception] if the sample format is unsupported.
+  ({TypedData frames, int framesRead}) readWaveformPcmFrames({
+    required int frameCount,
+  }) {
+    final resource = ensureIsNotFinalized();
+
+    final pFramesOut = malloc.allocate(frameCount * config.bpf);
+    final pFramesRead = malloc<Uint64>();
+
+    try {
+      _bindings.waveform_bank_read_pcm_frames_with_buffer(
+        resource,
+        pFramesOut.cast(),
+        frameCount,
+        pFramesRead,
+      );
+
+      final framesRead = pFramesRead.value;
+      final size = framesRead * config.outputChannels;
+
+      final frames = switch (config.sampleFormat) {
+        PcmFormat.f32 => pFramesOut
+            .cast<Float>()
+            .asTypedList(size, finalizer: malloc.nativeFree),
+        PcmFormat.s16 => pFramesOut
+            .cast<Int16>()
+            .asTypedList(size, finalizer: malloc.nativeFree),
+        PcmFormat.s32 || PcmFormat.s24 => pFramesOut
+            .cast<Int32>()
+            .asTypedList(size, finalizer: malloc.nativeFree),
+        PcmFormat.u8 => pFramesOut
+            .cast<Uint8>()
+            .asTypedList(size, finalizer: malloc.nativeFree),
+        _ =>
+          throw Exception('Unsupported sample format: ${config.sampleFormat}'),
+      };
+
+      return (frames: frames, framesRead: framesRead);
+    } finally {
+      malloc.free(pFramesRead);
+    }
+  }
+}
@@ -69,6 +69,90 @@ typedef struct {
     uint32_t count;       /**< Number of supported audio formats. */
 } device_info_ext_t;
 
+/**
+ * @brief Maximum number of backends in an `audio_context_config_t`.
+ */
+#define AUDIO_CONTEXT_MAX_BACKENDS 16
+
+/**
+ * @enum audio_backend_t
+ * @brief Audio backends, with the values of `ma_backend`.
+ */
+typedef enum {
+    audio_backend_wasapi = 0,      /**< Windows Audio Session API. */
+    audio_backend_dsound = 1,      /**< DirectSound. */
+    audio_backend_winmm = 2,       /**< Windows Multimedia. */
+    audio_backend_coreaudio = 3,   /**< Core Audio, macOS and iOS. */
+    audio_backend_sndio = 4,       /**< sndio, OpenBSD. */
+    audio_backend_audio4 = 5,      /**< audio(4), NetBSD. */
+    audio_backend_oss = 6,         /**< Open Sound System. */
+    audio_backend_pulseaudio = 7,  /**< PulseAudio. */
+    audio_backend_alsa = 8,        /**< Advanced Linux Sound Architecture. */
+    audio_backend_jack = 9,        /**< JACK Audio Connection Kit. */
+    audio_backend_aaudio = 10,     /**< AAudio, Android. */
+    audio_backend_opensl = 11,     /**< OpenSL ES, Android. */
+    audio_backend_webaudio = 12,   /**< Web Audio. */
+    audio_backend_custom = 13,     /**< Custom backend. */
+    audio_backend_null = 14,       /**< Silent backend that plays in real time. */
+    audio_backend_unknown = 0xFF   /**< No backend. */
+} audio_backend_t;
+
+/**
+ * @struct audio_context_config_t
+ * @brief Controls how an audio context starts.
+ */
+typedef struct {
+    audio_backend_t backends[AUDIO_CONTEXT_MAX_BACKENDS]; /**< Backends to try, in order. */
+    uint32_t backendCount;                                /**< Number of `backends`. 0 tries every enabled backend. */
+    bool preferLastBackend;                               /**< Try the backend the last context of the process used first. */
+    bool isLazy;                                          /**< Enumerate devices on first use instead of at creation. */
+} audio_context_config_t;
+
+/**
+ * @struct audio_context_timings_t
+ * @brief Time spent by each phase of starting an audio context.
+ */
+typedef struct {
+    audio_backend_t backend; /**< Backend the context uses. */
+    uint64_t logNs;          /**< Setting up the log. */
+    uint64_t initNs;         /**< Probing the backends and initializing the one used. */
+    uint64_t enumerateNs;    /**< Last device enumeration, 0 until the devices are enumerated. */
+    bool isEnumerated;       /**< The devices were enumerated. */
+    uint32_t enumerations;   /**< Backend enumerations run, coalesced requests counting once. */
+} audio_context_timings_t;
+
+/**
+ * @brief Receives the outcome of `audio_context_refresh_devices_async`.
+ *
+ * Called on the worker thread of the context.
+ *
+ * @param pUserData The user data passed with the request.
+ * @param isSuccess Whether the backend enumerated the devices.
+ */
+typedef void (*audio_context_refresh_callback_t)(void *pUserData, bool isSuccess);
+
+/**
+ * @brief Receives the outcome of `audio_context_get_device_infos_async`.
+ *
+ * Called on the worker thread of the context. The receiver owns the list
+ * and releases it with `audio_context_device_infos_destroy`.
+ *
+ * @param pUserData The user data passed with the request.
+ * @param pDeviceInfos The devices, or NULL if there are none or an error occurred.
+ */
+typedef void (*audio_context_device_infos_callback_t)(void *pUserData, device_infos_t *pDeviceInfos);
+
+/**
+ * @brief Receives the outcome of `audio_context_get_device_info_ext_async`.
+ *
+ * Called on the worker thread of the context. The receiver owns the
+ * information and releases it with `audio_context_device_info_ext_destroy`.
+ *
+ * @param pUserData The user data passed with the request.
+ * @param pDeviceInfoExt The formats of the device, or NULL if an error occurred.
+ */
+typedef void (*audio_context_device_info_ext_callback_t)(void *pUserData, device_info_ext_t *pDeviceInfoExt);
+
 /**
  * @brief Creates a new audio context.
  *
@@ -79,6 +163,36 @@ typedef struct {
 FFI_PLUGIN_EXPORT
 void *audio_context_create(void);
 
+/**
+ * @brief Creates a new audio context with a backend priority list.
+ *
+ * `audio_context_create` probes every compiled backend in the default
+ * order, which can be slow where the first ones are unavailable. Listing
+ * the backends to try, or trying first the one that worked last, skips
+ * those probes. The backend used is remembered for the rest of the process
+ * and reported by `audio_context_get_timings`, so it can also be persisted
+ * and listed first on the next launch.
+ *
+ * Unless `isLazy` is set, the devices are enumerated before returning. A
+ * lazy context enumerates them on the first `audio_context_get_device_infos`
+ * or `audio_context_refresh_devices`.
+ *
+ * @param pConfig Pointer to the configuration, or NULL for the defaults of `audio_context_create`.
+ * @return A pointer to the audio context, or NULL if no backend could be initialized.
+ */
+FFI_PLUGIN_EXPORT
+void *audio_context_create_ex(const audio_context_config_t *pConfig);
+
+/**
+ * @brief Retrieves the time spent by each phase of starting an audio context.
+ *
+ * @param self Pointer to the `audio_context_t` structure.
+ * @param pTimings Pointer to the structure that receives the timings.
+ * @return `true` on success, `false` if a parameter is invalid.
+ */
+FFI_PLUGIN_EXPORT
+bool audio_context_get_timings(const void *self, audio_context_timings_t *pTimings);
+
 /**
  * @brief Destroys an audio context.
  *
@@ -149,4 +263,55 @@ device_info_ext_t *audio_context_get_device_info_ext(const void *self,
 FFI_PLUGIN_EXPORT
 void audio_context_device_info_ext_destroy(device_info_ext_t *pDeviceInfoExt);
 
+/**
+ * @brief Refreshes the list of available audio devices on the worker thread of the context.
+ *
+ * Returns at once. Requests queued while the worker is busy are served by
+ * a single enumeration, so refreshing from several places costs one
+ * backend call. Requests still queued when the context is destroyed are
+ * served before it is.
+ *
+ * @param self Pointer to the `audio_context_t` structure.
+ * @param onComplete Receives the outcome.
+ * @param pUserData User data for `onComplete`.
+ * @return `true` if the request was queued, `false` otherwise; `onComplete` is then never called.
+ */
+FFI_PLUGIN_EXPORT
+bool audio_context_refresh_devices_async(const void *self,
+                                         audio_context_refresh_callback_t onComplete,
+                                         void *pUserData);
+
+/**
+ * @brief Retrieves the list of audio devices of a type on the worker thread of the context.
+ *
+ * Enumerates first if the context has not yet, sharing the enumeration
+ * with the other requests of the batch.
+ *
+ * @param self Pointer to the `audio_context_t` structure.
+ * @param type The type of audio devices to retrieve.
+ * @param onComplete Receives the list.
+ * @param pUserData User data for `onComplete`.
+ * @return `true` if the request was queued, `false` otherwise; `onComplete` is then never called.
+ */
+FFI_PLUGIN_EXPORT
+bool audio_context_get_device_infos_async(const void *self,
+                                          audio_device_type_t type,
+                                          audio_context_device_infos_callback_t onComplete,
+                                          void *pUserData);
+
+/**
+ * @brief Retrieves extended information about an audio device on the worker thread of the context.
+ *
+ * @param self Pointer to the `audio_context_t` structure.
+ * @param deviceId Pointer to the unique identifier of the device, copied before returning.
+ * @param onComplete Receives the information.
+ * @param pUserData User data for `onComplete`.
+ * @return `true` if the request was queued, `false` otherwise; `onComplete` is then never called.
+ */
+FFI_PLUGIN_EXPORT
+bool audio_context_get_device_info_ext_async(const void *self,
+                                             void *deviceId,
+                                             audio_context_device_info_ext_callback_t onComplete,
+                                             void *pUserData);
+
 #endif  // AUDIO_CONTEXT_H
@@ -1,8 +1,12 @@
 #ifndef AUDIO_CONTEXT_PRIVATE_H
 #define AUDIO_CONTEXT_PRIVATE_H
 
+#include <stdatomic.h>
+
+#include "context_worker.h"
 #include "miniaudio.h"
 #include "playback_device_private.h"
+#include "playback_pool_private.h"
 
 /**
  * @struct audio_context_t
@@ -16,6 +20,18 @@ typedef struct {
     ma_context maContext;          /**< Miniaudio context for initializing the audio system. Make this the first member so we can cast between ma_context and audio_context_t*/
     audio_device_t **audioDevices; /**< Dynamic array of pointers to all audio devices. */
     size_t deviceCount;            /**< Number of devices currently managed by the context. */
+    ma_log log;                    /**< Routes the messages of miniaudio to the logger. */
+    bool hasLog;                   /**< `log` was initialized. */
+
+    uint64_t logNs;                /**< Time spent setting up `log`. */
+    uint64_t initNs;               /**< Time spent in `ma_context_init`. */
+    _Atomic(uint64_t) enumerateNs; /**< Time spent by the last enumeration. */
+    atomic_bool isEnumerated;      /**< The devices were enumerated at least once. */
+    atomic_uint enumerations;      /**< Enumerations run. */
+
+    pthread_mutex_t devicesLock; /**< Serializes enumerations with copies of the device lists. */
+    context_worker_t worker;     /**< Serves the asynchronous requests. */
+    playback_pool_t pool;        /**< Warm playback devices. */
 } audio_context_t;
 
 /**
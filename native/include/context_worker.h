@@ -0,0 +1,96 @@
+#ifndef CONTEXT_WORKER_H
+#define CONTEXT_WORKER_H
+
+#include <stdbool.h>
+
+#include "audio_context.h"
+#include "miniaudio.h"
+#include "platform.h"
+#include "playback_device.h"
+
+/**
+ * @enum context_request_kind_t
+ * @brief What a request asks the worker of an audio context for.
+ */
+typedef enum {
+    context_request_refresh = 0,         /**< Enumerate the devices. */
+    context_request_device_infos = 1,    /**< Copy the devices of a type, enumerating first if needed. */
+    context_request_device_info_ext = 2, /**< Query the formats of one device. */
+    context_request_device_start = 3,    /**< Start a playback device. */
+    context_request_device_stop = 4      /**< Stop a playback device. */
+} context_request_kind_t;
+
+/**
+ * @struct context_request_t
+ * @brief A queued request, linked in the order it was posted.
+ */
+typedef struct context_request_t {
+    context_request_kind_t kind; /**< What is asked for. */
+    audio_device_type_t type;    /**< Device type, for `context_request_device_infos`. */
+    ma_device_id deviceId;       /**< Device, for `context_request_device_info_ext`. */
+    void *pDevice;               /**< Playback device, for `context_request_device_start` and `context_request_device_stop`. */
+    union {
+        audio_context_refresh_callback_t onRefresh;               /**< For `context_request_refresh`. */
+        audio_context_device_infos_callback_t onDeviceInfos;      /**< For `context_request_device_infos`. */
+        audio_context_device_info_ext_callback_t onDeviceInfoExt; /**< For `context_request_device_info_ext`. */
+        playback_transition_callback_t onTransition;              /**< For `context_request_device_start` and `context_request_device_stop`, may be NULL. */
+    } onComplete;                /**< Completion callback matching `kind`. */
+    void *pUserData;             /**< User data for `onComplete`. */
+
+    struct context_request_t *pNext; /**< Next request of the batch. */
+} context_request_t;
+
+/**
+ * @brief Handles a batch of requests, then frees them.
+ */
+typedef void (*context_worker_batch_callback_t)(void *pUserData, context_request_t *pBatch);
+
+/**
+ * @struct context_worker_t
+ * @brief Runs the blocking requests of an audio context off the caller's thread.
+ *
+ * Requests are queued under `mutex`. The worker takes everything queued at
+ * once and hands it to `onBatch` as one batch, so requests that arrive while
+ * the worker is busy are served together by the next backend call. The
+ * thread starts with the first request.
+ */
+typedef struct {
+    context_worker_batch_callback_t onBatch; /**< Handles each batch. */
+    void *pUserData;                         /**< User data for `onBatch`. */
+
+    pthread_t thread;         /**< Worker thread. */
+    pthread_mutex_t mutex;    /**< Protects every field below. */
+    pthread_cond_t cond;      /**< Signalled when a request is queued or on stop. */
+    pthread_cond_t idleCond;  /**< Signalled when a batch is served. */
+    context_request_t *pHead; /**< Oldest queued request. */
+    context_request_t *pTail; /**< Newest queued request. */
+    bool isRunning;           /**< The thread was started. */
+    bool isBusy;              /**< The thread is serving a batch. */
+    bool stop;                /**< Asks the thread to exit once the queue is empty. */
+} context_worker_t;
+
+/**
+ * @brief Initializes an idle worker that hands batches to `onBatch`.
+ */
+void context_worker_init(context_worker_t *self, context_worker_batch_callback_t onBatch, void *pUserData);
+
+/**
+ * @brief Queues a request, starting the thread if needed. Takes ownership of `pRequest`.
+ *
+ * @return `true` if the request was queued, `false` if the thread could not be started or the worker is stopping.
+ */
+bool context_worker_post(context_worker_t *self, context_request_t *pRequest);
+
+/**
+ * @brief Waits until every request queued so far was served.
+ *
+ * Returns at once on the worker thread, where waiting would never end.
+ */
+void context_worker_flush(context_worker_t *self);
+
+/**
+ * @brief Serves the queued requests, stops the thread and releases the worker.
+ */
+void context_worker_uninit(context_worker_t *self);
+
+#endif  // CONTEXT_WORKER_H
@@ -0,0 +1,124 @@
+#ifndef DECODER_H
+#define DECODER_H
+
+#include "audio_context.h"
+#include "platform.h"
+
+/**
+ * @struct decoder_config_t
+ * @brief Output configuration of a streaming decoder.
+ *
+ * The file is converted to this format while it is decoded, so the decoder can
+ * be attached directly to a playback device using the same format.
+ */
+typedef struct {
+    pcm_format_t pcmFormat;   /**< PCM format of the output (e.g., `pcm_format_f32`). */
+    uint32_t channels;        /**< Number of output channels (e.g., 2 for stereo). */
+    uint32_t sampleRate;      /**< Output sample rate in Hertz (e.g., 44100 Hz). */
+    uint32_t lookaheadFrames; /**< Frames decoded ahead of the reader. 0 selects half a second. */
+} decoder_config_t;
+
+/**
+ * @brief Opens an audio file for streaming playback.
+ *
+ * Supports WAV, FLAC and MP3. A background thread decodes the file ahead of
+ * the reader into a ring buffer holding `lookaheadFrames` frames, so memory
+ * use is constant regardless of the file length and reads never touch the
+ * file. The returned object is a miniaudio data source and can be attached to
+ * a playback device with `playback_device_attach_source`.
+ *
+ * @param path The path to the audio file.
+ * @param pConfig Pointer to the output configuration.
+ * @return A pointer to the decoder, or NULL if the file cannot be opened.
+ */
+FFI_PLUGIN_EXPORT
+void *decoder_create(const char *path, decoder_config_t *pConfig);
+
+/**
+ * @brief Stops the read-ahead thread, closes the file and releases the decoder.
+ *
+ * @param self Pointer to the decoder to destroy.
+ */
+FFI_PLUGIN_EXPORT
+void decoder_destroy(void *self);
+
+/**
+ * @brief Requests a seek to the given output frame.
+ *
+ * The call does not block. Frames buffered before the seek are discarded by
+ * the reader and the read-ahead thread refills the ring from the new position.
+ * Until the first frames at the new position are available, reads return
+ * silence instead of stale audio.
+ *
+ * @param self Pointer to the decoder.
+ * @param frameIndex The frame to seek to, in output frames.
+ */
+FFI_PLUGIN_EXPORT
+void decoder_seek(void *self, uint64_t frameIndex);
+
+/**
+ * @brief Enables or disables looping at the end of the file.
+ *
+ * @param self Pointer to the decoder.
+ * @param isLooping Whether the decoder restarts from the beginning at the end.
+ */
+FFI_PLUGIN_EXPORT
+void decoder_set_looping(void *self, bool isLooping);
+
+/**
+ * @brief Returns the position of the reader, in output frames.
+ *
+ * @param self Pointer to the decoder.
+ * @return The index of the next frame that will be read, or 0 if `self` is NULL.
+ */
+FFI_PLUGIN_EXPORT
+uint64_t decoder_get_cursor(void *self);
+
+/**
+ * @brief Returns the length of the file, in output frames.
+ *
+ * @param self Pointer to the decoder.
+ * @return The number of frames, or 0 if it is unknown or `self` is NULL.
+ */
+FFI_PLUGIN_EXPORT
+uint64_t decoder_get_length(void *self);
+
+/**
+ * @brief Returns the number of frames currently decoded ahead of the reader.
+ *
+ * @param self Pointer to the decoder.
+ * @return The number of buffered frames, or 0 if `self` is NULL.
+ */
+FFI_PLUGIN_EXPORT
+uint32_t decoder_get_buffered_frames(void *self);
+
+/**
+ * @brief Returns whether every frame of the file has been read.
+ *
+ * Always `false` while looping.
+ *
+ * @param self Pointer to the decoder.
+ * @return `true` if the end was reached and the lookahead ring is drained.
+ */
+FFI_PLUGIN_EXPORT
+bool decoder_is_at_end(void *self);
+
+/**
+ * @brief Reads decoded PCM frames.
+ *
+ * Copies at most the frames already decoded ahead; it never waits for the
+ * read-ahead thread. Must not be called while the decoder is attached to a
+ * playback device.
+ *
+ * @param self Pointer to the decoder.
+ * @param pFramesOut Pointer to the output buffer where PCM frames will be written.
+ * @param framesCount The maximum number of frames to read.
+ * @param pFramesRead Pointer to a variable that will store the actual number of frames read.
+ */
+FFI_PLUGIN_EXPORT
+void decoder_read_pcm_frames_with_buffer(void *self,
+                                         void *pFramesOut,
+                                         uint64_t framesCount,
+                                         uint64_t *pFramesRead);
+
+#endif  // DECODER_H
@@ -0,0 +1,98 @@
+#ifndef DSP_CHAIN_H
+#define DSP_CHAIN_H
+
+#include "miniaudio.h"
+#include "playback_device.h"
+
+/**
+ * @brief Frames processed at a time when the device format is not f32.
+ */
+#define DSP_CHAIN_SLICE_FRAMES 512
+
+/**
+ * @brief Parameter updates the queue of a chain holds.
+ */
+#define DSP_CHAIN_QUEUE_UPDATES 64
+
+/**
+ * @struct dsp_stage_t
+ * @brief A stage of a DSP chain and its miniaudio processor.
+ */
+typedef struct {
+    playback_dsp_stage_t config; /**< Parameters of the stage, as last applied. */
+
+    union {
+        ma_biquad biquad;
+        ma_lpf lpf;
+        ma_hpf hpf;
+        ma_bpf bpf;
+        ma_notch2 notch;
+        ma_peak2 peak;
+        ma_loshelf2 loshelf;
+        ma_hishelf2 hishelf;
+        ma_delay delay;
+        ma_gainer gainer;
+    } node; /**< Processor selected by `config.type`. */
+} dsp_stage_t;
+
+/**
+ * @struct dsp_update_t
+ * @brief A parameter update on its way to the audio thread.
+ */
+typedef struct {
+    uint32_t stageIndex;        /**< Stage to update. */
+    playback_dsp_stage_t stage; /**< New parameters. */
+} dsp_update_t;
+
+/**
+ * @struct dsp_chain_t
+ * @brief Processors applied in place to the output of a playback device.
+ *
+ * Every processor works in f32 and, except the delay, lives in `pHeap`, a
+ * single block allocated when the chain is created. The audio thread owns
+ * the stages; other threads post parameter updates into `updates`, a
+ * single-producer, single-consumer ring buffer that the audio thread drains
+ * before processing. Producers are serialized by the owner of the chain.
+ */
+typedef struct {
+    ma_format format;    /**< Format of the processed frames. */
+    uint32_t channels;   /**< Number of channels. */
+    uint32_t sampleRate; /**< Sample rate in Hertz. */
+
+    dsp_stage_t stages[PLAYBACK_DSP_MAX_STAGES]; /**< Stages in processing order. */
+    uint32_t stageCount;                         /**< Number of stages. */
+    void *pHeap;                                 /**< Heaps of the filters and gainers. */
+    float *pScratch;                             /**< `DSP_CHAIN_SLICE_FRAMES` frames in f32, NULL for f32 devices. */
+
+    ma_rb updates; /**< Pending `dsp_update_t`. */
+} dsp_chain_t;
+
+/**
+ * @brief Validates the stages and builds a chain.
+ *
+ * @return The chain, or NULL if a stage is invalid or memory ran out.
+ */
+dsp_chain_t *dsp_chain_create(ma_format format,
+                              uint32_t channels,
+                              uint32_t sampleRate,
+                              const playback_dsp_stage_t *pStages,
+                              uint32_t stageCount);
+
+/**
+ * @brief Validates an update and queues it for the audio thread.
+ *
+ * @return `true` if the update was queued.
+ */
+bool dsp_chain_post_update(dsp_chain_t *self, uint32_t stageIndex, const playback_dsp_stage_t *pStage);
+
+/**
+ * @brief Applies pending updates, then processes interleaved frames in place.
+ */
+void dsp_chain_process(dsp_chain_t *self, void *pFrames, uint32_t frameCount);
+
+/**
+ * @brief Releases the chain.
+ */
+void dsp_chain_destroy(dsp_chain_t *self);
+
+#endif  // DSP_CHAIN_H
@@ -4,17 +4,138 @@
 #include "audio_context.h"
 #include "platform.h"
 
+/**
+ * @enum encoder_storage_t
+ * @brief How samples are stored in the encoded file.
+ */
+typedef enum {
+    encoder_storage_pcm,       /**< PCM in `pcmFormat`, as the frames are written. */
+    encoder_storage_pcm_s16,   /**< 16-bit PCM, converted from `pcmFormat` while encoding. */
+    encoder_storage_ima_adpcm, /**< 4-bit IMA ADPCM, about a quarter of 16-bit PCM. Mono or stereo only. */
+} encoder_storage_t;
+
 typedef struct {
-    uint32_t channels;      /**< Number of audio channels (e.g., 2 for stereo). */
-    uint32_t sampleRate;    /**< Sample rate in Hertz (e.g., 44100 Hz). */
-    pcm_format_t pcmFormat; /**< PCM format of the audio data (e.g., `pcm_format_s16`). */
+    uint32_t channels;         /**< Number of audio channels (e.g., 2 for stereo). */
+    uint32_t sampleRate;       /**< Sample rate in Hertz (e.g., 44100 Hz). */
+    pcm_format_t pcmFormat;    /**< PCM format of the audio data (e.g., `pcm_format_s16`). */
+    encoder_storage_t storage; /**< Format of the samples in the file. */
 } encoder_config_t;
 
+/**
+ * @enum encoder_fsync_policy_t
+ * @brief When a writer encoder forces written blocks to stable storage.
+ */
+typedef enum {
+    encoder_fsync_never,    /**< Leave flushing to the operating system. */
+    encoder_fsync_on_close, /**< Sync once when the encoder is finalized. */
+    encoder_fsync_interval, /**< Sync every `fsyncIntervalBytes` and on close. */
+} encoder_fsync_policy_t;
+
+/**
+ * @brief Configuration of the block writer used by `encoder_create_writer`.
+ */
+typedef struct {
+    size_t blockSize;                   /**< Bytes collected per write, rounded up to 4 KiB. 0 selects 1 MiB. */
+    uint64_t preallocateSize;           /**< Extent reserved ahead of the written data. 0 disables preallocation. */
+    bool useDirectIo;                   /**< Bypass the page cache where the platform and file system allow it. */
+    encoder_fsync_policy_t fsyncPolicy; /**< When written data is synced to storage. */
+    uint64_t fsyncIntervalBytes;        /**< Bytes between syncs for `encoder_fsync_interval`. */
+} encoder_writer_config_t;
+
+/**
+ * @brief I/O statistics of a writer encoder.
+ */
+typedef struct {
+    uint64_t bytesWritten;     /**< Bytes passed to write calls, including alignment padding. */
+    uint64_t writeCalls;       /**< Number of write system calls. */
+    uint64_t readCalls;        /**< Number of reads of already written blocks, e.g. for the header patch. */
+    uint64_t preallocateCalls; /**< Number of preallocation system calls. */
+    uint64_t syncCalls;        /**< Number of sync system calls. */
+    double ioSeconds;          /**< Time spent in the system calls above. */
+    double megabytesPerSecond; /**< `bytesWritten` in MB (10^6 bytes) divided by `ioSeconds`. */
+    bool isDirectIo;           /**< Whether the page cache is actually bypassed. */
+} encoder_writer_stats_t;
+
+/**
+ * @brief When a segmented encoder rolls over to a new file.
+ *
+ * A segment ends as soon as either limit is reached. At least one limit must
+ * be set.
+ */
+typedef struct {
+    uint32_t segmentSeconds;              /**< Length of a segment in seconds. 0 for no time limit. */
+    uint64_t segmentBytes;                /**< Maximum size of a segment file. 0 for no size limit. */
+    bool useWriter;                       /**< Write segments with the block writer instead of stdio. */
+    encoder_writer_config_t writerConfig; /**< Block writer configuration, used when `useWriter` is set. */
+} encoder_segment_config_t;
+
+/**
+ * @brief Number of gaps an encoder records; later silent stretches are encoded.
+ */
+#define ENCODER_MAX_GAPS 1024
+
+/**
+ * @brief A stretch of silence left out of an encoded stream.
+ */
+typedef struct {
+    uint64_t position;   /**< Frames of the stream that precede the gap. */
+    uint64_t frameCount; /**< Frames of silence the gap stands for. */
+} encoder_gap_t;
+
+/**
+ * @brief Receives a completed segment from a segmented encoder.
+ *
+ * Called on the background thread of the encoder once the segment file is
+ * finalized and closed, in segment order. The last call of a recording has
+ * `isLast` set and comes from `encoder_finalize`.
+ *
+ * @param pUserData The user data passed to `encoder_create_segmented`.
+ * @param index The segment index, part of the file name.
+ * @param firstFrame The position of the first frame of the segment in the recording.
+ * @param frameCount The number of frames in the segment.
+ * @param sizeInBytes The size of the segment file.
+ * @param isLast Whether this is the last segment of the recording.
+ */
+typedef void (*encoder_segment_callback_t)(void *pUserData,
+                                           uint32_t index,
+                                           uint64_t firstFrame,
+                                           uint64_t frameCount,
+                                           uint64_t sizeInBytes,
+                                           bool isLast);
+
+/**
+ * @brief Receives an encoded chunk from a callback encoder.
+ *
+ * Ownership of `pData` passes to the callee, which must release it with
+ * `encoder_free_chunk`. Chunks normally arrive in order with contiguous
+ * offsets; when the container header is patched on finalize, the patched
+ * bytes arrive as extra chunks whose `offset` points back into the stream.
+ * Finally the callback is called once with `pData` NULL, `sizeInBytes` 0 and
+ * `offset` set to the stream size to mark the end of the stream.
+ *
+ * The callback runs on the thread that writes frames, which for recordings
+ * is the audio thread, so it must not block.
+ *
+ * @param pUserData The user data passed to `encoder_create_callback`.
+ * @param pData The chunk data.
+ * @param sizeInBytes The number of bytes in the chunk.
+ * @param offset The byte offset of the chunk in the encoded stream.
+ */
+typedef void (*encoder_chunk_callback_t)(void *pUserData,
+                                         void *pData,
+                                         size_t sizeInBytes,
+                                         uint64_t offset);
+
 /**
  * @brief Creates a new encoder instance.
  *
  * Initializes an encoder for writing audio data to a file.
  *
+ * Frames are always written in `pConfig->pcmFormat`. With a compact
+ * `pConfig->storage`, they are converted to 16-bit (vectorized) and, for IMA
+ * ADPCM, compressed while encoding, so the file can be much smaller than the
+ * device format. This applies to every encoder kind.
+ *
  * @param path The path to the output file.
  * @param pConfig Pointer to the encoder configuration.
  * @return A pointer to the newly created encoder instance, or NULL if the creation failed.
@@ -22,6 +143,227 @@ typedef struct {
 FFI_PLUGIN_EXPORT
 void* encoder_create(const char* path, encoder_config_t* pConfig);
 
+/**
+ * @brief Creates an encoder that writes a file through a block writer.
+ *
+ * Encoded bytes are collected into aligned blocks of
+ * `pWriterConfig->blockSize` bytes, so the file is written with a few large
+ * positioned writes regardless of how many frames each call delivers. The
+ * file extent is preallocated ahead of the data as it grows to keep long
+ * recordings contiguous on disk. The WAV header sizes are patched in place by
+ * `encoder_finalize`, which also truncates the file to its final size,
+ * releasing preallocated space that was not used.
+ *
+ * The thread that encodes frames, which for recordings is the audio thread,
+ * only copies into blocks; full blocks are written, preallocated and synced
+ * on a background thread. Up to `FILE_WRITER_QUEUE_BYTES` can wait for the
+ * disk, beyond that frames are dropped. Larger blocks mean fewer but longer
+ * writes.
+ *
+ * If the file system rejects direct I/O, the writer falls back to buffered
+ * writes; `encoder_get_writer_stats` reports which mode is used.
+ *
+ * @param path The path to the output file.
+ * @param pConfig Pointer to the encoder configuration.
+ * @param pWriterConfig Pointer to the writer configuration.
+ * @return A pointer to the newly created encoder instance, or NULL if the creation failed.
+ */
+FFI_PLUGIN_EXPORT
+void* encoder_create_writer(const char* path,
+                            encoder_config_t* pConfig,
+                            encoder_writer_config_t* pWriterConfig);
+
+/**
+ * @brief Retrieves the I/O statistics of a writer encoder.
+ *
+ * The counters are updated by the thread that encodes frames and can be read
+ * at any time; the totals are final after `encoder_finalize`.
+ *
+ * @param self Pointer to an encoder created by `encoder_create_writer`.
+ * @param pStats Pointer to the structure that receives the statistics.
+ * @return `true` on success, `false` if the encoder has no block writer.
+ */
+FFI_PLUGIN_EXPORT
+bool encoder_get_writer_stats(void* self, encoder_writer_stats_t* pStats);
+
+/**
+ * @brief Creates an encoder that splits the recording into segment files.
+ *
+ * Segment `i` is written to `<pathPrefix><i>.wav`, with `i` zero-padded to
+ * five digits. Rotation is frame-accurate: a write that crosses the segment
+ * boundary is split, so consecutive segments join without dropped or
+ * duplicated frames. The next file is opened ahead of time and finished
+ * files are finalized on a background thread, so the writing thread, usually
+ * the audio thread, never opens or closes files. If the next file is not
+ * ready in time, the current segment keeps growing until it is.
+ *
+ * The encoder is used like any other, e.g. with `playback_device_set_encoder`.
+ * `encoder_finalize` completes the last segment.
+ *
+ * @param pathPrefix The path of the segment files up to the index.
+ * @param pConfig Pointer to the encoder configuration of every segment.
+ * @param pSegmentConfig Pointer to the segmentation configuration.
+ * @param onSegment Optional callback receiving completed segments.
+ * @param pUserData User data passed to `onSegment`.
+ * @return A pointer to the newly created encoder instance, or NULL if the creation failed.
+ */
+FFI_PLUGIN_EXPORT
+void* encoder_create_segmented(const char* pathPrefix,
+                               encoder_config_t* pConfig,
+                               encoder_segment_config_t* pSegmentConfig,
+                               encoder_segment_callback_t onSegment,
+                               void* pUserData);
+
+/**
+ * @brief Creates an encoder that writes into a growable in-memory buffer.
+ *
+ * The buffer is a list of fixed-size chunks, so growing it never moves data
+ * that was already written. After `encoder_finalize`, the chunks are handed
+ * over with `encoder_take_chunk` without copying.
+ *
+ * @param pConfig Pointer to the encoder configuration.
+ * @param chunkSizeInBytes The size of each chunk. 0 selects 64 KiB.
+ * @return A pointer to the newly created encoder instance, or NULL if the creation failed.
+ */
+FFI_PLUGIN_EXPORT
+void* encoder_create_memory(encoder_config_t* pConfig, size_t chunkSizeInBytes);
+
+/**
+ * @brief Creates an encoder that streams encoded chunks to a callback.
+ *
+ * Encoded bytes are collected into chunks of `chunkSizeInBytes` and each full
+ * chunk is passed to `onChunk`. The last partial chunk and the patched header
+ * are delivered by `encoder_finalize`.
+ *
+ * @param pConfig Pointer to the encoder configuration.
+ * @param chunkSizeInBytes The size of each chunk. 0 selects 64 KiB.
+ * @param onChunk The callback receiving the chunks.
+ * @param pUserData User data passed to `onChunk`.
+ * @return A pointer to the newly created encoder instance, or NULL if the creation failed.
+ */
+FFI_PLUGIN_EXPORT
+void* encoder_create_callback(encoder_config_t* pConfig,
+                              size_t chunkSizeInBytes,
+                              encoder_chunk_callback_t onChunk,
+                              void* pUserData);
+
+/**
+ * @brief Feeds the encoded frames into a waveform overview, see `overview_create`.
+ *
+ * Every frame passed to `encoder_write_pcm_frames` is also reduced into the
+ * overview. `encoder_finalize` finishes the overview and, when `sidecarPath`
+ * is set, saves it there with `overview_save`, so the waveform of the
+ * recording can later be drawn without reading the audio.
+ *
+ * Must be called before frames are written. The overview must have the PCM
+ * format and channel count of the encoder and stays owned by the caller.
+ *
+ * @param self Pointer to the encoder instance.
+ * @param pOverview Pointer to the overview, or NULL to detach it.
+ * @param sidecarPath Optional path the overview is saved to on finalize.
+ * @return `true` on success, `false` if the overview format does not match the encoder.
+ */
+FFI_PLUGIN_EXPORT
+bool encoder_set_overview(void* self, void* pOverview, const char* sidecarPath);
+
+/**
+ * @brief Encodes PCM frames.
+ *
+ * The frames must be in the format given by the encoder configuration.
+ *
+ * @param self Pointer to the encoder instance.
+ * @param pFrames Pointer to the frames to encode.
+ * @param frameCount The number of frames to encode.
+ * @return The number of frames written.
+ */
+FFI_PLUGIN_EXPORT
+uint64_t encoder_write_pcm_frames(void* self, const void* pFrames, uint64_t frameCount);
+
+/**
+ * @brief Records a stretch of silence instead of encoding it.
+ *
+ * No frames are written; the gap is noted at the current position of the
+ * stream, merged with a gap recorded right before it. A recording where
+ * silence was left out can be laid back on its timeline by inserting
+ * `frameCount` silent frames after `position` frames for each gap listed by
+ * `encoder_get_gaps`. Gaps recorded after `encoder_finalize` are ignored.
+ *
+ * WAV files keep the gaps: `encoder_finalize` appends a `cue ` chunk with a
+ * point at the `position` of each gap and a `LIST` `adtl` chunk whose `ltxt`
+ * entries, of purpose `rgn `, give its `frameCount`. Each segment of a
+ * segmented encoder lists the gaps that fall into it.
+ *
+ * Never blocks or allocates, so it may run on the audio thread. Once
+ * `ENCODER_MAX_GAPS` gaps are recorded, new ones are refused.
+ *
+ * @param self Pointer to the encoder instance.
+ * @param frameCount The number of silent frames.
+ * @return `frameCount`, or 0 if the gap could not be recorded; the frames should then be encoded.
+ */
+FFI_PLUGIN_EXPORT
+uint64_t encoder_write_gap(void* self, uint64_t frameCount);
+
+/**
+ * @brief Lists the gaps recorded with `encoder_write_gap`, in stream order.
+ *
+ * May run on any thread while gaps are recorded; it retries until it reads
+ * a consistent list.
+ *
+ * @param self Pointer to the encoder instance.
+ * @param pGaps Pointer to an array receiving up to `capacity` gaps, or NULL to only count them.
+ * @param capacity The number of gaps `pGaps` can hold.
+ * @return The total number of gaps, which may exceed `capacity`.
+ */
+FFI_PLUGIN_EXPORT
+uint32_t encoder_get_gaps(void* self, encoder_gap_t* pGaps, uint32_t capacity);
+
+/**
+ * @brief Finishes the encoded stream.
+ *
+ * Patches the container header with the final sizes and flushes pending data.
+ * Frames written afterwards are ignored. Called by `encoder_destroy` if it was
+ * not called before. Must not be called while a device is still writing.
+ *
+ * @param self Pointer to the encoder instance.
+ */
+FFI_PLUGIN_EXPORT
+void encoder_finalize(void* self);
+
+/**
+ * @brief Returns the number of encoded bytes produced so far.
+ *
+ * For a segmented encoder, this is the size of the completed segments plus
+ * the current one.
+ *
+ * @param self Pointer to the encoder instance.
+ * @return The size of the encoded stream in bytes.
+ */
+FFI_PLUGIN_EXPORT
+uint64_t encoder_get_size_in_bytes(void* self);
+
+/**
+ * @brief Removes the first chunk from a finalized memory encoder.
+ *
+ * Ownership of the returned chunk passes to the caller, which must release it
+ * with `encoder_free_chunk`. Concatenating all chunks in order yields the
+ * encoded file.
+ *
+ * @param self Pointer to a finalized memory encoder.
+ * @param pSizeInBytes Pointer to a variable that receives the chunk size.
+ * @return The chunk data, or NULL when no chunks are left.
+ */
+FFI_PLUGIN_EXPORT
+void* encoder_take_chunk(void* self, size_t* pSizeInBytes);
+
+/**
+ * @brief Releases a chunk returned by `encoder_take_chunk` or passed to an
+ * `encoder_chunk_callback_t`.
+ *
+ * @param pData The chunk data.
+ */
+FFI_PLUGIN_EXPORT
+void encoder_free_chunk(void* pData);
+
 /**
  * @brief Destroys an encoder instance.
  *
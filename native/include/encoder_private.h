@@ -0,0 +1,89 @@
+#ifndef ENCODER_PRIVATE_H
+#define ENCODER_PRIVATE_H
+
+#include <stdatomic.h>
+#include <stdio.h>
+
+#include "encoder.h"
+#include "file_writer.h"
+#include "segmenter.h"
+#include "miniaudio.h"
+
+/**
+ * @enum encoder_sink_t
+ * @brief Where the encoded bytes of an encoder go.
+ */
+typedef enum {
+    encoder_sink_file,     /**< A file written through stdio. */
+    encoder_sink_memory,   /**< A list of chunks kept in memory. */
+    encoder_sink_callback, /**< Chunks handed to an `encoder_chunk_callback_t`. */
+    encoder_sink_writer,   /**< A file written in large aligned blocks. */
+    encoder_sink_segments, /**< Segment files, each written by its own encoder. */
+} encoder_sink_t;
+
+/**
+ * @struct encoder_chunk_t
+ * @brief A block of encoded bytes.
+ *
+ * Only `data` is exposed outside the encoder; the header is recovered from it
+ * by `encoder_free_chunk`.
+ */
+typedef struct encoder_chunk {
+    struct encoder_chunk* pNext; /**< Next chunk of a memory encoder. */
+    uint64_t offset;             /**< Offset of `data[0]` in the encoded stream. */
+    size_t size;                 /**< Number of bytes used in `data`. */
+    uint8_t data[];              /**< `chunkSize` bytes of encoded data. */
+} encoder_chunk_t;
+
+/**
+ * @struct encoder_adpcm_t
+ * @brief State of the built-in IMA ADPCM encoder.
+ */
+typedef struct {
+    uint32_t blockAlign;     /**< Block size in bytes. */
+    uint32_t framesPerBlock; /**< Frames stored in a block. */
+    int16_t* pFrames;        /**< `framesPerBlock` frames waiting for a full block. */
+    uint32_t bufferedFrames; /**< Number of frames in `pFrames`. */
+    uint8_t* pBlock;         /**< `blockAlign` bytes for the encoded block. */
+    uint8_t stepIndex[2];    /**< Step index of each channel. */
+    uint64_t frameCount;     /**< Frames encoded so far, for the `fact` chunk. */
+} encoder_adpcm_t;
+
+/**
+ * @struct encoder_t
+ * @brief An encoder and the sink it writes to.
+ */
+typedef struct {
+    ma_encoder maEncoder;    /**< Miniaudio encoder. */
+    encoder_config_t config; /**< Encoder configuration. */
+    encoder_sink_t sink;     /**< Where the encoded bytes go. */
+    bool isFinalized;        /**< `maEncoder` was uninitialized and the stream is complete. */
+    size_t chunkSize;        /**< Capacity of each chunk in bytes. */
+    uint64_t position;       /**< Write position in the encoded stream. */
+    uint64_t size;           /**< Size of the encoded stream. */
+
+    int16_t* pScratch;     /**< Frames converted to 16-bit for a compact `config.storage`, NULL otherwise. */
+    encoder_adpcm_t adpcm; /**< IMA ADPCM state, used instead of `maEncoder` for `encoder_storage_ima_adpcm`. */
+
+    FILE* pFile; /**< File sink: the output file. */
+
+    encoder_chunk_t* pHead; /**< Memory sink: first chunk. */
+    encoder_chunk_t* pTail; /**< Memory sink: last chunk. Callback sink: chunk being filled. */
+
+    encoder_chunk_callback_t onChunk; /**< Callback sink: receives full chunks. */
+    void* pCallbackUserData;          /**< Callback sink: user data for `onChunk`. */
+
+    file_writer_t writer; /**< Writer sink: the block writer. */
+
+    segmenter_t* pSegmenter; /**< Segments sink: rotates frames through segment encoders. */
+
+    uint64_t framesWritten;               /**< Frames encoded so far, the position of the next gap. */
+    encoder_gap_t gaps[ENCODER_MAX_GAPS]; /**< Gaps recorded with `encoder_write_gap`. */
+    uint32_t gapCount;                    /**< Number of entries in `gaps`. */
+    atomic_uint gapSequence;              /**< Odd while the writing thread changes `gaps`, see `encoder_get_gaps`. */
+
+    void* pOverview;     /**< Waveform overview fed with the written frames, or NULL. */
+    char* overviewPath;  /**< Where `pOverview` is saved on finalize, or NULL. */
+} encoder_t;
+
+#endif  // ENCODER_PRIVATE_H
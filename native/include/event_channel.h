@@ -0,0 +1,92 @@
+#ifndef EVENT_CHANNEL_H
+#define EVENT_CHANNEL_H
+
+#include <stdatomic.h>
+
+#include "playback_device.h"
+
+/**
+ * @brief Number of events the queue holds. Must be a power of two.
+ */
+#define EVENT_CHANNEL_CAPACITY 64
+
+/**
+ * @struct event_channel_event_t
+ * @brief A queued event, see `playback_event_callback_t`.
+ */
+typedef struct {
+    playback_event_type_t type; /**< The event type. */
+    device_state_t state;       /**< The device state when posted. */
+    uint32_t availableBytes;    /**< The ring buffer fill when posted. */
+} event_channel_event_t;
+
+/**
+ * @struct event_channel_cell_t
+ * @brief A queue slot. `sequence` tells producers and the consumer whose turn it is.
+ */
+typedef struct {
+    atomic_size_t sequence;      /**< Position the slot is ready for. */
+    event_channel_event_t event; /**< The event. */
+} event_channel_cell_t;
+
+/**
+ * @struct event_channel_t
+ * @brief Delivers events from real-time threads to a callback.
+ *
+ * A bounded multi-producer, single-consumer queue: producers claim a slot with
+ * one compare-and-swap and never block, allocate or signal, so posting is
+ * wait-free on the audio thread. A dispatcher thread polls the queue every
+ * few milliseconds, drains it and calls the callback.
+ * Events posted while the queue is full are dropped and counted.
+ */
+typedef struct {
+    event_channel_cell_t cells[EVENT_CHANNEL_CAPACITY]; /**< Queue slots. */
+    atomic_size_t enqueuePos;                           /**< Next position claimed by a producer. */
+    size_t dequeuePos;                                  /**< Next position read by the dispatcher. */
+    atomic_uint droppedEvents;                          /**< Events lost to a full queue. */
+
+    playback_event_callback_t onEvent; /**< Receives the events. */
+    void *pUserData;                   /**< User data for `onEvent`. */
+
+    pthread_t thread;       /**< Dispatcher thread. */
+    pthread_mutex_t mutex;  /**< Protects the wake-up condition. */
+    pthread_cond_t cond;    /**< Signalled on stop. */
+    atomic_bool isRunning;  /**< Events are accepted. */
+    atomic_bool stop;       /**< Asks the dispatcher to exit. */
+} event_channel_t;
+
+/**
+ * @brief Initializes an idle channel.
+ */
+void event_channel_init(event_channel_t *self);
+
+/**
+ * @brief Starts the dispatcher thread delivering events to `onEvent`.
+ *
+ * @return `true` on success, `false` if the thread could not be started.
+ */
+bool event_channel_start(event_channel_t *self, playback_event_callback_t onEvent, void *pUserData);
+
+/**
+ * @brief Delivers the queued events and `playback_event_closed`, then stops the dispatcher.
+ *
+ * Does nothing if the channel is not running.
+ */
+void event_channel_stop(event_channel_t *self);
+
+/**
+ * @brief Queues an event without blocking.
+ *
+ * @return `true` if the event was queued, `false` if the channel is not running or full.
+ */
+bool event_channel_post(event_channel_t *self,
+                        playback_event_type_t type,
+                        device_state_t state,
+                        uint32_t availableBytes);
+
+/**
+ * @brief Stops the channel if needed and releases its resources.
+ */
+void event_channel_uninit(event_channel_t *self);
+
+#endif  // EVENT_CHANNEL_H
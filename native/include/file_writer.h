@@ -0,0 +1,133 @@
+#ifndef FILE_WRITER_H
+#define FILE_WRITER_H
+
+#include <stdatomic.h>
+
+#include "encoder.h"
+
+/**
+ * @brief Bytes the writing thread can fill ahead of the disk.
+ *
+ * Rounded up to whole blocks, with at least `FILE_WRITER_MIN_QUEUE_BLOCKS`.
+ */
+#define FILE_WRITER_QUEUE_BYTES (4 * 1024 * 1024)
+
+/**
+ * @brief Minimum number of blocks in the queue of a writer.
+ */
+#define FILE_WRITER_MIN_QUEUE_BLOCKS 4
+
+/**
+ * @struct file_writer_block_t
+ * @brief One block-sized buffer of a writer and the file range it maps to.
+ */
+typedef struct {
+    uint8_t *pData;       /**< Aligned buffer of `config.blockSize` bytes. */
+    uint64_t blockOffset; /**< File offset of `pData[0]`. */
+    size_t blockFill;     /**< Bytes of `pData` that hold file data. */
+} file_writer_block_t;
+
+/**
+ * @struct file_writer_t
+ * @brief Writes a file in large aligned blocks on a background thread.
+ *
+ * The writing thread collects bytes into the current block, which maps to the
+ * file range `[blockOffset, blockOffset + blockSize)`. A block that is full,
+ * or that a write leaves, is handed to the background thread by incrementing
+ * `submitted`; the background thread writes it with one positioned write,
+ * preallocating and syncing as configured, then increments `completed`. The
+ * blocks are used in turn, so the current one is
+ * `pBlocks[submitted % blockCount]`.
+ * Handing a block over neither locks nor signals: the background thread
+ * polls, so the writing thread may be the audio thread. When every block is
+ * queued, writes are cut short rather than wait for the disk.
+ *
+ * Writes into a block that is already handed over, which is how header
+ * patches are applied, wait for the background thread and read the block
+ * back, so they must not happen on the audio thread. All offsets are
+ * multiples of the block size, which is a multiple of
+ * `FILE_WRITER_ALIGNMENT`, as direct I/O requires.
+ *
+ * The writer is not thread-safe except for the statistics, which may be read
+ * from any thread.
+ */
+typedef struct {
+    int fd;                         /**< File descriptor, -1 once closed. */
+    bool isDirect;                  /**< The page cache is bypassed. */
+    encoder_writer_config_t config; /**< Writer configuration with defaults applied. */
+
+    file_writer_block_t *pBlocks;  /**< Blocks, filled and written in turn. */
+    uint32_t blockCount;           /**< Number of entries in `pBlocks`. */
+    uint8_t *pStorage;             /**< Aligned memory backing all blocks. */
+    file_writer_block_t *pCurrent; /**< Writing thread: block being filled, NULL if none is free. */
+    bool isBlockDirty;             /**< Writing thread: `pCurrent` has bytes that are not on disk. */
+    uint64_t fileSize;             /**< Writing thread: logical size of the file. */
+
+    _Atomic(uint64_t) submitted; /**< Blocks handed to the background thread. */
+    _Atomic(uint64_t) completed; /**< Blocks the background thread wrote. */
+    atomic_uint overruns;        /**< Writes cut short because every block was queued. */
+    atomic_bool hasFailed;       /**< A block could not be written. */
+
+    uint64_t preallocatedEnd; /**< Background thread: end of the extent reserved so far. */
+    uint64_t bytesSinceSync;  /**< Background thread: bytes written since the last sync. */
+
+    pthread_t thread;          /**< Background thread. */
+    pthread_mutex_t mutex;     /**< Protects the wake-up conditions. */
+    pthread_cond_t cond;       /**< Wakes the background thread on drain and stop. */
+    pthread_cond_t drained;    /**< Signalled when the background thread caught up. */
+    atomic_bool stop;          /**< Set on close. */
+
+    _Atomic(uint64_t) bytesWritten;     /**< See `encoder_writer_stats_t`. */
+    _Atomic(uint64_t) writeCalls;       /**< See `encoder_writer_stats_t`. */
+    _Atomic(uint64_t) readCalls;        /**< See `encoder_writer_stats_t`. */
+    _Atomic(uint64_t) preallocateCalls; /**< See `encoder_writer_stats_t`. */
+    _Atomic(uint64_t) syncCalls;        /**< See `encoder_writer_stats_t`. */
+    _Atomic(uint64_t) ioNanoseconds;    /**< Time spent in system calls. */
+} file_writer_t;
+
+/**
+ * @brief Alignment of blocks, offsets and buffers in bytes.
+ */
+#define FILE_WRITER_ALIGNMENT 4096
+
+/**
+ * @brief Creates or truncates a file and starts the background thread.
+ *
+ * @param self Pointer to the writer to initialize.
+ * @param path The path to the file.
+ * @param pConfig Pointer to the writer configuration.
+ * @return `true` on success, `false` if the file, the blocks or the thread could not be created.
+ */
+bool file_writer_open(file_writer_t *self, const char *path, const encoder_writer_config_t *pConfig);
+
+/**
+ * @brief Writes bytes at the given file offset.
+ *
+ * @param self Pointer to the writer.
+ * @param offset The file offset of the first byte. Must not leave a hole past the end of the file.
+ * @param pData The bytes to write.
+ * @param size The number of bytes to write.
+ * @return The number of bytes accepted, less than `size` when every block is queued or a read back failed.
+ */
+size_t file_writer_write(file_writer_t *self, uint64_t offset, const void *pData, size_t size);
+
+/**
+ * @brief Writes the pending blocks, trims the file to its size and closes it.
+ *
+ * Syncs the file unless the policy is `encoder_fsync_never`, then stops the
+ * background thread. Does nothing if the writer is already closed.
+ *
+ * @param self Pointer to the writer.
+ * @return `true` if all data reached the file.
+ */
+bool file_writer_close(file_writer_t *self);
+
+/**
+ * @brief Retrieves the I/O statistics of the writer.
+ *
+ * @param self Pointer to the writer.
+ * @param pStats Pointer to the structure that receives the statistics.
+ */
+void file_writer_get_stats(file_writer_t *self, encoder_writer_stats_t *pStats);
+
+#endif  // FILE_WRITER_H
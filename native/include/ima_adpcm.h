@@ -0,0 +1,60 @@
+#ifndef IMA_ADPCM_H
+#define IMA_ADPCM_H
+
+#include <stdint.h>
+
+/**
+ * Internal IMA ADPCM encoder, as stored in WAV files (format tag 0x11).
+ *
+ * A block starts with one 4-byte header per channel holding the first sample
+ * and the current step index, followed by groups of 4 bytes per channel that
+ * each hold 8 samples as 4-bit codes, low nibble first. Only mono and stereo
+ * are supported, matching what common decoders accept.
+ */
+
+/**
+ * @brief The WAV format tag of IMA ADPCM.
+ */
+#define IMA_ADPCM_FORMAT_TAG 0x0011
+
+/**
+ * @brief Block size per channel in bytes.
+ *
+ * Gives 1017 frames per block, about 21 ms at 48 kHz.
+ */
+#define IMA_ADPCM_BLOCK_ALIGN_PER_CHANNEL 512
+
+/**
+ * @brief Returns the number of frames stored in a block.
+ *
+ * @param blockAlign The block size in bytes.
+ * @param channels The number of channels, 1 or 2.
+ */
+uint32_t ima_adpcm_frames_per_block(uint32_t blockAlign, uint32_t channels);
+
+/**
+ * @brief Returns the smallest step index that reaches a difference in one sample.
+ *
+ * Used to seed the first block so the encoder does not start from the
+ * smallest step and need dozens of samples to catch up with the signal.
+ *
+ * @param delta The difference between the first two samples of a channel.
+ */
+uint8_t ima_adpcm_step_index_for(int32_t delta);
+
+/**
+ * @brief Encodes one block.
+ *
+ * @param pFrames `ima_adpcm_frames_per_block` interleaved 16-bit frames.
+ * @param channels The number of channels, 1 or 2.
+ * @param blockAlign The block size in bytes.
+ * @param pStepIndex Step index of each channel, carried from block to block.
+ * @param pBlock Pointer to `blockAlign` bytes that receive the block.
+ */
+void ima_adpcm_encode_block(const int16_t *pFrames,
+                            uint32_t channels,
+                            uint32_t blockAlign,
+                            uint8_t *pStepIndex,
+                            uint8_t *pBlock);
+
+#endif  // IMA_ADPCM_H
@@ -1,6 +1,8 @@
 #ifndef INTERNAL_H
 #define INTERNAL_H
 
+#include <stdint.h>
+
 #include "miniaudio.h"
 
 /**
@@ -11,4 +13,16 @@
  */
 const char *describe_ma_format(ma_format format);
 
+/**
+ * @brief Estimates the frames between the callback of a playback device and its output.
+ *
+ * Counts the buffer of the backend, converted to the rate of the device,
+ * and the latency of the converter. The backend may add more, so this is a
+ * lower bound.
+ *
+ * @param pDevice The playback device.
+ * @return The latency in frames at the sample rate of the device.
+ */
+uint32_t estimate_playback_latency_frames(ma_device *pDevice);
+
 #endif  // INTERNAL_H
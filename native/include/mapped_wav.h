@@ -0,0 +1,108 @@
+#ifndef MAPPED_WAV_H
+#define MAPPED_WAV_H
+
+#include "audio_context.h"
+#include "platform.h"
+
+/**
+ * @brief Opens an uncompressed PCM WAV file through a read-only memory mapping.
+ *
+ * The header is parsed once at open time and the sample data is never copied
+ * into intermediate buffers. When the file already has the requested output
+ * format, reads copy frames straight from the mapping into the caller's
+ * buffer; otherwise they run through a data converter fed directly from the
+ * mapping. The kernel is asked for sequential read-ahead on the mapping.
+ *
+ * The returned object is a miniaudio data source and can be attached to a
+ * playback device with `playback_device_attach_source`. Supported sample
+ * formats are 8-bit unsigned, 16/24/32-bit signed and 32-bit float PCM.
+ * Not available on Windows.
+ *
+ * @param path The path to the WAV file.
+ * @param pOutputFormat Pointer to the format frames are read in.
+ * @return A pointer to the mapped WAV source, or NULL if the file is not a supported WAV file.
+ */
+FFI_PLUGIN_EXPORT
+void *mapped_wav_create(const char *path, audio_format_t *pOutputFormat);
+
+/**
+ * @brief Unmaps the file and releases the source.
+ *
+ * @param self Pointer to the mapped WAV source to destroy.
+ */
+FFI_PLUGIN_EXPORT
+void mapped_wav_destroy(void *self);
+
+/**
+ * @brief Retrieves the format stored in the file.
+ *
+ * @param self Pointer to the mapped WAV source.
+ * @param pFormat Pointer to the structure that receives the file format.
+ */
+FFI_PLUGIN_EXPORT
+void mapped_wav_get_file_format(void *self, audio_format_t *pFormat);
+
+/**
+ * @brief Returns whether frames are copied straight from the mapping.
+ *
+ * @param self Pointer to the mapped WAV source.
+ * @return `true` if the file format equals the output format, `false` if reads are converted.
+ */
+FFI_PLUGIN_EXPORT
+bool mapped_wav_is_direct(void *self);
+
+/**
+ * @brief Moves the read position to the given output frame.
+ *
+ * Must not be called while another thread reads from the source, e.g. while
+ * it is attached to a running playback device.
+ *
+ * @param self Pointer to the mapped WAV source.
+ * @param frameIndex The frame to seek to, in output frames.
+ * @return `true` on success, `false` if the index is past the end.
+ */
+FFI_PLUGIN_EXPORT
+bool mapped_wav_seek(void *self, uint64_t frameIndex);
+
+/**
+ * @brief Enables or disables looping at the end of the file.
+ *
+ * @param self Pointer to the mapped WAV source.
+ * @param isLooping Whether reading restarts from the beginning at the end.
+ */
+FFI_PLUGIN_EXPORT
+void mapped_wav_set_looping(void *self, bool isLooping);
+
+/**
+ * @brief Returns the read position, in output frames.
+ *
+ * @param self Pointer to the mapped WAV source.
+ * @return The index of the next frame that will be read, or 0 if `self` is NULL.
+ */
+FFI_PLUGIN_EXPORT
+uint64_t mapped_wav_get_cursor(void *self);
+
+/**
+ * @brief Returns the length of the file, in output frames.
+ *
+ * @param self Pointer to the mapped WAV source.
+ * @return The number of frames, or 0 if `self` is NULL.
+ */
+FFI_PLUGIN_EXPORT
+uint64_t mapped_wav_get_length(void *self);
+
+/**
+ * @brief Reads PCM frames in the output format.
+ *
+ * @param self Pointer to the mapped WAV source.
+ * @param pFramesOut Pointer to the output buffer where PCM frames will be written.
+ * @param framesCount The maximum number of frames to read.
+ * @param pFramesRead Pointer to a variable that will store the actual number of frames read.
+ */
+FFI_PLUGIN_EXPORT
+void mapped_wav_read_pcm_frames_with_buffer(void *self,
+                                            void *pFramesOut,
+                                            uint64_t framesCount,
+                                            uint64_t *pFramesRead);
+
+#endif  // MAPPED_WAV_H
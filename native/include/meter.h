@@ -0,0 +1,110 @@
+#ifndef METER_H
+#define METER_H
+
+#include <stdatomic.h>
+
+#include "miniaudio.h"
+#include "playback_device.h"
+
+/**
+ * @brief Frames converted and measured at a time.
+ */
+#define METER_SLICE_FRAMES 256
+
+/**
+ * @brief Taps per phase of the true-peak interpolation filter.
+ */
+#define METER_TRUE_PEAK_TAPS 12
+
+/**
+ * @brief Loudness blocks of 100 ms kept for the short-term window.
+ */
+#define METER_LOUDNESS_BLOCKS 30
+
+/**
+ * @struct meter_biquad_t
+ * @brief A second-order section in transposed direct form II.
+ */
+typedef struct {
+    double b0, b1, b2, a1, a2; /**< Coefficients, normalized to a0 = 1. */
+} meter_biquad_t;
+
+/**
+ * @struct meter_channel_t
+ * @brief Per-channel state of a meter.
+ */
+typedef struct {
+    float peak;       /**< Sample peak with fall-back. */
+    float meanSquare; /**< Exponentially averaged mean square. */
+    float truePeak;   /**< True peak with fall-back. */
+
+    float history[2 * METER_TRUE_PEAK_TAPS]; /**< Last input samples, stored twice to avoid wrapping. */
+
+    double shelfState[2];    /**< State of the K-weighting shelf. */
+    double highpassState[2]; /**< State of the K-weighting high-pass. */
+    double weight;           /**< Channel weight of the loudness sum. */
+} meter_channel_t;
+
+/**
+ * @struct meter_t
+ * @brief Measures levels and loudness on the audio thread.
+ *
+ * `meter_process` runs on the audio thread and never blocks or allocates.
+ * After each call, the levels are copied into `published` under the
+ * sequence lock `sequence`, which is odd while the copy is in progress, so
+ * `meter_read` can take a consistent snapshot from any thread without
+ * locking.
+ */
+typedef struct {
+    ma_format format;    /**< Format of the measured frames. */
+    uint32_t channels;   /**< Number of channels. */
+    uint32_t sampleRate; /**< Sample rate in Hertz. */
+
+    float *pScratch;          /**< `METER_SLICE_FRAMES` frames converted to f32. */
+    uint32_t historyPos;      /**< Next write position in the true-peak histories. */
+    float peakFallPerFrame;   /**< Peak fall-back factor per frame. */
+    float rmsCoefPerFrame;    /**< Mean square decay per frame. */
+    meter_biquad_t shelf;     /**< K-weighting stage 1. */
+    meter_biquad_t highpass;  /**< K-weighting stage 2. */
+    meter_channel_t channel[PLAYBACK_METER_MAX_CHANNELS]; /**< Per-channel state. */
+
+    uint32_t blockFrames;                         /**< Frames per 100 ms loudness block. */
+    uint32_t blockFill;                           /**< Frames in the current block. */
+    double blockEnergy;                           /**< Weighted energy of the current block. */
+    double blocks[METER_LOUDNESS_BLOCKS];         /**< Mean square of the last blocks, oldest overwritten. */
+    uint32_t blockCount;                          /**< Valid entries of `blocks`. */
+    uint32_t blockPos;                            /**< Next write position in `blocks`. */
+    uint64_t framesMetered;                       /**< Frames measured since the last reset. */
+
+    atomic_uint sequence;       /**< Sequence lock of `published`. */
+    playback_meter_t published; /**< Latest levels. */
+} meter_t;
+
+/**
+ * @brief Creates a meter for frames of the given format.
+ *
+ * @return The meter, or NULL if `channels` exceeds `PLAYBACK_METER_MAX_CHANNELS` or memory ran out.
+ */
+meter_t *meter_create(ma_format format, uint32_t channels, uint32_t sampleRate);
+
+/**
+ * @brief Clears the levels and filter states. Must not run concurrently with `meter_process`.
+ */
+void meter_reset(meter_t *self);
+
+/**
+ * @brief Measures interleaved frames and publishes the levels.
+ */
+void meter_process(meter_t *self, const void *pFrames, uint32_t frameCount);
+
+/**
+ * @brief Copies a consistent snapshot of the latest levels.
+ */
+void meter_read(meter_t *self, playback_meter_t *pMeter);
+
+/**
+ * @brief Releases the meter.
+ */
+void meter_destroy(meter_t *self);
+
+#endif  // METER_H
@@ -0,0 +1,153 @@
+#ifndef OVERVIEW_H
+#define OVERVIEW_H
+
+#include "audio_context.h"
+#include "platform.h"
+
+/**
+ * @brief Configuration of a waveform overview.
+ */
+typedef struct {
+    pcm_format_t pcmFormat; /**< PCM format of the written frames. */
+    uint32_t channels;      /**< Number of channels. */
+    uint32_t sampleRate;    /**< Sample rate in Hertz, kept for the sidecar file. */
+    uint32_t blockFrames;   /**< Frames per block of the finest level. 0 selects 256. */
+} overview_config_t;
+
+/**
+ * @brief Creates a min/max waveform overview.
+ *
+ * An overview keeps the minimum and maximum sample of every channel per block
+ * of `blockFrames` frames, and a pyramid of coarser levels where each level
+ * halves the previous one. It is built incrementally while frames are
+ * written, so drawing any zoom range of a long recording costs time
+ * proportional to the number of output pixels instead of the number of
+ * frames.
+ *
+ * Frames are written with `overview_write_pcm_frames`, or by attaching the
+ * overview to an encoder with `encoder_set_overview` or to a playback device
+ * with `playback_device_set_overview`. Writing never blocks: completed
+ * blocks go through a lock-free ring to a background thread that grows the
+ * pyramid. When the ring is full, a writer faster than real time grows the
+ * pyramid itself if no query holds it, while the audio thread of a playback
+ * device drops the block. An overview must only be fed by one writer at a
+ * time.
+ *
+ * @param pConfig Pointer to the overview configuration.
+ * @return A pointer to the overview, or NULL if the creation failed.
+ */
+FFI_PLUGIN_EXPORT
+void *overview_create(overview_config_t *pConfig);
+
+/**
+ * @brief Loads an overview saved with `overview_save`.
+ *
+ * The pyramid is rebuilt from the finest level stored in the file. Frames
+ * written to a loaded overview are ignored.
+ *
+ * @param path The path to the sidecar file.
+ * @return A pointer to the overview, or NULL if the file is not a valid overview.
+ */
+FFI_PLUGIN_EXPORT
+void *overview_load(const char *path);
+
+/**
+ * @brief Retrieves the configuration of an overview.
+ *
+ * @param self Pointer to the overview.
+ * @param pConfig Pointer to the structure that receives the configuration, with defaults applied.
+ * @return `true` on success, `false` if a parameter is NULL.
+ */
+FFI_PLUGIN_EXPORT
+bool overview_get_config(void *self, overview_config_t *pConfig);
+
+/**
+ * @brief Adds frames to the overview.
+ *
+ * May grow the pyramid when the writer outruns the background thread; attach
+ * the overview with `playback_device_set_overview` to feed it from the audio
+ * thread.
+ *
+ * @param self Pointer to the overview.
+ * @param pFrames Pointer to interleaved frames in the configured format.
+ * @param frameCount The number of frames.
+ * @return The number of frames added, 0 once the overview is finished.
+ */
+FFI_PLUGIN_EXPORT
+uint64_t overview_write_pcm_frames(void *self, const void *pFrames, uint64_t frameCount);
+
+/**
+ * @brief Completes the last, partial block. Frames written afterwards are ignored.
+ *
+ * Called by `encoder_finalize` for an overview attached to the encoder. Must
+ * not be called while frames are still being written.
+ *
+ * @param self Pointer to the overview.
+ */
+FFI_PLUGIN_EXPORT
+void overview_finish(void *self);
+
+/**
+ * @brief Returns the number of frames covered by the overview.
+ *
+ * Frames of a block still being filled are only counted once the block is
+ * complete or the overview is finished.
+ *
+ * @param self Pointer to the overview.
+ * @return The number of frames that can be queried.
+ */
+FFI_PLUGIN_EXPORT
+uint64_t overview_get_frame_count(void *self);
+
+/**
+ * @brief Computes the minimum and maximum of a channel for each pixel of a range.
+ *
+ * The range `[startFrame, startFrame + frameCount)` is split into
+ * `pixelCount` equal spans. Each span is answered from the coarsest level
+ * whose blocks are not larger than the span, so the cost depends on
+ * `pixelCount` only. Spans shorter than a block of the finest level get the
+ * values of the block they fall into.
+ *
+ * @param self Pointer to the overview.
+ * @param channel The channel to query.
+ * @param startFrame The first frame of the range.
+ * @param frameCount The number of frames in the range.
+ * @param pixelCount The number of spans, the size of `pMin` and `pMax`.
+ * @param pMin Pointer to the array that receives the minimum of each span.
+ * @param pMax Pointer to the array that receives the maximum of each span.
+ * @return The number of leading spans written; spans past the covered frames are left untouched.
+ */
+FFI_PLUGIN_EXPORT
+uint32_t overview_query(void *self,
+                        uint32_t channel,
+                        uint64_t startFrame,
+                        uint64_t frameCount,
+                        uint32_t pixelCount,
+                        float *pMin,
+                        float *pMax);
+
+/**
+ * @brief Writes the overview to a sidecar file.
+ *
+ * The file holds the configuration and the finest level in native byte
+ * order; the coarser levels are rebuilt by `overview_load`. Can be called
+ * while frames are written, in which case it saves the complete blocks.
+ *
+ * @param self Pointer to the overview.
+ * @param path The path to the sidecar file.
+ * @return `true` on success, `false` if the file could not be written.
+ */
+FFI_PLUGIN_EXPORT
+bool overview_save(void *self, const char *path);
+
+/**
+ * @brief Stops the background thread and releases the overview.
+ *
+ * The overview must be detached from encoders and devices first.
+ *
+ * @param self Pointer to the overview.
+ */
+FFI_PLUGIN_EXPORT
+void overview_destroy(void *self);
+
+#endif  // OVERVIEW_H
@@ -0,0 +1,87 @@
+#ifndef OVERVIEW_PRIVATE_H
+#define OVERVIEW_PRIVATE_H
+
+#include <stdatomic.h>
+
+#include "miniaudio.h"
+#include "overview.h"
+
+/**
+ * @brief Maximum number of levels of the pyramid.
+ */
+#define OVERVIEW_MAX_LEVELS 40
+
+/**
+ * @struct overview_level_t
+ * @brief One level of the pyramid.
+ *
+ * Entry `i` covers blocks `[i << level, (i + 1) << level)` of the finest
+ * level and holds a minimum and a maximum per channel, interleaved.
+ */
+typedef struct {
+    float *pData;      /**< `2 * channels` floats per entry. */
+    uint64_t count;    /**< Number of entries. */
+    uint64_t capacity; /**< Number of entries `pData` can hold. */
+} overview_level_t;
+
+/**
+ * @struct overview_entry_t
+ * @brief A completed block as it travels through the tap.
+ */
+typedef struct {
+    uint64_t index;   /**< Index of the block in the finest level. */
+    uint32_t frames;  /**< Frames in the block, less than `blockFrames` only for the last one. */
+    uint32_t padding; /**< Keeps `minMax` 8-byte aligned. */
+    float minMax[];   /**< Minimum and maximum per channel, interleaved. */
+} overview_entry_t;
+
+/**
+ * @struct overview_t
+ * @brief A min/max pyramid fed from a writing thread.
+ *
+ * The writing thread, usually the audio thread, owns the fields marked as
+ * such: it reduces frames into the current block and pushes each completed
+ * block into `tap`. Everything else is protected by `mutex` and filled by
+ * whoever drains the tap: the background thread, or a query or save that
+ * wants the latest blocks.
+ */
+typedef struct {
+    overview_config_t config; /**< Configuration with defaults applied. */
+    size_t entrySize;         /**< Size of an `overview_entry_t` with its values. */
+
+    float *pScratch;          /**< Writer: frames converted to f32, NULL for f32 input. */
+    overview_entry_t *pEntry; /**< Writer: the block being reduced. */
+    uint32_t blockFill;       /**< Writer: frames in `pEntry`. */
+    uint64_t blockIndex;      /**< Writer: index of `pEntry`. */
+    atomic_bool isFinished;   /**< No more frames are accepted. */
+
+    ma_rb tap;                 /**< Completed blocks on their way to the pyramid. */
+    atomic_uint droppedBlocks; /**< Blocks lost because the tap was full. */
+    atomic_bool isSelfDraining; /**< The writer drains a full tap itself, see `overview_set_self_draining`. */
+
+    overview_level_t levels[OVERVIEW_MAX_LEVELS]; /**< The pyramid, finest level first. */
+    uint32_t levelCount;                          /**< Levels with at least one entry. */
+    uint64_t frameCount;                          /**< Frames covered by the finest level. */
+    overview_entry_t *pDrained;                   /**< Entry read from the tap. */
+    float *pCombined;                             /**< Scratch entry for the coarser levels. */
+
+    pthread_t thread;      /**< Background thread. */
+    pthread_mutex_t mutex; /**< Protects the pyramid and the wake-up condition. */
+    pthread_cond_t cond;   /**< Signalled on stop. */
+    atomic_bool stop;      /**< Asks the background thread to exit. */
+} overview_t;
+
+/**
+ * @brief Sets whether the writer drains a full tap itself or drops the block.
+ *
+ * Draining takes the mutex and grows the pyramid, so it is only enabled,
+ * the default, for writers that may block and allocate, such as an encoder
+ * running faster than real time. `playback_device_set_overview` disables it
+ * for the audio thread.
+ *
+ * @param self Pointer to the overview.
+ * @param isSelfDraining Whether the writer drains a full tap.
+ */
+void overview_set_self_draining(overview_t *self, bool isSelfDraining);
+
+#endif  // OVERVIEW_PRIVATE_H
@@ -34,11 +34,231 @@ typedef struct {
     uint32_t sizeInBytes; /**< Size of the audio data in bytes. */
 } playback_data_t;
 
+/**
+ * @brief Maximum number of channels a playback meter measures.
+ */
+#define PLAYBACK_METER_MAX_CHANNELS 8
+
+/**
+ * @struct playback_meter_t
+ * @brief Levels of the audio a playback device actually output.
+ *
+ * Levels are linear amplitudes relative to full scale (1.0 = 0 dBFS) and
+ * loudness values are in LUFS, `-INFINITY` below the -70 LUFS absolute gate
+ * of EBU R128. Peaks fall back by
+ * 20 dB in 1.7 s, as on a peak programme meter, so a reader polling at UI
+ * frame rate does not miss short peaks.
+ */
+typedef struct {
+    uint32_t channels;                          /**< Number of measured channels. */
+    float peak[PLAYBACK_METER_MAX_CHANNELS];     /**< Sample peak per channel. */
+    float rms[PLAYBACK_METER_MAX_CHANNELS];      /**< RMS per channel, 300 ms time constant. */
+    float truePeak[PLAYBACK_METER_MAX_CHANNELS]; /**< 4x oversampled peak per channel (ITU-R BS.1770). */
+    float momentaryLoudness;                    /**< EBU R128 momentary loudness, 400 ms window. */
+    float shortTermLoudness;                    /**< EBU R128 short-term loudness, 3 s window. */
+    uint64_t framesMetered;                     /**< Frames measured since metering was enabled. */
+} playback_meter_t;
+
+/**
+ * @enum spectrum_window_t
+ * @brief Window applied to each block before the FFT.
+ */
+typedef enum {
+    spectrum_window_rectangular = 0,    /**< No window: best resolution, most leakage. */
+    spectrum_window_hann = 1,           /**< Good general-purpose window. */
+    spectrum_window_hamming = 2,        /**< Lower first side lobe than Hann. */
+    spectrum_window_blackman_harris = 3 /**< 4-term window with very low leakage. */
+} spectrum_window_t;
+
+/**
+ * @struct spectrum_config_t
+ * @brief Configuration of the spectrum analyzer of a playback device.
+ */
+typedef struct {
+    uint32_t fftSize;         /**< Power of two from 64 to 16384. 0 selects 2048. */
+    uint32_t hopSize;         /**< Frames between analyses. 0 selects `fftSize / 2`. */
+    spectrum_window_t window; /**< Window applied before the FFT. */
+    float smoothing;          /**< 0 to 1, weight of the previous magnitudes, as in Web Audio. */
+} spectrum_config_t;
+
+/**
+ * @brief Maximum number of stages of a playback DSP chain.
+ */
+#define PLAYBACK_DSP_MAX_STAGES 16
+
+/**
+ * @brief Largest linear gain accepted by `playback_device_set_volume` (+12 dB).
+ */
+#define PLAYBACK_VOLUME_MAX 4.0f
+
+/**
+ * @enum playback_dsp_type_t
+ * @brief Kinds of stages of a playback DSP chain.
+ */
+typedef enum {
+    playback_dsp_biquad = 0,    /**< Biquad with explicit `coefficients`. */
+    playback_dsp_lowpass = 1,   /**< Butterworth low-pass of `order` at `frequency`. */
+    playback_dsp_highpass = 2,  /**< Butterworth high-pass of `order` at `frequency`. */
+    playback_dsp_bandpass = 3,  /**< Band-pass of `order` centered on `frequency`. */
+    playback_dsp_notch = 4,     /**< Notch of quality `q` at `frequency`. */
+    playback_dsp_peaking = 5,   /**< Peaking EQ of `gainDb` and quality `q` at `frequency`. */
+    playback_dsp_lowshelf = 6,  /**< Low shelf of `gainDb` and slope `q` below `frequency`. */
+    playback_dsp_highshelf = 7, /**< High shelf of `gainDb` and slope `q` above `frequency`. */
+    playback_dsp_delay = 8,     /**< Feedback delay of `delayFrames` with `decay`, `wet` and `dry`. */
+    playback_dsp_gain = 9       /**< Gain of `gainDb`, ramped over `smoothFrames`. */
+} playback_dsp_type_t;
+
+/**
+ * @struct playback_dsp_stage_t
+ * @brief One stage of a playback DSP chain.
+ *
+ * Only the fields listed for the stage type are used.
+ */
+typedef struct {
+    playback_dsp_type_t type; /**< Kind of stage. */
+    uint32_t order;           /**< Filter order, 1 to 8 (even for band-pass). 0 selects 2. */
+    double frequency;         /**< Cutoff or center frequency in Hertz. */
+    double q;                 /**< Quality of notch and peaking filters, slope of shelves. */
+    double gainDb;            /**< Gain of peaking, shelf and gain stages in dB. */
+    uint32_t delayFrames;     /**< Length of a delay in frames. */
+    float decay;              /**< Feedback of a delay, 0 to below 1. */
+    float wet;                /**< Level of the delayed signal. */
+    float dry;                /**< Level of the direct signal. */
+    uint32_t smoothFrames;    /**< Length of the gain ramp in frames. */
+    double coefficients[6];   /**< Biquad `b0`, `b1`, `b2`, `a0`, `a1`, `a2`. */
+} playback_dsp_stage_t;
+
+/**
+ * @struct playback_reference_block_t
+ * @brief Timing of a block of output frames exported by the reference tap.
+ *
+ * A block holds the frames of one data callback, exactly as written to the
+ * device. Times are on the monotonic clock (`CLOCK_MONOTONIC`), the one
+ * capture timestamps of an echo canceller are usually taken on.
+ */
+typedef struct {
+    uint64_t framePosition;  /**< Index of the first frame among all frames output since the tap was set. */
+    uint64_t timestampNs;    /**< Time the data callback started, in nanoseconds. */
+    uint64_t presentationNs; /**< Estimated time the first frame reaches the speaker: `timestampNs` plus the latency. */
+    uint32_t latencyFrames;  /**< Estimated frames between the data callback and the speaker. */
+    uint32_t frameCount;     /**< Number of frames in the block. */
+    uint32_t droppedFrames;  /**< Frames lost right before this block because the consumer fell behind. */
+} playback_reference_block_t;
+
+/**
+ * @struct playback_silence_config_t
+ * @brief Configuration of the silence detector of a playback device.
+ */
+typedef struct {
+    float thresholdDb;        /**< Peak level in dBFS below which a block is quiet. 0 selects -60. */
+    float noiseFloorMarginDb; /**< When above 0, a block is also quiet if its peak is within this margin above the noise floor. */
+    uint32_t holdMs;          /**< Quiet time before the output counts as silent, so that word endings are kept. */
+    bool skipProcessing;      /**< Bypass the DSP chain while silent. */
+    bool compactRecording;    /**< Record silent blocks as gaps with `encoder_write_gap` instead of encoding them. */
+} playback_silence_config_t;
+
+/**
+ * @struct playback_silence_stats_t
+ * @brief What the silence detector of a playback device measured.
+ */
+typedef struct {
+    bool isSilent;         /**< Whether the last block was silent. */
+    float levelDb;         /**< Peak of the last block in dBFS. */
+    float noiseFloorDb;    /**< Estimated RMS noise floor in dBFS. */
+    uint64_t totalFrames;  /**< Frames analyzed since the detector was set. */
+    uint64_t silentFrames; /**< Frames classified as silent; divided by `totalFrames` gives the silent fraction. */
+} playback_silence_stats_t;
+
+/**
+ * @struct playback_migration_t
+ * @brief How a playback device moved to another output, see `playback_device_migrate`.
+ */
+typedef struct {
+    uint64_t openNs;        /**< Time spent opening the new device while the old one kept playing. */
+    uint64_t switchNs;      /**< Time from stopping the old device to starting the new one. */
+    uint32_t bufferedBytes; /**< Bytes queued in the ring buffer when the new device took over. */
+} playback_migration_t;
+
+/**
+ * @enum playback_interruption_mode_t
+ * @brief What a playback device does with the ring buffer during an interruption.
+ */
+typedef enum {
+    playback_interruption_ignore = 0,        /**< Keep consuming as if nothing happened, the default. */
+    playback_interruption_resume_paused = 1, /**< Freeze; resume with the first frame not played. */
+    playback_interruption_resume_latest = 2  /**< Freeze; resume with the latest frames, dropping older ones. */
+} playback_interruption_mode_t;
+
+/**
+ * @struct playback_interruption_policy_t
+ * @brief How a playback device handles interruptions.
+ */
+typedef struct {
+    playback_interruption_mode_t mode; /**< What happens to consumption and to the ring buffer. */
+    bool backpressure;                 /**< While frozen, pushes that do not fit are cut short instead of dropping queued frames. */
+} playback_interruption_policy_t;
+
+/**
+ * @struct playback_interruption_stats_t
+ * @brief Interruptions seen by a playback device.
+ */
+typedef struct {
+    bool isInterrupted;         /**< An interruption began and has not ended. */
+    uint32_t interruptionCount; /**< Interruptions since the device was created. */
+    uint32_t droppedBytes;      /**< Bytes dropped when the last interruption ended, with `playback_interruption_resume_latest`. */
+    uint64_t resumeLatencyNs;   /**< From the end of the last interruption to its first audible frame, 0 until it played. */
+} playback_interruption_stats_t;
+
+/**
+ * @enum playback_event_type_t
+ * @brief Kinds of events posted by a playback device.
+ */
+typedef enum {
+    playback_event_need_data = 0,            /**< The ring buffer fell below the low watermark. */
+    playback_event_underrun = 1,             /**< The ring buffer ran dry and silence was output. */
+    playback_event_state_changed = 2,        /**< The device started or stopped. */
+    playback_event_rerouted = 3,             /**< The device was moved to another output. */
+    playback_event_closed = 4,               /**< Last event before the callback is released. */
+    playback_event_interruption_began = 5,   /**< The system took the output away, e.g. for a call. */
+    playback_event_interruption_ended = 6    /**< The output is back, see `playback_interruption_policy_t`. */
+} playback_event_type_t;
+
+/**
+ * @brief Receives an event from a playback device.
+ *
+ * Called on the dispatcher thread of the device, never on the audio thread,
+ * in the order the events were posted. Events are edge-triggered: a
+ * `playback_event_need_data` is posted once per push while the ring buffer
+ * stays low, and a `playback_event_underrun` once each time playback runs
+ * dry after having had data.
+ *
+ * @param pUserData The user data passed to `playback_device_set_event_callback`.
+ * @param type The event type.
+ * @param state The device state when the event was posted.
+ * @param availableBytes The bytes queued in the ring buffer when the event was posted.
+ */
+typedef void (*playback_event_callback_t)(void *pUserData,
+                                          playback_event_type_t type,
+                                          device_state_t state,
+                                          uint32_t availableBytes);
+
+/**
+ * @brief Receives the outcome of `playback_device_start_async` or `playback_device_stop_async`.
+ *
+ * Called on the worker thread of the context.
+ *
+ * @param pUserData The user data passed with the request.
+ * @param isSuccess Whether the device reached the requested state.
+ * @param state The state of the device after the transition.
+ */
+typedef void (*playback_transition_callback_t)(void *pUserData, bool isSuccess, device_state_t state);
+
 /**
  * @brief Creates a playback device with the specified parameters.
  *
  * Initializes a playback device for audio output with the given configuration.
- * Allocates internal buffers for audio processing.
+ * Allocates internal buffers for audio processing. The encoder records the
+ * frames as they are read, before the DSP chain and the volume are applied.
  *
  * @param pContext Pointer to the `audio_context_t` instance managing the audio devices.
  * @param pDeviceId Pointer to the device ID for the playback device.
@@ -87,24 +307,98 @@ void playback_device_start(void *self);
 /**
  * @brief Stops audio playback on the specified device.
  *
- * Halts playback and clears any pending audio data in the buffer.
+ * Halts the backend stream. Pending audio data stays in the buffer; use
+ * `playback_device_reset_buffer` to drop it, or `playback_device_pause` to
+ * keep the stream open.
  *
  * @param self Pointer to the playback device.
  */
 FFI_PLUGIN_EXPORT
 void playback_device_stop(void *self);
 
+/**
+ * @brief Starts a playback device on the worker thread of its context.
+ *
+ * Returns at once; some backends block in `ma_device_start` for a long
+ * time. `playback_device_get_state` does not block: it keeps reporting
+ * `device_state_stopped` while the request is queued, and
+ * `device_state_starting` only once the worker is in `ma_device_start`.
+ * Transitions run in the order they were requested, and
+ * `playback_device_destroy` and `playback_device_migrate` wait for the
+ * pending ones.
+ *
+ * @param self Pointer to the playback device.
+ * @param onComplete Receives the outcome, or NULL.
+ * @param pUserData User data for `onComplete`.
+ * @return `true` if the request was queued, `false` otherwise; `onComplete` is then never called.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_start_async(void *self, playback_transition_callback_t onComplete, void *pUserData);
+
+/**
+ * @brief Stops a playback device on the worker thread of its context.
+ *
+ * See `playback_device_start_async`.
+ *
+ * @param self Pointer to the playback device.
+ * @param onComplete Receives the outcome, or NULL.
+ * @param pUserData User data for `onComplete`.
+ * @return `true` if the request was queued, `false` otherwise; `onComplete` is then never called.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_stop_async(void *self, playback_transition_callback_t onComplete, void *pUserData);
+
+/**
+ * @brief Pauses playback without stopping the backend stream.
+ *
+ * The data callback keeps running but outputs silence and consumes
+ * nothing, so the buffer, or the attached data source, keeps its position
+ * and pushes keep filling the buffer. Silence while paused is not an
+ * underrun. Returns once no callback consumes any more, so the next frame
+ * played after `playback_device_resume` is the one that follows the last
+ * frame played.
+ *
+ * The pause is independent of the device state: a paused device stays
+ * paused across `playback_device_stop` and `playback_device_start`.
+ *
+ * @param self Pointer to the playback device.
+ */
+FFI_PLUGIN_EXPORT
+void playback_device_pause(void *self);
+
+/**
+ * @brief Resumes a paused device at the next callback.
+ *
+ * @param self Pointer to the playback device.
+ */
+FFI_PLUGIN_EXPORT
+void playback_device_resume(void *self);
+
+/**
+ * @brief Checks whether a device is paused.
+ *
+ * @param self Pointer to the playback device.
+ * @return `true` if the device is paused, `false` otherwise or if `self` is NULL.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_is_paused(void *self);
+
 /**
  * @brief Pushes audio data into the playback device's buffer.
  *
  * Adds the specified audio data to the device's internal buffer for playback.
  * The data is copied into the buffer, so the caller retains ownership of the original data.
  *
+ * When the buffer is full, the oldest queued frames are dropped to make room,
+ * unless the device is frozen with backpressure: the push is then cut short
+ * to the free space, and the caller pushes the rest later.
+ *
  * @param self Pointer to the playback device.
  * @param pData Pointer to a `playback_data_t` structure containing the audio data.
+ * @return The number of bytes written to the buffer, less than `pData->sizeInBytes` under backpressure, 0 on error.
  */
 FFI_PLUGIN_EXPORT
-void playback_device_push_buffer(void *self, playback_data_t *pData);
+uint32_t playback_device_push_buffer(void *self, playback_data_t *pData);
 
 /**
  * @brief Resets the playback device's internal buffer.
@@ -116,4 +410,387 @@ void playback_device_push_buffer(void *self, playback_data_t *pData);
 FFI_PLUGIN_EXPORT
 void playback_device_reset_buffer(void *self);
 
+/**
+ * @brief Resizes the ring buffer without stopping playback.
+ *
+ * The new ring is allocated on the calling thread, which also moves the
+ * queued data into it, keeping the newest bytes if it is smaller. The copy
+ * starts right after a callback returned, with the callback frozen, and the
+ * ring is swapped before the freeze ends, so playback continues with the
+ * next frame; only a callback that falls into the copy plays silence. The
+ * old ring is freed on the calling thread. Pushes wait for the resize.
+ *
+ * @param self Pointer to the playback device.
+ * @param sizeInBytes New size of the ring buffer in bytes, rounded down to whole frames. Must not be below `rbMaxThreshold`.
+ * @return `true` if the ring buffer was resized, `false` if a parameter is invalid or memory ran out.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_resize_buffer(void *self, size_t sizeInBytes);
+
+/**
+ * @brief Attaches a native data source that the device pulls audio from.
+ *
+ * While a source is attached the data callback reads frames straight from it
+ * into the output buffer, so audio generated natively (waveforms, waveform
+ * banks, decoders, ...) never crosses the FFI boundary. The ring buffer is
+ * bypassed but keeps its contents, and is used again once the source is
+ * detached. Reaching the end of a non-looping source outputs silence.
+ *
+ * The source must produce the device's PCM format, channel count and sample
+ * rate, and must not be read from other threads while attached. The call can
+ * be made while the device is running; when it returns, the previous source
+ * is no longer referenced by the audio thread and may be destroyed.
+ *
+ * @param self Pointer to the playback device.
+ * @param pDataSource Pointer to a `ma_data_source` (e.g. a waveform), or NULL to detach.
+ * @return `true` if the source was attached, `false` if the formats do not match.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_attach_source(void *self, void *pDataSource);
+
+/**
+ * @brief Detaches the current data source and returns to ring buffer playback.
+ *
+ * Equivalent to `playback_device_attach_source(self, NULL)`.
+ *
+ * @param self Pointer to the playback device.
+ */
+FFI_PLUGIN_EXPORT
+void playback_device_detach_source(void *self);
+
+/**
+ * @brief Delivers device events to a callback instead of polling.
+ *
+ * The audio thread and the device notification thread post events into a
+ * lock-free queue without blocking; a dispatcher thread owned by the device
+ * calls `onEvent`. The callback may therefore be a Dart
+ * `NativeCallable.listener`.
+ *
+ * Replacing or removing the callback, or destroying the device, delivers the
+ * events still queued followed by `playback_event_closed` to the previous
+ * callback, which is not called again afterwards.
+ *
+ * @param self Pointer to the playback device.
+ * @param lowWatermarkBytes Fill level below which `playback_event_need_data` is posted. 0 selects `rbMaxThreshold`.
+ * @param onEvent The callback, or NULL to stop delivering events.
+ * @param pUserData User data passed to `onEvent`.
+ * @return `true` on success, `false` if the dispatcher thread could not be started.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_set_event_callback(void *self,
+                                        size_t lowWatermarkBytes,
+                                        playback_event_callback_t onEvent,
+                                        void *pUserData);
+
+/**
+ * @brief Enables or disables metering of the output.
+ *
+ * While enabled, the data callback measures every frame written to the
+ * output, whether it came from the ring buffer, an attached source or is
+ * silence, and publishes the levels for `playback_device_get_meter`.
+ * Enabling a disabled meter resets the levels.
+ *
+ * @param self Pointer to the playback device.
+ * @param enabled Whether to meter the output.
+ * @return `true` on success, `false` if the device has more than
+ *         `PLAYBACK_METER_MAX_CHANNELS` channels or memory ran out.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_set_metering_enabled(void *self, bool enabled);
+
+/**
+ * @brief Reads the latest levels without locking.
+ *
+ * The levels are published through a sequence lock: the call never blocks
+ * the audio thread and retries only if it raced with an update. Cheap enough
+ * to be called every UI frame.
+ *
+ * @param self Pointer to the playback device.
+ * @param pMeter Pointer to the structure that receives the levels.
+ * @return `true` if metering is enabled, `false` otherwise.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_get_meter(void *self, playback_meter_t *pMeter);
+
+/**
+ * @brief Starts or stops the spectrum analyzer of the output.
+ *
+ * While running, the data callback copies every output frame into a tap,
+ * which costs one copy. A worker thread downmixes the tap to mono, applies
+ * the window, runs a real FFT every `hopSize` frames and publishes
+ * `fftSize / 2 + 1` magnitude bins for `playback_device_get_spectrum`.
+ * Magnitudes are linear and scaled so that a full-scale sine reads 1.0.
+ *
+ * Starting an analyzer that is already running restarts it with the new
+ * configuration.
+ *
+ * @param self Pointer to the playback device.
+ * @param pConfig Pointer to the configuration, or NULL to stop the analyzer.
+ * @return `true` on success, `false` if the configuration is invalid or the worker could not start.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_set_spectrum(void *self, const spectrum_config_t *pConfig);
+
+/**
+ * @brief Copies the latest magnitude bins without locking.
+ *
+ * The bins are double-buffered: the worker fills one buffer while readers
+ * copy the other. Must not be called concurrently with
+ * `playback_device_set_spectrum`.
+ *
+ * @param self Pointer to the playback device.
+ * @param pBins Pointer to the array that receives the bins.
+ * @param binCount The capacity of `pBins`.
+ * @param pSequence Optional, receives the number of analyses so far, so unchanged spectra can be skipped.
+ * @return The number of bins copied, 0 if the analyzer is stopped or has not produced a spectrum yet.
+ */
+FFI_PLUGIN_EXPORT
+uint32_t playback_device_get_spectrum(void *self, float *pBins, uint32_t binCount, uint64_t *pSequence);
+
+/**
+ * @brief Sets the DSP chain applied to the output.
+ *
+ * Stages run in order, in place, inside the data callback, before metering
+ * and analysis see the output. The encoder records the frames before them. They are built from miniaudio
+ * filters whose heaps are allocated here, in a single block, so processing
+ * never allocates. Frames are processed in 32-bit float; other device
+ * formats are converted in slices through a preallocated buffer.
+ *
+ * Replacing the chain resets the filter states. Use
+ * `playback_device_update_dsp_stage` to change parameters smoothly.
+ *
+ * @param self Pointer to the playback device.
+ * @param pStages Pointer to the stages, or NULL to remove the chain.
+ * @param stageCount The number of stages, at most `PLAYBACK_DSP_MAX_STAGES`.
+ * @return `true` on success, `false` if a stage is invalid or memory ran out.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_set_dsp_chain(void *self, const playback_dsp_stage_t *pStages, uint32_t stageCount);
+
+/**
+ * @brief Changes the parameters of a stage of the DSP chain at runtime.
+ *
+ * The update is validated, then posted through a lock-free queue that the
+ * data callback drains before processing, so neither side blocks or
+ * allocates. The filter state is kept, which avoids clicks. The stage type,
+ * the filter order and the delay length cannot change; set a new chain for
+ * that.
+ *
+ * @param self Pointer to the playback device.
+ * @param stageIndex The index of the stage in the chain.
+ * @param pStage Pointer to the new parameters.
+ * @return `true` if the update was queued, `false` if it is invalid or the queue is full.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_update_dsp_stage(void *self, uint32_t stageIndex, const playback_dsp_stage_t *pStage);
+
+/**
+ * @brief Sets the linear gain applied to the output.
+ *
+ * The gain is applied in the data callback, after the DSP chain and before
+ * metering and analysis taps; the encoder records the frames before it. A change ramps smoothly over about
+ * 10 ms, so it never clicks, and never stops or blocks the stream. Safe to
+ * call from any thread.
+ *
+ * @param self Pointer to the playback device.
+ * @param volume The gain, from 0 to `PLAYBACK_VOLUME_MAX`. 1 leaves the output untouched.
+ * @return `true` on success, `false` if `volume` is out of range.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_set_volume(void *self, float volume);
+
+/**
+ * @brief Retrieves the gain set with `playback_device_set_volume`.
+ *
+ * @param self Pointer to the playback device.
+ * @return The linear gain, 1 by default.
+ */
+FFI_PLUGIN_EXPORT
+float playback_device_get_volume(void *self);
+
+/**
+ * @brief Mutes or unmutes the output without stopping the device.
+ *
+ * The gain ramps to 0 or back to the volume like a volume change. The
+ * device keeps running and consuming its ring buffer or source while muted,
+ * so unmuting is immediate. Safe to call from any thread.
+ *
+ * @param self Pointer to the playback device.
+ * @param muted Whether to mute the output.
+ */
+FFI_PLUGIN_EXPORT
+void playback_device_set_muted(void *self, bool muted);
+
+/**
+ * @brief Tells whether the output is muted.
+ *
+ * @param self Pointer to the playback device.
+ * @return `true` if muted.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_is_muted(void *self);
+
+/**
+ * @brief Exports the output as the reference signal of an echo canceller.
+ *
+ * While set, the data callback writes every frame written to the output,
+ * after the DSP chain, volume and mute, into a lock-free ring together with
+ * the time of the callback and the estimated output latency. The latency
+ * covers the buffers of the backend and the resampler of the device; it
+ * does not include the latency of the hardware, which the backends do not
+ * report.
+ *
+ * A consumer on any single thread reads the blocks in place with
+ * `playback_device_acquire_reference` and `playback_device_release_reference`.
+ * When it falls behind, whole blocks are dropped; `framePosition` and
+ * `droppedFrames` of the next block tell how many.
+ *
+ * @param self Pointer to the playback device.
+ * @param capacityFrames Frames the ring holds, or 0 to remove the tap.
+ * @return `true` on success, `false` if memory ran out.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_set_reference_tap(void *self, uint32_t capacityFrames);
+
+/**
+ * @brief Returns the oldest block of the reference tap, without copying.
+ *
+ * The frames are in the format and channel count of the device and stay
+ * valid until `playback_device_release_reference`. Calling again before
+ * releasing returns the same block. Must not race with
+ * `playback_device_set_reference_tap`.
+ *
+ * @param self Pointer to the playback device.
+ * @param pBlock Pointer to the structure that receives the timing of the block.
+ * @return A pointer to the interleaved frames, or NULL if no block is ready or no tap is set.
+ */
+FFI_PLUGIN_EXPORT
+const void *playback_device_acquire_reference(void *self, playback_reference_block_t *pBlock);
+
+/**
+ * @brief Releases the block returned by `playback_device_acquire_reference`.
+ *
+ * @param self Pointer to the playback device.
+ */
+FFI_PLUGIN_EXPORT
+void playback_device_release_reference(void *self);
+
+/**
+ * @brief Detects silence in the frames the device consumes.
+ *
+ * The data callback measures each block right after reading it from the
+ * ring buffer or source, with vectorized peak and RMS kernels, and tracks
+ * the noise floor. A block is silent once the output stayed quiet for
+ * `holdMs`. Silent blocks can skip the DSP chain and, for a device created
+ * with an encoder, be recorded as gaps so silent stretches take no space
+ * in the file. Metering, analysis taps and the output itself are not
+ * affected.
+ *
+ * @param self Pointer to the playback device.
+ * @param pConfig Pointer to the detector configuration, or NULL to remove the detector.
+ * @return `true` on success, `false` if memory ran out.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_set_silence_detection(void *self, const playback_silence_config_t *pConfig);
+
+/**
+ * @brief Reads what the silence detector measured, without locking.
+ *
+ * @param self Pointer to the playback device.
+ * @param pStats Pointer to the structure that receives the statistics.
+ * @return `true` if silence detection is enabled, `false` otherwise.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_get_silence_stats(void *self, playback_silence_stats_t *pStats);
+
+/**
+ * @brief Feeds the output into a waveform overview, see `overview_create`.
+ *
+ * The data callback writes every output frame into the overview, which only
+ * reduces it to a minimum and maximum per block. The overview must have the
+ * PCM format and channel count of the device and stays owned by the caller;
+ * once this function returns, the previous overview is no longer written to.
+ *
+ * @param self Pointer to the playback device.
+ * @param pOverview Pointer to the overview, or NULL to detach it.
+ * @return `true` on success, `false` if the overview format does not match the device.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_set_overview(void *self, void *pOverview);
+
+/**
+ * @brief Moves playback to another output without losing buffered audio.
+ *
+ * Opens the new device while the old one keeps playing, then stops the old
+ * device, hands the ring buffer, the attached source and every processing
+ * stage over to the new one, and starts it if the old one was started.
+ * Playback resumes with the frame after the last one the old device
+ * consumed. Use it on `playback_event_rerouted` or when the default device
+ * changes, instead of destroying and recreating the device.
+ *
+ * The new device must resolve to the sample format, channel count and
+ * sample rate of the old one; otherwise nothing changes. If the new device
+ * fails to start, playback goes back to the old device and the call can be
+ * retried. State events are not posted for the switch itself, and calls
+ * that use the device, such as `playback_device_get_state`, wait for it.
+ *
+ * @param self Pointer to the playback device.
+ * @param pDeviceId Pointer to the ID of the new device, or NULL for the default device.
+ * @param pResult Pointer to the structure that receives the timings, or NULL.
+ * @return `true` on success, `false` if the new device failed to open, does not match or failed to start.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_migrate(void *self, device_id *pDeviceId, playback_migration_t *pResult);
+
+/**
+ * @brief Sets how a playback device handles interruptions.
+ *
+ * An interruption begins and ends with the notifications of the backend,
+ * or with `playback_device_begin_interruption` and
+ * `playback_device_end_interruption` on platforms that report them
+ * elsewhere. Unless the mode is `playback_interruption_ignore`, the data
+ * callback stops consuming while interrupted and outputs silence, so the
+ * producer can keep pushing without the audio being lost. With
+ * `backpressure`, pushes stop at the free space of the ring buffer instead
+ * of dropping the oldest frames; `playback_event_interruption_began` tells
+ * the producer to slow down.
+ *
+ * When the interruption ends, `playback_interruption_resume_paused` plays
+ * on from the frame where consumption froze, while
+ * `playback_interruption_resume_latest` first drops all but the newest
+ * `rbMaxThreshold` bytes, so the listener does not hear stale audio.
+ *
+ * @param self Pointer to the playback device.
+ * @param pPolicy Pointer to the policy, or NULL to ignore interruptions.
+ * @return `true` on success, `false` if a parameter is invalid.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_set_interruption_policy(void *self, const playback_interruption_policy_t *pPolicy);
+
+/**
+ * @brief Retrieves the interruptions seen by a playback device.
+ *
+ * @param self Pointer to the playback device.
+ * @param pStats Pointer to the structure that receives the statistics.
+ * @return `true` on success, `false` if a parameter is NULL.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_device_get_interruption_stats(void *self, playback_interruption_stats_t *pStats);
+
+/**
+ * @brief Begins an interruption reported by the platform rather than the backend.
+ *
+ * @param self Pointer to the playback device.
+ */
+FFI_PLUGIN_EXPORT
+void playback_device_begin_interruption(void *self);
+
+/**
+ * @brief Ends an interruption begun with `playback_device_begin_interruption`.
+ *
+ * @param self Pointer to the playback device.
+ */
+FFI_PLUGIN_EXPORT
+void playback_device_end_interruption(void *self);
+
 #endif  // PLAYBACK_DEVICE_H
@@ -1,9 +1,18 @@
 #ifndef PLAYBACK_DEVICE_PRIVATE_H
 #define PLAYBACK_DEVICE_PRIVATE_H
 
+#include <stdatomic.h>
+
 #include "audio_device.h"
+#include "dsp_chain.h"
+#include "event_channel.h"
+#include "meter.h"
 #include "miniaudio.h"
 #include "playback_device.h"
+#include "reference_tap.h"
+#include "silence_detector.h"
+#include "spectrum.h"
+#include "volume.h"
 
 /**
  * @struct playback_device_t
@@ -15,10 +24,63 @@
 typedef struct {
     audio_device_t base;      /**< Base audio device structure. */
     playback_config_t config; /**< Configuration for the playback device. */
-    ma_device device;         /**< Miniaudio device for handling playback. */
-    ma_rb rb;                 /**< Ring buffer for managing audio data. */
+    _Atomic(ma_device *) pDevice; /**< Miniaudio device for handling playback, replaced by a migration. */
+    _Atomic(ma_rb *) pRb;     /**< Ring buffer for managing audio data, replaced by a resize. */
     bool isReadingEnabled;    /**< Indicates whether the playback device can read from the buffer. */
     void *encoder;            /**< Pointer to the encoder instance. */
+
+    _Atomic(ma_data_source *) pSource; /**< Data source pulled by the callback instead of the ring buffer, or NULL. */
+    atomic_uint callbackEpoch;         /**< Incremented on entry to and exit from the data callback; odd while it runs. */
+
+    pthread_mutex_t rbMutex;     /**< Serializes the writers of the ring buffer: pushes, resets and resizes. */
+    atomic_bool isResizing;      /**< The callback leaves the ring buffer alone while a resize moves it. */
+
+    event_channel_t events;        /**< Delivers events to the callback set with `playback_device_set_event_callback`. */
+    size_t lowWatermark;           /**< Fill level below which `playback_event_need_data` is posted. */
+    atomic_bool isNeedDataArmed;   /**< A push happened since the last `playback_event_need_data`. */
+    bool isStarved;                /**< The last ring buffer read came up short. Audio thread only. */
+    atomic_bool isMigrating;       /**< State notifications belong to a migration and are not posted. */
+    pthread_rwlock_t deviceLock;   /**< Read-held by the API calls that use `pDevice`, write-held by a migration. */
+
+    atomic_int interruptionMode;         /**< `playback_interruption_mode_t` of the policy. */
+    atomic_bool hasBackpressure;         /**< Pushes are cut short while frozen. */
+    atomic_bool isInterrupted;           /**< An interruption began and has not ended. */
+    atomic_bool isSkipPending;           /**< The audio thread drops stale frames before it resumes. */
+    atomic_bool isResumePending;         /**< The audio thread has not played since the interruption ended. */
+    _Atomic(uint64_t) interruptionEndNs; /**< When the last interruption ended. */
+    _Atomic(uint64_t) resumeLatencyNs;   /**< From `interruptionEndNs` to the first audible frame. */
+    atomic_uint interruptionCount;       /**< Interruptions since the device was created. */
+    atomic_uint droppedBytes;            /**< Bytes dropped at the last resume. */
+
+    atomic_bool isPaused; /**< The callback outputs silence and keeps the ring buffer, see `playback_device_pause`. */
+
+    _Atomic(silence_detector_t *) pSilence; /**< Classifies the consumed blocks, or NULL. */
+
+    _Atomic(dsp_chain_t *) pDspChain; /**< Processing applied in place to the output, or NULL. */
+    pthread_mutex_t dspMutex;         /**< Serializes chain swaps and parameter updates. */
+
+    volume_t volume; /**< Volume and mute, applied after the DSP chain. */
+
+    meter_t *pMeter;        /**< Output meter, created when metering is first enabled. */
+    atomic_bool isMetering; /**< The data callback feeds `pMeter`. */
+
+    _Atomic(spectrum_t *) pSpectrum; /**< Spectrum analyzer fed by the data callback, or NULL. */
+
+    _Atomic(void *) pOverview; /**< Waveform overview fed by the data callback, or NULL. */
+
+    _Atomic(reference_tap_t *) pReferenceTap; /**< Echo canceller reference fed by the data callback, or NULL. */
 } playback_device_t;
 
+/**
+ * @brief Empties the ring buffer and resets the stream state without closing the device.
+ *
+ * Detaches the data source and the overview, releases every processing
+ * stage, restores unity gain, stops the event callback, resumes a paused
+ * device and resets the interruption policy. Used by the playback pool when
+ * a device is released.
+ *
+ * @param playback Pointer to the playback device.
+ */
+void playback_device_recycle(playback_device_t *playback);
+
 #endif  // PLAYBACK_DEVICE_PRIVATE_H
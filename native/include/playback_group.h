@@ -0,0 +1,136 @@
+#ifndef PLAYBACK_GROUP_H
+#define PLAYBACK_GROUP_H
+
+#include "audio_context.h"
+#include "audio_device.h"
+#include "platform.h"
+
+/**
+ * @brief Maximum number of outputs of a playback group.
+ */
+#define PLAYBACK_GROUP_MAX_OUTPUTS 8
+
+/**
+ * @brief Configuration of a playback group.
+ */
+typedef struct {
+    pcm_format_t pcmFormat;       /**< PCM format of the pushed frames, `pcm_format_s16` or `pcm_format_f32`. */
+    uint32_t channels;            /**< Number of channels. */
+    uint32_t sampleRate;          /**< Sample rate in Hertz. */
+    uint32_t capacityFrames;      /**< Frames the shared ring holds. 0 selects one second. */
+    uint32_t targetLatencyFrames; /**< Frames each output keeps queued. 0 selects 50 ms. */
+} playback_group_config_t;
+
+/**
+ * @brief State of one output of a playback group.
+ */
+typedef struct {
+    uint64_t framesPlayed;  /**< Frames output by the device, silence excluded. */
+    uint32_t queuedFrames;  /**< Frames pushed but not yet read by the output. */
+    uint32_t latencyFrames; /**< Estimated frames between the callback and the speaker. */
+    uint32_t underruns;     /**< Times the output ran out of frames. */
+    float ratio;            /**< Input frames consumed per output frame, 1 when in sync. */
+    float offsetFrames;     /**< Frames the output plays ahead of output 0, smoothed. */
+} playback_group_output_stats_t;
+
+/**
+ * @brief Creates a group that plays one stream on several devices in sync.
+ *
+ * Frames pushed with `playback_group_push` go into a single ring that every
+ * output reads at its own position, so the stream is stored once however
+ * many devices play it. Each device runs on its own clock; a drift-correcting
+ * resampler per output keeps the frames it has queued, plus the latency of
+ * the device, at `targetLatencyFrames`, which holds every output at the same
+ * distance behind the producer. The producer is held back by the slowest
+ * output.
+ *
+ * The group registers with the context like a device and is destroyed with it.
+ *
+ * @param pContext Pointer to the audio context.
+ * @param pConfig Pointer to the group configuration.
+ * @return A pointer to the group, or NULL if the creation failed.
+ */
+FFI_PLUGIN_EXPORT
+void *playback_group_create(void *pContext, playback_group_config_t *pConfig);
+
+/**
+ * @brief Destroys a group and its devices.
+ *
+ * @param self Pointer to the group.
+ */
+FFI_PLUGIN_EXPORT
+void playback_group_destroy(void *self);
+
+/**
+ * @brief Opens a device and adds it as an output of a stopped group.
+ *
+ * The device plays the format of the group; miniaudio converts it to the
+ * native format of the device.
+ *
+ * @param self Pointer to the group.
+ * @param pDeviceId Pointer to the device ID, or NULL for the default device.
+ * @return The index of the output, or -1 if the group is started, full, or the device failed to open.
+ */
+FFI_PLUGIN_EXPORT
+int32_t playback_group_add_output(void *self, device_id *pDeviceId);
+
+/**
+ * @brief Retrieves the number of outputs of a group.
+ *
+ * @param self Pointer to the group.
+ * @return The number of outputs.
+ */
+FFI_PLUGIN_EXPORT
+uint32_t playback_group_get_output_count(void *self);
+
+/**
+ * @brief Starts every output of a group.
+ *
+ * Each output stays silent until `targetLatencyFrames` are queued, then
+ * skips the frames its own latency already accounts for.
+ *
+ * @param self Pointer to the group.
+ */
+FFI_PLUGIN_EXPORT
+void playback_group_start(void *self);
+
+/**
+ * @brief Stops every output of a group. Queued frames are kept.
+ *
+ * @param self Pointer to the group.
+ */
+FFI_PLUGIN_EXPORT
+void playback_group_stop(void *self);
+
+/**
+ * @brief Retrieves the state of a group.
+ *
+ * @param self Pointer to the group.
+ * @return `device_state_started` or `device_state_stopped`.
+ */
+FFI_PLUGIN_EXPORT
+device_state_t playback_group_get_state(void *self);
+
+/**
+ * @brief Pushes frames to every output of a group. Never blocks.
+ *
+ * @param self Pointer to the group.
+ * @param pData Interleaved frames in the format of the group.
+ * @param sizeInBytes Size of `pData` in bytes.
+ * @return The bytes written, fewer than `sizeInBytes` when the slowest output is that far behind.
+ */
+FFI_PLUGIN_EXPORT
+uint32_t playback_group_push(void *self, const void *pData, uint32_t sizeInBytes);
+
+/**
+ * @brief Retrieves the state of one output of a group.
+ *
+ * @param self Pointer to the group.
+ * @param index Index of the output.
+ * @param pStats Pointer to the structure that receives the state.
+ * @return `true` on success, `false` if a parameter is invalid.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_group_get_output_stats(void *self, uint32_t index, playback_group_output_stats_t *pStats);
+
+#endif  // PLAYBACK_GROUP_H
@@ -0,0 +1,62 @@
+#ifndef PLAYBACK_GROUP_PRIVATE_H
+#define PLAYBACK_GROUP_PRIVATE_H
+
+#include <stdatomic.h>
+
+#include "audio_device.h"
+#include "miniaudio.h"
+#include "playback_group.h"
+
+/**
+ * @struct playback_group_output_t
+ * @brief One device of a playback group and the resampler that keeps it in sync.
+ *
+ * The audio thread of the device owns `resampler` and every field marked
+ * as such; it publishes `readPosition` with release semantics so the
+ * producer may reuse the frames behind it, and the stats with relaxed
+ * stores.
+ */
+typedef struct {
+    ma_device device;              /**< Device the output plays on. */
+    ma_linear_resampler resampler; /**< Stretches the stream to the clock of the device. */
+    void *pGroup;                  /**< Group the output belongs to. */
+
+    _Atomic(uint64_t) readPosition; /**< Frames of the stream consumed by the resampler. */
+
+    bool isPlaying;      /**< Audio thread: the target was reached since the last underrun. */
+    double smoothedFill; /**< Audio thread: queued frames plus latency, low-pass filtered. */
+    double ratio;        /**< Audio thread: ratio last given to the resampler. */
+
+    _Atomic(uint64_t) framesPlayed; /**< Frames output, silence excluded. */
+    atomic_uint queuedFrames;       /**< Frames queued at the last callback. */
+    atomic_uint latencyFrames;      /**< Estimated latency of the device. */
+    atomic_uint underruns;          /**< Times the output ran out of frames. */
+    _Atomic float publishedRatio;   /**< `ratio`, for readers. */
+    _Atomic float publishedFill;    /**< `smoothedFill`, for readers. */
+} playback_group_output_t;
+
+/**
+ * @struct playback_group_t
+ * @brief Fans one stream out to several devices, derived from `audio_device_t`.
+ *
+ * `pRing` holds `capacityFrames` frames indexed by absolute stream position
+ * modulo the capacity. The producer is the only writer of `writePosition`
+ * and each output the only writer of its `readPosition`, so the ring needs
+ * no lock: the producer may write up to the slowest output, and each output
+ * reads up to `writePosition`. Outputs are only added while the group is
+ * stopped, so the audio threads never see `outputs` change.
+ */
+typedef struct {
+    audio_device_t base;            /**< Base audio device structure. */
+    playback_group_config_t config; /**< Configuration, with defaults applied. */
+    uint32_t bytesPerFrame;         /**< Bytes per frame of the stream. */
+
+    uint8_t *pRing;                  /**< Frames shared by the outputs. */
+    _Atomic(uint64_t) writePosition; /**< Frames of the stream pushed. */
+
+    playback_group_output_t *outputs[PLAYBACK_GROUP_MAX_OUTPUTS]; /**< Outputs of the group. */
+    uint32_t outputCount;                                         /**< Number of outputs. */
+    bool isStarted;                                               /**< The outputs are started. */
+} playback_group_t;
+
+#endif  // PLAYBACK_GROUP_PRIVATE_H
@@ -0,0 +1,86 @@
+#ifndef PLAYBACK_POOL_H
+#define PLAYBACK_POOL_H
+
+#include "audio_device.h"
+#include "platform.h"
+#include "playback_device.h"
+
+/**
+ * @brief State of the playback pool of a context.
+ */
+typedef struct {
+    uint32_t idleDevices; /**< Started devices waiting in the pool. */
+    uint32_t lentDevices; /**< Devices acquired and not yet released. */
+    uint32_t hits;        /**< Acquisitions served by a warm device. */
+    uint32_t misses;      /**< Acquisitions that had to open a device. */
+} playback_pool_stats_t;
+
+/**
+ * @brief Opens and starts playback devices until `count` of them wait in the pool.
+ *
+ * `playback_device_create` initializes the backend stream and allocates the
+ * ring buffer, and `playback_device_start` waits for the stream to run,
+ * which together can take hundreds of milliseconds. Warming pays for both
+ * ahead of time: pooled devices run, outputting silence, until they are
+ * acquired, so pushed audio is heard within one period.
+ *
+ * Devices are keyed by device ID and configuration.
+ *
+ * @param pContext Pointer to the audio context.
+ * @param pDeviceId Pointer to the device ID, or NULL for the default device.
+ * @param pConfig Pointer to the playback configuration.
+ * @param count Number of idle devices wanted for this key.
+ * @return The number of idle devices for this key, fewer than `count` if a device failed to open.
+ */
+FFI_PLUGIN_EXPORT
+uint32_t playback_pool_warm(void *pContext, device_id *pDeviceId, playback_config_t *pConfig, uint32_t count);
+
+/**
+ * @brief Takes a started playback device from the pool.
+ *
+ * Opens and starts a device if none with the key is idle; it joins the
+ * pool when released.
+ *
+ * @param pContext Pointer to the audio context.
+ * @param pDeviceId Pointer to the device ID, or NULL for the default device.
+ * @param pConfig Pointer to the playback configuration.
+ * @return A pointer to the started playback device, or NULL if the creation failed.
+ */
+FFI_PLUGIN_EXPORT
+void *playback_pool_acquire(void *pContext, device_id *pDeviceId, playback_config_t *pConfig);
+
+/**
+ * @brief Returns an acquired playback device to the pool without closing its stream.
+ *
+ * The ring buffer is emptied, the data source and the overview detached,
+ * the processing stages released, the volume and mute reset, the event
+ * callback stopped and the interruption policy reset, then the device is
+ * restarted if it was stopped. The device returns to the pool under the
+ * output it plays to, which a migration may have changed. The caller must
+ * not use the device afterwards.
+ *
+ * @param self Pointer to the playback device.
+ * @return `true` on success, `false` if the device was not acquired from the pool.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_pool_release(void *self);
+
+/**
+ * @brief Destroys the idle devices of the pool.
+ *
+ * @param pContext Pointer to the audio context.
+ */
+FFI_PLUGIN_EXPORT
+void playback_pool_drain(void *pContext);
+
+/**
+ * @brief Retrieves the state of the playback pool of a context.
+ *
+ * @param pContext Pointer to the audio context.
+ * @param pStats Pointer to the structure that receives the state.
+ * @return `true` on success, `false` if a parameter is invalid.
+ */
+FFI_PLUGIN_EXPORT
+bool playback_pool_get_stats(void *pContext, playback_pool_stats_t *pStats);
+
+#endif  // PLAYBACK_POOL_H
@@ -0,0 +1,50 @@
+#ifndef PLAYBACK_POOL_PRIVATE_H
+#define PLAYBACK_POOL_PRIVATE_H
+
+#include "playback_pool.h"
+
+/**
+ * @struct playback_pool_entry_t
+ * @brief A device the pool opened, idle or lent, and the key it was opened with.
+ */
+typedef struct {
+    void *pDevice;            /**< The `playback_device_t`. */
+    bool isDefault;           /**< Opened on the default device; `id` is unused. */
+    device_id id;             /**< Device ID it was opened with. */
+    playback_config_t config; /**< Configuration it was opened with. */
+    bool isIdle;              /**< Waiting in the pool, as opposed to lent. */
+} playback_pool_entry_t;
+
+/**
+ * @struct playback_pool_t
+ * @brief Warm playback devices of a context.
+ *
+ * Tracks every device the pool opened. `playback_device_destroy` removes
+ * the entry of a device, so a lent device may also be destroyed instead of
+ * released.
+ */
+typedef struct {
+    pthread_mutex_t mutex;           /**< Protects every field below. */
+    playback_pool_entry_t *pEntries; /**< Devices opened by the pool. */
+    uint32_t count;                  /**< Number of `pEntries`. */
+    uint32_t capacity;               /**< Entries `pEntries` has room for. */
+    uint32_t hits;                   /**< Acquisitions served by an idle device. */
+    uint32_t misses;                 /**< Acquisitions that opened a device. */
+} playback_pool_t;
+
+/**
+ * @brief Initializes an empty pool.
+ */
+void playback_pool_init(playback_pool_t *self);
+
+/**
+ * @brief Removes the entry of a device being destroyed, if any.
+ */
+void playback_pool_forget(playback_pool_t *self, void *pDevice);
+
+/**
+ * @brief Releases the pool. The context destroys the devices themselves.
+ */
+void playback_pool_uninit(playback_pool_t *self);
+
+#endif  // PLAYBACK_POOL_PRIVATE_H
@@ -0,0 +1,79 @@
+#ifndef REFERENCE_TAP_H
+#define REFERENCE_TAP_H
+
+#include <stdatomic.h>
+
+#include "miniaudio.h"
+#include "playback_device.h"
+
+/**
+ * @struct reference_header_t
+ * @brief Header preceding each block in the ring of a reference tap.
+ */
+typedef struct {
+    playback_reference_block_t info; /**< Timing of the block, as exported. */
+    uint32_t blockSize;              /**< Bytes of header and frames, a multiple of 16. */
+    uint32_t isPadding;              /**< Fills the end of the ring; carries no frames. */
+} reference_header_t;
+
+/**
+ * @struct reference_tap_t
+ * @brief Exports the output frames with their timing, without copying twice.
+ *
+ * The audio thread writes each callback as one block, a header followed by
+ * the frames, into `ring`, a single-producer, single-consumer ring buffer.
+ * Blocks never wrap: when a block does not fit before the end of the ring,
+ * the writer fills the rest with a padding block, or with bytes too few to
+ * hold a header, which the reader skips. The consumer therefore reads the
+ * frames in place and releases the block when it is done.
+ */
+typedef struct {
+    ma_format format;       /**< Format of the tapped frames. */
+    uint32_t channels;      /**< Number of channels. */
+    uint32_t bytesPerFrame; /**< Bytes per tapped frame. */
+
+    ma_rb ring; /**< Blocks on their way to the consumer. */
+
+    uint64_t framePosition;    /**< Writer: frames output since the tap was created. */
+    uint32_t pendingDrops;     /**< Writer: frames lost since the last block written. */
+    atomic_uint droppedFrames; /**< Frames lost because the consumer fell behind. */
+
+    uint32_t acquiredSize; /**< Reader: bytes of the block held by the consumer, 0 if none. */
+} reference_tap_t;
+
+/**
+ * @brief Creates a tap that holds about `capacityFrames` frames.
+ *
+ * @return The tap, or NULL if memory ran out.
+ */
+reference_tap_t *reference_tap_create(ma_format format, uint32_t channels, uint32_t capacityFrames);
+
+/**
+ * @brief Writes the frames of one callback as a block. Never blocks; a block that does not fit is dropped.
+ */
+void reference_tap_write(reference_tap_t *self,
+                         const void *pFrames,
+                         uint32_t frameCount,
+                         uint64_t timestampNs,
+                         uint32_t latencyFrames,
+                         uint32_t sampleRate);
+
+/**
+ * @brief Returns the oldest block in place, or NULL if none is ready.
+ *
+ * The block stays valid until `reference_tap_release`. Acquiring again
+ * without releasing returns the same block.
+ */
+const void *reference_tap_acquire(reference_tap_t *self, playback_reference_block_t *pBlock);
+
+/**
+ * @brief Hands the acquired block back to the writer.
+ */
+void reference_tap_release(reference_tap_t *self);
+
+/**
+ * @brief Releases the tap.
+ */
+void reference_tap_destroy(reference_tap_t *self);
+
+#endif  // REFERENCE_TAP_H
@@ -0,0 +1,100 @@
+#ifndef SEGMENTER_H
+#define SEGMENTER_H
+
+#include <stdatomic.h>
+
+#include "encoder.h"
+#include "platform.h"
+
+/**
+ * @struct segment_t
+ * @brief One file of a segmented recording.
+ */
+typedef struct segment {
+    struct segment *pNext; /**< Next segment in the finished list. */
+    void *pEncoder;        /**< Encoder writing the file. */
+    uint32_t index;        /**< Segment index, part of the file name. */
+    uint64_t firstFrame;   /**< Position of the first frame in the recording. */
+    uint64_t frameCount;   /**< Frames written to the segment. */
+    char path[];           /**< Path of the file. */
+} segment_t;
+
+/**
+ * @struct segmenter_t
+ * @brief Rotates the frames of a recording through segment encoders.
+ *
+ * The writing thread owns `pCurrent`. The background thread owns everything
+ * else and talks to the writing thread through two lock-free hand-overs:
+ * `pReady`, a single slot holding the opened next segment, and `pFinished`,
+ * a stack of segments waiting to be finalized.
+ */
+typedef struct {
+    encoder_config_t config;                /**< Encoder configuration of every segment. */
+    encoder_segment_config_t segmentConfig; /**< Segmentation configuration. */
+    uint64_t segmentFrames;                 /**< Frames per segment derived from both limits. */
+    uint32_t bpf;                           /**< Bytes per written frame. */
+    char *pathPrefix;                       /**< Path of the files up to the index. */
+
+    encoder_segment_callback_t onSegment; /**< Receives completed segments. */
+    void *pUserData;                      /**< User data for `onSegment`. */
+
+    segment_t *pCurrent;            /**< Segment being written. */
+    _Atomic(segment_t *) pReady;    /**< Opened next segment, NULL until it is ready. */
+    _Atomic(segment_t *) pFinished; /**< Segments to finalize, newest first. */
+    uint32_t nextIndex;             /**< Index of the next segment to open. */
+
+    _Atomic(uint64_t) completedBytes; /**< Size of the finalized segments. */
+    _Atomic(uint64_t) currentBytes;   /**< Size of the current segment after the last write. */
+    atomic_uint lateRotations;        /**< Boundaries where the next segment was not ready. */
+
+    pthread_t thread;      /**< Background thread. */
+    pthread_mutex_t mutex; /**< Protects the wake-up condition. */
+    pthread_cond_t cond;   /**< Signalled on stop. */
+    atomic_bool stop;      /**< Set on finalize. */
+    bool isFinalized;      /**< The last segment was finalized. */
+} segmenter_t;
+
+/**
+ * @brief Opens the first segment and starts the background thread.
+ *
+ * @return The segmenter, or NULL on failure.
+ */
+segmenter_t *segmenter_create(const char *pathPrefix,
+                              const encoder_config_t *pConfig,
+                              const encoder_segment_config_t *pSegmentConfig,
+                              encoder_segment_callback_t onSegment,
+                              void *pUserData);
+
+/**
+ * @brief Writes frames, rotating to the next segment at the boundaries.
+ *
+ * @return The number of frames written.
+ */
+uint64_t segmenter_write_pcm_frames(segmenter_t *self, const void *pFrames, uint64_t frameCount);
+
+/**
+ * @brief Records a gap in the current segment, see `encoder_write_gap`.
+ *
+ * @return `frameCount`, or 0 if the segment could not record it.
+ */
+uint64_t segmenter_write_gap(segmenter_t *self, uint64_t frameCount);
+
+/**
+ * @brief Stops the background thread and finalizes every segment.
+ *
+ * Reports the current segment as the last one and deletes the file opened
+ * ahead for the next one. Does nothing when called again.
+ */
+void segmenter_finalize(segmenter_t *self);
+
+/**
+ * @brief Returns the size of the completed segments plus the current one.
+ */
+uint64_t segmenter_get_size_in_bytes(segmenter_t *self);
+
+/**
+ * @brief Finalizes the recording if needed and releases the segmenter.
+ */
+void segmenter_destroy(segmenter_t *self);
+
+#endif  // SEGMENTER_H
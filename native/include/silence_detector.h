@@ -0,0 +1,80 @@
+#ifndef SILENCE_DETECTOR_H
+#define SILENCE_DETECTOR_H
+
+#include <stdatomic.h>
+
+#include "miniaudio.h"
+#include "playback_device.h"
+
+/**
+ * @brief Samples converted to f32 at a time when the format is not f32.
+ */
+#define SILENCE_SLICE_SAMPLES 1024
+
+/**
+ * @brief Speed at which the noise floor follows a rising level, in dB per second.
+ */
+#define SILENCE_FLOOR_RISE_DB_PER_SECOND 6.0f
+
+/**
+ * @struct silence_detector_t
+ * @brief Classifies the blocks of the audio thread as silent or not.
+ *
+ * Each block is reduced to its peak and RMS over all channels with
+ * `simd_f32x4`. A block is quiet when its peak is below the threshold or,
+ * with a noise floor margin, within the margin above the tracked noise
+ * floor. The floor follows the RMS down at once and up slowly, like a
+ * minimum statistics estimator, so speech does not raise it. The output is
+ * silent once it was quiet for the hold time. Statistics are published in
+ * atomics for any thread to read.
+ */
+typedef struct {
+    ma_format format;    /**< Format of the analyzed frames. */
+    uint32_t channels;   /**< Number of channels. */
+    uint32_t sampleRate; /**< Sample rate in Hertz. */
+
+    playback_silence_config_t config; /**< Configuration, read by the data callback. */
+
+    float threshold;      /**< Linear peak below which a block is quiet. */
+    float floorMargin;    /**< Linear factor above the noise floor still quiet, 0 if disabled. */
+    uint32_t holdFrames;  /**< Quiet frames before the output counts as silent. */
+    float riseLnPerFrame; /**< Natural log of the noise floor rise per frame. */
+
+    float noiseFloor;     /**< Audio thread: tracked RMS noise floor, negative before the first block. */
+    uint64_t quietFrames; /**< Audio thread: frames since the last loud block. */
+
+    atomic_bool isSilent;           /**< Classification of the last block. */
+    _Atomic float level;            /**< Peak of the last block. */
+    _Atomic float published;        /**< `noiseFloor` for other threads. */
+    _Atomic(uint64_t) totalFrames;  /**< Frames analyzed. */
+    _Atomic(uint64_t) silentFrames; /**< Frames classified as silent. */
+} silence_detector_t;
+
+/**
+ * @brief Creates a detector with the thresholds of `pConfig`.
+ *
+ * @return The detector, or NULL if memory ran out.
+ */
+silence_detector_t *silence_detector_create(ma_format format,
+                                            uint32_t channels,
+                                            uint32_t sampleRate,
+                                            const playback_silence_config_t *pConfig);
+
+/**
+ * @brief Classifies interleaved frames. Never blocks or allocates.
+ *
+ * @return `true` if the output is silent.
+ */
+bool silence_detector_process(silence_detector_t *self, const void *pFrames, uint32_t frameCount);
+
+/**
+ * @brief Copies the latest statistics.
+ */
+void silence_detector_read(silence_detector_t *self, playback_silence_stats_t *pStats);
+
+/**
+ * @brief Releases the detector.
+ */
+void silence_detector_destroy(silence_detector_t *self);
+
+#endif  // SILENCE_DETECTOR_H
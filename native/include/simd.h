@@ -0,0 +1,190 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <stdint.h>
+
+/**
+ * Internal SIMD helpers shared by the DSP kernels.
+ *
+ * `simd_f32x4` is a 4-lane float vector backed by SSE2 on x86, NEON on ARM
+ * and a plain struct everywhere else, so kernels written against it compile
+ * to the baseline instruction set of every supported target. Wider kernels
+ * (AVX2) are compiled separately behind `SIMD_HAVE_AVX2_TARGET` and selected
+ * at runtime with `simd_get_level`.
+ */
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SIMD_SSE2
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+    #define SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define SIMD_HAVE_AVX2_TARGET
+    #define SIMD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #include <immintrin.h>
+#endif
+
+/**
+ * @enum simd_level_t
+ * @brief Instruction set levels the kernels can be dispatched to.
+ */
+typedef enum {
+    simd_level_scalar, /**< No vector unit, plain C. */
+    simd_level_sse2,   /**< x86 SSE2 (4 lanes). */
+    simd_level_avx2,   /**< x86 AVX2 + FMA (8 lanes). */
+    simd_level_neon    /**< ARM NEON (4 lanes). */
+} simd_level_t;
+
+/**
+ * @brief Returns the best instruction set level supported by the running CPU.
+ *
+ * The result is detected once and cached.
+ */
+simd_level_t simd_get_level(void);
+
+/**
+ * @brief Returns a string representation of a `simd_level_t` value.
+ */
+const char *describe_simd_level(simd_level_t level);
+
+#if defined(SIMD_SSE2)
+
+typedef __m128 simd_f32x4;
+
+static inline simd_f32x4 simd_f32x4_load(const float *p) { return _mm_loadu_ps(p); }
+static inline void simd_f32x4_store(float *p, simd_f32x4 a) { _mm_storeu_ps(p, a); }
+static inline simd_f32x4 simd_f32x4_set1(float x) { return _mm_set1_ps(x); }
+static inline simd_f32x4 simd_f32x4_set(float a, float b, float c, float d) { return _mm_setr_ps(a, b, c, d); }
+static inline simd_f32x4 simd_f32x4_add(simd_f32x4 a, simd_f32x4 b) { return _mm_add_ps(a, b); }
+static inline simd_f32x4 simd_f32x4_sub(simd_f32x4 a, simd_f32x4 b) { return _mm_sub_ps(a, b); }
+static inline simd_f32x4 simd_f32x4_mul(simd_f32x4 a, simd_f32x4 b) { return _mm_mul_ps(a, b); }
+static inline simd_f32x4 simd_f32x4_min(simd_f32x4 a, simd_f32x4 b) { return _mm_min_ps(a, b); }
+static inline simd_f32x4 simd_f32x4_max(simd_f32x4 a, simd_f32x4 b) { return _mm_max_ps(a, b); }
+static inline simd_f32x4 simd_f32x4_and(simd_f32x4 a, simd_f32x4 b) { return _mm_and_ps(a, b); }
+static inline simd_f32x4 simd_f32x4_xor(simd_f32x4 a, simd_f32x4 b) { return _mm_xor_ps(a, b); }
+static inline simd_f32x4 simd_f32x4_abs(simd_f32x4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+static inline simd_f32x4 simd_f32x4_cmplt(simd_f32x4 a, simd_f32x4 b) { return _mm_cmplt_ps(a, b); }
+static inline simd_f32x4 simd_f32x4_select(simd_f32x4 mask, simd_f32x4 a, simd_f32x4 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+static inline simd_f32x4 simd_f32x4_floor(simd_f32x4 a) {
+    simd_f32x4 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+    return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a), _mm_set1_ps(1.0f)));
+}
+
+#elif defined(SIMD_NEON)
+
+typedef float32x4_t simd_f32x4;
+
+static inline simd_f32x4 simd_f32x4_load(const float *p) { return vld1q_f32(p); }
+static inline void simd_f32x4_store(float *p, simd_f32x4 a) { vst1q_f32(p, a); }
+static inline simd_f32x4 simd_f32x4_set1(float x) { return vdupq_n_f32(x); }
+static inline simd_f32x4 simd_f32x4_set(float a, float b, float c, float d) {
+    float v[4] = {a, b, c, d};
+    return vld1q_f32(v);
+}
+static inline simd_f32x4 simd_f32x4_add(simd_f32x4 a, simd_f32x4 b) { return vaddq_f32(a, b); }
+static inline simd_f32x4 simd_f32x4_sub(simd_f32x4 a, simd_f32x4 b) { return vsubq_f32(a, b); }
+static inline simd_f32x4 simd_f32x4_mul(simd_f32x4 a, simd_f32x4 b) { return vmulq_f32(a, b); }
+static inline simd_f32x4 simd_f32x4_min(simd_f32x4 a, simd_f32x4 b) { return vminq_f32(a, b); }
+static inline simd_f32x4 simd_f32x4_max(simd_f32x4 a, simd_f32x4 b) { return vmaxq_f32(a, b); }
+static inline simd_f32x4 simd_f32x4_and(simd_f32x4 a, simd_f32x4 b) {
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+}
+static inline simd_f32x4 simd_f32x4_xor(simd_f32x4 a, simd_f32x4 b) {
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+}
+static inline simd_f32x4 simd_f32x4_abs(simd_f32x4 a) { return vabsq_f32(a); }
+static inline simd_f32x4 simd_f32x4_cmplt(simd_f32x4 a, simd_f32x4 b) { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+static inline simd_f32x4 simd_f32x4_select(simd_f32x4 mask, simd_f32x4 a, simd_f32x4 b) {
+    return vbslq_f32(vreinterpretq_u32_f32(mask), a, b);
+}
+static inline simd_f32x4 simd_f32x4_floor(simd_f32x4 a) {
+    simd_f32x4 t = vcvtq_f32_s32(vcvtq_s32_f32(a));
+    return vsubq_f32(t, vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(t, a), vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+}
+
+#else
+
+typedef struct {
+    float v[4];
+} simd_f32x4;
+
+#define SIMD_F32X4_MAP2(name, expr)                                         \
+    static inline simd_f32x4 name(simd_f32x4 a, simd_f32x4 b) {             \
+        simd_f32x4 r;                                                       \
+        for (int i = 0; i < 4; i++) {                                       \
+            r.v[i] = (expr);                                                \
+        }                                                                   \
+        return r;                                                           \
+    }
+
+static inline simd_f32x4 simd_f32x4_load(const float *p) {
+    simd_f32x4 r = {{p[0], p[1], p[2], p[3]}};
+    return r;
+}
+static inline void simd_f32x4_store(float *p, simd_f32x4 a) {
+    for (int i = 0; i < 4; i++) p[i] = a.v[i];
+}
+static inline simd_f32x4 simd_f32x4_set1(float x) {
+    simd_f32x4 r = {{x, x, x, x}};
+    return r;
+}
+static inline simd_f32x4 simd_f32x4_set(float a, float b, float c, float d) {
+    simd_f32x4 r = {{a, b, c, d}};
+    return r;
+}
+
+SIMD_F32X4_MAP2(simd_f32x4_add, a.v[i] + b.v[i])
+SIMD_F32X4_MAP2(simd_f32x4_sub, a.v[i] - b.v[i])
+SIMD_F32X4_MAP2(simd_f32x4_mul, a.v[i] * b.v[i])
+SIMD_F32X4_MAP2(simd_f32x4_min, a.v[i] < b.v[i] ? a.v[i] : b.v[i])
+SIMD_F32X4_MAP2(simd_f32x4_max, a.v[i] > b.v[i] ? a.v[i] : b.v[i])
+
+static inline simd_f32x4 _simd_f32x4_bitop(simd_f32x4 a, simd_f32x4 b, int op) {
+    simd_f32x4 r;
+    for (int i = 0; i < 4; i++) {
+        union { float f; uint32_t u; } x = {a.v[i]}, y = {b.v[i]};
+        x.u = op ? (x.u ^ y.u) : (x.u & y.u);
+        r.v[i] = x.f;
+    }
+    return r;
+}
+static inline simd_f32x4 simd_f32x4_and(simd_f32x4 a, simd_f32x4 b) { return _simd_f32x4_bitop(a, b, 0); }
+static inline simd_f32x4 simd_f32x4_xor(simd_f32x4 a, simd_f32x4 b) { return _simd_f32x4_bitop(a, b, 1); }
+static inline simd_f32x4 simd_f32x4_abs(simd_f32x4 a) {
+    for (int i = 0; i < 4; i++) a.v[i] = a.v[i] < 0 ? -a.v[i] : a.v[i];
+    return a;
+}
+static inline simd_f32x4 simd_f32x4_cmplt(simd_f32x4 a, simd_f32x4 b) {
+    simd_f32x4 r;
+    for (int i = 0; i < 4; i++) {
+        union { uint32_t u; float f; } m = {a.v[i] < b.v[i] ? 0xFFFFFFFFu : 0u};
+        r.v[i] = m.f;
+    }
+    return r;
+}
+static inline simd_f32x4 simd_f32x4_select(simd_f32x4 mask, simd_f32x4 a, simd_f32x4 b) {
+    simd_f32x4 r;
+    for (int i = 0; i < 4; i++) {
+        union { float f; uint32_t u; } m = {mask.v[i]};
+        r.v[i] = m.u ? a.v[i] : b.v[i];
+    }
+    return r;
+}
+static inline simd_f32x4 simd_f32x4_floor(simd_f32x4 a) {
+    for (int i = 0; i < 4; i++) {
+        float t = (float)(int32_t)a.v[i];
+        a.v[i] = t > a.v[i] ? t - 1.0f : t;
+    }
+    return a;
+}
+
+#undef SIMD_F32X4_MAP2
+
+#endif
+
+#endif  // SIMD_H
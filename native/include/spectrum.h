@@ -0,0 +1,85 @@
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include <stdatomic.h>
+
+#include "miniaudio.h"
+#include "playback_device.h"
+
+/**
+ * @struct spectrum_t
+ * @brief Spectrum analyzer fed from an audio thread tap.
+ *
+ * The audio thread only copies frames into `tap`, a single-producer,
+ * single-consumer ring buffer. The worker thread downmixes them into the
+ * sliding block `pBlock`, windows it and runs a real FFT of `fftSize`
+ * points as a complex FFT of half the size. The FFT works on separate real
+ * and imaginary arrays so butterflies are computed four at a time with
+ * `simd_f32x4`.
+ *
+ * Bins are published through two buffers: the worker writes the buffer that
+ * is not current, then increments `sequence`, whose low bit selects the
+ * current buffer. A reader retries if `sequence` changed during its copy.
+ */
+typedef struct {
+    ma_format format;          /**< Format of the tapped frames. */
+    uint32_t channels;         /**< Number of tapped channels. */
+    uint32_t sampleRate;       /**< Sample rate in Hertz. */
+    spectrum_config_t config;  /**< Configuration with defaults applied. */
+    uint32_t binCount;         /**< `fftSize / 2 + 1`. */
+
+    ma_rb tap;                 /**< Frames copied by the audio thread. */
+    atomic_uint droppedFrames; /**< Frames lost because the tap was full. */
+
+    uint8_t *pRaw;     /**< `hopSize` frames read from the tap, NULL for f32 frames. */
+    float *pConvert;   /**< `hopSize` frames converted to f32. */
+    float *pBlock;     /**< Last `fftSize` mono samples, oldest first. */
+    float *pWindow;    /**< Window of `fftSize` points. */
+    float windowScale; /**< Scales magnitudes so a full-scale sine reads 1. */
+    float *pRe;        /**< Real parts, `fftSize / 2` points. */
+    float *pIm;        /**< Imaginary parts, `fftSize / 2` points. */
+    float *pTwiddleRe; /**< Per-stage twiddles of the complex FFT, stage `h` at offset `h - 1`. */
+    float *pTwiddleIm; /**< See `pTwiddleRe`. */
+    float *pSplitRe;   /**< Twiddles of the real FFT split, `fftSize / 2` points. */
+    float *pSplitIm;   /**< See `pSplitRe`. */
+    uint32_t *pBitReverse; /**< Bit reversal permutation of `fftSize / 2` points. */
+    float *pSmoothed;  /**< Smoothed magnitudes. */
+    uint32_t blockFill; /**< Samples in `pBlock` before it is full for the first time. */
+
+    float *pBins[2];            /**< Published magnitudes, double-buffered. */
+    _Atomic(uint64_t) sequence; /**< Number of published spectra; its low bit selects the current buffer. */
+
+    pthread_t thread;      /**< Worker thread. */
+    pthread_mutex_t mutex; /**< Protects the wake-up condition. */
+    pthread_cond_t cond;   /**< Signalled on stop. */
+    atomic_bool stop;      /**< Asks the worker to exit. */
+} spectrum_t;
+
+/**
+ * @brief Creates an analyzer and starts its worker.
+ *
+ * @return The analyzer, or NULL if the configuration is invalid or resources ran out.
+ */
+spectrum_t *spectrum_create(ma_format format,
+                            uint32_t channels,
+                            uint32_t sampleRate,
+                            const spectrum_config_t *pConfig);
+
+/**
+ * @brief Copies frames into the tap. Never blocks; frames that do not fit are dropped.
+ */
+void spectrum_write(spectrum_t *self, const void *pFrames, uint32_t frameCount);
+
+/**
+ * @brief Copies the latest bins.
+ *
+ * @return The number of bins copied, 0 before the first spectrum.
+ */
+uint32_t spectrum_read(spectrum_t *self, float *pBins, uint32_t binCount, uint64_t *pSequence);
+
+/**
+ * @brief Stops the worker and releases the analyzer.
+ */
+void spectrum_destroy(spectrum_t *self);
+
+#endif  // SPECTRUM_H
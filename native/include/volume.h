@@ -0,0 +1,56 @@
+#ifndef VOLUME_H
+#define VOLUME_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "miniaudio.h"
+
+/**
+ * @brief Length of the ramp applied when the gain changes, in milliseconds.
+ */
+#define VOLUME_RAMP_MS 10
+
+/**
+ * @brief Samples converted to f32 at a time when the format is not f32.
+ */
+#define VOLUME_SLICE_SAMPLES 1024
+
+/**
+ * @struct volume_t
+ * @brief Volume and mute applied in place on the audio thread.
+ *
+ * Any thread stores `volume` and `isMuted`. At the start of each call,
+ * `volume_process` compares the resulting gain with the one it is heading
+ * to and, when it changed, ramps linearly from the current gain over
+ * `rampFrames`, so changes never click. The first call starts at the
+ * requested gain, so a device muted before it starts never plays a frame.
+ * Unity gain costs nothing and a settled mute only writes silence.
+ */
+typedef struct {
+    ma_format format;    /**< Format of the processed frames. */
+    uint32_t channels;   /**< Number of channels. */
+    uint32_t rampFrames; /**< Frames of a ramp. */
+
+    _Atomic float volume; /**< Linear gain set by the user. */
+    atomic_bool isMuted;  /**< Gain is 0 regardless of `volume`. */
+
+    float gain;        /**< Audio thread: gain of the next frame. */
+    float target;      /**< Audio thread: gain the ramp heads to. */
+    float step;        /**< Audio thread: gain increment per frame. */
+    uint32_t rampLeft; /**< Audio thread: frames until `gain` reaches `target`. */
+    bool isPrimed;     /**< Audio thread: frames were processed, so changes ramp. */
+} volume_t;
+
+/**
+ * @brief Initializes a volume at unity gain, unmuted.
+ */
+void volume_init(volume_t *self, ma_format format, uint32_t channels, uint32_t sampleRate);
+
+/**
+ * @brief Applies the volume to interleaved frames in place. Never blocks or allocates.
+ */
+void volume_process(volume_t *self, void *pFrames, uint32_t frameCount);
+
+#endif  // VOLUME_H
@@ -0,0 +1,100 @@
+#ifndef WAVEFORM_BANK_H
+#define WAVEFORM_BANK_H
+
+#include "audio_context.h"
+#include "platform.h"
+#include "waveform.h"
+
+/**
+ * @enum waveform_bank_mix_t
+ * @brief Describes how the oscillators of a bank are written to the output.
+ */
+typedef enum {
+    waveform_bank_mix_interleaved, /**< Each oscillator is written to its own channel. */
+    waveform_bank_mix_summed       /**< All oscillators are summed and the sum is written to every channel. */
+} waveform_bank_mix_t;
+
+/**
+ * @struct waveform_bank_config_t
+ * @brief Output configuration of a waveform bank.
+ */
+typedef struct {
+    pcm_format_t pcmFormat;  /**< PCM format of the output (e.g., `pcm_format_f32`). */
+    uint32_t channels;       /**< Output channels for `waveform_bank_mix_summed`. Ignored when interleaved, where every oscillator is a channel. */
+    uint32_t sampleRate;     /**< Sample rate in Hertz (e.g., 44100 Hz). */
+    waveform_bank_mix_t mix; /**< How oscillators are written to the output. */
+} waveform_bank_config_t;
+
+/**
+ * @struct waveform_bank_oscillator_t
+ * @brief Parameters of a single oscillator in a waveform bank.
+ */
+typedef struct {
+    waveform_type_t type; /**< Waveform shape of the oscillator. */
+    double amplitude;     /**< Amplitude, typically in the range [0.0, 1.0]. */
+    double frequency;     /**< Frequency in Hertz. */
+} waveform_bank_oscillator_t;
+
+/**
+ * @brief Creates a bank of oscillators rendered together.
+ *
+ * The bank renders every oscillator with a phase-accumulator kernel that is
+ * vectorized for the running CPU (AVX2, SSE2 or NEON, selected at runtime).
+ * The returned object is also a miniaudio data source.
+ *
+ * @param pConfig Pointer to the output configuration.
+ * @param pOscillators Array of `oscillatorCount` oscillator descriptions.
+ * @param oscillatorCount Number of oscillators in the bank.
+ * @return A pointer to the waveform bank, or NULL if initialization fails.
+ */
+FFI_PLUGIN_EXPORT
+void *waveform_bank_create(waveform_bank_config_t *pConfig,
+                           waveform_bank_oscillator_t *pOscillators,
+                           uint32_t oscillatorCount);
+
+/**
+ * @brief Destroys a waveform bank and releases its resources.
+ *
+ * @param self Pointer to the waveform bank to destroy.
+ */
+FFI_PLUGIN_EXPORT
+void waveform_bank_destroy(void *self);
+
+/**
+ * @brief Replaces the parameters of one oscillator.
+ *
+ * The phase of the oscillator is preserved so frequency changes are continuous.
+ *
+ * @param self Pointer to the waveform bank.
+ * @param index Index of the oscillator to update.
+ * @param pOscillator Pointer to the new oscillator parameters.
+ */
+FFI_PLUGIN_EXPORT
+void waveform_bank_set_oscillator(void *self,
+                                  uint32_t index,
+                                  waveform_bank_oscillator_t *pOscillator);
+
+/**
+ * @brief Returns the number of channels written per output frame.
+ *
+ * @param self Pointer to the waveform bank.
+ * @return The number of output channels, or 0 if `self` is NULL.
+ */
+FFI_PLUGIN_EXPORT
+uint32_t waveform_bank_get_channels(void *self);
+
+/**
+ * @brief Reads PCM frames from the waveform bank.
+ *
+ * @param self Pointer to the waveform bank.
+ * @param pFramesOut Pointer to the output buffer where PCM frames will be written.
+ * @param framesCount The number of frames to generate.
+ * @param pFramesRead Pointer to a variable that will store the actual number of frames read.
+ */
+FFI_PLUGIN_EXPORT
+void waveform_bank_read_pcm_frames_with_buffer(void *self,
+                                               void *pFramesOut,
+                                               uint64_t framesCount,
+                                               uint64_t *pFramesRead);
+
+#endif  // WAVEFORM_BANK_H
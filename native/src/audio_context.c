@@ -2,6 +2,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "../include/audio_context_private.h"
 #include "../include/internal.h"
@@ -29,9 +30,67 @@ void _ma_(void *pUserData, ma_uint32 level, const char *pMessage) {
     }
 }
 
+// Backend the last context of the process initialized, `audio_backend_unknown` if none.
+static _Atomic int _lastBackend = audio_backend_unknown;
+
+static void _serve_batch(void *pUserData, context_request_t *pBatch);
+
+static uint64_t _now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+// Fills `pBackends` with the backends to try, in order. Returns the count,
+// 0 to let miniaudio try every enabled backend in its default order.
+static uint32_t _resolve_backends(const audio_context_config_t *pConfig, ma_backend *pBackends) {
+    if (!pConfig) {
+        return 0;
+    }
+
+    int last = atomic_load(&_lastBackend);
+    bool hasLast = pConfig->preferLastBackend && last != audio_backend_unknown;
+
+    ma_backend enabled[MA_BACKEND_COUNT];
+    const ma_backend *pSource = enabled;
+    size_t sourceCount = 0;
+
+    if (pConfig->backendCount > 0) {
+        pSource = (const ma_backend *)pConfig->backends;
+        sourceCount = pConfig->backendCount < AUDIO_CONTEXT_MAX_BACKENDS ? pConfig->backendCount : AUDIO_CONTEXT_MAX_BACKENDS;
+    } else if (hasLast) {
+        // The last backend goes first; the others keep their default order.
+        ma_get_enabled_backends(enabled, MA_BACKEND_COUNT, &sourceCount);
+    } else {
+        return 0;
+    }
+
+    uint32_t count = 0;
+
+    if (hasLast) {
+        pBackends[count++] = (ma_backend)last;
+    }
+
+    for (size_t i = 0; i < sourceCount; i++) {
+        if ((int)pSource[i] < 0 || pSource[i] >= MA_BACKEND_COUNT || (hasLast && (int)pSource[i] == last)) {
+            continue;
+        }
+
+        pBackends[count++] = pSource[i];
+    }
+
+    return count;
+}
+
 FFI_PLUGIN_EXPORT
 void *audio_context_create(void) {
-    audio_context_t *context = malloc(sizeof(audio_context_t));
+    return audio_context_create_ex(NULL);
+}
+
+FFI_PLUGIN_EXPORT
+void *audio_context_create_ex(const audio_context_config_t *pConfig) {
+    audio_context_t *context = calloc(1, sizeof(audio_context_t));
 
     if (!context) {
         LOG_ERROR("failed to allocate memory for audio context.\n", "");
@@ -40,6 +99,9 @@ void *audio_context_create(void) {
 
     context->audioDevices = NULL;
     context->deviceCount = 0;
+    atomic_init(&context->enumerateNs, 0);
+    atomic_init(&context->isEnumerated, false);
+    atomic_init(&context->enumerations, 0);
 
     ma_context_config config = ma_context_config_init();
     config.coreaudio.sessionCategory =
@@ -52,24 +114,39 @@ void *audio_context_create(void) {
 
     config.coreaudio.noAudioSessionDeactivate = MA_TRUE;
 
+    uint64_t startNs = _now_ns();
 
-    ma_log *log = malloc(sizeof(ma_log));
-    if (ma_log_init(
-            &context->maContext.allocationCallbacks,
-            log) == MA_SUCCESS) {
+    // The log lives in the context, so setting it up costs no allocation.
+    if (ma_log_init(NULL, &context->log) == MA_SUCCESS) {
         ma_log_callback log_callback;
         log_callback.onLog = _ma_;
-        ma_log_register_callback(log, log_callback);
-        config.pLog = log;
+        log_callback.pUserData = NULL;
+        ma_log_register_callback(&context->log, log_callback);
+        config.pLog = &context->log;
+        context->hasLog = true;
     }
 
+    context->logNs = _now_ns() - startNs;
+
+    // Room for the last backend ahead of a full list.
+    ma_backend backends[AUDIO_CONTEXT_MAX_BACKENDS + 1];
+    uint32_t backendCount = _resolve_backends(pConfig, backends);
+
+    startNs = _now_ns();
+
     ma_result contextInitResult =
-        ma_context_init(NULL,
-                        0,
+        ma_context_init(backendCount > 0 ? backends : NULL,
+                        backendCount,
                         &config,
                         &context->maContext);
 
+    context->initNs = _now_ns() - startNs;
+
     if (contextInitResult != MA_SUCCESS) {
+        if (context->hasLog) {
+            ma_log_uninit(&context->log);
+        }
+
         free(context);
 
         LOG_ERROR("ma_context_init failed - %s.\n",
@@ -78,11 +155,48 @@ void *audio_context_create(void) {
         return NULL;
     }
 
-    LOG_INFO("<%p>(audio_context_t *) created.\n", context);
+    atomic_store(&_lastBackend, (int)context->maContext.backend);
+
+    pthread_mutex_init(&context->devicesLock, NULL);
+    context_worker_init(&context->worker, _serve_batch, context);
+    playback_pool_init(&context->pool);
+
+    LOG_INFO("<%p>(audio_context_t *) created with %s in %llu us.\n",
+             context,
+             ma_get_backend_name(context->maContext.backend),
+             (unsigned long long)(context->initNs / 1000));
+
+    if (pConfig && !pConfig->isLazy) {
+        audio_context_refresh_devices(context);
+    }
 
     return context;
 }
 
+FFI_PLUGIN_EXPORT
+bool audio_context_get_timings(const void *self, audio_context_timings_t *pTimings) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    if (!pTimings) {
+        LOG_ERROR("invalid parameter: `pTimings` is NULL.\n", "");
+        return false;
+    }
+
+    const audio_context_t *ctx = (const audio_context_t *)self;
+
+    pTimings->backend = (audio_backend_t)ctx->maContext.backend;
+    pTimings->logNs = ctx->logNs;
+    pTimings->initNs = ctx->initNs;
+    pTimings->enumerateNs = atomic_load(&ctx->enumerateNs);
+    pTimings->isEnumerated = atomic_load(&ctx->isEnumerated);
+    pTimings->enumerations = atomic_load(&ctx->enumerations);
+
+    return true;
+}
+
 FFI_PLUGIN_EXPORT
 void audio_context_destroy(void *self) {
     if (!self) {
@@ -92,6 +206,10 @@ void audio_context_destroy(void *self) {
     }
 
     audio_context_t *ctx = (audio_context_t *)self;
+
+    // Serve the queued requests while the backend is still up.
+    context_worker_uninit(&ctx->worker);
+
     // Stop and free each device
     LOG_INFO("Destroying %d devices.\n", ctx->deviceCount);
 
@@ -117,21 +235,22 @@ void audio_context_destroy(void *self) {
                   ma_result_description(contextUninitResult));
     }
 
+    if (ctx->hasLog) {
+        ma_log_uninit(&ctx->log);
+    }
+
+    // The pooled devices were destroyed with the others.
+    playback_pool_uninit(&ctx->pool);
+    pthread_mutex_destroy(&ctx->devicesLock);
     free(ctx->audioDevices);
-    free(ctx->maContext.pLog);
     free(ctx);
 
     LOG_INFO("<%p>(audio_context_t *) destroyed.\n", ctx);
 }
 
-FFI_PLUGIN_EXPORT
-void audio_context_refresh_devices(const void *self) {
-    if (!self) {
-        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
-        return;
-    }
-
-    audio_context_t *ctx = (audio_context_t *)self;
+// Enumerates the devices. The caller holds `devicesLock`.
+static bool _refresh_devices_locked(audio_context_t *ctx) {
+    uint64_t startNs = _now_ns();
 
     // Get playback and capture devices
     ma_result getDevicesResult =
@@ -145,12 +264,32 @@ void audio_context_refresh_devices(const void *self) {
         LOG_ERROR("ma_context_get_devices failed - %s.\n",
                   ma_result_description(getDevicesResult));
 
-        return;
+        return false;
     }
 
+    atomic_store(&ctx->enumerateNs, _now_ns() - startNs);
+    atomic_store(&ctx->isEnumerated, true);
+    atomic_fetch_add(&ctx->enumerations, 1);
+
     LOG_INFO("devices refreshed.\n", "");
     LOG_DEBUG("  playback device count: %d.\n", ctx->maContext.playbackDeviceInfoCount);
     LOG_DEBUG("  capture device count: %d.\n", ctx->maContext.captureDeviceInfoCount);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+void audio_context_refresh_devices(const void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    audio_context_t *ctx = (audio_context_t *)self;
+
+    pthread_mutex_lock(&ctx->devicesLock);
+    _refresh_devices_locked(ctx);
+    pthread_mutex_unlock(&ctx->devicesLock);
 }
 
 static void _fill_device_info_list(ma_device_info *pSource,
@@ -162,14 +301,14 @@ static void _fill_device_info_ext(ma_context *maContext,
                                   ma_device_id *pDeviceId,
                                   device_info_ext_t **ppDeviceInfoExt);
 
-FFI_PLUGIN_EXPORT
-device_infos_t *audio_context_get_device_infos(const void *self, audio_device_type_t type) {
-    if (!self) {
-        LOG_ERROR("invalid parameter: `pContext` is NULL.\n", "");
-        return NULL;
+// Copies the devices of `type`, enumerating first if the context has not
+// yet. The caller holds `devicesLock`.
+static device_infos_t *_copy_device_infos_locked(audio_context_t *ctx, audio_device_type_t type) {
+    // A lazy context enumerates on first use.
+    if (!atomic_load(&ctx->isEnumerated)) {
+        _refresh_devices_locked(ctx);
     }
 
-    audio_context_t *ctx = (audio_context_t *)self;
     uint32_t playbackCount = ctx->maContext.playbackDeviceInfoCount;
     uint32_t captureCount = ctx->maContext.captureDeviceInfoCount;
 
@@ -209,6 +348,22 @@ device_infos_t *audio_context_get_device_infos(const void *self, audio_device_ty
     return pDeviceInfos;
 }
 
+FFI_PLUGIN_EXPORT
+device_infos_t *audio_context_get_device_infos(const void *self, audio_device_type_t type) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `pContext` is NULL.\n", "");
+        return NULL;
+    }
+
+    audio_context_t *ctx = (audio_context_t *)self;
+
+    pthread_mutex_lock(&ctx->devicesLock);
+    device_infos_t *pDeviceInfos = _copy_device_infos_locked(ctx, type);
+    pthread_mutex_unlock(&ctx->devicesLock);
+
+    return pDeviceInfos;
+}
+
 FFI_PLUGIN_EXPORT
 void audio_context_device_infos_destroy(device_infos_t *pDeviceInfos) {
     if (!pDeviceInfos) {
@@ -262,6 +417,162 @@ void audio_context_device_info_ext_destroy(device_info_ext_t *pDeviceInfoExt) {
     LOG_INFO("device info ext destroyed.\n", "");
 }
 
+// Serves a batch of requests on the worker thread: one enumeration for
+// every request that needs it, then each request in order. Callbacks run
+// without `devicesLock`, so they may call back into the context.
+static void _serve_batch(void *pUserData, context_request_t *pBatch) {
+    audio_context_t *ctx = pUserData;
+    bool needsRefresh = false;
+
+    for (context_request_t *pRequest = pBatch; pRequest; pRequest = pRequest->pNext) {
+        needsRefresh |= pRequest->kind == context_request_refresh;
+    }
+
+    bool isSuccess = true;
+
+    if (needsRefresh) {
+        pthread_mutex_lock(&ctx->devicesLock);
+        isSuccess = _refresh_devices_locked(ctx);
+        pthread_mutex_unlock(&ctx->devicesLock);
+    }
+
+    while (pBatch) {
+        context_request_t *pRequest = pBatch;
+        pBatch = pRequest->pNext;
+
+        switch (pRequest->kind) {
+            case context_request_refresh:
+                pRequest->onComplete.onRefresh(pRequest->pUserData, isSuccess);
+                break;
+            case context_request_device_infos: {
+                pthread_mutex_lock(&ctx->devicesLock);
+                device_infos_t *pDeviceInfos = _copy_device_infos_locked(ctx, pRequest->type);
+                pthread_mutex_unlock(&ctx->devicesLock);
+
+                pRequest->onComplete.onDeviceInfos(pRequest->pUserData, pDeviceInfos);
+                break;
+            }
+            case context_request_device_info_ext: {
+                device_info_ext_t *pDeviceInfoExt = NULL;
+
+                _fill_device_info_ext(&ctx->maContext,
+                                      ma_device_type_playback,
+                                      &pRequest->deviceId,
+                                      &pDeviceInfoExt);
+
+                pRequest->onComplete.onDeviceInfoExt(pRequest->pUserData, pDeviceInfoExt);
+                break;
+            }
+            case context_request_device_start:
+            case context_request_device_stop: {
+                bool isStart = pRequest->kind == context_request_device_start;
+
+                if (isStart) {
+                    playback_device_start(pRequest->pDevice);
+                } else {
+                    playback_device_stop(pRequest->pDevice);
+                }
+
+                device_state_t state = playback_device_get_state(pRequest->pDevice);
+
+                if (pRequest->onComplete.onTransition) {
+                    pRequest->onComplete.onTransition(pRequest->pUserData,
+                                                      state == (isStart ? device_state_started : device_state_stopped),
+                                                      state);
+                }
+                break;
+            }
+        }
+
+        free(pRequest);
+    }
+}
+
+static context_request_t *_new_request(const void *self,
+                                       context_request_kind_t kind,
+                                       bool hasCallback,
+                                       void *pUserData) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return NULL;
+    }
+
+    if (!hasCallback) {
+        LOG_ERROR("invalid parameter: `onComplete` is NULL.\n", "");
+        return NULL;
+    }
+
+    context_request_t *pRequest = calloc(1, sizeof(context_request_t));
+
+    if (!pRequest) {
+        LOG_ERROR("failed to allocate memory for a context request.\n", "");
+        return NULL;
+    }
+
+    pRequest->kind = kind;
+    pRequest->pUserData = pUserData;
+
+    return pRequest;
+}
+
+FFI_PLUGIN_EXPORT
+bool audio_context_refresh_devices_async(const void *self,
+                                         audio_context_refresh_callback_t onComplete,
+                                         void *pUserData) {
+    context_request_t *pRequest = _new_request(self, context_request_refresh, onComplete != NULL, pUserData);
+
+    if (!pRequest) {
+        return false;
+    }
+
+    audio_context_t *ctx = (audio_context_t *)self;
+    pRequest->onComplete.onRefresh = onComplete;
+
+    return context_worker_post(&ctx->worker, pRequest);
+}
+
+FFI_PLUGIN_EXPORT
+bool audio_context_get_device_infos_async(const void *self,
+                                          audio_device_type_t type,
+                                          audio_context_device_infos_callback_t onComplete,
+                                          void *pUserData) {
+    context_request_t *pRequest = _new_request(self, context_request_device_infos, onComplete != NULL, pUserData);
+
+    if (!pRequest) {
+        return false;
+    }
+
+    audio_context_t *ctx = (audio_context_t *)self;
+    pRequest->type = type;
+    pRequest->onComplete.onDeviceInfos = onComplete;
+
+    return context_worker_post(&ctx->worker, pRequest);
+}
+
+FFI_PLUGIN_EXPORT
+bool audio_context_get_device_info_ext_async(const void *self,
+                                             void *deviceId,
+                                             audio_context_device_info_ext_callback_t onComplete,
+                                             void *pUserData) {
+    if (!deviceId) {
+        LOG_ERROR("invalid parameter: `deviceId` is NULL.\n", "");
+        return false;
+    }
+
+    context_request_t *pRequest =
+        _new_request(self, context_request_device_info_ext, onComplete != NULL, pUserData);
+
+    if (!pRequest) {
+        return false;
+    }
+
+    audio_context_t *ctx = (audio_context_t *)self;
+    memcpy(&pRequest->deviceId, deviceId, sizeof(ma_device_id));
+    pRequest->onComplete.onDeviceInfoExt = onComplete;
+
+    return context_worker_post(&ctx->worker, pRequest);
+}
+
 static void _fill_device_info_list(ma_device_info *pSource,
                                    device_infos_t **ppDeviceInfos,
                                    uint32_t count) {
@@ -18,8 +18,11 @@ void audio_device_create(audio_device_t *dev,
                             
     dev->vtable = &g_audio_device_vtable;
 
+    // A zero ID stands for the default device.
     if (id) {
         memcpy(&dev->id, id, sizeof(device_id));
+    } else {
+        memset(&dev->id, 0, sizeof(device_id));
     }
 
     dev->owner = owner;
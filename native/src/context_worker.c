@@ -0,0 +1,117 @@
+#include "../include/context_worker.h"
+
+#include <stdlib.h>
+
+#include "../include/logger.h"
+
+void context_worker_init(context_worker_t *self, context_worker_batch_callback_t onBatch, void *pUserData) {
+    self->onBatch = onBatch;
+    self->pUserData = pUserData;
+
+    pthread_mutex_init(&self->mutex, NULL);
+    pthread_cond_init(&self->cond, NULL);
+    pthread_cond_init(&self->idleCond, NULL);
+    self->pHead = NULL;
+    self->pTail = NULL;
+    self->isRunning = false;
+    self->isBusy = false;
+    self->stop = false;
+}
+
+static void *_worker_thread(void *pUserData) {
+    context_worker_t *self = pUserData;
+
+    pthread_mutex_lock(&self->mutex);
+
+    for (;;) {
+        while (!self->pHead && !self->stop) {
+            pthread_cond_wait(&self->cond, &self->mutex);
+        }
+
+        if (!self->pHead) {
+            break;
+        }
+
+        context_request_t *pBatch = self->pHead;
+        self->pHead = NULL;
+        self->pTail = NULL;
+        self->isBusy = true;
+
+        pthread_mutex_unlock(&self->mutex);
+        self->onBatch(self->pUserData, pBatch);
+        pthread_mutex_lock(&self->mutex);
+
+        self->isBusy = false;
+        pthread_cond_broadcast(&self->idleCond);
+    }
+
+    pthread_mutex_unlock(&self->mutex);
+
+    return NULL;
+}
+
+bool context_worker_post(context_worker_t *self, context_request_t *pRequest) {
+    pRequest->pNext = NULL;
+
+    pthread_mutex_lock(&self->mutex);
+
+    if (self->stop) {
+        pthread_mutex_unlock(&self->mutex);
+        free(pRequest);
+        return false;
+    }
+
+    if (!self->isRunning) {
+        if (pthread_create(&self->thread, NULL, _worker_thread, self) != 0) {
+            pthread_mutex_unlock(&self->mutex);
+            LOG_ERROR("failed to start the context worker thread.\n", "");
+            free(pRequest);
+            return false;
+        }
+
+        self->isRunning = true;
+        LOG_INFO("<%p>(context_worker_t) started.\n", self);
+    }
+
+    if (self->pTail) {
+        self->pTail->pNext = pRequest;
+    } else {
+        self->pHead = pRequest;
+    }
+
+    self->pTail = pRequest;
+
+    pthread_cond_signal(&self->cond);
+    pthread_mutex_unlock(&self->mutex);
+
+    return true;
+}
+
+void context_worker_flush(context_worker_t *self) {
+    pthread_mutex_lock(&self->mutex);
+
+    if (self->isRunning && !pthread_equal(pthread_self(), self->thread)) {
+        while (self->pHead || self->isBusy) {
+            pthread_cond_wait(&self->idleCond, &self->mutex);
+        }
+    }
+
+    pthread_mutex_unlock(&self->mutex);
+}
+
+void context_worker_uninit(context_worker_t *self) {
+    pthread_mutex_lock(&self->mutex);
+    self->stop = true;
+    bool isRunning = self->isRunning;
+    pthread_cond_signal(&self->cond);
+    pthread_mutex_unlock(&self->mutex);
+
+    if (isRunning) {
+        pthread_join(self->thread, NULL);
+        LOG_INFO("<%p>(context_worker_t) stopped.\n", self);
+    }
+
+    pthread_cond_destroy(&self->idleCond);
+    pthread_cond_destroy(&self->cond);
+    pthread_mutex_destroy(&self->mutex);
+}
@@ -0,0 +1,537 @@
+#include "../include/decoder.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../include/internal.h"
+#include "../include/logger.h"
+#include "../include/miniaudio.h"
+
+// Lookahead used when the config leaves `lookaheadFrames` at 0, in seconds.
+#define DECODER_DEFAULT_LOOKAHEAD_SEC 0.5
+
+// The read-ahead thread decodes in slices of a quarter of the lookahead so the
+// ring is topped up well before the reader can drain it.
+#define DECODER_CHUNK_DIVISOR 4
+
+/*
+ * Seeking protocol.
+ *
+ * The ring is single producer (read-ahead thread) / single consumer (reader,
+ * usually the audio callback), so neither side may reset it. Instead:
+ *
+ * 1. `decoder_seek` stores the target and bumps `seekGeneration`.
+ * 2. The read-ahead thread seeks the `ma_decoder`, then publishes how many
+ *    frames it had written before the seek (`flushMark`), the new position
+ *    (`flushCursor`) and finally `flushGeneration`.
+ * 3. The reader outputs nothing while a seek is pending, and once it sees a
+ *    new `flushGeneration` it skips every frame up to `flushMark`.
+ */
+typedef struct {
+    ma_data_source_base ds;  /**< Must be the first member so the decoder is a `ma_data_source`. */
+    decoder_config_t config; /**< Output configuration. */
+    ma_decoder decoder;      /**< File decoder, only touched by the read-ahead thread after creation. */
+    ma_pcm_rb rb;            /**< Lookahead ring of decoded frames. */
+    ma_uint64 length;        /**< Length of the file in output frames, 0 if unknown. */
+    ma_uint32 chunkFrames;   /**< Frames decoded per slice. */
+    ma_uint32 waitUs;        /**< Idle wait of the read-ahead thread, in microseconds. */
+    ma_uint64 decodePos;     /**< Position of `decoder`, only touched by the read-ahead thread. */
+
+    pthread_t thread;      /**< Read-ahead thread. */
+    pthread_mutex_t mutex; /**< Protects the wake-up condition. */
+    pthread_cond_t cond;   /**< Signalled on seek and destroy. */
+
+    atomic_bool stop;      /**< Set on destroy. */
+    atomic_bool isLooping; /**< Restart from frame 0 at the end of the file. */
+    atomic_bool isAtEnd;   /**< The read-ahead thread has decoded the last frame. */
+
+    atomic_uint seekGeneration;      /**< Bumped by `decoder_seek`. */
+    _Atomic(uint64_t) seekTarget;    /**< Requested frame of the latest seek. */
+    atomic_uint flushGeneration;     /**< Latest seek applied by the read-ahead thread. */
+    _Atomic(uint64_t) flushMark;     /**< Frames written to the ring before that seek. */
+    _Atomic(uint64_t) flushCursor;   /**< Frame the decoder was moved to. */
+
+    unsigned int readerGeneration; /**< Latest flush applied by the reader. */
+    ma_uint64 framesReadTotal;     /**< Frames consumed from the ring, including skipped ones. */
+    _Atomic(uint64_t) cursor;      /**< Output position of the reader, not wrapped for looping. */
+} decoder_t;
+
+static void _wake(decoder_t *decoder) {
+    pthread_mutex_lock(&decoder->mutex);
+    pthread_cond_signal(&decoder->cond);
+    pthread_mutex_unlock(&decoder->mutex);
+}
+
+static void _wait(decoder_t *decoder, unsigned int handledGeneration) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+
+    deadline.tv_nsec += (long)decoder->waitUs * 1000;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&decoder->mutex);
+
+    if (!atomic_load(&decoder->stop) &&
+        atomic_load(&decoder->seekGeneration) == handledGeneration) {
+        pthread_cond_timedwait(&decoder->cond, &decoder->mutex, &deadline);
+    }
+
+    pthread_mutex_unlock(&decoder->mutex);
+}
+
+// Decodes one slice into the ring. Returns the number of frames written.
+static ma_uint32 _decode_chunk(decoder_t *decoder) {
+    if (ma_pcm_rb_available_write(&decoder->rb) < decoder->chunkFrames) {
+        return 0;
+    }
+
+    ma_uint32 framesToWrite = decoder->chunkFrames;
+    void *pBuffer;
+
+    ma_result acquireResult =
+        ma_pcm_rb_acquire_write(&decoder->rb, &framesToWrite, &pBuffer);
+
+    if (acquireResult != MA_SUCCESS || framesToWrite == 0) {
+        return 0;
+    }
+
+    ma_uint64 framesDecoded = 0;
+    ma_result readResult =
+        ma_decoder_read_pcm_frames(&decoder->decoder, pBuffer, framesToWrite, &framesDecoded);
+
+    ma_pcm_rb_commit_write(&decoder->rb, (ma_uint32)framesDecoded);
+    decoder->decodePos += framesDecoded;
+
+    if (readResult != MA_SUCCESS || framesDecoded < framesToWrite) {
+        if (readResult != MA_SUCCESS && readResult != MA_AT_END) {
+            LOG_ERROR("`ma_decoder_read_pcm_frames` failed - %s.\n",
+                      ma_result_description(readResult));
+        }
+
+        // Reaching the end at frame 0 means there is nothing to loop.
+        bool canLoop = atomic_load(&decoder->isLooping) && decoder->decodePos > 0;
+
+        if (canLoop && ma_decoder_seek_to_pcm_frame(&decoder->decoder, 0) == MA_SUCCESS) {
+            decoder->decodePos = 0;
+            LOG_DEBUG("<%p>(decoder_t) looped.\n", decoder);
+        } else {
+            atomic_store(&decoder->isAtEnd, true);
+        }
+    }
+
+    return (ma_uint32)framesDecoded;
+}
+
+static void *_read_ahead_thread(void *pUserData) {
+    decoder_t *decoder = (decoder_t *)pUserData;
+    unsigned int handledGeneration = 0;
+    ma_uint64 framesWritten = 0;
+
+    while (!atomic_load(&decoder->stop)) {
+        unsigned int generation = atomic_load(&decoder->seekGeneration);
+
+        if (generation != handledGeneration) {
+            handledGeneration = generation;
+
+            ma_uint64 target = atomic_load(&decoder->seekTarget);
+            ma_result seekResult = ma_decoder_seek_to_pcm_frame(&decoder->decoder, target);
+
+            if (seekResult != MA_SUCCESS) {
+                LOG_ERROR("`ma_decoder_seek_to_pcm_frame` failed - %s.\n",
+                          ma_result_description(seekResult));
+            }
+
+            decoder->decodePos = target;
+            atomic_store(&decoder->isAtEnd, seekResult != MA_SUCCESS);
+            atomic_store(&decoder->flushMark, framesWritten);
+            atomic_store(&decoder->flushCursor, target);
+            atomic_store(&decoder->flushGeneration, generation);
+            continue;
+        }
+
+        if (!atomic_load(&decoder->isAtEnd)) {
+            ma_uint32 framesDecoded = _decode_chunk(decoder);
+            framesWritten += framesDecoded;
+
+            if (framesDecoded > 0) {
+                continue;
+            }
+        }
+
+        _wait(decoder, handledGeneration);
+    }
+
+    return NULL;
+}
+
+// Applies a flush published by the read-ahead thread. Returns false while the
+// published values are being updated, in which case the caller retries later.
+static bool _apply_flush(decoder_t *decoder, unsigned int flushGeneration) {
+    ma_uint64 mark = atomic_load(&decoder->flushMark);
+    ma_uint64 cursor = atomic_load(&decoder->flushCursor);
+
+    if (atomic_load(&decoder->flushGeneration) != flushGeneration) {
+        return false;
+    }
+
+    ma_pcm_rb_seek_read(&decoder->rb, (ma_uint32)(mark - decoder->framesReadTotal));
+
+    decoder->framesReadTotal = mark;
+    decoder->readerGeneration = flushGeneration;
+    atomic_store(&decoder->cursor, cursor);
+
+    return true;
+}
+
+static ma_result _ds_read(ma_data_source *pDataSource,
+                          void *pFramesOut,
+                          ma_uint64 frameCount,
+                          ma_uint64 *pFramesRead) {
+    decoder_t *decoder = (decoder_t *)pDataSource;
+    unsigned int flushGeneration = atomic_load(&decoder->flushGeneration);
+
+    if (pFramesRead) {
+        *pFramesRead = 0;
+    }
+
+    // A seek is pending: stale frames must not be played.
+    if (atomic_load(&decoder->seekGeneration) != flushGeneration) {
+        return MA_BUSY;
+    }
+
+    if (flushGeneration != decoder->readerGeneration &&
+        !_apply_flush(decoder, flushGeneration)) {
+        return MA_BUSY;
+    }
+
+    // Loaded before the ring so frames committed ahead of the flag are seen.
+    bool isAtEnd = atomic_load(&decoder->isAtEnd);
+    ma_uint32 bpf = ma_get_bytes_per_frame((ma_format)decoder->config.pcmFormat,
+                                           decoder->config.channels);
+    ma_uint32 available = ma_pcm_rb_available_read(&decoder->rb);
+    ma_uint64 framesToRead = frameCount < available ? frameCount : available;
+    ma_uint64 framesRead = 0;
+
+    while (framesRead < framesToRead) {
+        ma_uint32 chunkFrames = (ma_uint32)(framesToRead - framesRead);
+        void *pBuffer;
+
+        if (ma_pcm_rb_acquire_read(&decoder->rb, &chunkFrames, &pBuffer) != MA_SUCCESS ||
+            chunkFrames == 0) {
+            break;
+        }
+
+        if (pFramesOut) {
+            memcpy((char *)pFramesOut + framesRead * bpf, pBuffer, (size_t)chunkFrames * bpf);
+        }
+
+        ma_pcm_rb_commit_read(&decoder->rb, chunkFrames);
+        framesRead += chunkFrames;
+    }
+
+    decoder->framesReadTotal += framesRead;
+    atomic_fetch_add(&decoder->cursor, framesRead);
+
+    if (pFramesRead) {
+        *pFramesRead = framesRead;
+    }
+
+    if (isAtEnd && framesRead == available) {
+        return MA_AT_END;
+    }
+
+    // Underrun. MA_BUSY stops `ma_data_source_read_pcm_frames` from retrying.
+    return framesRead == 0 ? MA_BUSY : MA_SUCCESS;
+}
+
+static ma_result _ds_seek(ma_data_source *pDataSource, ma_uint64 frameIndex) {
+    decoder_seek(pDataSource, frameIndex);
+
+    return MA_SUCCESS;
+}
+
+static ma_result _ds_get_data_format(ma_data_source *pDataSource,
+                                     ma_format *pFormat,
+                                     ma_uint32 *pChannels,
+                                     ma_uint32 *pSampleRate,
+                                     ma_channel *pChannelMap,
+                                     size_t channelMapCap) {
+    decoder_t *decoder = (decoder_t *)pDataSource;
+
+    *pFormat = (ma_format)decoder->config.pcmFormat;
+    *pChannels = decoder->config.channels;
+    *pSampleRate = decoder->config.sampleRate;
+    ma_channel_map_init_standard(ma_standard_channel_map_default,
+                                 pChannelMap,
+                                 channelMapCap,
+                                 decoder->config.channels);
+
+    return MA_SUCCESS;
+}
+
+static ma_result _ds_get_cursor(ma_data_source *pDataSource, ma_uint64 *pCursor) {
+    *pCursor = decoder_get_cursor(pDataSource);
+
+    return MA_SUCCESS;
+}
+
+static ma_result _ds_get_length(ma_data_source *pDataSource, ma_uint64 *pLength) {
+    *pLength = ((decoder_t *)pDataSource)->length;
+
+    return *pLength > 0 ? MA_SUCCESS : MA_NOT_IMPLEMENTED;
+}
+
+static ma_data_source_vtable g_decoder_ds_vtable = {
+    _ds_read,
+    _ds_seek,
+    _ds_get_data_format,
+    _ds_get_cursor,
+    _ds_get_length,
+    NULL, /* onSetLooping. Looping is done by the read-ahead thread, see `decoder_set_looping`. */
+    MA_DATA_SOURCE_SELF_MANAGED_RANGE_AND_LOOP_POINT};
+
+FFI_PLUGIN_EXPORT
+void *decoder_create(const char *path, decoder_config_t *pConfig) {
+    if (!path) {
+        LOG_ERROR("invalid parameter: `path` is NULL.\n", "");
+        return NULL;
+    }
+
+    if (!pConfig) {
+        LOG_ERROR("invalid parameter: `pConfig` is NULL.\n", "");
+        return NULL;
+    }
+
+    if (pConfig->channels == 0 || pConfig->sampleRate == 0) {
+        LOG_ERROR("invalid parameter: `pConfig` has no channels or sample rate.\n", "");
+        return NULL;
+    }
+
+    decoder_t *decoder = calloc(1, sizeof(decoder_t));
+
+    if (!decoder) {
+        LOG_ERROR("failed to allocate memory for `decoder_t`.\n", "");
+        return NULL;
+    }
+
+    decoder->config = *pConfig;
+
+    if (decoder->config.lookaheadFrames == 0) {
+        decoder->config.lookaheadFrames =
+            (uint32_t)(pConfig->sampleRate * DECODER_DEFAULT_LOOKAHEAD_SEC);
+    }
+
+    ma_decoder_config decoderConfig =
+        ma_decoder_config_init((ma_format)pConfig->pcmFormat,
+                               pConfig->channels,
+                               pConfig->sampleRate);
+
+    ma_result decoderInitResult =
+        ma_decoder_init_file(path, &decoderConfig, &decoder->decoder);
+
+    if (decoderInitResult != MA_SUCCESS) {
+        free(decoder);
+
+        LOG_ERROR("`ma_decoder_init_file` failed - %s.\n",
+                  ma_result_description(decoderInitResult));
+
+        return NULL;
+    }
+
+    ma_result rbInitResult =
+        ma_pcm_rb_init((ma_format)pConfig->pcmFormat,
+                       pConfig->channels,
+                       decoder->config.lookaheadFrames,
+                       NULL,
+                       NULL,
+                       &decoder->rb);
+
+    if (rbInitResult != MA_SUCCESS) {
+        ma_decoder_uninit(&decoder->decoder);
+        free(decoder);
+
+        LOG_ERROR("`ma_pcm_rb_init` failed - %s.\n",
+                  ma_result_description(rbInitResult));
+
+        return NULL;
+    }
+
+    if (ma_decoder_get_length_in_pcm_frames(&decoder->decoder, &decoder->length) != MA_SUCCESS) {
+        decoder->length = 0;
+    }
+
+    decoder->chunkFrames = decoder->config.lookaheadFrames / DECODER_CHUNK_DIVISOR;
+    if (decoder->chunkFrames == 0) {
+        decoder->chunkFrames = 1;
+    }
+
+    // Wake up twice per slice duration, bounded to keep idle CPU negligible.
+    decoder->waitUs = (ma_uint32)((ma_uint64)decoder->chunkFrames * 500000 / pConfig->sampleRate);
+    if (decoder->waitUs < 1000) {
+        decoder->waitUs = 1000;
+    } else if (decoder->waitUs > 50000) {
+        decoder->waitUs = 50000;
+    }
+
+    ma_data_source_config dsConfig = ma_data_source_config_init();
+    dsConfig.vtable = &g_decoder_ds_vtable;
+    ma_data_source_init(&dsConfig, &decoder->ds);
+
+    pthread_mutex_init(&decoder->mutex, NULL);
+    pthread_cond_init(&decoder->cond, NULL);
+
+    if (pthread_create(&decoder->thread, NULL, _read_ahead_thread, decoder) != 0) {
+        pthread_cond_destroy(&decoder->cond);
+        pthread_mutex_destroy(&decoder->mutex);
+        ma_data_source_uninit(&decoder->ds);
+        ma_pcm_rb_uninit(&decoder->rb);
+        ma_decoder_uninit(&decoder->decoder);
+        free(decoder);
+
+        LOG_ERROR("failed to start the read-ahead thread.\n", "");
+
+        return NULL;
+    }
+
+    LOG_INFO("<%p>(decoder_t) created - format: %s, channels: %u, sample_rate: %u, lookahead: %u frames, length: %llu frames.\n",
+             decoder,
+             describe_ma_format((ma_format)pConfig->pcmFormat),
+             pConfig->channels,
+             pConfig->sampleRate,
+             decoder->config.lookaheadFrames,
+             (unsigned long long)decoder->length);
+
+    return decoder;
+}
+
+FFI_PLUGIN_EXPORT
+void decoder_destroy(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    decoder_t *decoder = (decoder_t *)self;
+
+    atomic_store(&decoder->stop, true);
+    _wake(decoder);
+    pthread_join(decoder->thread, NULL);
+
+    pthread_cond_destroy(&decoder->cond);
+    pthread_mutex_destroy(&decoder->mutex);
+    ma_data_source_uninit(&decoder->ds);
+    ma_pcm_rb_uninit(&decoder->rb);
+    ma_decoder_uninit(&decoder->decoder);
+
+    LOG_INFO("<%p>(decoder_t) destroyed.\n", decoder);
+
+    free(decoder);
+}
+
+FFI_PLUGIN_EXPORT
+void decoder_seek(void *self, uint64_t frameIndex) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    decoder_t *decoder = (decoder_t *)self;
+
+    atomic_store(&decoder->seekTarget, frameIndex);
+    atomic_fetch_add(&decoder->seekGeneration, 1);
+    _wake(decoder);
+}
+
+FFI_PLUGIN_EXPORT
+void decoder_set_looping(void *self, bool isLooping) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    decoder_t *decoder = (decoder_t *)self;
+
+    atomic_store(&decoder->isLooping, isLooping);
+
+    // If the end was already decoded, let the read-ahead thread hit it again
+    // so it rewinds. Frames still buffered are played first.
+    if (isLooping && atomic_exchange(&decoder->isAtEnd, false)) {
+        _wake(decoder);
+    }
+}
+
+FFI_PLUGIN_EXPORT
+uint64_t decoder_get_cursor(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    decoder_t *decoder = (decoder_t *)self;
+    ma_uint64 cursor = atomic_load(&decoder->cursor);
+
+    // Past the end only after looping.
+    return decoder->length > 0 && cursor > decoder->length ? cursor % decoder->length : cursor;
+}
+
+FFI_PLUGIN_EXPORT
+uint64_t decoder_get_length(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    return ((decoder_t *)self)->length;
+}
+
+FFI_PLUGIN_EXPORT
+uint32_t decoder_get_buffered_frames(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    return ma_pcm_rb_available_read(&((decoder_t *)self)->rb);
+}
+
+FFI_PLUGIN_EXPORT
+bool decoder_is_at_end(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    decoder_t *decoder = (decoder_t *)self;
+
+    return atomic_load(&decoder->isAtEnd) &&
+           atomic_load(&decoder->seekGeneration) == atomic_load(&decoder->flushGeneration) &&
+           ma_pcm_rb_available_read(&decoder->rb) == 0;
+}
+
+FFI_PLUGIN_EXPORT
+void decoder_read_pcm_frames_with_buffer(void *self,
+                                         void *pFramesOut,
+                                         uint64_t framesCount,
+                                         uint64_t *pFramesRead) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    if (!pFramesOut) {
+        LOG_ERROR("invalid parameter: `pFramesOut` is NULL.\n", "");
+        return;
+    }
+
+    if (!pFramesRead) {
+        LOG_ERROR("invalid parameter: `pFramesRead` is NULL.\n", "");
+        return;
+    }
+
+    _ds_read(self, pFramesOut, framesCount, (ma_uint64 *)pFramesRead);
+}
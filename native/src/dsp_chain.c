@@ -0,0 +1,558 @@
+#include "../include/dsp_chain.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/internal.h"
+#include "../include/logger.h"
+
+// Heaps are carved out of one block at this alignment.
+#define DSP_CHAIN_HEAP_ALIGNMENT 16
+
+/**
+ * @brief Configuration of the miniaudio processor of a stage.
+ */
+typedef union {
+    ma_biquad_config biquad;
+    ma_lpf_config lpf;
+    ma_hpf_config hpf;
+    ma_bpf_config bpf;
+    ma_notch2_config notch;
+    ma_peak2_config peak;
+    ma_loshelf2_config loshelf;
+    ma_hishelf2_config hishelf;
+    ma_delay_config delay;
+    ma_gainer_config gainer;
+} dsp_node_config_t;
+
+static const char *_describe_type(playback_dsp_type_t type) {
+    switch (type) {
+        case playback_dsp_biquad:
+            return "biquad";
+        case playback_dsp_lowpass:
+            return "lowpass";
+        case playback_dsp_highpass:
+            return "highpass";
+        case playback_dsp_bandpass:
+            return "bandpass";
+        case playback_dsp_notch:
+            return "notch";
+        case playback_dsp_peaking:
+            return "peaking";
+        case playback_dsp_lowshelf:
+            return "lowshelf";
+        case playback_dsp_highshelf:
+            return "highshelf";
+        case playback_dsp_delay:
+            return "delay";
+        case playback_dsp_gain:
+            return "gain";
+    }
+
+    return "unknown";
+}
+
+// Applies the defaults of the fields left at 0.
+static playback_dsp_stage_t _normalize(const playback_dsp_stage_t *pStage) {
+    playback_dsp_stage_t stage = *pStage;
+
+    if (stage.order == 0) {
+        stage.order = 2;
+    }
+
+    if (stage.q == 0.0) {
+        stage.q = stage.type == playback_dsp_lowshelf || stage.type == playback_dsp_highshelf
+                      ? 1.0
+                      : 0.7071067811865476;
+    }
+
+    return stage;
+}
+
+static bool _is_valid(const playback_dsp_stage_t *pStage, uint32_t sampleRate) {
+    switch (pStage->type) {
+        case playback_dsp_biquad:
+            if (pStage->coefficients[3] == 0.0) {
+                LOG_ERROR("biquad `a0` must not be 0.\n", "");
+                return false;
+            }
+            return true;
+        case playback_dsp_lowpass:
+        case playback_dsp_highpass:
+        case playback_dsp_bandpass:
+            if (pStage->order > MA_MAX_FILTER_ORDER ||
+                (pStage->type == playback_dsp_bandpass && (pStage->order & 1) != 0)) {
+                LOG_ERROR("%s order %u is not supported.\n", _describe_type(pStage->type), pStage->order);
+                return false;
+            }
+            break;
+        case playback_dsp_notch:
+        case playback_dsp_peaking:
+        case playback_dsp_lowshelf:
+        case playback_dsp_highshelf:
+            if (!(pStage->q > 0.0)) {
+                LOG_ERROR("%s `q` must be positive, not %f.\n", _describe_type(pStage->type), pStage->q);
+                return false;
+            }
+            break;
+        case playback_dsp_delay:
+            if (pStage->delayFrames == 0 || !(pStage->decay >= 0.0f && pStage->decay < 1.0f)) {
+                LOG_ERROR("delay needs `delayFrames` > 0 and `decay` in [0, 1).\n", "");
+                return false;
+            }
+            return true;
+        case playback_dsp_gain:
+            if (!isfinite(pStage->gainDb)) {
+                LOG_ERROR("gain `gainDb` must be finite.\n", "");
+                return false;
+            }
+            return true;
+        default:
+            LOG_ERROR("unknown DSP stage type %d.\n", pStage->type);
+            return false;
+    }
+
+    if (!(pStage->frequency > 0.0 && pStage->frequency < sampleRate / 2.0)) {
+        LOG_ERROR("%s frequency %f is outside (0, %u).\n",
+                  _describe_type(pStage->type),
+                  pStage->frequency,
+                  sampleRate / 2);
+        return false;
+    }
+
+    return true;
+}
+
+static dsp_node_config_t _node_config(const dsp_chain_t *chain, const playback_dsp_stage_t *pStage) {
+    dsp_node_config_t config;
+    uint32_t channels = chain->channels;
+    uint32_t sampleRate = chain->sampleRate;
+
+    memset(&config, 0, sizeof(config));
+
+    switch (pStage->type) {
+        case playback_dsp_biquad:
+            config.biquad = ma_biquad_config_init(ma_format_f32,
+                                                  channels,
+                                                  pStage->coefficients[0],
+                                                  pStage->coefficients[1],
+                                                  pStage->coefficients[2],
+                                                  pStage->coefficients[3],
+                                                  pStage->coefficients[4],
+                                                  pStage->coefficients[5]);
+            break;
+        case playback_dsp_lowpass:
+            config.lpf = ma_lpf_config_init(ma_format_f32, channels, sampleRate, pStage->frequency, pStage->order);
+            break;
+        case playback_dsp_highpass:
+            config.hpf = ma_hpf_config_init(ma_format_f32, channels, sampleRate, pStage->frequency, pStage->order);
+            break;
+        case playback_dsp_bandpass:
+            config.bpf = ma_bpf_config_init(ma_format_f32, channels, sampleRate, pStage->frequency, pStage->order);
+            break;
+        case playback_dsp_notch:
+            config.notch = ma_notch2_config_init(ma_format_f32, channels, sampleRate, pStage->q, pStage->frequency);
+            break;
+        case playback_dsp_peaking:
+            config.peak = ma_peak2_config_init(ma_format_f32,
+                                               channels,
+                                               sampleRate,
+                                               pStage->gainDb,
+                                               pStage->q,
+                                               pStage->frequency);
+            break;
+        case playback_dsp_lowshelf:
+            config.loshelf = ma_loshelf2_config_init(ma_format_f32,
+                                                     channels,
+                                                     sampleRate,
+                                                     pStage->gainDb,
+                                                     pStage->q,
+                                                     pStage->frequency);
+            break;
+        case playback_dsp_highshelf:
+            config.hishelf = ma_hishelf2_config_init(ma_format_f32,
+                                                     channels,
+                                                     sampleRate,
+                                                     pStage->gainDb,
+                                                     pStage->q,
+                                                     pStage->frequency);
+            break;
+        case playback_dsp_delay:
+            config.delay = ma_delay_config_init(channels, sampleRate, pStage->delayFrames, pStage->decay);
+            config.delay.wet = pStage->wet;
+            config.delay.dry = pStage->dry;
+            break;
+        case playback_dsp_gain:
+            config.gainer = ma_gainer_config_init(channels, pStage->smoothFrames);
+            break;
+    }
+
+    return config;
+}
+
+static size_t _heap_size(const dsp_node_config_t *pConfig, playback_dsp_type_t type) {
+    size_t size = 0;
+
+    switch (type) {
+        case playback_dsp_biquad:
+            ma_biquad_get_heap_size(&pConfig->biquad, &size);
+            break;
+        case playback_dsp_lowpass:
+            ma_lpf_get_heap_size(&pConfig->lpf, &size);
+            break;
+        case playback_dsp_highpass:
+            ma_hpf_get_heap_size(&pConfig->hpf, &size);
+            break;
+        case playback_dsp_bandpass:
+            ma_bpf_get_heap_size(&pConfig->bpf, &size);
+            break;
+        case playback_dsp_notch:
+            ma_notch2_get_heap_size(&pConfig->notch, &size);
+            break;
+        case playback_dsp_peaking:
+            ma_peak2_get_heap_size(&pConfig->peak, &size);
+            break;
+        case playback_dsp_lowshelf:
+            ma_loshelf2_get_heap_size(&pConfig->loshelf, &size);
+            break;
+        case playback_dsp_highshelf:
+            ma_hishelf2_get_heap_size(&pConfig->hishelf, &size);
+            break;
+        case playback_dsp_gain:
+            ma_gainer_get_heap_size(&pConfig->gainer, &size);
+            break;
+        case playback_dsp_delay:
+            // `ma_delay` has no preallocated variant and owns its buffer.
+            break;
+    }
+
+    return (size + DSP_CHAIN_HEAP_ALIGNMENT - 1) & ~(size_t)(DSP_CHAIN_HEAP_ALIGNMENT - 1);
+}
+
+static ma_result _init_node(dsp_stage_t *pStage, const dsp_node_config_t *pConfig, void *pHeap) {
+    switch (pStage->config.type) {
+        case playback_dsp_biquad:
+            return ma_biquad_init_preallocated(&pConfig->biquad, pHeap, &pStage->node.biquad);
+        case playback_dsp_lowpass:
+            return ma_lpf_init_preallocated(&pConfig->lpf, pHeap, &pStage->node.lpf);
+        case playback_dsp_highpass:
+            return ma_hpf_init_preallocated(&pConfig->hpf, pHeap, &pStage->node.hpf);
+        case playback_dsp_bandpass:
+            return ma_bpf_init_preallocated(&pConfig->bpf, pHeap, &pStage->node.bpf);
+        case playback_dsp_notch:
+            return ma_notch2_init_preallocated(&pConfig->notch, pHeap, &pStage->node.notch);
+        case playback_dsp_peaking:
+            return ma_peak2_init_preallocated(&pConfig->peak, pHeap, &pStage->node.peak);
+        case playback_dsp_lowshelf:
+            return ma_loshelf2_init_preallocated(&pConfig->loshelf, pHeap, &pStage->node.loshelf);
+        case playback_dsp_highshelf:
+            return ma_hishelf2_init_preallocated(&pConfig->hishelf, pHeap, &pStage->node.hishelf);
+        case playback_dsp_delay:
+            return ma_delay_init(&pConfig->delay, NULL, &pStage->node.delay);
+        case playback_dsp_gain: {
+            ma_result result = ma_gainer_init_preallocated(&pConfig->gainer, pHeap, &pStage->node.gainer);
+
+            // The first gain is applied without a ramp.
+            if (result == MA_SUCCESS) {
+                result = ma_gainer_set_gain(&pStage->node.gainer, powf(10.0f, (float)pStage->config.gainDb / 20.0f));
+            }
+
+            return result;
+        }
+    }
+
+    return MA_INVALID_ARGS;
+}
+
+// Runs on the audio thread: reconfigures the processor without touching its
+// state or heap.
+static void _apply_update(dsp_chain_t *chain, const dsp_update_t *pUpdate) {
+    dsp_stage_t *pStage = &chain->stages[pUpdate->stageIndex];
+    dsp_node_config_t config = _node_config(chain, &pUpdate->stage);
+
+    switch (pStage->config.type) {
+        case playback_dsp_biquad:
+            ma_biquad_reinit(&config.biquad, &pStage->node.biquad);
+            break;
+        case playback_dsp_lowpass:
+            ma_lpf_reinit(&config.lpf, &pStage->node.lpf);
+            break;
+        case playback_dsp_highpass:
+            ma_hpf_reinit(&config.hpf, &pStage->node.hpf);
+            break;
+        case playback_dsp_bandpass:
+            ma_bpf_reinit(&config.bpf, &pStage->node.bpf);
+            break;
+        case playback_dsp_notch:
+            ma_notch2_reinit(&config.notch, &pStage->node.notch);
+            break;
+        case playback_dsp_peaking:
+            ma_peak2_reinit(&config.peak, &pStage->node.peak);
+            break;
+        case playback_dsp_lowshelf:
+            ma_loshelf2_reinit(&config.loshelf, &pStage->node.loshelf);
+            break;
+        case playback_dsp_highshelf:
+            ma_hishelf2_reinit(&config.hishelf, &pStage->node.hishelf);
+            break;
+        case playback_dsp_delay:
+            ma_delay_set_decay(&pStage->node.delay, pUpdate->stage.decay);
+            ma_delay_set_wet(&pStage->node.delay, pUpdate->stage.wet);
+            ma_delay_set_dry(&pStage->node.delay, pUpdate->stage.dry);
+            break;
+        case playback_dsp_gain:
+            ma_gainer_set_gain(&pStage->node.gainer, powf(10.0f, (float)pUpdate->stage.gainDb / 20.0f));
+            break;
+    }
+
+    pStage->config = pUpdate->stage;
+}
+
+static void _process_f32(dsp_chain_t *chain, float *pFrames, uint32_t frameCount) {
+    for (uint32_t i = 0; i < chain->stageCount; i++) {
+        dsp_stage_t *pStage = &chain->stages[i];
+
+        switch (pStage->config.type) {
+            case playback_dsp_biquad:
+                ma_biquad_process_pcm_frames(&pStage->node.biquad, pFrames, pFrames, frameCount);
+                break;
+            case playback_dsp_lowpass:
+                ma_lpf_process_pcm_frames(&pStage->node.lpf, pFrames, pFrames, frameCount);
+                break;
+            case playback_dsp_highpass:
+                ma_hpf_process_pcm_frames(&pStage->node.hpf, pFrames, pFrames, frameCount);
+                break;
+            case playback_dsp_bandpass:
+                ma_bpf_process_pcm_frames(&pStage->node.bpf, pFrames, pFrames, frameCount);
+                break;
+            case playback_dsp_notch:
+                ma_notch2_process_pcm_frames(&pStage->node.notch, pFrames, pFrames, frameCount);
+                break;
+            case playback_dsp_peaking:
+                ma_peak2_process_pcm_frames(&pStage->node.peak, pFrames, pFrames, frameCount);
+                break;
+            case playback_dsp_lowshelf:
+                ma_loshelf2_process_pcm_frames(&pStage->node.loshelf, pFrames, pFrames, frameCount);
+                break;
+            case playback_dsp_highshelf:
+                ma_hishelf2_process_pcm_frames(&pStage->node.hishelf, pFrames, pFrames, frameCount);
+                break;
+            case playback_dsp_delay:
+                ma_delay_process_pcm_frames(&pStage->node.delay, pFrames, pFrames, frameCount);
+                break;
+            case playback_dsp_gain:
+                ma_gainer_process_pcm_frames(&pStage->node.gainer, pFrames, pFrames, frameCount);
+                break;
+        }
+    }
+}
+
+static void _uninit_stages(dsp_chain_t *chain, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (chain->stages[i].config.type == playback_dsp_delay) {
+            ma_delay_uninit(&chain->stages[i].node.delay, NULL);
+        }
+    }
+}
+
+dsp_chain_t *dsp_chain_create(ma_format format,
+                              uint32_t channels,
+                              uint32_t sampleRate,
+                              const playback_dsp_stage_t *pStages,
+                              uint32_t stageCount) {
+    if (stageCount > PLAYBACK_DSP_MAX_STAGES) {
+        LOG_ERROR("%u DSP stages exceed the maximum of %d.\n", stageCount, PLAYBACK_DSP_MAX_STAGES);
+        return NULL;
+    }
+
+    dsp_chain_t *chain = calloc(1, sizeof(dsp_chain_t));
+
+    if (!chain) {
+        LOG_ERROR("failed to allocate memory for `dsp_chain_t`.\n", "");
+        return NULL;
+    }
+
+    chain->format = format;
+    chain->channels = channels;
+    chain->sampleRate = sampleRate;
+
+    dsp_node_config_t configs[PLAYBACK_DSP_MAX_STAGES];
+    size_t heapSize = 0;
+
+    for (uint32_t i = 0; i < stageCount; i++) {
+        playback_dsp_stage_t stage = _normalize(&pStages[i]);
+
+        if (!_is_valid(&stage, sampleRate)) {
+            free(chain);
+            return NULL;
+        }
+
+        chain->stages[i].config = stage;
+        configs[i] = _node_config(chain, &stage);
+        heapSize += _heap_size(&configs[i], stage.type);
+    }
+
+    if (heapSize > 0) {
+        chain->pHeap = ma_aligned_malloc(heapSize, DSP_CHAIN_HEAP_ALIGNMENT, NULL);
+    }
+
+    if (format != ma_format_f32) {
+        chain->pScratch = malloc((size_t)DSP_CHAIN_SLICE_FRAMES * channels * sizeof(float));
+    }
+
+    if ((heapSize > 0 && !chain->pHeap) || (format != ma_format_f32 && !chain->pScratch)) {
+        LOG_ERROR("failed to allocate memory for the DSP chain.\n", "");
+        ma_aligned_free(chain->pHeap, NULL);
+        free(chain->pScratch);
+        free(chain);
+        return NULL;
+    }
+
+    uint8_t *pHeap = chain->pHeap;
+
+    for (uint32_t i = 0; i < stageCount; i++) {
+        ma_result result = _init_node(&chain->stages[i], &configs[i], pHeap);
+
+        if (result != MA_SUCCESS) {
+            LOG_ERROR("failed to initialize the %s stage - %s.\n",
+                      _describe_type(chain->stages[i].config.type),
+                      ma_result_description(result));
+            _uninit_stages(chain, i);
+            ma_aligned_free(chain->pHeap, NULL);
+            free(chain->pScratch);
+            free(chain);
+            return NULL;
+        }
+
+        pHeap += _heap_size(&configs[i], chain->stages[i].config.type);
+        chain->stageCount = i + 1;
+    }
+
+    ma_result rbResult = ma_rb_init(DSP_CHAIN_QUEUE_UPDATES * sizeof(dsp_update_t), NULL, NULL, &chain->updates);
+
+    if (rbResult != MA_SUCCESS) {
+        LOG_ERROR("`ma_rb_init` failed - %s.\n", ma_result_description(rbResult));
+        _uninit_stages(chain, chain->stageCount);
+        ma_aligned_free(chain->pHeap, NULL);
+        free(chain->pScratch);
+        free(chain);
+        return NULL;
+    }
+
+    LOG_INFO("<%p>(dsp_chain_t) created - %u stage(s), heap: %zu bytes, format: %s.\n",
+             chain,
+             chain->stageCount,
+             heapSize,
+             describe_ma_format(format));
+
+    return chain;
+}
+
+bool dsp_chain_post_update(dsp_chain_t *self, uint32_t stageIndex, const playback_dsp_stage_t *pStage) {
+    if (stageIndex >= self->stageCount) {
+        LOG_ERROR("DSP stage %u out of range, the chain has %u.\n", stageIndex, self->stageCount);
+        return false;
+    }
+
+    const playback_dsp_stage_t *pCurrent = &self->stages[stageIndex].config;
+    dsp_update_t update = {
+        .stageIndex = stageIndex,
+        .stage = _normalize(pStage),
+    };
+
+    if (update.stage.type != pCurrent->type || update.stage.order != pCurrent->order ||
+        update.stage.delayFrames != pCurrent->delayFrames ||
+        update.stage.smoothFrames != pCurrent->smoothFrames) {
+        LOG_ERROR("the type, order, delay and ramp length of DSP stage %u cannot change.\n", stageIndex);
+        return false;
+    }
+
+    if (!_is_valid(&update.stage, self->sampleRate)) {
+        return false;
+    }
+
+    if (ma_rb_available_write(&self->updates) < sizeof(update)) {
+        LOG_WARN("<%p>(dsp_chain_t) update queue full.\n", self);
+        return false;
+    }
+
+    const uint8_t *pData = (const uint8_t *)&update;
+    size_t bytesWritten = 0;
+
+    while (bytesWritten < sizeof(update)) {
+        size_t chunkSize = sizeof(update) - bytesWritten;
+        void *pChunk;
+
+        if (ma_rb_acquire_write(&self->updates, &chunkSize, &pChunk) != MA_SUCCESS || chunkSize == 0) {
+            break;
+        }
+
+        memcpy(pChunk, pData + bytesWritten, chunkSize);
+        ma_rb_commit_write(&self->updates, chunkSize);
+        bytesWritten += chunkSize;
+    }
+
+    return true;
+}
+
+void dsp_chain_process(dsp_chain_t *self, void *pFrames, uint32_t frameCount) {
+    while (ma_rb_available_read(&self->updates) >= sizeof(dsp_update_t)) {
+        dsp_update_t update;
+        uint8_t *pData = (uint8_t *)&update;
+        size_t bytesRead = 0;
+
+        while (bytesRead < sizeof(update)) {
+            size_t chunkSize = sizeof(update) - bytesRead;
+            void *pChunk;
+
+            if (ma_rb_acquire_read(&self->updates, &chunkSize, &pChunk) != MA_SUCCESS || chunkSize == 0) {
+                break;
+            }
+
+            memcpy(pData + bytesRead, pChunk, chunkSize);
+            ma_rb_commit_read(&self->updates, chunkSize);
+            bytesRead += chunkSize;
+        }
+
+        _apply_update(self, &update);
+    }
+
+    if (self->stageCount == 0) {
+        return;
+    }
+
+    if (!self->pScratch) {
+        _process_f32(self, pFrames, frameCount);
+        return;
+    }
+
+    ma_uint32 bpf = ma_get_bytes_per_frame(self->format, self->channels);
+    uint8_t *pData = pFrames;
+    uint32_t framesDone = 0;
+
+    while (framesDone < frameCount) {
+        uint32_t slice = frameCount - framesDone > DSP_CHAIN_SLICE_FRAMES ? DSP_CHAIN_SLICE_FRAMES
+                                                                          : frameCount - framesDone;
+        void *pSlice = pData + (size_t)framesDone * bpf;
+
+        ma_pcm_convert(self->pScratch, ma_format_f32, pSlice, self->format,
+                       (ma_uint64)slice * self->channels, ma_dither_mode_none);
+        _process_f32(self, self->pScratch, slice);
+        ma_pcm_convert(pSlice, self->format, self->pScratch, ma_format_f32,
+                       (ma_uint64)slice * self->channels, ma_dither_mode_none);
+
+        framesDone += slice;
+    }
+}
+
+void dsp_chain_destroy(dsp_chain_t *self) {
+    _uninit_stages(self, self->stageCount);
+    ma_rb_uninit(&self->updates);
+    ma_aligned_free(self->pHeap, NULL);
+    free(self->pScratch);
+
+    LOG_INFO("<%p>(dsp_chain_t) destroyed.\n", self);
+
+    free(self);
+}
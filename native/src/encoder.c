@@ -1,9 +1,561 @@
 #include "../include/encoder.h"
 
+#include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "../include/encoder_private.h"
+#include "../include/ima_adpcm.h"
 #include "../include/logger.h"
 #include "../include/miniaudio.h"
+#include "../include/overview.h"
+#include "../include/overview_private.h"
+
+#define ENCODER_DEFAULT_CHUNK_SIZE (64 * 1024)
+
+// Frames converted per slice for a compact storage format.
+#define ENCODER_SCRATCH_FRAMES 1024
+
+// Size of the IMA ADPCM WAV header: RIFF, `fmt ` with the frames per block
+// extension, `fact` and the `data` chunk header.
+#define ENCODER_ADPCM_HEADER_SIZE 60
+#define ENCODER_ADPCM_FACT_OFFSET 48
+#define ENCODER_ADPCM_DATA_SIZE_OFFSET 56
+
+static encoder_chunk_t* _chunk_alloc(encoder_t* encoder, uint64_t offset) {
+    encoder_chunk_t* chunk = malloc(sizeof(encoder_chunk_t) + encoder->chunkSize);
+
+    if (!chunk) {
+        LOG_ERROR("failed to allocate a %zu bytes encoder chunk.\n", encoder->chunkSize);
+        return NULL;
+    }
+
+    chunk->pNext = NULL;
+    chunk->offset = offset;
+    chunk->size = 0;
+
+    return chunk;
+}
+
+// Hands the chunk being filled to the callback.
+static void _deliver_tail(encoder_t* encoder) {
+    encoder_chunk_t* chunk = encoder->pTail;
+
+    if (!chunk) {
+        return;
+    }
+
+    encoder->pTail = NULL;
+
+    if (chunk->size == 0) {
+        free(chunk);
+        return;
+    }
+
+    encoder->onChunk(encoder->pCallbackUserData, chunk->data, chunk->size, chunk->offset);
+}
+
+// Returns the memory chunk covering `position`, appending one at the end.
+static encoder_chunk_t* _memory_chunk_at(encoder_t* encoder, uint64_t position) {
+    encoder_chunk_t* tail = encoder->pTail;
+
+    if (tail && position >= tail->offset && position < tail->offset + encoder->chunkSize) {
+        return tail;
+    }
+
+    if (position < encoder->size) {
+        // Every chunk but the tail is full, so the index follows from the offset.
+        uint64_t index = position / encoder->chunkSize;
+        encoder_chunk_t* chunk = encoder->pHead;
+
+        while (index-- > 0 && chunk) {
+            chunk = chunk->pNext;
+        }
+
+        return chunk;
+    }
+
+    encoder_chunk_t* chunk = _chunk_alloc(encoder, tail ? tail->offset + encoder->chunkSize : 0);
+
+    if (!chunk) {
+        return NULL;
+    }
+
+    if (tail) {
+        tail->pNext = chunk;
+    } else {
+        encoder->pHead = chunk;
+    }
+
+    encoder->pTail = chunk;
+
+    return chunk;
+}
+
+static ma_result _on_write_memory(encoder_t* encoder,
+                                  const uint8_t* pBuffer,
+                                  size_t bytesToWrite,
+                                  size_t* pBytesWritten) {
+    size_t bytesWritten = 0;
+
+    while (bytesWritten < bytesToWrite) {
+        encoder_chunk_t* chunk = _memory_chunk_at(encoder, encoder->position);
+
+        if (!chunk) {
+            break;
+        }
+
+        size_t inner = (size_t)(encoder->position - chunk->offset);
+        size_t length = encoder->chunkSize - inner;
+
+        if (length > bytesToWrite - bytesWritten) {
+            length = bytesToWrite - bytesWritten;
+        }
+
+        memcpy(chunk->data + inner, pBuffer + bytesWritten, length);
+
+        if (inner + length > chunk->size) {
+            chunk->size = inner + length;
+        }
+
+        bytesWritten += length;
+        encoder->position += length;
+    }
+
+    *pBytesWritten = bytesWritten;
+
+    return bytesWritten == bytesToWrite ? MA_SUCCESS : MA_OUT_OF_MEMORY;
+}
+
+static ma_result _on_write_callback(encoder_t* encoder,
+                                    const uint8_t* pBuffer,
+                                    size_t bytesToWrite,
+                                    size_t* pBytesWritten) {
+    size_t bytesWritten = 0;
+
+    // A seek happened: the pending bytes are complete, start a new chunk.
+    if (encoder->pTail && encoder->position != encoder->pTail->offset + encoder->pTail->size) {
+        _deliver_tail(encoder);
+    }
+
+    while (bytesWritten < bytesToWrite) {
+        if (!encoder->pTail) {
+            encoder->pTail = _chunk_alloc(encoder, encoder->position);
+
+            if (!encoder->pTail) {
+                break;
+            }
+        }
+
+        encoder_chunk_t* chunk = encoder->pTail;
+        size_t length = encoder->chunkSize - chunk->size;
+
+        if (length > bytesToWrite - bytesWritten) {
+            length = bytesToWrite - bytesWritten;
+        }
+
+        memcpy(chunk->data + chunk->size, pBuffer + bytesWritten, length);
+        chunk->size += length;
+        bytesWritten += length;
+        encoder->position += length;
+
+        if (chunk->size == encoder->chunkSize) {
+            _deliver_tail(encoder);
+        }
+    }
+
+    *pBytesWritten = bytesWritten;
+
+    return bytesWritten == bytesToWrite ? MA_SUCCESS : MA_OUT_OF_MEMORY;
+}
+
+static ma_result _on_write_writer(encoder_t* encoder,
+                                  const uint8_t* pBuffer,
+                                  size_t bytesToWrite,
+                                  size_t* pBytesWritten) {
+    size_t bytesWritten = file_writer_write(&encoder->writer, encoder->position, pBuffer, bytesToWrite);
+
+    encoder->position += bytesWritten;
+    *pBytesWritten = bytesWritten;
+
+    return bytesWritten == bytesToWrite ? MA_SUCCESS : MA_IO_ERROR;
+}
+
+static ma_result _on_write_file(encoder_t* encoder,
+                                const uint8_t* pBuffer,
+                                size_t bytesToWrite,
+                                size_t* pBytesWritten) {
+    size_t bytesWritten = fwrite(pBuffer, 1, bytesToWrite, encoder->pFile);
+
+    encoder->position += bytesWritten;
+    *pBytesWritten = bytesWritten;
+
+    return bytesWritten == bytesToWrite ? MA_SUCCESS : MA_IO_ERROR;
+}
+
+static ma_result _sink_write(encoder_t* encoder,
+                             const void* pBufferIn,
+                             size_t bytesToWrite,
+                             size_t* pBytesWritten) {
+    ma_result result;
+
+    switch (encoder->sink) {
+        case encoder_sink_file:
+            result = _on_write_file(encoder, pBufferIn, bytesToWrite, pBytesWritten);
+            break;
+        case encoder_sink_memory:
+            result = _on_write_memory(encoder, pBufferIn, bytesToWrite, pBytesWritten);
+            break;
+        case encoder_sink_writer:
+            result = _on_write_writer(encoder, pBufferIn, bytesToWrite, pBytesWritten);
+            break;
+        default:
+            result = _on_write_callback(encoder, pBufferIn, bytesToWrite, pBytesWritten);
+            break;
+    }
+
+    if (encoder->position > encoder->size) {
+        encoder->size = encoder->position;
+    }
+
+    return result;
+}
+
+static ma_result _sink_seek(encoder_t* encoder, ma_int64 offset, ma_seek_origin origin) {
+    ma_int64 base = 0;
+
+    switch (origin) {
+        case ma_seek_origin_start:
+            base = 0;
+            break;
+        case ma_seek_origin_current:
+            base = (ma_int64)encoder->position;
+            break;
+        case ma_seek_origin_end:
+            base = (ma_int64)encoder->size;
+            break;
+    }
+
+    ma_int64 position = base + offset;
+
+    // The sinks cannot leave holes in the stream.
+    if (position < 0 || (uint64_t)position > encoder->size) {
+        return MA_BAD_SEEK;
+    }
+
+    if (encoder->sink == encoder_sink_file) {
+#if defined(_WIN32)
+        int seekResult = _fseeki64(encoder->pFile, position, SEEK_SET);
+#else
+        int seekResult = fseeko(encoder->pFile, (off_t)position, SEEK_SET);
+#endif
+
+        if (seekResult != 0) {
+            return MA_BAD_SEEK;
+        }
+    }
+
+    encoder->position = (uint64_t)position;
+
+    return MA_SUCCESS;
+}
+
+static ma_result _on_write(ma_encoder* pEncoder,
+                           const void* pBufferIn,
+                           size_t bytesToWrite,
+                           size_t* pBytesWritten) {
+    return _sink_write((encoder_t*)pEncoder->pUserData, pBufferIn, bytesToWrite, pBytesWritten);
+}
+
+static ma_result _on_seek(ma_encoder* pEncoder, ma_int64 offset, ma_seek_origin origin) {
+    return _sink_seek((encoder_t*)pEncoder->pUserData, offset, origin);
+}
+
+static bool _sink_write_all(encoder_t* encoder, const void* pData, size_t size) {
+    size_t bytesWritten = 0;
+
+    return _sink_write(encoder, pData, size, &bytesWritten) == MA_SUCCESS;
+}
+
+static void _put_u16(uint8_t* p, uint32_t value) {
+    p[0] = (uint8_t)(value & 0xFF);
+    p[1] = (uint8_t)((value >> 8) & 0xFF);
+}
+
+static void _put_u32(uint8_t* p, uint32_t value) {
+    _put_u16(p, value & 0xFFFF);
+    _put_u16(p + 2, value >> 16);
+}
+
+static uint32_t _clamp_u32(uint64_t value) {
+    return value > UINT32_MAX ? UINT32_MAX : (uint32_t)value;
+}
+
+static bool _adpcm_write_header(encoder_t* encoder) {
+    encoder_adpcm_t* adpcm = &encoder->adpcm;
+    uint32_t channels = encoder->config.channels;
+    uint8_t header[ENCODER_ADPCM_HEADER_SIZE];
+
+    memcpy(header, "RIFF", 4);
+    _put_u32(header + 4, 0);
+    memcpy(header + 8, "WAVE", 4);
+
+    memcpy(header + 12, "fmt ", 4);
+    _put_u32(header + 16, 20);
+    _put_u16(header + 20, IMA_ADPCM_FORMAT_TAG);
+    _put_u16(header + 22, channels);
+    _put_u32(header + 24, encoder->config.sampleRate);
+    _put_u32(header + 28,
+             (uint32_t)((uint64_t)encoder->config.sampleRate * adpcm->blockAlign / adpcm->framesPerBlock));
+    _put_u16(header + 32, adpcm->blockAlign);
+    _put_u16(header + 34, 4);
+    _put_u16(header + 36, 2);
+    _put_u16(header + 38, adpcm->framesPerBlock);
+
+    memcpy(header + 40, "fact", 4);
+    _put_u32(header + 44, 4);
+    _put_u32(header + ENCODER_ADPCM_FACT_OFFSET, 0);
+
+    memcpy(header + 52, "data", 4);
+    _put_u32(header + ENCODER_ADPCM_DATA_SIZE_OFFSET, 0);
+
+    return _sink_write_all(encoder, header, sizeof(header));
+}
+
+// Encodes the buffered frames and writes the first `size` bytes of the block.
+static bool _adpcm_flush_block(encoder_t* encoder, uint32_t size) {
+    encoder_adpcm_t* adpcm = &encoder->adpcm;
+    uint32_t channels = encoder->config.channels;
+
+    if (adpcm->frameCount <= adpcm->framesPerBlock && adpcm->bufferedFrames > 1) {
+        for (uint32_t c = 0; c < channels; c++) {
+            adpcm->stepIndex[c] = ima_adpcm_step_index_for(adpcm->pFrames[channels + c] - adpcm->pFrames[c]);
+        }
+    }
+
+    ima_adpcm_encode_block(adpcm->pFrames,
+                           channels,
+                           adpcm->blockAlign,
+                           adpcm->stepIndex,
+                           adpcm->pBlock);
+    adpcm->bufferedFrames = 0;
+
+    return _sink_write_all(encoder, adpcm->pBlock, size);
+}
+
+static uint64_t _adpcm_write(encoder_t* encoder, const int16_t* pFrames, uint64_t frameCount) {
+    encoder_adpcm_t* adpcm = &encoder->adpcm;
+    uint32_t channels = encoder->config.channels;
+    uint64_t framesWritten = 0;
+
+    while (framesWritten < frameCount) {
+        uint64_t length = adpcm->framesPerBlock - adpcm->bufferedFrames;
+
+        if (length > frameCount - framesWritten) {
+            length = frameCount - framesWritten;
+        }
+
+        memcpy(adpcm->pFrames + adpcm->bufferedFrames * channels,
+               pFrames + framesWritten * channels,
+               (size_t)length * channels * sizeof(int16_t));
+        adpcm->bufferedFrames += (uint32_t)length;
+        adpcm->frameCount += length;
+        framesWritten += length;
+
+        if (adpcm->bufferedFrames == adpcm->framesPerBlock &&
+            !_adpcm_flush_block(encoder, adpcm->blockAlign)) {
+            LOG_ERROR("<%p>(encoder_t) failed to write an IMA ADPCM block.\n", encoder);
+            break;
+        }
+    }
+
+    return framesWritten;
+}
+
+// Writes the last, padded block and patches the header sizes.
+static void _adpcm_finalize(encoder_t* encoder) {
+    encoder_adpcm_t* adpcm = &encoder->adpcm;
+    uint32_t channels = encoder->config.channels;
+
+    if (adpcm->bufferedFrames > 0) {
+        // The last block is cut after the group of 8 frames holding the last
+        // frame. The few padding frames repeat it, and the `fact` chunk tells
+        // decoders that read it where the audio really ends.
+        uint32_t groups = (adpcm->bufferedFrames - 1 + 7) / 8;
+
+        for (uint32_t frame = adpcm->bufferedFrames; frame < adpcm->framesPerBlock; frame++) {
+            memcpy(adpcm->pFrames + frame * channels,
+                   adpcm->pFrames + (adpcm->bufferedFrames - 1) * channels,
+                   channels * sizeof(int16_t));
+        }
+
+        _adpcm_flush_block(encoder, 4 * channels * (1 + groups));
+    }
+
+    uint64_t size = encoder->size;
+    uint8_t value[4];
+
+    _put_u32(value, _clamp_u32(size - 8));
+    if (_sink_seek(encoder, 4, ma_seek_origin_start) == MA_SUCCESS) {
+        _sink_write_all(encoder, value, 4);
+    }
+
+    _put_u32(value, _clamp_u32(adpcm->frameCount));
+    if (_sink_seek(encoder, ENCODER_ADPCM_FACT_OFFSET, ma_seek_origin_start) == MA_SUCCESS) {
+        _sink_write_all(encoder, value, 4);
+    }
+
+    _put_u32(value, _clamp_u32(size - ENCODER_ADPCM_HEADER_SIZE));
+    if (_sink_seek(encoder, ENCODER_ADPCM_DATA_SIZE_OFFSET, ma_seek_origin_start) == MA_SUCCESS) {
+        _sink_write_all(encoder, value, 4);
+    }
+}
+
+static bool _is_valid_config(encoder_config_t* pConfig) {
+    if (pConfig->storage == encoder_storage_ima_adpcm &&
+        pConfig->channels != 1 && pConfig->channels != 2) {
+        LOG_ERROR("IMA ADPCM supports 1 or 2 channels, got %u.\n", pConfig->channels);
+        return false;
+    }
+
+    return true;
+}
+
+static encoder_t* _create_with_sink(encoder_config_t* pConfig,
+                                    encoder_sink_t sink,
+                                    size_t chunkSizeInBytes) {
+    if (!_is_valid_config(pConfig)) {
+        return NULL;
+    }
+
+    encoder_t* encoder = calloc(1, sizeof(encoder_t));
+
+    if (!encoder) {
+        LOG_ERROR("failed to allocate memory for `encoder_t`.\n", "");
+        return NULL;
+    }
+
+    encoder->config = *pConfig;
+    encoder->sink = sink;
+    encoder->chunkSize = chunkSizeInBytes ? chunkSizeInBytes : ENCODER_DEFAULT_CHUNK_SIZE;
+
+    bool isCompact = pConfig->storage != encoder_storage_pcm;
+
+    if (isCompact && pConfig->pcmFormat != pcm_format_s16) {
+        encoder->pScratch = malloc(ENCODER_SCRATCH_FRAMES * pConfig->channels * sizeof(int16_t));
+
+        if (!encoder->pScratch) {
+            LOG_ERROR("failed to allocate the conversion buffer.\n", "");
+            free(encoder);
+            return NULL;
+        }
+    }
+
+    if (pConfig->storage == encoder_storage_ima_adpcm) {
+        encoder_adpcm_t* adpcm = &encoder->adpcm;
+
+        adpcm->blockAlign = IMA_ADPCM_BLOCK_ALIGN_PER_CHANNEL * pConfig->channels;
+        adpcm->framesPerBlock = ima_adpcm_frames_per_block(adpcm->blockAlign, pConfig->channels);
+        adpcm->pFrames = malloc((size_t)adpcm->framesPerBlock * pConfig->channels * sizeof(int16_t));
+        adpcm->pBlock = malloc(adpcm->blockAlign);
+
+        if (!adpcm->pFrames || !adpcm->pBlock) {
+            LOG_ERROR("failed to allocate the IMA ADPCM buffers.\n", "");
+            free(adpcm->pFrames);
+            free(adpcm->pBlock);
+            free(encoder->pScratch);
+            free(encoder);
+            return NULL;
+        }
+    }
+
+    return encoder;
+}
+
+static ma_encoder_config _ma_config(encoder_config_t* pConfig) {
+    ma_format format = pConfig->storage == encoder_storage_pcm ? (ma_format)pConfig->pcmFormat
+                                                              : ma_format_s16;
+
+    return ma_encoder_config_init(ma_encoding_format_wav,
+                                  format,
+                                  pConfig->channels,
+                                  pConfig->sampleRate);
+}
+
+static const char* _describe_storage(encoder_storage_t storage) {
+    switch (storage) {
+        case encoder_storage_pcm:
+            return "pcm";
+        case encoder_storage_pcm_s16:
+            return "pcm s16";
+        case encoder_storage_ima_adpcm:
+            return "ima adpcm";
+    }
+
+    return "unknown";
+}
+
+static const char* _describe_sink(encoder_sink_t sink) {
+    switch (sink) {
+        case encoder_sink_file:
+            return "file";
+        case encoder_sink_memory:
+            return "memory";
+        case encoder_sink_callback:
+            return "callback";
+        case encoder_sink_writer:
+            return "writer";
+        case encoder_sink_segments:
+            return "segments";
+    }
+
+    return "unknown";
+}
+
+static void* _init_stream(encoder_t* encoder) {
+    if (encoder->config.storage == encoder_storage_ima_adpcm) {
+        if (!_adpcm_write_header(encoder)) {
+            LOG_ERROR("failed to write the IMA ADPCM header.\n", "");
+
+            encoder->isFinalized = true;
+            encoder_destroy(encoder);
+
+            return NULL;
+        }
+
+        LOG_INFO("<%p>(encoder_t) created - sink: %s, storage: %s, chunk size: %zu.\n",
+                 encoder,
+                 _describe_sink(encoder->sink),
+                 _describe_storage(encoder->config.storage),
+                 encoder->chunkSize);
+
+        return encoder;
+    }
+
+    ma_encoder_config encoderConfig = _ma_config(&encoder->config);
+
+    ma_result initEncoderResult =
+        ma_encoder_init(_on_write, _on_seek, encoder, &encoderConfig, &encoder->maEncoder);
+
+    if (initEncoderResult != MA_SUCCESS) {
+        LOG_ERROR("`ma_encoder_init` failed - %s.\n",
+                  ma_result_description(initEncoderResult));
+
+        // The header may already be partially written.
+        encoder->isFinalized = true;
+        encoder_destroy(encoder);
+
+        return NULL;
+    }
+
+    LOG_INFO("<%p>(encoder_t) created - sink: %s, storage: %s, chunk size: %zu.\n",
+             encoder,
+             _describe_sink(encoder->sink),
+             _describe_storage(encoder->config.storage),
+             encoder->chunkSize);
+
+    return encoder;
+}
 
 FFI_PLUGIN_EXPORT
 void* encoder_create(const char* path, encoder_config_t* pConfig) {
@@ -12,35 +564,575 @@ void* encoder_create(const char* path, encoder_config_t* pConfig) {
         return NULL;
     }
 
-    ma_encoder_config encoderConfig =
-        ma_encoder_config_init(ma_encoding_format_wav,
-                               (ma_format)pConfig->pcmFormat,
-                               pConfig->channels,
-                               pConfig->sampleRate);
+    if (!pConfig) {
+        LOG_ERROR("invalid parameter: `pConfig` is NULL.\n", "");
+        return NULL;
+    }
+
+    encoder_t* encoder = _create_with_sink(pConfig, encoder_sink_file, 0);
+
+    if (!encoder) {
+        return NULL;
+    }
+
+    encoder->pFile = fopen(path, "wb");
+
+    if (!encoder->pFile) {
+        LOG_ERROR("failed to open `%s`.\n", path);
+        encoder->isFinalized = true;
+        encoder_destroy(encoder);
+        return NULL;
+    }
+
+    return _init_stream(encoder);
+}
+
+FFI_PLUGIN_EXPORT
+void* encoder_create_segmented(const char* pathPrefix,
+                               encoder_config_t* pConfig,
+                               encoder_segment_config_t* pSegmentConfig,
+                               encoder_segment_callback_t onSegment,
+                               void* pUserData) {
+    if (!pathPrefix) {
+        LOG_ERROR("invalid parameter: `pathPrefix` is NULL.\n", "");
+        return NULL;
+    }
+
+    if (!pConfig) {
+        LOG_ERROR("invalid parameter: `pConfig` is NULL.\n", "");
+        return NULL;
+    }
+
+    if (!pSegmentConfig) {
+        LOG_ERROR("invalid parameter: `pSegmentConfig` is NULL.\n", "");
+        return NULL;
+    }
 
-    encoderConfig.encodingFormat = ma_encoding_format_wav;
+    // Segment encoders do the actual encoding, so this one needs no buffers.
+    encoder_config_t config = *pConfig;
+    config.storage = encoder_storage_pcm;
 
-    ma_encoder* encoder = malloc(sizeof(ma_encoder));
+    encoder_t* encoder = _create_with_sink(&config, encoder_sink_segments, 0);
 
     if (!encoder) {
-        LOG_ERROR("Failed to allocate ma_encoder");
         return NULL;
     }
 
-    ma_result initEncoderResult =
-        ma_encoder_init_file(path,
-                             &encoderConfig,
-                             encoder);
+    encoder->config = *pConfig;
+    encoder->pSegmenter = segmenter_create(pathPrefix, pConfig, pSegmentConfig, onSegment, pUserData);
 
-    if (initEncoderResult != MA_SUCCESS) {
-        LOG_ERROR("Failed to initialize ma_encoder");
+    if (!encoder->pSegmenter) {
         free(encoder);
         return NULL;
     }
 
+    LOG_INFO("<%p>(encoder_t) created - sink: %s, storage: %s.\n",
+             encoder,
+             _describe_sink(encoder->sink),
+             _describe_storage(encoder->config.storage));
+
     return encoder;
 }
 
+FFI_PLUGIN_EXPORT
+void* encoder_create_memory(encoder_config_t* pConfig, size_t chunkSizeInBytes) {
+    if (!pConfig) {
+        LOG_ERROR("invalid parameter: `pConfig` is NULL.\n", "");
+        return NULL;
+    }
+
+    encoder_t* encoder = _create_with_sink(pConfig, encoder_sink_memory, chunkSizeInBytes);
+
+    return encoder ? _init_stream(encoder) : NULL;
+}
+
+FFI_PLUGIN_EXPORT
+void* encoder_create_callback(encoder_config_t* pConfig,
+                              size_t chunkSizeInBytes,
+                              encoder_chunk_callback_t onChunk,
+                              void* pUserData) {
+    if (!pConfig) {
+        LOG_ERROR("invalid parameter: `pConfig` is NULL.\n", "");
+        return NULL;
+    }
+
+    if (!onChunk) {
+        LOG_ERROR("invalid parameter: `onChunk` is NULL.\n", "");
+        return NULL;
+    }
+
+    encoder_t* encoder = _create_with_sink(pConfig, encoder_sink_callback, chunkSizeInBytes);
+
+    if (!encoder) {
+        return NULL;
+    }
+
+    encoder->onChunk = onChunk;
+    encoder->pCallbackUserData = pUserData;
+
+    return _init_stream(encoder);
+}
+
+FFI_PLUGIN_EXPORT
+void* encoder_create_writer(const char* path,
+                            encoder_config_t* pConfig,
+                            encoder_writer_config_t* pWriterConfig) {
+    if (!path) {
+        LOG_ERROR("invalid parameter: `path` is NULL.\n", "");
+        return NULL;
+    }
+
+    if (!pConfig) {
+        LOG_ERROR("invalid parameter: `pConfig` is NULL.\n", "");
+        return NULL;
+    }
+
+    if (!pWriterConfig) {
+        LOG_ERROR("invalid parameter: `pWriterConfig` is NULL.\n", "");
+        return NULL;
+    }
+
+    encoder_t* encoder = _create_with_sink(pConfig, encoder_sink_writer, 0);
+
+    if (!encoder) {
+        return NULL;
+    }
+
+    if (!file_writer_open(&encoder->writer, path, pWriterConfig)) {
+        encoder->isFinalized = true;
+        encoder_destroy(encoder);
+        return NULL;
+    }
+
+    LOG_INFO("<%p>(encoder_t) block writer - block size: %zu, preallocate: %llu, direct I/O: %s.\n",
+             encoder,
+             encoder->writer.config.blockSize,
+             (unsigned long long)encoder->writer.config.preallocateSize,
+             encoder->writer.isDirect ? "yes" : "no");
+
+    return _init_stream(encoder);
+}
+
+FFI_PLUGIN_EXPORT
+bool encoder_get_writer_stats(void* self, encoder_writer_stats_t* pStats) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    if (!pStats) {
+        LOG_ERROR("invalid parameter: `pStats` is NULL.\n", "");
+        return false;
+    }
+
+    encoder_t* encoder = (encoder_t*)self;
+
+    if (encoder->sink != encoder_sink_writer) {
+        LOG_ERROR("<%p>(encoder_t) has no block writer.\n", encoder);
+        return false;
+    }
+
+    file_writer_get_stats(&encoder->writer, pStats);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+bool encoder_set_overview(void* self, void* pOverview, const char* sidecarPath) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    encoder_t* encoder = (encoder_t*)self;
+
+    if (pOverview) {
+        overview_config_t config;
+        overview_get_config(pOverview, &config);
+
+        if (config.pcmFormat != encoder->config.pcmFormat ||
+            config.channels != encoder->config.channels) {
+            LOG_ERROR("<%p>(encoder_t) overview format %d/%u does not match %d/%u.\n",
+                      encoder,
+                      config.pcmFormat,
+                      config.channels,
+                      encoder->config.pcmFormat,
+                      encoder->config.channels);
+            return false;
+        }
+    }
+
+    char* overviewPath = NULL;
+
+    if (pOverview && sidecarPath) {
+        overviewPath = malloc(strlen(sidecarPath) + 1);
+
+        if (!overviewPath) {
+            LOG_ERROR("failed to copy the sidecar path.\n", "");
+            return false;
+        }
+
+        strcpy(overviewPath, sidecarPath);
+    }
+
+    // An encoder may outrun the background thread of the overview.
+    if (pOverview) {
+        overview_set_self_draining((overview_t*)pOverview, true);
+    }
+
+    free(encoder->overviewPath);
+    encoder->pOverview = pOverview;
+    encoder->overviewPath = overviewPath;
+
+    return true;
+}
+
+// Writes frames that are already in the storage sample format.
+static uint64_t _write_encoded(encoder_t* encoder, const void* pFrames, uint64_t frameCount) {
+    if (encoder->config.storage == encoder_storage_ima_adpcm) {
+        return _adpcm_write(encoder, pFrames, frameCount);
+    }
+
+    ma_uint32 bpf = ma_get_bytes_per_frame(encoder->maEncoder.config.format,
+                                           encoder->config.channels);
+    const uint8_t* pData = pFrames;
+    uint64_t framesWritten = 0;
+
+    while (framesWritten < frameCount) {
+        ma_uint64 written = 0;
+
+        ma_encoder_write_pcm_frames(&encoder->maEncoder,
+                                    pData + framesWritten * bpf,
+                                    frameCount - framesWritten,
+                                    &written);
+
+        if (written == 0) {
+            LOG_ERROR("`ma_encoder_write_pcm_frames` wrote no frames, dropping %llu.\n",
+                      (unsigned long long)(frameCount - framesWritten));
+            break;
+        }
+
+        framesWritten += written;
+    }
+
+    return framesWritten;
+}
+
+// Encodes frames through the sink of the encoder. Returns the frames written.
+static uint64_t _write_pcm_frames(encoder_t* encoder, const void* pFrames, uint64_t frameCount) {
+    if (encoder->pSegmenter) {
+        return segmenter_write_pcm_frames(encoder->pSegmenter, pFrames, frameCount);
+    }
+
+    if (!encoder->pScratch) {
+        return _write_encoded(encoder, pFrames, frameCount);
+    }
+
+    // Compact storage: convert to 16-bit in slices first. `ma_pcm_convert`
+    // uses the SSE2/NEON kernels of miniaudio for f32 input.
+    ma_format format = (ma_format)encoder->config.pcmFormat;
+    ma_uint32 bpf = ma_get_bytes_per_frame(format, encoder->config.channels);
+    const uint8_t* pData = pFrames;
+    uint64_t framesWritten = 0;
+
+    while (framesWritten < frameCount) {
+        uint64_t slice = frameCount - framesWritten;
+
+        if (slice > ENCODER_SCRATCH_FRAMES) {
+            slice = ENCODER_SCRATCH_FRAMES;
+        }
+
+        ma_pcm_convert(encoder->pScratch,
+                       ma_format_s16,
+                       pData + framesWritten * bpf,
+                       format,
+                       slice * encoder->config.channels,
+                       ma_dither_mode_none);
+
+        uint64_t written = _write_encoded(encoder, encoder->pScratch, slice);
+        framesWritten += written;
+
+        if (written < slice) {
+            break;
+        }
+    }
+
+    return framesWritten;
+}
+
+FFI_PLUGIN_EXPORT
+uint64_t encoder_write_pcm_frames(void* self, const void* pFrames, uint64_t frameCount) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    encoder_t* encoder = (encoder_t*)self;
+
+    if (encoder->isFinalized) {
+        return 0;
+    }
+
+    if (encoder->pOverview) {
+        overview_write_pcm_frames(encoder->pOverview, pFrames, frameCount);
+    }
+
+    uint64_t framesWritten = _write_pcm_frames(encoder, pFrames, frameCount);
+    encoder->framesWritten += framesWritten;
+
+    return framesWritten;
+}
+
+FFI_PLUGIN_EXPORT
+uint64_t encoder_write_gap(void* self, uint64_t frameCount) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    encoder_t* encoder = (encoder_t*)self;
+
+    if (encoder->isFinalized || frameCount == 0) {
+        return 0;
+    }
+
+    // Consecutive silent blocks make one gap, so the list grows once per
+    // silent stretch, not once per block.
+    bool isMerged = encoder->gapCount > 0 &&
+                    encoder->gaps[encoder->gapCount - 1].position == encoder->framesWritten;
+
+    if (!isMerged && encoder->gapCount == ENCODER_MAX_GAPS) {
+        return 0;
+    }
+
+    // Each segment lists the gaps that fall into it.
+    if (encoder->pSegmenter && segmenter_write_gap(encoder->pSegmenter, frameCount) == 0) {
+        return 0;
+    }
+
+    unsigned int sequence = atomic_load_explicit(&encoder->gapSequence, memory_order_relaxed);
+    atomic_store_explicit(&encoder->gapSequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    if (isMerged) {
+        encoder->gaps[encoder->gapCount - 1].frameCount += frameCount;
+    } else {
+        encoder->gaps[encoder->gapCount].position = encoder->framesWritten;
+        encoder->gaps[encoder->gapCount].frameCount = frameCount;
+        encoder->gapCount++;
+    }
+
+    atomic_store_explicit(&encoder->gapSequence, sequence + 2, memory_order_release);
+
+    return frameCount;
+}
+
+FFI_PLUGIN_EXPORT
+uint32_t encoder_get_gaps(void* self, encoder_gap_t* pGaps, uint32_t capacity) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    encoder_t* encoder = (encoder_t*)self;
+    uint32_t gapCount;
+    unsigned int sequence;
+
+    // The writing thread never waits for readers: copy, then start over if
+    // it changed the list meanwhile.
+    do {
+        sequence = atomic_load_explicit(&encoder->gapSequence, memory_order_acquire);
+
+        if (sequence & 1) {
+            continue;
+        }
+
+        gapCount = encoder->gapCount;
+
+        if (pGaps) {
+            uint32_t count = gapCount < capacity ? gapCount : capacity;
+            memcpy(pGaps, encoder->gaps, count * sizeof(encoder_gap_t));
+        }
+
+        atomic_thread_fence(memory_order_acquire);
+    } while ((sequence & 1) || atomic_load_explicit(&encoder->gapSequence, memory_order_relaxed) != sequence);
+
+    return gapCount;
+}
+
+// Appends the gaps after the `data` chunk: a `cue ` point at each gap and a
+// `ltxt` region of its length, then updates the RIFF size. Runs once the
+// header is complete.
+static void _write_gap_chunks(encoder_t* encoder) {
+    uint32_t count = encoder->gapCount;
+
+    if (count == 0 || _sink_seek(encoder, 0, ma_seek_origin_end) != MA_SUCCESS) {
+        return;
+    }
+
+    uint8_t header[12];
+    uint8_t entry[28];
+
+    memcpy(header, "cue ", 4);
+    _put_u32(header + 4, 4 + 24 * count);
+    _put_u32(header + 8, count);
+
+    if (!_sink_write_all(encoder, header, 12)) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t position = _clamp_u32(encoder->gaps[i].position);
+
+        memset(entry, 0, sizeof(entry));
+        _put_u32(entry, i + 1);
+        _put_u32(entry + 4, position);
+        memcpy(entry + 8, "data", 4);
+        _put_u32(entry + 20, position);
+
+        if (!_sink_write_all(encoder, entry, 24)) {
+            return;
+        }
+    }
+
+    memcpy(header, "LIST", 4);
+    _put_u32(header + 4, 4 + 28 * count);
+    memcpy(header + 8, "adtl", 4);
+
+    if (!_sink_write_all(encoder, header, 12)) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        memset(entry, 0, sizeof(entry));
+        memcpy(entry, "ltxt", 4);
+        _put_u32(entry + 4, 20);
+        _put_u32(entry + 8, i + 1);
+        _put_u32(entry + 12, _clamp_u32(encoder->gaps[i].frameCount));
+        memcpy(entry + 16, "rgn ", 4);
+
+        if (!_sink_write_all(encoder, entry, 28)) {
+            return;
+        }
+    }
+
+    uint8_t value[4];
+    _put_u32(value, _clamp_u32(encoder->size - 8));
+
+    if (_sink_seek(encoder, 4, ma_seek_origin_start) == MA_SUCCESS) {
+        _sink_write_all(encoder, value, 4);
+    }
+}
+
+FFI_PLUGIN_EXPORT
+void encoder_finalize(void* self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    encoder_t* encoder = (encoder_t*)self;
+
+    if (encoder->isFinalized) {
+        return;
+    }
+
+    // Patches the header through `_on_seek`/`_on_write`.
+    if (encoder->pSegmenter) {
+        segmenter_finalize(encoder->pSegmenter);
+    } else if (encoder->config.storage == encoder_storage_ima_adpcm) {
+        _adpcm_finalize(encoder);
+    } else {
+        ma_encoder_uninit(&encoder->maEncoder);
+    }
+
+    if (!encoder->pSegmenter) {
+        _write_gap_chunks(encoder);
+    }
+
+    encoder->isFinalized = true;
+
+    if (encoder->pOverview) {
+        overview_finish(encoder->pOverview);
+
+        if (encoder->overviewPath) {
+            overview_save(encoder->pOverview, encoder->overviewPath);
+        }
+    }
+
+    if (encoder->sink == encoder_sink_callback) {
+        _deliver_tail(encoder);
+        encoder->onChunk(encoder->pCallbackUserData, NULL, 0, encoder->size);
+    }
+
+    if (encoder->sink == encoder_sink_writer) {
+        file_writer_close(&encoder->writer);
+    }
+
+    if (encoder->pFile) {
+        fclose(encoder->pFile);
+        encoder->pFile = NULL;
+    }
+}
+
+FFI_PLUGIN_EXPORT
+uint64_t encoder_get_size_in_bytes(void* self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    encoder_t* encoder = (encoder_t*)self;
+
+    return encoder->pSegmenter ? segmenter_get_size_in_bytes(encoder->pSegmenter) : encoder->size;
+}
+
+FFI_PLUGIN_EXPORT
+void* encoder_take_chunk(void* self, size_t* pSizeInBytes) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return NULL;
+    }
+
+    if (!pSizeInBytes) {
+        LOG_ERROR("invalid parameter: `pSizeInBytes` is NULL.\n", "");
+        return NULL;
+    }
+
+    encoder_t* encoder = (encoder_t*)self;
+
+    if (encoder->sink != encoder_sink_memory || !encoder->isFinalized) {
+        LOG_ERROR("chunks can only be taken from a finalized memory encoder.\n", "");
+        return NULL;
+    }
+
+    encoder_chunk_t* chunk = encoder->pHead;
+
+    if (!chunk) {
+        *pSizeInBytes = 0;
+        return NULL;
+    }
+
+    encoder->pHead = chunk->pNext;
+
+    if (!encoder->pHead) {
+        encoder->pTail = NULL;
+    }
+
+    *pSizeInBytes = chunk->size;
+
+    return chunk->data;
+}
+
+FFI_PLUGIN_EXPORT
+void encoder_free_chunk(void* pData) {
+    if (!pData) {
+        return;
+    }
+
+    free((uint8_t*)pData - offsetof(encoder_chunk_t, data));
+}
+
 FFI_PLUGIN_EXPORT
 void encoder_destroy(void* self) {
     if (!self) {
@@ -48,8 +1140,34 @@ void encoder_destroy(void* self) {
         return;
     }
 
-    ma_encoder* encoder = (ma_encoder*)self;
-    ma_encoder_uninit(encoder);
+    encoder_t* encoder = (encoder_t*)self;
+
+    encoder_finalize(encoder);
+
+    // Also covers encoders that failed to initialize.
+    if (encoder->sink == encoder_sink_writer) {
+        file_writer_close(&encoder->writer);
+    }
+
+    if (encoder->pFile) {
+        fclose(encoder->pFile);
+    }
+
+    encoder_chunk_t* chunk = encoder->sink == encoder_sink_memory ? encoder->pHead : encoder->pTail;
+
+    while (chunk) {
+        encoder_chunk_t* next = chunk->pNext;
+        free(chunk);
+        chunk = next;
+    }
+
+    if (encoder->pSegmenter) {
+        segmenter_destroy(encoder->pSegmenter);
+    }
 
+    free(encoder->overviewPath);
+    free(encoder->pScratch);
+    free(encoder->adpcm.pFrames);
+    free(encoder->adpcm.pBlock);
     free(encoder);
 }
@@ -0,0 +1,185 @@
+#include "../include/event_channel.h"
+
+#include <time.h>
+
+#include "../include/logger.h"
+
+// Polling period of the dispatcher, in milliseconds. Producers run on the audio
+// thread and never signal, since waking a sleeper is a system call; the period
+// bounds how late an event is delivered.
+#define EVENT_CHANNEL_WAIT_MS 10
+
+void event_channel_init(event_channel_t *self) {
+    for (size_t i = 0; i < EVENT_CHANNEL_CAPACITY; i++) {
+        atomic_init(&self->cells[i].sequence, i);
+    }
+
+    atomic_init(&self->enqueuePos, 0);
+    self->dequeuePos = 0;
+    atomic_init(&self->droppedEvents, 0);
+
+    self->onEvent = NULL;
+    self->pUserData = NULL;
+
+    pthread_mutex_init(&self->mutex, NULL);
+    pthread_cond_init(&self->cond, NULL);
+    atomic_init(&self->isRunning, false);
+    atomic_init(&self->stop, false);
+}
+
+bool event_channel_post(event_channel_t *self,
+                        playback_event_type_t type,
+                        device_state_t state,
+                        uint32_t availableBytes) {
+    if (!atomic_load_explicit(&self->isRunning, memory_order_acquire)) {
+        return false;
+    }
+
+    size_t pos = atomic_load_explicit(&self->enqueuePos, memory_order_relaxed);
+    event_channel_cell_t *cell;
+
+    for (;;) {
+        cell = &self->cells[pos & (EVENT_CHANNEL_CAPACITY - 1)];
+
+        size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&self->enqueuePos,
+                                                      &pos,
+                                                      pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The dispatcher has not consumed this slot yet: the queue is full.
+            atomic_fetch_add_explicit(&self->droppedEvents, 1, memory_order_relaxed);
+            return false;
+        } else {
+            pos = atomic_load_explicit(&self->enqueuePos, memory_order_relaxed);
+        }
+    }
+
+    cell->event.type = type;
+    cell->event.state = state;
+    cell->event.availableBytes = availableBytes;
+    atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+
+    return true;
+}
+
+// Pops the oldest event. Only called by the dispatcher.
+static bool _take(event_channel_t *self, event_channel_event_t *pEvent) {
+    event_channel_cell_t *cell = &self->cells[self->dequeuePos & (EVENT_CHANNEL_CAPACITY - 1)];
+    size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+
+    if (sequence != self->dequeuePos + 1) {
+        return false;
+    }
+
+    *pEvent = cell->event;
+    atomic_store_explicit(&cell->sequence,
+                          self->dequeuePos + EVENT_CHANNEL_CAPACITY,
+                          memory_order_release);
+    self->dequeuePos++;
+
+    return true;
+}
+
+static bool _is_empty(event_channel_t *self) {
+    event_channel_cell_t *cell = &self->cells[self->dequeuePos & (EVENT_CHANNEL_CAPACITY - 1)];
+
+    return atomic_load_explicit(&cell->sequence, memory_order_acquire) != self->dequeuePos + 1;
+}
+
+static void _dispatch(event_channel_t *self) {
+    event_channel_event_t event;
+
+    while (_take(self, &event)) {
+        self->onEvent(self->pUserData, event.type, event.state, event.availableBytes);
+    }
+
+    unsigned int dropped = atomic_exchange(&self->droppedEvents, 0);
+
+    if (dropped) {
+        LOG_WARN("<%p>(event_channel_t) %u event(s) dropped, the queue was full.\n", self, dropped);
+    }
+}
+
+static void _wait(event_channel_t *self) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+
+    deadline.tv_nsec += EVENT_CHANNEL_WAIT_MS * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&self->mutex);
+
+    if (!atomic_load(&self->stop) && _is_empty(self)) {
+        pthread_cond_timedwait(&self->cond, &self->mutex, &deadline);
+    }
+
+    pthread_mutex_unlock(&self->mutex);
+}
+
+static void *_dispatcher_thread(void *pUserData) {
+    event_channel_t *self = pUserData;
+
+    while (!atomic_load(&self->stop)) {
+        _dispatch(self);
+        _wait(self);
+    }
+
+    _dispatch(self);
+    self->onEvent(self->pUserData, playback_event_closed, device_state_uninitialized, 0);
+
+    return NULL;
+}
+
+bool event_channel_start(event_channel_t *self, playback_event_callback_t onEvent, void *pUserData) {
+    self->onEvent = onEvent;
+    self->pUserData = pUserData;
+    atomic_store(&self->stop, false);
+
+    if (pthread_create(&self->thread, NULL, _dispatcher_thread, self) != 0) {
+        LOG_ERROR("failed to start the event dispatcher thread.\n", "");
+        self->onEvent = NULL;
+        self->pUserData = NULL;
+        return false;
+    }
+
+    atomic_store_explicit(&self->isRunning, true, memory_order_release);
+
+    LOG_INFO("<%p>(event_channel_t) started.\n", self);
+
+    return true;
+}
+
+void event_channel_stop(event_channel_t *self) {
+    if (!atomic_exchange(&self->isRunning, false)) {
+        return;
+    }
+
+    pthread_mutex_lock(&self->mutex);
+    atomic_store(&self->stop, true);
+    pthread_cond_signal(&self->cond);
+    pthread_mutex_unlock(&self->mutex);
+
+    pthread_join(self->thread, NULL);
+
+    self->onEvent = NULL;
+    self->pUserData = NULL;
+
+    LOG_INFO("<%p>(event_channel_t) stopped.\n", self);
+}
+
+void event_channel_uninit(event_channel_t *self) {
+    event_channel_stop(self);
+
+    pthread_cond_destroy(&self->cond);
+    pthread_mutex_destroy(&self->mutex);
+}
@@ -0,0 +1,494 @@
+#if defined(__linux__)
+    // For `O_DIRECT` and `fallocate`.
+    #define _GNU_SOURCE
+#endif
+
+#include "../include/file_writer.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if !defined(_WIN32)
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
+#include "../include/logger.h"
+
+#define FILE_WRITER_DEFAULT_BLOCK_SIZE (1024 * 1024)
+#define FILE_WRITER_WAIT_MS 10
+
+#if !defined(_WIN32)
+
+static uint64_t _now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+// Counts a system call that started at `startNs`.
+static void _account(file_writer_t *writer, _Atomic(uint64_t) *pCalls, uint64_t startNs) {
+    atomic_fetch_add_explicit(pCalls, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&writer->ioNanoseconds, _now_ns() - startNs, memory_order_relaxed);
+}
+
+static bool _sync(file_writer_t *writer) {
+    uint64_t start = _now_ns();
+
+    #if defined(__APPLE__)
+    int result = fsync(writer->fd);
+    #else
+    int result = fdatasync(writer->fd);
+    #endif
+
+    _account(writer, &writer->syncCalls, start);
+    writer->bytesSinceSync = 0;
+
+    if (result != 0) {
+        LOG_ERROR("sync failed - %s.\n", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+// Reserves the extent up to `end` plus `preallocateSize`, so the file grows in
+// a few large contiguous steps instead of one allocation per write.
+static void _preallocate(file_writer_t *writer, uint64_t end) {
+    if (writer->config.preallocateSize == 0 || end <= writer->preallocatedEnd) {
+        return;
+    }
+
+    uint64_t newEnd = end + writer->config.preallocateSize;
+    uint64_t start = _now_ns();
+
+    #if defined(__linux__)
+    int result = fallocate(writer->fd,
+                           FALLOC_FL_KEEP_SIZE,
+                           (off_t)writer->preallocatedEnd,
+                           (off_t)(newEnd - writer->preallocatedEnd));
+    #elif defined(__APPLE__)
+    fstore_t store = {F_ALLOCATEALL, F_PEOFPOSMODE, 0, (off_t)(newEnd - writer->preallocatedEnd), 0};
+    int result = fcntl(writer->fd, F_PREALLOCATE, &store);
+    #else
+    int result = -1;
+    errno = ENOTSUP;
+    #endif
+
+    _account(writer, &writer->preallocateCalls, start);
+
+    if (result != 0) {
+        // Not every file system supports it; writing still works without.
+        LOG_WARN("preallocation failed, disabling it - %s.\n", strerror(errno));
+        writer->config.preallocateSize = 0;
+        return;
+    }
+
+    writer->preallocatedEnd = newEnd;
+}
+
+// Writes a handed over block. Runs on the background thread.
+static bool _write_block(file_writer_t *writer, file_writer_block_t *pBlock) {
+    size_t length = pBlock->blockFill;
+
+    if (writer->isDirect) {
+        // Direct writes must cover whole aligned sectors; the padding past the
+        // end of the file is truncated on close.
+        size_t aligned = (length + FILE_WRITER_ALIGNMENT - 1) / FILE_WRITER_ALIGNMENT * FILE_WRITER_ALIGNMENT;
+        memset(pBlock->pData + length, 0, aligned - length);
+        length = aligned;
+    }
+
+    _preallocate(writer, pBlock->blockOffset + length);
+
+    size_t written = 0;
+
+    while (written < length) {
+        uint64_t start = _now_ns();
+        ssize_t result = pwrite(writer->fd,
+                                pBlock->pData + written,
+                                length - written,
+                                (off_t)(pBlock->blockOffset + written));
+        _account(writer, &writer->writeCalls, start);
+
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            LOG_ERROR("write of %zu bytes at %llu failed - %s.\n",
+                      length - written,
+                      (unsigned long long)(pBlock->blockOffset + written),
+                      strerror(errno));
+            return false;
+        }
+
+        written += (size_t)result;
+    }
+
+    atomic_fetch_add_explicit(&writer->bytesWritten, length, memory_order_relaxed);
+    writer->bytesSinceSync += length;
+
+    if (writer->config.fsyncPolicy == encoder_fsync_interval &&
+        writer->bytesSinceSync >= writer->config.fsyncIntervalBytes) {
+        _sync(writer);
+    }
+
+    return true;
+}
+
+// Writes every block handed over so far and wakes `_drain`.
+static void _write_queued(file_writer_t *writer) {
+    uint64_t completed = atomic_load_explicit(&writer->completed, memory_order_relaxed);
+    uint64_t submitted = atomic_load_explicit(&writer->submitted, memory_order_acquire);
+
+    for (; completed < submitted; completed++) {
+        if (!_write_block(writer, &writer->pBlocks[completed % writer->blockCount])) {
+            atomic_store(&writer->hasFailed, true);
+        }
+
+        atomic_store_explicit(&writer->completed, completed + 1, memory_order_release);
+    }
+
+    pthread_mutex_lock(&writer->mutex);
+    pthread_cond_broadcast(&writer->drained);
+    pthread_mutex_unlock(&writer->mutex);
+}
+
+static void _wait(file_writer_t *writer) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+
+    deadline.tv_nsec += FILE_WRITER_WAIT_MS * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&writer->mutex);
+
+    if (!atomic_load(&writer->stop) &&
+        atomic_load(&writer->submitted) == atomic_load(&writer->completed)) {
+        pthread_cond_timedwait(&writer->cond, &writer->mutex, &deadline);
+    }
+
+    pthread_mutex_unlock(&writer->mutex);
+}
+
+static void *_writer_thread(void *pUserData) {
+    file_writer_t *writer = pUserData;
+    unsigned int reportedOverruns = 0;
+
+    while (!atomic_load(&writer->stop)) {
+        _write_queued(writer);
+
+        unsigned int overruns = atomic_load_explicit(&writer->overruns, memory_order_relaxed);
+
+        if (overruns != reportedOverruns) {
+            LOG_WARN("<%p>(file_writer_t) every block was queued %u time(s), data was dropped.\n",
+                     writer,
+                     overruns - reportedOverruns);
+            reportedOverruns = overruns;
+        }
+
+        _wait(writer);
+    }
+
+    _write_queued(writer);
+
+    return NULL;
+}
+
+// Waits until the background thread wrote every block handed over.
+static void _drain(file_writer_t *writer) {
+    pthread_mutex_lock(&writer->mutex);
+
+    while (atomic_load_explicit(&writer->completed, memory_order_acquire) !=
+           atomic_load_explicit(&writer->submitted, memory_order_relaxed)) {
+        pthread_cond_signal(&writer->cond);
+        pthread_cond_wait(&writer->drained, &writer->mutex);
+    }
+
+    pthread_mutex_unlock(&writer->mutex);
+}
+
+// Hands the current block to the background thread without waiting for it.
+static void _submit(file_writer_t *writer) {
+    if (writer->isBlockDirty) {
+        atomic_fetch_add_explicit(&writer->submitted, 1, memory_order_release);
+        writer->isBlockDirty = false;
+    }
+
+    writer->pCurrent = NULL;
+}
+
+// Makes the current block map to the block at `blockOffset`, reading back the
+// part that is already in the file. Returns `false` if no block is free or the
+// read failed.
+static bool _load_block(file_writer_t *writer, uint64_t blockOffset) {
+    _submit(writer);
+
+    if (blockOffset < writer->fileSize) {
+        // Only rewrites get here, never the append path of the audio thread.
+        _drain(writer);
+    }
+
+    uint64_t submitted = atomic_load_explicit(&writer->submitted, memory_order_relaxed);
+
+    if (submitted - atomic_load_explicit(&writer->completed, memory_order_acquire) >= writer->blockCount) {
+        atomic_fetch_add_explicit(&writer->overruns, 1, memory_order_relaxed);
+        return false;
+    }
+
+    file_writer_block_t *pBlock = &writer->pBlocks[submitted % writer->blockCount];
+    pBlock->blockOffset = blockOffset;
+    pBlock->blockFill = 0;
+    writer->pCurrent = pBlock;
+
+    if (blockOffset >= writer->fileSize) {
+        return true;
+    }
+
+    uint64_t available = writer->fileSize - blockOffset;
+    size_t expected = available < writer->config.blockSize ? (size_t)available : writer->config.blockSize;
+
+    while (pBlock->blockFill < expected) {
+        uint64_t start = _now_ns();
+        ssize_t result = pread(writer->fd,
+                               pBlock->pData + pBlock->blockFill,
+                               writer->config.blockSize - pBlock->blockFill,
+                               (off_t)(blockOffset + pBlock->blockFill));
+        _account(writer, &writer->readCalls, start);
+
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (result <= 0) {
+            LOG_ERROR("read back of the block at %llu failed - %s.\n",
+                      (unsigned long long)blockOffset,
+                      result < 0 ? strerror(errno) : "end of file");
+            writer->pCurrent = NULL;
+            return false;
+        }
+
+        pBlock->blockFill += (size_t)result;
+    }
+
+    pBlock->blockFill = expected;
+
+    return true;
+}
+
+bool file_writer_open(file_writer_t *self, const char *path, const encoder_writer_config_t *pConfig) {
+    memset(self, 0, sizeof(file_writer_t));
+    self->fd = -1;
+    self->config = *pConfig;
+
+    size_t blockSize = pConfig->blockSize ? pConfig->blockSize : FILE_WRITER_DEFAULT_BLOCK_SIZE;
+    self->config.blockSize = (blockSize + FILE_WRITER_ALIGNMENT - 1) / FILE_WRITER_ALIGNMENT * FILE_WRITER_ALIGNMENT;
+
+    size_t blockCount = (FILE_WRITER_QUEUE_BYTES + self->config.blockSize - 1) / self->config.blockSize;
+    self->blockCount = blockCount < FILE_WRITER_MIN_QUEUE_BLOCKS ? FILE_WRITER_MIN_QUEUE_BLOCKS : (uint32_t)blockCount;
+
+    int flags = O_RDWR | O_CREAT | O_TRUNC;
+
+    #if defined(O_DIRECT)
+    if (pConfig->useDirectIo) {
+        self->fd = open(path, flags | O_DIRECT, 0644);
+        self->isDirect = self->fd >= 0;
+
+        if (!self->isDirect && errno == EINVAL) {
+            LOG_WARN("direct I/O is not supported for `%s`, using buffered writes.\n", path);
+        }
+    }
+    #endif
+
+    if (self->fd < 0) {
+        self->fd = open(path, flags, 0644);
+    }
+
+    if (self->fd < 0) {
+        LOG_ERROR("failed to open `%s` - %s.\n", path, strerror(errno));
+        return false;
+    }
+
+    #if defined(__APPLE__)
+    if (pConfig->useDirectIo) {
+        self->isDirect = fcntl(self->fd, F_NOCACHE, 1) == 0;
+    }
+    #endif
+
+    void *pStorage = NULL;
+    size_t storageSize = (size_t)self->blockCount * self->config.blockSize;
+
+    self->pBlocks = calloc(self->blockCount, sizeof(file_writer_block_t));
+
+    if (self->pBlocks == NULL || posix_memalign(&pStorage, FILE_WRITER_ALIGNMENT, storageSize) != 0) {
+        LOG_ERROR("failed to allocate %u write blocks of %zu bytes.\n", self->blockCount, self->config.blockSize);
+        free(self->pBlocks);
+        self->pBlocks = NULL;
+        close(self->fd);
+        self->fd = -1;
+        return false;
+    }
+
+    self->pStorage = pStorage;
+
+    for (uint32_t i = 0; i < self->blockCount; i++) {
+        self->pBlocks[i].pData = self->pStorage + (size_t)i * self->config.blockSize;
+    }
+
+    pthread_mutex_init(&self->mutex, NULL);
+    pthread_cond_init(&self->cond, NULL);
+    pthread_cond_init(&self->drained, NULL);
+
+    if (pthread_create(&self->thread, NULL, _writer_thread, self) != 0) {
+        LOG_ERROR("failed to start the writer thread.\n", "");
+        pthread_cond_destroy(&self->drained);
+        pthread_cond_destroy(&self->cond);
+        pthread_mutex_destroy(&self->mutex);
+        free(self->pStorage);
+        self->pStorage = NULL;
+        free(self->pBlocks);
+        self->pBlocks = NULL;
+        close(self->fd);
+        self->fd = -1;
+        return false;
+    }
+
+    return true;
+}
+
+size_t file_writer_write(file_writer_t *self, uint64_t offset, const void *pData, size_t size) {
+    const uint8_t *pBytes = pData;
+    size_t blockSize = self->config.blockSize;
+    size_t written = 0;
+
+    while (written < size) {
+        uint64_t position = offset + written;
+        uint64_t blockOffset = position - position % blockSize;
+
+        if ((self->pCurrent == NULL || self->pCurrent->blockOffset != blockOffset) &&
+            !_load_block(self, blockOffset)) {
+            break;
+        }
+
+        file_writer_block_t *pBlock = self->pCurrent;
+        size_t inner = (size_t)(position - blockOffset);
+        size_t length = blockSize - inner;
+
+        if (length > size - written) {
+            length = size - written;
+        }
+
+        memcpy(pBlock->pData + inner, pBytes + written, length);
+        self->isBlockDirty = true;
+        written += length;
+
+        if (inner + length > pBlock->blockFill) {
+            pBlock->blockFill = inner + length;
+        }
+
+        if (blockOffset + pBlock->blockFill > self->fileSize) {
+            self->fileSize = blockOffset + pBlock->blockFill;
+        }
+
+        if (pBlock->blockFill == blockSize) {
+            _submit(self);
+        }
+    }
+
+    return written;
+}
+
+bool file_writer_close(file_writer_t *self) {
+    if (self->fd < 0) {
+        return true;
+    }
+
+    _submit(self);
+
+    pthread_mutex_lock(&self->mutex);
+    atomic_store(&self->stop, true);
+    pthread_cond_signal(&self->cond);
+    pthread_mutex_unlock(&self->mutex);
+
+    // The thread writes what is still queued before it exits.
+    pthread_join(self->thread, NULL);
+
+    pthread_cond_destroy(&self->drained);
+    pthread_cond_destroy(&self->cond);
+    pthread_mutex_destroy(&self->mutex);
+
+    bool isComplete = !atomic_load(&self->hasFailed);
+
+    // Drops the alignment padding and the preallocated extent that was not used.
+    if (ftruncate(self->fd, (off_t)self->fileSize) != 0) {
+        LOG_ERROR("failed to truncate the file to %llu bytes - %s.\n",
+                  (unsigned long long)self->fileSize,
+                  strerror(errno));
+        isComplete = false;
+    }
+
+    if (self->config.fsyncPolicy != encoder_fsync_never && !_sync(self)) {
+        isComplete = false;
+    }
+
+    close(self->fd);
+    self->fd = -1;
+
+    free(self->pStorage);
+    self->pStorage = NULL;
+    free(self->pBlocks);
+    self->pBlocks = NULL;
+
+    return isComplete;
+}
+
+#else
+
+bool file_writer_open(file_writer_t *self, const char *path, const encoder_writer_config_t *pConfig) {
+    (void)path;
+    (void)pConfig;
+
+    memset(self, 0, sizeof(file_writer_t));
+    self->fd = -1;
+
+    LOG_ERROR("the block writer is not supported on this platform.\n", "");
+
+    return false;
+}
+
+size_t file_writer_write(file_writer_t *self, uint64_t offset, const void *pData, size_t size) {
+    (void)self;
+    (void)offset;
+    (void)pData;
+    (void)size;
+
+    return 0;
+}
+
+bool file_writer_close(file_writer_t *self) {
+    (void)self;
+
+    return true;
+}
+
+#endif
+
+void file_writer_get_stats(file_writer_t *self, encoder_writer_stats_t *pStats) {
+    pStats->bytesWritten = atomic_load_explicit(&self->bytesWritten, memory_order_relaxed);
+    pStats->writeCalls = atomic_load_explicit(&self->writeCalls, memory_order_relaxed);
+    pStats->readCalls = atomic_load_explicit(&self->readCalls, memory_order_relaxed);
+    pStats->preallocateCalls = atomic_load_explicit(&self->preallocateCalls, memory_order_relaxed);
+    pStats->syncCalls = atomic_load_explicit(&self->syncCalls, memory_order_relaxed);
+    pStats->ioSeconds = (double)atomic_load_explicit(&self->ioNanoseconds, memory_order_relaxed) / 1e9;
+    pStats->megabytesPerSecond =
+        pStats->ioSeconds > 0 ? (double)pStats->bytesWritten / 1e6 / pStats->ioSeconds : 0;
+    pStats->isDirectIo = self->isDirect;
+}
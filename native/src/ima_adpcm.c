@@ -0,0 +1,111 @@
+#include "../include/ima_adpcm.h"
+
+static const int8_t _indexTable[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8};
+
+static const int16_t _stepTable[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+    19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+    130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+    5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767};
+
+// Quantizes the difference to the prediction and advances the channel state
+// exactly like the decoder will.
+static uint8_t _encode_sample(int32_t sample, int32_t *pPredictor, uint8_t *pStepIndex) {
+    int32_t step = _stepTable[*pStepIndex];
+    int32_t diff = sample - *pPredictor;
+    uint8_t code = 0;
+
+    if (diff < 0) {
+        code = 8;
+        diff = -diff;
+    }
+
+    int32_t delta = step >> 3;
+
+    if (diff >= step) {
+        code |= 4;
+        diff -= step;
+        delta += step;
+    }
+
+    step >>= 1;
+
+    if (diff >= step) {
+        code |= 2;
+        diff -= step;
+        delta += step;
+    }
+
+    step >>= 1;
+
+    if (diff >= step) {
+        code |= 1;
+        delta += step;
+    }
+
+    int32_t predictor = (code & 8) ? *pPredictor - delta : *pPredictor + delta;
+    *pPredictor = predictor < -32768 ? -32768 : (predictor > 32767 ? 32767 : predictor);
+
+    int32_t stepIndex = (int32_t)*pStepIndex + _indexTable[code];
+    *pStepIndex = (uint8_t)(stepIndex < 0 ? 0 : (stepIndex > 88 ? 88 : stepIndex));
+
+    return code;
+}
+
+uint8_t ima_adpcm_step_index_for(int32_t delta) {
+    if (delta < 0) {
+        delta = -delta;
+    }
+
+    // A code reaches at most 15/8 of the step.
+    uint8_t stepIndex = 0;
+
+    while (stepIndex < 88 && _stepTable[stepIndex] * 15 / 8 < delta) {
+        stepIndex++;
+    }
+
+    return stepIndex;
+}
+
+uint32_t ima_adpcm_frames_per_block(uint32_t blockAlign, uint32_t channels) {
+    return (blockAlign - 4 * channels) * 2 / channels + 1;
+}
+
+void ima_adpcm_encode_block(const int16_t *pFrames,
+                            uint32_t channels,
+                            uint32_t blockAlign,
+                            uint8_t *pStepIndex,
+                            uint8_t *pBlock) {
+    uint32_t framesPerBlock = ima_adpcm_frames_per_block(blockAlign, channels);
+    int32_t predictor[2];
+
+    // The first frame is stored verbatim in the header.
+    for (uint32_t c = 0; c < channels; c++) {
+        predictor[c] = pFrames[c];
+
+        pBlock[0] = (uint8_t)(pFrames[c] & 0xFF);
+        pBlock[1] = (uint8_t)((pFrames[c] >> 8) & 0xFF);
+        pBlock[2] = pStepIndex[c];
+        pBlock[3] = 0;
+        pBlock += 4;
+    }
+
+    for (uint32_t frame = 1; frame < framesPerBlock; frame += 8) {
+        for (uint32_t c = 0; c < channels; c++) {
+            for (uint32_t i = 0; i < 8; i += 2) {
+                const int16_t *pSample = pFrames + (frame + i) * channels + c;
+                uint8_t low = _encode_sample(pSample[0], &predictor[c], &pStepIndex[c]);
+                uint8_t high = _encode_sample(pSample[channels], &predictor[c], &pStepIndex[c]);
+
+                *pBlock++ = (uint8_t)(low | (high << 4));
+            }
+        }
+    }
+}
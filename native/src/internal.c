@@ -18,3 +18,15 @@ const char *describe_ma_format(ma_format format) {
             return "unknown";
     }
 }
+
+uint32_t estimate_playback_latency_frames(ma_device *pDevice) {
+    uint64_t bufferFrames = (uint64_t)pDevice->playback.internalPeriodSizeInFrames *
+                            pDevice->playback.internalPeriods;
+
+    if (pDevice->playback.internalSampleRate != 0 &&
+        pDevice->playback.internalSampleRate != pDevice->sampleRate) {
+        bufferFrames = bufferFrames * pDevice->sampleRate / pDevice->playback.internalSampleRate;
+    }
+
+    return (uint32_t)(bufferFrames + ma_data_converter_get_output_latency(&pDevice->playback.converter));
+}
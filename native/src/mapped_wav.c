@@ -0,0 +1,539 @@
+#include "../include/mapped_wav.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#if !defined(_WIN32)
+    #include <sys/mman.h>
+#endif
+
+#include "../include/internal.h"
+#include "../include/logger.h"
+#include "../include/miniaudio.h"
+
+// WAVE_FORMAT_* tags from the `fmt ` chunk.
+#define WAV_FORMAT_PCM 0x0001
+#define WAV_FORMAT_IEEE_FLOAT 0x0003
+#define WAV_FORMAT_EXTENSIBLE 0xFFFE
+
+// How far ahead of the cursor the kernel is asked to fault pages in, in seconds.
+#define MAPPED_WAV_PREFETCH_SEC 1
+
+typedef struct {
+    ma_data_source_base ds;      /**< Must be the first member so the source is a `ma_data_source`. */
+    audio_format_t fileFormat;   /**< Format of the samples in the file. */
+    audio_format_t outputFormat; /**< Format frames are read in. */
+    const uint8_t *pMap;         /**< Start of the read-only mapping of the whole file. */
+    size_t mapSize;              /**< Size of the mapping in bytes. */
+    const uint8_t *pData;        /**< First frame of the `data` chunk inside the mapping. */
+    ma_uint64 frameCount;        /**< Number of frames in the file. */
+    ma_uint32 fileBpf;           /**< Bytes per frame in the file. */
+    ma_uint32 outputBpf;         /**< Bytes per output frame. */
+    bool isDirect;               /**< File format equals output format, reads are plain copies. */
+    ma_data_converter converter; /**< Format, channel and rate conversion when not direct. */
+    ma_uint64 fileCursor;        /**< Next frame of the file to read. */
+    ma_uint64 outputCursor;      /**< Next output frame. */
+} mapped_wav_t;
+
+static inline uint16_t _le16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t _le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static pcm_format_t _pcm_format_of(uint16_t formatTag, uint16_t bitsPerSample) {
+    if (formatTag == WAV_FORMAT_IEEE_FLOAT) {
+        return bitsPerSample == 32 ? pcm_format_f32 : pcm_format_unknown;
+    }
+
+    if (formatTag != WAV_FORMAT_PCM) {
+        return pcm_format_unknown;
+    }
+
+    switch (bitsPerSample) {
+        case 8:
+            return pcm_format_u8;
+        case 16:
+            return pcm_format_s16;
+        case 24:
+            return pcm_format_s24;
+        case 32:
+            return pcm_format_s32;
+        default:
+            return pcm_format_unknown;
+    }
+}
+
+// Walks the RIFF chunks once and fills the file format and data range.
+static bool _parse_header(mapped_wav_t *wav) {
+    const uint8_t *p = wav->pMap;
+    size_t size = wav->mapSize;
+
+    if (size < 12 || memcmp(p, "RIFF", 4) != 0 || memcmp(p + 8, "WAVE", 4) != 0) {
+        LOG_ERROR("not a RIFF/WAVE file.\n", "");
+        return false;
+    }
+
+    bool hasFormat = false;
+    size_t offset = 12;
+
+    while (offset + 8 <= size) {
+        const uint8_t *pChunk = p + offset;
+        size_t chunkSize = _le32(pChunk + 4);
+        size_t bodyOffset = offset + 8;
+
+        if (memcmp(pChunk, "fmt ", 4) == 0) {
+            if (chunkSize < 16 || bodyOffset + chunkSize > size) {
+                LOG_ERROR("truncated `fmt ` chunk.\n", "");
+                return false;
+            }
+
+            const uint8_t *pFmt = p + bodyOffset;
+            uint16_t formatTag = _le16(pFmt);
+            uint16_t channels = _le16(pFmt + 2);
+            uint32_t sampleRate = _le32(pFmt + 4);
+            uint16_t blockAlign = _le16(pFmt + 12);
+            uint16_t bitsPerSample = _le16(pFmt + 14);
+
+            // The sub-format GUID starts with the plain format tag.
+            if (formatTag == WAV_FORMAT_EXTENSIBLE && chunkSize >= 40) {
+                formatTag = _le16(pFmt + 24);
+            }
+
+            wav->fileFormat.pcmFormat = _pcm_format_of(formatTag, bitsPerSample);
+            wav->fileFormat.channels = channels;
+            wav->fileFormat.sampleRate = sampleRate;
+            wav->fileBpf = blockAlign;
+
+            if (wav->fileFormat.pcmFormat == pcm_format_unknown ||
+                channels == 0 || sampleRate == 0 ||
+                blockAlign != channels * (bitsPerSample / 8)) {
+                LOG_ERROR("unsupported WAV format - tag: 0x%04x, bits: %u, channels: %u.\n",
+                          formatTag, bitsPerSample, channels);
+                return false;
+            }
+
+            hasFormat = true;
+        } else if (memcmp(pChunk, "data", 4) == 0) {
+            if (!hasFormat) {
+                LOG_ERROR("`data` chunk before `fmt ` chunk.\n", "");
+                return false;
+            }
+
+            // Streaming writers may leave the size unpatched; trust the file size then.
+            size_t available = size - bodyOffset;
+            size_t dataSize = chunkSize > available ? available : chunkSize;
+
+            wav->pData = p + bodyOffset;
+            wav->frameCount = dataSize / wav->fileBpf;
+
+            return true;
+        }
+
+        offset = bodyOffset + chunkSize + (chunkSize & 1);
+    }
+
+    LOG_ERROR("no `data` chunk found.\n", "");
+
+    return false;
+}
+
+// Asks the kernel to fault in the pages following `fileFrame` so the audio
+// thread does not block on disk reads.
+static void _prefetch(mapped_wav_t *wav, ma_uint64 fileFrame) {
+#if !defined(_WIN32)
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t begin = (size_t)(wav->pData - wav->pMap) + (size_t)(fileFrame * wav->fileBpf);
+    size_t length = (size_t)wav->fileFormat.sampleRate * wav->fileBpf * MAPPED_WAV_PREFETCH_SEC;
+
+    begin -= begin % pageSize;
+
+    if (begin >= wav->mapSize) {
+        return;
+    }
+
+    if (length > wav->mapSize - begin) {
+        length = wav->mapSize - begin;
+    }
+
+    madvise((void *)(wav->pMap + begin), length, MADV_WILLNEED);
+#else
+    (void)wav;
+    (void)fileFrame;
+#endif
+}
+
+static ma_uint64 _read_direct(mapped_wav_t *wav, void *pFramesOut, ma_uint64 frameCount) {
+    ma_uint64 available = wav->frameCount - wav->fileCursor;
+    ma_uint64 framesToRead = frameCount < available ? frameCount : available;
+
+    if (pFramesOut) {
+        memcpy(pFramesOut,
+               wav->pData + wav->fileCursor * wav->fileBpf,
+               (size_t)(framesToRead * wav->fileBpf));
+    }
+
+    wav->fileCursor += framesToRead;
+
+    return framesToRead;
+}
+
+static ma_uint64 _read_converted(mapped_wav_t *wav, void *pFramesOut, ma_uint64 frameCount) {
+    ma_uint64 framesRead = 0;
+
+    while (framesRead < frameCount) {
+        ma_uint64 framesIn = wav->frameCount - wav->fileCursor;
+        ma_uint64 framesOut = frameCount - framesRead;
+
+        ma_result convertResult =
+            ma_data_converter_process_pcm_frames(
+                &wav->converter,
+                wav->pData + wav->fileCursor * wav->fileBpf,
+                &framesIn,
+                pFramesOut ? (uint8_t *)pFramesOut + framesRead * wav->outputBpf : NULL,
+                &framesOut);
+
+        if (convertResult != MA_SUCCESS) {
+            LOG_ERROR("`ma_data_converter_process_pcm_frames` failed - %s.\n",
+                      ma_result_description(convertResult));
+            break;
+        }
+
+        wav->fileCursor += framesIn;
+        framesRead += framesOut;
+
+        if (framesIn == 0 && framesOut == 0) {
+            break;
+        }
+    }
+
+    return framesRead;
+}
+
+static ma_result _ds_read(ma_data_source *pDataSource,
+                          void *pFramesOut,
+                          ma_uint64 frameCount,
+                          ma_uint64 *pFramesRead) {
+    mapped_wav_t *wav = (mapped_wav_t *)pDataSource;
+
+    ma_uint64 framesRead = wav->isDirect
+                               ? _read_direct(wav, pFramesOut, frameCount)
+                               : _read_converted(wav, pFramesOut, frameCount);
+
+    wav->outputCursor += framesRead;
+
+    if (pFramesRead) {
+        *pFramesRead = framesRead;
+    }
+
+    return framesRead < frameCount ? MA_AT_END : MA_SUCCESS;
+}
+
+static ma_result _ds_seek(ma_data_source *pDataSource, ma_uint64 frameIndex) {
+    mapped_wav_t *wav = (mapped_wav_t *)pDataSource;
+
+    ma_uint64 fileFrame = wav->isDirect
+                              ? frameIndex
+                              : frameIndex * wav->fileFormat.sampleRate / wav->outputFormat.sampleRate;
+
+    if (fileFrame > wav->frameCount) {
+        return MA_INVALID_ARGS;
+    }
+
+    if (!wav->isDirect) {
+        ma_data_converter_reset(&wav->converter);
+    }
+
+    wav->fileCursor = fileFrame;
+    wav->outputCursor = frameIndex;
+    _prefetch(wav, fileFrame);
+
+    return MA_SUCCESS;
+}
+
+static ma_result _ds_get_data_format(ma_data_source *pDataSource,
+                                     ma_format *pFormat,
+                                     ma_uint32 *pChannels,
+                                     ma_uint32 *pSampleRate,
+                                     ma_channel *pChannelMap,
+                                     size_t channelMapCap) {
+    mapped_wav_t *wav = (mapped_wav_t *)pDataSource;
+
+    *pFormat = (ma_format)wav->outputFormat.pcmFormat;
+    *pChannels = wav->outputFormat.channels;
+    *pSampleRate = wav->outputFormat.sampleRate;
+    ma_channel_map_init_standard(ma_standard_channel_map_default,
+                                 pChannelMap,
+                                 channelMapCap,
+                                 wav->outputFormat.channels);
+
+    return MA_SUCCESS;
+}
+
+static ma_result _ds_get_cursor(ma_data_source *pDataSource, ma_uint64 *pCursor) {
+    *pCursor = ((mapped_wav_t *)pDataSource)->outputCursor;
+
+    return MA_SUCCESS;
+}
+
+static ma_result _ds_get_length(ma_data_source *pDataSource, ma_uint64 *pLength) {
+    *pLength = mapped_wav_get_length(pDataSource);
+
+    return MA_SUCCESS;
+}
+
+static ma_data_source_vtable g_mapped_wav_ds_vtable = {
+    _ds_read,
+    _ds_seek,
+    _ds_get_data_format,
+    _ds_get_cursor,
+    _ds_get_length,
+    NULL, /* onSetLooping */
+    0};
+
+static void _unmap(mapped_wav_t *wav) {
+#if !defined(_WIN32)
+    if (wav->pMap) {
+        munmap((void *)wav->pMap, wav->mapSize);
+    }
+#endif
+}
+
+FFI_PLUGIN_EXPORT
+void *mapped_wav_create(const char *path, audio_format_t *pOutputFormat) {
+    if (!path) {
+        LOG_ERROR("invalid parameter: `path` is NULL.\n", "");
+        return NULL;
+    }
+
+    if (!pOutputFormat) {
+        LOG_ERROR("invalid parameter: `pOutputFormat` is NULL.\n", "");
+        return NULL;
+    }
+
+#if defined(_WIN32)
+    LOG_ERROR("memory-mapped WAV files are not supported on this platform.\n", "");
+    return NULL;
+#else
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        LOG_ERROR("failed to open `%s`.\n", path);
+        return NULL;
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        LOG_ERROR("failed to stat `%s` or file is empty.\n", path);
+        return NULL;
+    }
+
+    void *pMap = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping keeps its own reference to the file.
+    close(fd);
+
+    if (pMap == MAP_FAILED) {
+        LOG_ERROR("failed to map `%s`.\n", path);
+        return NULL;
+    }
+
+    madvise(pMap, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    mapped_wav_t *wav = calloc(1, sizeof(mapped_wav_t));
+
+    if (!wav) {
+        munmap(pMap, (size_t)st.st_size);
+        LOG_ERROR("failed to allocate memory for `mapped_wav_t`.\n", "");
+        return NULL;
+    }
+
+    wav->pMap = pMap;
+    wav->mapSize = (size_t)st.st_size;
+
+    if (!_parse_header(wav)) {
+        _unmap(wav);
+        free(wav);
+        return NULL;
+    }
+
+    wav->outputFormat = *pOutputFormat;
+    wav->outputBpf = ma_get_bytes_per_frame((ma_format)pOutputFormat->pcmFormat,
+                                            pOutputFormat->channels);
+    wav->isDirect = wav->fileFormat.pcmFormat == pOutputFormat->pcmFormat &&
+                    wav->fileFormat.channels == pOutputFormat->channels &&
+                    wav->fileFormat.sampleRate == pOutputFormat->sampleRate;
+
+    if (!wav->isDirect) {
+        ma_data_converter_config converterConfig =
+            ma_data_converter_config_init((ma_format)wav->fileFormat.pcmFormat,
+                                          (ma_format)pOutputFormat->pcmFormat,
+                                          wav->fileFormat.channels,
+                                          pOutputFormat->channels,
+                                          wav->fileFormat.sampleRate,
+                                          pOutputFormat->sampleRate);
+
+        ma_result converterInitResult =
+            ma_data_converter_init(&converterConfig, NULL, &wav->converter);
+
+        if (converterInitResult != MA_SUCCESS) {
+            _unmap(wav);
+            free(wav);
+
+            LOG_ERROR("`ma_data_converter_init` failed - %s.\n",
+                      ma_result_description(converterInitResult));
+
+            return NULL;
+        }
+    }
+
+    ma_data_source_config dsConfig = ma_data_source_config_init();
+    dsConfig.vtable = &g_mapped_wav_ds_vtable;
+    ma_data_source_init(&dsConfig, &wav->ds);
+
+    _prefetch(wav, 0);
+
+    LOG_INFO("<%p>(mapped_wav_t) created - file: %s/%u/%u, output: %s/%u/%u, frames: %llu, direct: %d.\n",
+             wav,
+             describe_ma_format((ma_format)wav->fileFormat.pcmFormat),
+             wav->fileFormat.channels,
+             wav->fileFormat.sampleRate,
+             describe_ma_format((ma_format)pOutputFormat->pcmFormat),
+             pOutputFormat->channels,
+             pOutputFormat->sampleRate,
+             (unsigned long long)wav->frameCount,
+             wav->isDirect);
+
+    return wav;
+#endif
+}
+
+FFI_PLUGIN_EXPORT
+void mapped_wav_destroy(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    mapped_wav_t *wav = (mapped_wav_t *)self;
+
+    ma_data_source_uninit(&wav->ds);
+
+    if (!wav->isDirect) {
+        ma_data_converter_uninit(&wav->converter, NULL);
+    }
+
+    _unmap(wav);
+    LOG_INFO("<%p>(mapped_wav_t) destroyed.\n", wav);
+
+    free(wav);
+}
+
+FFI_PLUGIN_EXPORT
+void mapped_wav_get_file_format(void *self, audio_format_t *pFormat) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    if (!pFormat) {
+        LOG_ERROR("invalid parameter: `pFormat` is NULL.\n", "");
+        return;
+    }
+
+    *pFormat = ((mapped_wav_t *)self)->fileFormat;
+}
+
+FFI_PLUGIN_EXPORT
+bool mapped_wav_is_direct(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    return ((mapped_wav_t *)self)->isDirect;
+}
+
+FFI_PLUGIN_EXPORT
+bool mapped_wav_seek(void *self, uint64_t frameIndex) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    ma_result seekResult = ma_data_source_seek_to_pcm_frame(self, frameIndex);
+
+    if (seekResult != MA_SUCCESS) {
+        LOG_ERROR("failed to seek to frame %llu - %s.\n",
+                  (unsigned long long)frameIndex,
+                  ma_result_description(seekResult));
+        return false;
+    }
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+void mapped_wav_set_looping(void *self, bool isLooping) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    ma_data_source_set_looping(self, isLooping);
+}
+
+FFI_PLUGIN_EXPORT
+uint64_t mapped_wav_get_cursor(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    return ((mapped_wav_t *)self)->outputCursor;
+}
+
+FFI_PLUGIN_EXPORT
+uint64_t mapped_wav_get_length(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    mapped_wav_t *wav = (mapped_wav_t *)self;
+
+    if (wav->isDirect) {
+        return wav->frameCount;
+    }
+
+    return wav->frameCount * wav->outputFormat.sampleRate / wav->fileFormat.sampleRate;
+}
+
+FFI_PLUGIN_EXPORT
+void mapped_wav_read_pcm_frames_with_buffer(void *self,
+                                            void *pFramesOut,
+                                            uint64_t framesCount,
+                                            uint64_t *pFramesRead) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    if (!pFramesOut) {
+        LOG_ERROR("invalid parameter: `pFramesOut` is NULL.\n", "");
+        return;
+    }
+
+    if (!pFramesRead) {
+        LOG_ERROR("invalid parameter: `pFramesRead` is NULL.\n", "");
+        return;
+    }
+
+    ma_data_source_read_pcm_frames(self, pFramesOut, framesCount, (ma_uint64 *)pFramesRead);
+}
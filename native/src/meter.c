@@ -0,0 +1,386 @@
+#include "../include/meter.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/internal.h"
+#include "../include/logger.h"
+#include "../include/simd.h"
+
+// Absolute gate of EBU R128.
+#define METER_SILENCE_LUFS -70.0
+
+#ifndef M_PI
+    #define M_PI 3.14159265358979323846
+#endif
+
+// 4x oversampling interpolation filter of ITU-R BS.1770-4, Annex 2. Row `k`
+// holds tap `k` of the four phases, so one vector multiply-add per tap
+// computes all four interpolated samples at once.
+static const float _truePeakTaps[METER_TRUE_PEAK_TAPS][4] = {
+    {0.0017089843750f, -0.0291748046875f, -0.0189208984375f, -0.0083007812500f},
+    {0.0109863281250f, 0.0292968750000f, 0.0330810546875f, 0.0148925781250f},
+    {-0.0196533203125f, -0.0517578125000f, -0.0582275390625f, -0.0266113281250f},
+    {0.0332031250000f, 0.0891113281250f, 0.1015625000000f, 0.0476074218750f},
+    {-0.0594482421875f, -0.1665039062500f, -0.2003173828125f, -0.1022949218750f},
+    {0.1373291015625f, 0.4650878906250f, 0.7797851562500f, 0.9721679687500f},
+    {0.9721679687500f, 0.7797851562500f, 0.4650878906250f, 0.1373291015625f},
+    {-0.1022949218750f, -0.2003173828125f, -0.1665039062500f, -0.0594482421875f},
+    {0.0476074218750f, 0.1015625000000f, 0.0891113281250f, 0.0332031250000f},
+    {-0.0266113281250f, -0.0582275390625f, -0.0517578125000f, -0.0196533203125f},
+    {0.0148925781250f, 0.0330810546875f, 0.0292968750000f, 0.0109863281250f},
+    {-0.0083007812500f, -0.0189208984375f, -0.0291748046875f, 0.0017089843750f},
+};
+
+// K-weighting of ITU-R BS.1770 for any sample rate, from the analog
+// prototypes of the 48 kHz coefficients given by the standard.
+static void _init_k_weighting(meter_t *meter) {
+    double rate = meter->sampleRate;
+
+    double f0 = 1681.974450955533;
+    double gain = 3.999843853973347;
+    double q = 0.7071752369554196;
+    double k = tan(M_PI * f0 / rate);
+    double vh = pow(10.0, gain / 20.0);
+    double vb = pow(vh, 0.4996667741545416);
+    double a0 = 1.0 + k / q + k * k;
+
+    meter->shelf.b0 = (vh + vb * k / q + k * k) / a0;
+    meter->shelf.b1 = 2.0 * (k * k - vh) / a0;
+    meter->shelf.b2 = (vh - vb * k / q + k * k) / a0;
+    meter->shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+    meter->shelf.a2 = (1.0 - k / q + k * k) / a0;
+
+    f0 = 38.13547087602444;
+    q = 0.5003270373238773;
+    k = tan(M_PI * f0 / rate);
+    a0 = 1.0 + k / q + k * k;
+
+    meter->highpass.b0 = 1.0;
+    meter->highpass.b1 = -2.0;
+    meter->highpass.b2 = 1.0;
+    meter->highpass.a1 = 2.0 * (k * k - 1.0) / a0;
+    meter->highpass.a2 = (1.0 - k / q + k * k) / a0;
+}
+
+static inline double _biquad(const meter_biquad_t *pCoef, double *pState, double x) {
+    double y = pCoef->b0 * x + pState[0];
+
+    pState[0] = pCoef->b1 * x - pCoef->a1 * y + pState[1];
+    pState[1] = pCoef->b2 * x - pCoef->a2 * y;
+
+    return y;
+}
+
+// Loudness weight of a channel. In a 5.1 layout the LFE channel is ignored
+// and the surround channels count 1.41 times, as BS.1770 specifies.
+static double _channel_weight(uint32_t channels, uint32_t channel) {
+    if (channels == 6) {
+        if (channel == 3) {
+            return 0.0;
+        }
+
+        if (channel >= 4) {
+            return 1.41;
+        }
+    }
+
+    return 1.0;
+}
+
+meter_t *meter_create(ma_format format, uint32_t channels, uint32_t sampleRate) {
+    if (channels == 0 || channels > PLAYBACK_METER_MAX_CHANNELS) {
+        LOG_ERROR("metering supports 1 to %d channels, not %u.\n", PLAYBACK_METER_MAX_CHANNELS, channels);
+        return NULL;
+    }
+
+    meter_t *meter = calloc(1, sizeof(meter_t));
+
+    if (!meter) {
+        LOG_ERROR("failed to allocate memory for `meter_t`.\n", "");
+        return NULL;
+    }
+
+    meter->format = format;
+    meter->channels = channels;
+    meter->sampleRate = sampleRate;
+
+    if (format != ma_format_f32) {
+        meter->pScratch = malloc(METER_SLICE_FRAMES * channels * sizeof(float));
+
+        if (!meter->pScratch) {
+            LOG_ERROR("failed to allocate memory for the meter scratch buffer.\n", "");
+            free(meter);
+            return NULL;
+        }
+    }
+
+    // 20 dB in 1.7 s, and a 300 ms averaging time constant.
+    meter->peakFallPerFrame = (float)pow(10.0, -1.0 / (1.7 * sampleRate));
+    meter->rmsCoefPerFrame = (float)exp(-1.0 / (0.3 * sampleRate));
+    meter->blockFrames = sampleRate / 10;
+
+    _init_k_weighting(meter);
+
+    for (uint32_t c = 0; c < channels; c++) {
+        meter->channel[c].weight = _channel_weight(channels, c);
+    }
+
+    atomic_init(&meter->sequence, 0);
+    meter_reset(meter);
+
+    LOG_INFO("<%p>(meter_t) created - format: %s, channels: %u, sampleRate: %u.\n",
+             meter,
+             describe_ma_format(format),
+             channels,
+             sampleRate);
+
+    return meter;
+}
+
+// Converts a weighted mean square to LUFS. Below the -70 LUFS absolute gate
+// of EBU R128 the filter tails of silence would read as arbitrary values.
+static float _loudness(double meanSquare) {
+    double loudness = meanSquare > 0.0 ? -0.691 + 10.0 * log10(meanSquare) : -INFINITY;
+
+    return loudness < METER_SILENCE_LUFS ? -INFINITY : (float)loudness;
+}
+
+// Publishes the levels under the sequence lock. Runs on the audio thread.
+static void _publish(meter_t *meter) {
+    playback_meter_t levels = {0};
+
+    levels.channels = meter->channels;
+
+    for (uint32_t c = 0; c < meter->channels; c++) {
+        levels.peak[c] = meter->channel[c].peak;
+        levels.rms[c] = sqrtf(meter->channel[c].meanSquare);
+        levels.truePeak[c] = meter->channel[c].truePeak;
+    }
+
+    double momentary = 0.0;
+    double shortTerm = 0.0;
+    uint32_t momentaryBlocks = meter->blockCount < 4 ? meter->blockCount : 4;
+
+    for (uint32_t i = 0; i < meter->blockCount; i++) {
+        double block = meter->blocks[(meter->blockPos + METER_LOUDNESS_BLOCKS - 1 - i) % METER_LOUDNESS_BLOCKS];
+
+        shortTerm += block;
+
+        if (i < momentaryBlocks) {
+            momentary += block;
+        }
+    }
+
+    levels.momentaryLoudness = momentaryBlocks ? _loudness(momentary / momentaryBlocks) : -INFINITY;
+    levels.shortTermLoudness = meter->blockCount ? _loudness(shortTerm / meter->blockCount) : -INFINITY;
+    levels.framesMetered = meter->framesMetered;
+
+    atomic_fetch_add_explicit(&meter->sequence, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    meter->published = levels;
+
+    atomic_fetch_add_explicit(&meter->sequence, 1, memory_order_release);
+}
+
+void meter_reset(meter_t *self) {
+    for (uint32_t c = 0; c < self->channels; c++) {
+        meter_channel_t *channel = &self->channel[c];
+        double weight = channel->weight;
+
+        memset(channel, 0, sizeof(meter_channel_t));
+        channel->weight = weight;
+    }
+
+    self->historyPos = 0;
+    self->blockFill = 0;
+    self->blockEnergy = 0.0;
+    self->blockCount = 0;
+    self->blockPos = 0;
+    self->framesMetered = 0;
+
+    _publish(self);
+}
+
+// Sample peak and sum of squares of each channel. With 1, 2 or 4 channels a
+// vector lane always holds the same channel, so whole vectors are folded.
+static void _measure_levels(const float *pSamples,
+                            uint32_t frameCount,
+                            uint32_t channels,
+                            float *pPeak,
+                            float *pSumSquares) {
+    uint32_t sampleCount = frameCount * channels;
+    uint32_t i = 0;
+
+    if (4 % channels == 0) {
+        simd_f32x4 peak = simd_f32x4_set1(0.0f);
+        simd_f32x4 sumSquares = simd_f32x4_set1(0.0f);
+
+        for (; i + 4 <= sampleCount; i += 4) {
+            simd_f32x4 x = simd_f32x4_load(pSamples + i);
+
+            peak = simd_f32x4_max(peak, simd_f32x4_abs(x));
+            sumSquares = simd_f32x4_add(sumSquares, simd_f32x4_mul(x, x));
+        }
+
+        float lanes[4];
+        float squares[4];
+
+        simd_f32x4_store(lanes, peak);
+        simd_f32x4_store(squares, sumSquares);
+
+        for (uint32_t lane = 0; lane < 4; lane++) {
+            uint32_t c = lane % channels;
+
+            pPeak[c] = lanes[lane] > pPeak[c] ? lanes[lane] : pPeak[c];
+            pSumSquares[c] += squares[lane];
+        }
+    }
+
+    for (; i < sampleCount; i++) {
+        uint32_t c = i % channels;
+        float x = pSamples[i];
+        float magnitude = fabsf(x);
+
+        pPeak[c] = magnitude > pPeak[c] ? magnitude : pPeak[c];
+        pSumSquares[c] += x * x;
+    }
+}
+
+// Largest magnitude of the 4x interpolated signal of one channel.
+static float _measure_true_peak(meter_channel_t *channel,
+                                const float *pSamples,
+                                uint32_t frameCount,
+                                uint32_t channels,
+                                uint32_t historyPos) {
+    simd_f32x4 peak = simd_f32x4_set1(0.0f);
+
+    for (uint32_t f = 0; f < frameCount; f++) {
+        float x = pSamples[f * channels];
+
+        channel->history[historyPos] = x;
+        channel->history[historyPos + METER_TRUE_PEAK_TAPS] = x;
+        historyPos = historyPos + 1 == METER_TRUE_PEAK_TAPS ? 0 : historyPos + 1;
+
+        // Oldest to newest sample.
+        const float *pHistory = channel->history + historyPos;
+        simd_f32x4 sum = simd_f32x4_set1(0.0f);
+
+        for (uint32_t k = 0; k < METER_TRUE_PEAK_TAPS; k++) {
+            sum = simd_f32x4_add(sum, simd_f32x4_mul(simd_f32x4_load(_truePeakTaps[k]),
+                                                     simd_f32x4_set1(pHistory[k])));
+        }
+
+        peak = simd_f32x4_max(peak, simd_f32x4_abs(sum));
+    }
+
+    float lanes[4];
+    simd_f32x4_store(lanes, peak);
+
+    float max = lanes[0];
+    for (int lane = 1; lane < 4; lane++) {
+        max = lanes[lane] > max ? lanes[lane] : max;
+    }
+
+    return max;
+}
+
+// K-weights the slice and accumulates it into 100 ms loudness blocks.
+static void _measure_loudness(meter_t *meter, const float *pSamples, uint32_t frameCount) {
+    for (uint32_t f = 0; f < frameCount; f++) {
+        for (uint32_t c = 0; c < meter->channels; c++) {
+            meter_channel_t *channel = &meter->channel[c];
+            double y = _biquad(&meter->shelf, channel->shelfState, pSamples[f * meter->channels + c]);
+
+            y = _biquad(&meter->highpass, channel->highpassState, y);
+            meter->blockEnergy += channel->weight * y * y;
+        }
+
+        if (++meter->blockFill == meter->blockFrames) {
+            meter->blocks[meter->blockPos] = meter->blockEnergy / meter->blockFrames;
+            meter->blockPos = (meter->blockPos + 1) % METER_LOUDNESS_BLOCKS;
+            meter->blockCount += meter->blockCount < METER_LOUDNESS_BLOCKS;
+            meter->blockFill = 0;
+            meter->blockEnergy = 0.0;
+        }
+    }
+}
+
+static void _process_slice(meter_t *meter, const float *pSamples, uint32_t frameCount) {
+    float peak[PLAYBACK_METER_MAX_CHANNELS] = {0};
+    float sumSquares[PLAYBACK_METER_MAX_CHANNELS] = {0};
+
+    _measure_levels(pSamples, frameCount, meter->channels, peak, sumSquares);
+
+    float fall = powf(meter->peakFallPerFrame, (float)frameCount);
+    float decay = powf(meter->rmsCoefPerFrame, (float)frameCount);
+
+    for (uint32_t c = 0; c < meter->channels; c++) {
+        meter_channel_t *channel = &meter->channel[c];
+        float truePeak = _measure_true_peak(channel, pSamples + c, frameCount, meter->channels, meter->historyPos);
+
+        channel->peak = fmaxf(peak[c], channel->peak * fall);
+        channel->truePeak = fmaxf(fmaxf(truePeak, peak[c]), channel->truePeak * fall);
+        channel->meanSquare = channel->meanSquare * decay + (1.0f - decay) * sumSquares[c] / frameCount;
+    }
+
+    meter->historyPos = (meter->historyPos + frameCount) % METER_TRUE_PEAK_TAPS;
+
+    _measure_loudness(meter, pSamples, frameCount);
+
+    meter->framesMetered += frameCount;
+}
+
+void meter_process(meter_t *self, const void *pFrames, uint32_t frameCount) {
+    uint32_t bpf = ma_get_bytes_per_frame(self->format, self->channels);
+    const uint8_t *pData = pFrames;
+
+    while (frameCount > 0) {
+        uint32_t length = frameCount < METER_SLICE_FRAMES ? frameCount : METER_SLICE_FRAMES;
+        const float *pSamples = (const float *)pData;
+
+        if (self->pScratch) {
+            ma_pcm_convert(self->pScratch,
+                           ma_format_f32,
+                           pData,
+                           self->format,
+                           (ma_uint64)length * self->channels,
+                           ma_dither_mode_none);
+            pSamples = self->pScratch;
+        }
+
+        _process_slice(self, pSamples, length);
+
+        pData += (size_t)length * bpf;
+        frameCount -= length;
+    }
+
+    _publish(self);
+}
+
+void meter_read(meter_t *self, playback_meter_t *pMeter) {
+    for (;;) {
+        unsigned int before = atomic_load_explicit(&self->sequence, memory_order_acquire);
+
+        if (before & 1) {
+            continue;
+        }
+
+        *pMeter = self->published;
+
+        atomic_thread_fence(memory_order_acquire);
+
+        if (atomic_load_explicit(&self->sequence, memory_order_relaxed) == before) {
+            return;
+        }
+    }
+}
+
+void meter_destroy(meter_t *self) {
+    LOG_INFO("<%p>(meter_t) destroyed.\n", self);
+
+    free(self->pScratch);
+    free(self);
+}
@@ -0,0 +1,743 @@
+#include "../include/overview.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../include/internal.h"
+#include "../include/logger.h"
+#include "../include/overview_private.h"
+
+#define OVERVIEW_DEFAULT_BLOCK_FRAMES 256
+
+// Frames converted to f32 at a time.
+#define OVERVIEW_SLICE_FRAMES 256
+
+// Completed blocks the tap holds, about 5 s of 48 kHz audio with the default
+// block size, so the background thread can be descheduled for a long time.
+#define OVERVIEW_TAP_BLOCKS 1024
+
+// Entries of the first allocation of a level.
+#define OVERVIEW_INITIAL_CAPACITY 1024
+
+#define OVERVIEW_WAIT_MS 100
+
+#define OVERVIEW_FILE_MAGIC "MAOV"
+#define OVERVIEW_FILE_VERSION 1
+
+/**
+ * @brief Header of a sidecar file, followed by the finest level.
+ */
+typedef struct {
+    char magic[4];        /**< `OVERVIEW_FILE_MAGIC`. */
+    uint32_t version;     /**< `OVERVIEW_FILE_VERSION`. */
+    uint32_t pcmFormat;   /**< `pcm_format_t` of the recorded frames. */
+    uint32_t channels;    /**< Number of channels. */
+    uint32_t sampleRate;  /**< Sample rate in Hertz. */
+    uint32_t blockFrames; /**< Frames per block of the finest level. */
+    uint64_t frameCount;  /**< Frames covered. */
+    uint64_t blockCount;  /**< Entries of the finest level that follow. */
+} overview_file_header_t;
+
+static uint32_t _values_per_entry(const overview_t *overview) {
+    return 2 * overview->config.channels;
+}
+
+// --- Writer side ---
+
+static void _reset_entry(overview_t *overview) {
+    float *pValues = overview->pEntry->minMax;
+
+    for (uint32_t c = 0; c < overview->config.channels; c++) {
+        pValues[2 * c] = INFINITY;
+        pValues[2 * c + 1] = -INFINITY;
+    }
+
+    overview->blockFill = 0;
+}
+
+static void _drain(overview_t *overview);
+
+static void _push_entry(overview_t *overview) {
+    overview->pEntry->index = overview->blockIndex++;
+    overview->pEntry->frames = overview->blockFill;
+
+    // A writer faster than real time, e.g. an offline encode, can outrun the
+    // background thread; it then drains the tap itself if that is free. The
+    // audio thread never does, it only counts the dropped block.
+    if (ma_rb_available_write(&overview->tap) < overview->entrySize &&
+        atomic_load_explicit(&overview->isSelfDraining, memory_order_relaxed) &&
+        pthread_mutex_trylock(&overview->mutex) == 0) {
+        _drain(overview);
+        pthread_mutex_unlock(&overview->mutex);
+    }
+
+    if (ma_rb_available_write(&overview->tap) < overview->entrySize) {
+        atomic_fetch_add_explicit(&overview->droppedBlocks, 1, memory_order_relaxed);
+        _reset_entry(overview);
+        return;
+    }
+
+    const uint8_t *pData = (const uint8_t *)overview->pEntry;
+    size_t bytesWritten = 0;
+
+    while (bytesWritten < overview->entrySize) {
+        size_t chunkSize = overview->entrySize - bytesWritten;
+        void *pChunk;
+
+        if (ma_rb_acquire_write(&overview->tap, &chunkSize, &pChunk) != MA_SUCCESS || chunkSize == 0) {
+            break;
+        }
+
+        memcpy(pChunk, pData + bytesWritten, chunkSize);
+        ma_rb_commit_write(&overview->tap, chunkSize);
+        bytesWritten += chunkSize;
+    }
+
+    _reset_entry(overview);
+}
+
+// Reduces interleaved f32 frames into the current block, pushing every block
+// that completes.
+static void _reduce_frames(overview_t *overview, const float *pFrames, uint32_t frameCount) {
+    uint32_t channels = overview->config.channels;
+    float *pValues = overview->pEntry->minMax;
+
+    while (frameCount > 0) {
+        uint32_t length = overview->config.blockFrames - overview->blockFill;
+
+        if (length > frameCount) {
+            length = frameCount;
+        }
+
+        for (uint32_t c = 0; c < channels; c++) {
+            float min = pValues[2 * c];
+            float max = pValues[2 * c + 1];
+
+            for (uint32_t f = 0; f < length; f++) {
+                float value = pFrames[f * channels + c];
+
+                min = value < min ? value : min;
+                max = value > max ? value : max;
+            }
+
+            pValues[2 * c] = min;
+            pValues[2 * c + 1] = max;
+        }
+
+        overview->blockFill += length;
+        pFrames += (size_t)length * channels;
+        frameCount -= length;
+
+        if (overview->blockFill == overview->config.blockFrames) {
+            _push_entry(overview);
+        }
+    }
+}
+
+// --- Pyramid side, called with `mutex` held ---
+
+static bool _append(overview_t *overview, uint32_t level, const float *pValues) {
+    overview_level_t *pLevel = &overview->levels[level];
+    uint32_t values = _values_per_entry(overview);
+
+    if (pLevel->count == pLevel->capacity) {
+        uint64_t capacity = pLevel->capacity ? pLevel->capacity * 2 : OVERVIEW_INITIAL_CAPACITY;
+        float *pData = realloc(pLevel->pData, (size_t)capacity * values * sizeof(float));
+
+        if (!pData) {
+            LOG_ERROR("<%p>(overview_t) failed to grow level %u to %llu entries.\n",
+                      overview,
+                      level,
+                      (unsigned long long)capacity);
+            return false;
+        }
+
+        pLevel->pData = pData;
+        pLevel->capacity = capacity;
+    }
+
+    memcpy(pLevel->pData + pLevel->count * values, pValues, values * sizeof(float));
+    pLevel->count++;
+
+    if (level + 1 > overview->levelCount) {
+        overview->levelCount = level + 1;
+    }
+
+    // Every second entry completes an entry of the next level.
+    if ((pLevel->count & 1) == 0 && level + 1 < OVERVIEW_MAX_LEVELS) {
+        const float *pFirst = pLevel->pData + (pLevel->count - 2) * values;
+        const float *pSecond = pFirst + values;
+
+        for (uint32_t i = 0; i < values; i += 2) {
+            overview->pCombined[i] = fminf(pFirst[i], pSecond[i]);
+            overview->pCombined[i + 1] = fmaxf(pFirst[i + 1], pSecond[i + 1]);
+        }
+
+        return _append(overview, level + 1, overview->pCombined);
+    }
+
+    return true;
+}
+
+static void _read_entry(overview_t *overview) {
+    uint8_t *pData = (uint8_t *)overview->pDrained;
+    size_t bytesRead = 0;
+
+    while (bytesRead < overview->entrySize) {
+        size_t chunkSize = overview->entrySize - bytesRead;
+        void *pChunk;
+
+        if (ma_rb_acquire_read(&overview->tap, &chunkSize, &pChunk) != MA_SUCCESS || chunkSize == 0) {
+            break;
+        }
+
+        memcpy(pData + bytesRead, pChunk, chunkSize);
+        ma_rb_commit_read(&overview->tap, chunkSize);
+        bytesRead += chunkSize;
+    }
+}
+
+// Moves the completed blocks from the tap into the pyramid.
+static void _drain(overview_t *overview) {
+    uint32_t values = _values_per_entry(overview);
+
+    while (ma_rb_available_read(&overview->tap) >= overview->entrySize) {
+        _read_entry(overview);
+
+        // Blocks dropped by the writer read as silence, so later blocks keep
+        // their position.
+        while (overview->levels[0].count < overview->pDrained->index) {
+            memset(overview->pCombined, 0, values * sizeof(float));
+
+            if (!_append(overview, 0, overview->pCombined)) {
+                break;
+            }
+
+            overview->frameCount += overview->config.blockFrames;
+        }
+
+        if (_append(overview, 0, overview->pDrained->minMax)) {
+            overview->frameCount += overview->pDrained->frames;
+        }
+    }
+
+    unsigned int dropped = atomic_exchange(&overview->droppedBlocks, 0);
+
+    if (dropped) {
+        LOG_WARN("<%p>(overview_t) %u block(s) dropped, the overview fell behind.\n", overview, dropped);
+    }
+}
+
+static void *_overview_thread(void *pUserData) {
+    overview_t *overview = pUserData;
+
+    pthread_mutex_lock(&overview->mutex);
+
+    while (!atomic_load(&overview->stop)) {
+        _drain(overview);
+
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+
+        deadline.tv_nsec += OVERVIEW_WAIT_MS * 1000000L;
+        while (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec += 1;
+            deadline.tv_nsec -= 1000000000L;
+        }
+
+        if (!atomic_load(&overview->stop)) {
+            pthread_cond_timedwait(&overview->cond, &overview->mutex, &deadline);
+        }
+    }
+
+    pthread_mutex_unlock(&overview->mutex);
+
+    return NULL;
+}
+
+// Folds entries `[first, last)` of a level into `pMin` and `pMax`. Entries
+// not yet complete at that level are taken from the finer levels.
+static void _reduce_range(const overview_t *overview,
+                          uint32_t level,
+                          uint64_t first,
+                          uint64_t last,
+                          uint32_t channel,
+                          float *pMin,
+                          float *pMax) {
+    const overview_level_t *pLevel = &overview->levels[level];
+    uint32_t values = _values_per_entry(overview);
+    uint64_t end = last < pLevel->count ? last : pLevel->count;
+
+    for (uint64_t i = first; i < end; i++) {
+        const float *pValues = pLevel->pData + i * values + 2 * channel;
+
+        *pMin = fminf(*pMin, pValues[0]);
+        *pMax = fmaxf(*pMax, pValues[1]);
+    }
+
+    if (last > pLevel->count && level > 0) {
+        uint64_t from = first > pLevel->count ? first : pLevel->count;
+
+        _reduce_range(overview, level - 1, 2 * from, 2 * last, channel, pMin, pMax);
+    }
+}
+
+// --- Lifecycle ---
+
+static void _free(overview_t *overview) {
+    for (uint32_t level = 0; level < OVERVIEW_MAX_LEVELS; level++) {
+        free(overview->levels[level].pData);
+    }
+
+    free(overview->pScratch);
+    free(overview->pEntry);
+    free(overview->pDrained);
+    free(overview->pCombined);
+    free(overview);
+}
+
+static overview_t *_create(const overview_config_t *pConfig) {
+    overview_config_t config = *pConfig;
+
+    if (config.blockFrames == 0) {
+        config.blockFrames = OVERVIEW_DEFAULT_BLOCK_FRAMES;
+    }
+
+    if (config.channels == 0) {
+        LOG_ERROR("`channels` must not be 0.\n", "");
+        return NULL;
+    }
+
+    if (config.pcmFormat <= pcm_format_unknown || config.pcmFormat >= pcm_format_count) {
+        LOG_ERROR("unsupported PCM format %d.\n", config.pcmFormat);
+        return NULL;
+    }
+
+    overview_t *overview = calloc(1, sizeof(overview_t));
+
+    if (!overview) {
+        LOG_ERROR("failed to allocate memory for `overview_t`.\n", "");
+        return NULL;
+    }
+
+    overview->config = config;
+
+    uint32_t values = 2 * config.channels;
+    overview->entrySize = sizeof(overview_entry_t) + values * sizeof(float);
+
+    if (config.pcmFormat != pcm_format_f32) {
+        overview->pScratch = malloc((size_t)OVERVIEW_SLICE_FRAMES * config.channels * sizeof(float));
+    }
+
+    overview->pEntry = malloc(overview->entrySize);
+    overview->pDrained = malloc(overview->entrySize);
+    overview->pCombined = malloc(values * sizeof(float));
+
+    if ((config.pcmFormat != pcm_format_f32 && !overview->pScratch) || !overview->pEntry ||
+        !overview->pDrained || !overview->pCombined) {
+        LOG_ERROR("failed to allocate memory for the overview buffers.\n", "");
+        _free(overview);
+        return NULL;
+    }
+
+    _reset_entry(overview);
+
+    ma_result rbResult = ma_rb_init(OVERVIEW_TAP_BLOCKS * overview->entrySize, NULL, NULL, &overview->tap);
+
+    if (rbResult != MA_SUCCESS) {
+        LOG_ERROR("`ma_rb_init` failed - %s.\n", ma_result_description(rbResult));
+        _free(overview);
+        return NULL;
+    }
+
+    atomic_init(&overview->isFinished, false);
+    atomic_init(&overview->droppedBlocks, 0);
+    atomic_init(&overview->isSelfDraining, true);
+    atomic_init(&overview->stop, false);
+    pthread_mutex_init(&overview->mutex, NULL);
+    pthread_cond_init(&overview->cond, NULL);
+
+    if (pthread_create(&overview->thread, NULL, _overview_thread, overview) != 0) {
+        LOG_ERROR("failed to start the overview thread.\n", "");
+        pthread_cond_destroy(&overview->cond);
+        pthread_mutex_destroy(&overview->mutex);
+        ma_rb_uninit(&overview->tap);
+        _free(overview);
+        return NULL;
+    }
+
+    return overview;
+}
+
+FFI_PLUGIN_EXPORT
+void *overview_create(overview_config_t *pConfig) {
+    if (!pConfig) {
+        LOG_ERROR("invalid parameter: `pConfig` is NULL.\n", "");
+        return NULL;
+    }
+
+    overview_t *overview = _create(pConfig);
+
+    if (!overview) {
+        return NULL;
+    }
+
+    LOG_INFO("<%p>(overview_t) created - format: %s, channels: %u, block frames: %u.\n",
+             overview,
+             describe_ma_format((ma_format)overview->config.pcmFormat),
+             overview->config.channels,
+             overview->config.blockFrames);
+
+    return overview;
+}
+
+FFI_PLUGIN_EXPORT
+void *overview_load(const char *path) {
+    if (!path) {
+        LOG_ERROR("invalid parameter: `path` is NULL.\n", "");
+        return NULL;
+    }
+
+    FILE *pFile = fopen(path, "rb");
+
+    if (!pFile) {
+        LOG_ERROR("failed to open `%s`.\n", path);
+        return NULL;
+    }
+
+    overview_file_header_t header;
+
+    if (fread(&header, sizeof(header), 1, pFile) != 1 ||
+        memcmp(header.magic, OVERVIEW_FILE_MAGIC, 4) != 0 ||
+        header.version != OVERVIEW_FILE_VERSION || header.blockFrames == 0) {
+        LOG_ERROR("`%s` is not an overview file.\n", path);
+        fclose(pFile);
+        return NULL;
+    }
+
+    overview_config_t config = {
+        .pcmFormat = (pcm_format_t)header.pcmFormat,
+        .channels = header.channels,
+        .sampleRate = header.sampleRate,
+        .blockFrames = header.blockFrames,
+    };
+
+    overview_t *overview = _create(&config);
+
+    if (!overview) {
+        fclose(pFile);
+        return NULL;
+    }
+
+    atomic_store(&overview->isFinished, true);
+
+    pthread_mutex_lock(&overview->mutex);
+
+    bool isComplete = true;
+
+    for (uint64_t i = 0; i < header.blockCount; i++) {
+        if (fread(overview->pDrained->minMax, sizeof(float), _values_per_entry(overview), pFile) !=
+                _values_per_entry(overview) ||
+            !_append(overview, 0, overview->pDrained->minMax)) {
+            isComplete = false;
+            break;
+        }
+    }
+
+    overview->frameCount = header.frameCount;
+
+    pthread_mutex_unlock(&overview->mutex);
+    fclose(pFile);
+
+    if (!isComplete) {
+        LOG_ERROR("`%s` is truncated.\n", path);
+        overview_destroy(overview);
+        return NULL;
+    }
+
+    LOG_INFO("<%p>(overview_t) loaded `%s` - %llu frames, %u levels.\n",
+             overview,
+             path,
+             (unsigned long long)overview->frameCount,
+             overview->levelCount);
+
+    return overview;
+}
+
+FFI_PLUGIN_EXPORT
+bool overview_get_config(void *self, overview_config_t *pConfig) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    if (!pConfig) {
+        LOG_ERROR("invalid parameter: `pConfig` is NULL.\n", "");
+        return false;
+    }
+
+    *pConfig = ((overview_t *)self)->config;
+
+    return true;
+}
+
+void overview_set_self_draining(overview_t *self, bool isSelfDraining) {
+    atomic_store_explicit(&self->isSelfDraining, isSelfDraining, memory_order_relaxed);
+}
+
+FFI_PLUGIN_EXPORT
+uint64_t overview_write_pcm_frames(void *self, const void *pFrames, uint64_t frameCount) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    overview_t *overview = (overview_t *)self;
+
+    if (atomic_load_explicit(&overview->isFinished, memory_order_relaxed)) {
+        return 0;
+    }
+
+    if (!overview->pScratch) {
+        // Frames are reduced in 32-bit slices to keep the count in range.
+        const float *pData = pFrames;
+        uint64_t framesDone = 0;
+
+        while (framesDone < frameCount) {
+            uint64_t slice = frameCount - framesDone;
+
+            if (slice > UINT32_MAX) {
+                slice = UINT32_MAX;
+            }
+
+            _reduce_frames(overview, pData + framesDone * overview->config.channels, (uint32_t)slice);
+            framesDone += slice;
+        }
+
+        return frameCount;
+    }
+
+    ma_format format = (ma_format)overview->config.pcmFormat;
+    ma_uint32 bpf = ma_get_bytes_per_frame(format, overview->config.channels);
+    const uint8_t *pData = pFrames;
+    uint64_t framesDone = 0;
+
+    while (framesDone < frameCount) {
+        uint32_t slice = frameCount - framesDone > OVERVIEW_SLICE_FRAMES
+                             ? OVERVIEW_SLICE_FRAMES
+                             : (uint32_t)(frameCount - framesDone);
+
+        ma_pcm_convert(overview->pScratch,
+                       ma_format_f32,
+                       pData + framesDone * bpf,
+                       format,
+                       (ma_uint64)slice * overview->config.channels,
+                       ma_dither_mode_none);
+
+        _reduce_frames(overview, overview->pScratch, slice);
+        framesDone += slice;
+    }
+
+    return frameCount;
+}
+
+FFI_PLUGIN_EXPORT
+void overview_finish(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    overview_t *overview = (overview_t *)self;
+
+    if (atomic_exchange(&overview->isFinished, true)) {
+        return;
+    }
+
+    if (overview->blockFill > 0) {
+        _push_entry(overview);
+    }
+}
+
+FFI_PLUGIN_EXPORT
+uint64_t overview_get_frame_count(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    overview_t *overview = (overview_t *)self;
+
+    pthread_mutex_lock(&overview->mutex);
+    _drain(overview);
+    uint64_t frameCount = overview->frameCount;
+    pthread_mutex_unlock(&overview->mutex);
+
+    return frameCount;
+}
+
+FFI_PLUGIN_EXPORT
+uint32_t overview_query(void *self,
+                        uint32_t channel,
+                        uint64_t startFrame,
+                        uint64_t frameCount,
+                        uint32_t pixelCount,
+                        float *pMin,
+                        float *pMax) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    if (!pMin || !pMax) {
+        LOG_ERROR("invalid parameter: `pMin` or `pMax` is NULL.\n", "");
+        return 0;
+    }
+
+    overview_t *overview = (overview_t *)self;
+
+    if (channel >= overview->config.channels) {
+        LOG_ERROR("channel %u out of range, the overview has %u.\n", channel, overview->config.channels);
+        return 0;
+    }
+
+    if (pixelCount == 0 || frameCount == 0) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&overview->mutex);
+    _drain(overview);
+
+    uint64_t end = startFrame + frameCount;
+
+    if (end > overview->frameCount) {
+        end = overview->frameCount;
+    }
+
+    double span = (double)frameCount / pixelCount;
+    uint32_t level = 0;
+
+    while (level + 1 < overview->levelCount &&
+           (double)((uint64_t)overview->config.blockFrames << (level + 1)) <= span) {
+        level++;
+    }
+
+    uint64_t blockSize = (uint64_t)overview->config.blockFrames << level;
+    uint32_t written = 0;
+
+    for (uint32_t pixel = 0; pixel < pixelCount; pixel++) {
+        uint64_t first = startFrame + (uint64_t)(pixel * span);
+        uint64_t last = startFrame + (uint64_t)((pixel + 1) * span);
+
+        if (first >= end) {
+            break;
+        }
+
+        if (last > end) {
+            last = end;
+        }
+
+        if (last <= first) {
+            last = first + 1;
+        }
+
+        float min = INFINITY;
+        float max = -INFINITY;
+
+        _reduce_range(overview, level, first / blockSize, (last - 1) / blockSize + 1, channel, &min, &max);
+
+        pMin[pixel] = min;
+        pMax[pixel] = max;
+        written++;
+    }
+
+    pthread_mutex_unlock(&overview->mutex);
+
+    return written;
+}
+
+FFI_PLUGIN_EXPORT
+bool overview_save(void *self, const char *path) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    if (!path) {
+        LOG_ERROR("invalid parameter: `path` is NULL.\n", "");
+        return false;
+    }
+
+    overview_t *overview = (overview_t *)self;
+    FILE *pFile = fopen(path, "wb");
+
+    if (!pFile) {
+        LOG_ERROR("failed to open `%s`.\n", path);
+        return false;
+    }
+
+    pthread_mutex_lock(&overview->mutex);
+    _drain(overview);
+
+    overview_level_t *pLevel = &overview->levels[0];
+    overview_file_header_t header = {
+        .version = OVERVIEW_FILE_VERSION,
+        .pcmFormat = (uint32_t)overview->config.pcmFormat,
+        .channels = overview->config.channels,
+        .sampleRate = overview->config.sampleRate,
+        .blockFrames = overview->config.blockFrames,
+        .frameCount = overview->frameCount,
+        .blockCount = pLevel->count,
+    };
+    memcpy(header.magic, OVERVIEW_FILE_MAGIC, 4);
+
+    size_t valueCount = (size_t)pLevel->count * _values_per_entry(overview);
+    bool isSaved = fwrite(&header, sizeof(header), 1, pFile) == 1 &&
+                   fwrite(pLevel->pData, sizeof(float), valueCount, pFile) == valueCount;
+
+    pthread_mutex_unlock(&overview->mutex);
+
+    if (fclose(pFile) != 0) {
+        isSaved = false;
+    }
+
+    if (!isSaved) {
+        LOG_ERROR("failed to write `%s`.\n", path);
+        return false;
+    }
+
+    LOG_INFO("<%p>(overview_t) saved to `%s` - %llu blocks.\n",
+             overview,
+             path,
+             (unsigned long long)header.blockCount);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+void overview_destroy(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    overview_t *overview = (overview_t *)self;
+
+    pthread_mutex_lock(&overview->mutex);
+    atomic_store(&overview->stop, true);
+    pthread_cond_signal(&overview->cond);
+    pthread_mutex_unlock(&overview->mutex);
+
+    pthread_join(overview->thread, NULL);
+
+    pthread_cond_destroy(&overview->cond);
+    pthread_mutex_destroy(&overview->mutex);
+    ma_rb_uninit(&overview->tap);
+
+    LOG_INFO("<%p>(overview_t) destroyed.\n", overview);
+
+    _free(overview);
+}
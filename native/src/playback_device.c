@@ -2,17 +2,21 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "../include/audio_context_private.h"
+#include "../include/encoder.h"
 #include "../include/internal.h"
 #include "../include/logger.h"
 #include "../include/miniaudio.h"
+#include "../include/overview.h"
+#include "../include/overview_private.h"
 #include "../include/playback_device_private.h"
 
 // Playback device vtable
 typedef struct {
     audio_device_vtable_t base;
-    void (*pushBuffer)(void *self, playback_data_t *pData);
+    uint32_t (*pushBuffer)(void *self, playback_data_t *pData);
     void (*resetBuffer)(void *self);
 } playback_device_vtable_t;
 
@@ -25,75 +29,55 @@ static playback_device_vtable_t g_playback_device_vtable = {
     .pushBuffer = playback_device_push_buffer,
     .resetBuffer = playback_device_reset_buffer};
 
-static void _encode(playback_device_t *playback, void *pData, ma_uint64 framesCount) {
-    ma_encoder *encoder = (ma_encoder *)playback->encoder;
-
-    if (encoder) {
-        ma_uint64 writeFramesCount = framesCount;
-        ma_uint64 framesWritten = framesCount;
-
-        while (writeFramesCount > 0) {
-            ma_encoder_write_pcm_frames(encoder,
-                                        pData,
-                                        writeFramesCount,
-                                        &framesWritten);
-
-            writeFramesCount -= framesWritten;
-
-            if (writeFramesCount != 0) {
-                pData = (char *)pData + framesWritten;
-            }
-        }
+static void _encode(playback_device_t *playback, void *pData, ma_uint64 framesCount, bool isGap) {
+    if (!playback->encoder) {
+        return;
     }
-}
-
-// Playback device data callback
-static void _data_callback(ma_device *pDevice,
-                           void *pOutput,
-                           const void *pInput,
-                           ma_uint32 frameCount) {
-    (void)pInput;
-
-    playback_device_t *playback = (playback_device_t *)pDevice->pUserData;
 
-    if (!playback) {
-        LOG_ERROR("invalid parameter: `pDevice->pUserData` is NULL.\n", "");
-        return;
+    // A full gap table makes the silence be encoded instead.
+    if (!isGap || encoder_write_gap(playback->encoder, framesCount) == 0) {
+        encoder_write_pcm_frames(playback->encoder, pData, framesCount);
     }
+}
 
+// Reads up to `frameCount` frames from the ring buffer into `pOutput`.
+// Returns the number of frames copied.
+static ma_uint32 _read_from_ring(playback_device_t *playback,
+                                 ma_rb *pRb,
+                                 void *pOutput,
+                                 ma_uint32 frameCount) {
     if (!playback->isReadingEnabled) {
         LOG_DEBUG("Reading is disabled. Buffer not sufficiently filled.\n", "");
-        _encode(playback, pOutput, frameCount);
-        return;
+        return 0;
     }
 
-    ma_uint32 availableRead = ma_rb_available_read(&playback->rb);
+    ma_uint32 availableRead = ma_rb_available_read(pRb);
 
     if (availableRead < playback->config.rbMinThreshold) {
         LOG_DEBUG("Reading is disabled. Buffer not sufficiently filled.\n", "");
         playback->isReadingEnabled = false;
-        _encode(playback, pOutput, frameCount);
-        return;
+        return 0;
     }
 
     if (availableRead == 0) {
         LOG_WARN("No data available for playback.\n", "");
-        _encode(playback, pOutput, frameCount);
-        return;
+        return 0;
     }
+
     ma_uint32 bpf =
         ma_get_bytes_per_frame((ma_format)playback->config.pcmFormat,
                                playback->config.channels);
 
     ma_uint32 bytesPerFrames = frameCount * bpf;
     size_t bytesToRead = (availableRead < bytesPerFrames) ? availableRead : bytesPerFrames;
+    size_t bytesRead = 0;
 
     while (bytesToRead > 0) {
         void *bufferOut;
         size_t chunkSize = bytesToRead;
 
         ma_result acquireReadResult =
-            ma_rb_acquire_read(&playback->rb,
+            ma_rb_acquire_read(pRb,
                                &chunkSize,
                                &bufferOut);
 
@@ -109,16 +93,13 @@ static void _data_callback(ma_device *pDevice,
         }
 
         // Copy the data to the output buffer
-        memcpy(pOutput, bufferOut, chunkSize);
-        // Move the output pointer
-        pOutput = (char *)pOutput + chunkSize;
-
-        _encode(playback, bufferOut, chunkSize / bpf);
-        // Move the input pointer
+        memcpy((char *)pOutput + bytesRead, bufferOut, chunkSize);
+        // Move the output and input positions
+        bytesRead += chunkSize;
         bytesToRead -= chunkSize;
 
         ma_result commitResult = ma_rb_commit_read(
-            &playback->rb,
+            pRb,
             chunkSize);
 
         if (commitResult == MA_AT_END) {
@@ -135,24 +116,373 @@ static void _data_callback(ma_device *pDevice,
             break;
         }
     }
+
+    return (ma_uint32)(bytesRead / bpf);
+}
+
+// Pulls up to `frameCount` frames from the attached data source into `pOutput`.
+// Returns the number of frames read.
+static ma_uint32 _read_from_source(ma_data_source *pSource,
+                                   void *pOutput,
+                                   ma_uint32 frameCount) {
+    ma_uint64 framesRead = 0;
+
+    ma_result readResult =
+        ma_data_source_read_pcm_frames(pSource, pOutput, frameCount, &framesRead);
+
+    // MA_BUSY means a streaming source has nothing buffered yet.
+    if (readResult != MA_SUCCESS && readResult != MA_AT_END && readResult != MA_BUSY) {
+        LOG_ERROR("`ma_data_source_read_pcm_frames` failed: %s.\n",
+                  ma_result_description(readResult));
+    }
+
+    return (ma_uint32)framesRead;
+}
+
+// Returns the current device. Off the audio thread, read-hold `deviceLock`
+// while using it, as a migration frees the device it replaces.
+static ma_device *_device(playback_device_t *playback) {
+    return atomic_load_explicit(&playback->pDevice, memory_order_acquire);
+}
+
+// Posts the ring buffer events after a read. Runs on the audio thread.
+static void _post_ring_events(playback_device_t *playback, ma_device *pDevice, ma_rb *pRb, bool isStarved) {
+    if (!atomic_load_explicit(&playback->events.isRunning, memory_order_acquire)) {
+        playback->isStarved = isStarved;
+        return;
+    }
+
+    ma_uint32 availableRead = ma_rb_available_read(pRb);
+    device_state_t state = (device_state_t)ma_device_get_state(pDevice);
+
+    if (availableRead < playback->lowWatermark &&
+        atomic_exchange(&playback->isNeedDataArmed, false)) {
+        event_channel_post(&playback->events, playback_event_need_data, state, availableRead);
+    }
+
+    // Only a transition from playing data to silence is an underrun, not
+    // the silence before the first push.
+    if (isStarved && !playback->isStarved) {
+        event_channel_post(&playback->events, playback_event_underrun, state, availableRead);
+    }
+
+    playback->isStarved = isStarved;
+}
+
+static uint64_t _now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+static ma_rb *_ring_create(size_t sizeInBytes) {
+    ma_rb *pRb = malloc(sizeof(ma_rb));
+
+    if (!pRb) {
+        LOG_ERROR("Failed to allocate memory for `ma_rb`.\n", "");
+        return NULL;
+    }
+
+    ma_result maRbInitResult = ma_rb_init(sizeInBytes, NULL, NULL, pRb);
+
+    if (maRbInitResult != MA_SUCCESS) {
+        LOG_ERROR("`ma_rb_init` failed - %s.\n",
+                  ma_result_description(maRbInitResult));
+        free(pRb);
+        return NULL;
+    }
+
+    return pRb;
+}
+
+static void _ring_destroy(ma_rb *pRb) {
+    ma_rb_uninit(pRb);
+    LOG_INFO("<%p>(ma_rb *) destroyed.\n", pRb);
+    free(pRb);
+}
+
+// Consumption stops during an interruption unless the policy ignores it.
+static bool _is_frozen(playback_device_t *playback) {
+    if (atomic_load_explicit(&playback->isPaused, memory_order_acquire) ||
+        atomic_load_explicit(&playback->isResizing, memory_order_acquire)) {
+        return true;
+    }
+
+    return atomic_load_explicit(&playback->isInterrupted, memory_order_acquire) &&
+           atomic_load_explicit(&playback->interruptionMode, memory_order_relaxed) != playback_interruption_ignore;
+}
+
+// Drops all but the newest `rbMaxThreshold` bytes. Runs on the audio thread,
+// the reader of the ring buffer, before it resumes.
+static void _skip_stale(playback_device_t *playback, ma_rb *pRb) {
+    ma_uint32 bpf =
+        ma_get_bytes_per_frame((ma_format)playback->config.pcmFormat,
+                               playback->config.channels);
+
+    ma_uint32 availableRead = ma_rb_available_read(pRb);
+    ma_uint32 keep = playback->config.rbMaxThreshold - playback->config.rbMaxThreshold % bpf;
+
+    if (availableRead <= keep) {
+        return;
+    }
+
+    ma_uint32 skip = availableRead - keep;
+    skip -= skip % bpf;
+
+    ma_result maRbSeekResult = ma_rb_seek_read(pRb, skip);
+
+    if (maRbSeekResult != MA_SUCCESS) {
+        LOG_ERROR("`ma_rb_seek_read` failed: %s.\n", ma_result_description(maRbSeekResult));
+        return;
+    }
+
+    atomic_store_explicit(&playback->droppedBytes, skip, memory_order_relaxed);
+}
+
+// Records the time from the end of an interruption to the moment the first
+// frame of this callback reaches the speaker.
+static void _record_resume(playback_device_t *playback, ma_device *pDevice) {
+    uint64_t latencyNs = (uint64_t)estimate_playback_latency_frames(pDevice) * 1000000000ull / pDevice->sampleRate;
+    uint64_t endNs = atomic_load_explicit(&playback->interruptionEndNs, memory_order_relaxed);
+
+    atomic_store_explicit(&playback->resumeLatencyNs, _now_ns() - endNs + latencyNs, memory_order_relaxed);
+    atomic_store_explicit(&playback->isResumePending, false, memory_order_relaxed);
+}
+
+// Moves the queued bytes of `pRb` into the empty `pNewRb`, dropping the
+// oldest ones if they do not fit. The caller is the only reader of `pRb`,
+// which the frozen callback leaves alone, and `pNewRb` is not published yet.
+// Returns the bytes moved.
+static ma_uint32 _move_ring(ma_rb *pRb, ma_rb *pNewRb, ma_uint32 bpf) {
+    size_t queued = ma_rb_available_read(pRb);
+    size_t newSize = ma_rb_get_subbuffer_size(pNewRb);
+    size_t moved = 0;
+
+    newSize -= newSize % bpf;
+
+    if (queued > newSize) {
+        ma_rb_seek_read(pRb, queued - newSize);
+        queued = newSize;
+    }
+
+    // The queued bytes may wrap around the end of the old ring.
+    while (moved < queued) {
+        size_t chunkInBytes = queued - moved;
+        void *pRead;
+        void *pWrite;
+
+        if (ma_rb_acquire_read(pRb, &chunkInBytes, &pRead) != MA_SUCCESS || chunkInBytes == 0) {
+            break;
+        }
+
+        if (ma_rb_acquire_write(pNewRb, &chunkInBytes, &pWrite) != MA_SUCCESS || chunkInBytes == 0) {
+            break;
+        }
+
+        memcpy(pWrite, pRead, chunkInBytes);
+        ma_rb_commit_write(pNewRb, chunkInBytes);
+        ma_rb_commit_read(pRb, chunkInBytes);
+        moved += chunkInBytes;
+    }
+
+    return (ma_uint32)moved;
+}
+
+// Playback device data callback
+static void _data_callback(ma_device *pDevice,
+                           void *pOutput,
+                           const void *pInput,
+                           ma_uint32 frameCount) {
+    (void)pInput;
+
+    playback_device_t *playback = (playback_device_t *)pDevice->pUserData;
+
+    if (!playback) {
+        LOG_ERROR("invalid parameter: `pDevice->pUserData` is NULL.\n", "");
+        return;
+    }
+
+    // Odd while the callback runs. See `_wait_for_callback_boundary`.
+    atomic_fetch_add(&playback->callbackEpoch, 1);
+
+    ma_rb *pRb = atomic_load_explicit(&playback->pRb, memory_order_acquire);
+
+    reference_tap_t *pReferenceTap = atomic_load_explicit(&playback->pReferenceTap, memory_order_acquire);
+    uint64_t callbackNs = pReferenceTap ? _now_ns() : 0;
+
+    ma_data_source *pSource = atomic_load(&playback->pSource);
+    ma_uint32 framesRead = 0;
+
+    // While frozen, nothing is consumed and silence is not an underrun.
+    if (!_is_frozen(playback)) {
+        if (atomic_exchange_explicit(&playback->isSkipPending, false, memory_order_acquire)) {
+            _skip_stale(playback, pRb);
+        }
+
+        framesRead = pSource
+                         ? _read_from_source(pSource, pOutput, frameCount)
+                         : _read_from_ring(playback, pRb, pOutput, frameCount);
+
+        if (!pSource) {
+            _post_ring_events(playback, pDevice, pRb, framesRead < frameCount);
+        }
+
+        if (framesRead > 0 && atomic_load_explicit(&playback->isResumePending, memory_order_acquire)) {
+            _record_resume(playback, pDevice);
+        }
+    }
+
+    if (framesRead < frameCount) {
+        ma_uint32 bpf =
+            ma_get_bytes_per_frame((ma_format)playback->config.pcmFormat,
+                                   playback->config.channels);
+
+        memset((char *)pOutput + framesRead * bpf, 0, (frameCount - framesRead) * bpf);
+    }
+
+    silence_detector_t *pSilence = atomic_load_explicit(&playback->pSilence, memory_order_acquire);
+    bool isSilent = pSilence && silence_detector_process(pSilence, pOutput, frameCount);
+
+    // The recording keeps the frames as they were read, before any processing.
+    _encode(playback, pOutput, frameCount, isSilent && pSilence->config.compactRecording);
+
+    dsp_chain_t *pDspChain = atomic_load_explicit(&playback->pDspChain, memory_order_acquire);
+
+    if (pDspChain && !(isSilent && pSilence->config.skipProcessing)) {
+        dsp_chain_process(pDspChain, pOutput, frameCount);
+    }
+
+    volume_process(&playback->volume, pOutput, frameCount);
+
+    if (pReferenceTap) {
+        reference_tap_write(pReferenceTap,
+                            pOutput,
+                            frameCount,
+                            callbackNs,
+                            estimate_playback_latency_frames(pDevice),
+                            pDevice->sampleRate);
+    }
+
+    if (atomic_load_explicit(&playback->isMetering, memory_order_acquire)) {
+        meter_process(playback->pMeter, pOutput, frameCount);
+    }
+
+    spectrum_t *pSpectrum = atomic_load_explicit(&playback->pSpectrum, memory_order_acquire);
+
+    if (pSpectrum) {
+        spectrum_write(pSpectrum, pOutput, frameCount);
+    }
+
+    void *pOverview = atomic_load_explicit(&playback->pOverview, memory_order_acquire);
+
+    if (pOverview) {
+        overview_write_pcm_frames(pOverview, pOutput, frameCount);
+    }
+
+    atomic_fetch_add(&playback->callbackEpoch, 1);
+}
+
+// Blocks until no data callback that could have observed state published
+// before this call is still running. Callers swap a pointer first, then wait,
+// then release whatever the old pointer referenced.
+static void _wait_for_callback_boundary(playback_device_t *playback) {
+    unsigned int epoch = atomic_load(&playback->callbackEpoch);
+
+    if ((epoch & 1) == 0) {
+        return;
+    }
+
+    while (atomic_load(&playback->callbackEpoch) == epoch) {
+        usleep(500);
+    }
+}
+
+// Posts a device notification with the ring buffer fill. Notifications are
+// sent while the device is still transitioning, so the state is passed in.
+static void _post_device_event(ma_device *pDevice, playback_event_type_t type, device_state_t state) {
+    playback_device_t *playback = (playback_device_t *)pDevice->pUserData;
+
+    if (!playback) {
+        return;
+    }
+
+    event_channel_post(&playback->events, type, state, ma_rb_available_read(atomic_load(&playback->pRb)));
+}
+
+// Posts a state change, unless it is part of a migration.
+static void _post_state_event(ma_device *pDevice, device_state_t state) {
+    playback_device_t *playback = (playback_device_t *)pDevice->pUserData;
+
+    if (!playback || atomic_load(&playback->isMigrating)) {
+        return;
+    }
+
+    _post_device_event(pDevice, playback_event_state_changed, state);
+}
+
+static void _begin_interruption(playback_device_t *playback, device_state_t state) {
+    if (atomic_exchange(&playback->isInterrupted, true)) {
+        return;
+    }
+
+    atomic_fetch_add(&playback->interruptionCount, 1);
+
+    event_channel_post(&playback->events,
+                       playback_event_interruption_began,
+                       state,
+                       ma_rb_available_read(atomic_load(&playback->pRb)));
+}
+
+static void _end_interruption(playback_device_t *playback, device_state_t state) {
+    if (!atomic_load(&playback->isInterrupted)) {
+        return;
+    }
+
+    int mode = atomic_load(&playback->interruptionMode);
+
+    // Published before consumption resumes, so the first callback sees them.
+    if (mode != playback_interruption_ignore) {
+        atomic_store(&playback->droppedBytes, 0);
+        atomic_store(&playback->resumeLatencyNs, 0);
+        atomic_store(&playback->interruptionEndNs, _now_ns());
+        atomic_store(&playback->isSkipPending, mode == playback_interruption_resume_latest);
+        atomic_store(&playback->isResumePending, true);
+    }
+
+    atomic_store(&playback->isInterrupted, false);
+
+    event_channel_post(&playback->events,
+                       playback_event_interruption_ended,
+                       state,
+                       ma_rb_available_read(atomic_load(&playback->pRb)));
 }
 
 void notification_callback(const ma_device_notification *pNotification) {
     switch (pNotification->type) {
         case ma_device_notification_type_started:
             LOG_INFO("playbackDevice started <%p>.\n", pNotification->pDevice);
+            _post_state_event(pNotification->pDevice, device_state_started);
             break;
         case ma_device_notification_type_stopped:
             LOG_INFO("playbackDevice stopped <%p>.\n", pNotification->pDevice);
+            _post_state_event(pNotification->pDevice, device_state_stopped);
             break;
         case ma_device_notification_type_rerouted:
             LOG_INFO("playbackDevice rerouted <%p>.\n", pNotification->pDevice);
+            _post_device_event(pNotification->pDevice,
+                               playback_event_rerouted,
+                               (device_state_t)ma_device_get_state(pNotification->pDevice));
             break;
         case ma_device_notification_type_interruption_began:
             LOG_INFO("playbackDevice interruption began <%p>.\n", pNotification->pDevice);
+            _begin_interruption((playback_device_t *)pNotification->pDevice->pUserData,
+                                (device_state_t)ma_device_get_state(pNotification->pDevice));
             break;
         case ma_device_notification_type_interruption_ended:
             LOG_INFO("playbackDevice interruption ended <%p>.\n", pNotification->pDevice);
+            _end_interruption((playback_device_t *)pNotification->pDevice->pUserData,
+                              (device_state_t)ma_device_get_state(pNotification->pDevice));
             break;
         case ma_device_notification_type_unlocked:
             LOG_INFO("playbackDevice unlocked <%p>.\n", pNotification->pDevice);
@@ -162,6 +492,57 @@ void notification_callback(const ma_device_notification *pNotification) {
     }
 }
 
+// Opens a device playing the configured format for `playback` and stores it
+// in `*ppDevice`. Logs and returns the error on failure.
+static ma_result _open_device(playback_device_t *playback,
+                              audio_context_t *context,
+                              device_id *pDeviceId,
+                              ma_device **ppDevice) {
+    playback_config_t *pConfig = &playback->config;
+    ma_device *pDevice = malloc(sizeof(ma_device));
+
+    if (!pDevice) {
+        LOG_ERROR("Failed to allocate memory for `ma_device`.\n", "");
+        return MA_OUT_OF_MEMORY;
+    }
+
+    ma_device_config deviceConfig =
+        ma_device_config_init(ma_device_type_playback);
+
+    deviceConfig.playback.pDeviceID = (ma_device_id *)pDeviceId;
+    deviceConfig.playback.format = (ma_format)pConfig->pcmFormat;
+    deviceConfig.playback.channels = pConfig->channels;
+    deviceConfig.sampleRate = pConfig->sampleRate;
+
+    deviceConfig.dataCallback = _data_callback;
+    deviceConfig.notificationCallback = notification_callback;
+    deviceConfig.pUserData = playback;
+
+    deviceConfig.opensl.enableCompatibilityWorkarounds = MA_TRUE;
+    deviceConfig.opensl.recordingPreset = ma_opensl_recording_preset_voice_communication;
+
+    deviceConfig.aaudio.enableCompatibilityWorkarounds = MA_TRUE;
+    deviceConfig.aaudio.inputPreset = ma_aaudio_input_preset_voice_communication;
+
+    ma_result maDeviceInitResult =
+        ma_device_init(&context->maContext,
+                       &deviceConfig,
+                       pDevice);
+
+    if (maDeviceInitResult != MA_SUCCESS) {
+        free(pDevice);
+
+        LOG_ERROR("`ma_device_init` failed - %s.\n",
+                  ma_result_description(maDeviceInitResult));
+
+        return maDeviceInitResult;
+    }
+
+    *ppDevice = pDevice;
+
+    return MA_SUCCESS;
+}
+
 FFI_PLUGIN_EXPORT
 void *playback_device_create(void *pContext,
                              device_id *pDeviceId,
@@ -192,7 +573,7 @@ void *playback_device_create(void *pContext,
     }
 
     if (pEncoder) {
-        LOG_INFO("Using ma_encoder <%p>.\n", pEncoder);
+        LOG_INFO("Using encoder <%p>.\n", pEncoder);
         playback->encoder = pEncoder;
     }
 
@@ -200,6 +581,33 @@ void *playback_device_create(void *pContext,
 
     // Copy the config
     memcpy(&playback->config, pConfig, sizeof(playback_config_t));
+
+    // Ready before the device exists, as notifications post into it.
+    event_channel_init(&playback->events);
+    playback->lowWatermark = 0;
+    atomic_init(&playback->isNeedDataArmed, true);
+    atomic_init(&playback->isMigrating, false);
+    atomic_init(&playback->interruptionMode, playback_interruption_ignore);
+    atomic_init(&playback->hasBackpressure, false);
+    atomic_init(&playback->isInterrupted, false);
+    atomic_init(&playback->isSkipPending, false);
+    atomic_init(&playback->isResumePending, false);
+    atomic_init(&playback->interruptionEndNs, 0);
+    atomic_init(&playback->resumeLatencyNs, 0);
+    atomic_init(&playback->interruptionCount, 0);
+    atomic_init(&playback->droppedBytes, 0);
+    atomic_init(&playback->isPaused, false);
+    playback->isStarved = true;
+    playback->pMeter = NULL;
+    atomic_init(&playback->isMetering, false);
+    atomic_init(&playback->pSpectrum, NULL);
+    atomic_init(&playback->pOverview, NULL);
+    atomic_init(&playback->pReferenceTap, NULL);
+    atomic_init(&playback->pSilence, NULL);
+    atomic_init(&playback->pDspChain, NULL);
+    pthread_mutex_init(&playback->dspMutex, NULL);
+    pthread_mutex_init(&playback->rbMutex, NULL);
+    pthread_rwlock_init(&playback->deviceLock, NULL);
     uint32_t bpf = ma_get_bytes_per_frame((ma_format)pConfig->pcmFormat,
                                           pConfig->channels);
 
@@ -215,68 +623,59 @@ void *playback_device_create(void *pContext,
     LOG_INFO("  rbMinThreshold: %d\n", pConfig->rbMinThreshold);
     LOG_INFO("  bufferSizeInSec: %f\n", bufferSizeInSec);
 
-    // Initialize the playback playbackDevice
-    ma_device_config deviceConfig =
-        ma_device_config_init(ma_device_type_playback);
-
-    deviceConfig.playback.pDeviceID = (ma_device_id *)pDeviceId;
-    deviceConfig.playback.format = (ma_format)pConfig->pcmFormat;
-    deviceConfig.playback.channels = pConfig->channels;
-    deviceConfig.sampleRate = pConfig->sampleRate;
-
-    deviceConfig.dataCallback = _data_callback;
-    deviceConfig.notificationCallback = notification_callback;
-    deviceConfig.pUserData = playback;
-
-    deviceConfig.opensl.enableCompatibilityWorkarounds = MA_TRUE;
-    deviceConfig.opensl.recordingPreset = ma_opensl_recording_preset_voice_communication;
-
-    deviceConfig.aaudio.enableCompatibilityWorkarounds = MA_TRUE;
-    deviceConfig.aaudio.inputPreset = ma_aaudio_input_preset_voice_communication;
-
     audio_context_t *context = (audio_context_t *)pContext;
 
-    ma_result maDeviceInitResult =
-        ma_device_init(&context->maContext,
-                       &deviceConfig,
-                       &playback->device);
+    // Initialize the playback playbackDevice
+    ma_device *pDevice;
+    ma_result maDeviceInitResult = _open_device(playback, context, pDeviceId, &pDevice);
 
     if (maDeviceInitResult != MA_SUCCESS) {
+        event_channel_uninit(&playback->events);
+        pthread_rwlock_destroy(&playback->deviceLock);
+        pthread_mutex_destroy(&playback->dspMutex);
+        pthread_mutex_destroy(&playback->rbMutex);
         free(playback);
 
-        LOG_ERROR("`ma_device_init` failed - %s.\n",
-                  ma_result_description(maDeviceInitResult));
-
         return NULL;
     }
 
     // Initialize the ring buffer
-    ma_result maRbInitResult =
-        ma_rb_init(pConfig->rbSizeInBytes,
-                   NULL,
-                   NULL,
-                   &playback->rb);
+    ma_rb *pRb = _ring_create(pConfig->rbSizeInBytes);
 
-    if (maRbInitResult != MA_SUCCESS) {
-        ma_device_uninit(&playback->device);
+    if (!pRb) {
+        ma_device_uninit(pDevice);
+        free(pDevice);
+        event_channel_uninit(&playback->events);
+        pthread_rwlock_destroy(&playback->deviceLock);
+        pthread_mutex_destroy(&playback->dspMutex);
+        pthread_mutex_destroy(&playback->rbMutex);
 
         free(playback);
 
-        LOG_ERROR("`ma_rb_init` failed - %s.\n",
-                  ma_result_description(maRbInitResult));
-
         return NULL;
     }
 
+    atomic_init(&playback->pDevice, pDevice);
+    atomic_init(&playback->pRb, pRb);
+    atomic_init(&playback->isResizing, false);
+
     playback->isReadingEnabled = false;
+    atomic_init(&playback->pSource, NULL);
+
+    // The device resolves a channel count of 0 to the native one.
+    volume_init(&playback->volume,
+                pDevice->playback.format,
+                pDevice->playback.channels,
+                pDevice->sampleRate);
+    atomic_init(&playback->callbackEpoch, 0);
 
     audio_device_create(&playback->base, pDeviceId, context, device_type_playback);
     playback->base.vtable = (audio_device_vtable_t *)&g_playback_device_vtable;
 
     context_register_device(context, (audio_device_t *)playback);
 
-    LOG_INFO("<%p>(ma_device *) created\n", &playback->device);
-    LOG_INFO("<%p>(ma_rb *) created \n", &playback->rb);
+    LOG_INFO("<%p>(ma_device *) created\n", pDevice);
+    LOG_INFO("<%p>(ma_rb *) created \n", pRb);
     LOG_INFO("<%p>(playback_device_t *) created\n", playback);
 
     return playback;
@@ -297,32 +696,73 @@ void playback_device_destroy(void *self) {
         return;
     }
 
+    // The context clears the vtable when it destroys its devices, after it
+    // stopped its worker.
     if (playback->base.vtable) {
+        context_worker_flush(&pContext->worker);
         context_unregister_device(pContext, (audio_device_t *)playback);
     }
 
+    playback_pool_forget(&pContext->pool, playback);
+
     playback->base.vtable = NULL;
     playback->base.owner = NULL;
 
+    ma_device *pDevice = _device(playback);
     ma_result maDeviceStopResult =
-        ma_device_stop(&playback->device);
+        ma_device_stop(pDevice);
 
     if (maDeviceStopResult != MA_SUCCESS) {
         LOG_WARN("`ma_device_stop` failed - %s.\n",
                  ma_result_description(maDeviceStopResult));
     }
 
-    ma_rb_uninit(&playback->rb);
-    LOG_INFO("<%p>(ma_rb *) destroyed.\n", &playback->rb);
+    // Delivers the stop notification before the callback is released.
+    event_channel_uninit(&playback->events);
 
-    ma_device_uninit(&playback->device);
-    LOG_INFO("<%p>(ma_device *) destroyed.\n", &playback->device);
+    _ring_destroy(atomic_load(&playback->pRb));
 
-    free(playback);
-    LOG_INFO("<%p>(playback_device_t *) destroyed.\n", playback);
-}
+    ma_device_uninit(pDevice);
+    LOG_INFO("<%p>(ma_device *) destroyed.\n", pDevice);
+    free(pDevice);
 
-FFI_PLUGIN_EXPORT
+    if (playback->pMeter) {
+        meter_destroy(playback->pMeter);
+    }
+
+    spectrum_t *pSpectrum = atomic_load(&playback->pSpectrum);
+
+    if (pSpectrum) {
+        spectrum_destroy(pSpectrum);
+    }
+
+    dsp_chain_t *pDspChain = atomic_load(&playback->pDspChain);
+
+    if (pDspChain) {
+        dsp_chain_destroy(pDspChain);
+    }
+
+    reference_tap_t *pReferenceTap = atomic_load(&playback->pReferenceTap);
+
+    if (pReferenceTap) {
+        reference_tap_destroy(pReferenceTap);
+    }
+
+    silence_detector_t *pSilence = atomic_load(&playback->pSilence);
+
+    if (pSilence) {
+        silence_detector_destroy(pSilence);
+    }
+
+    pthread_rwlock_destroy(&playback->deviceLock);
+    pthread_mutex_destroy(&playback->dspMutex);
+    pthread_mutex_destroy(&playback->rbMutex);
+
+    free(playback);
+    LOG_INFO("<%p>(playback_device_t *) destroyed.\n", playback);
+}
+
+FFI_PLUGIN_EXPORT
 device_state_t playback_device_get_state(void *self) {
     if (!self) {
         LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
@@ -331,7 +771,9 @@ device_state_t playback_device_get_state(void *self) {
 
     playback_device_t *playback = (playback_device_t *)self;
 
-    ma_device_state state = ma_device_get_state(&playback->device);
+    pthread_rwlock_rdlock(&playback->deviceLock);
+    ma_device_state state = ma_device_get_state(_device(playback));
+    pthread_rwlock_unlock(&playback->deviceLock);
 
     return (device_state_t)state;
 }
@@ -346,20 +788,28 @@ void playback_device_start(void *self) {
 
     playback_device_t *playback = (playback_device_t *)self;
 
-    if (playback->device.type != ma_device_type_playback) {
+    pthread_rwlock_rdlock(&playback->deviceLock);
+
+    ma_device *pDevice = _device(playback);
+
+    if (pDevice->type != ma_device_type_playback) {
+        pthread_rwlock_unlock(&playback->deviceLock);
         LOG_ERROR("invalid playback type %d != %d.\n",
-                  playback->device.type, ma_device_type_playback);
+                  pDevice->type, ma_device_type_playback);
 
         return;
     }
 
-    if (ma_device_is_started(&playback->device)) {
+    if (ma_device_is_started(pDevice)) {
+        pthread_rwlock_unlock(&playback->deviceLock);
         LOG_INFO("playback <%p> already started.\n", playback);
         return;
     }
 
     ma_result maStartResult =
-        ma_device_start(&playback->device);
+        ma_device_start(pDevice);
+
+    pthread_rwlock_unlock(&playback->deviceLock);
 
     if (maStartResult != MA_SUCCESS) {
         LOG_ERROR("`ma_device_start` failed - %s.\n",
@@ -381,8 +831,10 @@ void playback_device_stop(void *self) {
 
     playback_device_t *playback = (playback_device_t *)self;
 
+    pthread_rwlock_rdlock(&playback->deviceLock);
     ma_result stopResult =
-        ma_device_stop(&playback->device);
+        ma_device_stop(_device(playback));
+    pthread_rwlock_unlock(&playback->deviceLock);
 
     if (stopResult != MA_SUCCESS) {
         LOG_ERROR("`ma_device_stop` failed - %s.\n",
@@ -394,28 +846,99 @@ void playback_device_stop(void *self) {
     LOG_INFO("playback <%p> stopped.\n", playback);
 }
 
+static bool _post_transition(void *self,
+                             context_request_kind_t kind,
+                             playback_transition_callback_t onComplete,
+                             void *pUserData) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+    audio_context_t *pContext = (audio_context_t *)playback->base.owner;
+
+    if (!pContext) {
+        LOG_ERROR("<%p>(playback_device_t *) has no context.\n", playback);
+        return false;
+    }
+
+    context_request_t *pRequest = calloc(1, sizeof(context_request_t));
+
+    if (!pRequest) {
+        LOG_ERROR("failed to allocate memory for a context request.\n", "");
+        return false;
+    }
+
+    pRequest->kind = kind;
+    pRequest->pDevice = playback;
+    pRequest->onComplete.onTransition = onComplete;
+    pRequest->pUserData = pUserData;
+
+    return context_worker_post(&pContext->worker, pRequest);
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_start_async(void *self, playback_transition_callback_t onComplete, void *pUserData) {
+    return _post_transition(self, context_request_device_start, onComplete, pUserData);
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_stop_async(void *self, playback_transition_callback_t onComplete, void *pUserData) {
+    return _post_transition(self, context_request_device_stop, onComplete, pUserData);
+}
+
 FFI_PLUGIN_EXPORT
-void playback_device_push_buffer(void *self, playback_data_t *pData) {
+void playback_device_pause(void *self) {
     if (!self) {
         LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
         return;
     }
 
-    if (!pData) {
-        LOG_ERROR("invalid parameter: `pData` is NULL.\n", "");
+    playback_device_t *playback = (playback_device_t *)self;
+
+    if (atomic_exchange(&playback->isPaused, true)) {
         return;
     }
 
-    if (pData->sizeInBytes == 0) {
-        LOG_ERROR("invalid parameter: `pData->sizeInBytes` is 0.\n", "");
+    // A callback that started before the flag may still be consuming.
+    _wait_for_callback_boundary(playback);
+
+    LOG_INFO("playback <%p> paused.\n", playback);
+}
+
+FFI_PLUGIN_EXPORT
+void playback_device_resume(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
         return;
     }
 
     playback_device_t *playback = (playback_device_t *)self;
 
-    ma_uint32 availableWrite = ma_rb_available_write(&playback->rb);
-    ma_uint32 availableRead = ma_rb_available_read(&playback->rb);
-    size_t bufferSize = ma_rb_get_subbuffer_size(&playback->rb);
+    if (!atomic_exchange(&playback->isPaused, false)) {
+        return;
+    }
+
+    LOG_INFO("playback <%p> resumed.\n", playback);
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_is_paused(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    return atomic_load(&((playback_device_t *)self)->isPaused);
+}
+
+// Writes `pData` to the ring buffer and returns the bytes written. The caller
+// holds `rbMutex`.
+static uint32_t _push_buffer_locked(playback_device_t *playback, ma_rb *pRb, playback_data_t *pData) {
+    ma_uint32 availableWrite = ma_rb_available_write(pRb);
+    ma_uint32 availableRead = ma_rb_available_read(pRb);
+    size_t bufferSize = ma_rb_get_subbuffer_size(pRb);
     size_t sizeInBytes = pData->sizeInBytes;
 
     ma_format format = (ma_format)playback->config.pcmFormat;
@@ -435,6 +958,18 @@ void playback_device_push_buffer(void *self, playback_data_t *pData) {
               bufferAvailableInSec,
               pushBufferInSec);
 
+    // Frozen with backpressure: keep what is queued and cut the push short.
+    if (availableWrite < sizeInBytes && _is_frozen(playback) &&
+        atomic_load_explicit(&playback->hasBackpressure, memory_order_relaxed)) {
+        sizeInBytes = availableWrite - availableWrite % bpf;
+
+        LOG_DEBUG("interrupted: pushing %zu of %u bytes.\n", sizeInBytes, pData->sizeInBytes);
+
+        if (sizeInBytes == 0) {
+            return 0;
+        }
+    }
+
     if (availableWrite < sizeInBytes) {
         size_t bytesToSkip = sizeInBytes - availableWrite;
 
@@ -448,45 +983,88 @@ void playback_device_push_buffer(void *self, playback_data_t *pData) {
         }
 
         ma_result maRbSeekResult =
-            ma_rb_seek_read(&playback->rb, bytesToSkip);
+            ma_rb_seek_read(pRb, bytesToSkip);
 
         if (maRbSeekResult != MA_SUCCESS) {
             LOG_ERROR("`ma_rb_seek_read` failed: %s.\n",
                       ma_result_description(maRbSeekResult));
-            return;
+            return 0;
         }
     }
 
-    // Acquire write buffer
-    void *bufferOut;
+    // The free space may wrap around the end of the ring, which takes two
+    // acquisitions.
+    const uint8_t *pBytes = pData->pUserData;
+    size_t pushedBytes = 0;
 
-    ma_result writeResult =
-        ma_rb_acquire_write(&playback->rb,
-                            &sizeInBytes,
-                            &bufferOut);
+    while (pushedBytes < sizeInBytes) {
+        size_t chunkInBytes = sizeInBytes - pushedBytes;
+        void *bufferOut;
 
-    if (writeResult != MA_SUCCESS) {
-        LOG_ERROR("`ma_rb_acquire_write` failed - %s.\n",
-                  ma_result_description(writeResult));
+        ma_result writeResult =
+            ma_rb_acquire_write(pRb,
+                                &chunkInBytes,
+                                &bufferOut);
 
-        return;
-    }
+        if (writeResult != MA_SUCCESS) {
+            LOG_ERROR("`ma_rb_acquire_write` failed - %s.\n",
+                      ma_result_description(writeResult));
+            break;
+        }
+
+        if (chunkInBytes == 0) {
+            break;
+        }
 
-    memcpy(bufferOut, pData->pUserData, sizeInBytes);
+        memcpy(bufferOut, pBytes + pushedBytes, chunkInBytes);
 
-    ma_result maRbCommitResult =
-        ma_rb_commit_write(&playback->rb,
-                           sizeInBytes);
+        ma_result maRbCommitResult =
+            ma_rb_commit_write(pRb,
+                               chunkInBytes);
+
+        if (maRbCommitResult != MA_SUCCESS) {
+            LOG_ERROR("`ma_rb_commit_write` failed - %s.\n",
+                      ma_result_description(maRbCommitResult));
+            break;
+        }
 
-    if (maRbCommitResult != MA_SUCCESS) {
-        LOG_ERROR("`ma_rb_commit_write` failed - %s.\n",
-                  ma_result_description(maRbCommitResult));
+        pushedBytes += chunkInBytes;
     }
 
+    atomic_store(&playback->isNeedDataArmed, true);
+
     if (!playback->isReadingEnabled && availableRead >= playback->config.rbMaxThreshold) {
         playback->isReadingEnabled = true;
         LOG_INFO("rb filled to %zu bytes. Reading enabled.\n", availableRead);
     }
+
+    return (uint32_t)pushedBytes;
+}
+
+FFI_PLUGIN_EXPORT
+uint32_t playback_device_push_buffer(void *self, playback_data_t *pData) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    if (!pData) {
+        LOG_ERROR("invalid parameter: `pData` is NULL.\n", "");
+        return 0;
+    }
+
+    if (pData->sizeInBytes == 0) {
+        LOG_ERROR("invalid parameter: `pData->sizeInBytes` is 0.\n", "");
+        return 0;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    pthread_mutex_lock(&playback->rbMutex);
+    uint32_t pushedBytes = _push_buffer_locked(playback, atomic_load(&playback->pRb), pData);
+    pthread_mutex_unlock(&playback->rbMutex);
+
+    return pushedBytes;
 }
 
 FFI_PLUGIN_EXPORT
@@ -498,10 +1076,834 @@ void playback_device_reset_buffer(void *self) {
 
     playback_device_t *playback = (playback_device_t *)self;
 
-    ma_rb_reset(&playback->rb);
+    pthread_mutex_lock(&playback->rbMutex);
+
+    ma_rb *pRb = atomic_load(&playback->pRb);
+
+    ma_rb_reset(pRb);
     playback->isReadingEnabled = false;
+    atomic_store(&playback->isNeedDataArmed, true);
+
+    pthread_mutex_unlock(&playback->rbMutex);
 
-    LOG_INFO("<%p>(ma_rb *) reset.\n", &playback->rb);
+    LOG_INFO("<%p>(ma_rb *) reset.\n", pRb);
 
     return;
 }
+
+FFI_PLUGIN_EXPORT
+bool playback_device_resize_buffer(void *self, size_t sizeInBytes) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    ma_uint32 bpf =
+        ma_get_bytes_per_frame((ma_format)playback->config.pcmFormat,
+                               playback->config.channels);
+
+    sizeInBytes -= sizeInBytes % bpf;
+
+    if (sizeInBytes == 0 || sizeInBytes < playback->config.rbMaxThreshold) {
+        LOG_ERROR("invalid parameter: `sizeInBytes` %zu is below a frame or `rbMaxThreshold`.\n", sizeInBytes);
+        return false;
+    }
+
+    ma_rb *pNewRb = _ring_create(sizeInBytes);
+
+    if (!pNewRb) {
+        return false;
+    }
+
+    // Pushes wait, so only the callback could touch the ring. Freezing it
+    // once no callback runs usually leaves the copy most of a period; a
+    // callback that still falls into it plays silence instead of reading.
+    pthread_mutex_lock(&playback->rbMutex);
+
+    ma_rb *pRb = atomic_load(&playback->pRb);
+
+    _wait_for_callback_boundary(playback);
+    atomic_store(&playback->isResizing, true);
+    _wait_for_callback_boundary(playback);
+
+    ma_uint32 moved = _move_ring(pRb, pNewRb, bpf);
+
+    atomic_store(&playback->pRb, pNewRb);
+    atomic_store(&playback->isResizing, false);
+
+    playback->config.rbSizeInBytes = sizeInBytes;
+
+    pthread_mutex_unlock(&playback->rbMutex);
+
+    // A callback that started before the swap may still hold the old ring.
+    _wait_for_callback_boundary(playback);
+    _ring_destroy(pRb);
+
+    LOG_INFO("<%p>(playback_device_t *) ring buffer resized to %zu bytes, %u kept.\n", playback, sizeInBytes, moved);
+
+    return true;
+}
+
+void playback_device_recycle(playback_device_t *playback) {
+    atomic_store(&playback->pSource, NULL);
+    playback->isReadingEnabled = false;
+    atomic_store(&playback->interruptionMode, playback_interruption_ignore);
+    atomic_store(&playback->hasBackpressure, false);
+    atomic_store(&playback->isInterrupted, false);
+    atomic_store(&playback->isSkipPending, false);
+    atomic_store(&playback->isResumePending, false);
+    atomic_store(&playback->isPaused, false);
+
+    // The next holder starts from a device as created: no stage attached,
+    // unity gain. The overview belongs to the previous holder, which may
+    // free it once the device is back in the pool.
+    atomic_store(&playback->pOverview, NULL);
+    atomic_store(&playback->isMetering, false);
+    atomic_store_explicit(&playback->volume.volume, 1.0f, memory_order_relaxed);
+    atomic_store_explicit(&playback->volume.isMuted, false, memory_order_relaxed);
+
+    spectrum_t *pSpectrum = atomic_exchange(&playback->pSpectrum, NULL);
+    reference_tap_t *pReferenceTap = atomic_exchange(&playback->pReferenceTap, NULL);
+    silence_detector_t *pSilence = atomic_exchange(&playback->pSilence, NULL);
+
+    pthread_mutex_lock(&playback->dspMutex);
+    dsp_chain_t *pDspChain = atomic_exchange(&playback->pDspChain, NULL);
+
+    // The callback no longer reads once it has seen the flags above, so the
+    // ring can be reset and the stages released from this thread.
+    _wait_for_callback_boundary(playback);
+
+    pthread_mutex_unlock(&playback->dspMutex);
+
+    if (pDspChain) {
+        dsp_chain_destroy(pDspChain);
+    }
+
+    if (pSpectrum) {
+        spectrum_destroy(pSpectrum);
+    }
+
+    if (pReferenceTap) {
+        reference_tap_destroy(pReferenceTap);
+    }
+
+    if (pSilence) {
+        silence_detector_destroy(pSilence);
+    }
+
+    pthread_mutex_lock(&playback->rbMutex);
+    ma_rb_reset(atomic_load(&playback->pRb));
+    atomic_store(&playback->isNeedDataArmed, true);
+    pthread_mutex_unlock(&playback->rbMutex);
+
+    event_channel_stop(&playback->events);
+    playback->lowWatermark = 0;
+
+    LOG_INFO("<%p>(playback_device_t *) recycled.\n", playback);
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_attach_source(void *self, void *pDataSource) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    if (pDataSource) {
+        ma_format format;
+        ma_uint32 channels;
+        ma_uint32 sampleRate;
+
+        ma_result formatResult =
+            ma_data_source_get_data_format(pDataSource,
+                                           &format,
+                                           &channels,
+                                           &sampleRate,
+                                           NULL,
+                                           0);
+
+        if (formatResult != MA_SUCCESS) {
+            LOG_ERROR("`ma_data_source_get_data_format` failed - %s.\n",
+                      ma_result_description(formatResult));
+            return false;
+        }
+
+        if (format != (ma_format)playback->config.pcmFormat ||
+            channels != playback->config.channels ||
+            sampleRate != playback->config.sampleRate) {
+            LOG_ERROR("data source format %s/%u/%u does not match device format %s/%u/%u.\n",
+                      describe_ma_format(format),
+                      channels,
+                      sampleRate,
+                      describe_ma_format((ma_format)playback->config.pcmFormat),
+                      playback->config.channels,
+                      playback->config.sampleRate);
+            return false;
+        }
+    }
+
+    ma_data_source *pPrevious = atomic_exchange(&playback->pSource, pDataSource);
+
+    // The caller may free the previous source as soon as we return.
+    if (pPrevious) {
+        _wait_for_callback_boundary(playback);
+    }
+
+    LOG_INFO("playback <%p> source <%p> attached (previous <%p>).\n",
+             playback, pDataSource, pPrevious);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+void playback_device_detach_source(void *self) {
+    playback_device_attach_source(self, NULL);
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_set_event_callback(void *self,
+                                        size_t lowWatermarkBytes,
+                                        playback_event_callback_t onEvent,
+                                        void *pUserData) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    event_channel_stop(&playback->events);
+
+    if (!onEvent) {
+        LOG_INFO("playback <%p> events disabled.\n", playback);
+        return true;
+    }
+
+    playback->lowWatermark = lowWatermarkBytes ? lowWatermarkBytes : playback->config.rbMaxThreshold;
+    atomic_store(&playback->isNeedDataArmed, true);
+
+    if (!event_channel_start(&playback->events, onEvent, pUserData)) {
+        return false;
+    }
+
+    LOG_INFO("playback <%p> events enabled - low watermark: %zu bytes.\n",
+             playback,
+             playback->lowWatermark);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_set_metering_enabled(void *self, bool enabled) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    if (!enabled) {
+        // The meter may be reset or freed once no callback uses it anymore.
+        if (atomic_exchange(&playback->isMetering, false)) {
+            _wait_for_callback_boundary(playback);
+        }
+
+        return true;
+    }
+
+    if (atomic_load(&playback->isMetering)) {
+        return true;
+    }
+
+    if (playback->pMeter) {
+        meter_reset(playback->pMeter);
+    } else {
+        playback->pMeter = meter_create((ma_format)playback->config.pcmFormat,
+                                        playback->config.channels,
+                                        playback->config.sampleRate);
+
+        if (!playback->pMeter) {
+            return false;
+        }
+    }
+
+    atomic_store_explicit(&playback->isMetering, true, memory_order_release);
+
+    LOG_INFO("playback <%p> metering enabled.\n", playback);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_get_meter(void *self, playback_meter_t *pMeter) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    if (!pMeter) {
+        LOG_ERROR("invalid parameter: `pMeter` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    if (!atomic_load_explicit(&playback->isMetering, memory_order_acquire)) {
+        return false;
+    }
+
+    meter_read(playback->pMeter, pMeter);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_set_spectrum(void *self, const spectrum_config_t *pConfig) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+    spectrum_t *pSpectrum = NULL;
+
+    if (pConfig) {
+        pSpectrum = spectrum_create((ma_format)playback->config.pcmFormat,
+                                    playback->config.channels,
+                                    playback->config.sampleRate,
+                                    pConfig);
+
+        if (!pSpectrum) {
+            return false;
+        }
+    }
+
+    spectrum_t *pPrevious = atomic_exchange(&playback->pSpectrum, pSpectrum);
+
+    if (pPrevious) {
+        _wait_for_callback_boundary(playback);
+        spectrum_destroy(pPrevious);
+    }
+
+    LOG_INFO("playback <%p> spectrum <%p> set (previous <%p>).\n", playback, pSpectrum, pPrevious);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+uint32_t playback_device_get_spectrum(void *self, float *pBins, uint32_t binCount, uint64_t *pSequence) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    if (!pBins) {
+        LOG_ERROR("invalid parameter: `pBins` is NULL.\n", "");
+        return 0;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+    spectrum_t *pSpectrum = atomic_load(&playback->pSpectrum);
+
+    if (!pSpectrum) {
+        if (pSequence) {
+            *pSequence = 0;
+        }
+
+        return 0;
+    }
+
+    return spectrum_read(pSpectrum, pBins, binCount, pSequence);
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_set_overview(void *self, void *pOverview) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    if (pOverview) {
+        overview_config_t config;
+        overview_get_config(pOverview, &config);
+
+        if (config.pcmFormat != playback->config.pcmFormat ||
+            config.channels != playback->config.channels) {
+            LOG_ERROR("overview format %s/%u does not match device format %s/%u.\n",
+                      describe_ma_format((ma_format)config.pcmFormat),
+                      config.channels,
+                      describe_ma_format((ma_format)playback->config.pcmFormat),
+                      playback->config.channels);
+            return false;
+        }
+
+        // The data callback must not drain the tap.
+        overview_set_self_draining((overview_t *)pOverview, false);
+    }
+
+    void *pPrevious = atomic_exchange(&playback->pOverview, pOverview);
+
+    // The caller may destroy the previous overview as soon as we return.
+    if (pPrevious) {
+        _wait_for_callback_boundary(playback);
+    }
+
+    LOG_INFO("playback <%p> overview <%p> set (previous <%p>).\n", playback, pOverview, pPrevious);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_set_dsp_chain(void *self, const playback_dsp_stage_t *pStages, uint32_t stageCount) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    if (!pStages && stageCount > 0) {
+        LOG_ERROR("invalid parameter: `pStages` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+    dsp_chain_t *pDspChain = NULL;
+
+    if (stageCount > 0) {
+        pDspChain = dsp_chain_create((ma_format)playback->config.pcmFormat,
+                                     playback->config.channels,
+                                     playback->config.sampleRate,
+                                     pStages,
+                                     stageCount);
+
+        if (!pDspChain) {
+            return false;
+        }
+    }
+
+    pthread_mutex_lock(&playback->dspMutex);
+
+    dsp_chain_t *pPrevious = atomic_exchange(&playback->pDspChain, pDspChain);
+
+    if (pPrevious) {
+        _wait_for_callback_boundary(playback);
+        dsp_chain_destroy(pPrevious);
+    }
+
+    pthread_mutex_unlock(&playback->dspMutex);
+
+    LOG_INFO("playback <%p> DSP chain <%p> set (previous <%p>).\n", playback, pDspChain, pPrevious);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_update_dsp_stage(void *self, uint32_t stageIndex, const playback_dsp_stage_t *pStage) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    if (!pStage) {
+        LOG_ERROR("invalid parameter: `pStage` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    pthread_mutex_lock(&playback->dspMutex);
+
+    dsp_chain_t *pDspChain = atomic_load(&playback->pDspChain);
+    bool isPosted = false;
+
+    if (pDspChain) {
+        isPosted = dsp_chain_post_update(pDspChain, stageIndex, pStage);
+    } else {
+        LOG_ERROR("playback <%p> has no DSP chain.\n", playback);
+    }
+
+    pthread_mutex_unlock(&playback->dspMutex);
+
+    return isPosted;
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_set_volume(void *self, float volume) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    if (!(volume >= 0.0f && volume <= PLAYBACK_VOLUME_MAX)) {
+        LOG_ERROR("invalid parameter: `volume` %f is not in [0, %f].\n", volume, PLAYBACK_VOLUME_MAX);
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    atomic_store_explicit(&playback->volume.volume, volume, memory_order_relaxed);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+float playback_device_get_volume(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0.0f;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    return atomic_load_explicit(&playback->volume.volume, memory_order_relaxed);
+}
+
+FFI_PLUGIN_EXPORT
+void playback_device_set_muted(void *self, bool muted) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    atomic_store_explicit(&playback->volume.isMuted, muted, memory_order_relaxed);
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_is_muted(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    return atomic_load_explicit(&playback->volume.isMuted, memory_order_relaxed);
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_set_reference_tap(void *self, uint32_t capacityFrames) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+    reference_tap_t *pReferenceTap = NULL;
+
+    if (capacityFrames > 0) {
+        pthread_rwlock_rdlock(&playback->deviceLock);
+        ma_device *pDevice = _device(playback);
+        pReferenceTap = reference_tap_create(pDevice->playback.format,
+                                             pDevice->playback.channels,
+                                             capacityFrames);
+        pthread_rwlock_unlock(&playback->deviceLock);
+
+        if (!pReferenceTap) {
+            return false;
+        }
+    }
+
+    reference_tap_t *pPrevious = atomic_exchange(&playback->pReferenceTap, pReferenceTap);
+
+    if (pPrevious) {
+        _wait_for_callback_boundary(playback);
+        reference_tap_destroy(pPrevious);
+    }
+
+    LOG_INFO("playback <%p> reference tap <%p> set (previous <%p>).\n", playback, pReferenceTap, pPrevious);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+const void *playback_device_acquire_reference(void *self, playback_reference_block_t *pBlock) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return NULL;
+    }
+
+    if (!pBlock) {
+        LOG_ERROR("invalid parameter: `pBlock` is NULL.\n", "");
+        return NULL;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+    reference_tap_t *pReferenceTap = atomic_load(&playback->pReferenceTap);
+
+    return pReferenceTap ? reference_tap_acquire(pReferenceTap, pBlock) : NULL;
+}
+
+FFI_PLUGIN_EXPORT
+void playback_device_release_reference(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+    reference_tap_t *pReferenceTap = atomic_load(&playback->pReferenceTap);
+
+    if (pReferenceTap) {
+        reference_tap_release(pReferenceTap);
+    }
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_set_silence_detection(void *self, const playback_silence_config_t *pConfig) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+    silence_detector_t *pSilence = NULL;
+
+    if (pConfig) {
+        pthread_rwlock_rdlock(&playback->deviceLock);
+        ma_device *pDevice = _device(playback);
+        pSilence = silence_detector_create(pDevice->playback.format,
+                                           pDevice->playback.channels,
+                                           pDevice->sampleRate,
+                                           pConfig);
+        pthread_rwlock_unlock(&playback->deviceLock);
+
+        if (!pSilence) {
+            return false;
+        }
+    }
+
+    silence_detector_t *pPrevious = atomic_exchange(&playback->pSilence, pSilence);
+
+    if (pPrevious) {
+        _wait_for_callback_boundary(playback);
+        silence_detector_destroy(pPrevious);
+    }
+
+    LOG_INFO("playback <%p> silence detector <%p> set (previous <%p>).\n", playback, pSilence, pPrevious);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_get_silence_stats(void *self, playback_silence_stats_t *pStats) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    if (!pStats) {
+        LOG_ERROR("invalid parameter: `pStats` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    // The detector is only replaced by the owner of the device, which is the
+    // thread reading the statistics.
+    silence_detector_t *pSilence = atomic_load(&playback->pSilence);
+
+    if (!pSilence) {
+        return false;
+    }
+
+    silence_detector_read(pSilence, pStats);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_migrate(void *self, device_id *pDeviceId, playback_migration_t *pResult) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+    audio_context_t *context = (audio_context_t *)playback->base.owner;
+    ma_device *pNewDevice;
+
+    uint64_t openStartNs = _now_ns();
+
+    if (_open_device(playback, context, pDeviceId, &pNewDevice) != MA_SUCCESS) {
+        return false;
+    }
+
+    // Queued transitions act on `pDevice`; let them finish on the old device.
+    // Later ones wait for the switch on `deviceLock`.
+    context_worker_flush(&context->worker);
+
+    pthread_rwlock_wrlock(&playback->deviceLock);
+
+    ma_device *pOldDevice = _device(playback);
+
+    // The ring buffer and every stage keep the format they were made for.
+    if (pNewDevice->playback.format != pOldDevice->playback.format ||
+        pNewDevice->playback.channels != pOldDevice->playback.channels ||
+        pNewDevice->sampleRate != pOldDevice->sampleRate) {
+        LOG_ERROR("the new device plays %s, %u channels at %u Hz instead of %s, %u channels at %u Hz.\n",
+                  describe_ma_format(pNewDevice->playback.format),
+                  pNewDevice->playback.channels,
+                  pNewDevice->sampleRate,
+                  describe_ma_format(pOldDevice->playback.format),
+                  pOldDevice->playback.channels,
+                  pOldDevice->sampleRate);
+
+        pthread_rwlock_unlock(&playback->deviceLock);
+
+        ma_device_uninit(pNewDevice);
+        free(pNewDevice);
+        return false;
+    }
+
+    bool wasStarted = ma_device_is_started(pOldDevice);
+    uint64_t switchStartNs = _now_ns();
+
+    atomic_store(&playback->isMigrating, true);
+
+    ma_result maStopResult = ma_device_stop(pOldDevice);
+
+    if (maStopResult != MA_SUCCESS) {
+        LOG_WARN("`ma_device_stop` failed - %s.\n", ma_result_description(maStopResult));
+    }
+
+    // Only one device may read the ring buffer at a time.
+    _wait_for_callback_boundary(playback);
+
+    atomic_store_explicit(&playback->pDevice, pNewDevice, memory_order_release);
+    uint32_t bufferedBytes = ma_rb_available_read(atomic_load(&playback->pRb));
+
+    if (wasStarted) {
+        ma_result maStartResult = ma_device_start(pNewDevice);
+
+        if (maStartResult != MA_SUCCESS) {
+            LOG_ERROR("`ma_device_start` failed - %s, staying on <%p>.\n",
+                      ma_result_description(maStartResult),
+                      pOldDevice);
+
+            // The new device never ran, so the ring buffer is untouched and
+            // the old device takes over where it stopped.
+            atomic_store_explicit(&playback->pDevice, pOldDevice, memory_order_release);
+            maStartResult = ma_device_start(pOldDevice);
+
+            if (maStartResult != MA_SUCCESS) {
+                LOG_ERROR("`ma_device_start` failed on <%p> - %s.\n",
+                          pOldDevice,
+                          ma_result_description(maStartResult));
+            }
+
+            atomic_store(&playback->isMigrating, false);
+            pthread_rwlock_unlock(&playback->deviceLock);
+
+            ma_device_uninit(pNewDevice);
+            free(pNewDevice);
+
+            return false;
+        }
+    }
+
+    uint64_t switchEndNs = _now_ns();
+
+    atomic_store(&playback->isMigrating, false);
+
+    // No caller can reach the old device once the lock is released.
+    pthread_rwlock_unlock(&playback->deviceLock);
+
+    ma_device_uninit(pOldDevice);
+    free(pOldDevice);
+
+    if (pDeviceId) {
+        memcpy(&playback->base.id, pDeviceId, sizeof(device_id));
+    } else {
+        memset(&playback->base.id, 0, sizeof(device_id));
+    }
+
+    if (pResult) {
+        pResult->openNs = switchStartNs - openStartNs;
+        pResult->switchNs = switchEndNs - switchStartNs;
+        pResult->bufferedBytes = bufferedBytes;
+    }
+
+    LOG_INFO("playback <%p> migrated to <%p> in %llu us.\n",
+             playback, pNewDevice, (unsigned long long)((switchEndNs - switchStartNs) / 1000));
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_set_interruption_policy(void *self, const playback_interruption_policy_t *pPolicy) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    if (!pPolicy) {
+        atomic_store(&playback->hasBackpressure, false);
+        atomic_store(&playback->interruptionMode, playback_interruption_ignore);
+        return true;
+    }
+
+    if (pPolicy->mode > playback_interruption_resume_latest) {
+        LOG_ERROR("invalid interruption mode %d.\n", pPolicy->mode);
+        return false;
+    }
+
+    atomic_store(&playback->hasBackpressure, pPolicy->backpressure);
+    atomic_store(&playback->interruptionMode, pPolicy->mode);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_device_get_interruption_stats(void *self, playback_interruption_stats_t *pStats) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    if (!pStats) {
+        LOG_ERROR("invalid parameter: `pStats` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    pStats->isInterrupted = atomic_load(&playback->isInterrupted);
+    pStats->interruptionCount = atomic_load(&playback->interruptionCount);
+    pStats->droppedBytes = atomic_load(&playback->droppedBytes);
+    pStats->resumeLatencyNs = atomic_load(&playback->resumeLatencyNs);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+void playback_device_begin_interruption(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    _begin_interruption(playback, playback_device_get_state(playback));
+}
+
+FFI_PLUGIN_EXPORT
+void playback_device_end_interruption(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+
+    _end_interruption(playback, playback_device_get_state(playback));
+}
@@ -0,0 +1,511 @@
+#include "../include/playback_group.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/audio_context_private.h"
+#include "../include/internal.h"
+#include "../include/logger.h"
+#include "../include/miniaudio.h"
+#include "../include/playback_group_private.h"
+
+#define PLAYBACK_GROUP_DEFAULT_LATENCY_MS 50
+
+// Time constant of the filter applied to the fill level of an output. The
+// fill moves by a whole callback at every read, so it must be averaged over
+// many callbacks before it says anything about drift.
+#define PLAYBACK_GROUP_SMOOTHING_SECONDS 1.0
+
+// The ratio corrects a fill error of `e` frames in about this many seconds.
+#define PLAYBACK_GROUP_CORRECTION_SECONDS 10.0
+
+// Largest correction of the ratio, 0.5%, well beyond the drift of real
+// clocks and small enough that the pitch change cannot be heard.
+#define PLAYBACK_GROUP_MAX_CORRECTION 0.005
+
+// Resolution of `ma_linear_resampler_set_rate_ratio`; smaller changes are
+// not applied, which spares resetting the rate at every callback.
+#define PLAYBACK_GROUP_RATIO_STEP 1e-6
+
+static playback_group_output_t *_output_at(playback_group_t *group, uint32_t index) {
+    return index < group->outputCount ? group->outputs[index] : NULL;
+}
+
+// Updates the ratio of the resampler from the fill level measured after a
+// read. Audio thread of the output.
+static void _correct_drift(playback_group_output_t *output,
+                           playback_group_t *group,
+                           uint32_t queuedFrames,
+                           uint32_t frameCount) {
+    uint32_t latencyFrames = estimate_playback_latency_frames(&output->device);
+    double fill = (double)queuedFrames + latencyFrames;
+    double alpha = frameCount / (group->config.sampleRate * PLAYBACK_GROUP_SMOOTHING_SECONDS);
+
+    output->smoothedFill += (alpha < 1.0 ? alpha : 1.0) * (fill - output->smoothedFill);
+
+    // More frames queued than the target means the device is slower than
+    // the producer, so it must consume more than one frame per frame played.
+    double error = output->smoothedFill - group->config.targetLatencyFrames;
+    double correction = error / (group->config.sampleRate * PLAYBACK_GROUP_CORRECTION_SECONDS);
+
+    if (correction > PLAYBACK_GROUP_MAX_CORRECTION) {
+        correction = PLAYBACK_GROUP_MAX_CORRECTION;
+    } else if (correction < -PLAYBACK_GROUP_MAX_CORRECTION) {
+        correction = -PLAYBACK_GROUP_MAX_CORRECTION;
+    }
+
+    double ratio = 1.0 + correction;
+
+    if (fabs(ratio - output->ratio) >= PLAYBACK_GROUP_RATIO_STEP) {
+        ma_linear_resampler_set_rate_ratio(&output->resampler, (float)ratio);
+        output->ratio = ratio;
+    }
+
+    atomic_store_explicit(&output->queuedFrames, queuedFrames, memory_order_relaxed);
+    atomic_store_explicit(&output->latencyFrames, latencyFrames, memory_order_relaxed);
+    atomic_store_explicit(&output->publishedRatio, (float)output->ratio, memory_order_relaxed);
+    atomic_store_explicit(&output->publishedFill, (float)output->smoothedFill, memory_order_relaxed);
+}
+
+static void _data_callback(ma_device *pDevice,
+                           void *pOutput,
+                           const void *pInput,
+                           ma_uint32 frameCount) {
+    (void)pInput;
+
+    playback_group_output_t *output = (playback_group_output_t *)pDevice->pUserData;
+    playback_group_t *group = (playback_group_t *)output->pGroup;
+
+    uint32_t capacity = group->config.capacityFrames;
+    uint32_t bpf = group->bytesPerFrame;
+    uint64_t writePosition = atomic_load_explicit(&group->writePosition, memory_order_acquire);
+    uint64_t readPosition = atomic_load_explicit(&output->readPosition, memory_order_relaxed);
+
+    // After a start or an underrun, wait for the target, then skip what is
+    // queued beyond it, so every output starts at the same distance behind
+    // the producer whenever its first callback comes.
+    if (!output->isPlaying) {
+        uint64_t target = group->config.targetLatencyFrames;
+        uint64_t latencyFrames = estimate_playback_latency_frames(pDevice);
+
+        if (writePosition - readPosition < target) {
+            ma_silence_pcm_frames(pOutput, frameCount, pDevice->playback.format, pDevice->playback.channels);
+            return;
+        }
+
+        uint64_t queued = target > latencyFrames ? target - latencyFrames : 0;
+
+        readPosition = writePosition - queued;
+        output->isPlaying = true;
+        output->smoothedFill = (double)(queued + latencyFrames);
+    }
+
+    ma_uint64 produced = 0;
+
+    while (produced < frameCount && readPosition < writePosition) {
+        uint32_t offset = (uint32_t)(readPosition % capacity);
+        ma_uint64 contiguous = writePosition - readPosition;
+
+        if (contiguous > capacity - offset) {
+            contiguous = capacity - offset;
+        }
+
+        ma_uint64 frameCountIn = contiguous;
+        ma_uint64 frameCountOut = frameCount - produced;
+
+        ma_linear_resampler_process_pcm_frames(&output->resampler,
+                                               group->pRing + (size_t)offset * bpf,
+                                               &frameCountIn,
+                                               (char *)pOutput + (size_t)produced * bpf,
+                                               &frameCountOut);
+
+        if (frameCountIn == 0 && frameCountOut == 0) {
+            break;
+        }
+
+        readPosition += frameCountIn;
+        produced += frameCountOut;
+    }
+
+    atomic_store_explicit(&output->readPosition, readPosition, memory_order_release);
+    atomic_fetch_add_explicit(&output->framesPlayed, produced, memory_order_relaxed);
+
+    if (produced < frameCount) {
+        ma_silence_pcm_frames((char *)pOutput + (size_t)produced * bpf,
+                              frameCount - produced,
+                              pDevice->playback.format,
+                              pDevice->playback.channels);
+
+        output->isPlaying = false;
+        atomic_fetch_add_explicit(&output->underruns, 1, memory_order_relaxed);
+    }
+
+    _correct_drift(output, group, (uint32_t)(writePosition - readPosition), frameCount);
+}
+
+static audio_device_vtable_t g_playback_group_vtable = {
+    .start = playback_group_start,
+    .stop = playback_group_stop,
+    .destroy = playback_group_destroy,
+    .get_state = playback_group_get_state};
+
+FFI_PLUGIN_EXPORT
+void *playback_group_create(void *pContext, playback_group_config_t *pConfig) {
+    if (!pContext) {
+        LOG_ERROR("invalid parameter: `pContext` is NULL.\n", "");
+        return NULL;
+    }
+
+    if (!pConfig) {
+        LOG_ERROR("invalid parameter: `pConfig` is NULL.\n", "");
+        return NULL;
+    }
+
+    // The drift-correcting resampler only handles these formats.
+    if (pConfig->pcmFormat != pcm_format_s16 && pConfig->pcmFormat != pcm_format_f32) {
+        LOG_ERROR("unsupported format %s, expected s16 or f32.\n",
+                  describe_ma_format((ma_format)pConfig->pcmFormat));
+        return NULL;
+    }
+
+    if (pConfig->channels == 0 || pConfig->sampleRate == 0) {
+        LOG_ERROR("invalid parameter: `channels` and `sampleRate` must not be 0.\n", "");
+        return NULL;
+    }
+
+    playback_group_t *group = calloc(1, sizeof(playback_group_t));
+
+    if (!group) {
+        LOG_ERROR("Failed to allocate memory for `playback_group_t`.\n", "");
+        return NULL;
+    }
+
+    group->config = *pConfig;
+
+    if (group->config.capacityFrames == 0) {
+        group->config.capacityFrames = pConfig->sampleRate;
+    }
+
+    if (group->config.targetLatencyFrames == 0) {
+        group->config.targetLatencyFrames = pConfig->sampleRate * PLAYBACK_GROUP_DEFAULT_LATENCY_MS / 1000;
+    }
+
+    if (group->config.targetLatencyFrames >= group->config.capacityFrames) {
+        LOG_ERROR("`targetLatencyFrames` %u does not fit in %u frames.\n",
+                  group->config.targetLatencyFrames, group->config.capacityFrames);
+        free(group);
+        return NULL;
+    }
+
+    group->bytesPerFrame = ma_get_bytes_per_frame((ma_format)pConfig->pcmFormat, pConfig->channels);
+    group->pRing = malloc((size_t)group->config.capacityFrames * group->bytesPerFrame);
+
+    if (!group->pRing) {
+        LOG_ERROR("Failed to allocate a ring of %u frames.\n", group->config.capacityFrames);
+        free(group);
+        return NULL;
+    }
+
+    atomic_init(&group->writePosition, 0);
+
+    audio_context_t *context = (audio_context_t *)pContext;
+
+    audio_device_create(&group->base, NULL, context, device_type_playback);
+    group->base.vtable = &g_playback_group_vtable;
+
+    context_register_device(context, (audio_device_t *)group);
+
+    LOG_INFO("<%p>(playback_group_t *) created\n", group);
+
+    return group;
+}
+
+FFI_PLUGIN_EXPORT
+void playback_group_destroy(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    playback_group_t *group = (playback_group_t *)self;
+    audio_context_t *pContext = (audio_context_t *)group->base.owner;
+
+    if (group->base.vtable && pContext) {
+        context_unregister_device(pContext, (audio_device_t *)group);
+    }
+
+    group->base.vtable = NULL;
+    group->base.owner = NULL;
+
+    for (uint32_t i = 0; i < group->outputCount; i++) {
+        playback_group_output_t *output = group->outputs[i];
+
+        ma_device_uninit(&output->device);
+        ma_linear_resampler_uninit(&output->resampler, NULL);
+        free(output);
+    }
+
+    LOG_INFO("<%p>(playback_group_t *) destroyed.\n", group);
+
+    free(group->pRing);
+    free(group);
+}
+
+FFI_PLUGIN_EXPORT
+int32_t playback_group_add_output(void *self, device_id *pDeviceId) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return -1;
+    }
+
+    playback_group_t *group = (playback_group_t *)self;
+    audio_context_t *context = (audio_context_t *)group->base.owner;
+
+    if (group->isStarted) {
+        LOG_ERROR("outputs can only be added to a stopped group.\n", "");
+        return -1;
+    }
+
+    if (group->outputCount == PLAYBACK_GROUP_MAX_OUTPUTS) {
+        LOG_ERROR("a group holds at most %d outputs.\n", PLAYBACK_GROUP_MAX_OUTPUTS);
+        return -1;
+    }
+
+    playback_group_output_t *output = calloc(1, sizeof(playback_group_output_t));
+
+    if (!output) {
+        LOG_ERROR("Failed to allocate memory for `playback_group_output_t`.\n", "");
+        return -1;
+    }
+
+    // The order of the filter is 0: a ratio this close to 1 does not alias.
+    ma_linear_resampler_config resamplerConfig =
+        ma_linear_resampler_config_init((ma_format)group->config.pcmFormat,
+                                        group->config.channels,
+                                        group->config.sampleRate,
+                                        group->config.sampleRate);
+    resamplerConfig.lpfOrder = 0;
+
+    ma_result maResamplerInitResult =
+        ma_linear_resampler_init(&resamplerConfig, NULL, &output->resampler);
+
+    if (maResamplerInitResult != MA_SUCCESS) {
+        LOG_ERROR("`ma_linear_resampler_init` failed - %s.\n",
+                  ma_result_description(maResamplerInitResult));
+        free(output);
+        return -1;
+    }
+
+    ma_device_config deviceConfig = ma_device_config_init(ma_device_type_playback);
+
+    deviceConfig.playback.pDeviceID = (ma_device_id *)pDeviceId;
+    deviceConfig.playback.format = (ma_format)group->config.pcmFormat;
+    deviceConfig.playback.channels = group->config.channels;
+    deviceConfig.sampleRate = group->config.sampleRate;
+    deviceConfig.dataCallback = _data_callback;
+    deviceConfig.pUserData = output;
+
+    ma_result maDeviceInitResult =
+        ma_device_init(&context->maContext, &deviceConfig, &output->device);
+
+    if (maDeviceInitResult != MA_SUCCESS) {
+        LOG_ERROR("`ma_device_init` failed - %s.\n",
+                  ma_result_description(maDeviceInitResult));
+        ma_linear_resampler_uninit(&output->resampler, NULL);
+        free(output);
+        return -1;
+    }
+
+    // A new output starts with the frames the others still have queued.
+    uint64_t readPosition = atomic_load(&group->writePosition);
+
+    for (uint32_t i = 0; i < group->outputCount; i++) {
+        uint64_t other = atomic_load(&group->outputs[i]->readPosition);
+
+        if (other < readPosition) {
+            readPosition = other;
+        }
+    }
+
+    output->pGroup = group;
+    output->ratio = 1.0;
+    atomic_init(&output->readPosition, readPosition);
+    atomic_init(&output->framesPlayed, 0);
+    atomic_init(&output->queuedFrames, 0);
+    atomic_init(&output->latencyFrames, estimate_playback_latency_frames(&output->device));
+    atomic_init(&output->underruns, 0);
+    atomic_init(&output->publishedRatio, 1.0f);
+    atomic_init(&output->publishedFill, 0.0f);
+
+    group->outputs[group->outputCount] = output;
+
+    LOG_INFO("<%p>(playback_group_t *) output %u added.\n", group, group->outputCount);
+
+    return (int32_t)group->outputCount++;
+}
+
+FFI_PLUGIN_EXPORT
+uint32_t playback_group_get_output_count(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    return ((playback_group_t *)self)->outputCount;
+}
+
+FFI_PLUGIN_EXPORT
+void playback_group_start(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    playback_group_t *group = (playback_group_t *)self;
+
+    if (group->isStarted) {
+        LOG_INFO("group <%p> already started.\n", group);
+        return;
+    }
+
+    for (uint32_t i = 0; i < group->outputCount; i++) {
+        ma_result maStartResult = ma_device_start(&group->outputs[i]->device);
+
+        if (maStartResult != MA_SUCCESS) {
+            LOG_ERROR("`ma_device_start` failed for output %u - %s.\n",
+                      i, ma_result_description(maStartResult));
+        }
+    }
+
+    group->isStarted = true;
+
+    LOG_INFO("group <%p> started.\n", group);
+}
+
+FFI_PLUGIN_EXPORT
+void playback_group_stop(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    playback_group_t *group = (playback_group_t *)self;
+
+    for (uint32_t i = 0; i < group->outputCount; i++) {
+        playback_group_output_t *output = group->outputs[i];
+        ma_result maStopResult = ma_device_stop(&output->device);
+
+        if (maStopResult != MA_SUCCESS) {
+            LOG_WARN("`ma_device_stop` failed for output %u - %s.\n",
+                     i, ma_result_description(maStopResult));
+        }
+
+        // The callback no longer runs, so its state can be reset here.
+        output->isPlaying = false;
+    }
+
+    group->isStarted = false;
+
+    LOG_INFO("group <%p> stopped.\n", group);
+}
+
+FFI_PLUGIN_EXPORT
+device_state_t playback_group_get_state(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return device_state_uninitialized;
+    }
+
+    return ((playback_group_t *)self)->isStarted ? device_state_started : device_state_stopped;
+}
+
+FFI_PLUGIN_EXPORT
+uint32_t playback_group_push(void *self, const void *pData, uint32_t sizeInBytes) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    if (!pData) {
+        LOG_ERROR("invalid parameter: `pData` is NULL.\n", "");
+        return 0;
+    }
+
+    playback_group_t *group = (playback_group_t *)self;
+    uint32_t capacity = group->config.capacityFrames;
+    uint32_t bpf = group->bytesPerFrame;
+    uint64_t writePosition = atomic_load_explicit(&group->writePosition, memory_order_relaxed);
+
+    // The slowest output bounds the writer. Without outputs nothing reads,
+    // so the frames are dropped as they would be on a disconnected device.
+    uint64_t oldest = writePosition;
+
+    for (uint32_t i = 0; i < group->outputCount; i++) {
+        uint64_t readPosition = atomic_load_explicit(&group->outputs[i]->readPosition, memory_order_acquire);
+
+        if (readPosition < oldest) {
+            oldest = readPosition;
+        }
+    }
+
+    uint64_t frames = sizeInBytes / bpf;
+    uint64_t space = capacity - (writePosition - oldest);
+
+    if (frames > space) {
+        frames = space;
+    }
+
+    const uint8_t *pFrames = (const uint8_t *)pData;
+
+    for (uint64_t written = 0; written < frames;) {
+        uint32_t offset = (uint32_t)((writePosition + written) % capacity);
+        uint64_t contiguous = capacity - offset;
+
+        if (contiguous > frames - written) {
+            contiguous = frames - written;
+        }
+
+        memcpy(group->pRing + (size_t)offset * bpf, pFrames + (size_t)written * bpf, (size_t)contiguous * bpf);
+        written += contiguous;
+    }
+
+    atomic_store_explicit(&group->writePosition, writePosition + frames, memory_order_release);
+
+    return (uint32_t)(frames * bpf);
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_group_get_output_stats(void *self, uint32_t index, playback_group_output_stats_t *pStats) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    if (!pStats) {
+        LOG_ERROR("invalid parameter: `pStats` is NULL.\n", "");
+        return false;
+    }
+
+    playback_group_t *group = (playback_group_t *)self;
+    playback_group_output_t *output = _output_at(group, index);
+
+    if (!output) {
+        LOG_ERROR("invalid parameter: output %u does not exist.\n", index);
+        return false;
+    }
+
+    // An output plays the frame `writePosition - fill`, so the difference
+    // of the fills of two outputs is how far one is ahead of the other.
+    float fill = atomic_load_explicit(&output->publishedFill, memory_order_relaxed);
+    float reference = atomic_load_explicit(&group->outputs[0]->publishedFill, memory_order_relaxed);
+
+    pStats->framesPlayed = atomic_load_explicit(&output->framesPlayed, memory_order_relaxed);
+    pStats->queuedFrames = atomic_load_explicit(&output->queuedFrames, memory_order_relaxed);
+    pStats->latencyFrames = atomic_load_explicit(&output->latencyFrames, memory_order_relaxed);
+    pStats->underruns = atomic_load_explicit(&output->underruns, memory_order_relaxed);
+    pStats->ratio = atomic_load_explicit(&output->publishedRatio, memory_order_relaxed);
+    pStats->offsetFrames = reference - fill;
+
+    return true;
+}
@@ -0,0 +1,345 @@
+#include "../include/playback_pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/audio_context_private.h"
+#include "../include/logger.h"
+#include "../include/playback_pool_private.h"
+
+void playback_pool_init(playback_pool_t *self) {
+    pthread_mutex_init(&self->mutex, NULL);
+    self->pEntries = NULL;
+    self->count = 0;
+    self->capacity = 0;
+    self->hits = 0;
+    self->misses = 0;
+}
+
+void playback_pool_uninit(playback_pool_t *self) {
+    free(self->pEntries);
+    self->pEntries = NULL;
+    self->count = 0;
+    self->capacity = 0;
+
+    pthread_mutex_destroy(&self->mutex);
+}
+
+static bool _config_equals(const playback_config_t *a, const playback_config_t *b) {
+    return a->channels == b->channels &&
+           a->sampleRate == b->sampleRate &&
+           a->pcmFormat == b->pcmFormat &&
+           a->rbMaxThreshold == b->rbMaxThreshold &&
+           a->rbMinThreshold == b->rbMinThreshold &&
+           a->rbSizeInBytes == b->rbSizeInBytes;
+}
+
+static bool _matches(const playback_pool_entry_t *pEntry,
+                     const device_id *pDeviceId,
+                     const playback_config_t *pConfig) {
+    if (pEntry->isDefault != (pDeviceId == NULL)) {
+        return false;
+    }
+
+    if (pDeviceId && memcmp(&pEntry->id, pDeviceId, sizeof(device_id)) != 0) {
+        return false;
+    }
+
+    return _config_equals(&pEntry->config, pConfig);
+}
+
+// Adds an entry. The caller holds `mutex`.
+static bool _add_locked(playback_pool_t *self,
+                        void *pDevice,
+                        const device_id *pDeviceId,
+                        const playback_config_t *pConfig,
+                        bool isIdle) {
+    if (self->count == self->capacity) {
+        uint32_t capacity = self->capacity ? self->capacity * 2 : 4;
+        playback_pool_entry_t *pEntries = realloc(self->pEntries, capacity * sizeof(playback_pool_entry_t));
+
+        if (!pEntries) {
+            LOG_ERROR("Failed to allocate memory for the playback pool.\n", "");
+            return false;
+        }
+
+        self->pEntries = pEntries;
+        self->capacity = capacity;
+    }
+
+    playback_pool_entry_t *pEntry = &self->pEntries[self->count++];
+
+    memset(pEntry, 0, sizeof(playback_pool_entry_t));
+    pEntry->pDevice = pDevice;
+    pEntry->isDefault = pDeviceId == NULL;
+    if (pDeviceId) {
+        memcpy(&pEntry->id, pDeviceId, sizeof(device_id));
+    }
+    pEntry->config = *pConfig;
+    pEntry->isIdle = isIdle;
+
+    return true;
+}
+
+// Opens and starts a device for the pool.
+static void *_open(audio_context_t *context, device_id *pDeviceId, playback_config_t *pConfig) {
+    void *pDevice = playback_device_create(context, pDeviceId, pConfig, NULL);
+
+    if (!pDevice) {
+        return NULL;
+    }
+
+    playback_device_start(pDevice);
+
+    if (playback_device_get_state(pDevice) != device_state_started) {
+        LOG_ERROR("<%p>(playback_device_t *) failed to start for the pool.\n", pDevice);
+        playback_device_destroy(pDevice);
+        return NULL;
+    }
+
+    return pDevice;
+}
+
+FFI_PLUGIN_EXPORT
+uint32_t playback_pool_warm(void *pContext, device_id *pDeviceId, playback_config_t *pConfig, uint32_t count) {
+    if (!pContext) {
+        LOG_ERROR("invalid parameter: `pContext` is NULL.\n", "");
+        return 0;
+    }
+
+    if (!pConfig) {
+        LOG_ERROR("invalid parameter: `pConfig` is NULL.\n", "");
+        return 0;
+    }
+
+    audio_context_t *context = (audio_context_t *)pContext;
+    playback_pool_t *pool = &context->pool;
+    uint32_t idle = 0;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    for (uint32_t i = 0; i < pool->count; i++) {
+        idle += pool->pEntries[i].isIdle && _matches(&pool->pEntries[i], pDeviceId, pConfig);
+    }
+
+    pthread_mutex_unlock(&pool->mutex);
+
+    // Opening is slow: the pool stays available meanwhile.
+    while (idle < count) {
+        void *pDevice = _open(context, pDeviceId, pConfig);
+
+        if (!pDevice) {
+            break;
+        }
+
+        pthread_mutex_lock(&pool->mutex);
+        bool isAdded = _add_locked(pool, pDevice, pDeviceId, pConfig, true);
+        pthread_mutex_unlock(&pool->mutex);
+
+        if (!isAdded) {
+            playback_device_destroy(pDevice);
+            break;
+        }
+
+        idle++;
+    }
+
+    LOG_INFO("<%p>(playback_pool_t *) %u device(s) warm.\n", pool, idle);
+
+    return idle;
+}
+
+FFI_PLUGIN_EXPORT
+void *playback_pool_acquire(void *pContext, device_id *pDeviceId, playback_config_t *pConfig) {
+    if (!pContext) {
+        LOG_ERROR("invalid parameter: `pContext` is NULL.\n", "");
+        return NULL;
+    }
+
+    if (!pConfig) {
+        LOG_ERROR("invalid parameter: `pConfig` is NULL.\n", "");
+        return NULL;
+    }
+
+    audio_context_t *context = (audio_context_t *)pContext;
+    playback_pool_t *pool = &context->pool;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    for (uint32_t i = 0; i < pool->count; i++) {
+        playback_pool_entry_t *pEntry = &pool->pEntries[i];
+
+        if (pEntry->isIdle && _matches(pEntry, pDeviceId, pConfig)) {
+            pEntry->isIdle = false;
+            pool->hits++;
+            pthread_mutex_unlock(&pool->mutex);
+
+            return pEntry->pDevice;
+        }
+    }
+
+    pool->misses++;
+    pthread_mutex_unlock(&pool->mutex);
+
+    void *pDevice = _open(context, pDeviceId, pConfig);
+
+    if (!pDevice) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    bool isAdded = _add_locked(pool, pDevice, pDeviceId, pConfig, false);
+    pthread_mutex_unlock(&pool->mutex);
+
+    if (!isAdded) {
+        playback_device_destroy(pDevice);
+        return NULL;
+    }
+
+    return pDevice;
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_pool_release(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return false;
+    }
+
+    playback_device_t *playback = (playback_device_t *)self;
+    audio_context_t *context = (audio_context_t *)playback->base.owner;
+
+    if (!context) {
+        LOG_ERROR("<%p>(playback_device_t *) has no context.\n", playback);
+        return false;
+    }
+
+    playback_pool_t *pool = &context->pool;
+    bool isLent = false;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    for (uint32_t i = 0; i < pool->count; i++) {
+        if (pool->pEntries[i].pDevice == self) {
+            isLent = !pool->pEntries[i].isIdle;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&pool->mutex);
+
+    if (!isLent) {
+        LOG_ERROR("<%p>(playback_device_t *) was not acquired from the pool.\n", playback);
+        return false;
+    }
+
+    // Only the holder of a lent device changes its entry, so it can be
+    // recycled without the lock.
+    playback_device_recycle(playback);
+
+    if (playback_device_get_state(playback) != device_state_started) {
+        playback_device_start(playback);
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+
+    for (uint32_t i = 0; i < pool->count; i++) {
+        if (pool->pEntries[i].pDevice == self) {
+            playback_pool_entry_t *pEntry = &pool->pEntries[i];
+
+            // The holder may have resized the ring buffer or migrated the
+            // device, which leaves a zero ID for the default device.
+            pEntry->config.rbSizeInBytes = playback->config.rbSizeInBytes;
+            pEntry->id = playback->base.id;
+            pEntry->isDefault = memcmp(&pEntry->id, &(device_id){0}, sizeof(device_id)) == 0;
+            pEntry->isIdle = true;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&pool->mutex);
+
+    LOG_INFO("<%p>(playback_device_t *) back in the pool.\n", playback);
+
+    return true;
+}
+
+FFI_PLUGIN_EXPORT
+void playback_pool_drain(void *pContext) {
+    if (!pContext) {
+        LOG_ERROR("invalid parameter: `pContext` is NULL.\n", "");
+        return;
+    }
+
+    audio_context_t *context = (audio_context_t *)pContext;
+    playback_pool_t *pool = &context->pool;
+
+    for (;;) {
+        void *pDevice = NULL;
+
+        pthread_mutex_lock(&pool->mutex);
+
+        for (uint32_t i = 0; i < pool->count; i++) {
+            if (pool->pEntries[i].isIdle) {
+                pDevice = pool->pEntries[i].pDevice;
+                pool->pEntries[i] = pool->pEntries[--pool->count];
+                break;
+            }
+        }
+
+        pthread_mutex_unlock(&pool->mutex);
+
+        if (!pDevice) {
+            break;
+        }
+
+        playback_device_destroy(pDevice);
+    }
+}
+
+FFI_PLUGIN_EXPORT
+bool playback_pool_get_stats(void *pContext, playback_pool_stats_t *pStats) {
+    if (!pContext) {
+        LOG_ERROR("invalid parameter: `pContext` is NULL.\n", "");
+        return false;
+    }
+
+    if (!pStats) {
+        LOG_ERROR("invalid parameter: `pStats` is NULL.\n", "");
+        return false;
+    }
+
+    playback_pool_t *pool = &((audio_context_t *)pContext)->pool;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    memset(pStats, 0, sizeof(playback_pool_stats_t));
+
+    for (uint32_t i = 0; i < pool->count; i++) {
+        if (pool->pEntries[i].isIdle) {
+            pStats->idleDevices++;
+        } else {
+            pStats->lentDevices++;
+        }
+    }
+
+    pStats->hits = pool->hits;
+    pStats->misses = pool->misses;
+
+    pthread_mutex_unlock(&pool->mutex);
+
+    return true;
+}
+
+void playback_pool_forget(playback_pool_t *self, void *pDevice) {
+    pthread_mutex_lock(&self->mutex);
+
+    for (uint32_t i = 0; i < self->count; i++) {
+        if (self->pEntries[i].pDevice == pDevice) {
+            self->pEntries[i] = self->pEntries[--self->count];
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&self->mutex);
+}
@@ -0,0 +1,142 @@
+#include "../include/reference_tap.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/logger.h"
+
+// Blocks are 16-byte aligned so frames can be read with vector loads.
+#define REFERENCE_ALIGN(x) (((x) + 15) & ~(size_t)15)
+#define REFERENCE_HEADER_SIZE REFERENCE_ALIGN(sizeof(reference_header_t))
+
+// Callbacks shorter than this many frames would fill the ring with headers
+// before frames; the ring reserves headers for callbacks of this size.
+#define REFERENCE_MIN_CALLBACK_FRAMES 64
+
+reference_tap_t *reference_tap_create(ma_format format, uint32_t channels, uint32_t capacityFrames) {
+    reference_tap_t *tap = calloc(1, sizeof(reference_tap_t));
+
+    if (!tap) {
+        LOG_ERROR("Failed to allocate memory for `reference_tap_t`.\n", "");
+        return NULL;
+    }
+
+    tap->format = format;
+    tap->channels = channels;
+    tap->bytesPerFrame = ma_get_bytes_per_frame(format, channels);
+
+    size_t headers = capacityFrames / REFERENCE_MIN_CALLBACK_FRAMES + 2;
+    size_t size = REFERENCE_ALIGN((size_t)capacityFrames * tap->bytesPerFrame) +
+                  headers * (REFERENCE_HEADER_SIZE + 16);
+
+    if (ma_rb_init(size, NULL, NULL, &tap->ring) != MA_SUCCESS) {
+        LOG_ERROR("`ma_rb_init` failed for a reference tap of %zu bytes.\n", size);
+        free(tap);
+        return NULL;
+    }
+
+    atomic_init(&tap->droppedFrames, 0);
+
+    return tap;
+}
+
+void reference_tap_write(reference_tap_t *self,
+                         const void *pFrames,
+                         uint32_t frameCount,
+                         uint64_t timestampNs,
+                         uint32_t latencyFrames,
+                         uint32_t sampleRate) {
+    size_t framesSize = (size_t)frameCount * self->bytesPerFrame;
+    size_t blockSize = REFERENCE_HEADER_SIZE + REFERENCE_ALIGN(framesSize);
+    size_t contiguous = blockSize;
+    void *pWrite;
+
+    uint64_t framePosition = self->framePosition;
+    self->framePosition += frameCount;
+
+    ma_rb_acquire_write(&self->ring, &contiguous, &pWrite);
+
+    // Not enough room before the end of the ring: pad up to the end and
+    // start over at the beginning, if the reader left enough room there.
+    if (contiguous < blockSize) {
+        if (ma_rb_available_write(&self->ring) < contiguous + blockSize) {
+            self->pendingDrops += frameCount;
+            atomic_fetch_add_explicit(&self->droppedFrames, frameCount, memory_order_relaxed);
+            return;
+        }
+
+        if (contiguous >= REFERENCE_HEADER_SIZE) {
+            reference_header_t *pPadding = (reference_header_t *)pWrite;
+            memset(pPadding, 0, sizeof(reference_header_t));
+            pPadding->blockSize = (uint32_t)contiguous;
+            pPadding->isPadding = 1;
+        }
+
+        ma_rb_commit_write(&self->ring, contiguous);
+
+        contiguous = blockSize;
+        ma_rb_acquire_write(&self->ring, &contiguous, &pWrite);
+    }
+
+    reference_header_t *pHeader = (reference_header_t *)pWrite;
+
+    pHeader->info.framePosition = framePosition;
+    pHeader->info.timestampNs = timestampNs;
+    pHeader->info.presentationNs = timestampNs + (uint64_t)latencyFrames * 1000000000ull / sampleRate;
+    pHeader->info.latencyFrames = latencyFrames;
+    pHeader->info.frameCount = frameCount;
+    pHeader->info.droppedFrames = self->pendingDrops;
+    pHeader->blockSize = (uint32_t)blockSize;
+    pHeader->isPadding = 0;
+
+    memcpy((char *)pWrite + REFERENCE_HEADER_SIZE, pFrames, framesSize);
+    ma_rb_commit_write(&self->ring, blockSize);
+
+    self->pendingDrops = 0;
+}
+
+const void *reference_tap_acquire(reference_tap_t *self, playback_reference_block_t *pBlock) {
+    for (;;) {
+        size_t size = REFERENCE_HEADER_SIZE;
+        void *pRead;
+
+        ma_rb_acquire_read(&self->ring, &size, &pRead);
+
+        if (size == 0) {
+            return NULL;
+        }
+
+        // Fewer bytes than a header before the end of the ring: the writer
+        // skipped them, as it does for a padding block.
+        if (size < REFERENCE_HEADER_SIZE) {
+            ma_rb_commit_read(&self->ring, size);
+            continue;
+        }
+
+        const reference_header_t *pHeader = (const reference_header_t *)pRead;
+
+        if (pHeader->isPadding) {
+            ma_rb_commit_read(&self->ring, pHeader->blockSize);
+            continue;
+        }
+
+        *pBlock = pHeader->info;
+        self->acquiredSize = pHeader->blockSize;
+
+        return (const char *)pRead + REFERENCE_HEADER_SIZE;
+    }
+}
+
+void reference_tap_release(reference_tap_t *self) {
+    if (self->acquiredSize == 0) {
+        return;
+    }
+
+    ma_rb_commit_read(&self->ring, self->acquiredSize);
+    self->acquiredSize = 0;
+}
+
+void reference_tap_destroy(reference_tap_t *self) {
+    ma_rb_uninit(&self->ring);
+    free(self);
+}
@@ -0,0 +1,355 @@
+#include "../include/segmenter.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../include/ima_adpcm.h"
+#include "../include/logger.h"
+#include "../include/miniaudio.h"
+
+// Space left for the container header when converting `segmentBytes` to
+// frames. Covers the WAV header written by miniaudio and the IMA ADPCM one.
+#define SEGMENTER_HEADER_RESERVE 128
+
+// Poll interval of the background thread, in milliseconds. Rotations do not
+// signal it, as they may run on the audio thread, so this bounds how long a
+// finished segment waits and how late the next one is opened.
+#define SEGMENTER_WAIT_MS 10
+
+// Returns how many frames fit into a file of `bytes` bytes.
+static uint64_t _frames_for_bytes(const encoder_config_t *pConfig, uint64_t bytes) {
+    if (bytes <= SEGMENTER_HEADER_RESERVE) {
+        return 0;
+    }
+
+    bytes -= SEGMENTER_HEADER_RESERVE;
+
+    if (pConfig->storage == encoder_storage_ima_adpcm) {
+        uint32_t blockAlign = IMA_ADPCM_BLOCK_ALIGN_PER_CHANNEL * pConfig->channels;
+
+        return bytes / blockAlign * ima_adpcm_frames_per_block(blockAlign, pConfig->channels);
+    }
+
+    ma_format format = pConfig->storage == encoder_storage_pcm_s16 ? ma_format_s16
+                                                                   : (ma_format)pConfig->pcmFormat;
+
+    return bytes / ma_get_bytes_per_frame(format, pConfig->channels);
+}
+
+static segment_t *_open_segment(segmenter_t *segmenter, uint32_t index) {
+    size_t pathSize = strlen(segmenter->pathPrefix) + 16;
+    segment_t *segment = calloc(1, sizeof(segment_t) + pathSize);
+
+    if (!segment) {
+        LOG_ERROR("failed to allocate memory for `segment_t`.\n", "");
+        return NULL;
+    }
+
+    snprintf(segment->path, pathSize, "%s%05u.wav", segmenter->pathPrefix, index);
+    segment->index = index;
+
+    encoder_config_t config = segmenter->config;
+
+    if (segmenter->segmentConfig.useWriter) {
+        encoder_writer_config_t writerConfig = segmenter->segmentConfig.writerConfig;
+        segment->pEncoder = encoder_create_writer(segment->path, &config, &writerConfig);
+    } else {
+        segment->pEncoder = encoder_create(segment->path, &config);
+    }
+
+    if (!segment->pEncoder) {
+        LOG_ERROR("failed to open segment `%s`.\n", segment->path);
+        free(segment);
+        return NULL;
+    }
+
+    return segment;
+}
+
+static void _complete_segment(segmenter_t *segmenter, segment_t *segment, bool isLast) {
+    encoder_finalize(segment->pEncoder);
+
+    uint64_t sizeInBytes = encoder_get_size_in_bytes(segment->pEncoder);
+    encoder_destroy(segment->pEncoder);
+
+    atomic_fetch_add(&segmenter->completedBytes, sizeInBytes);
+
+    LOG_INFO("<%p>(segmenter_t) segment %u completed - frames: %llu, bytes: %llu.\n",
+             segmenter,
+             segment->index,
+             (unsigned long long)segment->frameCount,
+             (unsigned long long)sizeInBytes);
+
+    if (segmenter->onSegment) {
+        segmenter->onSegment(segmenter->pUserData,
+                             segment->index,
+                             segment->firstFrame,
+                             segment->frameCount,
+                             sizeInBytes,
+                             isLast);
+    }
+
+    free(segment);
+}
+
+// Finalizes the segments handed over by the writing thread, oldest first.
+static void _complete_finished(segmenter_t *segmenter) {
+    segment_t *segment = atomic_exchange(&segmenter->pFinished, NULL);
+    segment_t *pOldest = NULL;
+
+    while (segment) {
+        segment_t *next = segment->pNext;
+        segment->pNext = pOldest;
+        pOldest = segment;
+        segment = next;
+    }
+
+    while (pOldest) {
+        segment_t *next = pOldest->pNext;
+        _complete_segment(segmenter, pOldest, false);
+        pOldest = next;
+    }
+}
+
+static void _wait(segmenter_t *segmenter) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+
+    deadline.tv_nsec += SEGMENTER_WAIT_MS * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&segmenter->mutex);
+
+    if (!atomic_load(&segmenter->stop) && !atomic_load(&segmenter->pFinished)) {
+        pthread_cond_timedwait(&segmenter->cond, &segmenter->mutex, &deadline);
+    }
+
+    pthread_mutex_unlock(&segmenter->mutex);
+}
+
+static void *_segmenter_thread(void *pUserData) {
+    segmenter_t *segmenter = pUserData;
+    unsigned int reportedLateRotations = 0;
+
+    while (!atomic_load(&segmenter->stop)) {
+        if (!atomic_load(&segmenter->pReady)) {
+            segment_t *segment = _open_segment(segmenter, segmenter->nextIndex);
+
+            if (segment) {
+                segmenter->nextIndex++;
+                atomic_store(&segmenter->pReady, segment);
+            }
+        }
+
+        _complete_finished(segmenter);
+
+        unsigned int lateRotations = atomic_load(&segmenter->lateRotations);
+
+        if (lateRotations != reportedLateRotations) {
+            LOG_WARN("<%p>(segmenter_t) the next segment was late %u time(s), segments ran long.\n",
+                     segmenter,
+                     lateRotations - reportedLateRotations);
+            reportedLateRotations = lateRotations;
+        }
+
+        _wait(segmenter);
+    }
+
+    _complete_finished(segmenter);
+
+    return NULL;
+}
+
+segmenter_t *segmenter_create(const char *pathPrefix,
+                              const encoder_config_t *pConfig,
+                              const encoder_segment_config_t *pSegmentConfig,
+                              encoder_segment_callback_t onSegment,
+                              void *pUserData) {
+    uint64_t secondsFrames = (uint64_t)pSegmentConfig->segmentSeconds * pConfig->sampleRate;
+    uint64_t bytesFrames = pSegmentConfig->segmentBytes
+                               ? _frames_for_bytes(pConfig, pSegmentConfig->segmentBytes)
+                               : 0;
+
+    if (pSegmentConfig->segmentSeconds == 0 && pSegmentConfig->segmentBytes == 0) {
+        LOG_ERROR("a segment needs a time or a size limit.\n", "");
+        return NULL;
+    }
+
+    if (pSegmentConfig->segmentBytes && bytesFrames == 0) {
+        LOG_ERROR("`segmentBytes` of %llu cannot hold a frame.\n",
+                  (unsigned long long)pSegmentConfig->segmentBytes);
+        return NULL;
+    }
+
+    segmenter_t *segmenter = calloc(1, sizeof(segmenter_t));
+
+    if (!segmenter) {
+        LOG_ERROR("failed to allocate memory for `segmenter_t`.\n", "");
+        return NULL;
+    }
+
+    segmenter->config = *pConfig;
+    segmenter->segmentConfig = *pSegmentConfig;
+    segmenter->segmentFrames = secondsFrames == 0 || (bytesFrames && bytesFrames < secondsFrames)
+                                   ? bytesFrames
+                                   : secondsFrames;
+    segmenter->bpf = ma_get_bytes_per_frame((ma_format)pConfig->pcmFormat, pConfig->channels);
+    segmenter->onSegment = onSegment;
+    segmenter->pUserData = pUserData;
+    segmenter->pathPrefix = malloc(strlen(pathPrefix) + 1);
+
+    if (!segmenter->pathPrefix) {
+        LOG_ERROR("failed to allocate memory for the path prefix.\n", "");
+        free(segmenter);
+        return NULL;
+    }
+
+    strcpy(segmenter->pathPrefix, pathPrefix);
+
+    segmenter->pCurrent = _open_segment(segmenter, 0);
+
+    if (!segmenter->pCurrent) {
+        free(segmenter->pathPrefix);
+        free(segmenter);
+        return NULL;
+    }
+
+    segmenter->nextIndex = 1;
+    atomic_store(&segmenter->currentBytes, encoder_get_size_in_bytes(segmenter->pCurrent->pEncoder));
+
+    pthread_mutex_init(&segmenter->mutex, NULL);
+    pthread_cond_init(&segmenter->cond, NULL);
+
+    if (pthread_create(&segmenter->thread, NULL, _segmenter_thread, segmenter) != 0) {
+        LOG_ERROR("failed to start the segmenter thread.\n", "");
+        encoder_destroy(segmenter->pCurrent->pEncoder);
+        free(segmenter->pCurrent);
+        pthread_cond_destroy(&segmenter->cond);
+        pthread_mutex_destroy(&segmenter->mutex);
+        free(segmenter->pathPrefix);
+        free(segmenter);
+        return NULL;
+    }
+
+    LOG_INFO("<%p>(segmenter_t) created - prefix: %s, frames per segment: %llu.\n",
+             segmenter,
+             pathPrefix,
+             (unsigned long long)segmenter->segmentFrames);
+
+    return segmenter;
+}
+
+// Switches to the segment opened ahead. Runs on the writing thread, so it only
+// swaps pointers and never blocks.
+static bool _rotate(segmenter_t *segmenter) {
+    segment_t *next = atomic_exchange(&segmenter->pReady, NULL);
+
+    if (!next) {
+        return false;
+    }
+
+    segment_t *current = segmenter->pCurrent;
+    next->firstFrame = current->firstFrame + current->frameCount;
+
+    current->pNext = atomic_load(&segmenter->pFinished);
+    while (!atomic_compare_exchange_weak(&segmenter->pFinished, &current->pNext, current)) {
+    }
+
+    segmenter->pCurrent = next;
+
+    return true;
+}
+
+uint64_t segmenter_write_pcm_frames(segmenter_t *self, const void *pFrames, uint64_t frameCount) {
+    const uint8_t *pData = pFrames;
+    uint64_t framesWritten = 0;
+    bool isLate = false;
+
+    while (framesWritten < frameCount) {
+        segment_t *segment = self->pCurrent;
+
+        if (segment->frameCount >= self->segmentFrames && !isLate) {
+            if (_rotate(self)) {
+                continue;
+            }
+
+            // Keep writing into the current segment rather than drop frames.
+            isLate = true;
+            atomic_fetch_add(&self->lateRotations, 1);
+        }
+
+        uint64_t length = frameCount - framesWritten;
+
+        if (segment->frameCount < self->segmentFrames &&
+            length > self->segmentFrames - segment->frameCount) {
+            length = self->segmentFrames - segment->frameCount;
+        }
+
+        uint64_t written = encoder_write_pcm_frames(segment->pEncoder,
+                                                    pData + framesWritten * self->bpf,
+                                                    length);
+        segment->frameCount += written;
+        framesWritten += written;
+
+        if (written < length) {
+            break;
+        }
+    }
+
+    atomic_store(&self->currentBytes, encoder_get_size_in_bytes(self->pCurrent->pEncoder));
+
+    return framesWritten;
+}
+
+uint64_t segmenter_write_gap(segmenter_t *self, uint64_t frameCount) {
+    // Gaps add no bytes, so they never trigger a rotation.
+    return encoder_write_gap(self->pCurrent->pEncoder, frameCount);
+}
+
+void segmenter_finalize(segmenter_t *self) {
+    if (self->isFinalized) {
+        return;
+    }
+
+    pthread_mutex_lock(&self->mutex);
+    atomic_store(&self->stop, true);
+    pthread_cond_signal(&self->cond);
+    pthread_mutex_unlock(&self->mutex);
+
+    pthread_join(self->thread, NULL);
+
+    segment_t *ready = atomic_exchange(&self->pReady, NULL);
+
+    if (ready) {
+        encoder_destroy(ready->pEncoder);
+        remove(ready->path);
+        free(ready);
+    }
+
+    segment_t *current = self->pCurrent;
+    self->pCurrent = NULL;
+    atomic_store(&self->currentBytes, 0);
+
+    _complete_segment(self, current, true);
+
+    self->isFinalized = true;
+}
+
+uint64_t segmenter_get_size_in_bytes(segmenter_t *self) {
+    return atomic_load(&self->completedBytes) + atomic_load(&self->currentBytes);
+}
+
+void segmenter_destroy(segmenter_t *self) {
+    segmenter_finalize(self);
+
+    pthread_cond_destroy(&self->cond);
+    pthread_mutex_destroy(&self->mutex);
+
+    free(self->pathPrefix);
+    free(self);
+}
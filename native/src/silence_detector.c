@@ -0,0 +1,151 @@
+#include "../include/silence_detector.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "../include/logger.h"
+#include "../include/simd.h"
+
+// Threshold used when the configuration leaves it at 0.
+#define SILENCE_DEFAULT_THRESHOLD_DB -60.0f
+
+silence_detector_t *silence_detector_create(ma_format format,
+                                            uint32_t channels,
+                                            uint32_t sampleRate,
+                                            const playback_silence_config_t *pConfig) {
+    silence_detector_t *detector = calloc(1, sizeof(silence_detector_t));
+
+    if (!detector) {
+        LOG_ERROR("Failed to allocate memory for `silence_detector_t`.\n", "");
+        return NULL;
+    }
+
+    float thresholdDb = pConfig->thresholdDb != 0.0f ? pConfig->thresholdDb : SILENCE_DEFAULT_THRESHOLD_DB;
+
+    detector->format = format;
+    detector->channels = channels;
+    detector->sampleRate = sampleRate;
+    detector->config = *pConfig;
+    detector->threshold = powf(10.0f, thresholdDb / 20.0f);
+    detector->floorMargin = pConfig->noiseFloorMarginDb > 0.0f
+                                ? powf(10.0f, pConfig->noiseFloorMarginDb / 20.0f)
+                                : 0.0f;
+    detector->holdFrames = (uint32_t)((uint64_t)sampleRate * pConfig->holdMs / 1000);
+    detector->riseLnPerFrame = SILENCE_FLOOR_RISE_DB_PER_SECOND / 20.0f * logf(10.0f) / (float)sampleRate;
+    detector->noiseFloor = -1.0f;
+
+    atomic_init(&detector->isSilent, false);
+    atomic_init(&detector->level, 0.0f);
+    atomic_init(&detector->published, 0.0f);
+    atomic_init(&detector->totalFrames, 0);
+    atomic_init(&detector->silentFrames, 0);
+
+    return detector;
+}
+
+// Peak and sum of squares of all samples. Channels are not told apart, so
+// whole vectors are folded whatever the channel count.
+static void _measure(const float *pSamples, uint32_t sampleCount, float *pPeak, double *pSumSquares) {
+    simd_f32x4 peak = simd_f32x4_set1(0.0f);
+    simd_f32x4 sumSquares = simd_f32x4_set1(0.0f);
+    uint32_t i = 0;
+
+    for (; i + 4 <= sampleCount; i += 4) {
+        simd_f32x4 x = simd_f32x4_load(pSamples + i);
+
+        peak = simd_f32x4_max(peak, simd_f32x4_abs(x));
+        sumSquares = simd_f32x4_add(sumSquares, simd_f32x4_mul(x, x));
+    }
+
+    float lanes[4];
+    float squares[4];
+
+    simd_f32x4_store(lanes, peak);
+    simd_f32x4_store(squares, sumSquares);
+
+    for (int lane = 0; lane < 4; lane++) {
+        *pPeak = lanes[lane] > *pPeak ? lanes[lane] : *pPeak;
+        *pSumSquares += squares[lane];
+    }
+
+    for (; i < sampleCount; i++) {
+        float magnitude = fabsf(pSamples[i]);
+
+        *pPeak = magnitude > *pPeak ? magnitude : *pPeak;
+        *pSumSquares += pSamples[i] * pSamples[i];
+    }
+}
+
+bool silence_detector_process(silence_detector_t *self, const void *pFrames, uint32_t frameCount) {
+    if (frameCount == 0) {
+        return atomic_load_explicit(&self->isSilent, memory_order_relaxed);
+    }
+
+    uint32_t sampleCount = frameCount * self->channels;
+    float peak = 0.0f;
+    double sumSquares = 0.0;
+
+    if (self->format == ma_format_f32) {
+        _measure((const float *)pFrames, sampleCount, &peak, &sumSquares);
+    } else {
+        float scratch[SILENCE_SLICE_SAMPLES];
+        uint32_t bytesPerSample = ma_get_bytes_per_sample(self->format);
+        const char *pBytes = (const char *)pFrames;
+
+        for (uint32_t done = 0; done < sampleCount; done += SILENCE_SLICE_SAMPLES) {
+            uint32_t samples = sampleCount - done < SILENCE_SLICE_SAMPLES ? sampleCount - done : SILENCE_SLICE_SAMPLES;
+
+            ma_pcm_convert(scratch,
+                           ma_format_f32,
+                           pBytes + (size_t)done * bytesPerSample,
+                           self->format,
+                           samples,
+                           ma_dither_mode_none);
+            _measure(scratch, samples, &peak, &sumSquares);
+        }
+    }
+
+    float rms = sqrtf((float)(sumSquares / sampleCount));
+
+    // Down at once, up by at most the rise rate.
+    if (self->noiseFloor < 0.0f || rms <= self->noiseFloor) {
+        self->noiseFloor = rms;
+    } else {
+        float risen = self->noiseFloor * expf(self->riseLnPerFrame * (float)frameCount);
+        self->noiseFloor = rms < risen ? rms : risen;
+    }
+
+    bool isQuiet = peak < self->threshold ||
+                   (self->floorMargin > 0.0f && peak < self->noiseFloor * self->floorMargin);
+
+    self->quietFrames = isQuiet ? self->quietFrames + frameCount : 0;
+
+    bool isSilent = isQuiet && self->quietFrames >= self->holdFrames;
+
+    atomic_store_explicit(&self->isSilent, isSilent, memory_order_relaxed);
+    atomic_store_explicit(&self->level, peak, memory_order_relaxed);
+    atomic_store_explicit(&self->published, self->noiseFloor, memory_order_relaxed);
+    atomic_fetch_add_explicit(&self->totalFrames, frameCount, memory_order_relaxed);
+
+    if (isSilent) {
+        atomic_fetch_add_explicit(&self->silentFrames, frameCount, memory_order_relaxed);
+    }
+
+    return isSilent;
+}
+
+static float _to_db(float level) {
+    return level > 0.0f ? 20.0f * log10f(level) : -INFINITY;
+}
+
+void silence_detector_read(silence_detector_t *self, playback_silence_stats_t *pStats) {
+    pStats->isSilent = atomic_load_explicit(&self->isSilent, memory_order_relaxed);
+    pStats->levelDb = _to_db(atomic_load_explicit(&self->level, memory_order_relaxed));
+    pStats->noiseFloorDb = _to_db(atomic_load_explicit(&self->published, memory_order_relaxed));
+    pStats->totalFrames = atomic_load_explicit(&self->totalFrames, memory_order_relaxed);
+    pStats->silentFrames = atomic_load_explicit(&self->silentFrames, memory_order_relaxed);
+}
+
+void silence_detector_destroy(silence_detector_t *self) {
+    free(self);
+}
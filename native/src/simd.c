@@ -0,0 +1,51 @@
+#include "../include/simd.h"
+
+#include <stdatomic.h>
+
+static simd_level_t _detect_level(void) {
+#if defined(SIMD_HAVE_AVX2_TARGET)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return simd_level_avx2;
+    }
+#endif
+
+#if defined(SIMD_SSE2)
+    return simd_level_sse2;
+#elif defined(SIMD_NEON)
+    return simd_level_neon;
+#else
+    return simd_level_scalar;
+#endif
+}
+
+simd_level_t simd_get_level(void) {
+    // -1 until the first call has probed the CPU.
+    static atomic_int level = -1;
+
+    int detected = atomic_load_explicit(&level, memory_order_acquire);
+
+    // Detection is idempotent, so concurrent first calls store the same level.
+    if (detected < 0) {
+        detected = (int)_detect_level();
+        atomic_store_explicit(&level, detected, memory_order_release);
+    }
+
+    return (simd_level_t)detected;
+}
+
+const char *describe_simd_level(simd_level_t level) {
+    switch (level) {
+        case simd_level_scalar:
+            return "scalar";
+        case simd_level_sse2:
+            return "sse2";
+        case simd_level_avx2:
+            return "avx2";
+        case simd_level_neon:
+            return "neon";
+        default:
+            return "unknown";
+    }
+}
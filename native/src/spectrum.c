@@ -0,0 +1,493 @@
+#include "../include/spectrum.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../include/internal.h"
+#include "../include/logger.h"
+#include "../include/simd.h"
+
+#ifndef M_PI
+    #define M_PI 3.14159265358979323846
+#endif
+
+#define SPECTRUM_DEFAULT_FFT_SIZE 2048
+#define SPECTRUM_MIN_FFT_SIZE 64
+#define SPECTRUM_MAX_FFT_SIZE 16384
+
+static bool _apply_defaults(spectrum_config_t *pConfig) {
+    if (pConfig->fftSize == 0) {
+        pConfig->fftSize = SPECTRUM_DEFAULT_FFT_SIZE;
+    }
+
+    if (pConfig->fftSize < SPECTRUM_MIN_FFT_SIZE || pConfig->fftSize > SPECTRUM_MAX_FFT_SIZE ||
+        (pConfig->fftSize & (pConfig->fftSize - 1)) != 0) {
+        LOG_ERROR("`fftSize` must be a power of two from %d to %d, not %u.\n",
+                  SPECTRUM_MIN_FFT_SIZE,
+                  SPECTRUM_MAX_FFT_SIZE,
+                  pConfig->fftSize);
+        return false;
+    }
+
+    if (pConfig->hopSize == 0) {
+        pConfig->hopSize = pConfig->fftSize / 2;
+    }
+
+    if (pConfig->hopSize > pConfig->fftSize) {
+        LOG_ERROR("`hopSize` of %u exceeds `fftSize` of %u.\n", pConfig->hopSize, pConfig->fftSize);
+        return false;
+    }
+
+    if (!(pConfig->smoothing >= 0.0f && pConfig->smoothing < 1.0f)) {
+        LOG_ERROR("`smoothing` must be in [0, 1), not %f.\n", pConfig->smoothing);
+        return false;
+    }
+
+    return true;
+}
+
+static float _window(spectrum_window_t window, uint32_t n, uint32_t size) {
+    double x = 2.0 * M_PI * n / size;
+
+    switch (window) {
+        case spectrum_window_hann:
+            return (float)(0.5 - 0.5 * cos(x));
+        case spectrum_window_hamming:
+            return (float)(0.54 - 0.46 * cos(x));
+        case spectrum_window_blackman_harris:
+            return (float)(0.35875 - 0.48829 * cos(x) + 0.14128 * cos(2.0 * x) - 0.01168 * cos(3.0 * x));
+        case spectrum_window_rectangular:
+        default:
+            return 1.0f;
+    }
+}
+
+// Fills the window, twiddle and permutation tables.
+static void _init_tables(spectrum_t *spectrum) {
+    uint32_t size = spectrum->config.fftSize;
+    uint32_t half = size / 2;
+    double windowSum = 0.0;
+
+    for (uint32_t n = 0; n < size; n++) {
+        spectrum->pWindow[n] = _window(spectrum->config.window, n, size);
+        windowSum += spectrum->pWindow[n];
+    }
+
+    spectrum->windowScale = (float)(2.0 / windowSum);
+
+    for (uint32_t h = 1; h < half; h *= 2) {
+        for (uint32_t j = 0; j < h; j++) {
+            spectrum->pTwiddleRe[h - 1 + j] = (float)cos(M_PI * j / h);
+            spectrum->pTwiddleIm[h - 1 + j] = (float)-sin(M_PI * j / h);
+        }
+    }
+
+    for (uint32_t k = 0; k < half; k++) {
+        spectrum->pSplitRe[k] = (float)cos(2.0 * M_PI * k / size);
+        spectrum->pSplitIm[k] = (float)-sin(2.0 * M_PI * k / size);
+    }
+
+    uint32_t bits = 0;
+    while ((1u << bits) < half) {
+        bits++;
+    }
+
+    for (uint32_t n = 0; n < half; n++) {
+        uint32_t reversed = 0;
+
+        for (uint32_t b = 0; b < bits; b++) {
+            reversed |= ((n >> b) & 1u) << (bits - 1 - b);
+        }
+
+        spectrum->pBitReverse[n] = reversed;
+    }
+}
+
+// In-place radix-2 complex FFT of `size` points whose input is already in
+// bit-reversed order. Stages of four or more butterflies per group are
+// computed four at a time.
+static void _fft(float *pRe, float *pIm, const float *pTwiddleRe, const float *pTwiddleIm, uint32_t size) {
+    for (uint32_t h = 1; h < size; h *= 2) {
+        const float *pWr = pTwiddleRe + h - 1;
+        const float *pWi = pTwiddleIm + h - 1;
+
+        for (uint32_t g = 0; g < size; g += 2 * h) {
+            float *pRe0 = pRe + g;
+            float *pIm0 = pIm + g;
+            float *pRe1 = pRe + g + h;
+            float *pIm1 = pIm + g + h;
+            uint32_t j = 0;
+
+            for (; h >= 4 && j < h; j += 4) {
+                simd_f32x4 wr = simd_f32x4_load(pWr + j);
+                simd_f32x4 wi = simd_f32x4_load(pWi + j);
+                simd_f32x4 xr = simd_f32x4_load(pRe1 + j);
+                simd_f32x4 xi = simd_f32x4_load(pIm1 + j);
+                simd_f32x4 tr = simd_f32x4_sub(simd_f32x4_mul(wr, xr), simd_f32x4_mul(wi, xi));
+                simd_f32x4 ti = simd_f32x4_add(simd_f32x4_mul(wr, xi), simd_f32x4_mul(wi, xr));
+                simd_f32x4 ar = simd_f32x4_load(pRe0 + j);
+                simd_f32x4 ai = simd_f32x4_load(pIm0 + j);
+
+                simd_f32x4_store(pRe1 + j, simd_f32x4_sub(ar, tr));
+                simd_f32x4_store(pIm1 + j, simd_f32x4_sub(ai, ti));
+                simd_f32x4_store(pRe0 + j, simd_f32x4_add(ar, tr));
+                simd_f32x4_store(pIm0 + j, simd_f32x4_add(ai, ti));
+            }
+
+            for (; j < h; j++) {
+                float tr = pWr[j] * pRe1[j] - pWi[j] * pIm1[j];
+                float ti = pWr[j] * pIm1[j] + pWi[j] * pRe1[j];
+
+                pRe1[j] = pRe0[j] - tr;
+                pIm1[j] = pIm0[j] - ti;
+                pRe0[j] += tr;
+                pIm0[j] += ti;
+            }
+        }
+    }
+}
+
+// Windows the block, transforms it and updates the smoothed magnitudes.
+static void _analyze(spectrum_t *spectrum) {
+    uint32_t size = spectrum->config.fftSize;
+    uint32_t half = size / 2;
+    const float *pBlock = spectrum->pBlock;
+    const float *pWindow = spectrum->pWindow;
+    float *pRe = spectrum->pRe;
+    float *pIm = spectrum->pIm;
+
+    // Even samples as real parts, odd samples as imaginary parts.
+    for (uint32_t n = 0; n < half; n++) {
+        uint32_t r = spectrum->pBitReverse[n];
+
+        pRe[r] = pBlock[2 * n] * pWindow[2 * n];
+        pIm[r] = pBlock[2 * n + 1] * pWindow[2 * n + 1];
+    }
+
+    _fft(pRe, pIm, spectrum->pTwiddleRe, spectrum->pTwiddleIm, half);
+
+    float smoothing = spectrum->config.smoothing;
+    float scale = spectrum->windowScale;
+    float *pSmoothed = spectrum->pSmoothed;
+
+    // DC and Nyquist are real and carry no mirrored half.
+    float dc = fabsf(pRe[0] + pIm[0]) * scale * 0.5f;
+    float nyquist = fabsf(pRe[0] - pIm[0]) * scale * 0.5f;
+
+    pSmoothed[0] = smoothing * pSmoothed[0] + (1.0f - smoothing) * dc;
+    pSmoothed[half] = smoothing * pSmoothed[half] + (1.0f - smoothing) * nyquist;
+
+    // Separates the spectra of the even and odd samples and combines them.
+    for (uint32_t k = 1; k < half; k++) {
+        float ar = pRe[k];
+        float ai = pIm[k];
+        float br = pRe[half - k];
+        float bi = pIm[half - k];
+
+        float evenRe = 0.5f * (ar + br);
+        float evenIm = 0.5f * (ai - bi);
+        float oddRe = 0.5f * (ai + bi);
+        float oddIm = -0.5f * (ar - br);
+
+        float wr = spectrum->pSplitRe[k];
+        float wi = spectrum->pSplitIm[k];
+        float xr = evenRe + wr * oddRe - wi * oddIm;
+        float xi = evenIm + wr * oddIm + wi * oddRe;
+
+        float magnitude = sqrtf(xr * xr + xi * xi) * scale;
+
+        pSmoothed[k] = smoothing * pSmoothed[k] + (1.0f - smoothing) * magnitude;
+    }
+
+    uint64_t sequence = atomic_load_explicit(&spectrum->sequence, memory_order_relaxed);
+
+    memcpy(spectrum->pBins[(sequence + 1) & 1], pSmoothed, spectrum->binCount * sizeof(float));
+    atomic_store_explicit(&spectrum->sequence, sequence + 1, memory_order_release);
+}
+
+// Moves one hop of frames from the tap into the block.
+static void _read_hop(spectrum_t *spectrum) {
+    uint32_t channels = spectrum->channels;
+    uint32_t hop = spectrum->config.hopSize;
+    size_t bytesToRead = (size_t)hop * ma_get_bytes_per_frame(spectrum->format, channels);
+    uint8_t *pRaw = spectrum->pRaw ? spectrum->pRaw : (uint8_t *)spectrum->pConvert;
+
+    size_t bytesRead = 0;
+
+    while (bytesRead < bytesToRead) {
+        size_t chunkSize = bytesToRead - bytesRead;
+        void *pChunk;
+
+        if (ma_rb_acquire_read(&spectrum->tap, &chunkSize, &pChunk) != MA_SUCCESS || chunkSize == 0) {
+            break;
+        }
+
+        memcpy(pRaw + bytesRead, pChunk, chunkSize);
+        ma_rb_commit_read(&spectrum->tap, chunkSize);
+        bytesRead += chunkSize;
+    }
+
+    if (spectrum->format != ma_format_f32) {
+        ma_pcm_convert(spectrum->pConvert,
+                       ma_format_f32,
+                       pRaw,
+                       spectrum->format,
+                       (ma_uint64)hop * channels,
+                       ma_dither_mode_none);
+    }
+
+    uint32_t size = spectrum->config.fftSize;
+    float *pBlock = spectrum->pBlock;
+
+    memmove(pBlock, pBlock + hop, (size - hop) * sizeof(float));
+
+    float *pTail = pBlock + size - hop;
+    const float *pSamples = spectrum->pConvert;
+    float gain = 1.0f / channels;
+
+    for (uint32_t f = 0; f < hop; f++) {
+        float sum = 0.0f;
+
+        for (uint32_t c = 0; c < channels; c++) {
+            sum += pSamples[f * channels + c];
+        }
+
+        pTail[f] = sum * gain;
+    }
+
+    spectrum->blockFill = spectrum->blockFill + hop < size ? spectrum->blockFill + hop : size;
+}
+
+static void _wait(spectrum_t *spectrum) {
+    // Half a hop, so a hop is analyzed soon after it is complete.
+    long waitNs = (long)(500000000.0 * spectrum->config.hopSize / spectrum->sampleRate);
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+
+    deadline.tv_nsec += waitNs < 1000000L ? 1000000L : waitNs;
+    while (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&spectrum->mutex);
+
+    if (!atomic_load(&spectrum->stop)) {
+        pthread_cond_timedwait(&spectrum->cond, &spectrum->mutex, &deadline);
+    }
+
+    pthread_mutex_unlock(&spectrum->mutex);
+}
+
+static void *_spectrum_thread(void *pUserData) {
+    spectrum_t *spectrum = pUserData;
+    size_t hopBytes = (size_t)spectrum->config.hopSize *
+                      ma_get_bytes_per_frame(spectrum->format, spectrum->channels);
+
+    while (!atomic_load(&spectrum->stop)) {
+        while (ma_rb_available_read(&spectrum->tap) >= hopBytes && !atomic_load(&spectrum->stop)) {
+            _read_hop(spectrum);
+
+            if (spectrum->blockFill == spectrum->config.fftSize) {
+                _analyze(spectrum);
+            }
+        }
+
+        unsigned int dropped = atomic_exchange(&spectrum->droppedFrames, 0);
+
+        if (dropped) {
+            LOG_WARN("<%p>(spectrum_t) %u frame(s) dropped, the analyzer fell behind.\n", spectrum, dropped);
+        }
+
+        _wait(spectrum);
+    }
+
+    return NULL;
+}
+
+static void _free(spectrum_t *spectrum) {
+    free(spectrum->pRaw);
+    free(spectrum->pConvert);
+    free(spectrum->pBlock);
+    free(spectrum->pWindow);
+    free(spectrum->pRe);
+    free(spectrum->pIm);
+    free(spectrum->pTwiddleRe);
+    free(spectrum->pTwiddleIm);
+    free(spectrum->pSplitRe);
+    free(spectrum->pSplitIm);
+    free(spectrum->pBitReverse);
+    free(spectrum->pSmoothed);
+    free(spectrum->pBins[0]);
+    free(spectrum->pBins[1]);
+    free(spectrum);
+}
+
+spectrum_t *spectrum_create(ma_format format,
+                            uint32_t channels,
+                            uint32_t sampleRate,
+                            const spectrum_config_t *pConfig) {
+    spectrum_config_t config = *pConfig;
+
+    if (!_apply_defaults(&config)) {
+        return NULL;
+    }
+
+    spectrum_t *spectrum = calloc(1, sizeof(spectrum_t));
+
+    if (!spectrum) {
+        LOG_ERROR("failed to allocate memory for `spectrum_t`.\n", "");
+        return NULL;
+    }
+
+    spectrum->format = format;
+    spectrum->channels = channels;
+    spectrum->sampleRate = sampleRate;
+    spectrum->config = config;
+    spectrum->binCount = config.fftSize / 2 + 1;
+
+    uint32_t size = config.fftSize;
+    uint32_t half = size / 2;
+
+    spectrum->pConvert = malloc((size_t)config.hopSize * channels * sizeof(float));
+    if (format != ma_format_f32) {
+        spectrum->pRaw = malloc((size_t)config.hopSize * ma_get_bytes_per_frame(format, channels));
+    }
+
+    spectrum->pBlock = calloc(size, sizeof(float));
+    spectrum->pWindow = malloc(size * sizeof(float));
+    spectrum->pRe = malloc(half * sizeof(float));
+    spectrum->pIm = malloc(half * sizeof(float));
+    spectrum->pTwiddleRe = malloc(half * sizeof(float));
+    spectrum->pTwiddleIm = malloc(half * sizeof(float));
+    spectrum->pSplitRe = malloc(half * sizeof(float));
+    spectrum->pSplitIm = malloc(half * sizeof(float));
+    spectrum->pBitReverse = malloc(half * sizeof(uint32_t));
+    spectrum->pSmoothed = calloc(spectrum->binCount, sizeof(float));
+    spectrum->pBins[0] = calloc(spectrum->binCount, sizeof(float));
+    spectrum->pBins[1] = calloc(spectrum->binCount, sizeof(float));
+
+    if ((format != ma_format_f32 && !spectrum->pRaw) || !spectrum->pConvert || !spectrum->pBlock ||
+        !spectrum->pWindow || !spectrum->pRe || !spectrum->pIm || !spectrum->pTwiddleRe || !spectrum->pTwiddleIm || !spectrum->pSplitRe ||
+        !spectrum->pSplitIm || !spectrum->pBitReverse || !spectrum->pSmoothed ||
+        !spectrum->pBins[0] || !spectrum->pBins[1]) {
+        LOG_ERROR("failed to allocate memory for the spectrum buffers.\n", "");
+        _free(spectrum);
+        return NULL;
+    }
+
+    _init_tables(spectrum);
+
+    // Room for a quarter second or four blocks, whichever is more, so the
+    // worker can be descheduled for a while without losing frames.
+    uint32_t bpf = ma_get_bytes_per_frame(format, channels);
+    uint32_t tapFrames = sampleRate / 4 > 4 * size ? sampleRate / 4 : 4 * size;
+    ma_result rbResult = ma_rb_init((size_t)tapFrames * bpf, NULL, NULL, &spectrum->tap);
+
+    if (rbResult != MA_SUCCESS) {
+        LOG_ERROR("`ma_rb_init` failed - %s.\n", ma_result_description(rbResult));
+        _free(spectrum);
+        return NULL;
+    }
+
+    atomic_init(&spectrum->droppedFrames, 0);
+    atomic_init(&spectrum->sequence, 0);
+    atomic_init(&spectrum->stop, false);
+    pthread_mutex_init(&spectrum->mutex, NULL);
+    pthread_cond_init(&spectrum->cond, NULL);
+
+    if (pthread_create(&spectrum->thread, NULL, _spectrum_thread, spectrum) != 0) {
+        LOG_ERROR("failed to start the spectrum thread.\n", "");
+        pthread_cond_destroy(&spectrum->cond);
+        pthread_mutex_destroy(&spectrum->mutex);
+        ma_rb_uninit(&spectrum->tap);
+        _free(spectrum);
+        return NULL;
+    }
+
+    LOG_INFO("<%p>(spectrum_t) created - fftSize: %u, hopSize: %u, window: %d, format: %s, channels: %u.\n",
+             spectrum,
+             config.fftSize,
+             config.hopSize,
+             config.window,
+             describe_ma_format(format),
+             channels);
+
+    return spectrum;
+}
+
+void spectrum_write(spectrum_t *self, const void *pFrames, uint32_t frameCount) {
+    uint32_t bpf = ma_get_bytes_per_frame(self->format, self->channels);
+    size_t available = ma_rb_available_write(&self->tap);
+    size_t bytesToWrite = (size_t)frameCount * bpf;
+
+    if (bytesToWrite > available) {
+        atomic_fetch_add_explicit(&self->droppedFrames,
+                                  (unsigned int)((bytesToWrite - available) / bpf),
+                                  memory_order_relaxed);
+        bytesToWrite = available / bpf * bpf;
+    }
+
+    const uint8_t *pData = pFrames;
+    size_t bytesWritten = 0;
+
+    while (bytesWritten < bytesToWrite) {
+        size_t chunkSize = bytesToWrite - bytesWritten;
+        void *pChunk;
+
+        if (ma_rb_acquire_write(&self->tap, &chunkSize, &pChunk) != MA_SUCCESS || chunkSize == 0) {
+            break;
+        }
+
+        memcpy(pChunk, pData + bytesWritten, chunkSize);
+        ma_rb_commit_write(&self->tap, chunkSize);
+        bytesWritten += chunkSize;
+    }
+}
+
+uint32_t spectrum_read(spectrum_t *self, float *pBins, uint32_t binCount, uint64_t *pSequence) {
+    uint32_t count = binCount < self->binCount ? binCount : self->binCount;
+
+    for (;;) {
+        uint64_t sequence = atomic_load_explicit(&self->sequence, memory_order_acquire);
+
+        if (sequence == 0) {
+            if (pSequence) {
+                *pSequence = 0;
+            }
+
+            return 0;
+        }
+
+        memcpy(pBins, self->pBins[sequence & 1], count * sizeof(float));
+
+        atomic_thread_fence(memory_order_acquire);
+
+        if (atomic_load_explicit(&self->sequence, memory_order_relaxed) == sequence) {
+            if (pSequence) {
+                *pSequence = sequence;
+            }
+
+            return count;
+        }
+    }
+}
+
+void spectrum_destroy(spectrum_t *self) {
+    pthread_mutex_lock(&self->mutex);
+    atomic_store(&self->stop, true);
+    pthread_cond_signal(&self->cond);
+    pthread_mutex_unlock(&self->mutex);
+
+    pthread_join(self->thread, NULL);
+
+    pthread_cond_destroy(&self->cond);
+    pthread_mutex_destroy(&self->mutex);
+    ma_rb_uninit(&self->tap);
+
+    LOG_INFO("<%p>(spectrum_t) destroyed.\n", self);
+
+    _free(self);
+}
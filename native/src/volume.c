@@ -0,0 +1,125 @@
+#include "../include/volume.h"
+
+#include "../include/simd.h"
+
+void volume_init(volume_t *self, ma_format format, uint32_t channels, uint32_t sampleRate) {
+    self->format = format;
+    self->channels = channels;
+    self->rampFrames = sampleRate * VOLUME_RAMP_MS / 1000;
+
+    if (self->rampFrames == 0) {
+        self->rampFrames = 1;
+    }
+
+    atomic_init(&self->volume, 1.0f);
+    atomic_init(&self->isMuted, false);
+
+    self->gain = 1.0f;
+    self->target = 1.0f;
+    self->step = 0.0f;
+    self->rampLeft = 0;
+    self->isPrimed = false;
+}
+
+static void _scale(float *pSamples, uint32_t sampleCount, float gain) {
+    simd_f32x4 g = simd_f32x4_set1(gain);
+    uint32_t i = 0;
+
+    for (; i + 4 <= sampleCount; i += 4) {
+        simd_f32x4_store(pSamples + i, simd_f32x4_mul(simd_f32x4_load(pSamples + i), g));
+    }
+
+    for (; i < sampleCount; i++) {
+        pSamples[i] *= gain;
+    }
+}
+
+// Multiplies frame `f` by `gain + f * step`. When a vector holds whole
+// frames (1, 2 or 4 channels), each lane starts at the gain of its frame and
+// all lanes advance by the frames a vector spans.
+static void _ramp(float *pSamples, uint32_t frameCount, uint32_t channels, float gain, float step) {
+    uint32_t sampleCount = frameCount * channels;
+    uint32_t i = 0;
+
+    if (4 % channels == 0) {
+        simd_f32x4 g = simd_f32x4_set(gain,
+                                      gain + step * (1 / channels),
+                                      gain + step * (2 / channels),
+                                      gain + step * (3 / channels));
+        simd_f32x4 advance = simd_f32x4_set1(step * (4 / channels));
+
+        for (; i + 4 <= sampleCount; i += 4) {
+            simd_f32x4_store(pSamples + i, simd_f32x4_mul(simd_f32x4_load(pSamples + i), g));
+            g = simd_f32x4_add(g, advance);
+        }
+    }
+
+    for (; i < sampleCount; i++) {
+        pSamples[i] *= gain + step * (float)(i / channels);
+    }
+}
+
+static void _process_f32(volume_t *self, float *pSamples, uint32_t frameCount) {
+    uint32_t rampFrames = self->rampLeft < frameCount ? self->rampLeft : frameCount;
+
+    if (rampFrames > 0) {
+        _ramp(pSamples, rampFrames, self->channels, self->gain, self->step);
+
+        self->rampLeft -= rampFrames;
+        self->gain = self->rampLeft == 0 ? self->target : self->gain + self->step * (float)rampFrames;
+    }
+
+    if (rampFrames < frameCount && self->gain != 1.0f) {
+        _scale(pSamples + rampFrames * self->channels, (frameCount - rampFrames) * self->channels, self->gain);
+    }
+}
+
+void volume_process(volume_t *self, void *pFrames, uint32_t frameCount) {
+    float target = atomic_load_explicit(&self->isMuted, memory_order_relaxed)
+                       ? 0.0f
+                       : atomic_load_explicit(&self->volume, memory_order_relaxed);
+
+    if (!self->isPrimed) {
+        self->gain = target;
+        self->target = target;
+        self->isPrimed = true;
+    }
+
+    // A change restarts the ramp from wherever the gain is now.
+    if (target != self->target) {
+        self->target = target;
+        self->rampLeft = self->rampFrames;
+        self->step = (target - self->gain) / (float)self->rampFrames;
+    }
+
+    if (self->rampLeft == 0) {
+        if (self->gain == 1.0f) {
+            return;
+        }
+
+        if (self->gain == 0.0f) {
+            ma_silence_pcm_frames(pFrames, frameCount, self->format, self->channels);
+            return;
+        }
+    }
+
+    if (self->format == ma_format_f32) {
+        _process_f32(self, (float *)pFrames, frameCount);
+        return;
+    }
+
+    float scratch[VOLUME_SLICE_SAMPLES];
+    uint32_t sliceFrames = VOLUME_SLICE_SAMPLES / self->channels;
+    uint32_t bytesPerFrame = ma_get_bytes_per_frame(self->format, self->channels);
+    char *pBytes = (char *)pFrames;
+
+    for (uint32_t done = 0; done < frameCount; done += sliceFrames) {
+        uint32_t frames = frameCount - done < sliceFrames ? frameCount - done : sliceFrames;
+        uint64_t samples = (uint64_t)frames * self->channels;
+        void *pSlice = pBytes + (size_t)done * bytesPerFrame;
+
+        ma_pcm_convert(scratch, ma_format_f32, pSlice, self->format, samples, ma_dither_mode_none);
+        _process_f32(self, scratch, frames);
+        ma_pcm_convert(pSlice, self->format, scratch, ma_format_f32, samples, ma_dither_mode_none);
+    }
+}
@@ -0,0 +1,574 @@
+#include "../include/waveform_bank.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/internal.h"
+#include "../include/logger.h"
+#include "../include/miniaudio.h"
+#include "../include/simd.h"
+
+// Frames rendered per inner pass. Bounds the scratch buffers and the float
+// drift of the vector phase accumulator between resyncs with the double phase.
+#define WAVEFORM_BANK_CHUNK_FRAMES 256
+
+#define WAVEFORM_BANK_TAU 6.283185307179586
+
+typedef void (*waveform_bank_kernel_fn)(float *pOut,
+                                        uint32_t frameCount,
+                                        waveform_type_t type,
+                                        float amplitude,
+                                        double phase,
+                                        double increment,
+                                        bool accumulate);
+
+typedef struct {
+    ma_data_source_base ds;         /**< Must be the first member so the bank is a `ma_data_source`. */
+    waveform_bank_config_t config;  /**< Output configuration. */
+    uint32_t oscillatorCount;       /**< Number of oscillators. */
+    uint32_t outputChannels;        /**< Channels per output frame. */
+    waveform_type_t *pTypes;        /**< Per-oscillator waveform type. */
+    float *pAmplitudes;             /**< Per-oscillator amplitude. */
+    double *pPhases;                /**< Per-oscillator phase in cycles, [0, 1). */
+    double *pIncrements;            /**< Per-oscillator phase increment in cycles per frame. */
+    float *pScratch;                /**< One oscillator worth of f32 frames. */
+    float *pMix;                    /**< One chunk of f32 output frames before format conversion. */
+    waveform_bank_kernel_fn kernel; /**< Kernel selected for the running CPU. */
+    ma_uint64 cursor;               /**< Frames rendered so far. */
+} waveform_bank_t;
+
+static inline float _shape_scalar(waveform_type_t type, float p) {
+    switch (type) {
+        case waveform_type_sine:
+            return (float)sin(WAVEFORM_BANK_TAU * p);
+        case waveform_type_square:
+            return p < 0.5f ? 1.0f : -1.0f;
+        case waveform_type_triangle:
+            return fabsf(4.0f * p - 2.0f) - 1.0f;
+        case waveform_type_sawtooth:
+            return 2.0f * p - 1.0f;
+        default:
+            return 0.0f;
+    }
+}
+
+static void _kernel_scalar(float *pOut,
+                           uint32_t frameCount,
+                           waveform_type_t type,
+                           float amplitude,
+                           double phase,
+                           double increment,
+                           bool accumulate) {
+    for (uint32_t i = 0; i < frameCount; i++) {
+        float s = _shape_scalar(type, (float)phase) * amplitude;
+        pOut[i] = accumulate ? pOut[i] + s : s;
+
+        phase += increment;
+        phase -= floor(phase);
+    }
+}
+
+// sin(2*pi*p) for p in [0, 1). The phase is folded into [0, pi/2] and
+// evaluated with an odd Taylor polynomial (error < 1e-7).
+static inline simd_f32x4 _sine_f32x4(simd_f32x4 p) {
+    const simd_f32x4 signMask = simd_f32x4_set1(-0.0f);
+    const simd_f32x4 half = simd_f32x4_set1(0.5f);
+
+    simd_f32x4 t = simd_f32x4_sub(p, half);
+    simd_f32x4 a = simd_f32x4_abs(t);
+    a = simd_f32x4_min(a, simd_f32x4_sub(half, a));
+
+    simd_f32x4 x = simd_f32x4_mul(a, simd_f32x4_set1((float)WAVEFORM_BANK_TAU));
+    simd_f32x4 x2 = simd_f32x4_mul(x, x);
+
+    simd_f32x4 poly = simd_f32x4_set1(-1.0f / 39916800.0f);
+    poly = simd_f32x4_add(simd_f32x4_mul(poly, x2), simd_f32x4_set1(1.0f / 362880.0f));
+    poly = simd_f32x4_add(simd_f32x4_mul(poly, x2), simd_f32x4_set1(-1.0f / 5040.0f));
+    poly = simd_f32x4_add(simd_f32x4_mul(poly, x2), simd_f32x4_set1(1.0f / 120.0f));
+    poly = simd_f32x4_add(simd_f32x4_mul(poly, x2), simd_f32x4_set1(-1.0f / 6.0f));
+    poly = simd_f32x4_add(simd_f32x4_mul(poly, x2), simd_f32x4_set1(1.0f));
+
+    simd_f32x4 s = simd_f32x4_mul(poly, x);
+
+    // sin(2*pi*p) = -sin(2*pi*t): flip the sign unless t is negative.
+    return simd_f32x4_xor(s, simd_f32x4_xor(simd_f32x4_and(t, signMask), signMask));
+}
+
+static inline simd_f32x4 _shape_f32x4(waveform_type_t type, simd_f32x4 p) {
+    switch (type) {
+        case waveform_type_sine:
+            return _sine_f32x4(p);
+        case waveform_type_square:
+            return simd_f32x4_select(simd_f32x4_cmplt(p, simd_f32x4_set1(0.5f)),
+                                     simd_f32x4_set1(1.0f),
+                                     simd_f32x4_set1(-1.0f));
+        case waveform_type_triangle:
+            return simd_f32x4_sub(
+                simd_f32x4_abs(simd_f32x4_sub(simd_f32x4_mul(p, simd_f32x4_set1(4.0f)),
+                                              simd_f32x4_set1(2.0f))),
+                simd_f32x4_set1(1.0f));
+        case waveform_type_sawtooth:
+            return simd_f32x4_sub(simd_f32x4_add(p, p), simd_f32x4_set1(1.0f));
+        default:
+            return simd_f32x4_set1(0.0f);
+    }
+}
+
+static void _kernel_f32x4(float *pOut,
+                          uint32_t frameCount,
+                          waveform_type_t type,
+                          float amplitude,
+                          double phase,
+                          double increment,
+                          bool accumulate) {
+    const simd_f32x4 amp = simd_f32x4_set1(amplitude);
+    const simd_f32x4 step = simd_f32x4_set1((float)(increment * 4.0));
+
+    simd_f32x4 p = simd_f32x4_set((float)phase,
+                                  (float)(phase + increment),
+                                  (float)(phase + increment * 2.0),
+                                  (float)(phase + increment * 3.0));
+    p = simd_f32x4_sub(p, simd_f32x4_floor(p));
+
+    uint32_t i = 0;
+
+    for (; i + 4 <= frameCount; i += 4) {
+        simd_f32x4 s = simd_f32x4_mul(_shape_f32x4(type, p), amp);
+
+        if (accumulate) {
+            s = simd_f32x4_add(s, simd_f32x4_load(pOut + i));
+        }
+
+        simd_f32x4_store(pOut + i, s);
+
+        p = simd_f32x4_add(p, step);
+        p = simd_f32x4_sub(p, simd_f32x4_floor(p));
+    }
+
+    if (i < frameCount) {
+        double tail = phase + increment * i;
+        _kernel_scalar(pOut + i, frameCount - i, type, amplitude,
+                       tail - floor(tail), increment, accumulate);
+    }
+}
+
+#if defined(SIMD_HAVE_AVX2_TARGET)
+
+SIMD_TARGET_AVX2
+static inline __m256 _sine_f32x8(__m256 p) {
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+
+    __m256 t = _mm256_sub_ps(p, half);
+    __m256 a = _mm256_andnot_ps(signMask, t);
+    a = _mm256_min_ps(a, _mm256_sub_ps(half, a));
+
+    __m256 x = _mm256_mul_ps(a, _mm256_set1_ps((float)WAVEFORM_BANK_TAU));
+    __m256 x2 = _mm256_mul_ps(x, x);
+
+    __m256 poly = _mm256_set1_ps(-1.0f / 39916800.0f);
+    poly = _mm256_fmadd_ps(poly, x2, _mm256_set1_ps(1.0f / 362880.0f));
+    poly = _mm256_fmadd_ps(poly, x2, _mm256_set1_ps(-1.0f / 5040.0f));
+    poly = _mm256_fmadd_ps(poly, x2, _mm256_set1_ps(1.0f / 120.0f));
+    poly = _mm256_fmadd_ps(poly, x2, _mm256_set1_ps(-1.0f / 6.0f));
+    poly = _mm256_fmadd_ps(poly, x2, _mm256_set1_ps(1.0f));
+
+    __m256 s = _mm256_mul_ps(poly, x);
+
+    return _mm256_xor_ps(s, _mm256_xor_ps(_mm256_and_ps(t, signMask), signMask));
+}
+
+SIMD_TARGET_AVX2
+static inline __m256 _shape_f32x8(waveform_type_t type, __m256 p) {
+    switch (type) {
+        case waveform_type_sine:
+            return _sine_f32x8(p);
+        case waveform_type_square:
+            return _mm256_blendv_ps(_mm256_set1_ps(-1.0f),
+                                    _mm256_set1_ps(1.0f),
+                                    _mm256_cmp_ps(p, _mm256_set1_ps(0.5f), _CMP_LT_OQ));
+        case waveform_type_triangle:
+            return _mm256_sub_ps(
+                _mm256_andnot_ps(_mm256_set1_ps(-0.0f),
+                                 _mm256_fmsub_ps(p, _mm256_set1_ps(4.0f), _mm256_set1_ps(2.0f))),
+                _mm256_set1_ps(1.0f));
+        case waveform_type_sawtooth:
+            return _mm256_sub_ps(_mm256_add_ps(p, p), _mm256_set1_ps(1.0f));
+        default:
+            return _mm256_setzero_ps();
+    }
+}
+
+SIMD_TARGET_AVX2
+static void _kernel_f32x8(float *pOut,
+                          uint32_t frameCount,
+                          waveform_type_t type,
+                          float amplitude,
+                          double phase,
+                          double increment,
+                          bool accumulate) {
+    const __m256 amp = _mm256_set1_ps(amplitude);
+    const __m256 step = _mm256_set1_ps((float)(increment * 8.0));
+
+    __m256 p = _mm256_setr_ps((float)phase,
+                              (float)(phase + increment),
+                              (float)(phase + increment * 2.0),
+                              (float)(phase + increment * 3.0),
+                              (float)(phase + increment * 4.0),
+                              (float)(phase + increment * 5.0),
+                              (float)(phase + increment * 6.0),
+                              (float)(phase + increment * 7.0));
+    p = _mm256_sub_ps(p, _mm256_floor_ps(p));
+
+    uint32_t i = 0;
+
+    for (; i + 8 <= frameCount; i += 8) {
+        __m256 s = _mm256_mul_ps(_shape_f32x8(type, p), amp);
+
+        if (accumulate) {
+            s = _mm256_add_ps(s, _mm256_loadu_ps(pOut + i));
+        }
+
+        _mm256_storeu_ps(pOut + i, s);
+
+        p = _mm256_add_ps(p, step);
+        p = _mm256_sub_ps(p, _mm256_floor_ps(p));
+    }
+
+    if (i < frameCount) {
+        double tail = phase + increment * i;
+        _kernel_f32x4(pOut + i, frameCount - i, type, amplitude,
+                      tail - floor(tail), increment, accumulate);
+    }
+}
+
+#endif
+
+static waveform_bank_kernel_fn _select_kernel(void) {
+    switch (simd_get_level()) {
+#if defined(SIMD_HAVE_AVX2_TARGET)
+        case simd_level_avx2:
+            return _kernel_f32x8;
+#endif
+        case simd_level_sse2:
+        case simd_level_neon:
+            return _kernel_f32x4;
+        default:
+            return _kernel_scalar;
+    }
+}
+
+static void _set_oscillator(waveform_bank_t *bank,
+                            uint32_t index,
+                            waveform_bank_oscillator_t *pOscillator) {
+    bank->pTypes[index] = pOscillator->type;
+    bank->pAmplitudes[index] = (float)pOscillator->amplitude;
+
+    double increment = pOscillator->frequency / bank->config.sampleRate;
+    bank->pIncrements[index] = increment - floor(increment);
+}
+
+static void _render(waveform_bank_t *bank, void *pFramesOut, ma_uint64 frameCount) {
+    ma_format format = (ma_format)bank->config.pcmFormat;
+    uint32_t channels = bank->outputChannels;
+    ma_uint32 bpf = ma_get_bytes_per_frame(format, channels);
+    ma_uint64 framesDone = 0;
+
+    while (framesDone < frameCount) {
+        ma_uint64 remaining = frameCount - framesDone;
+        uint32_t n = remaining < WAVEFORM_BANK_CHUNK_FRAMES
+                         ? (uint32_t)remaining
+                         : WAVEFORM_BANK_CHUNK_FRAMES;
+
+        char *pOut = (char *)pFramesOut + framesDone * bpf;
+        float *pMix = format == ma_format_f32 ? (float *)pOut : bank->pMix;
+
+        if (bank->config.mix == waveform_bank_mix_summed) {
+            // Mono sum rendered straight into the first `n` samples.
+            float *pSum = channels == 1 ? pMix : bank->pScratch;
+
+            for (uint32_t o = 0; o < bank->oscillatorCount; o++) {
+                bank->kernel(pSum, n, bank->pTypes[o], bank->pAmplitudes[o],
+                             bank->pPhases[o], bank->pIncrements[o], o != 0);
+            }
+
+            if (channels > 1) {
+                for (uint32_t f = 0; f < n; f++) {
+                    for (uint32_t c = 0; c < channels; c++) {
+                        pMix[f * channels + c] = pSum[f];
+                    }
+                }
+            }
+        } else {
+            for (uint32_t o = 0; o < bank->oscillatorCount; o++) {
+                bank->kernel(bank->pScratch, n, bank->pTypes[o], bank->pAmplitudes[o],
+                             bank->pPhases[o], bank->pIncrements[o], false);
+
+                for (uint32_t f = 0; f < n; f++) {
+                    pMix[f * channels + o] = bank->pScratch[f];
+                }
+            }
+        }
+
+        for (uint32_t o = 0; o < bank->oscillatorCount; o++) {
+            double phase = bank->pPhases[o] + bank->pIncrements[o] * n;
+            bank->pPhases[o] = phase - floor(phase);
+        }
+
+        if (format != ma_format_f32) {
+            ma_pcm_convert(pOut, format, pMix, ma_format_f32,
+                           (ma_uint64)n * channels, ma_dither_mode_none);
+        }
+
+        framesDone += n;
+    }
+
+    bank->cursor += frameCount;
+}
+
+static ma_result _ds_read(ma_data_source *pDataSource,
+                          void *pFramesOut,
+                          ma_uint64 frameCount,
+                          ma_uint64 *pFramesRead) {
+    waveform_bank_t *bank = (waveform_bank_t *)pDataSource;
+
+    if (pFramesOut) {
+        _render(bank, pFramesOut, frameCount);
+    } else {
+        for (uint32_t o = 0; o < bank->oscillatorCount; o++) {
+            double phase = bank->pPhases[o] + bank->pIncrements[o] * (double)frameCount;
+            bank->pPhases[o] = phase - floor(phase);
+        }
+
+        bank->cursor += frameCount;
+    }
+
+    if (pFramesRead) {
+        *pFramesRead = frameCount;
+    }
+
+    return MA_SUCCESS;
+}
+
+static ma_result _ds_seek(ma_data_source *pDataSource, ma_uint64 frameIndex) {
+    waveform_bank_t *bank = (waveform_bank_t *)pDataSource;
+
+    for (uint32_t o = 0; o < bank->oscillatorCount; o++) {
+        double phase = bank->pIncrements[o] * (double)frameIndex;
+        bank->pPhases[o] = phase - floor(phase);
+    }
+
+    bank->cursor = frameIndex;
+
+    return MA_SUCCESS;
+}
+
+static ma_result _ds_get_data_format(ma_data_source *pDataSource,
+                                     ma_format *pFormat,
+                                     ma_uint32 *pChannels,
+                                     ma_uint32 *pSampleRate,
+                                     ma_channel *pChannelMap,
+                                     size_t channelMapCap) {
+    waveform_bank_t *bank = (waveform_bank_t *)pDataSource;
+
+    *pFormat = (ma_format)bank->config.pcmFormat;
+    *pChannels = bank->outputChannels;
+    *pSampleRate = bank->config.sampleRate;
+    ma_channel_map_init_standard(ma_standard_channel_map_default,
+                                 pChannelMap,
+                                 channelMapCap,
+                                 bank->outputChannels);
+
+    return MA_SUCCESS;
+}
+
+static ma_result _ds_get_cursor(ma_data_source *pDataSource, ma_uint64 *pCursor) {
+    *pCursor = ((waveform_bank_t *)pDataSource)->cursor;
+
+    return MA_SUCCESS;
+}
+
+static ma_data_source_vtable g_waveform_bank_ds_vtable = {
+    _ds_read,
+    _ds_seek,
+    _ds_get_data_format,
+    _ds_get_cursor,
+    NULL, /* onGetLength. Oscillators are infinite. */
+    NULL, /* onSetLooping */
+    0};
+
+static void _free_bank(waveform_bank_t *bank) {
+    free(bank->pTypes);
+    free(bank->pAmplitudes);
+    free(bank->pPhases);
+    free(bank->pIncrements);
+    free(bank->pScratch);
+    free(bank->pMix);
+    free(bank);
+}
+
+FFI_PLUGIN_EXPORT
+void *waveform_bank_create(waveform_bank_config_t *pConfig,
+                           waveform_bank_oscillator_t *pOscillators,
+                           uint32_t oscillatorCount) {
+    if (!pConfig) {
+        LOG_ERROR("invalid parameter: `pConfig` is NULL.\n", "");
+        return NULL;
+    }
+
+    if (!pOscillators || oscillatorCount == 0) {
+        LOG_ERROR("invalid parameter: `pOscillators` is empty.\n", "");
+        return NULL;
+    }
+
+    if (pConfig->sampleRate == 0) {
+        LOG_ERROR("invalid parameter: `pConfig->sampleRate` is 0.\n", "");
+        return NULL;
+    }
+
+    uint32_t outputChannels = pConfig->mix == waveform_bank_mix_interleaved
+                                  ? oscillatorCount
+                                  : pConfig->channels;
+
+    if (outputChannels == 0 || outputChannels > MA_MAX_CHANNELS) {
+        LOG_ERROR("invalid output channel count: %u.\n", outputChannels);
+        return NULL;
+    }
+
+    waveform_bank_t *bank = calloc(1, sizeof(waveform_bank_t));
+
+    if (!bank) {
+        LOG_ERROR("failed to allocate memory for `waveform_bank_t`.\n", "");
+        return NULL;
+    }
+
+    bank->config = *pConfig;
+    bank->oscillatorCount = oscillatorCount;
+    bank->outputChannels = outputChannels;
+    bank->pTypes = malloc(oscillatorCount * sizeof(waveform_type_t));
+    bank->pAmplitudes = malloc(oscillatorCount * sizeof(float));
+    bank->pPhases = calloc(oscillatorCount, sizeof(double));
+    bank->pIncrements = malloc(oscillatorCount * sizeof(double));
+    bank->pScratch = malloc(WAVEFORM_BANK_CHUNK_FRAMES * sizeof(float));
+    bank->pMix = malloc((size_t)WAVEFORM_BANK_CHUNK_FRAMES * outputChannels * sizeof(float));
+
+    if (!bank->pTypes || !bank->pAmplitudes || !bank->pPhases ||
+        !bank->pIncrements || !bank->pScratch || !bank->pMix) {
+        _free_bank(bank);
+        LOG_ERROR("failed to allocate memory for oscillator state.\n", "");
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < oscillatorCount; i++) {
+        _set_oscillator(bank, i, &pOscillators[i]);
+    }
+
+    bank->kernel = _select_kernel();
+
+    ma_data_source_config dsConfig = ma_data_source_config_init();
+    dsConfig.vtable = &g_waveform_bank_ds_vtable;
+
+    ma_result dsInitResult = ma_data_source_init(&dsConfig, &bank->ds);
+
+    if (dsInitResult != MA_SUCCESS) {
+        _free_bank(bank);
+
+        LOG_ERROR("`ma_data_source_init` failed - %s.\n",
+                  ma_result_description(dsInitResult));
+
+        return NULL;
+    }
+
+    LOG_INFO("<%p>(waveform_bank_t) created - oscillators: %u, format: %s, channels: %u, kernel: %s.\n",
+             bank,
+             oscillatorCount,
+             describe_ma_format((ma_format)pConfig->pcmFormat),
+             outputChannels,
+             describe_simd_level(simd_get_level()));
+
+    return bank;
+}
+
+FFI_PLUGIN_EXPORT
+void waveform_bank_destroy(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    waveform_bank_t *bank = (waveform_bank_t *)self;
+
+    ma_data_source_uninit(&bank->ds);
+    _free_bank(bank);
+
+    LOG_INFO("<%p>(waveform_bank_t) destroyed.\n", bank);
+}
+
+FFI_PLUGIN_EXPORT
+void waveform_bank_set_oscillator(void *self,
+                                  uint32_t index,
+                                  waveform_bank_oscillator_t *pOscillator) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    if (!pOscillator) {
+        LOG_ERROR("invalid parameter: `pOscillator` is NULL.\n", "");
+        return;
+    }
+
+    waveform_bank_t *bank = (waveform_bank_t *)self;
+
+    if (index >= bank->oscillatorCount) {
+        LOG_ERROR("invalid parameter: `index` %u out of range (%u).\n",
+                  index, bank->oscillatorCount);
+        return;
+    }
+
+    _set_oscillator(bank, index, pOscillator);
+}
+
+FFI_PLUGIN_EXPORT
+uint32_t waveform_bank_get_channels(void *self) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return 0;
+    }
+
+    return ((waveform_bank_t *)self)->outputChannels;
+}
+
+FFI_PLUGIN_EXPORT
+void waveform_bank_read_pcm_frames_with_buffer(void *self,
+                                               void *pFramesOut,
+                                               uint64_t framesCount,
+                                               uint64_t *pFramesRead) {
+    if (!self) {
+        LOG_ERROR("invalid parameter: `self` is NULL.\n", "");
+        return;
+    }
+
+    if (!pFramesOut) {
+        LOG_ERROR("invalid parameter: `pFramesOut` is NULL.\n", "");
+        return;
+    }
+
+    if (!pFramesRead) {
+        LOG_ERROR("invalid parameter: `pFramesRead` is NULL.\n", "");
+        return;
+    }
+
+    ma_uint64 framesRead = 0;
+
+    ma_result readResult =
+        ma_data_source_read_pcm_frames(self, pFramesOut, framesCount, &framesRead);
+
+    if (readResult != MA_SUCCESS) {
+        LOG_ERROR("`ma_data_source_read_pcm_frames` failed - %s.\n",
+                  ma_result_description(readResult));
+    }
+
+    *pFramesRead = framesRead;
+}
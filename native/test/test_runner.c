@@ -1,9 +1,28 @@
 #include "../include/audio_context.h"
+#include "../include/decoder.h"
+#include "../include/dsp_chain.h"
+#include "../include/reference_tap.h"
+#include "../include/silence_detector.h"
+#include "../include/volume.h"
+#include "../include/encoder.h"
 #include "../include/logger.h"
+#include "../include/mapped_wav.h"
+#include "../include/meter.h"
+#include "../include/overview.h"
 #include "../include/playback_device.h"
+#include "../include/playback_group.h"
+#include "../include/playback_pool.h"
+#include "../include/spectrum.h"
 #include "../include/waveform.h"
+#include "../include/waveform_bank.h"
+#include "../include/miniaudio.h"
 #include "unity/unity.h"
 
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
 void setUp(void) {}
 void tearDown(void) {}
 
@@ -17,10 +36,2617 @@ void test_context_create_destroy(void) {
     audio_context_destroy(pContext);
 }
 
+void test_context_create_ex_lazy_with_backend_list(void) {
+    audio_context_config_t config = {0};
+    config.backends[0] = audio_backend_null;
+    config.backendCount = 1;
+    config.isLazy = true;
+
+    void *pContext = audio_context_create_ex(&config);
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    audio_context_timings_t timings;
+    TEST_ASSERT_TRUE(audio_context_get_timings(pContext, &timings));
+    TEST_ASSERT_EQUAL(audio_backend_null, timings.backend);
+    TEST_ASSERT_FALSE(timings.isEnumerated);
+    TEST_ASSERT_EQUAL_UINT64(0, timings.enumerateNs);
+
+    // The first query enumerates.
+    device_infos_t *pInfos = audio_context_get_device_infos(pContext, device_type_playback);
+    TEST_ASSERT_NOT_NULL(pInfos);
+    TEST_ASSERT_TRUE(pInfos->count > 0);
+    audio_context_device_infos_destroy(pInfos);
+
+    TEST_ASSERT_TRUE(audio_context_get_timings(pContext, &timings));
+    TEST_ASSERT_TRUE(timings.isEnumerated);
+    TEST_ASSERT_TRUE(timings.enumerateNs > 0);
+
+    audio_context_destroy(pContext);
+}
+
+void test_context_create_ex_prefers_last_backend(void) {
+    audio_context_config_t config = {0};
+    config.backends[0] = audio_backend_null;
+    config.backendCount = 1;
+
+    void *pContext = audio_context_create_ex(&config);
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    audio_context_timings_t timings;
+    TEST_ASSERT_TRUE(audio_context_get_timings(pContext, &timings));
+    TEST_ASSERT_TRUE(timings.isEnumerated);
+    audio_context_destroy(pContext);
+
+    // No list: every enabled backend, with the last one first.
+    audio_context_config_t preferLast = {0};
+    preferLast.preferLastBackend = true;
+    preferLast.isLazy = true;
+
+    pContext = audio_context_create_ex(&preferLast);
+    TEST_ASSERT_NOT_NULL(pContext);
+    TEST_ASSERT_TRUE(audio_context_get_timings(pContext, &timings));
+    TEST_ASSERT_EQUAL(audio_backend_null, timings.backend);
+    audio_context_destroy(pContext);
+}
+
+typedef struct {
+    atomic_uint completed;
+    atomic_bool isHeld;
+    atomic_bool isReleased;
+    device_infos_t *pDeviceInfos;
+    device_info_ext_t *pDeviceInfoExt;
+} async_requests_t;
+
+static void _on_refresh(void *pUserData, bool isSuccess) {
+    async_requests_t *pRequests = pUserData;
+
+    TEST_ASSERT_TRUE(isSuccess);
+
+    // Holds the worker in the first batch until the test queued the others.
+    atomic_store(&pRequests->isHeld, true);
+
+    while (!atomic_load(&pRequests->isReleased)) {
+        usleep(1000);
+    }
+
+    atomic_fetch_add(&pRequests->completed, 1);
+}
+
+static void _on_device_infos(void *pUserData, device_infos_t *pDeviceInfos) {
+    async_requests_t *pRequests = pUserData;
+
+    pRequests->pDeviceInfos = pDeviceInfos;
+    atomic_fetch_add(&pRequests->completed, 1);
+}
+
+static void _on_device_info_ext(void *pUserData, device_info_ext_t *pDeviceInfoExt) {
+    async_requests_t *pRequests = pUserData;
+
+    pRequests->pDeviceInfoExt = pDeviceInfoExt;
+    atomic_fetch_add(&pRequests->completed, 1);
+}
+
+static void _wait_for_completed(async_requests_t *pRequests, uint32_t count) {
+    for (int i = 0; i < 2000 && atomic_load(&pRequests->completed) < count; i++) {
+        usleep(1000);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(count, atomic_load(&pRequests->completed));
+}
+
+void test_context_async_refresh_coalesces(void) {
+    audio_context_config_t config = {0};
+    config.backends[0] = audio_backend_null;
+    config.backendCount = 1;
+    config.isLazy = true;
+
+    void *pContext = audio_context_create_ex(&config);
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    async_requests_t requests = {0};
+
+    TEST_ASSERT_TRUE(audio_context_refresh_devices_async(pContext, _on_refresh, &requests));
+
+    for (int i = 0; i < 2000 && !atomic_load(&requests.isHeld); i++) {
+        usleep(1000);
+    }
+
+    // The worker is busy with the first request: these form one batch.
+    for (int i = 0; i < 7; i++) {
+        TEST_ASSERT_TRUE(audio_context_refresh_devices_async(pContext, _on_refresh, &requests));
+    }
+
+    TEST_ASSERT_TRUE(audio_context_get_device_infos_async(pContext,
+                                                          device_type_playback,
+                                                          _on_device_infos,
+                                                          &requests));
+
+    atomic_store(&requests.isReleased, true);
+    _wait_for_completed(&requests, 9);
+
+    audio_context_timings_t timings;
+    TEST_ASSERT_TRUE(audio_context_get_timings(pContext, &timings));
+    TEST_ASSERT_EQUAL_UINT32(2, timings.enumerations);
+
+    TEST_ASSERT_NOT_NULL(requests.pDeviceInfos);
+    TEST_ASSERT_TRUE(requests.pDeviceInfos->count > 0);
+    audio_context_device_infos_destroy(requests.pDeviceInfos);
+
+    audio_context_destroy(pContext);
+}
+
+void test_context_async_device_info_ext(void) {
+    audio_context_config_t config = {0};
+    config.backends[0] = audio_backend_null;
+    config.backendCount = 1;
+    config.isLazy = true;
+
+    void *pContext = audio_context_create_ex(&config);
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    async_requests_t requests = {0};
+    atomic_store(&requests.isReleased, true);
+
+    // A lazy context enumerates for the first list.
+    TEST_ASSERT_TRUE(audio_context_get_device_infos_async(pContext,
+                                                          device_type_playback,
+                                                          _on_device_infos,
+                                                          &requests));
+    _wait_for_completed(&requests, 1);
+    TEST_ASSERT_NOT_NULL(requests.pDeviceInfos);
+
+    TEST_ASSERT_TRUE(audio_context_get_device_info_ext_async(pContext,
+                                                             &requests.pDeviceInfos->list[0].id,
+                                                             _on_device_info_ext,
+                                                             &requests));
+    TEST_ASSERT_TRUE(audio_context_refresh_devices_async(pContext, _on_refresh, &requests));
+
+    // Queued requests are served before the context goes away.
+    audio_context_destroy(pContext);
+
+    TEST_ASSERT_EQUAL_UINT32(3, atomic_load(&requests.completed));
+    TEST_ASSERT_NOT_NULL(requests.pDeviceInfoExt);
+    TEST_ASSERT_TRUE(requests.pDeviceInfoExt->count > 0);
+
+    audio_context_device_info_ext_destroy(requests.pDeviceInfoExt);
+    audio_context_device_infos_destroy(requests.pDeviceInfos);
+}
+
+typedef struct {
+    atomic_uint completed;
+    device_state_t states[4];
+    bool isSuccess[4];
+} async_transitions_t;
+
+static void _on_transition(void *pUserData, bool isSuccess, device_state_t state) {
+    async_transitions_t *pTransitions = pUserData;
+    uint32_t index = atomic_load(&pTransitions->completed);
+
+    pTransitions->states[index] = state;
+    pTransitions->isSuccess[index] = isSuccess;
+    atomic_fetch_add(&pTransitions->completed, 1);
+}
+
+void test_playback_device_start_async(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_s16,
+        .rbSizeInBytes = 48000 * 2,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_NOT_NULL(pDevice);
+
+    async_transitions_t transitions = {0};
+    TEST_ASSERT_TRUE(playback_device_start_async(pDevice, _on_transition, &transitions));
+
+    for (int i = 0; i < 2000 && atomic_load(&transitions.completed) < 1; i++) {
+        usleep(1000);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&transitions.completed));
+    TEST_ASSERT_TRUE(transitions.isSuccess[0]);
+    TEST_ASSERT_EQUAL(device_state_started, transitions.states[0]);
+    TEST_ASSERT_EQUAL(device_state_started, playback_device_get_state(pDevice));
+
+    playback_device_destroy(pDevice);
+    audio_context_destroy(pContext);
+}
+
+void test_playback_device_transitions_run_in_order(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_s16,
+        .rbSizeInBytes = 48000 * 2,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_NOT_NULL(pDevice);
+
+    async_transitions_t transitions = {0};
+    TEST_ASSERT_TRUE(playback_device_start_async(pDevice, _on_transition, &transitions));
+    TEST_ASSERT_TRUE(playback_device_stop_async(pDevice, _on_transition, &transitions));
+    TEST_ASSERT_TRUE(playback_device_start_async(pDevice, NULL, NULL));
+
+    // Destroying waits for the queued transitions of the device.
+    playback_device_destroy(pDevice);
+
+    TEST_ASSERT_EQUAL_UINT32(2, atomic_load(&transitions.completed));
+    TEST_ASSERT_TRUE(transitions.isSuccess[0]);
+    TEST_ASSERT_EQUAL(device_state_started, transitions.states[0]);
+    TEST_ASSERT_TRUE(transitions.isSuccess[1]);
+    TEST_ASSERT_EQUAL(device_state_stopped, transitions.states[1]);
+
+    audio_context_destroy(pContext);
+}
+
+void test_waveform_bank_matches_waveform(void) {
+    const uint32_t sampleRate = 48000;
+    const uint32_t frames = 1000;
+    waveform_bank_oscillator_t oscillators[] = {
+        {waveform_type_sine, 0.5, 440.0},
+        {waveform_type_square, 0.25, 1003.0},
+        {waveform_type_triangle, 1.0, 97.0},
+        {waveform_type_sawtooth, 0.8, 3000.0},
+        {waveform_type_sine, 1.0, 12345.0},
+    };
+    const uint32_t count = sizeof(oscillators) / sizeof(oscillators[0]);
+
+    waveform_bank_config_t config = {
+        .pcmFormat = pcm_format_f32,
+        .channels = 0,
+        .sampleRate = sampleRate,
+        .mix = waveform_bank_mix_interleaved,
+    };
+
+    void *pBank = waveform_bank_create(&config, oscillators, count);
+    TEST_ASSERT_NOT_NULL(pBank);
+    TEST_ASSERT_EQUAL_UINT32(count, waveform_bank_get_channels(pBank));
+
+    float bankOut[1000 * 5];
+    uint64_t framesRead = 0;
+    waveform_bank_read_pcm_frames_with_buffer(pBank, bankOut, frames, &framesRead);
+    TEST_ASSERT_EQUAL_UINT64(frames, framesRead);
+
+    for (uint32_t o = 0; o < count; o++) {
+        void *pWaveform = waveform_create(pcm_format_f32, 1, sampleRate,
+                                          oscillators[o].type,
+                                          oscillators[o].amplitude,
+                                          oscillators[o].frequency);
+        TEST_ASSERT_NOT_NULL(pWaveform);
+
+        float reference[1000];
+        waveform_read_pcm_frames_with_buffer(pWaveform, reference, frames, &framesRead);
+
+        uint32_t mismatches = 0;
+
+        for (uint32_t f = 0; f < frames; f++) {
+            float diff = fabsf(reference[f] - bankOut[f * count + o]);
+
+            // Square and sawtooth jump at the period boundary, where a rounding
+            // difference in the phase may land a sample on the other side.
+            if (diff > 1e-3f) {
+                mismatches++;
+            }
+        }
+
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(frames / 100, mismatches);
+
+        waveform_destroy(pWaveform);
+    }
+
+    waveform_bank_destroy(pBank);
+}
+
+void test_waveform_bank_summed_s16(void) {
+    waveform_bank_oscillator_t oscillators[] = {
+        {waveform_type_sine, 0.25, 440.0},
+        {waveform_type_sine, 0.25, 440.0},
+    };
+
+    waveform_bank_config_t config = {
+        .pcmFormat = pcm_format_s16,
+        .channels = 2,
+        .sampleRate = 44100,
+        .mix = waveform_bank_mix_summed,
+    };
+
+    void *pBank = waveform_bank_create(&config, oscillators, 2);
+    TEST_ASSERT_NOT_NULL(pBank);
+
+    int16_t out[300 * 2];
+    uint64_t framesRead = 0;
+    waveform_bank_read_pcm_frames_with_buffer(pBank, out, 300, &framesRead);
+    TEST_ASSERT_EQUAL_UINT64(300, framesRead);
+
+    for (uint32_t f = 0; f < 300; f++) {
+        double expected = 0.5 * sin(2.0 * M_PI * 440.0 * f / 44100.0) * 32767.0;
+        TEST_ASSERT_INT16_WITHIN(4, (int16_t)lrint(expected), out[f * 2]);
+        TEST_ASSERT_EQUAL_INT16(out[f * 2], out[f * 2 + 1]);
+    }
+
+    waveform_bank_destroy(pBank);
+}
+
+void test_playback_device_attach_source(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_f32,
+        .rbMaxThreshold = 4800 * 4,
+        .rbMinThreshold = 480 * 4,
+        .rbSizeInBytes = 48000 * 4,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_NOT_NULL(pDevice);
+
+    void *pMismatched = waveform_create(pcm_format_s16, 1, 48000, waveform_type_sine, 0.5, 440.0);
+    TEST_ASSERT_FALSE(playback_device_attach_source(pDevice, pMismatched));
+
+    void *pWaveform = waveform_create(pcm_format_f32, 1, 48000, waveform_type_sine, 0.5, 440.0);
+    TEST_ASSERT_TRUE(playback_device_attach_source(pDevice, pWaveform));
+
+    playback_device_start(pDevice);
+    usleep(50000);
+
+    TEST_ASSERT_TRUE(playback_device_attach_source(pDevice, NULL));
+    waveform_destroy(pWaveform);
+
+    playback_device_destroy(pDevice);
+    waveform_destroy(pMismatched);
+    audio_context_destroy(pContext);
+}
+
+typedef struct {
+    pthread_mutex_t mutex;
+    int count;
+    playback_event_type_t types[64];
+    device_state_t states[64];
+} event_log_t;
+
+static void _log_event(void *pUserData,
+                       playback_event_type_t type,
+                       device_state_t state,
+                       uint32_t availableBytes) {
+    event_log_t *log = pUserData;
+    (void)availableBytes;
+
+    pthread_mutex_lock(&log->mutex);
+    if (log->count < 64) {
+        log->types[log->count] = type;
+        log->states[log->count] = state;
+        log->count++;
+    }
+    pthread_mutex_unlock(&log->mutex);
+}
+
+static int _count_events(event_log_t *log, playback_event_type_t type) {
+    int count = 0;
+
+    pthread_mutex_lock(&log->mutex);
+    for (int i = 0; i < log->count; i++) {
+        count += log->types[i] == type;
+    }
+    pthread_mutex_unlock(&log->mutex);
+
+    return count;
+}
+
+void test_playback_device_events(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_f32,
+        .rbMaxThreshold = 4800 * 4,
+        .rbMinThreshold = 480 * 4,
+        .rbSizeInBytes = 48000 * 4,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_NOT_NULL(pDevice);
+
+    static event_log_t log;
+    memset(&log, 0, sizeof(log));
+    pthread_mutex_init(&log.mutex, NULL);
+
+    TEST_ASSERT_TRUE(playback_device_set_event_callback(pDevice, 0, _log_event, &log));
+
+    // 0.15 s of audio: enough to start reading, then runs dry.
+    static float samples[2400];
+    playback_data_t data = {.pUserData = samples, .sizeInBytes = sizeof(samples)};
+    for (int i = 0; i < 3; i++) {
+        playback_device_push_buffer(pDevice, &data);
+    }
+
+    playback_device_start(pDevice);
+    usleep(400000);
+    playback_device_stop(pDevice);
+    usleep(100000);
+
+    // Delivers the queued events and the closing marker.
+    playback_device_set_event_callback(pDevice, 0, NULL, NULL);
+    int count = log.count;
+
+    TEST_ASSERT_EQUAL_INT(1, _count_events(&log, playback_event_need_data));
+    TEST_ASSERT_EQUAL_INT(1, _count_events(&log, playback_event_underrun));
+    TEST_ASSERT_EQUAL_INT(2, _count_events(&log, playback_event_state_changed));
+    TEST_ASSERT_EQUAL(playback_event_closed, log.types[count - 1]);
+
+    // Events follow the order they happened in.
+    int needData = -1, underrun = -1;
+    for (int i = 0; i < count; i++) {
+        if (log.types[i] == playback_event_need_data) needData = i;
+        if (log.types[i] == playback_event_underrun) underrun = i;
+    }
+    TEST_ASSERT_EQUAL(playback_event_state_changed, log.types[0]);
+    TEST_ASSERT_EQUAL(device_state_started, log.states[0]);
+    TEST_ASSERT_TRUE(needData < underrun);
+    TEST_ASSERT_EQUAL(playback_event_state_changed, log.types[count - 2]);
+    TEST_ASSERT_EQUAL(device_state_stopped, log.states[count - 2]);
+
+    // Nothing is delivered once the callback is removed.
+    playback_device_destroy(pDevice);
+    TEST_ASSERT_EQUAL_INT(count, log.count);
+
+    pthread_mutex_destroy(&log.mutex);
+    audio_context_destroy(pContext);
+}
+
+void test_meter_levels_and_loudness(void) {
+    // EBU Tech 3341: a 1 kHz stereo sine at -23 dBFS reads -23 LUFS.
+    const float amplitude = powf(10.0f, -23.0f / 20.0f);
+    meter_t *pMeter = meter_create(ma_format_f32, 2, 48000);
+    TEST_ASSERT_NOT_NULL(pMeter);
+
+    static float frames[480 * 2];
+    uint64_t position = 0;
+
+    for (int block = 0; block < 400; block++) {
+        for (int f = 0; f < 480; f++, position++) {
+            float x = amplitude * sinf(2.0f * (float)M_PI * 1000.0f * position / 48000.0f);
+            frames[f * 2] = x;
+            frames[f * 2 + 1] = x;
+        }
+
+        meter_process(pMeter, frames, 480);
+    }
+
+    playback_meter_t levels;
+    meter_read(pMeter, &levels);
+
+    TEST_ASSERT_EQUAL_UINT32(2, levels.channels);
+    TEST_ASSERT_EQUAL_UINT64(position, levels.framesMetered);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, -23.0f, levels.shortTermLoudness);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, -23.0f, levels.momentaryLoudness);
+
+    for (int c = 0; c < 2; c++) {
+        TEST_ASSERT_FLOAT_WITHIN(amplitude * 0.01f, amplitude, levels.peak[c]);
+        TEST_ASSERT_FLOAT_WITHIN(amplitude * 0.01f, amplitude / sqrtf(2.0f), levels.rms[c]);
+        TEST_ASSERT_FLOAT_WITHIN(amplitude * 0.02f, amplitude, levels.truePeak[c]);
+    }
+
+    meter_destroy(pMeter);
+}
+
+void test_meter_true_peak(void) {
+    // A sine at a quarter of the sample rate sampled 45 degrees off its crests:
+    // every sample is at 0.707 of the real peak.
+    meter_t *pMeter = meter_create(ma_format_s16, 1, 48000);
+    TEST_ASSERT_NOT_NULL(pMeter);
+
+    static int16_t frames[4800];
+    for (int f = 0; f < 4800; f++) {
+        frames[f] = (int16_t)lrintf(16384.0f * sinf((float)M_PI / 2.0f * f + (float)M_PI / 4.0f));
+    }
+
+    meter_process(pMeter, frames, 4800);
+
+    playback_meter_t levels;
+    meter_read(pMeter, &levels);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 0.5f * 0.7071f, levels.peak[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.025f, 0.5f, levels.truePeak[0]);
+
+    // Silence keeps the peaks falling back and reads as -inf LUFS once the
+    // loudness window is past the tone.
+    static int16_t silence[48000];
+    for (int i = 0; i < 4; i++) {
+        meter_process(pMeter, silence, 48000);
+    }
+
+    meter_read(pMeter, &levels);
+
+    TEST_ASSERT_TRUE(levels.peak[0] < 0.5f * 0.7071f * 0.01f);
+    TEST_ASSERT_TRUE(isinf(levels.shortTermLoudness) && levels.shortTermLoudness < 0);
+
+    meter_destroy(pMeter);
+}
+
+void test_playback_device_metering(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_f32,
+        .rbMaxThreshold = 4800 * 4,
+        .rbMinThreshold = 480 * 4,
+        .rbSizeInBytes = 48000 * 4,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_NOT_NULL(pDevice);
+
+    playback_meter_t levels;
+    TEST_ASSERT_FALSE(playback_device_get_meter(pDevice, &levels));
+
+    TEST_ASSERT_TRUE(playback_device_set_metering_enabled(pDevice, true));
+
+    void *pWaveform = waveform_create(pcm_format_f32, 1, 48000, waveform_type_square, 0.5, 440.0);
+    TEST_ASSERT_TRUE(playback_device_attach_source(pDevice, pWaveform));
+
+    playback_device_start(pDevice);
+    usleep(200000);
+
+    // The meter sees what was actually output.
+    TEST_ASSERT_TRUE(playback_device_get_meter(pDevice, &levels));
+    TEST_ASSERT_TRUE(levels.framesMetered > 0);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, levels.peak[0]);
+
+    TEST_ASSERT_TRUE(playback_device_set_metering_enabled(pDevice, false));
+    TEST_ASSERT_FALSE(playback_device_get_meter(pDevice, &levels));
+
+    playback_device_stop(pDevice);
+    playback_device_detach_source(pDevice);
+    waveform_destroy(pWaveform);
+
+    playback_device_destroy(pDevice);
+    audio_context_destroy(pContext);
+}
+
+// Peak of a 0.5 amplitude sine after it ran through the chain, skipping the
+// first 4800 frames of transients.
+static float _dsp_sine_peak(dsp_chain_t *pChain, double frequency) {
+    static int16_t frames[9600];
+    float peak = 0.0f;
+
+    for (int i = 0; i < 9600; i++) {
+        frames[i] = (int16_t)(16384.0 * sin(2.0 * M_PI * frequency * i / 48000.0));
+    }
+
+    // Odd-sized calls exercise the conversion slices.
+    for (int done = 0; done < 9600; done += 1200) {
+        dsp_chain_process(pChain, frames + done, 1200);
+    }
+
+    for (int i = 4800; i < 9600; i++) {
+        peak = fmaxf(peak, fabsf(frames[i] / 32768.0f));
+    }
+
+    return peak;
+}
+
+void test_dsp_chain_filters_and_updates(void) {
+    playback_dsp_stage_t stages[] = {
+        {.type = playback_dsp_lowpass, .order = 4, .frequency = 1000.0},
+        {.type = playback_dsp_gain, .gainDb = -6.0206},
+    };
+
+    dsp_chain_t *pChain = dsp_chain_create(ma_format_s16, 1, 48000, stages, 2);
+    TEST_ASSERT_NOT_NULL(pChain);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.25f, _dsp_sine_peak(pChain, 100.0));
+    TEST_ASSERT_TRUE(_dsp_sine_peak(pChain, 10000.0) < 0.001f);
+
+    // Parameters change through the queue; the structure cannot.
+    playback_dsp_stage_t gain = {.type = playback_dsp_gain, .gainDb = 0.0};
+    TEST_ASSERT_TRUE(dsp_chain_post_update(pChain, 1, &gain));
+
+    playback_dsp_stage_t lowpass = {.type = playback_dsp_lowpass, .order = 4, .frequency = 20000.0};
+    TEST_ASSERT_TRUE(dsp_chain_post_update(pChain, 0, &lowpass));
+
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.5f, _dsp_sine_peak(pChain, 10000.0));
+
+    lowpass.order = 2;
+    TEST_ASSERT_FALSE(dsp_chain_post_update(pChain, 0, &lowpass));
+    TEST_ASSERT_FALSE(dsp_chain_post_update(pChain, 2, &gain));
+    TEST_ASSERT_FALSE(dsp_chain_post_update(pChain, 0, &gain));
+
+    dsp_chain_destroy(pChain);
+
+    playback_dsp_stage_t invalid = {.type = playback_dsp_highpass, .frequency = 30000.0};
+    TEST_ASSERT_NULL(dsp_chain_create(ma_format_f32, 2, 48000, &invalid, 1));
+}
+
+void test_playback_device_dsp_chain(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_f32,
+        .rbMaxThreshold = 4800 * 4,
+        .rbMinThreshold = 480 * 4,
+        .rbSizeInBytes = 48000 * 4,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_NOT_NULL(pDevice);
+
+    playback_dsp_stage_t stage = {.type = playback_dsp_gain, .gainDb = -20.0, .smoothFrames = 480};
+    TEST_ASSERT_FALSE(playback_device_update_dsp_stage(pDevice, 0, &stage));
+    TEST_ASSERT_TRUE(playback_device_set_dsp_chain(pDevice, &stage, 1));
+    TEST_ASSERT_TRUE(playback_device_set_metering_enabled(pDevice, true));
+
+    void *pWaveform = waveform_create(pcm_format_f32, 1, 48000, waveform_type_square, 0.5, 440.0);
+    TEST_ASSERT_TRUE(playback_device_attach_source(pDevice, pWaveform));
+
+    playback_device_start(pDevice);
+    usleep(200000);
+
+    // The meter sees the processed output.
+    playback_meter_t levels;
+    TEST_ASSERT_TRUE(playback_device_get_meter(pDevice, &levels));
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 0.05f, levels.peak[0]);
+
+    stage.gainDb = 0.0;
+    TEST_ASSERT_TRUE(playback_device_update_dsp_stage(pDevice, 0, &stage));
+    usleep(200000);
+
+    TEST_ASSERT_TRUE(playback_device_get_meter(pDevice, &levels));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, levels.peak[0]);
+
+    TEST_ASSERT_TRUE(playback_device_set_dsp_chain(pDevice, NULL, 0));
+
+    playback_device_stop(pDevice);
+    playback_device_detach_source(pDevice);
+    waveform_destroy(pWaveform);
+
+    playback_device_destroy(pDevice);
+    audio_context_destroy(pContext);
+}
+
+void test_volume_ramp_and_mute(void) {
+    static float frames[2 * 2400];
+    volume_t volume;
+
+    volume_init(&volume, ma_format_f32, 2, 48000);
+
+    for (int i = 0; i < 2 * 2400; i++) {
+        frames[i] = 1.0f;
+    }
+
+    // Unity gain leaves the frames untouched.
+    volume_process(&volume, frames, 2400);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, frames[2 * 2400 - 1]);
+
+    // A mute ramps down over 10 ms without a jump, then stays silent.
+    atomic_store(&volume.isMuted, true);
+    volume_process(&volume, frames, 2400);
+
+    for (int f = 1; f < 2400; f++) {
+        TEST_ASSERT_EQUAL_FLOAT(frames[2 * f], frames[2 * f + 1]);
+        TEST_ASSERT_TRUE(frames[2 * f] <= frames[2 * (f - 1)]);
+        TEST_ASSERT_TRUE(frames[2 * (f - 1)] - frames[2 * f] < 1.0f / 400.0f);
+    }
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, frames[2 * 240]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, frames[2 * 480]);
+
+    // A ramp continues across calls of any size, here a non-f32 format.
+    static int16_t pcm[3 * 480];
+    volume_init(&volume, ma_format_s16, 3, 48000);
+    atomic_store(&volume.volume, 0.5f);
+
+    for (int i = 0; i < 3 * 480; i++) {
+        pcm[i] = 16384;
+    }
+
+    volume_process(&volume, pcm, 480);
+    TEST_ASSERT_INT16_WITHIN(1, 8192, pcm[0]);
+    TEST_ASSERT_INT16_WITHIN(1, 8192, pcm[3 * 480 - 1]);
+
+    atomic_store(&volume.volume, 1.0f);
+
+    for (int done = 0; done < 480; done += 7) {
+        int frames = 480 - done < 7 ? 480 - done : 7;
+        for (int i = 0; i < 3 * frames; i++) {
+            pcm[3 * done + i] = 16384;
+        }
+        volume_process(&volume, pcm + 3 * done, (uint32_t)frames);
+    }
+
+    TEST_ASSERT_INT16_WITHIN(2, 8192, pcm[0]);
+    TEST_ASSERT_INT16_WITHIN(20, 12288, pcm[3 * 240]);
+    TEST_ASSERT_INT16_WITHIN(20, 16384, pcm[3 * 479 + 2]);
+}
+
+void test_playback_device_volume_and_mute(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_f32,
+        .rbMaxThreshold = 4800 * 4,
+        .rbMinThreshold = 480 * 4,
+        .rbSizeInBytes = 48000 * 4,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_NOT_NULL(pDevice);
+
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, playback_device_get_volume(pDevice));
+    TEST_ASSERT_FALSE(playback_device_set_volume(pDevice, -0.5f));
+    TEST_ASSERT_FALSE(playback_device_set_volume(pDevice, PLAYBACK_VOLUME_MAX * 2.0f));
+    TEST_ASSERT_TRUE(playback_device_set_metering_enabled(pDevice, true));
+
+    void *pWaveform = waveform_create(pcm_format_f32, 1, 48000, waveform_type_square, 0.5, 440.0);
+    TEST_ASSERT_TRUE(playback_device_attach_source(pDevice, pWaveform));
+
+    // Muted before the start, the device never outputs a frame.
+    playback_device_set_muted(pDevice, true);
+    TEST_ASSERT_TRUE(playback_device_is_muted(pDevice));
+
+    playback_device_start(pDevice);
+    usleep(200000);
+
+    playback_meter_t levels;
+    TEST_ASSERT_TRUE(playback_device_get_meter(pDevice, &levels));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, levels.peak[0]);
+    TEST_ASSERT_TRUE(levels.framesMetered > 0);
+
+    TEST_ASSERT_TRUE(playback_device_set_volume(pDevice, 0.25f));
+    playback_device_set_muted(pDevice, false);
+    usleep(200000);
+
+    TEST_ASSERT_TRUE(playback_device_get_meter(pDevice, &levels));
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 0.125f, levels.peak[0]);
+
+    TEST_ASSERT_TRUE(playback_device_set_volume(pDevice, 1.0f));
+    usleep(200000);
+
+    TEST_ASSERT_TRUE(playback_device_get_meter(pDevice, &levels));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, levels.peak[0]);
+    TEST_ASSERT_EQUAL(device_state_started, playback_device_get_state(pDevice));
+
+    playback_device_stop(pDevice);
+    playback_device_detach_source(pDevice);
+    waveform_destroy(pWaveform);
+
+    playback_device_destroy(pDevice);
+    audio_context_destroy(pContext);
+}
+
+void test_reference_tap_wraps_and_drops(void) {
+    reference_tap_t *pTap = reference_tap_create(ma_format_f32, 1, 1000);
+    TEST_ASSERT_NOT_NULL(pTap);
+
+    float frames[333];
+    playback_reference_block_t block;
+    uint64_t expected = 0;
+
+    TEST_ASSERT_NULL(reference_tap_acquire(pTap, &block));
+
+    // Odd block sizes move the end of the ring around every lap.
+    for (int lap = 0; lap < 50; lap++) {
+        uint32_t count = 1 + (uint32_t)(lap * 37) % 333;
+
+        for (uint32_t i = 0; i < count; i++) {
+            frames[i] = (float)(expected + i);
+        }
+
+        reference_tap_write(pTap, frames, count, 1000 * lap, 480, 48000);
+
+        const float *pFrames = reference_tap_acquire(pTap, &block);
+        TEST_ASSERT_NOT_NULL(pFrames);
+        TEST_ASSERT_EQUAL_PTR(pFrames, reference_tap_acquire(pTap, &block));
+        TEST_ASSERT_EQUAL_UINT64(expected, block.framePosition);
+        TEST_ASSERT_EQUAL_UINT32(count, block.frameCount);
+        TEST_ASSERT_EQUAL_UINT32(0, block.droppedFrames);
+        TEST_ASSERT_EQUAL_UINT64(1000 * lap + 10000000, block.presentationNs);
+        TEST_ASSERT_EQUAL_FLOAT((float)expected, pFrames[0]);
+        TEST_ASSERT_EQUAL_FLOAT((float)(expected + count - 1), pFrames[count - 1]);
+
+        reference_tap_release(pTap);
+        expected += count;
+    }
+
+    TEST_ASSERT_NULL(reference_tap_acquire(pTap, &block));
+
+    // A consumer that falls behind loses whole blocks, and learns how many.
+    uint32_t written = 0;
+    for (int i = 0; i < 20; i++) {
+        reference_tap_write(pTap, frames, 100, 0, 0, 48000);
+    }
+
+    while (reference_tap_acquire(pTap, &block)) {
+        written += block.frameCount;
+        reference_tap_release(pTap);
+    }
+
+    TEST_ASSERT_TRUE(written >= 1000 && written < 2000);
+    TEST_ASSERT_EQUAL_UINT32(2000 - written, atomic_load(&pTap->droppedFrames));
+
+    reference_tap_write(pTap, frames, 100, 0, 0, 48000);
+    TEST_ASSERT_NOT_NULL(reference_tap_acquire(pTap, &block));
+    TEST_ASSERT_EQUAL_UINT64(expected + 2000, block.framePosition);
+    TEST_ASSERT_EQUAL_UINT32(2000 - written, block.droppedFrames);
+    reference_tap_release(pTap);
+
+    reference_tap_destroy(pTap);
+}
+
+void test_playback_device_reference_tap(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 2,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_f32,
+        .rbMaxThreshold = 4800 * 8,
+        .rbMinThreshold = 480 * 8,
+        .rbSizeInBytes = 48000 * 8,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_NOT_NULL(pDevice);
+
+    playback_reference_block_t block;
+    TEST_ASSERT_NULL(playback_device_acquire_reference(pDevice, &block));
+    TEST_ASSERT_TRUE(playback_device_set_reference_tap(pDevice, 48000));
+    TEST_ASSERT_TRUE(playback_device_set_volume(pDevice, 0.5f));
+
+    void *pWaveform = waveform_create(pcm_format_f32, 2, 48000, waveform_type_square, 0.5, 440.0);
+    TEST_ASSERT_TRUE(playback_device_attach_source(pDevice, pWaveform));
+
+    playback_device_start(pDevice);
+    usleep(200000);
+    playback_device_stop(pDevice);
+
+    // The blocks are contiguous, in time order, and hold the output after
+    // the volume.
+    uint64_t position = 0;
+    uint64_t previousNs = 0;
+    int blocks = 0;
+    const float *pFrames;
+
+    while ((pFrames = playback_device_acquire_reference(pDevice, &block))) {
+        TEST_ASSERT_EQUAL_UINT64(position, block.framePosition);
+        TEST_ASSERT_EQUAL_UINT32(0, block.droppedFrames);
+        TEST_ASSERT_TRUE(block.timestampNs >= previousNs);
+        TEST_ASSERT_EQUAL_UINT64(block.timestampNs + (uint64_t)block.latencyFrames * 1000000000ull / 48000,
+                                 block.presentationNs);
+
+        for (uint32_t i = 0; i < block.frameCount * 2; i++) {
+            TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.25f, fabsf(pFrames[i]));
+        }
+
+        position += block.frameCount;
+        previousNs = block.timestampNs;
+        blocks++;
+
+        playback_device_release_reference(pDevice);
+    }
+
+    TEST_ASSERT_TRUE(blocks > 1);
+    TEST_ASSERT_TRUE(position >= 4800);
+
+    TEST_ASSERT_TRUE(playback_device_set_reference_tap(pDevice, 0));
+    TEST_ASSERT_NULL(playback_device_acquire_reference(pDevice, &block));
+
+    playback_device_detach_source(pDevice);
+    waveform_destroy(pWaveform);
+
+    playback_device_destroy(pDevice);
+    audio_context_destroy(pContext);
+}
+
+void test_silence_detector_hold_and_floor(void) {
+    playback_silence_config_t config = {.thresholdDb = -50.0f, .holdMs = 100};
+    silence_detector_t *pDetector = silence_detector_create(ma_format_s16, 1, 48000, &config);
+    TEST_ASSERT_NOT_NULL(pDetector);
+
+    int16_t loud[480];
+    int16_t quiet[480] = {0};
+
+    for (int i = 0; i < 480; i++) {
+        loud[i] = (int16_t)(16384.0 * sin(2.0 * M_PI * 1000.0 * i / 48000.0));
+    }
+
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_FALSE(silence_detector_process(pDetector, loud, 480));
+    }
+
+    // The hold keeps the first 100 ms of quiet from counting as silence.
+    for (int i = 0; i < 9; i++) {
+        TEST_ASSERT_FALSE(silence_detector_process(pDetector, quiet, 480));
+    }
+
+    for (int i = 0; i < 11; i++) {
+        TEST_ASSERT_TRUE(silence_detector_process(pDetector, quiet, 480));
+    }
+
+    TEST_ASSERT_FALSE(silence_detector_process(pDetector, loud, 480));
+
+    playback_silence_stats_t stats;
+    silence_detector_read(pDetector, &stats);
+    TEST_ASSERT_FALSE(stats.isSilent);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, -6.02f, stats.levelDb);
+    TEST_ASSERT_EQUAL_UINT64(31 * 480, stats.totalFrames);
+    TEST_ASSERT_EQUAL_UINT64(11 * 480, stats.silentFrames);
+
+    silence_detector_destroy(pDetector);
+
+    // With a margin, steady noise well above the threshold counts as silence
+    // once the floor found it, while speech-like bursts do not.
+    config = (playback_silence_config_t){.thresholdDb = -90.0f, .noiseFloorMarginDb = 12.0f};
+    pDetector = silence_detector_create(ma_format_f32, 2, 48000, &config);
+    TEST_ASSERT_NOT_NULL(pDetector);
+
+    float noise[2 * 480];
+    float burst[2 * 480];
+    uint32_t seed = 1;
+
+    for (int i = 0; i < 2 * 480; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        noise[i] = 0.01f * ((float)(seed >> 8) / (float)(1u << 24) * 2.0f - 1.0f);
+        burst[i] = noise[i] + 0.5f * sinf(2.0f * (float)M_PI * 300.0f * (float)(i / 2) / 48000.0f);
+    }
+
+    TEST_ASSERT_TRUE(silence_detector_process(pDetector, noise, 480));
+    TEST_ASSERT_FALSE(silence_detector_process(pDetector, burst, 480));
+    TEST_ASSERT_TRUE(silence_detector_process(pDetector, noise, 480));
+
+    silence_detector_read(pDetector, &stats);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, -44.8f, stats.noiseFloorDb);
+
+    silence_detector_destroy(pDetector);
+}
+
+void test_playback_device_silence_gaps(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    encoder_config_t encoderConfig = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_f32,
+    };
+
+    void *pEncoder = encoder_create_memory(&encoderConfig, 0);
+    TEST_ASSERT_NOT_NULL(pEncoder);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_f32,
+        .rbMaxThreshold = 4800 * 4,
+        .rbMinThreshold = 480 * 4,
+        .rbSizeInBytes = 48000 * 4,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, pEncoder);
+    TEST_ASSERT_NOT_NULL(pDevice);
+
+    playback_silence_stats_t stats;
+    TEST_ASSERT_FALSE(playback_device_get_silence_stats(pDevice, &stats));
+
+    playback_silence_config_t silenceConfig = {.holdMs = 50, .skipProcessing = true, .compactRecording = true};
+    TEST_ASSERT_TRUE(playback_device_set_silence_detection(pDevice, &silenceConfig));
+
+    void *pWaveform = waveform_create(pcm_format_f32, 1, 48000, waveform_type_sine, 0.5, 440.0);
+    TEST_ASSERT_TRUE(playback_device_attach_source(pDevice, pWaveform));
+
+    playback_device_start(pDevice);
+    usleep(200000);
+
+    // Without data the device outputs silence, which is left out of the file.
+    playback_device_detach_source(pDevice);
+    usleep(300000);
+    playback_device_stop(pDevice);
+
+    TEST_ASSERT_TRUE(playback_device_get_silence_stats(pDevice, &stats));
+    TEST_ASSERT_TRUE(stats.isSilent);
+    TEST_ASSERT_EQUAL_FLOAT(-INFINITY, stats.levelDb);
+    TEST_ASSERT_TRUE(stats.silentFrames > 0 && stats.silentFrames < stats.totalFrames);
+
+    encoder_gap_t gap;
+    TEST_ASSERT_EQUAL_UINT32(1, encoder_get_gaps(pEncoder, &gap, 1));
+    TEST_ASSERT_EQUAL_UINT64(stats.silentFrames, gap.frameCount);
+    TEST_ASSERT_EQUAL_UINT64(stats.totalFrames - stats.silentFrames, gap.position);
+
+    TEST_ASSERT_TRUE(playback_device_set_silence_detection(pDevice, NULL));
+    TEST_ASSERT_FALSE(playback_device_get_silence_stats(pDevice, &stats));
+
+    waveform_destroy(pWaveform);
+    playback_device_destroy(pDevice);
+    encoder_destroy(pEncoder);
+    audio_context_destroy(pContext);
+}
+
+void test_playback_group_push_and_outputs(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_group_config_t config = {
+        .pcmFormat = pcm_format_u8,
+        .channels = 1,
+        .sampleRate = 48000,
+        .capacityFrames = 4800,
+        .targetLatencyFrames = 960,
+    };
+
+    TEST_ASSERT_NULL(playback_group_create(pContext, &config));
+
+    config.pcmFormat = pcm_format_s16;
+    void *pGroup = playback_group_create(pContext, &config);
+    TEST_ASSERT_NOT_NULL(pGroup);
+
+    int16_t frames[6000] = {0};
+
+    // Nothing reads a group without outputs, so pushes never wait.
+    TEST_ASSERT_EQUAL_UINT32(4800 * sizeof(int16_t), playback_group_push(pGroup, frames, sizeof(frames)));
+    TEST_ASSERT_EQUAL_UINT32(4800 * sizeof(int16_t), playback_group_push(pGroup, frames, sizeof(frames)));
+
+    TEST_ASSERT_EQUAL_INT32(0, playback_group_add_output(pGroup, NULL));
+    TEST_ASSERT_EQUAL_INT32(1, playback_group_add_output(pGroup, NULL));
+    TEST_ASSERT_EQUAL_UINT32(2, playback_group_get_output_count(pGroup));
+
+    // The outputs are stopped, so the ring fills up and holds the writer.
+    TEST_ASSERT_EQUAL_UINT32(4800 * sizeof(int16_t), playback_group_push(pGroup, frames, sizeof(frames)));
+    TEST_ASSERT_EQUAL_UINT32(0, playback_group_push(pGroup, frames, sizeof(frames)));
+
+    playback_group_output_stats_t stats;
+    TEST_ASSERT_TRUE(playback_group_get_output_stats(pGroup, 1, &stats));
+    TEST_ASSERT_EQUAL_UINT64(0, stats.framesPlayed);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, stats.ratio);
+    TEST_ASSERT_FALSE(playback_group_get_output_stats(pGroup, 2, &stats));
+
+    playback_group_start(pGroup);
+    TEST_ASSERT_EQUAL_INT(device_state_started, playback_group_get_state(pGroup));
+    TEST_ASSERT_EQUAL_INT32(-1, playback_group_add_output(pGroup, NULL));
+
+    // The outputs drain the ring, which makes room for the writer again.
+    usleep(200000);
+    TEST_ASSERT_TRUE(playback_group_push(pGroup, frames, sizeof(frames)) > 0);
+
+    playback_group_stop(pGroup);
+    TEST_ASSERT_EQUAL_INT(device_state_stopped, playback_group_get_state(pGroup));
+
+    // The context destroys the group it still holds.
+    audio_context_destroy(pContext);
+}
+
+static uint64_t _elapsed_frames(const struct timespec *pStart, uint32_t sampleRate) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    double seconds = (double)(now.tv_sec - pStart->tv_sec) + (now.tv_nsec - pStart->tv_nsec) / 1e9;
+
+    return (uint64_t)(seconds * sampleRate);
+}
+
+void test_playback_group_keeps_outputs_in_sync(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_group_config_t config = {
+        .pcmFormat = pcm_format_f32,
+        .channels = 1,
+        .sampleRate = 48000,
+    };
+
+    void *pGroup = playback_group_create(pContext, &config);
+    TEST_ASSERT_NOT_NULL(pGroup);
+
+    TEST_ASSERT_EQUAL_INT32(0, playback_group_add_output(pGroup, NULL));
+    TEST_ASSERT_EQUAL_INT32(1, playback_group_add_output(pGroup, NULL));
+
+    // Feeds a sine in real time, ahead of the clock by the default target.
+    float frames[480];
+    uint64_t pushed = 0;
+    struct timespec start;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    playback_group_start(pGroup);
+
+    while (pushed < 48000) {
+        uint64_t due = _elapsed_frames(&start, 48000) + 2400;
+
+        while (pushed < due) {
+            for (int i = 0; i < 480; i++) {
+                frames[i] = 0.5f * sinf(2.0f * (float)M_PI * 440.0f * (float)(pushed + i) / 48000.0f);
+            }
+
+            uint32_t written = playback_group_push(pGroup, frames, sizeof(frames));
+            pushed += written / sizeof(float);
+
+            if (written < sizeof(frames)) {
+                break;
+            }
+        }
+
+        usleep(5000);
+    }
+
+    playback_group_stop(pGroup);
+
+    for (uint32_t i = 0; i < 2; i++) {
+        playback_group_output_stats_t stats;
+        TEST_ASSERT_TRUE(playback_group_get_output_stats(pGroup, i, &stats));
+
+        TEST_ASSERT_TRUE(stats.framesPlayed > 24000);
+        TEST_ASSERT_TRUE(stats.queuedFrames <= 48000);
+        TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f, stats.ratio);
+        TEST_ASSERT_FLOAT_WITHIN(480.0f, 0.0f, stats.offsetFrames);
+    }
+
+    playback_group_destroy(pGroup);
+    audio_context_destroy(pContext);
+}
+
+void test_playback_device_migrate_keeps_buffer(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_s16,
+        .rbMaxThreshold = 4800 * 2,
+        .rbMinThreshold = 480 * 2,
+        .rbSizeInBytes = 48000 * 2,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_NOT_NULL(pDevice);
+
+    // Reading starts with the push that finds the ring above the threshold.
+    int16_t frames[12000] = {0};
+    playback_data_t data = {.pUserData = frames, .sizeInBytes = sizeof(frames)};
+    playback_device_push_buffer(pDevice, &data);
+    playback_device_push_buffer(pDevice, &data);
+
+    // A stopped device moves with every queued byte and stays stopped.
+    playback_migration_t migration;
+    TEST_ASSERT_TRUE(playback_device_migrate(pDevice, NULL, &migration));
+    TEST_ASSERT_EQUAL_UINT32(2 * sizeof(frames), migration.bufferedBytes);
+    TEST_ASSERT_EQUAL_INT(device_state_stopped, playback_device_get_state(pDevice));
+
+    playback_device_start(pDevice);
+    usleep(100000);
+
+    // A started device resumes on the new device where the old one stopped.
+    TEST_ASSERT_TRUE(playback_device_migrate(pDevice, NULL, &migration));
+    TEST_ASSERT_TRUE(migration.bufferedBytes > 0 && migration.bufferedBytes < 2 * sizeof(frames));
+    TEST_ASSERT_TRUE(migration.switchNs < 500000000ull);
+    TEST_ASSERT_EQUAL_INT(device_state_started, playback_device_get_state(pDevice));
+
+    uint32_t bufferedBytes = migration.bufferedBytes;
+    usleep(100000);
+
+    // The new device kept consuming the same ring buffer.
+    playback_device_stop(pDevice);
+    TEST_ASSERT_TRUE(playback_device_migrate(pDevice, NULL, &migration));
+    TEST_ASSERT_TRUE(migration.bufferedBytes < bufferedBytes);
+
+    playback_device_destroy(pDevice);
+    audio_context_destroy(pContext);
+}
+
+// Returns the first non-zero sample the reference tap of an s16 device
+// holds, 0 if all of it is silent, and releases every block read.
+static int16_t _first_audible_sample(void *pDevice) {
+    playback_reference_block_t block;
+    const int16_t *pFrames;
+    int16_t sample = 0;
+
+    while ((pFrames = playback_device_acquire_reference(pDevice, &block)) != NULL) {
+        for (uint32_t i = 0; i < block.frameCount && sample == 0; i++) {
+            sample = pFrames[i];
+        }
+
+        playback_device_release_reference(pDevice);
+    }
+
+    return sample;
+}
+
+// Plays `first`, interrupts, pushes a second of `second` and ends the
+// interruption. Returns the first sample heard after the end.
+static int16_t _play_through_interruption(void *pDevice, int16_t first, int16_t second) {
+    static int16_t frames[48000];
+    playback_data_t data = {.pUserData = frames, .sizeInBytes = 12000 * sizeof(int16_t)};
+
+    for (int i = 0; i < 48000; i++) {
+        frames[i] = first;
+    }
+
+    playback_device_push_buffer(pDevice, &data);
+    playback_device_push_buffer(pDevice, &data);
+
+    playback_device_start(pDevice);
+    usleep(100000);
+
+    playback_device_begin_interruption(pDevice);
+    usleep(50000);
+    _first_audible_sample(pDevice);
+
+    for (int i = 0; i < 48000; i++) {
+        frames[i] = second;
+    }
+
+    data.sizeInBytes = sizeof(frames);
+    playback_device_push_buffer(pDevice, &data);
+
+    // Nothing is consumed while interrupted.
+    usleep(100000);
+    TEST_ASSERT_EQUAL_INT16(0, _first_audible_sample(pDevice));
+
+    playback_device_end_interruption(pDevice);
+    usleep(100000);
+
+    return _first_audible_sample(pDevice);
+}
+
+void test_playback_device_interruption_resumes_paused(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_s16,
+        .rbMaxThreshold = 4800 * 2,
+        .rbMinThreshold = 480 * 2,
+        .rbSizeInBytes = 48000 * 2,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_NOT_NULL(pDevice);
+    TEST_ASSERT_TRUE(playback_device_set_reference_tap(pDevice, 48000));
+
+    playback_interruption_policy_t policy = {.mode = playback_interruption_resume_paused, .backpressure = true};
+    TEST_ASSERT_TRUE(playback_device_set_interruption_policy(pDevice, &policy));
+
+    // Backpressure kept the frames queued before the interruption.
+    TEST_ASSERT_EQUAL_INT16(1000, _play_through_interruption(pDevice, 1000, 2000));
+
+    playback_interruption_stats_t stats;
+    TEST_ASSERT_TRUE(playback_device_get_interruption_stats(pDevice, &stats));
+    TEST_ASSERT_FALSE(stats.isInterrupted);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.interruptionCount);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.droppedBytes);
+    TEST_ASSERT_TRUE(stats.resumeLatencyNs > 0 && stats.resumeLatencyNs < 1000000000ull);
+
+    playback_device_stop(pDevice);
+    playback_device_destroy(pDevice);
+    audio_context_destroy(pContext);
+}
+
+void test_playback_device_push_buffer_reports_backpressure(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_s16,
+        .rbMaxThreshold = 4800 * 2,
+        .rbMinThreshold = 480 * 2,
+        .rbSizeInBytes = 4800 * 2 * 2,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_NOT_NULL(pDevice);
+
+    static int16_t samples[7200];
+    playback_data_t data = {.pUserData = samples, .sizeInBytes = sizeof(samples)};
+
+    // Without backpressure the oldest frames make room for the whole push.
+    TEST_ASSERT_EQUAL_UINT32(sizeof(samples), playback_device_push_buffer(pDevice, &data));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(samples), playback_device_push_buffer(pDevice, &data));
+
+    playback_device_reset_buffer(pDevice);
+
+    playback_interruption_policy_t policy = {.mode = playback_interruption_resume_paused, .backpressure = true};
+    TEST_ASSERT_TRUE(playback_device_set_interruption_policy(pDevice, &policy));
+    playback_device_pause(pDevice);
+
+    // Frozen with backpressure: the second push only fills the free space.
+    TEST_ASSERT_EQUAL_UINT32(sizeof(samples), playback_device_push_buffer(pDevice, &data));
+    TEST_ASSERT_EQUAL_UINT32(config.rbSizeInBytes - sizeof(samples), playback_device_push_buffer(pDevice, &data));
+    TEST_ASSERT_EQUAL_UINT32(0, playback_device_push_buffer(pDevice, &data));
+
+    playback_device_destroy(pDevice);
+    audio_context_destroy(pContext);
+}
+
+void test_playback_device_interruption_resumes_latest(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_s16,
+        .rbMaxThreshold = 4800 * 2,
+        .rbMinThreshold = 480 * 2,
+        .rbSizeInBytes = 48000 * 2,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_NOT_NULL(pDevice);
+    TEST_ASSERT_TRUE(playback_device_set_reference_tap(pDevice, 48000));
+
+    playback_interruption_policy_t policy = {.mode = playback_interruption_resume_latest};
+    TEST_ASSERT_TRUE(playback_device_set_interruption_policy(pDevice, &policy));
+
+    TEST_ASSERT_EQUAL_INT16(2000, _play_through_interruption(pDevice, 1000, 2000));
+
+    playback_interruption_stats_t stats;
+    TEST_ASSERT_TRUE(playback_device_get_interruption_stats(pDevice, &stats));
+    TEST_ASSERT_TRUE(stats.droppedBytes > 0);
+    TEST_ASSERT_TRUE(stats.resumeLatencyNs > 0 && stats.resumeLatencyNs < 1000000000ull);
+
+    playback_device_stop(pDevice);
+    playback_device_destroy(pDevice);
+    audio_context_destroy(pContext);
+}
+
+// Drains the reference tap and returns the last non-zero sample, 0 if none.
+static int16_t _last_audible_sample(void *pDevice) {
+    playback_reference_block_t block;
+    const int16_t *pFrames;
+    int16_t sample = 0;
+
+    while ((pFrames = playback_device_acquire_reference(pDevice, &block)) != NULL) {
+        for (uint32_t i = 0; i < block.frameCount; i++) {
+            if (pFrames[i] != 0) {
+                sample = pFrames[i];
+            }
+        }
+
+        playback_device_release_reference(pDevice);
+    }
+
+    return sample;
+}
+
+void test_playback_device_pause_resumes_at_next_frame(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_s16,
+        .rbSizeInBytes = 48000 * 2,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_NOT_NULL(pDevice);
+    TEST_ASSERT_TRUE(playback_device_set_reference_tap(pDevice, 48000));
+
+    // Each sample holds its position in the stream, starting at 1.
+    static int16_t frames[24000];
+    for (int i = 0; i < 24000; i++) {
+        frames[i] = (int16_t)(i + 1);
+    }
+
+    playback_data_t data = {.pUserData = frames, .sizeInBytes = sizeof(frames)};
+    playback_device_push_buffer(pDevice, &data);
+
+    playback_device_start(pDevice);
+    usleep(50000);
+
+    playback_device_pause(pDevice);
+    TEST_ASSERT_TRUE(playback_device_is_paused(pDevice));
+
+    int16_t last = _last_audible_sample(pDevice);
+    TEST_ASSERT_TRUE(last > 0);
+
+    // The stream stays open and outputs silence.
+    usleep(100000);
+    TEST_ASSERT_EQUAL(device_state_started, playback_device_get_state(pDevice));
+    TEST_ASSERT_EQUAL_INT16(0, _first_audible_sample(pDevice));
+
+    playback_device_resume(pDevice);
+    TEST_ASSERT_FALSE(playback_device_is_paused(pDevice));
+
+    int16_t sample = 0;
+    for (int i = 0; i < 200 && sample == 0; i++) {
+        usleep(1000);
+        sample = _first_audible_sample(pDevice);
+    }
+
+    TEST_ASSERT_EQUAL_INT16(last + 1, sample);
+
+    playback_device_stop(pDevice);
+    playback_device_destroy(pDevice);
+    audio_context_destroy(pContext);
+}
+
+void test_playback_device_pause_survives_stop(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_s16,
+        .rbSizeInBytes = 48000 * 2,
+    };
+
+    TEST_ASSERT_EQUAL_UINT32(1, playback_pool_warm(pContext, NULL, &config, 1));
+
+    void *pDevice = playback_pool_acquire(pContext, NULL, &config);
+    TEST_ASSERT_NOT_NULL(pDevice);
+
+    playback_device_pause(pDevice);
+    playback_device_pause(pDevice);
+    playback_device_stop(pDevice);
+    playback_device_start(pDevice);
+    TEST_ASSERT_TRUE(playback_device_is_paused(pDevice));
+
+    // A device goes back to the pool unpaused.
+    TEST_ASSERT_TRUE(playback_pool_release(pDevice));
+    TEST_ASSERT_FALSE(playback_device_is_paused(pDevice));
+
+    TEST_ASSERT_FALSE(playback_device_is_paused(NULL));
+
+    audio_context_destroy(pContext);
+}
+
+// Drains the reference tap and checks that the audible samples count up by
+// one from `*pLast`. Returns false at the first gap or repeat.
+static bool _drain_counting_samples(void *pDevice, int16_t *pLast) {
+    playback_reference_block_t block;
+    const int16_t *pFrames;
+    bool isCounting = true;
+
+    while ((pFrames = playback_device_acquire_reference(pDevice, &block)) != NULL) {
+        for (uint32_t i = 0; i < block.frameCount; i++) {
+            if (pFrames[i] == 0) {
+                continue;
+            }
+
+            isCounting = isCounting && pFrames[i] == *pLast + 1;
+            *pLast = pFrames[i];
+        }
+
+        playback_device_release_reference(pDevice);
+    }
+
+    return isCounting;
+}
+
+void test_playback_device_resize_buffer_while_playing(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_s16,
+        .rbSizeInBytes = 48000 * 2,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_NOT_NULL(pDevice);
+    TEST_ASSERT_TRUE(playback_device_set_reference_tap(pDevice, 48000));
+
+    static int16_t frames[24000];
+    for (int i = 0; i < 24000; i++) {
+        frames[i] = (int16_t)(i + 1);
+    }
+
+    playback_data_t data = {.pUserData = frames, .sizeInBytes = sizeof(frames)};
+    playback_device_push_buffer(pDevice, &data);
+
+    playback_device_start(pDevice);
+    usleep(50000);
+
+    int16_t last = 0;
+    TEST_ASSERT_TRUE(_drain_counting_samples(pDevice, &last));
+
+    // Grow, then shrink below the data queued, while the device plays.
+    TEST_ASSERT_TRUE(playback_device_resize_buffer(pDevice, 96000 * 2));
+    usleep(30000);
+    TEST_ASSERT_TRUE(_drain_counting_samples(pDevice, &last));
+
+    TEST_ASSERT_TRUE(playback_device_resize_buffer(pDevice, 24000 * 2));
+    usleep(50000);
+
+    // Nothing played twice or skipped across the swaps.
+    TEST_ASSERT_TRUE(_drain_counting_samples(pDevice, &last));
+    TEST_ASSERT_TRUE(last > 4800);
+    TEST_ASSERT_EQUAL(device_state_started, playback_device_get_state(pDevice));
+
+    playback_device_stop(pDevice);
+    playback_device_destroy(pDevice);
+    audio_context_destroy(pContext);
+}
+
+void test_playback_device_resize_buffer_keeps_newest(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_s16,
+        .rbMaxThreshold = 480 * 2,
+        .rbSizeInBytes = 48000 * 2,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_NOT_NULL(pDevice);
+    TEST_ASSERT_TRUE(playback_device_set_reference_tap(pDevice, 48000));
+
+    static int16_t frames[24000];
+    for (int i = 0; i < 24000; i++) {
+        frames[i] = (int16_t)(i + 1);
+    }
+
+    // The second push finds `rbMaxThreshold` queued and enables reading.
+    playback_data_t data = {.pUserData = frames, .sizeInBytes = sizeof(frames) / 2};
+    playback_device_push_buffer(pDevice, &data);
+
+    data.pUserData = frames + 12000;
+    playback_device_push_buffer(pDevice, &data);
+
+    TEST_ASSERT_FALSE(playback_device_resize_buffer(NULL, 4800 * 2));
+    TEST_ASSERT_FALSE(playback_device_resize_buffer(pDevice, 240 * 2));
+
+    // A stopped device swaps at once; an odd size is cut to whole frames.
+    TEST_ASSERT_TRUE(playback_device_resize_buffer(pDevice, 4800 * 2 + 1));
+
+    playback_device_start(pDevice);
+
+    int16_t sample = 0;
+    for (int i = 0; i < 200 && sample == 0; i++) {
+        usleep(1000);
+        sample = _first_audible_sample(pDevice);
+    }
+
+    TEST_ASSERT_EQUAL_INT16(24000 - 4800 + 1, sample);
+
+    playback_device_stop(pDevice);
+    playback_device_destroy(pDevice);
+    audio_context_destroy(pContext);
+}
+
+void test_playback_pool_warm_acquire_release(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_s16,
+        .rbMaxThreshold = 4800 * 2,
+        .rbMinThreshold = 480 * 2,
+        .rbSizeInBytes = 48000 * 2,
+    };
+
+    TEST_ASSERT_EQUAL_UINT32(2, playback_pool_warm(pContext, NULL, &config, 2));
+    TEST_ASSERT_EQUAL_UINT32(2, playback_pool_warm(pContext, NULL, &config, 1));
+
+    void *pDevice = playback_pool_acquire(pContext, NULL, &config);
+    TEST_ASSERT_NOT_NULL(pDevice);
+    TEST_ASSERT_EQUAL_INT(device_state_started, playback_device_get_state(pDevice));
+
+    int16_t frames[12000] = {0};
+    playback_data_t data = {.pUserData = frames, .sizeInBytes = sizeof(frames)};
+    playback_device_push_buffer(pDevice, &data);
+
+    // Another key opens a device.
+    playback_config_t stereo = config;
+    stereo.channels = 2;
+    void *pStereo = playback_pool_acquire(pContext, NULL, &stereo);
+    TEST_ASSERT_NOT_NULL(pStereo);
+
+    playback_pool_stats_t stats;
+    TEST_ASSERT_TRUE(playback_pool_get_stats(pContext, &stats));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.idleDevices);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.lentDevices);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.hits);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.misses);
+
+    // Released devices come back running, with an empty ring.
+    TEST_ASSERT_TRUE(playback_pool_release(pDevice));
+    TEST_ASSERT_FALSE(playback_pool_release(pDevice));
+    playback_device_destroy(pStereo);
+
+    TEST_ASSERT_TRUE(playback_pool_get_stats(pContext, &stats));
+    TEST_ASSERT_EQUAL_UINT32(2, stats.idleDevices);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.lentDevices);
+
+    void *pAgain = playback_pool_acquire(pContext, NULL, &config);
+    TEST_ASSERT_EQUAL_INT(device_state_started, playback_device_get_state(pAgain));
+
+    playback_device_stop(pAgain);
+    playback_migration_t migration;
+    TEST_ASSERT_TRUE(playback_device_migrate(pAgain, NULL, &migration));
+    TEST_ASSERT_EQUAL_UINT32(0, migration.bufferedBytes);
+
+    // A device not from the pool cannot join it.
+    void *pOwn = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_FALSE(playback_pool_release(pOwn));
+    playback_device_destroy(pOwn);
+
+    playback_pool_drain(pContext);
+    TEST_ASSERT_TRUE(playback_pool_get_stats(pContext, &stats));
+    TEST_ASSERT_EQUAL_UINT32(0, stats.idleDevices);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.lentDevices);
+
+    // The context destroys the lent device.
+    audio_context_destroy(pContext);
+}
+
+void test_playback_pool_release_resets_the_device(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_s16,
+        .rbMaxThreshold = 4800 * 2,
+        .rbMinThreshold = 480 * 2,
+        .rbSizeInBytes = 48000 * 2,
+    };
+
+    TEST_ASSERT_EQUAL_UINT32(1, playback_pool_warm(pContext, NULL, &config, 1));
+
+    void *pDevice = playback_pool_acquire(pContext, NULL, &config);
+    TEST_ASSERT_NOT_NULL(pDevice);
+
+    spectrum_config_t spectrumConfig = {.fftSize = 1024, .window = spectrum_window_hann};
+    playback_silence_config_t silenceConfig = {.thresholdDb = -50.0f, .holdMs = 100};
+    playback_dsp_stage_t stage = {.type = playback_dsp_gain, .gainDb = -6.0};
+
+    TEST_ASSERT_TRUE(playback_device_set_volume(pDevice, 0.5f));
+    playback_device_set_muted(pDevice, true);
+    TEST_ASSERT_TRUE(playback_device_set_spectrum(pDevice, &spectrumConfig));
+    TEST_ASSERT_TRUE(playback_device_set_reference_tap(pDevice, 4800));
+    TEST_ASSERT_TRUE(playback_device_set_silence_detection(pDevice, &silenceConfig));
+    TEST_ASSERT_TRUE(playback_device_set_dsp_chain(pDevice, &stage, 1));
+    TEST_ASSERT_TRUE(playback_device_set_metering_enabled(pDevice, true));
+    usleep(50000);
+
+    TEST_ASSERT_TRUE(playback_pool_release(pDevice));
+
+    // The next holder gets the same device without the stages of the last one.
+    void *pAgain = playback_pool_acquire(pContext, NULL, &config);
+    TEST_ASSERT_EQUAL_PTR(pDevice, pAgain);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, playback_device_get_volume(pAgain));
+    TEST_ASSERT_FALSE(playback_device_is_muted(pAgain));
+
+    float bins[512];
+    uint64_t sequence = 1;
+    TEST_ASSERT_EQUAL_UINT32(0, playback_device_get_spectrum(pAgain, bins, 512, &sequence));
+    TEST_ASSERT_EQUAL_UINT64(0, sequence);
+
+    playback_reference_block_t block;
+    TEST_ASSERT_NULL(playback_device_acquire_reference(pAgain, &block));
+
+    playback_silence_stats_t silenceStats;
+    TEST_ASSERT_FALSE(playback_device_get_silence_stats(pAgain, &silenceStats));
+
+    playback_meter_t meter;
+    TEST_ASSERT_FALSE(playback_device_get_meter(pAgain, &meter));
+
+    playback_dsp_stage_t update = stage;
+    TEST_ASSERT_FALSE(playback_device_update_dsp_stage(pAgain, 0, &update));
+
+    playback_device_destroy(pAgain);
+    audio_context_destroy(pContext);
+}
+
+void test_playback_pool_device_is_audible_within_a_period(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_s16,
+        .rbMaxThreshold = 0,
+        .rbMinThreshold = 0,
+        .rbSizeInBytes = 48000 * 2,
+    };
+
+    TEST_ASSERT_EQUAL_UINT32(1, playback_pool_warm(pContext, NULL, &config, 1));
+
+    void *pDevice = playback_pool_acquire(pContext, NULL, &config);
+    TEST_ASSERT_NOT_NULL(pDevice);
+    TEST_ASSERT_TRUE(playback_device_set_reference_tap(pDevice, 48000));
+
+    // The warm device outputs silence while idle.
+    usleep(50000);
+    TEST_ASSERT_EQUAL_INT16(0, _first_audible_sample(pDevice));
+
+    int16_t frames[4800];
+    for (int i = 0; i < 4800; i++) {
+        frames[i] = 1000;
+    }
+
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    playback_data_t data = {.pUserData = frames, .sizeInBytes = sizeof(frames)};
+    playback_device_push_buffer(pDevice, &data);
+
+    int16_t sample = 0;
+    for (int i = 0; i < 200 && sample == 0; i++) {
+        usleep(1000);
+        sample = _first_audible_sample(pDevice);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double elapsedMs = (now.tv_sec - start.tv_sec) * 1e3 + (now.tv_nsec - start.tv_nsec) / 1e6;
+
+    // The null backend runs 10 ms periods.
+    TEST_ASSERT_EQUAL_INT16(1000, sample);
+    TEST_ASSERT_TRUE(elapsedMs < 30.0);
+
+    TEST_ASSERT_TRUE(playback_pool_release(pDevice));
+    audio_context_destroy(pContext);
+}
+
+// Waits until the analyzer published `count` spectra.
+static uint32_t _wait_for_spectrum(spectrum_t *pSpectrum, float *pBins, uint32_t binCount, uint64_t count) {
+    uint64_t sequence = 0;
+    uint32_t copied = 0;
+
+    for (int i = 0; i < 200 && sequence < count; i++) {
+        usleep(5000);
+        copied = spectrum_read(pSpectrum, pBins, binCount, &sequence);
+    }
+
+    TEST_ASSERT_TRUE(sequence >= count);
+
+    return copied;
+}
+
+void test_spectrum_sine_bins(void) {
+    // 1500 Hz is exactly bin 32 of a 1024-point FFT at 48 kHz.
+    spectrum_config_t config = {.fftSize = 1024, .window = spectrum_window_hann};
+    spectrum_t *pSpectrum = spectrum_create(ma_format_s16, 2, 48000, &config);
+    TEST_ASSERT_NOT_NULL(pSpectrum);
+    TEST_ASSERT_EQUAL_UINT32(512, pSpectrum->config.hopSize);
+
+    static int16_t frames[2048 * 2];
+    for (int f = 0; f < 2048; f++) {
+        int16_t x = (int16_t)lrintf(16384.0f * sinf(2.0f * (float)M_PI * 1500.0f * f / 48000.0f));
+        frames[f * 2] = x;
+        frames[f * 2 + 1] = x;
+    }
+
+    spectrum_write(pSpectrum, frames, 2048);
+
+    static float bins[513];
+    TEST_ASSERT_EQUAL_UINT32(513, _wait_for_spectrum(pSpectrum, bins, 513, 3));
+
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 0.5f, bins[32]);
+
+    // Hann leakage stays within the neighbouring bins.
+    for (int k = 0; k < 513; k++) {
+        if (k < 30 || k > 34) {
+            TEST_ASSERT_TRUE(bins[k] < 0.001f);
+        }
+    }
+
+    spectrum_destroy(pSpectrum);
+
+    spectrum_config_t invalid = {.fftSize = 1000};
+    TEST_ASSERT_NULL(spectrum_create(ma_format_f32, 1, 48000, &invalid));
+}
+
+void test_playback_device_spectrum(void) {
+    void *pContext = audio_context_create();
+    TEST_ASSERT_NOT_NULL(pContext);
+
+    playback_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_f32,
+        .rbMaxThreshold = 4800 * 4,
+        .rbMinThreshold = 480 * 4,
+        .rbSizeInBytes = 48000 * 4,
+    };
+
+    void *pDevice = playback_device_create(pContext, NULL, &config, NULL);
+    TEST_ASSERT_NOT_NULL(pDevice);
+
+    spectrum_config_t spectrumConfig = {.fftSize = 2048, .window = spectrum_window_blackman_harris};
+    TEST_ASSERT_TRUE(playback_device_set_spectrum(pDevice, &spectrumConfig));
+
+    // 3000 Hz is bin 128 of a 2048-point FFT at 48 kHz.
+    void *pWaveform = waveform_create(pcm_format_f32, 1, 48000, waveform_type_sine, 0.5, 3000.0);
+    TEST_ASSERT_TRUE(playback_device_attach_source(pDevice, pWaveform));
+
+    playback_device_start(pDevice);
+    usleep(300000);
+
+    static float bins[1025];
+    uint64_t sequence = 0;
+    TEST_ASSERT_EQUAL_UINT32(1025, playback_device_get_spectrum(pDevice, bins, 1025, &sequence));
+    TEST_ASSERT_TRUE(sequence > 0);
+
+    int loudest = 0;
+    for (int k = 1; k < 1025; k++) {
+        loudest = bins[k] > bins[loudest] ? k : loudest;
+    }
+
+    TEST_ASSERT_EQUAL_INT(128, loudest);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, bins[128]);
+
+    TEST_ASSERT_TRUE(playback_device_set_spectrum(pDevice, NULL));
+    TEST_ASSERT_EQUAL_UINT32(0, playback_device_get_spectrum(pDevice, bins, 1025, NULL));
+
+    playback_device_stop(pDevice);
+    playback_device_detach_source(pDevice);
+    waveform_destroy(pWaveform);
+
+    playback_device_destroy(pDevice);
+    audio_context_destroy(pContext);
+}
+
+// Writes a mono s16 WAV whose sample at frame `i` is `i % 30000`.
+static void _write_ramp_wav(const char *path, uint32_t frames) {
+    encoder_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_s16,
+    };
+
+    void *pEncoder = encoder_create(path, &config);
+    TEST_ASSERT_NOT_NULL(pEncoder);
+
+    int16_t chunk[1000];
+    for (uint32_t f = 0; f < frames; f += 1000) {
+        for (uint32_t i = 0; i < 1000; i++) {
+            chunk[i] = (int16_t)((f + i) % 30000);
+        }
+
+        TEST_ASSERT_EQUAL_UINT64(1000, encoder_write_pcm_frames(pEncoder, chunk, 1000));
+    }
+
+    encoder_destroy(pEncoder);
+}
+
+// Reads `frameCount` frames, waiting for the read-ahead thread when needed.
+static uint64_t _read_decoder(void *pDecoder, int16_t *pOut, uint64_t frameCount) {
+    uint64_t total = 0;
+
+    for (int attempt = 0; attempt < 1000 && total < frameCount; attempt++) {
+        uint64_t framesRead = 0;
+        decoder_read_pcm_frames_with_buffer(pDecoder, pOut + total, frameCount - total, &framesRead);
+        total += framesRead;
+
+        if (decoder_is_at_end(pDecoder)) {
+            break;
+        }
+
+        if (total < frameCount) {
+            usleep(1000);
+        }
+    }
+
+    return total;
+}
+
+void test_decoder_streams_and_seeks(void) {
+    const char *path = "test/build/decoder_ramp.wav";
+    const uint32_t frames = 48000;
+    _write_ramp_wav(path, frames);
+
+    decoder_config_t config = {
+        .pcmFormat = pcm_format_s16,
+        .channels = 1,
+        .sampleRate = 48000,
+        .lookaheadFrames = 4096,
+    };
+
+    void *pDecoder = decoder_create(path, &config);
+    TEST_ASSERT_NOT_NULL(pDecoder);
+    TEST_ASSERT_EQUAL_UINT64(frames, decoder_get_length(pDecoder));
+
+    int16_t out[10000];
+    TEST_ASSERT_EQUAL_UINT64(10000, _read_decoder(pDecoder, out, 10000));
+
+    for (uint32_t i = 0; i < 10000; i++) {
+        TEST_ASSERT_EQUAL_INT16((int16_t)(i % 30000), out[i]);
+    }
+
+    TEST_ASSERT_TRUE(decoder_get_buffered_frames(pDecoder) <= 4096);
+
+    decoder_seek(pDecoder, 31000);
+    TEST_ASSERT_EQUAL_UINT64(500, _read_decoder(pDecoder, out, 500));
+    TEST_ASSERT_EQUAL_INT16(1000, out[0]);
+    TEST_ASSERT_EQUAL_INT16(1499, out[499]);
+    TEST_ASSERT_EQUAL_UINT64(31500, decoder_get_cursor(pDecoder));
+
+    // Reads the remaining frames and stops at the end of the file.
+    uint64_t remaining = 0;
+    uint64_t framesRead = 0;
+    while ((framesRead = _read_decoder(pDecoder, out, 4000)) > 0) {
+        remaining += framesRead;
+    }
+
+    TEST_ASSERT_EQUAL_UINT64(frames - 31500, remaining);
+    TEST_ASSERT_TRUE(decoder_is_at_end(pDecoder));
+
+    decoder_destroy(pDecoder);
+    remove(path);
+}
+
+void test_mapped_wav_direct_and_converted(void) {
+    const char *path = "test/build/mapped_ramp.wav";
+    const uint32_t frames = 20000;
+    _write_ramp_wav(path, frames);
+
+    audio_format_t fileFormat = {pcm_format_s16, 1, 48000};
+    void *pDirect = mapped_wav_create(path, &fileFormat);
+    TEST_ASSERT_NOT_NULL(pDirect);
+    TEST_ASSERT_TRUE(mapped_wav_is_direct(pDirect));
+    TEST_ASSERT_EQUAL_UINT64(frames, mapped_wav_get_length(pDirect));
+
+    int16_t s16[1000];
+    uint64_t framesRead = 0;
+    TEST_ASSERT_TRUE(mapped_wav_seek(pDirect, 15000));
+    mapped_wav_read_pcm_frames_with_buffer(pDirect, s16, 1000, &framesRead);
+    TEST_ASSERT_EQUAL_UINT64(1000, framesRead);
+    TEST_ASSERT_EQUAL_INT16(15000, s16[0]);
+    TEST_ASSERT_EQUAL_INT16(15999, s16[999]);
+    TEST_ASSERT_EQUAL_UINT64(16000, mapped_wav_get_cursor(pDirect));
+    TEST_ASSERT_FALSE(mapped_wav_seek(pDirect, frames + 1));
+
+    mapped_wav_destroy(pDirect);
+
+    audio_format_t outputFormat = {pcm_format_f32, 2, 48000};
+    void *pConverted = mapped_wav_create(path, &outputFormat);
+    TEST_ASSERT_NOT_NULL(pConverted);
+    TEST_ASSERT_FALSE(mapped_wav_is_direct(pConverted));
+
+    float f32[1000 * 2];
+    mapped_wav_read_pcm_frames_with_buffer(pConverted, f32, 1000, &framesRead);
+    TEST_ASSERT_EQUAL_UINT64(1000, framesRead);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 500.0f / 32768.0f, f32[500 * 2]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 500.0f / 32768.0f, f32[500 * 2 + 1]);
+
+    mapped_wav_destroy(pConverted);
+    remove(path);
+}
+
+typedef struct {
+    uint8_t bytes[65536];
+    size_t size;
+    int chunks;
+    bool ended;
+} chunk_sink_t;
+
+static void _collect_chunk(void *pUserData, void *pData, size_t sizeInBytes, uint64_t offset) {
+    chunk_sink_t *sink = pUserData;
+
+    if (!pData) {
+        TEST_ASSERT_EQUAL_UINT64(sink->size, offset);
+        sink->ended = true;
+        return;
+    }
+
+    TEST_ASSERT_TRUE(offset + sizeInBytes <= sizeof(sink->bytes));
+    memcpy(sink->bytes + offset, pData, sizeInBytes);
+
+    if (offset + sizeInBytes > sink->size) {
+        sink->size = offset + sizeInBytes;
+    }
+
+    sink->chunks++;
+    encoder_free_chunk(pData);
+}
+
+void test_encoder_memory_and_callback_sinks(void) {
+    encoder_config_t config = {
+        .channels = 2,
+        .sampleRate = 44100,
+        .pcmFormat = pcm_format_s16,
+    };
+
+    int16_t frames[5000 * 2];
+    for (int i = 0; i < 5000 * 2; i++) {
+        frames[i] = (int16_t)(i * 7);
+    }
+
+    static chunk_sink_t sink;
+    memset(&sink, 0, sizeof(sink));
+
+    void *pMemory = encoder_create_memory(&config, 1000);
+    void *pCallback = encoder_create_callback(&config, 1000, _collect_chunk, &sink);
+    TEST_ASSERT_NOT_NULL(pMemory);
+    TEST_ASSERT_NOT_NULL(pCallback);
+
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_UINT64(1000, encoder_write_pcm_frames(pMemory, frames + i * 2000, 1000));
+        TEST_ASSERT_EQUAL_UINT64(1000, encoder_write_pcm_frames(pCallback, frames + i * 2000, 1000));
+    }
+
+    size_t size = 0;
+    TEST_ASSERT_NULL(encoder_take_chunk(pMemory, &size));
+
+    encoder_finalize(pMemory);
+    encoder_finalize(pCallback);
+
+    static uint8_t file[65536];
+    size_t fileSize = 0;
+    void *pChunk;
+    while ((pChunk = encoder_take_chunk(pMemory, &size)) != NULL) {
+        memcpy(file + fileSize, pChunk, size);
+        fileSize += size;
+        encoder_free_chunk(pChunk);
+    }
+
+    TEST_ASSERT_EQUAL_UINT64(encoder_get_size_in_bytes(pMemory), fileSize);
+    TEST_ASSERT_EQUAL_size_t(fileSize, sink.size);
+    TEST_ASSERT_EQUAL_MEMORY(file, sink.bytes, fileSize);
+    TEST_ASSERT_TRUE(sink.chunks > 20);
+    TEST_ASSERT_TRUE(sink.ended);
+
+    ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_s16, 2, 44100);
+    ma_decoder decoder;
+    TEST_ASSERT_EQUAL(MA_SUCCESS, ma_decoder_init_memory(file, fileSize, &decoderConfig, &decoder));
+
+    ma_uint64 length = 0;
+    ma_decoder_get_length_in_pcm_frames(&decoder, &length);
+    TEST_ASSERT_EQUAL_UINT64(5000, length);
+
+    int16_t decoded[5000 * 2];
+    ma_uint64 framesRead = 0;
+    ma_decoder_read_pcm_frames(&decoder, decoded, 5000, &framesRead);
+    TEST_ASSERT_EQUAL_UINT64(5000, framesRead);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(frames, decoded, 5000 * 2);
+
+    ma_decoder_uninit(&decoder);
+    encoder_destroy(pMemory);
+    encoder_destroy(pCallback);
+}
+
+static uint32_t _read_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+void test_encoder_gaps_are_saved_in_the_file(void) {
+    const char *path = "test/build/gaps.wav";
+    encoder_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_s16,
+    };
+
+    void *pEncoder = encoder_create(path, &config);
+    TEST_ASSERT_NOT_NULL(pEncoder);
+
+    int16_t frames[101] = {0};
+    TEST_ASSERT_EQUAL_UINT64(101, encoder_write_pcm_frames(pEncoder, frames, 101));
+    TEST_ASSERT_EQUAL_UINT64(480, encoder_write_gap(pEncoder, 480));
+    TEST_ASSERT_EQUAL_UINT64(480, encoder_write_gap(pEncoder, 480));
+    TEST_ASSERT_EQUAL_UINT64(100, encoder_write_pcm_frames(pEncoder, frames, 100));
+    TEST_ASSERT_EQUAL_UINT64(48, encoder_write_gap(pEncoder, 48));
+    encoder_finalize(pEncoder);
+
+    encoder_gap_t gaps[2];
+    TEST_ASSERT_EQUAL_UINT32(2, encoder_get_gaps(pEncoder, gaps, 2));
+    encoder_destroy(pEncoder);
+
+    static uint8_t bytes[4096];
+    FILE *pFile = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(pFile);
+    size_t size = fread(bytes, 1, sizeof(bytes), pFile);
+    fclose(pFile);
+
+    // The RIFF size covers the chunks appended after the data.
+    TEST_ASSERT_EQUAL_UINT32(size - 8, _read_u32(bytes + 4));
+
+    uint8_t *pCue = NULL;
+    uint8_t *pList = NULL;
+
+    for (size_t i = 0; i + 4 <= size; i++) {
+        if (!pCue && memcmp(bytes + i, "cue ", 4) == 0) {
+            pCue = bytes + i;
+        }
+
+        if (!pList && memcmp(bytes + i, "adtl", 4) == 0) {
+            pList = bytes + i;
+        }
+    }
+
+    TEST_ASSERT_NOT_NULL(pCue);
+    TEST_ASSERT_NOT_NULL(pList);
+    TEST_ASSERT_EQUAL_UINT32(2, _read_u32(pCue + 8));
+    TEST_ASSERT_EQUAL_UINT32(101, _read_u32(pCue + 12 + 20));
+    TEST_ASSERT_EQUAL_UINT32(201, _read_u32(pCue + 12 + 24 + 20));
+    TEST_ASSERT_EQUAL_MEMORY("ltxt", pList + 4, 4);
+    TEST_ASSERT_EQUAL_UINT32(960, _read_u32(pList + 4 + 12));
+    TEST_ASSERT_EQUAL_UINT32(48, _read_u32(pList + 4 + 28 + 12));
+
+    ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_s16, 1, 48000);
+    ma_decoder decoder;
+    TEST_ASSERT_EQUAL(MA_SUCCESS, ma_decoder_init_file(path, &decoderConfig, &decoder));
+
+    ma_uint64 length = 0;
+    ma_decoder_get_length_in_pcm_frames(&decoder, &length);
+    TEST_ASSERT_EQUAL_UINT64(201, length);
+
+    ma_decoder_uninit(&decoder);
+}
+
+void test_encoder_block_writer(void) {
+    const char *path = "test/build/writer.wav";
+    encoder_config_t config = {
+        .channels = 1,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_s16,
+    };
+    encoder_writer_config_t writerConfig = {
+        .blockSize = 5000,
+        .preallocateSize = 65536,
+        .useDirectIo = true,
+        .fsyncPolicy = encoder_fsync_interval,
+        .fsyncIntervalBytes = 32768,
+    };
+
+    void *pEncoder = encoder_create_writer(path, &config, &writerConfig);
+    TEST_ASSERT_NOT_NULL(pEncoder);
+
+    // Small writes, as a device callback would deliver them.
+    int16_t chunk[480];
+    for (uint32_t f = 0; f < 48000; f += 480) {
+        for (uint32_t i = 0; i < 480; i++) {
+            chunk[i] = (int16_t)((f + i) % 30000);
+        }
+
+        TEST_ASSERT_EQUAL_UINT64(480, encoder_write_pcm_frames(pEncoder, chunk, 480));
+    }
+
+    encoder_writer_stats_t stats;
+    TEST_ASSERT_TRUE(encoder_get_writer_stats(pEncoder, &stats));
+    // 96 KB in 8 KiB blocks instead of 100 writes.
+    TEST_ASSERT_TRUE(stats.writeCalls <= 12);
+
+    encoder_finalize(pEncoder);
+    TEST_ASSERT_TRUE(encoder_get_writer_stats(pEncoder, &stats));
+    TEST_ASSERT_TRUE(stats.readCalls >= 1);
+    TEST_ASSERT_TRUE(stats.preallocateCalls >= 1);
+    TEST_ASSERT_TRUE(stats.syncCalls >= 3);
+    TEST_ASSERT_TRUE(stats.bytesWritten >= encoder_get_size_in_bytes(pEncoder));
+
+    FILE *pFile = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(pFile);
+    fseek(pFile, 0, SEEK_END);
+    TEST_ASSERT_EQUAL_INT64((long)encoder_get_size_in_bytes(pEncoder), ftell(pFile));
+    fclose(pFile);
+
+    encoder_destroy(pEncoder);
+
+    ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_s16, 1, 48000);
+    ma_decoder decoder;
+    TEST_ASSERT_EQUAL(MA_SUCCESS, ma_decoder_init_file(path, &decoderConfig, &decoder));
+
+    ma_uint64 length = 0;
+    ma_decoder_get_length_in_pcm_frames(&decoder, &length);
+    TEST_ASSERT_EQUAL_UINT64(48000, length);
+
+    static int16_t decoded[48000];
+    ma_uint64 framesRead = 0;
+    ma_decoder_read_pcm_frames(&decoder, decoded, 48000, &framesRead);
+    TEST_ASSERT_EQUAL_UINT64(48000, framesRead);
+
+    for (uint32_t i = 0; i < 48000; i += 997) {
+        TEST_ASSERT_EQUAL_INT16((int16_t)(i % 30000), decoded[i]);
+    }
+
+    ma_decoder_uninit(&decoder);
+}
+
+void test_encoder_compact_storage(void) {
+    const char *path = "test/build/adpcm.wav";
+    const uint32_t frames = 10000;
+    static float input[10000 * 2];
+    for (uint32_t i = 0; i < frames; i++) {
+        input[i * 2] = 0.5f * sinf((float)i * 0.05f);
+        input[i * 2 + 1] = 0.25f * sinf((float)i * 0.013f);
+    }
+
+    encoder_config_t config = {
+        .channels = 2,
+        .sampleRate = 48000,
+        .pcmFormat = pcm_format_f32,
+        .storage = encoder_storage_pcm_s16,
+    };
+
+    void *pS16 = encoder_create_memory(&config, 0);
+    config.storage = encoder_storage_ima_adpcm;
+    void *pAdpcm = encoder_create(path, &config);
+    TEST_ASSERT_NOT_NULL(pS16);
+    TEST_ASSERT_NOT_NULL(pAdpcm);
+
+    // Odd slices cross the conversion and ADPCM block boundaries.
+    for (uint32_t f = 0; f < frames; f += 1250) {
+        TEST_ASSERT_EQUAL_UINT64(1250, encoder_write_pcm_frames(pS16, input + f * 2, 1250));
+        TEST_ASSERT_EQUAL_UINT64(1250, encoder_write_pcm_frames(pAdpcm, input + f * 2, 1250));
+    }
+
+    encoder_finalize(pS16);
+    encoder_finalize(pAdpcm);
+
+    uint64_t s16Size = encoder_get_size_in_bytes(pS16);
+    uint64_t adpcmSize = encoder_get_size_in_bytes(pAdpcm);
+    TEST_ASSERT_EQUAL_UINT64(44 + frames * 4, s16Size);
+    TEST_ASSERT_TRUE(adpcmSize * 3 < s16Size);
+
+    static uint8_t file[44 + 10000 * 4];
+    size_t fileSize = 0;
+    size_t size = 0;
+    void *pChunk;
+    while ((pChunk = encoder_take_chunk(pS16, &size)) != NULL) {
+        memcpy(file + fileSize, pChunk, size);
+        fileSize += size;
+        encoder_free_chunk(pChunk);
+    }
+
+    encoder_destroy(pS16);
+    encoder_destroy(pAdpcm);
+
+    ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_f32, 2, 48000);
+    ma_decoder s16Decoder;
+    ma_decoder adpcmDecoder;
+    TEST_ASSERT_EQUAL(MA_SUCCESS, ma_decoder_init_memory(file, fileSize, &decoderConfig, &s16Decoder));
+    TEST_ASSERT_EQUAL(MA_SUCCESS, ma_decoder_init_file(path, &decoderConfig, &adpcmDecoder));
+
+    // The last ADPCM block is padded to a group of 8 frames.
+    ma_uint64 length = 0;
+    ma_decoder_get_length_in_pcm_frames(&adpcmDecoder, &length);
+    TEST_ASSERT_TRUE(length >= frames && length < frames + 8);
+
+    static float s16Output[10000 * 2];
+    static float adpcmOutput[10000 * 2];
+    ma_uint64 framesRead = 0;
+    ma_decoder_read_pcm_frames(&s16Decoder, s16Output, frames, &framesRead);
+    TEST_ASSERT_EQUAL_UINT64(frames, framesRead);
+    ma_decoder_read_pcm_frames(&adpcmDecoder, adpcmOutput, frames, &framesRead);
+    TEST_ASSERT_EQUAL_UINT64(frames, framesRead);
+
+    for (uint32_t i = 0; i < frames * 2; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1.0f / 16384, input[i], s16Output[i]);
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, input[i], adpcmOutput[i]);
+    }
+
+    ma_decoder_uninit(&s16Decoder);
+    ma_decoder_uninit(&adpcmDecoder);
+}
+
+typedef struct {
+    int count;
+    uint32_t index[8];
+    uint64_t firstFrame[8];
+    uint64_t frameCount[8];
+    bool isLast[8];
+} segment_log_t;
+
+static void _log_segment(void *pUserData,
+                         uint32_t index,
+                         uint64_t firstFrame,
+                         uint64_t frameCount,
+                         uint64_t sizeInBytes,
+                         bool isLast) {
+    segment_log_t *log = pUserData;
+    (void)sizeInBytes;
+
+    TEST_ASSERT_TRUE(log->count < 8);
+    log->index[log->count] = index;
+    log->firstFrame[log->count] = firstFrame;
+    log->frameCount[log->count] = frameCount;
+    log->isLast[log->count] = isLast;
+    log->count++;
+}
+
+void test_encoder_segmented_rotation(void) {
+    encoder_config_t config = {
+        .channels = 1,
+        .sampleRate = 4000,
+        .pcmFormat = pcm_format_s16,
+    };
+    encoder_segment_config_t segmentConfig = {
+        .segmentSeconds = 1,
+    };
+
+    static segment_log_t log;
+    memset(&log, 0, sizeof(log));
+
+    void *pEncoder = encoder_create_segmented("test/build/segment_", &config, &segmentConfig, _log_segment, &log);
+    TEST_ASSERT_NOT_NULL(pEncoder);
+
+    // Writes straddle the 4000 frame boundaries.
+    int16_t chunk[700];
+    uint32_t frames = 0;
+    while (frames < 10000) {
+        uint32_t length = frames + 700 > 10000 ? 10000 - frames : 700;
+        for (uint32_t i = 0; i < length; i++) {
+            chunk[i] = (int16_t)(frames + i);
+        }
+
+        TEST_ASSERT_EQUAL_UINT64(length, encoder_write_pcm_frames(pEncoder, chunk, length));
+        frames += length;
+
+        // Gives the background thread time to open the next segment.
+        usleep(5000);
+    }
+
+    encoder_finalize(pEncoder);
+    encoder_destroy(pEncoder);
+
+    TEST_ASSERT_EQUAL_INT(3, log.count);
+
+    uint64_t expected[3] = {4000, 4000, 2000};
+    int16_t decoded[4000];
+
+    for (int s = 0; s < 3; s++) {
+        TEST_ASSERT_EQUAL_UINT32(s, log.index[s]);
+        TEST_ASSERT_EQUAL_UINT64(s * 4000, log.firstFrame[s]);
+        TEST_ASSERT_EQUAL_UINT64(expected[s], log.frameCount[s]);
+        TEST_ASSERT_EQUAL(s == 2, log.isLast[s]);
+
+        char path[64];
+        snprintf(path, sizeof(path), "test/build/segment_%05d.wav", s);
+
+        ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_s16, 1, 4000);
+        ma_decoder decoder;
+        TEST_ASSERT_EQUAL(MA_SUCCESS, ma_decoder_init_file(path, &decoderConfig, &decoder));
+
+        ma_uint64 framesRead = 0;
+        ma_decoder_read_pcm_frames(&decoder, decoded, 4000, &framesRead);
+        TEST_ASSERT_EQUAL_UINT64(expected[s], framesRead);
+
+        // No frame is dropped or repeated at the boundaries.
+        for (uint64_t i = 0; i < framesRead; i++) {
+            TEST_ASSERT_EQUAL_INT16((int16_t)(s * 4000 + i), decoded[i]);
+        }
+
+        ma_decoder_uninit(&decoder);
+    }
+
+    // The file opened ahead for a fourth segment is removed.
+    FILE *pUnused = fopen("test/build/segment_00003.wav", "rb");
+    TEST_ASSERT_NULL(pUnused);
+}
+
+// Brute-force minimum and maximum of frames `[first, last)` widened to whole blocks.
+static void _block_min_max(const float *pSamples, uint64_t count, uint32_t blockFrames,
+                           uint64_t first, uint64_t last, float *pMin, float *pMax) {
+    uint64_t from = first / blockFrames * blockFrames;
+    uint64_t to = (last + blockFrames - 1) / blockFrames * blockFrames;
+
+    *pMin = INFINITY;
+    *pMax = -INFINITY;
+
+    for (uint64_t i = from; i < to && i < count; i++) {
+        *pMin = fminf(*pMin, pSamples[i]);
+        *pMax = fmaxf(*pMax, pSamples[i]);
+    }
+}
+
+void test_overview_pyramid_query(void) {
+    const uint32_t blockFrames = 64;
+    const uint64_t frames = 100000;
+    overview_config_t config = {
+        .pcmFormat = pcm_format_f32,
+        .channels = 2,
+        .sampleRate = 48000,
+        .blockFrames = blockFrames,
+    };
+
+    void *pOverview = overview_create(&config);
+    TEST_ASSERT_NOT_NULL(pOverview);
+
+    float *pLeft = malloc(frames * sizeof(float));
+    float chunk[2 * 333];
+    uint64_t written = 0;
+
+    while (written < frames) {
+        uint64_t length = frames - written > 333 ? 333 : frames - written;
+
+        for (uint64_t i = 0; i < length; i++) {
+            uint64_t n = written + i;
+            pLeft[n] = 0.9f * sinf((float)n * 0.0011f) * sinf((float)n * 0.37f);
+            chunk[2 * i] = pLeft[n];
+            chunk[2 * i + 1] = -0.5f;
+        }
+
+        TEST_ASSERT_EQUAL_UINT64(length, overview_write_pcm_frames(pOverview, chunk, length));
+        written += length;
+    }
+
+    // Only complete blocks are covered until the overview is finished.
+    TEST_ASSERT_EQUAL_UINT64(frames / blockFrames * blockFrames, overview_get_frame_count(pOverview));
+    overview_finish(pOverview);
+    TEST_ASSERT_EQUAL_UINT64(frames, overview_get_frame_count(pOverview));
+    TEST_ASSERT_EQUAL_UINT64(0, overview_write_pcm_frames(pOverview, chunk, 1));
+
+    // Zoom levels from one block per pixel to the whole recording.
+    const uint32_t pixels = 100;
+    float mins[100];
+    float maxs[100];
+    const uint64_t ranges[][2] = {{0, 6400}, {1000, 51200}, {0, frames}, {77777, 22223}};
+
+    for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++) {
+        uint64_t start = ranges[r][0];
+        uint64_t count = ranges[r][1];
+
+        TEST_ASSERT_EQUAL_UINT32(pixels, overview_query(pOverview, 0, start, count, pixels, mins, maxs));
+
+        double span = (double)count / pixels;
+
+        for (uint32_t p = 0; p < pixels; p++) {
+            uint64_t first = start + (uint64_t)(p * span);
+            uint64_t last = start + (uint64_t)((p + 1) * span);
+            float min;
+            float max;
+
+            // Coarser levels may widen a span to its enclosing blocks, which
+            // never exceed two spans on each side.
+            _block_min_max(pLeft, frames, blockFrames, first, last, &min, &max);
+            TEST_ASSERT_TRUE(mins[p] <= min && maxs[p] >= max);
+
+            uint64_t margin = (uint64_t)(2 * span) + blockFrames;
+            _block_min_max(pLeft, frames, blockFrames,
+                           first > margin ? first - margin : 0, last + margin, &min, &max);
+            TEST_ASSERT_TRUE(mins[p] >= min && maxs[p] <= max);
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(pixels, overview_query(pOverview, 1, 0, frames, pixels, mins, maxs));
+    TEST_ASSERT_EQUAL_FLOAT(-0.5f, mins[pixels - 1]);
+    TEST_ASSERT_EQUAL_FLOAT(-0.5f, maxs[pixels - 1]);
+
+    // Spans past the end are not written.
+    TEST_ASSERT_EQUAL_UINT32(50, overview_query(pOverview, 0, frames - 500, 1000, pixels, mins, maxs));
+
+    free(pLeft);
+    overview_destroy(pOverview);
+}
+
+void test_overview_sidecar_from_encoder(void) {
+    encoder_config_t config = {
+        .channels = 1,
+        .sampleRate = 8000,
+        .pcmFormat = pcm_format_s16,
+    };
+    overview_config_t overviewConfig = {
+        .pcmFormat = pcm_format_s16,
+        .channels = 1,
+        .sampleRate = 8000,
+    };
+
+    void *pEncoder = encoder_create("test/build/overview.wav", &config);
+    void *pOverview = overview_create(&overviewConfig);
+    TEST_ASSERT_NOT_NULL(pEncoder);
+    TEST_ASSERT_NOT_NULL(pOverview);
+
+    overview_config_t mismatched = overviewConfig;
+    mismatched.channels = 2;
+    void *pMismatched = overview_create(&mismatched);
+    TEST_ASSERT_FALSE(encoder_set_overview(pEncoder, pMismatched, NULL));
+    overview_destroy(pMismatched);
+
+    TEST_ASSERT_TRUE(encoder_set_overview(pEncoder, pOverview, "test/build/overview.mmov"));
+
+    // One second rising from -16000 in steps of 4, then one second of silence.
+    int16_t samples[16000];
+    for (int i = 0; i < 16000; i++) {
+        samples[i] = i < 8000 ? (int16_t)(-16000 + 4 * i) : 0;
+    }
+
+    TEST_ASSERT_EQUAL_UINT64(16000, encoder_write_pcm_frames(pEncoder, samples, 16000));
+    encoder_finalize(pEncoder);
+    encoder_destroy(pEncoder);
+
+    void *pLoaded = overview_load("test/build/overview.mmov");
+    TEST_ASSERT_NOT_NULL(pLoaded);
+
+    overview_config_t loadedConfig;
+    TEST_ASSERT_TRUE(overview_get_config(pLoaded, &loadedConfig));
+    TEST_ASSERT_EQUAL_UINT32(8000, loadedConfig.sampleRate);
+    TEST_ASSERT_EQUAL_UINT32(256, loadedConfig.blockFrames);
+    TEST_ASSERT_EQUAL_UINT64(16000, overview_get_frame_count(pLoaded));
+
+    float mins[2][4];
+    float maxs[2][4];
+    TEST_ASSERT_EQUAL_UINT32(4, overview_query(pOverview, 0, 0, 16000, 4, mins[0], maxs[0]));
+    TEST_ASSERT_EQUAL_UINT32(4, overview_query(pLoaded, 0, 0, 16000, 4, mins[1], maxs[1]));
+    TEST_ASSERT_EQUAL_FLOAT_ARRAY(mins[0], mins[1], 4);
+    TEST_ASSERT_EQUAL_FLOAT_ARRAY(maxs[0], maxs[1], 4);
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, -16000.0f / 32768.0f, mins[1][0]);
+    TEST_ASSERT_TRUE(maxs[1][1] > 0.0f);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, mins[1][3]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, maxs[1][3]);
+
+    overview_destroy(pLoaded);
+    overview_destroy(pOverview);
+}
+
 int main(void) {
     UNITY_BEGIN();
 
     RUN_TEST(test_context_create_destroy);
+    RUN_TEST(test_context_create_ex_lazy_with_backend_list);
+    RUN_TEST(test_context_create_ex_prefers_last_backend);
+    RUN_TEST(test_context_async_refresh_coalesces);
+    RUN_TEST(test_context_async_device_info_ext);
+    RUN_TEST(test_playback_device_start_async);
+    RUN_TEST(test_playback_device_transitions_run_in_order);
+    RUN_TEST(test_waveform_bank_matches_waveform);
+    RUN_TEST(test_waveform_bank_summed_s16);
+    RUN_TEST(test_playback_device_attach_source);
+    RUN_TEST(test_playback_device_events);
+    RUN_TEST(test_meter_levels_and_loudness);
+    RUN_TEST(test_meter_true_peak);
+    RUN_TEST(test_playback_device_metering);
+    RUN_TEST(test_dsp_chain_filters_and_updates);
+    RUN_TEST(test_playback_device_dsp_chain);
+    RUN_TEST(test_volume_ramp_and_mute);
+    RUN_TEST(test_playback_device_volume_and_mute);
+    RUN_TEST(test_reference_tap_wraps_and_drops);
+    RUN_TEST(test_playback_device_reference_tap);
+    RUN_TEST(test_silence_detector_hold_and_floor);
+    RUN_TEST(test_playback_device_silence_gaps);
+    RUN_TEST(test_playback_group_push_and_outputs);
+    RUN_TEST(test_playback_group_keeps_outputs_in_sync);
+    RUN_TEST(test_playback_device_migrate_keeps_buffer);
+    RUN_TEST(test_playback_device_interruption_resumes_paused);
+    RUN_TEST(test_playback_device_push_buffer_reports_backpressure);
+    RUN_TEST(test_playback_device_interruption_resumes_latest);
+    RUN_TEST(test_playback_device_pause_resumes_at_next_frame);
+    RUN_TEST(test_playback_device_pause_survives_stop);
+    RUN_TEST(test_playback_device_resize_buffer_while_playing);
+    RUN_TEST(test_playback_device_resize_buffer_keeps_newest);
+    RUN_TEST(test_playback_pool_warm_acquire_release);
+    RUN_TEST(test_playback_pool_release_resets_the_device);
+    RUN_TEST(test_playback_pool_device_is_audible_within_a_period);
+    RUN_TEST(test_spectrum_sine_bins);
+    RUN_TEST(test_playback_device_spectrum);
+    RUN_TEST(test_decoder_streams_and_seeks);
+    RUN_TEST(test_mapped_wav_direct_and_converted);
+    RUN_TEST(test_encoder_memory_and_callback_sinks);
+    RUN_TEST(test_encoder_gaps_are_saved_in_the_file);
+    RUN_TEST(test_encoder_block_writer);
+    RUN_TEST(test_encoder_compact_storage);
+    RUN_TEST(test_encoder_segmented_rotation);
+    RUN_TEST(test_overview_pyramid_query);
+    RUN_TEST(test_overview_sidecar_from_encoder);
 
     return UNITY_END();
 }